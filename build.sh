@@ -28,13 +28,39 @@ fi
 # Compile source files to object files
 echo "Compiling BinanceAPI.cpp..."
 g++ $CXXFLAGS -c src/BinanceAPI.cpp -o build/BinanceAPI.o
+g++ $CXXFLAGS -c src/Backtester.cpp -o build/Backtester.o
 g++ $CXXFLAGS -c src/BinanceAuth.cpp -o build/BinanceAuth.o
 g++ $CXXFLAGS -c src/BinanceTypes.cpp -o build/BinanceTypes.o
+g++ $CXXFLAGS -c src/BinanceWsTradingClient.cpp -o build/BinanceWsTradingClient.o
+g++ $CXXFLAGS -c src/Decimal.cpp -o build/Decimal.o
+g++ $CXXFLAGS -c src/ExchangeInfo.cpp -o build/ExchangeInfo.o
+g++ $CXXFLAGS -c src/ExchangeSimulator.cpp -o build/ExchangeSimulator.o
+g++ $CXXFLAGS -c src/HistoryFile.cpp -o build/HistoryFile.o
 g++ $CXXFLAGS -c src/HttpClient.cpp -o build/HttpClient.o
+g++ $CXXFLAGS -c src/Indicators.cpp -o build/Indicators.o
+g++ $CXXFLAGS -c src/LatencyHistogram.cpp -o build/LatencyHistogram.o
+g++ $CXXFLAGS -c src/JsonReader.cpp -o build/JsonReader.o
+g++ $CXXFLAGS -c src/MarketData.cpp -o build/MarketData.o
+g++ $CXXFLAGS -c src/MarketDataStream.cpp -o build/MarketDataStream.o
+g++ $CXXFLAGS -c src/OrderBook.cpp -o build/OrderBook.o
+g++ $CXXFLAGS -c src/OrderGateway.cpp -o build/OrderGateway.o
+g++ $CXXFLAGS -c src/OrderStore.cpp -o build/OrderStore.o
+g++ $CXXFLAGS -c src/PositionTracker.cpp -o build/PositionTracker.o
+g++ $CXXFLAGS -c src/RateLimiter.cpp -o build/RateLimiter.o
+g++ $CXXFLAGS -c src/RequestBuilder.cpp -o build/RequestBuilder.o
+g++ $CXXFLAGS -c src/RiskEngine.cpp -o build/RiskEngine.o
+g++ $CXXFLAGS -c src/Sha256.cpp -o build/Sha256.o
+g++ $CXXFLAGS -c src/Strategy.cpp -o build/Strategy.o
+g++ $CXXFLAGS -c src/StrategyRuntime.cpp -o build/StrategyRuntime.o
+g++ $CXXFLAGS -c src/SymbolRegistry.cpp -o build/SymbolRegistry.o
+g++ $CXXFLAGS -c src/TickFile.cpp -o build/TickFile.o
+g++ $CXXFLAGS -c src/UserData.cpp -o build/UserData.o
+g++ $CXXFLAGS -c src/UserDataStream.cpp -o build/UserDataStream.o
+g++ $CXXFLAGS -c src/WebSocketClient.cpp -o build/WebSocketClient.o
 
 # Create archive/static library
 echo "Creating static library..."
-ar rcs build/libbinance_api.a build/BinanceAPI.o build/BinanceAuth.o build/BinanceTypes.o build/HttpClient.o
+ar rcs build/libbinance_api.a build/Backtester.o build/BinanceAPI.o build/BinanceAuth.o build/BinanceTypes.o build/BinanceWsTradingClient.o build/Decimal.o build/ExchangeInfo.o build/ExchangeSimulator.o build/HistoryFile.o build/HttpClient.o build/Indicators.o build/JsonReader.o build/LatencyHistogram.o build/MarketData.o build/MarketDataStream.o build/OrderBook.o build/OrderGateway.o build/OrderStore.o build/PositionTracker.o build/RateLimiter.o build/RequestBuilder.o build/RiskEngine.o build/Sha256.o build/Strategy.o build/StrategyRuntime.o build/SymbolRegistry.o build/TickFile.o build/UserData.o build/UserDataStream.o build/WebSocketClient.o
 
 # Compile and link main example
 echo "Building binance_example executable..."
@@ -53,6 +79,60 @@ g++ $CXXFLAGS src/strategy_example.cpp -o build/strategy_example build/libbinanc
 echo "Building utils_test executable..."
 g++ $CXXFLAGS src/utils_test.cpp -o build/utils_test build/libbinance_api.a $LDFLAGS
 
+echo "Building sha256_test executable..."
+g++ $CXXFLAGS src/sha256_test.cpp -o build/sha256_test build/libbinance_api.a $LDFLAGS
+
+echo "Building json_test executable..."
+g++ $CXXFLAGS src/json_test.cpp -o build/json_test build/libbinance_api.a $LDFLAGS
+
+echo "Building decimal_test executable..."
+g++ $CXXFLAGS src/decimal_test.cpp -o build/decimal_test build/libbinance_api.a $LDFLAGS
+
+echo "Building rate_limiter_test executable..."
+g++ $CXXFLAGS src/rate_limiter_test.cpp -o build/rate_limiter_test build/libbinance_api.a $LDFLAGS
+
+echo "Building market_data_test executable..."
+g++ $CXXFLAGS src/market_data_test.cpp -o build/market_data_test build/libbinance_api.a $LDFLAGS
+
+echo "Building order_book_test executable..."
+g++ $CXXFLAGS src/order_book_test.cpp -o build/order_book_test build/libbinance_api.a $LDFLAGS
+
+echo "Building strategy_runtime_test executable..."
+g++ $CXXFLAGS src/strategy_runtime_test.cpp -o build/strategy_runtime_test build/libbinance_api.a $LDFLAGS
+
+echo "Building indicators_test executable..."
+g++ $CXXFLAGS src/indicators_test.cpp -o build/indicators_test build/libbinance_api.a $LDFLAGS
+
+echo "Building backtest_test executable..."
+g++ $CXXFLAGS src/backtest_test.cpp -o build/backtest_test build/libbinance_api.a $LDFLAGS
+
+echo "Building tick_file_test executable..."
+g++ $CXXFLAGS src/tick_file_test.cpp -o build/tick_file_test build/libbinance_api.a $LDFLAGS
+
+echo "Building simulator_test executable..."
+g++ $CXXFLAGS src/simulator_test.cpp -o build/simulator_test build/libbinance_api.a $LDFLAGS
+
+echo "Building exchange_simulator executable..."
+g++ $CXXFLAGS src/exchange_simulator.cpp -o build/exchange_simulator build/libbinance_api.a $LDFLAGS
+
+echo "Building histogram_test executable..."
+g++ $CXXFLAGS src/histogram_test.cpp -o build/histogram_test build/libbinance_api.a $LDFLAGS
+
+echo "Building binance_bench executable..."
+g++ $CXXFLAGS src/binance_bench.cpp -o build/binance_bench build/libbinance_api.a $LDFLAGS
+
+echo "Building user_data_test executable..."
+g++ $CXXFLAGS src/user_data_test.cpp -o build/user_data_test build/libbinance_api.a $LDFLAGS
+
+echo "Building ws_trading_test executable..."
+g++ $CXXFLAGS src/ws_trading_test.cpp -o build/ws_trading_test build/libbinance_api.a $LDFLAGS
+
+echo "Building exchange_info_test executable..."
+g++ $CXXFLAGS src/exchange_info_test.cpp -o build/exchange_info_test build/libbinance_api.a $LDFLAGS
+
+echo "Building risk_engine_test executable..."
+g++ $CXXFLAGS src/risk_engine_test.cpp -o build/risk_engine_test build/libbinance_api.a $LDFLAGS
+
 echo "Build completed. Executables are in the build/ directory."
 echo ""
 echo "Available test executables:"
@@ -71,5 +151,59 @@ echo ""
 echo "5. Utils and price calculation tests:"
 echo "   ./build/utils_test \"YOUR_API_KEY\" \"YOUR_API_SECRET\""
 echo ""
+echo "6. SHA-256 known-answer tests (add --bench for throughput):"
+echo "   ./build/sha256_test"
+echo ""
+echo "7. JSON response parsing tests (add --bench for parse time):"
+echo "   ./build/json_test"
+echo ""
+echo "8. Fixed-point decimal tests (add --bench for parse/format time):"
+echo "   ./build/decimal_test"
+echo ""
+echo "9. Rate limiter and usage header tests:"
+echo "   ./build/rate_limiter_test"
+echo ""
+echo "10. WebSocket market data tests (local stand-in server):"
+echo "   ./build/market_data_test"
+echo ""
+echo "11. Order book tests (add --bench [recording] for update throughput):"
+echo "   ./build/order_book_test"
+echo ""
+echo "12. Strategy runtime tests (add --bench for dispatch latency):"
+echo "   ./build/strategy_runtime_test"
+echo ""
+echo "13. Indicator tests (add --bench for update and warm-up time):"
+echo "   ./build/indicators_test"
+echo ""
+echo "14. Backtester tests (add --bench for replay and sweep throughput):"
+echo "   ./build/backtest_test"
+echo ""
+echo "15. Tick recorder tests (add --bench for record/decode speed and file size):"
+echo "   ./build/tick_file_test"
+echo ""
+echo "16. Exchange simulator tests (add --bench for round-trip latency):"
+echo "   ./build/simulator_test"
+echo ""
+echo "17. Local exchange simulator; pass its URL as the third argument of 1, 2, 3 and 5:"
+echo "   ./build/exchange_simulator \"YOUR_API_KEY\" \"YOUR_API_SECRET\" 8090"
+echo ""
+echo "18. Latency histogram tests (add --bench for record cost):"
+echo "   ./build/histogram_test"
+echo ""
+echo "19. Order path benchmark against the local simulator (JSON with --json FILE):"
+echo "   ./build/binance_bench --iterations 20000 --json bench.json"
+echo ""
+echo "20. User data stream, order store and position tests (add --bench for lookup time):"
+echo "   ./build/user_data_test"
+echo ""
+echo "21. WebSocket API trading client tests (add --bench for REST vs WebSocket round trips):"
+echo "   ./build/ws_trading_test"
+echo ""
+echo "22. Exchange info filter cache and symbol registry tests (add --bench for lookup and load time):"
+echo "   ./build/exchange_info_test"
+echo ""
+echo "23. Pre-trade risk engine tests (add --bench for the cost per order):"
+echo "   ./build/risk_engine_test"
+echo ""
 echo "Note: All executables support both mainnet and testnet."
 echo "When testing, always use testnet first!"
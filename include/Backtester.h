@@ -0,0 +1,147 @@
+#ifndef BACKTESTER_H
+#define BACKTESTER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Decimal.h"
+#include "HistoryFile.h"
+#include "OrderGateway.h"
+#include "Strategy.h"
+
+namespace binance {
+
+/**
+ * @struct BacktestConfig
+ * @brief Simulated exchange settings for a backtest
+ */
+struct BacktestConfig {
+    int64_t latencyMicros = 0;  // From placeOrder/cancelOrder to the exchange acting on it
+    Decimal makerFee;           // Fee rates as fractions of the notional, e.g. 0.001
+    Decimal takerFee;
+    Decimal startingBase;
+    Decimal startingQuote;
+};
+
+/**
+ * @struct BacktestResult
+ * @brief Outcome of one backtest
+ */
+struct BacktestResult {
+    size_t events = 0;       // Trades or klines replayed
+    size_t orders = 0;       // Orders placed, including rejected ones
+    size_t fills = 0;
+    Decimal position;        // Base asset held at the end
+    Decimal quote;           // Quote asset held at the end
+    Decimal fees;            // Paid in the quote asset
+    Decimal lastPrice;
+    double pnl = 0;          // Change in equity, with the position marked at the first and last price
+    double maxDrawdown = 0;  // Largest fall in equity from a previous peak, in the quote asset
+    double seconds = 0;      // Wall-clock time of the replay
+};
+
+/**
+ * @class SimulatedGateway
+ * @brief OrderGateway backed by a matching engine that trades against replayed prices
+ *
+ * Requests reach the simulated exchange latencyMicros after they are sent
+ * and are then matched against the prints that follow:
+ * - MARKET orders fill completely at the next print, paying the taker fee.
+ * - LIMIT orders that are marketable on arrival fill like market orders at
+ *   the better of the limit and the print; otherwise they rest and fill at
+ *   their limit price, paying the maker fee, once a print reaches it.
+ * - LIMIT_MAKER orders that would be marketable on arrival are rejected.
+ * - Other order types are rejected.
+ *
+ * Liquidity is unlimited and balances are not checked; the gateway only
+ * keeps account of them. Order updates are produced with the same fields
+ * and error codes as from the exchange. Time only moves through match() and
+ * setTime(), so a replay is deterministic.
+ */
+class SimulatedGateway : public OrderGateway {
+public:
+    explicit SimulatedGateway(const BacktestConfig& config = {});
+    ~SimulatedGateway() override;
+
+    SimulatedGateway(const SimulatedGateway&) = delete;
+    SimulatedGateway& operator=(const SimulatedGateway&) = delete;
+
+    std::string placeOrder(const OrderParams& order) override;
+    void cancelOrder(const std::string& symbol, const std::string& clientOrderId) override;
+    size_t poll(const std::function<void(const OrderUpdateEvent&)>& sink) override;
+
+    /**
+     * @brief Set the simulated time, in microseconds, without a print
+     */
+    void setTime(int64_t nowMicros);
+
+    /**
+     * @brief Advance to a print and match orders against it
+     *
+     * A trade is a print with open, low and high all equal to its price; a
+     * candle is a print at its open time, so orders sent while it was
+     * forming wait for the next one.
+     * @return Number of order updates waiting to be polled
+     */
+    size_t match(int64_t nowMicros, Decimal open, Decimal low, Decimal high);
+
+    size_t orderCount() const;
+    size_t fillCount() const;
+    Decimal position() const;
+    Decimal quote() const;
+    Decimal fees() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+/**
+ * @class Backtester
+ * @brief Replays a history file through a strategy as if it were trading live
+ *
+ * The strategy gets the same callbacks as under StrategyRuntime: trades as
+ * onTrade, candles as closed onKline at their close time, timers and order
+ * updates from a SimulatedGateway. The clock is the event time, so a run
+ * depends only on the file, the configuration and the strategy, and takes
+ * as long as the strategy's own work. Strategy exceptions end the run.
+ */
+class Backtester {
+public:
+    /**
+     * @brief Constructor
+     * @param history File to replay; must outlive the backtester
+     * @param config Simulated exchange settings
+     */
+    explicit Backtester(const HistoryFile& history, const BacktestConfig& config = {});
+
+    /**
+     * @brief Replay the whole file through a strategy
+     */
+    BacktestResult run(Strategy& strategy);
+
+    /**
+     * @brief Run many strategies over one file in parallel
+     *
+     * Worker threads share the mapping and take indices in turn; each run
+     * is independent, so the results equal running them one after another.
+     * @param count Number of runs
+     * @param factory Makes the strategy for a run index; called from the worker threads
+     * @param threads Worker threads; 0 for one per hardware thread
+     * @return One result per index
+     */
+    static std::vector<BacktestResult> sweep(const HistoryFile& history, size_t count,
+                                             const std::function<std::unique_ptr<Strategy>(size_t)>& factory,
+                                             const BacktestConfig& config = {}, size_t threads = 0);
+
+private:
+    const HistoryFile& history_;
+    BacktestConfig config_;
+};
+
+} // namespace binance
+
+#endif // BACKTESTER_H
@@ -17,12 +17,22 @@
 #include <memory>
 #include <functional>
 #include <chrono>
+#include <future>
+#include "RequestBuilder.h"
+#include "BinanceTypes.h"
+#include "RateLimiter.h"
+#include "MarketData.h"
+#include "SymbolRegistry.h"
 
 namespace binance {
 
+class RiskEngine;
+
 /**
  * @class BinanceAPI
  * @brief Main interface for interacting with Binance Spot API
+ *
+ * All methods are safe to call from multiple threads at once.
  */
 class BinanceAPI {
 public:
@@ -211,6 +221,303 @@ public:
     std::string testSOROrder(const std::string& symbol, const std::string& side, 
                             const std::string& type, const std::map<std::string, std::string>& params = {});
     
+    /**
+     * @brief Creates a new order from a prebuilt parameter buffer
+     *
+     * The RequestBuilder overloads skip the map entirely: extra parameters are
+     * appended into the caller's (typically stack-allocated) builder, which is
+     * then signed in place and sent as is. The builder is consumed by the call
+     * and must not already contain keys the method sets itself.
+     * @param symbol Trading pair symbol (e.g., "BTCUSDT")
+     * @param side "BUY" or "SELL"
+     * @param type Order type (e.g., "LIMIT", "MARKET")
+     * @param params Additional parameters
+     * @return JSON string containing the response
+     */
+    std::string createOrder(const std::string& symbol, const std::string& side,
+                           const std::string& type, RequestBuilder& params);
+
+    /**
+     * @brief Test new order creation from a prebuilt parameter buffer
+     * @return JSON string containing the response
+     */
+    std::string testOrder(const std::string& symbol, const std::string& side,
+                         const std::string& type, RequestBuilder& params);
+
+    /**
+     * @brief Query order status from a prebuilt parameter buffer
+     * @return JSON string containing the response
+     */
+    std::string queryOrder(const std::string& symbol, RequestBuilder& params);
+
+    /**
+     * @brief Cancel an active order from a prebuilt parameter buffer
+     * @return JSON string containing the response
+     */
+    std::string cancelOrder(const std::string& symbol, RequestBuilder& params);
+
+    /**
+     * @brief Cancel all open orders on a symbol from a prebuilt parameter buffer
+     * @return JSON string containing the response
+     */
+    std::string cancelAllOrders(const std::string& symbol, RequestBuilder& params);
+
+    /**
+     * @brief Cancel and replace an order from a prebuilt parameter buffer
+     * @return JSON string containing the response
+     */
+    std::string cancelReplaceOrder(const std::string& symbol, const std::string& side,
+                                  const std::string& type, const std::string& cancelReplaceMode,
+                                  RequestBuilder& params);
+
+    /**
+     * @brief Creates a new order for an interned symbol
+     *
+     * The SymbolId overloads take the symbol as an id from symbols() and
+     * append its pre-rendered "symbol=..." parameter, and the side and type
+     * as enums, so no string is built or compared for them; with a risk
+     * engine that shares the registry, the id indexes its table directly.
+     * Otherwise they behave as the RequestBuilder overloads.
+     * @param symbol Id from symbols()
+     * @param side Order side
+     * @param type Order type
+     * @param params Additional parameters; consumed by the call
+     * @return JSON string containing the response
+     * @throws std::out_of_range if the id is not in symbols()
+     */
+    std::string createOrder(SymbolId symbol, OrderSide side, OrderType type, RequestBuilder& params);
+
+    /**
+     * @brief Test new order creation for an interned symbol
+     * @return JSON string containing the response
+     */
+    std::string testOrder(SymbolId symbol, OrderSide side, OrderType type, RequestBuilder& params);
+
+    /**
+     * @brief Query order status for an interned symbol
+     * @return JSON string containing the response
+     */
+    std::string queryOrder(SymbolId symbol, RequestBuilder& params);
+
+    /**
+     * @brief Cancel an active order for an interned symbol
+     * @return JSON string containing the response
+     */
+    std::string cancelOrder(SymbolId symbol, RequestBuilder& params);
+
+    /**
+     * @brief Cancel all open orders on an interned symbol
+     * @return JSON string containing the response
+     */
+    std::string cancelAllOrders(SymbolId symbol, RequestBuilder& params);
+
+    /**
+     * @brief Create an order without throwing on a reject
+     *
+     * The try* methods send the same request as the RequestBuilder overloads
+     * but report the outcome in a caller-owned Response: HTTP status, Binance
+     * error code and message, usage headers and body. An exchange reject or
+     * a transport failure costs no more than a fill, and reusing the same
+     * Response across calls reuses its body buffer.
+     * @param symbol Trading pair symbol (e.g., "BTCUSDT")
+     * @param side "BUY" or "SELL"
+     * @param type Order type (e.g., "LIMIT", "MARKET")
+     * @param params Additional parameters; consumed by the call
+     * @param response Receives the outcome
+     * @return response.ok()
+     * @throws std::runtime_error only if the rate limiter's maximum wait would be exceeded
+     */
+    bool tryCreateOrder(const std::string& symbol, const std::string& side, const std::string& type,
+                        RequestBuilder& params, Response& response);
+
+    /**
+     * @brief Test new order creation without throwing on a reject
+     * @return response.ok()
+     */
+    bool tryTestOrder(const std::string& symbol, const std::string& side, const std::string& type,
+                      RequestBuilder& params, Response& response);
+
+    /**
+     * @brief Query an order without throwing if it does not exist
+     * @return response.ok()
+     */
+    bool tryQueryOrder(const std::string& symbol, RequestBuilder& params, Response& response);
+
+    /**
+     * @brief Cancel an order without throwing if it is already gone (-2011)
+     * @return response.ok()
+     */
+    bool tryCancelOrder(const std::string& symbol, RequestBuilder& params, Response& response);
+
+    /**
+     * @brief Cancel and replace an order without throwing on a partial failure (-2021, -2022)
+     * @return response.ok()
+     */
+    bool tryCancelReplaceOrder(const std::string& symbol, const std::string& side, const std::string& type,
+                               const std::string& cancelReplaceMode, RequestBuilder& params,
+                               Response& response);
+
+    /**
+     * @brief tryCreateOrder for an interned symbol
+     * @return response.ok()
+     */
+    bool tryCreateOrder(SymbolId symbol, OrderSide side, OrderType type, RequestBuilder& params,
+                        Response& response);
+
+    /**
+     * @brief tryTestOrder for an interned symbol
+     * @return response.ok()
+     */
+    bool tryTestOrder(SymbolId symbol, OrderSide side, OrderType type, RequestBuilder& params,
+                      Response& response);
+
+    /**
+     * @brief tryQueryOrder for an interned symbol
+     * @return response.ok()
+     */
+    bool tryQueryOrder(SymbolId symbol, RequestBuilder& params, Response& response);
+
+    /**
+     * @brief tryCancelOrder for an interned symbol
+     * @return response.ok()
+     */
+    bool tryCancelOrder(SymbolId symbol, RequestBuilder& params, Response& response);
+
+    /**
+     * @brief Typed variant of createOrder
+     *
+     * The *Typed methods send the same request as their string counterparts
+     * and parse the response in a single pass (see JsonReader) instead of
+     * returning the raw JSON. Request errors throw exactly as before; a
+     * response that cannot be parsed throws std::runtime_error. To parse a
+     * response from the RequestBuilder overloads, call the parse* functions
+     * from BinanceTypes.h directly.
+     * @return The order as acknowledged by the exchange
+     */
+    OrderInfo createOrderTyped(const std::string& symbol, const std::string& side,
+                               const std::string& type, const std::map<std::string, std::string>& params = {});
+
+    /**
+     * @brief Typed variant of testOrder
+     * @return Commission rates (empty unless computeCommissionRates=true was passed)
+     */
+    TestOrderResult testOrderTyped(const std::string& symbol, const std::string& side,
+                                   const std::string& type, const std::map<std::string, std::string>& params = {});
+
+    /**
+     * @brief Typed variant of queryOrder
+     * @return The order
+     */
+    OrderInfo queryOrderTyped(const std::string& symbol, const std::map<std::string, std::string>& params);
+
+    /**
+     * @brief Typed variant of cancelOrder
+     * @return The canceled order
+     */
+    OrderInfo cancelOrderTyped(const std::string& symbol, const std::map<std::string, std::string>& params);
+
+    /**
+     * @brief Typed variant of cancelReplaceOrder
+     * @return Outcome of the cancel and of the new order
+     */
+    CancelReplaceResult cancelReplaceOrderTyped(const std::string& symbol, const std::string& side,
+                                                const std::string& type, const std::string& cancelReplaceMode,
+                                                const std::map<std::string, std::string>& params);
+
+    /**
+     * @brief Typed variant of getOpenOrders
+     * @return Open orders
+     */
+    std::vector<OrderInfo> getOpenOrdersTyped(const std::string& symbol = "", const std::map<std::string, std::string>& params = {});
+
+    /**
+     * @brief Typed variant of getAllOrders
+     * @return Orders
+     */
+    std::vector<OrderInfo> getAllOrdersTyped(const std::string& symbol, const std::map<std::string, std::string>& params = {});
+
+    /**
+     * @brief Typed variant of createOrderListOCO
+     * @return The order list with its order reports
+     */
+    OrderListInfo createOrderListOCOTyped(const std::string& symbol, const std::string& side,
+                                          const std::string& quantity, const std::map<std::string, std::string>& params);
+
+    /**
+     * @brief Typed variant of createOrderListOTO
+     * @return The order list with its order reports
+     */
+    OrderListInfo createOrderListOTOTyped(const std::string& symbol, const std::map<std::string, std::string>& params);
+
+    /**
+     * @brief Typed variant of createOrderListOTOCO
+     * @return The order list with its order reports
+     */
+    OrderListInfo createOrderListOTOCOTyped(const std::string& symbol, const std::map<std::string, std::string>& params);
+
+    /**
+     * @brief Typed variant of cancelOrderList
+     * @return The canceled order list with its order reports
+     */
+    OrderListInfo cancelOrderListTyped(const std::string& symbol, const std::map<std::string, std::string>& params);
+
+    /**
+     * @brief Typed variant of queryOrderList
+     * @return The order list (without order reports)
+     */
+    OrderListInfo queryOrderListTyped(const std::map<std::string, std::string>& params);
+
+    /**
+     * @brief Asynchronous variant of createOrder
+     *
+     * The *Async methods sign the request immediately and return without
+     * waiting for the response. All in-flight requests share one event loop
+     * and, over HTTPS, one multiplexed HTTP/2 connection, so a burst such as
+     * a mass cancel completes in about one round trip instead of N.
+     * @return Future holding the JSON response; get() rethrows request errors
+     */
+    std::future<std::string> createOrderAsync(const std::string& symbol, const std::string& side,
+                                              const std::string& type,
+                                              const std::map<std::string, std::string>& params = {});
+
+    /**
+     * @brief Asynchronous variant of testOrder
+     * @return Future holding the JSON response
+     */
+    std::future<std::string> testOrderAsync(const std::string& symbol, const std::string& side,
+                                            const std::string& type,
+                                            const std::map<std::string, std::string>& params = {});
+
+    /**
+     * @brief Asynchronous variant of queryOrder
+     * @return Future holding the JSON response
+     */
+    std::future<std::string> queryOrderAsync(const std::string& symbol,
+                                             const std::map<std::string, std::string>& params);
+
+    /**
+     * @brief Asynchronous variant of cancelOrder
+     * @return Future holding the JSON response
+     */
+    std::future<std::string> cancelOrderAsync(const std::string& symbol,
+                                              const std::map<std::string, std::string>& params);
+
+    /**
+     * @brief Asynchronous variant of cancelAllOrders
+     * @return Future holding the JSON response
+     */
+    std::future<std::string> cancelAllOrdersAsync(const std::string& symbol,
+                                                  const std::map<std::string, std::string>& params = {});
+
+    /**
+     * @brief Asynchronous variant of cancelReplaceOrder
+     * @return Future holding the JSON response
+     */
+    std::future<std::string> cancelReplaceOrderAsync(const std::string& symbol, const std::string& side,
+                                                     const std::string& type,
+                                                     const std::string& cancelReplaceMode,
+                                                     const std::map<std::string, std::string>& params);
+
     /**
      * @brief Get symbol price ticker
      * @param symbol Trading pair symbol
@@ -219,6 +526,105 @@ public:
      */
     std::string getSymbolPriceTicker(const std::string& symbol, const std::map<std::string, std::string>& params = {});
 
+    /**
+     * @brief Get the order book
+     * @param symbol Trading pair symbol
+     * @param limit Levels per side (default 100, max 5000); request weight grows with it
+     * @return JSON string containing lastUpdateId, bids and asks
+     */
+    std::string getOrderBook(const std::string& symbol, int limit = 100);
+
+    /**
+     * @brief Typed variant of getOrderBook
+     * @return The snapshot, ready to bootstrap an OrderBook
+     */
+    DepthSnapshot getOrderBookTyped(const std::string& symbol, int limit = 100);
+
+    /**
+     * @brief Get exchange trading rules and symbol filters (GET /api/v3/exchangeInfo, weight 20)
+     * @param symbols Symbols to include; empty returns every symbol (several megabytes)
+     * @return JSON string containing serverTime, rateLimits and the symbols with their filters
+     */
+    std::string getExchangeInfo(const std::vector<std::string>& symbols = {});
+
+    /**
+     * @brief Test connectivity to the REST API
+     *
+     * Also leaves a warm TLS connection in the shared pool, so calling it once
+     * before trading keeps the handshake out of the first order's latency.
+     * @return JSON string containing the response (empty object on success)
+     */
+    std::string ping();
+
+    /**
+     * @brief Start a user data stream (POST /api/v3/userDataStream)
+     *
+     * Needs only the API key. The key stays valid for 60 minutes unless kept
+     * alive, and the exchange hands back the same key while one is active.
+     * @return The listen key, for the stream URL <stream base>/ws/<listenKey>
+     * @throws std::runtime_error if the request fails
+     */
+    std::string createListenKey();
+
+    /**
+     * @brief Extend a listen key's validity by 60 minutes (PUT /api/v3/userDataStream)
+     * @throws std::runtime_error if the request fails, e.g. the key has expired (-1125)
+     */
+    void keepAliveListenKey(const std::string& listenKey);
+
+    /**
+     * @brief Close a user data stream (DELETE /api/v3/userDataStream)
+     * @throws std::runtime_error if the request fails
+     */
+    void closeListenKey(const std::string& listenKey);
+
+    /**
+     * @brief Request-weight and order-count model used to pace requests
+     *
+     * Every request takes budget from it before it is signed and every
+     * response's usage headers are fed back into it. Cancels are scheduled
+     * ahead of new orders. Use it to inspect usage or change the limits.
+     * @return The client's rate limiter
+     */
+    RateLimiter& rateLimiter();
+
+    /**
+     * @brief Check new orders against pre-trade risk limits before signing them
+     *
+     * Every request that places orders (createOrder, cancel-replace, SOR
+     * and order lists, with their typed, try* and async variants) reserves
+     * each order with the engine and fails without being sent if one breaks
+     * a limit, with error code -2010 and the message "Risk check failed:
+     * <reason>"; a list is reserved whole or not at all. A request that
+     * fails gives its reservations back, an async one before its future
+     * throws, unless a cancel-replace placed its new order anyway. Set
+     * before placing orders.
+     * @param engine Engine to use, which must outlive the client; nullptr turns checking off
+     */
+    void setRiskEngine(RiskEngine* engine);
+
+    /**
+     * @brief The risk engine set with setRiskEngine(), or nullptr
+     */
+    RiskEngine* riskEngine() const;
+
+    /**
+     * @brief Registry of the ids the SymbolId overloads take
+     *
+     * Intern every traded symbol during setup, before orders are placed
+     * from other threads, and build ExchangeInfoCache and RiskEngine on the
+     * same registry so one id names the symbol everywhere.
+     */
+    SymbolRegistry& symbols();
+
+    /**
+     * @brief Request counts, bytes and curl phase latencies per endpoint
+     * @param reset Also start the counters and histograms over
+     * @return One entry per method and path requested so far
+     * @see HttpClient::metrics
+     */
+    std::vector<EndpointMetrics> httpMetrics(bool reset = false);
+
 private:
     class Impl;
     std::unique_ptr<Impl> pImpl;
@@ -3,15 +3,24 @@
 
 #include <string>
 #include <map>
+#include <vector>
+#include <string_view>
+#include <array>
+#include <cstdint>
 
 namespace binance {
 
+class RequestBuilder;
+
 /**
  * @class BinanceAuth
  * @brief Handles authentication and signatures for Binance API requests
  */
 class BinanceAuth {
 public:
+    /// Length of a hex-encoded HMAC-SHA256 signature
+    static constexpr size_t SIGNATURE_LENGTH = 64;
+
     /**
      * @brief Constructor
      * @param api_key The Binance API key
@@ -37,6 +46,38 @@ public:
      * @param params Map of parameters to modify
      */
     void signRequest(std::map<std::string, std::string>& params) const;
+
+    /**
+     * @brief Sign a payload into a caller-provided buffer
+     * @param payload Bytes to sign
+     * @param signature Output buffer of SIGNATURE_LENGTH bytes (not NUL-terminated)
+     */
+    void sign(std::string_view payload, char* signature) const;
+
+    /**
+     * @brief Add timestamp (if missing) and append &signature= to a request in place
+     * @param request Request whose serialized bytes are signed
+     */
+    void signRequest(RequestBuilder& request) const;
+
+    /**
+     * @brief Sign many query strings together
+     *
+     * Payloads are hashed in groups of up to eight SHA-256 lanes at once
+     * (AVX2 where available), which makes refreshing a whole quote ladder
+     * much cheaper than calling generateSignature per order.
+     * @param payloads Query strings to sign
+     * @param count Number of payloads
+     * @param signatures Caller-provided buffer of count * SIGNATURE_LENGTH bytes;
+     *        signature i is written, not NUL-terminated, at offset i * SIGNATURE_LENGTH
+     */
+    void signBatch(const std::string_view* payloads, size_t count, char* signatures) const;
+
+    /**
+     * @brief Add timestamp and signature to each parameter set, signing them as a batch
+     * @param paramSets Parameter maps to modify
+     */
+    void signBatch(std::vector<std::map<std::string, std::string>>& paramSets) const;
     
     /**
      * @brief Create standard headers for Binance API requests
@@ -47,6 +88,10 @@ public:
 private:
     std::string api_key_;
     std::string api_secret_;
+
+    // SHA-256 states after absorbing (key ^ ipad) and (key ^ opad)
+    std::array<uint32_t, 8> inner_state_;
+    std::array<uint32_t, 8> outer_state_;
 };
 
 } // namespace binance
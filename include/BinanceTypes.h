@@ -2,10 +2,12 @@
 #define BINANCE_TYPES_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
 #include <optional>
 #include <variant>
+#include "Decimal.h"
 
 namespace binance {
 
@@ -60,7 +62,8 @@ enum class SelfTradePreventionMode {
     NONE,
     EXPIRE_TAKER,
     EXPIRE_MAKER,
-    EXPIRE_BOTH
+    EXPIRE_BOTH,
+    DECREMENT
 };
 
 /**
@@ -78,12 +81,28 @@ enum class CancelReplaceMode {
  */
 enum class OrderStatus {
     NEW,
+    PENDING_NEW,      // Pending order of an OTO or OTOCO list, not placed yet
     PARTIALLY_FILLED,
     FILLED,
     CANCELED,
     PENDING_CANCEL,
     REJECTED,
-    EXPIRED
+    EXPIRED,
+    EXPIRED_IN_MATCH  // Expired by self-trade prevention
+};
+
+/**
+ * @enum ExecutionType
+ * @brief What happened to an order in an execution report
+ */
+enum class ExecutionType {
+    NEW,
+    CANCELED,
+    REPLACED,
+    REJECTED,
+    TRADE,
+    EXPIRED,
+    TRADE_PREVENTION  // Expired by self-trade prevention
 };
 
 /**
@@ -101,6 +120,7 @@ enum class ContingencyType {
  * @brief Status type of an order list
  */
 enum class ListStatusType {
+    RESPONSE,
     EXEC_STARTED,
     ALL_DONE,
     REJECT
@@ -125,15 +145,15 @@ struct OrderParams {
     OrderSide side;
     OrderType type;
     std::optional<TimeInForce> timeInForce;
-    std::optional<std::string> quantity;
-    std::optional<std::string> quoteOrderQty;
-    std::optional<std::string> price;
+    std::optional<Decimal> quantity;
+    std::optional<Decimal> quoteOrderQty;
+    std::optional<Decimal> price;
     std::optional<std::string> newClientOrderId;
     std::optional<std::string> strategyId;
     std::optional<int> strategyType;
-    std::optional<std::string> stopPrice;
+    std::optional<Decimal> stopPrice;
     std::optional<long> trailingDelta;
-    std::optional<std::string> icebergQty;
+    std::optional<Decimal> icebergQty;
     std::optional<OrderResponseType> newOrderRespType;
     std::optional<SelfTradePreventionMode> selfTradePreventionMode;
 };
@@ -145,20 +165,20 @@ struct OrderParams {
 struct OCOOrderParams {
     std::string symbol;
     OrderSide side;
-    std::string quantity;
-    std::string price;
-    std::string stopPrice;
+    Decimal quantity;
+    Decimal price;
+    Decimal stopPrice;
     std::optional<std::string> listClientOrderId;
     std::optional<std::string> limitClientOrderId;
     std::optional<std::string> limitStrategyId;
     std::optional<int> limitStrategyType;
-    std::optional<std::string> limitIcebergQty;
+    std::optional<Decimal> limitIcebergQty;
     std::optional<long> trailingDelta;
     std::optional<std::string> stopClientOrderId;
     std::optional<std::string> stopStrategyId;
     std::optional<int> stopStrategyType;
-    std::optional<std::string> stopLimitPrice;
-    std::optional<std::string> stopIcebergQty;
+    std::optional<Decimal> stopLimitPrice;
+    std::optional<Decimal> stopIcebergQty;
     std::optional<TimeInForce> stopLimitTimeInForce;
     std::optional<OrderResponseType> newOrderRespType;
     std::optional<SelfTradePreventionMode> selfTradePreventionMode;
@@ -178,9 +198,9 @@ struct OTOOrderParams {
     OrderType workingType;
     OrderSide workingSide;
     std::optional<std::string> workingClientOrderId;
-    std::string workingPrice;
-    std::string workingQuantity;
-    std::optional<std::string> workingIcebergQty;
+    Decimal workingPrice;
+    Decimal workingQuantity;
+    std::optional<Decimal> workingIcebergQty;
     std::optional<TimeInForce> workingTimeInForce;
     std::optional<std::string> workingStrategyId;
     std::optional<int> workingStrategyType;
@@ -189,11 +209,11 @@ struct OTOOrderParams {
     OrderType pendingType;
     OrderSide pendingSide;
     std::optional<std::string> pendingClientOrderId;
-    std::optional<std::string> pendingPrice;
-    std::optional<std::string> pendingStopPrice;
+    std::optional<Decimal> pendingPrice;
+    std::optional<Decimal> pendingStopPrice;
     std::optional<std::string> pendingTrailingDelta;
-    std::string pendingQuantity;
-    std::optional<std::string> pendingIcebergQty;
+    Decimal pendingQuantity;
+    std::optional<Decimal> pendingIcebergQty;
     std::optional<TimeInForce> pendingTimeInForce;
     std::optional<std::string> pendingStrategyId;
     std::optional<int> pendingStrategyType;
@@ -213,24 +233,24 @@ struct OTOCOOrderParams {
     OrderType workingType;
     OrderSide workingSide;
     std::optional<std::string> workingClientOrderId;
-    std::string workingPrice;
-    std::string workingQuantity;
-    std::optional<std::string> workingIcebergQty;
+    Decimal workingPrice;
+    Decimal workingQuantity;
+    std::optional<Decimal> workingIcebergQty;
     std::optional<TimeInForce> workingTimeInForce;
     std::optional<std::string> workingStrategyId;
     std::optional<int> workingStrategyType;
 
     // Pending parameters
     OrderSide pendingSide;
-    std::string pendingQuantity;
+    Decimal pendingQuantity;
 
     // Pending above order parameters
     OrderType pendingAboveType;
     std::optional<std::string> pendingAboveClientOrderId;
-    std::optional<std::string> pendingAbovePrice;
-    std::optional<std::string> pendingAboveStopPrice;
+    std::optional<Decimal> pendingAbovePrice;
+    std::optional<Decimal> pendingAboveStopPrice;
     std::optional<std::string> pendingAboveTrailingDelta;
-    std::optional<std::string> pendingAboveIcebergQty;
+    std::optional<Decimal> pendingAboveIcebergQty;
     std::optional<TimeInForce> pendingAboveTimeInForce;
     std::optional<std::string> pendingAboveStrategyId;
     std::optional<int> pendingAboveStrategyType;
@@ -238,10 +258,10 @@ struct OTOCOOrderParams {
     // Pending below order parameters
     OrderType pendingBelowType;
     std::optional<std::string> pendingBelowClientOrderId;
-    std::optional<std::string> pendingBelowPrice;
-    std::optional<std::string> pendingBelowStopPrice;
+    std::optional<Decimal> pendingBelowPrice;
+    std::optional<Decimal> pendingBelowStopPrice;
     std::optional<std::string> pendingBelowTrailingDelta;
-    std::optional<std::string> pendingBelowIcebergQty;
+    std::optional<Decimal> pendingBelowIcebergQty;
     std::optional<TimeInForce> pendingBelowTimeInForce;
     std::optional<std::string> pendingBelowStrategyId;
     std::optional<int> pendingBelowStrategyType;
@@ -252,9 +272,9 @@ struct OTOCOOrderParams {
  * @brief Information about fills in an order
  */
 struct OrderFill {
-    std::string price;
-    std::string qty;
-    std::string commission;
+    Decimal price;
+    Decimal qty;
+    Decimal commission;
     std::string commissionAsset;
     std::string tradeId;
 };
@@ -269,17 +289,17 @@ struct OrderInfo {
     long orderListId;
     std::string clientOrderId;
     long transactTime;
-    std::string price;
-    std::string origQty;
-    std::string executedQty;
-    std::string origQuoteOrderQty;
-    std::string cummulativeQuoteQty;
+    Decimal price;
+    Decimal origQty;
+    Decimal executedQty;
+    Decimal origQuoteOrderQty;
+    Decimal cummulativeQuoteQty;
     OrderStatus status;
     TimeInForce timeInForce;
     OrderType type;
     OrderSide side;
-    std::optional<std::string> stopPrice;
-    std::optional<std::string> icebergQty;
+    std::optional<Decimal> stopPrice;
+    std::optional<Decimal> icebergQty;
     long time;
     long updateTime;
     bool isWorking;
@@ -288,7 +308,7 @@ struct OrderInfo {
     std::optional<bool> usedSor;
     std::optional<std::string> workingFloor;
     std::optional<long> preventedMatchId;
-    std::optional<std::string> preventedQuantity;
+    std::optional<Decimal> preventedQuantity;
     std::optional<long> strategyId;
     std::optional<int> strategyType;
     std::optional<long> trailingDelta;
@@ -338,8 +358,8 @@ struct CancelReplaceResult {
  * @brief Commission rates for orders
  */
 struct CommissionRates {
-    std::string maker;
-    std::string taker;
+    Decimal maker;
+    Decimal taker;
 };
 
 /**
@@ -350,7 +370,7 @@ struct Discount {
     bool enabledForAccount;
     bool enabledForSymbol;
     std::string discountAsset;
-    std::string discount;
+    Decimal discount;
 };
 
 /**
@@ -371,16 +391,22 @@ std::string toString(OrderResponseType respType);
 std::string toString(SelfTradePreventionMode mode);
 std::string toString(CancelReplaceMode mode);
 std::string toString(OrderStatus status);
+std::string toString(ExecutionType type);
 std::string toString(ContingencyType type);
-
-OrderSide orderSideFromString(const std::string& str);
-OrderType orderTypeFromString(const std::string& str);
-TimeInForce timeInForceFromString(const std::string& str);
-OrderResponseType orderResponseTypeFromString(const std::string& str);
-SelfTradePreventionMode selfTradePreventionModeFromString(const std::string& str);
-CancelReplaceMode cancelReplaceModeFromString(const std::string& str);
-OrderStatus orderStatusFromString(const std::string& str);
-ContingencyType contingencyTypeFromString(const std::string& str);
+std::string toString(ListStatusType type);
+std::string toString(ListOrderStatus status);
+
+OrderSide orderSideFromString(std::string_view str);
+OrderType orderTypeFromString(std::string_view str);
+TimeInForce timeInForceFromString(std::string_view str);
+OrderResponseType orderResponseTypeFromString(std::string_view str);
+SelfTradePreventionMode selfTradePreventionModeFromString(std::string_view str);
+CancelReplaceMode cancelReplaceModeFromString(std::string_view str);
+OrderStatus orderStatusFromString(std::string_view str);
+ExecutionType executionTypeFromString(std::string_view str);
+ContingencyType contingencyTypeFromString(std::string_view str);
+ListStatusType listStatusTypeFromString(std::string_view str);
+ListOrderStatus listOrderStatusFromString(std::string_view str);
 
 // Utility function to convert parameters to query string
 std::string paramsToQueryString(const std::map<std::string, std::string>& params);
@@ -391,6 +417,16 @@ std::map<std::string, std::string> toParamMap(const OCOOrderParams& params);
 std::map<std::string, std::string> toParamMap(const OTOOrderParams& params);
 std::map<std::string, std::string> toParamMap(const OTOCOOrderParams& params);
 
+// Parse JSON responses into structs. Each runs a single pass over the text
+// with JsonReader and skips fields it does not know. Malformed JSON throws
+// std::runtime_error; unknown enum values or bad decimals throw
+// std::invalid_argument.
+OrderInfo parseOrderInfo(std::string_view json);
+std::vector<OrderInfo> parseOrderInfoList(std::string_view json);
+OrderListInfo parseOrderListInfo(std::string_view json);
+CancelReplaceResult parseCancelReplaceResult(std::string_view json);
+TestOrderResult parseTestOrderResult(std::string_view json);
+
 } // namespace binance
 
 #endif // BINANCE_TYPES_H
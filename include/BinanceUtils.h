@@ -3,6 +3,9 @@
 
 #include <string>
 #include <map>
+#include <stdexcept>
+#include "Decimal.h"
+#include "ExchangeInfo.h"
 
 namespace binance {
 
@@ -29,14 +32,11 @@ OCOPrices calculateOCOPrices(double currentPrice, bool isSell, double percentage
         prices.stopLimitPrice = prices.stopPrice * 1.001;         // Just slightly above stop price
     }
 
-    // Ensure proper price formatting
-    char buffer[32];
-    snprintf(buffer, sizeof(buffer), "%.2f", prices.limitPrice);
-    prices.limitPrice = std::stod(buffer);
-    snprintf(buffer, sizeof(buffer), "%.2f", prices.stopPrice);
-    prices.stopPrice = std::stod(buffer);
-    snprintf(buffer, sizeof(buffer), "%.2f", prices.stopLimitPrice);
-    prices.stopLimitPrice = std::stod(buffer);
+    // Snap to the 0.01 tick exactly rather than via a printf/stod round trip
+    const Decimal tick = Decimal::fromUnits(Decimal::SCALE / 100);
+    prices.limitPrice = Decimal::fromDouble(prices.limitPrice).round(tick).toDouble();
+    prices.stopPrice = Decimal::fromDouble(prices.stopPrice).round(tick).toDouble();
+    prices.stopLimitPrice = Decimal::fromDouble(prices.stopLimitPrice).round(tick).toDouble();
 
     return prices;
 }
@@ -48,6 +48,37 @@ std::string formatPrice(double price, int decimals = 2) {
     return std::string(buffer);
 }
 
+struct OCODecimalPrices {
+    Decimal limitPrice;
+    Decimal stopPrice;
+    Decimal stopLimitPrice;
+};
+
+// Exact variant of calculateOCOPrices: percentage is a fraction (0.02 = 2%)
+// and every price is snapped to the symbol's tick size, rounding away from
+// the market so the OCO price relationships still hold after rounding
+inline OCODecimalPrices calculateOCOPrices(Decimal currentPrice, bool isSell, Decimal tickSize,
+                                           Decimal percentage = Decimal::fromUnits(2000000)) {
+    const Decimal one = Decimal::fromInteger(1);
+    const Decimal offset = Decimal::fromUnits(100000);  // 0.001
+    OCODecimalPrices prices;
+    if (isSell) {
+        prices.stopPrice = (currentPrice * (one - percentage)).round(tickSize, Decimal::Rounding::DOWN);
+        prices.limitPrice = (currentPrice * (one + percentage)).round(tickSize, Decimal::Rounding::UP);
+        prices.stopLimitPrice = (prices.stopPrice * (one - offset)).round(tickSize, Decimal::Rounding::DOWN);
+    } else {
+        prices.limitPrice = (currentPrice * (one - percentage)).round(tickSize, Decimal::Rounding::DOWN);
+        prices.stopPrice = (currentPrice * (one + percentage)).round(tickSize, Decimal::Rounding::UP);
+        prices.stopLimitPrice = (prices.stopPrice * (one + offset)).round(tickSize, Decimal::Rounding::UP);
+    }
+    return prices;
+}
+
+// Format a decimal price with a fixed number of places
+inline std::string formatPrice(Decimal price, int decimals = 2) {
+    return price.toString(decimals);
+}
+
 // Helper to create OCO order parameters
 std::map<std::string, std::string> createOCOParams(const OCOPrices& prices, 
                                                   const std::string& quantity,
@@ -79,6 +110,50 @@ int getPricePrecision(const std::string& symbol) {
     return it != precisions.end() ? it->second : 2;
 }
 
+// Price precision from the symbol's tick size; symbols the cache lacks fall back to the table above
+inline int getPricePrecision(const ExchangeInfoCache& cache, const std::string& symbol) {
+    const SymbolFilters* filters = cache.find(symbol);
+    return filters ? filters->pricePrecision() : getPricePrecision(symbol);
+}
+
+// Price precision of an interned symbol, without hashing or comparing its name
+inline int getPricePrecision(const ExchangeInfoCache& cache, SymbolId symbol) {
+    const SymbolFilters* filters = cache.find(symbol);
+    return filters ? filters->pricePrecision() : getPricePrecision(std::string(cache.registry().name(symbol)));
+}
+
+// calculateOCOPrices snapped to the symbol's own tick size
+inline OCODecimalPrices calculateOCOPrices(Decimal currentPrice, bool isSell, const SymbolFilters& filters,
+                                           Decimal percentage = Decimal::fromUnits(2000000)) {
+    Decimal tick = filters.tickSize.units() > 0 ? filters.tickSize : Decimal::fromUnits(1);
+    return calculateOCOPrices(currentPrice, isSell, tick, percentage);
+}
+
+// OCO order parameters formatted at the symbol's precision, with the quantity
+// rounded down to its step size and every leg checked against its filters
+inline std::map<std::string, std::string> createOCOParams(const OCODecimalPrices& prices, Decimal quantity,
+                                                         OrderSide side, const SymbolFilters& filters,
+                                                         const std::string& timeInForce = "GTC") {
+    Decimal rounded = filters.roundQuantity(quantity);
+    const Decimal legPrices[] = {prices.limitPrice, prices.stopLimitPrice};
+    for (Decimal legPrice : legPrices) {
+        FilterResult result = filters.check(side, OrderType::LIMIT, legPrice, rounded);
+        if (result != FilterResult::OK) {
+            throw std::invalid_argument(std::string("OCO order fails filter ") + toString(result) + " for " +
+                                        std::string(filters.symbol.view()));
+        }
+    }
+
+    int decimals = filters.pricePrecision();
+    std::map<std::string, std::string> params;
+    params["price"] = formatPrice(prices.limitPrice, decimals);
+    params["stopPrice"] = formatPrice(prices.stopPrice, decimals);
+    params["stopLimitPrice"] = formatPrice(prices.stopLimitPrice, decimals);
+    params["stopLimitTimeInForce"] = timeInForce;
+    params["quantity"] = rounded.toString(filters.quantityPrecision());
+    return params;
+}
+
 } // namespace binance
 
 #endif // BINANCE_UTILS_H
@@ -0,0 +1,325 @@
+#ifndef BINANCE_WS_TRADING_CLIENT_H
+#define BINANCE_WS_TRADING_CLIENT_H
+
+#include <string>
+#include <map>
+#include <memory>
+#include <future>
+#include <cstdint>
+#include <cstddef>
+#include "RequestBuilder.h"
+#include "BinanceTypes.h"
+#include "HttpClient.h"
+#include "RateLimiter.h"
+
+namespace binance {
+
+class RiskEngine;
+
+/**
+ * @class BinanceWsTradingClient
+ * @brief Order entry over the Binance WebSocket API, with the order methods of BinanceAPI
+ *
+ * Every request is one signed JSON message (order.place, order.test,
+ * order.status, order.cancel, order.cancelReplace) on a single persistent
+ * connection, so there are no HTTP headers to send or parse and no transfer
+ * to set up per order. Each request carries an id, and a reader thread
+ * hands each response to the call waiting for that id. Requests from any
+ * number of threads, and the *Async variants, are pipelined: they go out
+ * without waiting for earlier responses, and a burst completes in about one
+ * round trip.
+ *
+ * The methods take and return the same parameters and JSON as their
+ * BinanceAPI counterparts: results are the REST response bodies, errors
+ * throw std::runtime_error with the exchange's {"code":..,"msg":..}
+ * object, and the try* variants report the outcome in a Response. Request
+ * weight and order counts are taken from the client's own RateLimiter and
+ * synced from each response's rateLimits; the WebSocket API shares the
+ * account's limits with REST.
+ *
+ * If the connection drops, the requests in flight fail with status 0 and
+ * later calls throw until connect() is called again; whether those orders
+ * reached the exchange is unknown, so query them after reconnecting.
+ * All methods are safe to call from multiple threads at once.
+ */
+class BinanceWsTradingClient {
+public:
+    /// Requests that may await a response at once; further requests wait for a free slot
+    static constexpr size_t MAX_IN_FLIGHT = 1024;
+
+    /**
+     * @brief Constructor; does not connect
+     * @param api_key The Binance API key
+     * @param api_secret The Binance API secret (HMAC keys only)
+     * @param url WebSocket API endpoint, e.g. "wss://ws-api.binance.com:443/ws-api/v3" or
+     *        "wss://ws-api.testnet.binance.vision/ws-api/v3"
+     */
+    BinanceWsTradingClient(const std::string& api_key, const std::string& api_secret,
+                           const std::string& url = "wss://ws-api.binance.com:443/ws-api/v3");
+
+    /**
+     * @brief Destructor; closes the connection
+     */
+    ~BinanceWsTradingClient();
+
+    BinanceWsTradingClient(const BinanceWsTradingClient&) = delete;
+    BinanceWsTradingClient& operator=(const BinanceWsTradingClient&) = delete;
+
+    /**
+     * @brief Open the connection and start the reader thread
+     * @param timeoutMs Longest wait for any single step of the connection setup
+     * @throws std::runtime_error if the connection fails
+     */
+    void connect(int timeoutMs = 10000);
+
+    /**
+     * @brief Close the connection; requests in flight fail
+     */
+    void close();
+
+    /**
+     * @brief Whether the connection is open
+     */
+    bool isConnected() const;
+
+    /**
+     * @brief Longest wait for a response before a request fails (default 10000 ms)
+     */
+    void setResponseTimeout(int64_t milliseconds);
+
+    /**
+     * @brief Requests sent and not yet answered
+     */
+    size_t inFlight() const;
+
+    /**
+     * @brief Test connectivity to the WebSocket API
+     * @return JSON string containing the response (empty object on success)
+     */
+    std::string ping();
+
+    /**
+     * @brief Creates a new order (order.place)
+     * @param symbol Trading pair symbol (e.g., "BTCUSDT")
+     * @param side "BUY" or "SELL"
+     * @param type Order type (e.g., "LIMIT", "MARKET")
+     * @param params Additional parameters map
+     * @return JSON string containing the response
+     */
+    std::string createOrder(const std::string& symbol, const std::string& side,
+                           const std::string& type, const std::map<std::string, std::string>& params = {});
+
+    /**
+     * @brief Test new order creation (order.test)
+     * @return JSON string containing the response
+     */
+    std::string testOrder(const std::string& symbol, const std::string& side,
+                         const std::string& type, const std::map<std::string, std::string>& params = {});
+
+    /**
+     * @brief Query order status (order.status)
+     * @param params Additional parameters (must include orderId or origClientOrderId)
+     * @return JSON string containing the response
+     */
+    std::string queryOrder(const std::string& symbol, const std::map<std::string, std::string>& params);
+
+    /**
+     * @brief Cancel an active order (order.cancel)
+     * @param params Additional parameters (must include orderId or origClientOrderId)
+     * @return JSON string containing the response
+     */
+    std::string cancelOrder(const std::string& symbol, const std::map<std::string, std::string>& params);
+
+    /**
+     * @brief Cancel an existing order and send a new order (order.cancelReplace)
+     * @param cancelReplaceMode "STOP_ON_FAILURE" or "ALLOW_FAILURE"
+     * @return JSON string containing the response
+     */
+    std::string cancelReplaceOrder(const std::string& symbol, const std::string& side,
+                                  const std::string& type, const std::string& cancelReplaceMode,
+                                  const std::map<std::string, std::string>& params);
+
+    /**
+     * @brief Creates a new order from a prebuilt parameter buffer
+     *
+     * As with BinanceAPI, the builder is consumed by the call and must not
+     * already contain keys the method sets itself. Its values must not need
+     * JSON escaping, which holds for the URL-safe values it takes anyway.
+     * @return JSON string containing the response
+     */
+    std::string createOrder(const std::string& symbol, const std::string& side,
+                           const std::string& type, RequestBuilder& params);
+
+    /**
+     * @brief Test new order creation from a prebuilt parameter buffer
+     * @return JSON string containing the response
+     */
+    std::string testOrder(const std::string& symbol, const std::string& side,
+                         const std::string& type, RequestBuilder& params);
+
+    /**
+     * @brief Query order status from a prebuilt parameter buffer
+     * @return JSON string containing the response
+     */
+    std::string queryOrder(const std::string& symbol, RequestBuilder& params);
+
+    /**
+     * @brief Cancel an active order from a prebuilt parameter buffer
+     * @return JSON string containing the response
+     */
+    std::string cancelOrder(const std::string& symbol, RequestBuilder& params);
+
+    /**
+     * @brief Cancel and replace an order from a prebuilt parameter buffer
+     * @return JSON string containing the response
+     */
+    std::string cancelReplaceOrder(const std::string& symbol, const std::string& side,
+                                  const std::string& type, const std::string& cancelReplaceMode,
+                                  RequestBuilder& params);
+
+    /**
+     * @brief Create an order without throwing on a reject
+     *
+     * Fills the Response as BinanceAPI::tryCreateOrder does: status, error
+     * code, usage (from rateLimits) and the body, which is the result or
+     * the error object. A dropped connection or a timeout gives status 0.
+     * @return response.ok()
+     */
+    bool tryCreateOrder(const std::string& symbol, const std::string& side, const std::string& type,
+                        RequestBuilder& params, Response& response);
+
+    /**
+     * @brief Test new order creation without throwing on a reject
+     * @return response.ok()
+     */
+    bool tryTestOrder(const std::string& symbol, const std::string& side, const std::string& type,
+                      RequestBuilder& params, Response& response);
+
+    /**
+     * @brief Query an order without throwing if it does not exist
+     * @return response.ok()
+     */
+    bool tryQueryOrder(const std::string& symbol, RequestBuilder& params, Response& response);
+
+    /**
+     * @brief Cancel an order without throwing if it is already gone (-2011)
+     * @return response.ok()
+     */
+    bool tryCancelOrder(const std::string& symbol, RequestBuilder& params, Response& response);
+
+    /**
+     * @brief Cancel and replace an order without throwing on a partial failure (-2021, -2022)
+     * @return response.ok()
+     */
+    bool tryCancelReplaceOrder(const std::string& symbol, const std::string& side, const std::string& type,
+                               const std::string& cancelReplaceMode, RequestBuilder& params,
+                               Response& response);
+
+    /**
+     * @brief Typed variant of createOrder
+     * @return The order as acknowledged by the exchange
+     */
+    OrderInfo createOrderTyped(const std::string& symbol, const std::string& side,
+                               const std::string& type, const std::map<std::string, std::string>& params = {});
+
+    /**
+     * @brief Typed variant of testOrder
+     * @return Commission rates (empty unless computeCommissionRates=true was passed)
+     */
+    TestOrderResult testOrderTyped(const std::string& symbol, const std::string& side,
+                                   const std::string& type, const std::map<std::string, std::string>& params = {});
+
+    /**
+     * @brief Typed variant of queryOrder
+     * @return The order
+     */
+    OrderInfo queryOrderTyped(const std::string& symbol, const std::map<std::string, std::string>& params);
+
+    /**
+     * @brief Typed variant of cancelOrder
+     * @return The canceled order
+     */
+    OrderInfo cancelOrderTyped(const std::string& symbol, const std::map<std::string, std::string>& params);
+
+    /**
+     * @brief Typed variant of cancelReplaceOrder
+     * @return Outcome of the cancel and of the new order
+     */
+    CancelReplaceResult cancelReplaceOrderTyped(const std::string& symbol, const std::string& side,
+                                                const std::string& type, const std::string& cancelReplaceMode,
+                                                const std::map<std::string, std::string>& params);
+
+    /**
+     * @brief Asynchronous variant of createOrder
+     *
+     * Signs and sends the request and returns without waiting for the
+     * response, so many requests can be in flight on the connection.
+     * @return Future holding the JSON response; get() rethrows request errors
+     */
+    std::future<std::string> createOrderAsync(const std::string& symbol, const std::string& side,
+                                              const std::string& type,
+                                              const std::map<std::string, std::string>& params = {});
+
+    /**
+     * @brief Asynchronous variant of testOrder
+     * @return Future holding the JSON response
+     */
+    std::future<std::string> testOrderAsync(const std::string& symbol, const std::string& side,
+                                            const std::string& type,
+                                            const std::map<std::string, std::string>& params = {});
+
+    /**
+     * @brief Asynchronous variant of queryOrder
+     * @return Future holding the JSON response
+     */
+    std::future<std::string> queryOrderAsync(const std::string& symbol,
+                                             const std::map<std::string, std::string>& params);
+
+    /**
+     * @brief Asynchronous variant of cancelOrder
+     * @return Future holding the JSON response
+     */
+    std::future<std::string> cancelOrderAsync(const std::string& symbol,
+                                              const std::map<std::string, std::string>& params);
+
+    /**
+     * @brief Asynchronous variant of cancelReplaceOrder
+     * @return Future holding the JSON response
+     */
+    std::future<std::string> cancelReplaceOrderAsync(const std::string& symbol, const std::string& side,
+                                                     const std::string& type,
+                                                     const std::string& cancelReplaceMode,
+                                                     const std::map<std::string, std::string>& params);
+
+    /**
+     * @brief Request-weight and order-count model used to pace requests
+     * @return The client's rate limiter
+     */
+    RateLimiter& rateLimiter();
+
+    /**
+     * @brief Check new orders against pre-trade risk limits before signing them
+     *
+     * Works as BinanceAPI::setRiskEngine: createOrder, cancelReplaceOrder and
+     * their typed, try* and async variants reserve the order they place and
+     * fail without sending it if it breaks a limit, with error code -2010
+     * and the message "Risk check failed: <reason>". A request that fails
+     * gives its reservation back, an async one before its future throws. A
+     * client and a BinanceAPI trading the same account may share an engine.
+     * @param engine Engine to use, which must outlive the client; nullptr turns checking off
+     */
+    void setRiskEngine(RiskEngine* engine);
+
+    /**
+     * @brief The risk engine set with setRiskEngine(), or nullptr
+     */
+    RiskEngine* riskEngine() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace binance
+
+#endif // BINANCE_WS_TRADING_CLIENT_H
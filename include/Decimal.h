@@ -0,0 +1,156 @@
+#ifndef DECIMAL_H
+#define DECIMAL_H
+
+#include <string>
+#include <string_view>
+#include <charconv>
+#include <cstdint>
+#include <iosfwd>
+
+namespace binance {
+
+/**
+ * @class Decimal
+ * @brief Fixed-point number with the exchange's eight decimal places
+ *
+ * The value is held as a signed 64-bit count of 1e-8 units, the same
+ * resolution Binance uses for prices, quantities and commissions, so every
+ * value the exchange sends is represented exactly. Addition, subtraction and
+ * comparison are exact integer operations; multiplication and division
+ * round the last digit half away from zero. The representable range is
+ * about +/-92,233,720,368; results outside it are undefined, as with int64_t.
+ */
+class Decimal {
+public:
+    /// Number of decimal places
+    static constexpr int DIGITS = 8;
+    /// Units per whole number
+    static constexpr int64_t SCALE = 100000000;
+
+    /**
+     * @enum Rounding
+     * @brief Direction used when snapping to a tick or step size
+     */
+    enum class Rounding {
+        DOWN,    // Toward negative infinity
+        UP,      // Toward positive infinity
+        NEAREST  // Half away from zero
+    };
+
+    /**
+     * @brief Zero
+     */
+    constexpr Decimal() : units_(0) {}
+
+    /**
+     * @brief Make a value from a raw count of 1e-8 units
+     */
+    static constexpr Decimal fromUnits(int64_t units) { return Decimal(units); }
+
+    /**
+     * @brief Make a value from a whole number
+     */
+    static constexpr Decimal fromInteger(int64_t value) { return Decimal(value * SCALE); }
+
+    /**
+     * @brief Convert from double, rounding to the nearest unit
+     */
+    static Decimal fromDouble(double value);
+
+    /**
+     * @brief Parse a decimal string such as "0.00100000" or "-12.5"
+     * @param text The whole string must be a plain decimal number
+     * @return The value
+     * @throws std::invalid_argument if the text is not a decimal or needs more than eight places
+     */
+    static Decimal parse(std::string_view text);
+
+    /**
+     * @brief Raw count of 1e-8 units
+     */
+    constexpr int64_t units() const { return units_; }
+
+    /**
+     * @brief Nearest double
+     */
+    double toDouble() const { return static_cast<double>(units_) / SCALE; }
+
+    /**
+     * @brief Shortest exact string, without trailing zeros (e.g. "0.001", "42")
+     */
+    std::string toString() const;
+
+    /**
+     * @brief String with a fixed number of decimal places, rounded to nearest
+     * @param decimals Decimal places, 0 to 8
+     */
+    std::string toString(int decimals) const;
+
+    /**
+     * @brief Snap to a multiple of a tick or step size
+     * @param increment Tick size (prices) or step size (quantities); must be positive
+     * @param mode Rounding direction
+     * @return The nearest multiple of increment in the given direction
+     * @throws std::invalid_argument if increment is not positive
+     */
+    Decimal round(Decimal increment, Rounding mode = Rounding::NEAREST) const;
+
+    /**
+     * @brief Whether the value is an exact multiple of an increment
+     */
+    bool isMultipleOf(Decimal increment) const {
+        return increment.units_ != 0 && units_ % increment.units_ == 0;
+    }
+
+    constexpr bool isZero() const { return units_ == 0; }
+
+    constexpr Decimal operator-() const { return Decimal(-units_); }
+    constexpr Decimal operator+(Decimal other) const { return Decimal(units_ + other.units_); }
+    constexpr Decimal operator-(Decimal other) const { return Decimal(units_ - other.units_); }
+    constexpr Decimal operator*(int64_t factor) const { return Decimal(units_ * factor); }
+    Decimal operator*(Decimal other) const;
+    Decimal operator/(Decimal other) const;
+
+    Decimal& operator+=(Decimal other) { units_ += other.units_; return *this; }
+    Decimal& operator-=(Decimal other) { units_ -= other.units_; return *this; }
+
+    constexpr bool operator==(Decimal other) const { return units_ == other.units_; }
+    constexpr bool operator!=(Decimal other) const { return units_ != other.units_; }
+    constexpr bool operator<(Decimal other) const { return units_ < other.units_; }
+    constexpr bool operator<=(Decimal other) const { return units_ <= other.units_; }
+    constexpr bool operator>(Decimal other) const { return units_ > other.units_; }
+    constexpr bool operator>=(Decimal other) const { return units_ >= other.units_; }
+
+private:
+    int64_t units_;
+
+    constexpr explicit Decimal(int64_t units) : units_(units) {}
+};
+
+/**
+ * @brief Parse a decimal from a character range, in the manner of std::from_chars
+ *
+ * Accepts an optional '-', digits and an optional fraction. Fraction digits
+ * past the eighth must be zero.
+ * @return ptr one past the last character consumed; ec is invalid_argument if
+ *         no number starts at first, result_out_of_range if it cannot be
+ *         represented (value left unchanged in both cases)
+ */
+std::from_chars_result from_chars(const char* first, const char* last, Decimal& value);
+
+/**
+ * @brief Format the shortest exact representation, in the manner of std::to_chars
+ * @return ptr one past the last character written; ec is value_too_large if the range is too small
+ */
+std::to_chars_result to_chars(char* first, char* last, Decimal value);
+
+/**
+ * @brief Format with a fixed number of decimal places (0 to 8), rounded to nearest
+ */
+std::to_chars_result to_chars(char* first, char* last, Decimal value, int decimals);
+
+std::ostream& operator<<(std::ostream& os, Decimal value);
+
+} // namespace binance
+
+#endif // DECIMAL_H
@@ -0,0 +1,245 @@
+#ifndef EXCHANGE_INFO_H
+#define EXCHANGE_INFO_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "BinanceTypes.h"
+#include "Decimal.h"
+#include "MarketData.h"
+#include "SymbolRegistry.h"
+
+namespace binance {
+
+class BinanceAPI;
+
+/**
+ * @enum FilterResult
+ * @brief Outcome of checking an order against its symbol's filters
+ *
+ * Each failure names the exchange filter that would reject the order with
+ * -1013 "Filter failure: <name>".
+ */
+enum class FilterResult {
+    OK,
+    UNKNOWN_SYMBOL,         // No filters loaded for the symbol
+    NOT_TRADING,            // The symbol's status is not TRADING
+    PRICE_FILTER,           // Price outside [minPrice, maxPrice] or not a multiple of tickSize
+    PERCENT_PRICE,          // Price too far from the reference price (PERCENT_PRICE[_BY_SIDE])
+    LOT_SIZE,               // Quantity outside [minQty, maxQty] or not a multiple of stepSize
+    MARKET_LOT_SIZE,        // As LOT_SIZE, for market orders
+    NOTIONAL                // price * quantity outside [minNotional, maxNotional] (NOTIONAL, MIN_NOTIONAL)
+};
+
+/**
+ * @brief Exchange filter name of a failure, e.g. "LOT_SIZE"; "OK" for success
+ */
+const char* toString(FilterResult result);
+
+/**
+ * @struct SymbolFilters
+ * @brief Trading rules of one symbol from exchangeInfo
+ *
+ * A zero limit means the exchange does not apply it (e.g. maxPrice 0, or a
+ * symbol without a PERCENT_PRICE filter). Trivially copyable, so a table
+ * of these is snapshotted to disk as is.
+ */
+struct SymbolFilters {
+    SymbolName symbol;
+    SymbolName baseAsset;
+    SymbolName quoteAsset;
+    bool trading = false;                // status is TRADING
+    int32_t baseAssetPrecision = 8;
+    int32_t quoteAssetPrecision = 8;
+
+    // PRICE_FILTER
+    Decimal minPrice;
+    Decimal maxPrice;
+    Decimal tickSize;
+
+    // LOT_SIZE and MARKET_LOT_SIZE
+    Decimal minQty;
+    Decimal maxQty;
+    Decimal stepSize;
+    Decimal marketMinQty;
+    Decimal marketMaxQty;
+    Decimal marketStepSize;
+
+    // NOTIONAL, or the older MIN_NOTIONAL
+    Decimal minNotional;
+    Decimal maxNotional;
+    bool applyMinToMarket = true;
+    bool applyMaxToMarket = false;
+
+    // PERCENT_PRICE_BY_SIDE; PERCENT_PRICE sets both sides alike
+    Decimal bidMultiplierUp;
+    Decimal bidMultiplierDown;
+    Decimal askMultiplierUp;
+    Decimal askMultiplierDown;
+
+    /**
+     * @brief Decimal places of the tick size, e.g. 2 for 0.01; what prices should be formatted with
+     */
+    int pricePrecision() const;
+
+    /**
+     * @brief Decimal places of the step size, e.g. 5 for 0.00001
+     */
+    int quantityPrecision() const;
+
+    /**
+     * @brief Snap a price to the tick size
+     */
+    Decimal roundPrice(Decimal price, Decimal::Rounding mode = Decimal::Rounding::NEAREST) const;
+
+    /**
+     * @brief Snap a quantity down to the step size (of MARKET_LOT_SIZE if market and set)
+     */
+    Decimal roundQuantity(Decimal quantity, bool market = false) const;
+
+    /**
+     * @brief Check an order the way the exchange will
+     *
+     * Checks run in the exchange's order: price, percent price, lot size,
+     * then notional. Market orders skip the price checks and use the
+     * reference price for the notional; without one, they skip it too.
+     * @param price Limit price; ignored for MARKET
+     * @param quantity Base quantity
+     * @param referencePrice Last or average price for PERCENT_PRICE and market notional; zero skips those checks
+     * @return The first filter the order fails, or OK
+     */
+    FilterResult check(OrderSide side, OrderType type, Decimal price, Decimal quantity,
+                       Decimal referencePrice = Decimal()) const;
+
+    /**
+     * @brief Round an order to the filters, then check it
+     *
+     * The price is rounded away from the market (bids down, asks up) so the
+     * order never becomes more aggressive than asked; the quantity is
+     * rounded down so it never grows.
+     * @return check() of the rounded order
+     */
+    FilterResult normalize(OrderSide side, OrderType type, Decimal& price, Decimal& quantity,
+                           Decimal referencePrice = Decimal()) const;
+};
+
+/**
+ * @class ExchangeInfoCache
+ * @brief Symbol filters from exchangeInfo, looked up by SymbolId
+ *
+ * Load the filters once from GET /api/v3/exchangeInfo, then round and
+ * validate orders locally instead of learning about a bad tick or lot size
+ * from a -1013 reject. Filters sit in a flat array indexed by the ids of a
+ * shared SymbolRegistry, so a lookup is one bounds check and one index.
+ *
+ * The whole table can be saved to a binary snapshot and loaded back on the
+ * next start, which skips the request and the parse of the several
+ * megabytes the exchange sends. warmStart() does that when the snapshot is
+ * recent enough and fetches otherwise.
+ *
+ * Snapshot layout (little-endian): magic "BNXINFO1", record size (u32),
+ * count (u32), saved time (ms since the epoch, i64), 8 reserved bytes, then
+ * count SymbolFilters records as laid out in memory.
+ *
+ * Loading replaces the table and interns the symbols into the registry;
+ * reads are safe from any number of threads between loads.
+ */
+class ExchangeInfoCache {
+public:
+    /**
+     * @brief Constructor
+     * @param registry Registry whose ids index the table; must outlive the cache
+     */
+    explicit ExchangeInfoCache(SymbolRegistry& registry);
+
+    /**
+     * @brief Replace the table with the symbols of an exchangeInfo response
+     * @return Number of symbols loaded
+     * @throws std::runtime_error if the JSON is malformed
+     */
+    size_t load(std::string_view exchangeInfoJson);
+
+    /**
+     * @brief Fetch exchangeInfo (weight 20) and load it
+     * @param symbols Symbols to fetch; empty fetches every symbol
+     * @return Number of symbols loaded
+     */
+    size_t fetch(BinanceAPI& api, const std::vector<std::string>& symbols = {});
+
+    /**
+     * @brief Write the table to a snapshot file
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void saveSnapshot(const std::string& path) const;
+
+    /**
+     * @brief Load the table from a snapshot file
+     * @param maxAgeMs Oldest snapshot accepted, by the time it was saved; negative accepts any age
+     * @return False, leaving the table as it was, if the file is missing, too old or not a snapshot
+     *         written by this build
+     */
+    bool loadSnapshot(const std::string& path, int64_t maxAgeMs = -1);
+
+    /**
+     * @brief Load from a recent snapshot, or fetch and save a new one
+     * @param maxAgeMs Oldest snapshot used (default one day)
+     * @return Number of symbols loaded
+     */
+    size_t warmStart(BinanceAPI& api, const std::string& snapshotPath, int64_t maxAgeMs = 24 * 3600 * 1000);
+
+    /**
+     * @brief Filters of a symbol, or nullptr if none are loaded
+     */
+    const SymbolFilters* find(SymbolId id) const {
+        return id < loaded_.size() && loaded_[id] ? &filters_[id] : nullptr;
+    }
+
+    /**
+     * @brief Filters of a symbol by name, or nullptr if none are loaded
+     */
+    const SymbolFilters* find(std::string_view symbol) const {
+        return find(registry_.find(symbol));
+    }
+
+    /**
+     * @brief check() of a symbol's filters; UNKNOWN_SYMBOL if none are loaded
+     */
+    FilterResult check(SymbolId id, OrderSide side, OrderType type, Decimal price, Decimal quantity,
+                       Decimal referencePrice = Decimal()) const {
+        const SymbolFilters* filters = find(id);
+        return filters ? filters->check(side, type, price, quantity, referencePrice) : FilterResult::UNKNOWN_SYMBOL;
+    }
+
+    /**
+     * @brief normalize() with a symbol's filters; UNKNOWN_SYMBOL, leaving the order as it is, if none are loaded
+     */
+    FilterResult normalize(SymbolId id, OrderSide side, OrderType type, Decimal& price, Decimal& quantity,
+                           Decimal referencePrice = Decimal()) const {
+        const SymbolFilters* filters = find(id);
+        return filters ? filters->normalize(side, type, price, quantity, referencePrice)
+                       : FilterResult::UNKNOWN_SYMBOL;
+    }
+
+    /// Symbols with filters loaded
+    size_t size() const { return count_; }
+
+    /// When the loaded data was produced, in ms since the epoch (serverTime, or the snapshot's saved time)
+    int64_t updateTime() const { return updateTime_; }
+
+    SymbolRegistry& registry() const { return registry_; }
+
+private:
+    void store(std::vector<SymbolFilters>& symbols, int64_t updateTime);
+
+    SymbolRegistry& registry_;
+    std::vector<SymbolFilters> filters_;     // Indexed by SymbolId
+    std::vector<uint8_t> loaded_;            // Whether filters_[id] holds a symbol
+    size_t count_ = 0;
+    int64_t updateTime_ = 0;
+};
+
+} // namespace binance
+
+#endif // EXCHANGE_INFO_H
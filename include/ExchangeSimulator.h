@@ -0,0 +1,173 @@
+#ifndef EXCHANGE_SIMULATOR_H
+#define EXCHANGE_SIMULATOR_H
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include "Decimal.h"
+#include "ExchangeInfo.h"
+
+namespace binance {
+
+/**
+ * @struct SimulatorConfig
+ * @brief Account, limits and network behaviour of an ExchangeSimulator
+ */
+struct SimulatorConfig {
+    std::string apiKey;                // Expected in the X-MBX-APIKEY header of signed requests
+    std::string apiSecret;             // Signatures are checked with this secret
+    uint16_t port = 0;                 // Loopback port to listen on; 0 picks a free one
+    int64_t latencyMicros = 0;         // Added before every response is sent
+    int64_t jitterMicros = 0;          // Uniform random extra delay, up to this much
+    uint64_t seed = 1;                 // Seeds the jitter, so runs are repeatable
+    int64_t weightLimit = 6000;        // Request weight per minute (X-MBX-USED-WEIGHT-1M)
+    int64_t orderLimit10s = 100;       // Orders per 10 seconds (X-MBX-ORDER-COUNT-10S)
+    int64_t orderLimit1d = 200000;     // Orders per day (X-MBX-ORDER-COUNT-1D)
+    Decimal makerCommission = Decimal::fromUnits(100000);  // 0.001
+    Decimal takerCommission = Decimal::fromUnits(100000);
+};
+
+/**
+ * @class ExchangeSimulator
+ * @brief Local stand-in for the Binance Spot REST API, served over HTTP on the loopback interface
+ *
+ * Point BinanceAPI at baseUrl() to run the examples, tests and benchmarks
+ * without network access. The simulator implements the order endpoints the
+ * client uses (/api/v3/order, /order/test, /order/cancelReplace,
+ * /openOrders, /allOrders, /order/oco, /orderList/oco|oto|otoco,
+ * /orderList, /openOrderList, /allOrderList, /sor/order and
+ * /sor/order/test), the public /ticker/price, /depth, /exchangeInfo, /ping
+ * and /time, and the user data stream: listen keys from
+ * /api/v3/userDataStream and a WebSocket at /ws/<listenKey> on the same
+ * port that pushes execution reports and outboundAccountPosition events as
+ * orders change. The WebSocket API at /ws-api/v3 takes ping, time,
+ * exchangeInfo, order.place, order.test, order.status, order.cancel,
+ * order.cancelReplace and openOrders.status requests on one connection and
+ * runs them through the same handlers.
+ *
+ * Signed requests are checked as the exchange checks them: the API key
+ * header, the timestamp against recvWindow and the HMAC-SHA256 signature of
+ * the query string and body (for the WebSocket API, the apiKey parameter
+ * and the signature of the sorted parameters). Request weight and order
+ * counts are tracked in fixed windows, reported in the X-MBX-* headers (the
+ * rateLimits member over the WebSocket API), and answered with 429 and
+ * Retry-After once a limit is exceeded. Errors use the exchange's codes and
+ * messages.
+ *
+ * Each symbol has a market price, set with setPrice() or trade(), and a
+ * book of the orders placed through the API, matched in price-time
+ * priority. An incoming order first takes resting orders priced better than
+ * the market, then fills at the market price against unlimited outside
+ * liquidity if its limit allows. Moving the market fills resting orders it
+ * crosses, at their own prices, and triggers stop and take-profit orders.
+ * Order lists follow the exchange's rules: an OCO leg that fills or
+ * triggers expires the other, and the pending orders of OTO and OTOCO lists
+ * are placed once the working order fills. Balances, set with setBalance(),
+ * move with fills and commissions but are never checked or locked.
+ */
+class ExchangeSimulator {
+public:
+    /**
+     * @brief Constructor; binds the listening socket
+     * @throws std::runtime_error if the port cannot be bound
+     */
+    explicit ExchangeSimulator(const SimulatorConfig& config);
+
+    /**
+     * @brief Destructor; stops the server
+     */
+    ~ExchangeSimulator();
+
+    ExchangeSimulator(const ExchangeSimulator&) = delete;
+    ExchangeSimulator& operator=(const ExchangeSimulator&) = delete;
+
+    /**
+     * @brief Start accepting connections
+     */
+    void start();
+
+    /**
+     * @brief Close every connection and stop the server threads
+     */
+    void stop();
+
+    uint16_t port() const;
+
+    /**
+     * @brief Base URL to give BinanceAPI, e.g. "http://127.0.0.1:40123"
+     */
+    std::string baseUrl() const;
+
+    /**
+     * @brief URL to give BinanceWsTradingClient, e.g. "ws://127.0.0.1:40123/ws-api/v3"
+     */
+    std::string webSocketApiUrl() const;
+
+    /**
+     * @brief Move a symbol's market price, listing the symbol if it is new
+     *
+     * Resting orders the new price crosses fill completely at their own
+     * prices, and stop and take-profit orders it reaches are triggered.
+     */
+    void setPrice(const std::string& symbol, Decimal price);
+
+    /**
+     * @brief Market price of a symbol
+     * @throws std::invalid_argument if the symbol is not listed
+     */
+    Decimal price(const std::string& symbol) const;
+
+    /**
+     * @brief Trade another participant's order against the book, then move the market price
+     *
+     * Up to quantity is taken from the resting orders that price crosses,
+     * best price first and oldest first within a price.
+     * @return Quantity filled
+     * @throws std::invalid_argument if the symbol is not listed
+     */
+    Decimal trade(const std::string& symbol, Decimal price, Decimal quantity);
+
+    /**
+     * @brief Enforce trading rules for a listed symbol, as reported by exchangeInfo
+     *
+     * Orders that break them are rejected with -1013 "Filter failure: <name>",
+     * the percent-price bands taken around the market price. Without rules
+     * set, exchangeInfo reports a tick and step of 0.00000001 and orders
+     * are not checked.
+     * @throws std::invalid_argument if the symbol is not listed
+     */
+    void setFilters(const std::string& symbol, const SymbolFilters& filters);
+
+    /**
+     * @brief Set the free amount of an asset, reported on the user data streams
+     */
+    void setBalance(const std::string& asset, Decimal free);
+
+    /**
+     * @brief Free amount of an asset; zero if it was never set or traded
+     */
+    Decimal balance(const std::string& asset) const;
+
+    /**
+     * @brief Expire every listen key, as the exchange does after 60 minutes without a keepalive
+     *
+     * Open user data streams get a listenKeyExpired event and are closed.
+     */
+    void expireListenKeys();
+
+    /// Requests answered, including rejected ones
+    uint64_t requestCount() const;
+    /// Requests answered with a 4xx status
+    uint64_t errorCount() const;
+    /// Orders resting in a book or waiting for their stop price
+    size_t openOrderCount() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace binance
+
+#endif // EXCHANGE_SIMULATOR_H
@@ -0,0 +1,135 @@
+#ifndef HISTORY_FILE_H
+#define HISTORY_FILE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "MarketData.h"
+
+namespace binance {
+
+/**
+ * @enum HistoryKind
+ * @brief What a history file holds
+ */
+enum class HistoryKind : uint32_t {
+    TRADES = 1,
+    KLINES = 2
+};
+
+/**
+ * @struct TradeColumns
+ * @brief Column pointers into a trade history file
+ *
+ * Times are milliseconds since the epoch; prices and quantities are raw
+ * Decimal units (1e-8).
+ */
+struct TradeColumns {
+    const int64_t* time = nullptr;
+    const int64_t* price = nullptr;
+    const int64_t* quantity = nullptr;
+    const uint8_t* buyerMaker = nullptr;
+};
+
+/**
+ * @struct KlineColumns
+ * @brief Column pointers into a kline history file (units as in TradeColumns)
+ */
+struct KlineColumns {
+    const int64_t* openTime = nullptr;
+    const int64_t* closeTime = nullptr;
+    const int64_t* open = nullptr;
+    const int64_t* high = nullptr;
+    const int64_t* low = nullptr;
+    const int64_t* close = nullptr;
+    const int64_t* volume = nullptr;
+};
+
+/**
+ * @class HistoryFile
+ * @brief Read-only, memory-mapped columnar file of trades or klines
+ *
+ * The file is a 64-byte header followed by one fixed-width column per
+ * field, each starting on an 8-byte boundary. Opening maps it and checks
+ * the header; the columns are then used in place, so replay reads memory
+ * sequentially without parsing and any number of threads can share one
+ * mapping.
+ *
+ * Layout (little-endian): magic "BNHIST1\0", kind (u32), interval (char[4],
+ * klines only), count (u64), symbol (char[24]), 16 reserved bytes, then the
+ * columns in the order of TradeColumns or KlineColumns.
+ */
+class HistoryFile {
+public:
+    /**
+     * @brief Map a file
+     * @param path File written by writeTrades/writeKlines
+     * @throws std::runtime_error if the file cannot be mapped or is not a valid history file
+     */
+    explicit HistoryFile(const std::string& path);
+
+    /**
+     * @brief Destructor; unmaps the file
+     */
+    ~HistoryFile();
+
+    HistoryFile(const HistoryFile&) = delete;
+    HistoryFile& operator=(const HistoryFile&) = delete;
+
+    HistoryKind kind() const { return kind_; }
+    size_t size() const { return count_; }
+    const std::string& symbol() const { return symbol_; }
+    /// Kline interval such as "1m"; empty for trades
+    const std::string& interval() const { return interval_; }
+
+    /**
+     * @brief Columns of a trade file
+     * @throws std::runtime_error if the file holds klines
+     */
+    const TradeColumns& trades() const;
+
+    /**
+     * @brief Columns of a kline file
+     * @throws std::runtime_error if the file holds trades
+     */
+    const KlineColumns& klines() const;
+
+    /**
+     * @brief Write trades, oldest first, to a new history file
+     * @throws std::runtime_error if the file cannot be written
+     */
+    static void writeTrades(const std::string& path, const std::string& symbol,
+                            const std::vector<TradeEvent>& trades);
+
+    /**
+     * @brief Write klines, oldest first, to a new history file
+     * @throws std::runtime_error if the file cannot be written
+     */
+    static void writeKlines(const std::string& path, const std::string& symbol, const std::string& interval,
+                            const std::vector<KlineEvent>& klines);
+
+    /**
+     * @brief Read klines from a CSV file as published at data.binance.vision
+     *
+     * Rows are open time, open, high, low, close, volume, close time, ...;
+     * a header row is skipped. Times in microseconds (newer spot files) are
+     * converted to milliseconds.
+     * @throws std::runtime_error if the file cannot be read or a row is malformed
+     */
+    static std::vector<KlineEvent> readKlineCsv(const std::string& path);
+
+private:
+    void* data_ = nullptr;
+    size_t length_ = 0;
+    HistoryKind kind_ = HistoryKind::TRADES;
+    size_t count_ = 0;
+    std::string symbol_;
+    std::string interval_;
+    TradeColumns trades_;
+    KlineColumns klines_;
+};
+
+} // namespace binance
+
+#endif // HISTORY_FILE_H
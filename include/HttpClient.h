@@ -5,12 +5,140 @@
 #include <map>
 #include <functional>
 #include <memory>
+#include <future>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include "LatencyHistogram.h"
 
 namespace binance {
 
+/**
+ * @enum HttpMethod
+ * @brief HTTP request methods used by the REST API
+ */
+enum class HttpMethod {
+    GET,
+    POST,
+    PUT,
+    DEL
+};
+
+/**
+ * @enum RateLimitType
+ * @brief Exchange limits reported through response headers
+ */
+enum class RateLimitType {
+    REQUEST_WEIGHT,  // X-MBX-USED-WEIGHT-<interval>
+    ORDERS           // X-MBX-ORDER-COUNT-<interval>
+};
+
+/**
+ * @struct RateLimitUsage
+ * @brief One usage counter reported by the exchange
+ */
+struct RateLimitUsage {
+    RateLimitType type;
+    int64_t intervalSeconds;  // Window length, e.g. 60 for "1M"
+    int64_t count;            // Usage in the current window
+};
+
+/**
+ * @struct ResponseInfo
+ * @brief Status and rate-limit headers of a completed response
+ *
+ * Filled while the headers arrive, in fixed storage, so capturing them costs
+ * no allocation.
+ */
+struct ResponseInfo {
+    static constexpr size_t MAX_USAGES = 8;
+
+    long status = 0;             // HTTP status, 0 if the transfer failed
+    int64_t retryAfter = -1;     // Retry-After in seconds, -1 if absent
+    size_t usageCount = 0;
+    RateLimitUsage usages[MAX_USAGES];
+
+    /**
+     * @brief Record a raw header line if it is a rate-limit header
+     * @param line Header line as received, e.g. "x-mbx-used-weight-1m: 23\r\n"
+     * @return True if the line was recognized
+     */
+    bool parseHeader(std::string_view line);
+};
+
+/**
+ * @struct Response
+ * @brief Outcome of a request made without exceptions
+ *
+ * Exchange rejects come back as a status and error code instead of a
+ * thrown exception, so handling an expected reject (-2010, -1013, ...)
+ * costs the same as handling a fill. Pass the same object to every call to
+ * borrow its body buffer: each request clears the body but keeps its
+ * capacity, so steady-state requests do not allocate for the response.
+ * Move the body out to keep it.
+ */
+struct Response {
+    long status = 0;                        // HTTP status, 0 if the transfer failed
+    int64_t code = 0;                       // Binance error code of a 4xx/5xx body, 0 if none
+    const char* transportError = nullptr;   // curl's static message when status is 0
+    ResponseInfo headers;                   // Rate-limit and Retry-After headers
+    std::string body;
+
+    /**
+     * @brief Whether the request succeeded with a 2xx status
+     */
+    bool ok() const { return status >= 200 && status < 300; }
+
+    /**
+     * @brief The "msg" of an error body, raw as sent; empty if there is none
+     */
+    std::string_view message() const;
+
+    /**
+     * @brief Reset every field, keeping the body's capacity
+     */
+    void clear();
+};
+
+/**
+ * @enum HttpPhase
+ * @brief Phases of a request as timed by curl, indexing EndpointMetrics::phases
+ */
+enum class HttpPhase {
+    DNS,         // Name lookup; new connections only
+    CONNECT,     // TCP connect; new connections only
+    TLS,         // TLS handshake; new HTTPS connections only
+    FIRST_BYTE,  // From the request being sent to the first response byte
+    TRANSFER,    // From the first response byte to the last
+    TOTAL        // Whole request, including any connection setup
+};
+
+constexpr size_t HTTP_PHASE_COUNT = 6;
+
+/**
+ * @struct EndpointMetrics
+ * @brief Counters and phase latencies of the requests sent to one method and path
+ */
+struct EndpointMetrics {
+    HttpMethod method;
+    std::string path;                            // URL path without the query, e.g. "/api/v3/order"
+    uint64_t requests = 0;
+    uint64_t failures = 0;                       // Transport errors and HTTP status >= 400
+    uint64_t reusedConnections = 0;              // Requests sent on an already open connection
+    uint64_t bytesSent = 0;                      // Request headers and body
+    uint64_t bytesReceived = 0;                  // Response headers and body
+    LatencySummary phases[HTTP_PHASE_COUNT];     // Microseconds, indexed by HttpPhase
+};
+
 /**
  * @class HttpClient
  * @brief HTTP client for making RESTful API requests
+ *
+ * Requests are served from a pool of pre-configured CURL handles, so
+ * several threads may issue requests concurrently. Each handle keeps its
+ * connections alive between calls; the handles share one DNS cache and TLS
+ * session cache, so a handle that has to connect skips the lookup and
+ * resumes the TLS session.
  */
 class HttpClient {
 public:
@@ -26,10 +154,39 @@ public:
     
     /**
      * @brief Initializes the HTTP client
+     * @param poolSize Number of CURL handles to pre-configure
      * @return True if initialization succeeds, false otherwise
      */
-    bool init();
+    bool init(size_t poolSize = 4);
+
+    /**
+     * @brief Opens a connection to the host on every pooled handle so later requests skip DNS and TLS setup
+     * @param url Any cheap URL on the target host, requested with HEAD
+     * @return True if every connection was established
+     */
+    bool warmUp(const std::string& url);
     
+    /**
+     * @brief Set headers sent with every request
+     *
+     * The header list is built once and reused, so requests that pass no
+     * headers of their own do no per-request header work. Call before
+     * issuing requests; it is not synchronized with requests in flight.
+     * @param headers Map of HTTP headers
+     */
+    void setDefaultHeaders(const std::map<std::string, std::string>& headers);
+
+    /**
+     * @brief Set a callback that sees the status and rate-limit headers of every response
+     *
+     * Called for successful and failed responses alike, before an error is
+     * thrown, from the requesting thread or (for asynchronous requests) the
+     * event loop thread, so it must be cheap and thread-safe. Call before
+     * issuing requests; it is not synchronized with requests in flight.
+     * @param observer Callback receiving the captured response info
+     */
+    void setResponseObserver(std::function<void(const ResponseInfo&)> observer);
+
     /**
      * @brief Perform HTTP GET request
      * @param url The URL to request
@@ -56,6 +213,92 @@ public:
      */
     std::string del(const std::string& url, const std::map<std::string, std::string>& headers = {});
 
+    /**
+     * @brief Perform a request with the default headers, borrowing the body buffer
+     * @param method HTTP method
+     * @param url NUL-terminated URL
+     * @param data Request body (POST only); read in place, not copied
+     * @param size Body size in bytes
+     * @return Response string
+     */
+    std::string request(HttpMethod method, const char* url, const char* data = nullptr, size_t size = 0);
+
+    /**
+     * @brief Perform a request like request(), reporting failure in the response instead of throwing
+     * @param method HTTP method
+     * @param url NUL-terminated URL
+     * @param response Receives the outcome; its body buffer is reused
+     * @param data Request body (POST only); read in place, not copied
+     * @param size Body size in bytes
+     * @return response.ok()
+     * @throws std::runtime_error only if no CURL handle can be created
+     */
+    bool tryRequest(HttpMethod method, const char* url, Response& response,
+                    const char* data = nullptr, size_t size = 0);
+
+    /**
+     * @brief Queue an HTTP GET request on the asynchronous event loop
+     *
+     * Asynchronous requests are driven by a single curl multi handle on a
+     * background thread; over HTTPS they are multiplexed onto one HTTP/2
+     * connection, so a burst of N requests costs roughly one round trip.
+     * @param url The URL to request
+     * @param headers Map of HTTP headers
+     * @return Future holding the response string, or the error the blocking call would throw
+     */
+    std::future<std::string> getAsync(const std::string& url,
+                                      const std::map<std::string, std::string>& headers = {});
+
+    /**
+     * @brief Queue an HTTP POST request on the asynchronous event loop
+     * @param url The URL to request
+     * @param data The POST data string
+     * @param headers Map of HTTP headers
+     * @return Future holding the response string
+     */
+    std::future<std::string> postAsync(const std::string& url, const std::string& data = "",
+                                       const std::map<std::string, std::string>& headers = {});
+
+    /**
+     * @brief Queue an HTTP DELETE request on the asynchronous event loop
+     * @param url The URL to request
+     * @param headers Map of HTTP headers
+     * @return Future holding the response string
+     */
+    std::future<std::string> delAsync(const std::string& url,
+                                      const std::map<std::string, std::string>& headers = {});
+
+    /**
+     * @brief Queue a request on the asynchronous event loop and run a hook when it finishes
+     *
+     * The hook runs on the event loop thread before the future becomes
+     * ready, so whatever it settles is visible to a caller woken by get().
+     * It also runs for requests failed when the client shuts down. Keep it
+     * short and do not throw from it; it may queue another request.
+     * @param method Request method
+     * @param url The URL to request
+     * @param data Body sent with POST and PUT
+     * @param onComplete Called with true for a 2xx response, false for an HTTP or
+     *        transport error, and the response body
+     * @return Future holding the response string
+     * @throws std::runtime_error if the client is shutting down
+     */
+    std::future<std::string> requestAsync(HttpMethod method, const std::string& url, const std::string& data,
+                                          std::function<void(bool, std::string_view)> onComplete);
+
+    /**
+     * @brief Per-endpoint request counters and phase latencies
+     *
+     * Every completed request, blocking or asynchronous, records curl's
+     * phase timings, its byte counts and whether its connection was reused
+     * into lock-free histograms kept per method and path. Recording never
+     * blocks; the first request to a new endpoint allocates its histograms.
+     * @param reset Also empty the histograms and counters; requests that
+     *              complete meanwhile land in this snapshot or the next, never both
+     * @return One entry per endpoint seen, in no particular order
+     */
+    std::vector<EndpointMetrics> metrics(bool reset = false);
+
 private:
     class Impl;
     std::unique_ptr<Impl> pImpl;
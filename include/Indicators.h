@@ -0,0 +1,292 @@
+#ifndef INDICATORS_H
+#define INDICATORS_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace binance {
+
+/**
+ * @class RollingWindow
+ * @brief Fixed-capacity ring of the most recent values
+ *
+ * Storage is allocated once by the constructor; pushing never allocates.
+ */
+class RollingWindow {
+public:
+    /**
+     * @brief Constructor
+     * @param capacity Number of values kept
+     * @throws std::invalid_argument if capacity is zero
+     */
+    explicit RollingWindow(size_t capacity);
+
+    /**
+     * @brief Append a value, evicting the oldest once full
+     * @param value Value to append
+     * @param evicted Receives the evicted value, if any
+     * @return True if a value was evicted
+     */
+    bool push(double value, double& evicted) {
+        bool full = size_ == values_.size();
+        evicted = full ? values_[next_] : 0.0;
+        values_[next_] = value;
+        next_ = next_ + 1 == values_.size() ? 0 : next_ + 1;
+        size_ += full ? 0 : 1;
+        return full;
+    }
+
+    /**
+     * @brief Value i places back from the newest (0 is the newest)
+     */
+    double back(size_t i = 0) const {
+        size_t index = next_ + values_.size() - 1 - i;
+        return values_[index >= values_.size() ? index - values_.size() : index];
+    }
+
+    /**
+     * @brief Replace the contents with the last values of a series, oldest first
+     */
+    void assign(const double* values, size_t count);
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return values_.size(); }
+    bool full() const { return size_ == values_.size(); }
+    void clear() { size_ = 0; next_ = 0; }
+
+private:
+    std::vector<double> values_;
+    size_t next_ = 0;
+    size_t size_ = 0;
+};
+
+/**
+ * @class CompensatedSum
+ * @brief Running sum that carries its rounding error (Neumaier), so adding
+ *        and removing values for a long time does not drift
+ */
+class CompensatedSum {
+public:
+    void add(double value) {
+        double total = sum_ + value;
+        compensation_ += std::fabs(sum_) >= std::fabs(value) ? (sum_ - total) + value : (value - total) + sum_;
+        sum_ = total;
+    }
+
+    double value() const { return sum_ + compensation_; }
+    void set(double value) { sum_ = value; compensation_ = 0.0; }
+
+private:
+    double sum_ = 0.0;
+    double compensation_ = 0.0;
+};
+
+/**
+ * @class SMA
+ * @brief Simple moving average with a compensated running sum
+ */
+class SMA {
+public:
+    explicit SMA(size_t period);
+
+    void update(double value);
+
+    /**
+     * @brief Same result, up to rounding, as calling update() for each value, oldest first
+     */
+    void warmUp(const double* values, size_t count);
+
+    /// Average of the values seen so far, up to the last period of them
+    double value() const { return window_.size() ? sum_.value() / window_.size() : 0.0; }
+    bool isReady() const { return window_.full(); }
+    size_t period() const { return window_.capacity(); }
+    void reset();
+
+private:
+    RollingWindow window_;
+    CompensatedSum sum_;
+};
+
+/**
+ * @class EMA
+ * @brief Exponential moving average, seeded with the SMA of the first period values
+ */
+class EMA {
+public:
+    /**
+     * @brief Constructor
+     * @param period Smoothing period; the weight of each new value is 2 / (period + 1)
+     */
+    explicit EMA(size_t period);
+
+    void update(double value);
+
+    /**
+     * @brief Same result, up to rounding, as calling update() for each value
+     */
+    void warmUp(const double* values, size_t count);
+
+    double value() const { return seeded_ ? value_ : (count_ ? seedSum_ / count_ : 0.0); }
+    bool isReady() const { return seeded_; }
+    size_t period() const { return period_; }
+    void reset();
+
+private:
+    size_t period_;
+    double alpha_;
+    double value_ = 0.0;
+    double seedSum_ = 0.0;
+    size_t count_ = 0;
+    bool seeded_ = false;
+};
+
+/**
+ * @class VWAP
+ * @brief Volume-weighted average price over the last period trades
+ */
+class VWAP {
+public:
+    explicit VWAP(size_t period);
+
+    void update(double price, double quantity);
+
+    /**
+     * @brief Same result, up to rounding, as calling update() for each trade, oldest first
+     */
+    void warmUp(const double* prices, const double* quantities, size_t count);
+
+    double value() const;
+    double volume() const { return volume_.value(); }
+    bool isReady() const { return quantities_.full(); }
+    void reset();
+
+private:
+    RollingWindow prices_;
+    RollingWindow quantities_;
+    CompensatedSum notional_;
+    CompensatedSum volume_;
+};
+
+/**
+ * @class RollingVariance
+ * @brief Mean and variance of the last period values (Welford's method over a sliding window)
+ */
+class RollingVariance {
+public:
+    explicit RollingVariance(size_t period);
+
+    void update(double value);
+
+    /**
+     * @brief Same result, up to rounding, as calling update() for each value
+     */
+    void warmUp(const double* values, size_t count);
+
+    double mean() const { return mean_; }
+    /// Population variance
+    double variance() const;
+    /// Sample variance (divides by n - 1)
+    double sampleVariance() const;
+    double stddev() const;
+    bool isReady() const { return window_.full(); }
+    size_t period() const { return window_.capacity(); }
+    void reset();
+
+private:
+    RollingWindow window_;
+    double mean_ = 0.0;
+    double m2_ = 0.0;
+};
+
+/**
+ * @class BollingerBands
+ * @brief Moving average with bands a number of standard deviations above and below
+ */
+class BollingerBands {
+public:
+    /**
+     * @brief Constructor
+     * @param period Window length
+     * @param width Band distance in population standard deviations
+     */
+    BollingerBands(size_t period, double width = 2.0);
+
+    void update(double value) { stats_.update(value); }
+    void warmUp(const double* values, size_t count) { stats_.warmUp(values, count); }
+
+    double middle() const { return stats_.mean(); }
+    double upper() const { return stats_.mean() + width_ * stats_.stddev(); }
+    double lower() const { return stats_.mean() - width_ * stats_.stddev(); }
+    /// Where the value sits between the bands: 0 at the lower band, 1 at the upper
+    double percentB(double value) const;
+    bool isReady() const { return stats_.isReady(); }
+    void reset() { stats_.reset(); }
+
+private:
+    RollingVariance stats_;
+    double width_;
+};
+
+/**
+ * @class RSI
+ * @brief Relative strength index with Wilder's smoothing
+ */
+class RSI {
+public:
+    explicit RSI(size_t period = 14);
+
+    void update(double price);
+
+    /**
+     * @brief Same result, up to rounding, as calling update() for each price
+     */
+    void warmUp(const double* prices, size_t count);
+
+    /// 0 to 100; 50 until ready
+    double value() const;
+    bool isReady() const { return seeded_; }
+    size_t period() const { return period_; }
+    void reset();
+
+private:
+    size_t period_;
+    double averageGain_ = 0.0;
+    double averageLoss_ = 0.0;
+    double lastPrice_ = 0.0;
+    size_t changes_ = 0;
+    bool hasPrice_ = false;
+    bool seeded_ = false;
+};
+
+namespace indicators {
+
+// Batch kernels behind warmUp(). They use AVX2 when the CPU has it and a
+// scalar loop otherwise; results agree up to floating-point rounding.
+
+/// Sum of the values
+double sum(const double* values, size_t count);
+
+/// Sum of squared differences from a given mean
+double sumSquaredDeviations(const double* values, size_t count, double mean);
+
+/// Sum of a[i] * b[i]
+double dot(const double* a, const double* b, size_t count);
+
+/// Sum of values[i] * decay^(count - 1 - i): the newest value has weight 1
+double decayedSum(const double* values, size_t count, double decay);
+
+/**
+ * @brief Decayed sums of the gains and losses between consecutive prices
+ *
+ * Covers the count - 1 changes between prices[0..count); the newest change
+ * has weight 1.
+ */
+void decayedGainLoss(const double* prices, size_t count, double decay, double& gains, double& losses);
+
+} // namespace indicators
+
+} // namespace binance
+
+#endif // INDICATORS_H
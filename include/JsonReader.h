@@ -0,0 +1,118 @@
+#ifndef JSON_READER_H
+#define JSON_READER_H
+
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+
+namespace binance {
+
+/**
+ * @class JsonReader
+ * @brief Single-pass pull tokenizer over a JSON document
+ *
+ * The reader walks the input once, front to back, and never builds a DOM:
+ * callers ask for the next key or value and get views into the original
+ * buffer. Values the caller does not care about are skipped without being
+ * decoded. String views are returned raw, with escape sequences left as they
+ * appear in the input, which suits the ASCII identifiers and decimal strings
+ * that make up Binance responses.
+ *
+ * The input must outlive every view returned from it. Malformed input throws
+ * std::runtime_error with the byte offset of the problem.
+ */
+class JsonReader {
+public:
+    /**
+     * @brief Constructor
+     * @param json The document to read
+     */
+    explicit JsonReader(std::string_view json);
+
+    /**
+     * @brief Peek at the first character of the next token
+     * @return The character, or '\0' at the end of the input
+     */
+    char peek();
+
+    /**
+     * @brief Consume the '{' that opens an object
+     */
+    void beginObject();
+
+    /**
+     * @brief Advance to the next key of the current object
+     * @param key Set to the raw key on success
+     * @return False (after consuming '}') when the object has no more keys
+     */
+    bool nextKey(std::string_view& key);
+
+    /**
+     * @brief Consume the '[' that opens an array
+     */
+    void beginArray();
+
+    /**
+     * @brief Advance to the next element of the current array
+     * @return False (after consuming ']') when the array has no more elements
+     */
+    bool nextElement();
+
+    /**
+     * @brief Read a string value
+     * @return Raw contents between the quotes
+     */
+    std::string_view readString();
+
+    /**
+     * @brief Read a string, number or literal as text
+     *
+     * Binance sends prices and quantities as strings and ids as numbers; this
+     * returns either without the quotes, so both read the same way.
+     * @return Raw text of the value
+     */
+    std::string_view readScalar();
+
+    /**
+     * @brief Read an integer, quoted or not
+     * @return The value
+     */
+    int64_t readInt();
+
+    /**
+     * @brief Read true or false
+     * @return The value
+     */
+    bool readBool();
+
+    /**
+     * @brief Consume a null if one comes next
+     * @return True if a null was consumed
+     */
+    bool readNull();
+
+    /**
+     * @brief Skip the next value, including nested objects and arrays
+     */
+    void skipValue();
+
+    /**
+     * @brief Byte offset of the read position
+     */
+    size_t offset() const { return static_cast<size_t>(pos_ - begin_); }
+
+private:
+    const char* begin_;
+    const char* pos_;
+    const char* end_;
+
+    void skipWhitespace();
+    void expect(char c);
+    const char* findStringEnd(const char* open) const;
+    std::string_view readToken();
+    [[noreturn]] void fail(const char* what) const;
+};
+
+} // namespace binance
+
+#endif // JSON_READER_H
@@ -0,0 +1,140 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace binance {
+
+/**
+ * @struct LatencySummary
+ * @brief Count, mean and percentiles read from a LatencyHistogram, in its units
+ */
+struct LatencySummary {
+    uint64_t count = 0;
+    double mean = 0.0;
+    int64_t p50 = 0;
+    int64_t p99 = 0;
+    int64_t p999 = 0;
+    int64_t max = 0;
+};
+
+/**
+ * @class LatencyHistogram
+ * @brief Fixed-size log-linear histogram of latencies, in the style of HdrHistogram
+ *
+ * Values below 128 are counted exactly; above that every power of two is
+ * split into 64 buckets, so a reported percentile is within 1/64 (1.6%) of
+ * the true value. Values are usually nanoseconds, and anything above
+ * HIGHEST_TRACKABLE (about 68 seconds in nanoseconds) is counted as
+ * HIGHEST_TRACKABLE.
+ *
+ * Recording is a few relaxed atomic increments, never allocates and is safe
+ * from any number of threads. Reads taken while other threads record see
+ * each value either completely or not at all, but may be a few values
+ * behind.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 6;
+    static constexpr size_t SUB_BUCKET_COUNT = size_t(1) << SUB_BUCKET_BITS;
+    static constexpr int TRACKABLE_BITS = 36;
+    static constexpr int64_t HIGHEST_TRACKABLE = (int64_t(1) << TRACKABLE_BITS) - 1;
+    static constexpr size_t BUCKET_COUNT =
+        size_t(TRACKABLE_BITS - SUB_BUCKET_BITS) * SUB_BUCKET_COUNT + SUB_BUCKET_COUNT;
+
+    /**
+     * @brief Constructor; the histogram starts empty
+     */
+    LatencyHistogram();
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    /**
+     * @brief Count one value; negative values count as zero
+     */
+    void record(int64_t value) {
+        uint64_t clamped = value < 0 ? 0 : value > HIGHEST_TRACKABLE ? HIGHEST_TRACKABLE : value;
+        // The total goes first, so a concurrent drainInto() never takes more than it
+        total_.fetch_add(1, std::memory_order_relaxed);
+        counts_[bucketOf(clamped)].fetch_add(1, std::memory_order_release);
+        sum_.fetch_add(clamped, std::memory_order_relaxed);
+        uint64_t seen = max_.load(std::memory_order_relaxed);
+        while (clamped > seen && !max_.compare_exchange_weak(seen, clamped, std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * @brief Add every value counted by another histogram
+     */
+    void add(const LatencyHistogram& other);
+
+    /**
+     * @brief Move every value counted so far into another histogram, leaving this one empty
+     *
+     * Each bucket is taken with one atomic exchange, so values recorded
+     * concurrently land in one histogram or the other and none are lost.
+     * @param target Histogram receiving the values; must not be recorded to concurrently
+     */
+    void drainInto(LatencyHistogram& target);
+
+    /**
+     * @brief Forget every value; not synchronized with concurrent record() calls
+     */
+    void reset();
+
+    /**
+     * @brief Number of values counted
+     */
+    uint64_t count() const { return total_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Largest value counted, 0 if empty
+     */
+    int64_t max() const { return static_cast<int64_t>(max_.load(std::memory_order_relaxed)); }
+
+    /**
+     * @brief Mean of the values counted, 0 if empty
+     */
+    double mean() const;
+
+    /**
+     * @brief Value at or below which the given percentage of values fall
+     * @param percentile Percentage between 0 and 100, e.g. 99.9
+     * @return Highest value of the bucket holding that rank, capped at max(); 0 if empty
+     */
+    int64_t valueAtPercentile(double percentile) const;
+
+    /**
+     * @brief Count, mean, p50, p99, p99.9 and max in one read
+     */
+    LatencySummary summary() const;
+
+    /**
+     * @brief Bucket a value falls in
+     */
+    static size_t bucketOf(uint64_t value) {
+        if (value < 2 * SUB_BUCKET_COUNT) {
+            return static_cast<size_t>(value);
+        }
+        int shift = 63 - __builtin_clzll(value) - SUB_BUCKET_BITS;
+        return static_cast<size_t>(shift) * SUB_BUCKET_COUNT + static_cast<size_t>(value >> shift);
+    }
+
+    /**
+     * @brief Highest value that falls in a bucket
+     */
+    static int64_t highestInBucket(size_t bucket);
+
+private:
+    std::atomic<uint64_t> counts_[BUCKET_COUNT];
+    std::atomic<uint64_t> total_;
+    std::atomic<uint64_t> sum_;
+    std::atomic<uint64_t> max_;
+};
+
+} // namespace binance
+
+#endif // LATENCY_HISTOGRAM_H
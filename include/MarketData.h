@@ -0,0 +1,151 @@
+#ifndef MARKET_DATA_H
+#define MARKET_DATA_H
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <string_view>
+#include <variant>
+#include <vector>
+#include "Decimal.h"
+
+namespace binance {
+
+/**
+ * @struct SymbolName
+ * @brief Symbol held inline so market events stay trivially copyable
+ */
+struct SymbolName {
+    static constexpr size_t CAPACITY = 23;
+
+    char data[CAPACITY + 1] = {};
+
+    /**
+     * @brief Store a symbol, upper-cased and truncated to CAPACITY characters
+     */
+    void assign(std::string_view symbol);
+
+    std::string_view view() const { return std::string_view(data); }
+    bool operator==(std::string_view symbol) const { return view() == symbol; }
+};
+
+/**
+ * @struct TradeEvent
+ * @brief One trade from a <symbol>@trade stream
+ */
+struct TradeEvent {
+    SymbolName symbol;
+    int64_t eventTime = 0;
+    int64_t tradeId = 0;
+    Decimal price;
+    Decimal quantity;
+    int64_t tradeTime = 0;
+    bool isBuyerMaker = false;
+};
+
+/**
+ * @struct BookTickerEvent
+ * @brief Best bid and ask from a <symbol>@bookTicker stream
+ */
+struct BookTickerEvent {
+    SymbolName symbol;
+    int64_t updateId = 0;
+    Decimal bidPrice;
+    Decimal bidQty;
+    Decimal askPrice;
+    Decimal askQty;
+};
+
+/**
+ * @struct PriceLevel
+ * @brief Price and total quantity at that price; zero quantity removes the level
+ */
+struct PriceLevel {
+    Decimal price;
+    Decimal quantity;
+};
+
+/**
+ * @struct DepthSnapshot
+ * @brief Order book snapshot from GET /api/v3/depth
+ */
+struct DepthSnapshot {
+    int64_t lastUpdateId = 0;
+    std::vector<PriceLevel> bids;  // Best (highest) first
+    std::vector<PriceLevel> asks;  // Best (lowest) first
+};
+
+/**
+ * @struct DepthUpdateEvent
+ * @brief Order book levels from a depth stream
+ *
+ * Diff-depth updates (<symbol>@depth, <symbol>@depth@100ms) can carry any
+ * number of levels; they are split into chunks of at most MAX_LEVELS bids and
+ * MAX_LEVELS asks that share the update ids, and `last` marks the final chunk.
+ * Partial book streams (<symbol>@depth5/10/20) arrive as a single chunk with
+ * `snapshot` set and both update ids equal to the book's lastUpdateId.
+ */
+struct DepthUpdateEvent {
+    static constexpr size_t MAX_LEVELS = 20;
+
+    SymbolName symbol;
+    int64_t eventTime = 0;
+    int64_t firstUpdateId = 0;
+    int64_t finalUpdateId = 0;
+    bool snapshot = false;
+    bool last = true;
+    uint16_t bidCount = 0;
+    uint16_t askCount = 0;
+    PriceLevel bids[MAX_LEVELS];
+    PriceLevel asks[MAX_LEVELS];
+};
+
+/**
+ * @struct KlineEvent
+ * @brief Candlestick update from a <symbol>@kline_<interval> stream
+ */
+struct KlineEvent {
+    SymbolName symbol;
+    char interval[4] = {};  // e.g. "1m", "15m", "1d"
+    int64_t eventTime = 0;
+    int64_t startTime = 0;
+    int64_t closeTime = 0;
+    Decimal open;
+    Decimal high;
+    Decimal low;
+    Decimal close;
+    Decimal volume;
+    Decimal quoteVolume;
+    int64_t tradeCount = 0;
+    bool closed = false;  // True once the candle is final
+};
+
+/**
+ * @brief A decoded market data event
+ */
+using MarketEvent = std::variant<TradeEvent, BookTickerEvent, DepthUpdateEvent, KlineEvent>;
+
+/**
+ * @brief Decode a combined-stream message ({"stream": ..., "data": ...})
+ *
+ * The stream name decides how the payload is read, so bookTicker and partial
+ * depth payloads, which carry no event type, are recognized too. Messages for
+ * other streams and subscription replies produce no events.
+ * @param message Raw WebSocket text message
+ * @param sink Called once per decoded event (more than once for large depth updates)
+ * @return Number of events produced
+ * @throws std::runtime_error if a recognized payload is malformed
+ */
+size_t parseStreamMessage(std::string_view message, const std::function<void(const MarketEvent&)>& sink);
+
+/**
+ * @brief Parse a REST depth snapshot
+ * @param json Response of GET /api/v3/depth
+ * @return The snapshot
+ * @throws std::runtime_error if the response is malformed
+ */
+DepthSnapshot parseDepthSnapshot(std::string_view json);
+
+} // namespace binance
+
+#endif // MARKET_DATA_H
@@ -0,0 +1,137 @@
+#ifndef MARKET_DATA_STREAM_H
+#define MARKET_DATA_STREAM_H
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "MarketData.h"
+#include "RingBuffer.h"
+
+namespace binance {
+
+/// Queue of decoded events for one consumer thread
+using MarketEventQueue = SpscRingBuffer<MarketEvent>;
+
+/**
+ * @class MarketDataStream
+ * @brief WebSocket market data client publishing typed events to consumer threads
+ *
+ * A dedicated I/O thread holds one combined-stream connection, decodes each
+ * message into MarketEvent values and copies every event into each
+ * consumer's single-producer single-consumer ring buffer, so a strategy
+ * thread reads market data without locks or allocation. A consumer that
+ * falls behind loses events rather than stalling the others; drops are
+ * counted. The connection is re-established with backoff if it drops or
+ * goes quiet for longer than the read timeout.
+ */
+class MarketDataStream {
+public:
+    /**
+     * @brief Constructor
+     * @param base_url Stream endpoint, e.g. "wss://stream.binance.com:9443" or
+     *        "wss://stream.testnet.binance.vision"
+     */
+    explicit MarketDataStream(const std::string& base_url = "wss://stream.binance.com:9443");
+
+    /**
+     * @brief Destructor; stops the I/O thread
+     */
+    ~MarketDataStream();
+
+    MarketDataStream(const MarketDataStream&) = delete;
+    MarketDataStream& operator=(const MarketDataStream&) = delete;
+
+    /**
+     * @brief Add streams, e.g. "btcusdt@trade"
+     *
+     * Before start() the streams are part of the connection URL; while
+     * running they are requested with a SUBSCRIBE message.
+     * @param streams Stream names (see the *Stream helpers)
+     */
+    void subscribe(const std::vector<std::string>& streams);
+
+    /**
+     * @brief Register a consumer; call before start()
+     * @param capacity Minimum queue length; rounded up to a power of two
+     * @return The consumer's queue, to be drained by one thread
+     */
+    std::shared_ptr<MarketEventQueue> addConsumer(size_t capacity = 4096);
+
+    /**
+     * @brief How long the connection may go without data before it is reconnected
+     *
+     * The exchange pings every 20 seconds, so the default of 60 seconds only
+     * passes on a connection that dropped without being closed. 0 waits forever.
+     */
+    void setReadTimeout(std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Start the I/O thread
+     * @throws std::runtime_error if no streams were subscribed
+     */
+    void start();
+
+    /**
+     * @brief Stop the I/O thread and close the connection
+     */
+    void stop();
+
+    /**
+     * @brief Whether the connection is currently open
+     */
+    bool isConnected() const;
+
+    /**
+     * @brief Messages received since start()
+     */
+    uint64_t messagesReceived() const;
+
+    /**
+     * @brief Events not delivered because a consumer queue was full
+     */
+    uint64_t eventsDropped() const;
+
+    /**
+     * @brief Messages that failed to decode and were skipped
+     */
+    uint64_t decodeErrors() const;
+
+    /**
+     * @brief Connections that failed to open or ended with an error
+     */
+    uint64_t connectionErrors() const;
+
+    /**
+     * @brief Message of the most recent connection error, empty if there was none
+     */
+    std::string lastError() const;
+
+    /**
+     * @brief Number of times the connection was re-established
+     */
+    uint64_t reconnects() const;
+
+    /// "<symbol>@trade"
+    static std::string tradeStream(const std::string& symbol);
+    /// "<symbol>@bookTicker"
+    static std::string bookTickerStream(const std::string& symbol);
+    /**
+     * @brief Depth stream name
+     * @param symbol Trading pair symbol
+     * @param levels 0 for diff-depth updates, or 5, 10 or 20 for partial book snapshots
+     * @param fast True for 100ms updates instead of 1000ms
+     */
+    static std::string depthStream(const std::string& symbol, int levels = 0, bool fast = true);
+    /// "<symbol>@kline_<interval>"
+    static std::string klineStream(const std::string& symbol, const std::string& interval);
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace binance
+
+#endif // MARKET_DATA_STREAM_H
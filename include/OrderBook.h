@@ -0,0 +1,183 @@
+#ifndef ORDER_BOOK_H
+#define ORDER_BOOK_H
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+#include "Decimal.h"
+#include "MarketData.h"
+
+namespace binance {
+
+/**
+ * @enum DepthApplyResult
+ * @brief What OrderBook::apply did with a depth event
+ */
+enum class DepthApplyResult {
+    APPLIED,   // The book now reflects the event
+    IGNORED,   // Older than the book (already contained in the snapshot)
+    BUFFERED,  // Held until a snapshot arrives
+    GAP        // Updates were missed; the book is out of sync until the next snapshot
+};
+
+/**
+ * @class OrderBook
+ * @brief Local L2 order book kept in sync from a REST snapshot and diff-depth updates
+ *
+ * Prices are converted to integer ticks. Each side keeps a window of
+ * quantities indexed directly by tick, positioned around its best price, plus
+ * a bitmap of non-empty ticks, so updating a level is an array store and
+ * finding the next level after the best one is cleared is a scan over a few
+ * 64-bit words. Levels outside the window (deep in the book) live in a small
+ * sorted vector; the window re-centers when the best price drifts toward its
+ * edge. The best bid and ask are kept current on every update, so reading
+ * them is O(1), and the top N levels are O(N).
+ *
+ * Synchronization follows the exchange's procedure: updates received before
+ * the snapshot are buffered and replayed, updates already in the snapshot are
+ * ignored, and a break in the update id sequence marks the book out of sync.
+ * With a snapshot source set, the book fetches a new snapshot itself.
+ *
+ * Not thread-safe; use it from the thread that consumes the depth stream.
+ */
+class OrderBook {
+public:
+    /**
+     * @brief Constructor
+     * @param symbol Trading pair symbol
+     * @param tickSize The symbol's price tick size (PRICE_FILTER tickSize)
+     * @param windowTicks Ticks held in each side's direct-indexed window; rounded up to a multiple of 64
+     * @throws std::invalid_argument if the tick size is not positive
+     */
+    OrderBook(const std::string& symbol, Decimal tickSize, size_t windowTicks = 32768);
+
+    /**
+     * @brief Set a callback that returns a fresh snapshot, e.g. from BinanceAPI::getOrderBookTyped
+     *
+     * When set, apply() fetches a snapshot itself whenever the book is out of
+     * sync. The call is synchronous, on the thread calling apply().
+     */
+    void setSnapshotSource(std::function<DepthSnapshot()> source);
+
+    /**
+     * @brief Replace the book with a snapshot and replay buffered updates
+     * @return True if the book is in sync afterwards
+     */
+    bool applySnapshot(const DepthSnapshot& snapshot);
+
+    /**
+     * @brief Apply one depth event (or chunk of one) from the stream
+     *
+     * Partial book events (snapshot set) replace the book outright. Chunks
+     * after the first of a split update get the first chunk's result.
+     * @throws Whatever the snapshot source throws
+     */
+    DepthApplyResult apply(const DepthUpdateEvent& event);
+
+    /**
+     * @brief Set the quantity at a price directly, bypassing sequence checks
+     * @param isBid True for the bid side
+     * @param price Price; rounded down to the tick size
+     * @param quantity New total quantity; zero removes the level
+     */
+    void setLevel(bool isBid, Decimal price, Decimal quantity);
+
+    /**
+     * @brief Remove all levels and mark the book out of sync
+     */
+    void clear();
+
+    bool isSynced() const { return synced_; }
+    int64_t lastUpdateId() const { return lastUpdateId_; }
+    const std::string& symbol() const { return symbol_; }
+    Decimal tickSize() const { return Decimal::fromUnits(tickUnits_); }
+
+    bool hasBid() const { return bids_.best != NONE; }
+    bool hasAsk() const { return asks_.best != NONE; }
+
+    /**
+     * @brief Highest bid; zero price and quantity if the side is empty
+     */
+    PriceLevel bestBid() const { return levelAt(bids_, bids_.best); }
+
+    /**
+     * @brief Lowest ask; zero price and quantity if the side is empty
+     */
+    PriceLevel bestAsk() const { return levelAt(asks_, asks_.best); }
+
+    /**
+     * @brief Midpoint of the best bid and ask (not rounded to the tick)
+     */
+    Decimal midPrice() const;
+
+    /**
+     * @brief Copy up to count best bids, best first
+     * @return Number of levels written
+     */
+    size_t topBids(PriceLevel* out, size_t count) const { return top(bids_, out, count); }
+
+    /**
+     * @brief Copy up to count best asks, best first
+     * @return Number of levels written
+     */
+    size_t topAsks(PriceLevel* out, size_t count) const { return top(asks_, out, count); }
+
+    /**
+     * @brief Number of non-empty levels on a side
+     */
+    size_t levelCount(bool isBid) const { return (isBid ? bids_ : asks_).count; }
+
+private:
+    static constexpr int64_t NONE = INT64_MIN;
+    static constexpr size_t MAX_PENDING = 4096;  // Buffered chunks kept while out of sync
+
+    struct FarLevel {
+        int64_t tick;
+        int64_t quantity;
+    };
+
+    struct Side {
+        bool isBid = false;
+        int64_t base = 0;                 // Tick of window slot 0
+        std::vector<int64_t> quantities;  // Units per window slot
+        std::vector<uint64_t> occupied;   // One bit per window slot
+        std::vector<FarLevel> far;        // Levels outside the window, ascending tick
+        int64_t best = NONE;
+        size_t count = 0;
+    };
+
+    std::string symbol_;
+    int64_t tickUnits_;
+    size_t windowTicks_;
+    Side bids_;
+    Side asks_;
+
+    bool synced_ = false;
+    bool resyncing_ = false;
+    bool inMessage_ = false;            // Further chunks of the current update follow
+    int64_t messageUpdateId_ = 0;       // Final update id of the current update
+    DepthApplyResult messageResult_ = DepthApplyResult::IGNORED;
+    int64_t lastUpdateId_ = 0;
+    std::vector<DepthUpdateEvent> pending_;
+    std::function<DepthSnapshot()> snapshotSource_;
+
+    int64_t toTick(Decimal price) const;
+    PriceLevel levelAt(const Side& side, int64_t tick) const;
+    int64_t quantityAt(const Side& side, int64_t tick) const;
+    void set(Side& side, int64_t tick, int64_t quantity);
+    void position(Side& side, int64_t anchor);
+    void recenter(Side& side, int64_t anchor);
+    void keepBestInWindow(Side& side);
+    int64_t nextBest(const Side& side, int64_t from) const;
+    size_t top(const Side& side, PriceLevel* out, size_t count) const;
+    void applyLevels(const DepthUpdateEvent& event);
+    void resetSide(Side& side);
+    void buffer(const DepthUpdateEvent& event);
+    void resync();
+};
+
+} // namespace binance
+
+#endif // ORDER_BOOK_H
@@ -0,0 +1,109 @@
+#ifndef ORDER_GATEWAY_H
+#define ORDER_GATEWAY_H
+
+#include <string>
+#include <functional>
+#include <memory>
+#include "BinanceTypes.h"
+#include "UserData.h"
+
+namespace binance {
+
+class BinanceAPI;
+class ExchangeInfoCache;
+
+/**
+ * @class OrderGateway
+ * @brief Where strategies send orders
+ *
+ * Calls return as soon as the order is on its way; the outcome arrives
+ * later as an OrderUpdateEvent, delivered when the owner of the gateway
+ * calls poll(). Live trading sends orders to the exchange, backtests to a
+ * simulated one, and the strategy cannot tell the difference.
+ */
+class OrderGateway {
+public:
+    virtual ~OrderGateway() = default;
+
+    /**
+     * @brief Send a new order
+     * @param order Order parameters; a client order id is generated if none is set
+     * @return The order's client order id
+     */
+    virtual std::string placeOrder(const OrderParams& order) = 0;
+
+    /**
+     * @brief Cancel an order by client order id
+     */
+    virtual void cancelOrder(const std::string& symbol, const std::string& clientOrderId) = 0;
+
+    /**
+     * @brief Deliver the outcome of requests that have completed
+     * @param sink Called once per order update
+     * @return Number of updates delivered
+     */
+    virtual size_t poll(const std::function<void(const OrderUpdateEvent&)>& sink) = 0;
+};
+
+/**
+ * @class RestOrderGateway
+ * @brief OrderGateway over the asynchronous REST methods of BinanceAPI
+ *
+ * Requests are multiplexed on the client's event loop, so placing an order
+ * costs the strategy thread only the signing. Each response becomes one
+ * order update; a rejected request becomes an update with status REJECTED
+ * and the exchange's error code, as does an order the client's risk engine
+ * or rate limiter stops before it is sent. Orders that fail after passing
+ * the risk engine give their reservation back. Use from one thread.
+ */
+class RestOrderGateway : public OrderGateway {
+public:
+    /**
+     * @brief Constructor
+     * @param api Client used to send orders; must outlive the gateway
+     * @param clientIdPrefix Prefix for generated client order ids
+     */
+    explicit RestOrderGateway(BinanceAPI& api, const std::string& clientIdPrefix = "rt");
+
+    /**
+     * @brief Destructor; waits for requests still in flight
+     */
+    ~RestOrderGateway() override;
+
+    RestOrderGateway(const RestOrderGateway&) = delete;
+    RestOrderGateway& operator=(const RestOrderGateway&) = delete;
+
+    std::string placeOrder(const OrderParams& order) override;
+    void cancelOrder(const std::string& symbol, const std::string& clientOrderId) override;
+    size_t poll(const std::function<void(const OrderUpdateEvent&)>& sink) override;
+
+    /**
+     * @brief Round and check orders against the symbol filters before sending
+     *
+     * Prices are snapped to the tick size away from the market and
+     * quantities down to the step size. An order that still breaks a filter
+     * is not sent: it comes back from poll() as REJECTED with error code
+     * -1013, as the exchange would have answered. Symbols the cache does not
+     * know are sent as they are.
+     * @param filters Loaded filters, which must outlive the gateway; nullptr turns checking off
+     */
+    void setFilters(const ExchangeInfoCache* filters);
+
+    /**
+     * @brief Orders rejected locally by the filters instead of being sent
+     */
+    uint64_t filterRejects() const;
+
+    /**
+     * @brief Requests sent whose responses have not been delivered yet
+     */
+    size_t inFlight() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace binance
+
+#endif // ORDER_GATEWAY_H
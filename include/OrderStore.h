@@ -0,0 +1,218 @@
+#ifndef ORDER_STORE_H
+#define ORDER_STORE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+#include "BinanceTypes.h"
+#include "Decimal.h"
+#include "UserData.h"
+
+namespace binance {
+
+/**
+ * @struct OrderState
+ * @brief Last known state of one order
+ */
+struct OrderState {
+    SymbolName symbol;
+    ClientOrderId clientOrderId;
+    int64_t orderId = -1;
+    OrderSide side = OrderSide::BUY;
+    OrderType type = OrderType::LIMIT;
+    OrderStatus status = OrderStatus::NEW;
+    Decimal price;
+    Decimal quantity;
+    Decimal executedQty;
+    Decimal cumulativeQuoteQty;
+    int64_t updateTime = 0;          // Event time of the last update applied
+
+    /// Whether the order is live: working, or waiting to be placed by its list
+    bool isOpen() const {
+        return status == OrderStatus::NEW || status == OrderStatus::PARTIALLY_FILLED ||
+               status == OrderStatus::PENDING_CANCEL || status == OrderStatus::PENDING_NEW;
+    }
+};
+
+/**
+ * @struct OrderExecution
+ * @brief Quantity an update newly executed, in the base and the quote asset
+ */
+struct OrderExecution {
+    Decimal quantity;
+    Decimal quoteQuantity;
+
+    bool empty() const { return quantity.isZero(); }
+};
+
+/**
+ * @enum OrderApplyResult
+ * @brief What OrderStore::apply did with an update
+ */
+enum class OrderApplyResult {
+    APPLIED,             // The store now reflects the update
+    STALE,               // Already known, or older than what is known; e.g. a response after the stream
+    INVALID_TRANSITION,  // The status change is not one an order can make
+    IGNORED,             // Carries no order state: no order id, or a rejected cancel
+    FULL                 // A new order, but every slot holds a live order
+};
+
+/**
+ * @class OrderStore
+ * @brief In-memory table of our orders, kept current from order updates
+ *
+ * Updates from the user data stream and from REST responses may arrive in
+ * either order and more than once. Each update is checked against the
+ * order's current state: one that executes less than is already known, or
+ * moves the status backwards, is stale and dropped, and a status change the
+ * exchange never makes (e.g. out of FILLED) is counted and dropped. The
+ * first update seen for an order creates it in whatever state it reports.
+ *
+ * Orders live in a fixed array of slots, indexed by two open-addressing
+ * hash tables (linear probing, backward-shift deletion) keyed by orderId and
+ * by clientOrderId, so a lookup is a hash and usually one or two probes with
+ * no allocation. When every slot is taken, the order that finished longest
+ * ago is forgotten to make room. Client order ids are assumed unique across
+ * symbols; an id reused after its order finished refers to the newer order.
+ *
+ * Not thread-safe; use it from the thread that consumes the order updates.
+ */
+class OrderStore {
+public:
+    /**
+     * @brief Constructor
+     * @param capacity Orders remembered at once, open and finished
+     * @throws std::invalid_argument if capacity is zero
+     */
+    explicit OrderStore(size_t capacity = 4096);
+
+    /**
+     * @brief Apply one order update
+     * @param update From the user data stream or an order gateway
+     * @param fill If set, receives the quantity this update newly executed
+     * @return What was done with the update
+     */
+    OrderApplyResult apply(const OrderUpdateEvent& update, OrderExecution* fill = nullptr);
+
+    /**
+     * @brief Order with an exchange order id, or nullptr if not known
+     */
+    const OrderState* find(int64_t orderId) const {
+        uint32_t hash = hashId(orderId);
+        for (size_t i = hash & mask_;; i = (i + 1) & mask_) {
+            const IndexEntry& entry = byId_[i];
+            if (entry.slot == EMPTY) return nullptr;
+            if (entry.hash == hash && slots_[entry.slot].orderId == orderId) return &slots_[entry.slot];
+        }
+    }
+
+    /**
+     * @brief Order with a client order id, or nullptr if not known
+     */
+    const OrderState* findByClientId(std::string_view clientOrderId) const {
+        uint32_t hash = hashClientId(clientOrderId);
+        for (size_t i = hash & mask_;; i = (i + 1) & mask_) {
+            const IndexEntry& entry = byClientId_[i];
+            if (entry.slot == EMPTY) return nullptr;
+            if (entry.hash == hash && slots_[entry.slot].clientOrderId == clientOrderId) {
+                return &slots_[entry.slot];
+            }
+        }
+    }
+
+    /**
+     * @brief Call a function with every live order
+     */
+    template <typename Function>
+    void forEachOpen(Function&& function) const {
+        for (const OrderState& order : slots_) {
+            if (order.orderId >= 0 && order.isOpen()) function(order);
+        }
+    }
+
+    /**
+     * @brief Forget every order and reset the counters
+     */
+    void clear();
+
+    /// Orders held, open and finished
+    size_t size() const { return size_; }
+    /// Orders that are still live
+    size_t openCount() const { return openCount_; }
+    size_t capacity() const { return slots_.size(); }
+
+    /// Updates dropped as stale
+    uint64_t staleUpdates() const { return stale_; }
+    /// Updates dropped for an impossible status change
+    uint64_t invalidTransitions() const { return invalid_; }
+    /// Finished orders forgotten to make room
+    uint64_t evictions() const { return evictions_; }
+
+    /**
+     * @brief Whether an order can go from one status to another
+     *
+     * PENDING_NEW is only ever a first status; FILLED, CANCELED, REJECTED,
+     * EXPIRED and EXPIRED_IN_MATCH are final. A PARTIALLY_FILLED order may
+     * stay PARTIALLY_FILLED as it fills further.
+     */
+    static bool isValidTransition(OrderStatus from, OrderStatus to);
+
+    /**
+     * @brief Whether a status is final
+     */
+    static bool isFinal(OrderStatus status) {
+        return status == OrderStatus::FILLED || status == OrderStatus::CANCELED ||
+               status == OrderStatus::REJECTED || status == OrderStatus::EXPIRED ||
+               status == OrderStatus::EXPIRED_IN_MATCH;
+    }
+
+private:
+    static constexpr uint32_t EMPTY = UINT32_MAX;
+
+    struct IndexEntry {
+        uint32_t slot = EMPTY;
+        uint32_t hash = 0;  // Compared before the slot is read, to skip most mismatches
+    };
+
+    static uint32_t hashId(int64_t orderId) {
+        // splitmix64 finalizer; exchange ids are sequential
+        uint64_t x = static_cast<uint64_t>(orderId);
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return static_cast<uint32_t>(x ^ (x >> 31));
+    }
+
+    static uint32_t hashClientId(std::string_view id) {
+        // FNV-1a
+        uint64_t hash = 14695981039346656037ULL;
+        for (char c : id) {
+            hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+        }
+        return static_cast<uint32_t>(hash ^ (hash >> 32));
+    }
+
+    uint32_t insert(const OrderUpdateEvent& update);
+    void evictOldest();
+    void indexClientId(uint32_t slot);
+    void erase(std::vector<IndexEntry>& table, size_t position);
+    size_t positionOf(int64_t orderId) const;
+
+    std::vector<OrderState> slots_;          // orderId -1 marks a free slot
+    std::vector<IndexEntry> byId_;
+    std::vector<IndexEntry> byClientId_;
+    size_t mask_ = 0;
+    std::vector<uint32_t> freeSlots_;
+    std::vector<uint32_t> finished_;         // Ring of slots in the order their orders finished
+    size_t finishedHead_ = 0;
+    size_t finishedCount_ = 0;
+    size_t size_ = 0;
+    size_t openCount_ = 0;
+    uint64_t stale_ = 0;
+    uint64_t invalid_ = 0;
+    uint64_t evictions_ = 0;
+};
+
+} // namespace binance
+
+#endif // ORDER_STORE_H
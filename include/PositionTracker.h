@@ -0,0 +1,141 @@
+#ifndef POSITION_TRACKER_H
+#define POSITION_TRACKER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+#include "BinanceTypes.h"
+#include "Decimal.h"
+#include "OrderStore.h"
+#include "SymbolRegistry.h"
+#include "UserData.h"
+
+namespace binance {
+
+/**
+ * @struct AssetBalance
+ * @brief Free and locked amounts of one asset
+ */
+struct AssetBalance {
+    AssetName asset;
+    Decimal free;
+    Decimal locked;                  // Held by open orders
+    int64_t updateTime = 0;
+
+    Decimal total() const { return free + locked; }
+};
+
+/**
+ * @struct Position
+ * @brief Net quantity of a symbol's base asset bought through our orders, and its cost
+ */
+struct Position {
+    SymbolName symbol;
+    Decimal quantity;                // Bought minus sold; negative when net short
+    Decimal averagePrice;            // Of the open quantity; zero when flat
+    Decimal realizedPnl;             // In the quote asset, from quantity closed at other prices
+    Decimal volume;                  // Base quantity traded either way
+
+    /**
+     * @brief Profit or loss of the open quantity if it were closed at a price
+     */
+    Decimal unrealizedPnl(Decimal markPrice) const { return (markPrice - averagePrice) * quantity; }
+};
+
+/**
+ * @class PositionTracker
+ * @brief Account balances and per-symbol positions, updated incrementally from the user data stream
+ *
+ * Balances are set from outboundAccountPosition events and adjusted by
+ * balanceUpdate deltas. Positions are built from fills as OrderStore::apply
+ * reports them, so a fill seen in both a REST response and an execution
+ * report is counted once; commissions are left to the balances. Positions
+ * use the average cost method: adding to a position moves its average
+ * price, reducing it realizes the difference to the fill price.
+ *
+ * Accounts hold a handful of assets and strategies trade a handful of
+ * symbols, so both are flat arrays searched in order, which takes a few
+ * nanoseconds at these sizes. Given a SymbolRegistry, positions in its
+ * symbols are also indexed by SymbolId, so position(id) and applyFill(id)
+ * are one array index at any number of symbols. Not thread-safe; use it
+ * from the thread that consumes the updates.
+ */
+class PositionTracker {
+public:
+    /**
+     * @brief Constructor
+     * @param symbols Registry whose ids index the positions, which must outlive the tracker; nullptr
+     *        for lookups by name only. Only looked up, so it may be shared with other threads.
+     */
+    explicit PositionTracker(const SymbolRegistry* symbols = nullptr) : symbols_(symbols) {}
+
+    /**
+     * @brief Set or adjust one asset balance
+     */
+    void apply(const BalanceUpdateEvent& update);
+
+    /**
+     * @brief Add a fill to the position of a symbol
+     * @param symbol Trading pair symbol
+     * @param side Side of our order
+     * @param fill Base and quote quantity newly executed, from OrderStore::apply
+     */
+    void applyFill(std::string_view symbol, OrderSide side, const OrderExecution& fill);
+
+    /**
+     * @brief Add a fill to the position of a symbol in the tracker's registry
+     * @throws std::out_of_range if the tracker has no registry or the id is not in it
+     */
+    void applyFill(SymbolId symbol, OrderSide side, const OrderExecution& fill);
+
+    /**
+     * @brief Balance of an asset, or nullptr if none was reported
+     */
+    const AssetBalance* balance(std::string_view asset) const {
+        for (const AssetBalance& entry : balances_) {
+            if (entry.asset == asset) return &entry;
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Position in a symbol, or nullptr if it never traded
+     */
+    const Position* position(std::string_view symbol) const {
+        for (const Position& entry : positions_) {
+            if (entry.symbol == symbol) return &entry;
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Position in a symbol of the tracker's registry, or nullptr if it never traded
+     */
+    const Position* position(SymbolId symbol) const {
+        return symbol < slots_.size() && slots_[symbol] >= 0 ? &positions_[slots_[symbol]] : nullptr;
+    }
+
+    const std::vector<AssetBalance>& balances() const { return balances_; }
+    const std::vector<Position>& positions() const { return positions_; }
+
+    /**
+     * @brief Forget every balance and position
+     */
+    void clear();
+
+private:
+    AssetBalance& balanceOf(std::string_view asset);
+    Position& positionOf(std::string_view symbol);
+    Position& positionOf(SymbolId id, std::string_view symbol);
+    void applyFill(Position& entry, OrderSide side, const OrderExecution& fill);
+
+    const SymbolRegistry* symbols_;
+    std::vector<AssetBalance> balances_;
+    std::vector<Position> positions_;
+    std::vector<int32_t> slots_;             // Index into positions_ by SymbolId, -1 if none
+};
+
+} // namespace binance
+
+#endif // POSITION_TRACKER_H
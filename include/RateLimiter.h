@@ -0,0 +1,158 @@
+#ifndef RATE_LIMITER_H
+#define RATE_LIMITER_H
+
+#include "HttpClient.h"
+#include <atomic>
+#include <cstdint>
+
+namespace binance {
+
+/**
+ * @enum RequestPriority
+ * @brief Scheduling class of a request
+ */
+enum class RequestPriority {
+    HIGH,   // Cancels: always go first and may use the reserved budget
+    NORMAL  // Everything else
+};
+
+/**
+ * @class RateLimiter
+ * @brief Lock-free model of the exchange's request-weight and order-count limits
+ *
+ * Each limit is a counter over a fixed window aligned to the wall clock, which
+ * is how the exchange accounts usage (the X-MBX-USED-WEIGHT-1M counter resets at
+ * the top of each minute). A counter is a single atomic word holding the window
+ * number and the usage in it, so acquiring budget is a compare-and-swap per
+ * limit and never takes a lock. The model is kept honest by feeding it the
+ * usage headers of every response through update().
+ *
+ * Requests that would exceed a limit are paced: acquire() sleeps until the
+ * window rolls over. While a HIGH priority request is waiting, NORMAL requests
+ * hold back, and NORMAL requests never use the last cancel-reserve fraction of
+ * the request weight, so cancels still go out when new orders have run the
+ * budget down.
+ */
+class RateLimiter {
+public:
+    /// Maximum number of limits tracked
+    static constexpr size_t MAX_LIMITS = 8;
+
+    /**
+     * @brief Constructor; starts with the Spot API defaults
+     *
+     * 6000 request weight per minute, 100 orders per 10 seconds and
+     * 200000 orders per day.
+     */
+    RateLimiter();
+
+    RateLimiter(const RateLimiter&) = delete;
+    RateLimiter& operator=(const RateLimiter&) = delete;
+
+    /**
+     * @brief Add or change a limit
+     *
+     * Not synchronized with acquire(); configure before issuing requests.
+     * @param type Limit type
+     * @param intervalSeconds Window length in seconds
+     * @param limit Allowed usage per window
+     * @throws std::invalid_argument if the interval or limit is not positive, or
+     *         MAX_LIMITS limits already exist
+     */
+    void setLimit(RateLimitType type, int64_t intervalSeconds, int64_t limit);
+
+    /**
+     * @brief Fraction of the request weight kept back for HIGH priority requests
+     * @param fraction 0 to 1, default 0.05
+     */
+    void setCancelReserve(double fraction);
+
+    /**
+     * @brief Longest acquire() may wait before giving up
+     * @param milliseconds Default 10000
+     */
+    void setMaxWait(int64_t milliseconds);
+
+    /**
+     * @brief Turn pacing on or off; usage is still tracked when off
+     */
+    void setEnabled(bool enabled);
+
+    /**
+     * @brief Take budget for a request, waiting for it if needed
+     * @param priority Scheduling class
+     * @param weight Request weight
+     * @param orders Number of orders the request places
+     * @throws std::runtime_error if the budget would not be available within the maximum wait
+     */
+    void acquire(RequestPriority priority, int64_t weight, int64_t orders = 0);
+
+    /**
+     * @brief Take budget for a request if it is available now
+     * @param priority Scheduling class
+     * @param weight Request weight
+     * @param orders Number of orders the request places
+     * @param nowMs Current time in milliseconds since the epoch
+     * @return 0 if the budget was taken, otherwise the milliseconds to wait before retrying
+     */
+    int64_t tryAcquire(RequestPriority priority, int64_t weight, int64_t orders, int64_t nowMs);
+
+    /**
+     * @brief Sync the model with the usage the exchange reported
+     *
+     * Reported counters raise the local ones (requests from other processes on
+     * the same key count too); a 429 or 418 with Retry-After blocks all
+     * requests until it expires.
+     * @param info Captured response headers
+     * @param nowMs Current time in milliseconds since the epoch
+     */
+    void update(const ResponseInfo& info, int64_t nowMs);
+
+    /**
+     * @brief Sync with the current time
+     */
+    void update(const ResponseInfo& info) { update(info, nowMilliseconds()); }
+
+    /**
+     * @brief Usage of a limit in the window containing nowMs
+     * @return The usage, or -1 if no such limit is configured
+     */
+    int64_t used(RateLimitType type, int64_t intervalSeconds, int64_t nowMs) const;
+
+    /**
+     * @brief Usage of a limit in the current window
+     */
+    int64_t used(RateLimitType type, int64_t intervalSeconds) const {
+        return used(type, intervalSeconds, nowMilliseconds());
+    }
+
+    /**
+     * @brief Wall-clock time in milliseconds since the epoch
+     */
+    static int64_t nowMilliseconds();
+
+private:
+    struct Limit {
+        RateLimitType type = RateLimitType::REQUEST_WEIGHT;
+        int64_t intervalMs = 0;
+        int64_t limit = 0;
+        // Window number in the high 32 bits, usage in the low 32 bits
+        std::atomic<uint64_t> state{0};
+    };
+
+    Limit limits_[MAX_LIMITS];
+    size_t limitCount_ = 0;
+    double cancelReserve_ = 0.05;
+    int64_t maxWaitMs_ = 10000;
+    std::atomic<bool> enabled_{true};
+    std::atomic<int> highWaiting_{0};
+    std::atomic<int64_t> blockedUntilMs_{0};
+
+    Limit* find(RateLimitType type, int64_t intervalMs);
+    const Limit* find(RateLimitType type, int64_t intervalMs) const;
+    void release(size_t count, const int64_t* charged, int64_t nowMs);
+};
+
+} // namespace binance
+
+#endif // RATE_LIMITER_H
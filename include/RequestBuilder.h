@@ -0,0 +1,130 @@
+#ifndef REQUEST_BUILDER_H
+#define REQUEST_BUILDER_H
+
+#include <string>
+#include <string_view>
+#include <map>
+#include <memory>
+#include <cstdint>
+#include "Decimal.h"
+
+namespace binance {
+
+/**
+ * @class RequestBuilder
+ * @brief Flat query-string buffer for building, signing and sending a request
+ *
+ * Parameters are appended as key=value pairs straight into one contiguous
+ * buffer that lives inside the object, so a typical order built on the
+ * stack needs no heap allocation. The same bytes are signed and handed to
+ * the HTTP layer without further copies. Longer requests spill to the heap.
+ *
+ * Keys and values are written as given; callers pass values that are
+ * already URL-safe, as with the map-based API.
+ */
+class RequestBuilder {
+public:
+    static constexpr size_t INLINE_CAPACITY = 512;
+
+    /**
+     * @brief Constructor
+     */
+    RequestBuilder();
+
+    RequestBuilder(const RequestBuilder&) = delete;
+    RequestBuilder& operator=(const RequestBuilder&) = delete;
+
+    /**
+     * @brief Append a key=value pair
+     * @param key Parameter name
+     * @param value Parameter value
+     * @return Reference to this builder
+     */
+    RequestBuilder& add(std::string_view key, std::string_view value);
+
+    /**
+     * @brief Append a key=value pair with an integer value
+     * @param key Parameter name
+     * @param value Parameter value
+     * @return Reference to this builder
+     */
+    RequestBuilder& add(std::string_view key, int64_t value);
+
+    /**
+     * @brief Append a key=value pair with a decimal value, formatted without a float round trip
+     * @param key Parameter name
+     * @param value Parameter value
+     * @return Reference to this builder
+     */
+    RequestBuilder& add(std::string_view key, Decimal value);
+
+    /**
+     * @brief Append a pre-rendered key=value pair, such as SymbolRegistry::param()
+     * @param pair Parameter as it should appear, without a separator
+     * @return Reference to this builder
+     */
+    RequestBuilder& addPair(std::string_view pair);
+
+    /**
+     * @brief Append every entry of a parameter map
+     * @param params Parameter map
+     * @return Reference to this builder
+     */
+    RequestBuilder& add(const std::map<std::string, std::string>& params);
+
+    /**
+     * @brief Append raw bytes without a separator
+     * @param text Bytes to append
+     * @return Reference to this builder
+     */
+    RequestBuilder& append(std::string_view text);
+
+    /**
+     * @brief Whether a timestamp parameter has been added
+     */
+    bool hasTimestamp() const { return hasTimestamp_; }
+
+    /**
+     * @brief Pointer to the serialized bytes (always NUL-terminated)
+     */
+    const char* data() const { return data_; }
+
+    /**
+     * @brief Number of serialized bytes
+     */
+    size_t size() const { return size_; }
+
+    /**
+     * @brief Whether no parameters have been added
+     */
+    bool empty() const { return size_ == 0; }
+
+    /**
+     * @brief View of the serialized bytes
+     */
+    std::string_view view() const { return std::string_view(data_, size_); }
+
+    /**
+     * @brief Copy of the serialized bytes
+     */
+    std::string str() const { return std::string(data_, size_); }
+
+    /**
+     * @brief Remove all parameters, keeping the allocated capacity
+     */
+    void clear();
+
+private:
+    char* data_;
+    size_t size_;
+    size_t capacity_;
+    bool hasTimestamp_;
+    std::unique_ptr<char[]> heap_;
+    char inline_[INLINE_CAPACITY];
+
+    char* grow(size_t extra);
+};
+
+} // namespace binance
+
+#endif // REQUEST_BUILDER_H
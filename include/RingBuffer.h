@@ -0,0 +1,191 @@
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+namespace binance {
+
+/// Size used to keep producer and consumer state on separate cache lines
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+namespace detail {
+
+inline size_t roundUpToPowerOfTwo(size_t value) {
+    if (value < 2) {
+        throw std::invalid_argument("Ring buffer capacity must be at least 2");
+    }
+    size_t capacity = 1;
+    while (capacity < value) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+} // namespace detail
+
+/**
+ * @class SpscRingBuffer
+ * @brief Bounded lock-free queue for exactly one producer and one consumer thread
+ *
+ * Head and tail live on their own cache lines and each side keeps a cached
+ * copy of the other's index, so in the common case a push or pop touches no
+ * cache line owned by the other thread. Elements are copied in and out, so T
+ * should be trivially copyable.
+ */
+template <typename T>
+class SpscRingBuffer {
+    static_assert(std::is_trivially_copyable<T>::value, "Ring buffer elements must be trivially copyable");
+
+public:
+    /**
+     * @brief Constructor
+     * @param capacity Minimum number of elements; rounded up to a power of two
+     */
+    explicit SpscRingBuffer(size_t capacity)
+        : mask_(detail::roundUpToPowerOfTwo(capacity) - 1), slots_(new T[mask_ + 1]) {}
+
+    SpscRingBuffer(const SpscRingBuffer&) = delete;
+    SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+    /**
+     * @brief Append an element (producer thread only)
+     * @return False if the buffer is full
+     */
+    bool tryPush(const T& value) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cachedHead_ > mask_) {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            if (tail - cachedHead_ > mask_) {
+                return false;
+            }
+        }
+        slots_[tail & mask_] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Remove the oldest element (consumer thread only)
+     * @return False if the buffer is empty
+     */
+    bool tryPop(T& value) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cachedTail_) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            if (head == cachedTail_) {
+                return false;
+            }
+        }
+        value = slots_[head & mask_];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Approximate number of queued elements
+     */
+    size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    const size_t mask_;
+    const std::unique_ptr<T[]> slots_;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_{0};
+    size_t cachedTail_ = 0;  // Consumer's copy of tail_
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_{0};
+    size_t cachedHead_ = 0;  // Producer's copy of head_
+};
+
+/**
+ * @class MpscRingBuffer
+ * @brief Bounded lock-free queue for many producer threads and one consumer thread
+ *
+ * Each slot carries a sequence number telling whether it is free for the
+ * producer that claimed its position or holds data for the consumer, so
+ * producers only contend on a compare-and-swap of the tail and never
+ * wait for each other to finish writing.
+ */
+template <typename T>
+class MpscRingBuffer {
+    static_assert(std::is_trivially_copyable<T>::value, "Ring buffer elements must be trivially copyable");
+
+public:
+    /**
+     * @brief Constructor
+     * @param capacity Minimum number of elements; rounded up to a power of two
+     */
+    explicit MpscRingBuffer(size_t capacity)
+        : mask_(detail::roundUpToPowerOfTwo(capacity) - 1), slots_(new Slot[mask_ + 1]) {
+        for (size_t i = 0; i <= mask_; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscRingBuffer(const MpscRingBuffer&) = delete;
+    MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+
+    /**
+     * @brief Append an element (any thread)
+     * @return False if the buffer is full
+     */
+    bool tryPush(const T& value) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[tail & mask_];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence == tail) {
+                if (tail_.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed)) {
+                    slot.value = value;
+                    slot.sequence.store(tail + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (sequence < tail) {
+                return false;  // Slot still holds an element the consumer has not taken
+            } else {
+                tail = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Remove the oldest element (consumer thread only)
+     * @return False if the buffer is empty or the oldest element is still being written
+     */
+    bool tryPop(T& value) {
+        Slot& slot = slots_[head_ & mask_];
+        if (slot.sequence.load(std::memory_order_acquire) != head_ + 1) {
+            return false;
+        }
+        value = slot.value;
+        slot.sequence.store(head_ + mask_ + 1, std::memory_order_release);
+        ++head_;
+        return true;
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    const size_t mask_;
+    const std::unique_ptr<Slot[]> slots_;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_{0};
+    alignas(CACHE_LINE_SIZE) size_t head_ = 0;
+};
+
+} // namespace binance
+
+#endif // RING_BUFFER_H
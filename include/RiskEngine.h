@@ -0,0 +1,228 @@
+#ifndef RISK_ENGINE_H
+#define RISK_ENGINE_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include "BinanceTypes.h"
+#include "Decimal.h"
+#include "SymbolRegistry.h"
+#include "UserData.h"
+
+namespace binance {
+
+struct OrderExecution;
+
+/**
+ * @enum RiskResult
+ * @brief Outcome of a pre-trade risk check
+ */
+enum class RiskResult {
+    OK,
+    UNKNOWN_SYMBOL,         // No limits set for the symbol; orders in it are not allowed
+    ORDER_SIZE,             // Quantity above maxOrderQty
+    NOTIONAL,               // price * quantity (or quoteOrderQty) above maxNotional
+    PRICE_BAND,             // Limit price further from the last trade than priceBand allows
+    NO_REFERENCE_PRICE,     // A check needs the last trade price and none has been seen
+    OPEN_ORDERS,            // maxOpenOrders already open
+    POSITION                // The position could pass maxPosition if every open order filled
+};
+
+/// Number of RiskResult values, for per-reason counters
+constexpr size_t RISK_RESULT_COUNT = 8;
+
+/**
+ * @brief Name of a result, e.g. "PRICE_BAND"
+ */
+const char* toString(RiskResult result);
+
+/**
+ * @struct RiskLimits
+ * @brief Pre-trade limits of one symbol; a zero limit is not checked
+ */
+struct RiskLimits {
+    Decimal maxOrderQty;             // Base quantity of one order
+    Decimal maxNotional;             // Quote value of one order; market orders are valued at the last trade
+    Decimal priceBand;               // Furthest a limit price may be from the last trade, as a fraction (0.05 = 5%), at most 21.47
+    int32_t maxOpenOrders = 0;       // Orders open at once
+    Decimal maxPosition;             // Net base quantity either way, counting open orders as filled
+};
+
+/**
+ * @struct RiskExposure
+ * @brief What the risk engine knows about one symbol
+ */
+struct RiskExposure {
+    Decimal position;                // Net base quantity filled; negative when short
+    Decimal openBuyQty;              // Unfilled quantity of open buy orders
+    Decimal openSellQty;
+    int32_t openOrders = 0;
+    Decimal lastPrice;               // Zero until a trade is seen
+};
+
+/**
+ * @class RiskEngine
+ * @brief Pre-trade risk checks run locally before an order is signed
+ *
+ * Checks one order against its symbol's limits in this order: order size,
+ * notional, price band around the last trade, open-order count, then the
+ * position the symbol could reach if every open order filled. An order that
+ * passes reserve() counts as open until it is released or finishes, so
+ * orders sent back to back cannot each slip under the same limit.
+ *
+ * State lives in a flat array indexed by SymbolId with one cache line per
+ * symbol, so a check costs tens of nanoseconds. Each symbol's line has its
+ * own spin lock: orders may be checked from any number of threads, and
+ * threads trading different symbols never contend. Last trade prices are
+ * stored without the lock on a line of their own, so a market data thread
+ * can feed them at any rate without stealing the line the checks lock;
+ * only checks that need the price read it. Notionals are compared in 128
+ * bits and positions as headroom, so an order too large for Decimal is
+ * rejected rather than wrapping under the limit. Symbols without limits are
+ * rejected.
+ *
+ * Keep the engine current by passing it every order update that
+ * OrderStore::apply applied, with the fill it reported; updates from the
+ * user data stream and from order responses can be mixed, since the store
+ * drops the duplicates. StrategyRuntime::trackRisk() does this, and feeds
+ * the last prices, for everything the runtime sees. Quote-quantity market
+ * orders are checked by their notional alone and count towards the
+ * position once they fill.
+ *
+ * Set limits during setup: setLimits() for a new symbol may grow the table
+ * and must not run while orders are being checked.
+ */
+class RiskEngine {
+public:
+    /**
+     * @brief Constructor
+     * @param registry Registry whose ids index the table; must outlive the engine
+     */
+    explicit RiskEngine(SymbolRegistry& registry);
+
+    ~RiskEngine();
+
+    RiskEngine(const RiskEngine&) = delete;
+    RiskEngine& operator=(const RiskEngine&) = delete;
+
+    /**
+     * @brief Set a symbol's limits, interning it if it is new; exposure is kept
+     * @throws std::invalid_argument if the price band is negative or above 21.47
+     */
+    void setLimits(std::string_view symbol, const RiskLimits& limits);
+
+    /**
+     * @brief Limits of a symbol; all zero if none are set
+     */
+    RiskLimits limits(SymbolId id) const;
+
+    /**
+     * @brief Check an order without reserving anything
+     * @param price Limit price; ignored for MARKET
+     * @param quantity Base quantity; zero for a quote-quantity order
+     * @param quoteQuantity quoteOrderQty of a market order without a base quantity
+     */
+    RiskResult check(SymbolId id, OrderSide side, OrderType type, Decimal price, Decimal quantity,
+                     Decimal quoteQuantity = Decimal()) const;
+
+    /**
+     * @brief Check an order and, if it passes, count it as open
+     *
+     * Every order that passes must later be released, or finish through
+     * apply(); rejects are counted per reason.
+     * @return OK, or the first limit the order breaks
+     */
+    RiskResult reserve(SymbolId id, OrderSide side, OrderType type, Decimal price, Decimal quantity,
+                       Decimal quoteQuantity = Decimal());
+
+    /**
+     * @brief Give back what reserve() took for an order the exchange never accepted
+     * @param quantity The base quantity the order was reserved with
+     */
+    void release(SymbolId id, OrderSide side, Decimal quantity);
+
+    /**
+     * @brief Record an order update
+     *
+     * Fills move quantity from the open orders into the position; an order
+     * that is filled, canceled, rejected or expired stops counting as open.
+     * @param update An update OrderStore::apply returned APPLIED for
+     * @param fill The quantity apply() reported the update executed
+     */
+    void apply(const OrderUpdateEvent& update, const OrderExecution& fill);
+
+    /**
+     * @brief Record the price of a trade, the reference for price bands and market notional
+     */
+    void onTrade(SymbolId id, Decimal price) {
+        if (id < capacity_) {
+            prices_[id].price.store(price.units(), std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Set a symbol's position, e.g. from the account's balances at startup
+     */
+    void setPosition(SymbolId id, Decimal position);
+
+    /**
+     * @brief Current exposure of a symbol
+     */
+    RiskExposure exposure(SymbolId id) const;
+
+    /**
+     * @brief Orders checked by reserve(), passed or not
+     */
+    uint64_t checked() const { return checked_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Orders reserve() rejected for a reason
+     */
+    uint64_t rejects(RiskResult reason) const {
+        return rejects_[static_cast<size_t>(reason)].load(std::memory_order_relaxed);
+    }
+
+    SymbolRegistry& registry() const { return registry_; }
+
+private:
+    // One cache line per symbol: limits, exposure and the lock that guards them
+    struct alignas(64) SymbolState {
+        std::atomic<bool> locked{false};
+        bool active = false;             // Limits have been set
+        int32_t maxOpenOrders = 0;
+        int32_t openOrders = 0;
+        int32_t priceBand = 0;           // Decimal units, like every field below
+        int64_t maxOrderQty = 0;
+        int64_t maxNotional = 0;
+        int64_t maxPosition = 0;
+        int64_t position = 0;
+        int64_t openBuyQty = 0;
+        int64_t openSellQty = 0;
+    };
+    static_assert(sizeof(SymbolState) == 64, "a symbol's state must fill exactly one cache line");
+
+    // Written by the market data thread without the lock, so kept off the locked line
+    struct alignas(64) PriceLine {
+        std::atomic<int64_t> price{0};   // Decimal units of the last trade, 0 until one is seen
+    };
+    static_assert(sizeof(PriceLine) == 64, "a last price must have its cache line to itself");
+
+    class Guard;
+
+    RiskResult evaluate(const SymbolState& state, const std::atomic<int64_t>& lastPrice, OrderSide side,
+                        OrderType type, Decimal price, Decimal quantity, Decimal quoteQuantity) const;
+    static void close(SymbolState& state, OrderSide side, int64_t quantity);
+
+    SymbolRegistry& registry_;
+    std::unique_ptr<SymbolState[]> states_;  // Indexed by SymbolId
+    std::unique_ptr<PriceLine[]> prices_;    // Indexed by SymbolId
+    size_t capacity_ = 0;
+    std::atomic<uint64_t> checked_{0};
+    std::atomic<uint64_t> rejects_[RISK_RESULT_COUNT] = {};
+};
+
+} // namespace binance
+
+#endif // RISK_ENGINE_H
@@ -0,0 +1,147 @@
+#ifndef SHA256_H
+#define SHA256_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace binance {
+
+/**
+ * @class Sha256
+ * @brief Streaming SHA-256 with a CPU-specific compression backend
+ *
+ * Data is absorbed block-at-a-time without copying whole messages. The
+ * compression function is picked once at startup through CPUID: Intel SHA
+ * extensions when the CPU has them, otherwise the portable scalar code.
+ * Batches of independent messages can additionally be hashed eight lanes at
+ * a time with AVX2 (see finishMany).
+ */
+class Sha256 {
+public:
+    using State = std::array<uint32_t, 8>;
+    using Digest = std::array<uint8_t, 32>;
+
+    static constexpr size_t BLOCK_SIZE = 64;
+    static constexpr size_t MAX_LANES = 8;
+
+    /**
+     * @enum Backend
+     * @brief Available implementations of the compression function
+     */
+    enum class Backend {
+        SCALAR,  // Portable C++
+        SHA_NI   // Intel SHA extensions (x86 SHA256RNDS2 / SHA256MSG1 / SHA256MSG2)
+    };
+
+    /**
+     * @brief Start a new hash from the standard initial state
+     */
+    Sha256();
+
+    /**
+     * @brief Resume a hash from a saved midstate
+     * @param midstate State after absorbing a whole number of blocks
+     * @param absorbed Number of bytes already folded into the midstate (multiple of 64)
+     */
+    Sha256(const State& midstate, uint64_t absorbed);
+
+    /**
+     * @brief Absorb more message bytes
+     * @param data Pointer to the bytes
+     * @param len Number of bytes
+     */
+    void update(const void* data, size_t len);
+
+    /**
+     * @brief Pad the message and produce the digest
+     * @return The 32-byte digest; the object must not be updated afterwards
+     */
+    Digest finish();
+
+    /**
+     * @brief Current chaining state (meaningful when a whole number of blocks was absorbed)
+     * @return The eight state words
+     */
+    const State& state() const { return state_; }
+
+    /**
+     * @brief One-shot hash of a buffer
+     * @param data Pointer to the bytes
+     * @param len Number of bytes
+     * @return The 32-byte digest
+     */
+    static Digest hash(const void* data, size_t len);
+
+    /**
+     * @brief Fold whole blocks into a state using the active backend
+     * @param state State to update
+     * @param blocks Pointer to blocks * 64 bytes
+     * @param count Number of blocks
+     */
+    static void compress(State& state, const uint8_t* blocks, size_t count);
+
+    /**
+     * @brief Finish many independent messages that resume from the same midstate
+     *
+     * With the multi-buffer path enabled the messages are hashed in groups of
+     * eight, one per 32-bit lane of an AVX2 register; otherwise they are
+     * finished one after another with the single-stream backend.
+     * @param midstate State after absorbing the shared prefix
+     * @param absorbed Length of the shared prefix in bytes (multiple of 64)
+     * @param messages Pointers to each message's remaining bytes
+     * @param lengths Length of each message
+     * @param count Number of messages
+     * @param digests Output array of count digests
+     */
+    static void finishMany(const State& midstate, uint64_t absorbed,
+                           const uint8_t* const* messages, const size_t* lengths,
+                           size_t count, Digest* digests);
+
+    /**
+     * @brief Check whether the AVX2 multi-buffer path can run on this CPU
+     */
+    static bool isMultiBufferSupported();
+
+    /**
+     * @brief Whether finishMany currently uses the multi-buffer path
+     */
+    static bool isMultiBufferEnabled();
+
+    /**
+     * @brief Enable or disable the multi-buffer path, e.g. for tests and benchmarks
+     * @return False if enabling was requested but the CPU lacks AVX2
+     */
+    static bool setMultiBuffer(bool enabled);
+
+    /**
+     * @brief The backend selected for this CPU (or forced with setBackend)
+     */
+    static Backend activeBackend();
+
+    /**
+     * @brief Check whether a backend can run on this CPU
+     */
+    static bool isSupported(Backend backend);
+
+    /**
+     * @brief Force a backend, e.g. for tests and benchmarks
+     * @return False if the backend is not supported on this CPU
+     */
+    static bool setBackend(Backend backend);
+
+    static const State INITIAL_STATE;
+
+private:
+    State state_;
+    uint64_t length_;
+    uint8_t buffer_[BLOCK_SIZE];
+    size_t buffered_;
+};
+
+// Helper to get a backend's display name
+const char* toString(Sha256::Backend backend);
+
+} // namespace binance
+
+#endif // SHA256_H
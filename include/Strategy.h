@@ -0,0 +1,107 @@
+#ifndef STRATEGY_H
+#define STRATEGY_H
+
+#include <cstdint>
+#include "MarketData.h"
+#include "UserData.h"
+
+namespace binance {
+
+class OrderBook;
+class OrderGateway;
+class Strategy;
+
+/// Identifies a timer scheduled by a strategy
+using TimerId = uint64_t;
+
+/**
+ * @class StrategyContext
+ * @brief What a strategy can ask of whatever drives it
+ *
+ * Implemented by StrategyRuntime for live trading. A replay driver supplies
+ * its own clock and gateway, so the same strategy code runs in both.
+ */
+class StrategyContext {
+public:
+    virtual ~StrategyContext() = default;
+
+    /**
+     * @brief Gateway for the strategy's orders
+     * @throws std::runtime_error if none was configured
+     */
+    virtual OrderGateway& orderGateway() = 0;
+
+    /**
+     * @brief Call strategy.onTimer after a delay, and then periodically if a period is given
+     * @param delayMicros Microseconds until the first call
+     * @param periodMicros Microseconds between later calls; 0 for a one-shot timer
+     */
+    virtual TimerId scheduleTimer(Strategy& strategy, int64_t delayMicros, int64_t periodMicros) = 0;
+
+    /**
+     * @brief Cancel a timer; unknown or finished timers are ignored
+     */
+    virtual void cancelTimer(TimerId id) = 0;
+
+    /**
+     * @brief Current time in microseconds on the driver's clock
+     */
+    virtual int64_t nowMicros() const = 0;
+};
+
+/**
+ * @class Strategy
+ * @brief Base class for event-driven strategies
+ *
+ * Override the callbacks of interest. They are all called on the driver's
+ * thread, one at a time, so a strategy needs no locking of its own. Every
+ * strategy sees every event; filter by symbol as needed.
+ */
+class Strategy {
+public:
+    virtual ~Strategy() = default;
+
+    /// Called once before the first event
+    virtual void onStart() {}
+
+    /// Called once after the last event
+    virtual void onStop() {}
+
+    virtual void onTrade(const TradeEvent& trade) { (void)trade; }
+    virtual void onBookTicker(const BookTickerEvent& ticker) { (void)ticker; }
+    virtual void onKline(const KlineEvent& kline) { (void)kline; }
+
+    /// Called after each update applied to a tracked order book that leaves it in sync
+    virtual void onBookUpdate(const OrderBook& book) { (void)book; }
+
+    virtual void onOrderUpdate(const OrderUpdateEvent& update) { (void)update; }
+    virtual void onBalanceUpdate(const BalanceUpdateEvent& balance) { (void)balance; }
+    virtual void onTimer(TimerId id) { (void)id; }
+
+    /**
+     * @brief Attach the strategy to its driver; done by the driver
+     */
+    void bind(StrategyContext* context) { context_ = context; }
+
+protected:
+    /**
+     * @brief Gateway for placing and cancelling orders
+     * @throws std::runtime_error if the strategy is not attached to a driver with a gateway
+     */
+    OrderGateway& orders();
+
+    TimerId scheduleTimer(int64_t delayMicros, int64_t periodMicros = 0);
+    void cancelTimer(TimerId id);
+
+    /// Driver time in microseconds: monotonic when live, event time in a replay
+    int64_t now() const;
+
+private:
+    StrategyContext* context_ = nullptr;
+
+    StrategyContext& context() const;
+};
+
+} // namespace binance
+
+#endif // STRATEGY_H
@@ -0,0 +1,180 @@
+#ifndef STRATEGY_RUNTIME_H
+#define STRATEGY_RUNTIME_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include "Decimal.h"
+#include "MarketDataStream.h"
+#include "Strategy.h"
+#include "UserData.h"
+
+namespace binance {
+
+class OrderBook;
+class OrderGateway;
+class OrderStore;
+class PositionTracker;
+class RiskEngine;
+
+/**
+ * @enum IdleMode
+ * @brief What the event loop does when no queue has work
+ */
+enum class IdleMode {
+    SPIN,   // Busy-poll; lowest latency, needs a core of its own
+    YIELD   // Yield the CPU between polls; for machines without a spare core
+};
+
+/**
+ * @class StrategyRuntime
+ * @brief Event loop that drives strategies from market data, order updates and timers
+ *
+ * One thread polls the market data queues, the order update queues and the
+ * order gateway, then fires due timers, and calls the strategies directly
+ * for each event. There is no sleep in the loop, so the time from an event
+ * arriving in a queue to the strategy's decision is the time it takes to
+ * compute it. The loop thread can be pinned to a CPU.
+ *
+ * Configure everything before start() or run(); stop() may be called from
+ * any thread, including from a strategy callback.
+ */
+class StrategyRuntime {
+public:
+    /**
+     * @brief Constructor
+     */
+    StrategyRuntime();
+
+    /**
+     * @brief Destructor; stops the loop
+     */
+    ~StrategyRuntime();
+
+    StrategyRuntime(const StrategyRuntime&) = delete;
+    StrategyRuntime& operator=(const StrategyRuntime&) = delete;
+
+    /**
+     * @brief Add a strategy; it must outlive the runtime's loop
+     */
+    void addStrategy(Strategy& strategy);
+
+    /**
+     * @brief Drain a market data queue, e.g. from MarketDataStream::addConsumer
+     */
+    void addMarketData(std::shared_ptr<MarketEventQueue> queue);
+
+    /**
+     * @brief Drain a queue of order updates, e.g. from the user data stream
+     */
+    void addOrderUpdates(std::shared_ptr<OrderUpdateQueue> queue);
+
+    /**
+     * @brief Drain a queue of balance updates, e.g. from UserDataStream::addBalanceConsumer
+     */
+    void addBalanceUpdates(std::shared_ptr<BalanceUpdateQueue> queue);
+
+    /**
+     * @brief Keep the state of every order from the order updates
+     *
+     * Each update, from the queues or the gateway, is applied to the store
+     * before strategies see it, so a strategy can look any order up from its
+     * callbacks. Updates the store finds stale (e.g. a response that arrives
+     * after the stream reported the same fill) are not passed on.
+     * @param capacity Orders remembered at once
+     * @return The store, owned by the runtime
+     */
+    OrderStore& trackOrders(size_t capacity = 4096);
+
+    /**
+     * @brief Keep balances from the balance updates and positions from the fills of tracked orders
+     *
+     * Tracks orders too, with the default capacity unless trackOrders() was called.
+     * @return The tracker, owned by the runtime
+     */
+    PositionTracker& trackPositions();
+
+    /**
+     * @brief Keep a risk engine current from the order updates and trades
+     *
+     * Each update the order store applies is passed to RiskEngine::apply with
+     * its fill, so fills and finished orders give back what they reserved,
+     * and every trade sets its symbol's last price. Tracks orders too, with
+     * the default capacity unless trackOrders() was called.
+     * @param risk Engine to keep current; it must outlive the runtime's loop
+     */
+    void trackRisk(RiskEngine& risk);
+
+    /**
+     * @brief Set the gateway strategies send orders to; it is polled for responses by the loop
+     */
+    void setOrderGateway(OrderGateway& gateway);
+
+    /**
+     * @brief Keep a local order book from the symbol's diff-depth stream
+     *
+     * Depth events for the symbol update the book, and strategies get
+     * onBookUpdate after each complete update while it is in sync.
+     * @param symbol Trading pair symbol
+     * @param tickSize The symbol's price tick size
+     * @param snapshotSource Returns a REST snapshot; called on the loop thread when the book needs one
+     * @return The book, owned by the runtime
+     */
+    OrderBook& trackOrderBook(const std::string& symbol, Decimal tickSize,
+                              std::function<DepthSnapshot()> snapshotSource = nullptr);
+
+    /**
+     * @brief Pin the loop thread to a CPU; -1 (the default) leaves it unpinned
+     */
+    void setCpu(int cpu);
+
+    /**
+     * @brief Choose how the loop waits when idle (default YIELD)
+     */
+    void setIdleMode(IdleMode mode);
+
+    /**
+     * @brief Run the loop on the calling thread until stop()
+     * @throws std::runtime_error if the thread cannot be pinned as requested
+     */
+    void run();
+
+    /**
+     * @brief Run the loop on a new thread
+     */
+    void start();
+
+    /**
+     * @brief Ask the loop to finish and wait for a thread started by start()
+     */
+    void stop();
+
+    /**
+     * @brief Whether the loop is running
+     */
+    bool isRunning() const;
+
+    /**
+     * @brief Events handed to strategies (each counted once, however many strategies)
+     */
+    uint64_t eventsDispatched() const;
+
+    /**
+     * @brief Exceptions thrown by strategy callbacks; the loop carries on
+     */
+    uint64_t callbackErrors() const;
+
+    /**
+     * @brief Monotonic clock used for timers, in microseconds
+     */
+    static int64_t nowMicros();
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace binance
+
+#endif // STRATEGY_RUNTIME_H
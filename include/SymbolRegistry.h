@@ -0,0 +1,102 @@
+#ifndef SYMBOL_REGISTRY_H
+#define SYMBOL_REGISTRY_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+#include "MarketData.h"
+
+namespace binance {
+
+/// Dense id of an interned symbol: 0, 1, 2, ... in the order symbols were first seen
+using SymbolId = uint16_t;
+
+/// Returned by lookups of a symbol that has not been interned
+constexpr SymbolId INVALID_SYMBOL = UINT16_MAX;
+
+/**
+ * @class SymbolRegistry
+ * @brief Interns symbol names to small integer ids
+ *
+ * Per-symbol state can then live in flat arrays indexed by SymbolId rather
+ * than in maps keyed by string, and a symbol is compared as one integer.
+ * Names are upper-cased as by SymbolName::assign, so "btcusdt" and
+ * "BTCUSDT" share an id. Ids are never reused or reassigned for the life
+ * of the registry.
+ *
+ * Each symbol also keeps its request parameter pre-rendered
+ * ("symbol=BTCUSDT"), so requests by id append it with one copy instead
+ * of formatting the name again.
+ *
+ * Lookups hash the name into an open-addressing table (linear probing), so
+ * they cost a hash and usually one probe, with no allocation. Intern every
+ * symbol during setup: intern() may grow the table and must not run while
+ * other threads look symbols up; lookups alone are safe from any number of
+ * threads.
+ */
+class SymbolRegistry {
+public:
+    /// Most symbols one registry holds; INVALID_SYMBOL is kept out of the id range
+    static constexpr size_t MAX_SYMBOLS = UINT16_MAX;
+
+    SymbolRegistry();
+
+    /**
+     * @brief Id of a symbol, assigning the next one if it is new
+     * @throws std::invalid_argument if the name is empty
+     * @throws std::length_error if MAX_SYMBOLS symbols are already interned
+     */
+    SymbolId intern(std::string_view symbol);
+
+    /**
+     * @brief Id of a symbol, or INVALID_SYMBOL if it has not been interned
+     */
+    SymbolId find(std::string_view symbol) const;
+
+    /**
+     * @brief Name of an interned symbol
+     * @throws std::out_of_range if the id was not assigned
+     */
+    std::string_view name(SymbolId id) const;
+
+    /**
+     * @brief The symbol as a request parameter, e.g. "symbol=BTCUSDT"
+     * @throws std::out_of_range if the id was not assigned
+     */
+    std::string_view param(SymbolId id) const;
+
+    /**
+     * @brief Whether an id was assigned by this registry
+     */
+    bool contains(SymbolId id) const { return id < entries_.size(); }
+
+    /// Symbols interned; every id is below this
+    size_t size() const { return entries_.size(); }
+
+private:
+    static uint32_t hashName(std::string_view name) {
+        // FNV-1a
+        uint64_t hash = 14695981039346656037ULL;
+        for (char c : name) {
+            hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+        }
+        return static_cast<uint32_t>(hash ^ (hash >> 32));
+    }
+
+    struct Entry {
+        SymbolName name;
+        uint8_t paramSize = 0;
+        char param[7 + SymbolName::CAPACITY];  // "symbol=" and the name, unterminated
+    };
+
+    void grow();
+
+    std::vector<Entry> entries_;             // Indexed by id
+    std::vector<SymbolId> table_;            // Ids by hash; INVALID_SYMBOL marks an empty entry
+    size_t mask_ = 0;
+};
+
+} // namespace binance
+
+#endif // SYMBOL_REGISTRY_H
@@ -0,0 +1,151 @@
+#ifndef TICK_FILE_H
+#define TICK_FILE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "MarketData.h"
+#include "MarketDataStream.h"
+
+namespace binance {
+
+/**
+ * @class TickRecorder
+ * @brief Records decoded market data to a compact, chunked, columnar tick file
+ *
+ * A background writer thread drains market event queues, such as those
+ * from MarketDataStream::addConsumer, so the stream's I/O thread only ever
+ * copies events into a ring buffer; if the writer falls behind, the stream
+ * counts drops instead of waiting. Each event is stamped with the time the
+ * writer took it from the queue, in microseconds since the epoch.
+ *
+ * Trades, book tickers and depth updates are recorded; klines are skipped.
+ * Events are appended in chunks of up to chunkRows rows. Within a chunk each
+ * field is a column of its own, and integers (times, ids, prices and
+ * quantities in Decimal units) are stored as varints of the difference from
+ * the previous value for the same symbol, which makes a recorded tick a few
+ * bytes instead of the hundreds of its JSON. Every chunk is written whole and
+ * flushed, so a file cut short by a crash is readable up to its last chunk;
+ * stop() adds an index of the chunks' time ranges.
+ */
+class TickRecorder {
+public:
+    /**
+     * @brief Constructor; creates or truncates the file
+     * @param path File to write
+     * @param chunkRows Events per chunk
+     * @param flushIntervalMillis Longest time an event waits in a partial chunk before it is written
+     * @throws std::runtime_error if the file cannot be created
+     */
+    explicit TickRecorder(const std::string& path, size_t chunkRows = 4096, int64_t flushIntervalMillis = 1000);
+
+    /**
+     * @brief Destructor; stops the writer and completes the file
+     */
+    ~TickRecorder();
+
+    TickRecorder(const TickRecorder&) = delete;
+    TickRecorder& operator=(const TickRecorder&) = delete;
+
+    /**
+     * @brief Record the events of a queue; call before start()
+     */
+    void addSource(std::shared_ptr<MarketEventQueue> queue);
+
+    /**
+     * @brief Start the writer thread
+     */
+    void start();
+
+    /**
+     * @brief Drain the queues, write the last chunk and the index, and stop the writer
+     */
+    void stop();
+
+    uint64_t eventsRecorded() const;
+    /// Events of kinds the format does not hold
+    uint64_t eventsSkipped() const;
+    uint64_t chunksWritten() const;
+    uint64_t bytesWritten() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+/**
+ * @class TickFile
+ * @brief Read-only, memory-mapped view of a file written by TickRecorder
+ *
+ * Opening maps the file and reads the chunk index (or, for a file whose
+ * recorder did not stop cleanly, rebuilds it from the chunk headers).
+ * Chunks are in time order, so finding the first event at or after a time
+ * is a binary search over chunks followed by decoding part of one chunk.
+ */
+class TickFile {
+public:
+    /**
+     * @brief Map a file
+     * @throws std::runtime_error if the file cannot be mapped or is not a tick file
+     */
+    explicit TickFile(const std::string& path);
+
+    /**
+     * @brief Destructor; unmaps the file
+     */
+    ~TickFile();
+
+    TickFile(const TickFile&) = delete;
+    TickFile& operator=(const TickFile&) = delete;
+
+    /// Number of recorded events
+    uint64_t size() const { return events_; }
+    size_t chunkCount() const { return chunks_.size(); }
+    /// Recording time of the first and last events, in microseconds; 0 if empty
+    int64_t firstTime() const;
+    int64_t lastTime() const;
+
+    /**
+     * @brief Index of the first chunk that holds events at or after a time
+     * @return chunkCount() if there is none
+     */
+    size_t findChunk(int64_t timeMicros) const;
+
+    /**
+     * @brief Decode the events recorded in [fromMicros, toMicros), in recording order
+     * @param sink Called with each event's recording time and the event
+     * @return Number of events delivered
+     * @throws std::runtime_error if a chunk is corrupt
+     */
+    size_t replay(int64_t fromMicros, int64_t toMicros,
+                  const std::function<void(int64_t timeMicros, const MarketEvent& event)>& sink) const;
+
+    /**
+     * @brief Decode every event
+     */
+    size_t replay(const std::function<void(int64_t timeMicros, const MarketEvent& event)>& sink) const;
+
+private:
+    struct Chunk {
+        int64_t firstTime;
+        int64_t lastTime;
+        uint64_t offset;
+        uint32_t rows;
+    };
+
+    void* data_ = nullptr;
+    size_t length_ = 0;
+    uint64_t events_ = 0;
+    std::vector<Chunk> chunks_;
+
+    void decodeChunk(const Chunk& chunk, int64_t fromMicros, int64_t toMicros,
+                     const std::function<void(int64_t, const MarketEvent&)>& sink, size_t& delivered,
+                     bool& done) const;
+};
+
+} // namespace binance
+
+#endif // TICK_FILE_H
@@ -0,0 +1,125 @@
+#ifndef USER_DATA_H
+#define USER_DATA_H
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <string_view>
+#include <variant>
+#include "BinanceTypes.h"
+#include "Decimal.h"
+#include "MarketData.h"
+#include "RingBuffer.h"
+
+namespace binance {
+
+/**
+ * @struct ClientOrderId
+ * @brief Client order id held inline so order events stay trivially copyable
+ */
+struct ClientOrderId {
+    static constexpr size_t CAPACITY = 36;  // Longest id the exchange accepts
+
+    char data[CAPACITY + 1] = {};
+
+    /**
+     * @brief Store an id, truncated to CAPACITY characters
+     */
+    void assign(std::string_view id);
+
+    std::string_view view() const { return std::string_view(data); }
+    bool empty() const { return data[0] == '\0'; }
+    bool operator==(std::string_view id) const { return view() == id; }
+};
+
+/// Asset code held inline, e.g. "BTC"; asset codes are upper-case like symbols
+using AssetName = SymbolName;
+
+/**
+ * @struct OrderUpdateEvent
+ * @brief A change in the state of one of our orders
+ *
+ * Produced from order responses by an OrderGateway and from execution
+ * reports on the user data stream. Responses carry only the cumulative
+ * quantities; the fill details are set for execution reports.
+ */
+struct OrderUpdateEvent {
+    SymbolName symbol;
+    ClientOrderId clientOrderId;
+    int64_t eventTime = 0;
+    int64_t orderId = -1;            // -1 if the exchange never assigned one (rejected)
+    OrderSide side = OrderSide::BUY;
+    OrderType type = OrderType::LIMIT;
+    OrderStatus status = OrderStatus::NEW;
+    Decimal price;
+    Decimal quantity;
+    Decimal executedQty;             // Cumulative
+    Decimal cumulativeQuoteQty;
+    Decimal lastPrice;               // Of the fill that caused this event, if any
+    Decimal lastQty;
+    int errorCode = 0;               // Exchange error code of a failed request
+    bool cancelRejected = false;     // A cancel failed; status is then not known
+    ExecutionType executionType = ExecutionType::NEW;
+    int64_t tradeId = -1;            // Of the fill, -1 if none
+    Decimal commission;              // Charged for the fill
+    AssetName commissionAsset;
+    bool isMaker = false;
+};
+
+/// Queue of order updates for the strategy thread
+using OrderUpdateQueue = SpscRingBuffer<OrderUpdateEvent>;
+
+/**
+ * @struct BalanceUpdateEvent
+ * @brief A change in one asset balance of the account
+ *
+ * An outboundAccountPosition event gives the new free and locked amounts of
+ * every asset that changed; a balanceUpdate event (deposits, withdrawals,
+ * transfers) gives only the change in the free amount, as isDelta events.
+ */
+struct BalanceUpdateEvent {
+    AssetName asset;
+    int64_t eventTime = 0;
+    Decimal free;                    // New free amount, or the change if isDelta
+    Decimal locked;                  // New locked amount; unset if isDelta
+    bool isDelta = false;
+};
+
+/// Queue of balance updates for the strategy thread
+using BalanceUpdateQueue = SpscRingBuffer<BalanceUpdateEvent>;
+
+/**
+ * @brief A decoded user data event
+ */
+using UserDataEvent = std::variant<OrderUpdateEvent, BalanceUpdateEvent>;
+
+/**
+ * @enum UserDataMessage
+ * @brief Kind of message received on a user data stream
+ */
+enum class UserDataMessage {
+    OTHER,               // Not an account event, e.g. a subscription reply
+    EXECUTION_REPORT,
+    ACCOUNT_POSITION,    // outboundAccountPosition
+    BALANCE_UPDATE,
+    STREAM_EXPIRED       // listenKeyExpired or eventStreamTerminated; resubscribe to carry on
+};
+
+/**
+ * @brief Decode a user data stream message
+ *
+ * Accepts the bare event as sent on /ws/<listenKey>, and events wrapped in
+ * a "data" (combined stream) or "event" (WebSocket API subscription)
+ * member. For cancels the client order id is the one the order was placed
+ * with, not the id of the cancel request.
+ * @param message Raw WebSocket text message
+ * @param sink Called once per decoded event (once per asset for account positions)
+ * @return What the message was
+ * @throws std::runtime_error if a recognized event is malformed
+ */
+UserDataMessage parseUserDataMessage(std::string_view message,
+                                     const std::function<void(const UserDataEvent&)>& sink);
+
+} // namespace binance
+
+#endif // USER_DATA_H
@@ -0,0 +1,126 @@
+#ifndef USER_DATA_STREAM_H
+#define USER_DATA_STREAM_H
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "UserData.h"
+
+namespace binance {
+
+class BinanceAPI;
+
+/**
+ * @class UserDataStream
+ * @brief WebSocket client for the account's user data stream, publishing order and balance updates
+ *
+ * Creates a listen key over REST, connects to <base_url>/ws/<listenKey> and
+ * decodes execution reports into OrderUpdateEvent values and account
+ * position and balance update events into BalanceUpdateEvent values, which
+ * are copied into each consumer's single-producer single-consumer ring
+ * buffer. A second thread keeps the listen key alive. If the key expires,
+ * its keepalive fails or the connection drops, a new key is created and the
+ * stream reconnects with backoff; events sent while disconnected are lost,
+ * so reconcile with getOpenOrders() after reconnects() moves if that matters.
+ */
+class UserDataStream {
+public:
+    /**
+     * @brief Constructor
+     * @param api Client used to create, keep alive and close listen keys; must outlive the stream
+     * @param base_url Stream endpoint, e.g. "wss://stream.binance.com:9443" or
+     *        "wss://stream.testnet.binance.vision"
+     */
+    explicit UserDataStream(BinanceAPI& api, const std::string& base_url = "wss://stream.binance.com:9443");
+
+    /**
+     * @brief Destructor; stops the threads
+     */
+    ~UserDataStream();
+
+    UserDataStream(const UserDataStream&) = delete;
+    UserDataStream& operator=(const UserDataStream&) = delete;
+
+    /**
+     * @brief Register a consumer of order updates; call before start()
+     * @param capacity Minimum queue length; rounded up to a power of two
+     * @return The consumer's queue, to be drained by one thread
+     */
+    std::shared_ptr<OrderUpdateQueue> addOrderConsumer(size_t capacity = 1024);
+
+    /**
+     * @brief Register a consumer of balance updates; call before start()
+     * @param capacity Minimum queue length; rounded up to a power of two
+     * @return The consumer's queue, to be drained by one thread
+     */
+    std::shared_ptr<BalanceUpdateQueue> addBalanceConsumer(size_t capacity = 1024);
+
+    /**
+     * @brief How often the listen key is kept alive (default 30 minutes; keys expire after 60)
+     */
+    void setKeepAliveInterval(std::chrono::milliseconds interval);
+
+    /**
+     * @brief Start the I/O and keepalive threads
+     */
+    void start();
+
+    /**
+     * @brief Stop the threads, close the connection and the listen key
+     */
+    void stop();
+
+    /**
+     * @brief Whether the connection is currently open
+     */
+    bool isConnected() const;
+
+    /**
+     * @brief Listen key of the current connection, empty if none
+     */
+    std::string listenKey() const;
+
+    /**
+     * @brief Messages received since start()
+     */
+    uint64_t messagesReceived() const;
+
+    /**
+     * @brief Events not delivered because a consumer queue was full
+     */
+    uint64_t eventsDropped() const;
+
+    /**
+     * @brief Messages that failed to decode and were skipped
+     */
+    uint64_t decodeErrors() const;
+
+    /**
+     * @brief Connections that failed to open or ended with an error, and failed keepalives
+     */
+    uint64_t connectionErrors() const;
+
+    /**
+     * @brief Message of the most recent connection or keepalive error, empty if there was none
+     */
+    std::string lastError() const;
+
+    /**
+     * @brief Number of times the connection was re-established
+     */
+    uint64_t reconnects() const;
+
+    /**
+     * @brief Successful listen key keepalives
+     */
+    uint64_t keepAlives() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace binance
+
+#endif // USER_DATA_STREAM_H
@@ -0,0 +1,104 @@
+#ifndef WEBSOCKET_CLIENT_H
+#define WEBSOCKET_CLIENT_H
+
+#include <string>
+#include <string_view>
+#include <memory>
+
+namespace binance {
+
+/**
+ * @class WebSocketClient
+ * @brief Minimal RFC 6455 client over a plain or TLS socket
+ *
+ * Supports ws:// and wss:// URLs, text and binary messages, fragmented
+ * messages, and answers pings from the server automatically. Receiving is
+ * meant for one thread; sending is serialized internally, so any thread may
+ * send while another receives. A connection that goes quiet for longer than
+ * the read timeout is treated as dead, since a dropped connection that was
+ * never closed (e.g. by a NAT) would otherwise block receive() forever.
+ */
+class WebSocketClient {
+public:
+    /**
+     * @brief Constructor
+     */
+    WebSocketClient();
+
+    /**
+     * @brief Destructor; closes the connection
+     */
+    ~WebSocketClient();
+
+    WebSocketClient(const WebSocketClient&) = delete;
+    WebSocketClient& operator=(const WebSocketClient&) = delete;
+
+    /**
+     * @brief Connect and perform the opening handshake
+     * @param url ws:// or wss:// URL including path and query
+     * @param timeoutMs Longest wait for any single step of the connection setup
+     * @throws std::runtime_error if the connection or handshake fails or is interrupted
+     */
+    void connect(const std::string& url, int timeoutMs = 10000);
+
+    /**
+     * @brief Longest receive() waits for data once connected
+     *
+     * Binance pings every 20 seconds, so the default of 60 seconds only
+     * passes on a connection that has stopped delivering anything.
+     * @param timeoutMs Milliseconds; 0 waits forever
+     */
+    void setReadTimeout(int timeoutMs);
+
+    /**
+     * @brief Whether the connection is open
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Send a text message
+     * @param message UTF-8 payload
+     * @throws std::runtime_error if the connection is closed or the write fails
+     */
+    void sendText(std::string_view message);
+
+    /**
+     * @brief Block until the next complete data message arrives
+     *
+     * Control frames are handled here: pings are answered with pongs and a
+     * close frame from the server is acknowledged.
+     * @param message Receives the payload; its capacity is reused between calls
+     * @return False once the connection has been closed
+     * @throws std::runtime_error on socket or protocol errors, or when no data
+     *         arrived within the read timeout; the connection is closed then
+     */
+    bool receive(std::string& message);
+
+    /**
+     * @brief Send a close frame and shut the connection down
+     */
+    void close();
+
+    /**
+     * @brief Unblock a receive() in progress on another thread
+     *
+     * Shuts the socket down without the closing handshake; receive() then
+     * returns false and a connect() in progress fails.
+     */
+    void interrupt();
+
+    /**
+     * @brief Compute the Sec-WebSocket-Accept value for a handshake key
+     * @param key The client's Sec-WebSocket-Key
+     * @return Base64 of SHA-1(key + RFC 6455 GUID)
+     */
+    static std::string acceptKey(std::string_view key);
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace binance
+
+#endif // WEBSOCKET_CLIENT_H
@@ -0,0 +1,511 @@
+#include "../include/Backtester.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace binance {
+
+namespace {
+
+// Exchange error codes for the requests the simulated exchange refuses
+constexpr int MANDATORY_PARAM_MISSING = -1102;
+constexpr int INVALID_ORDER_TYPE = -1116;
+constexpr int NEW_ORDER_REJECTED = -2010;
+constexpr int UNKNOWN_ORDER = -2011;
+
+constexpr size_t NO_ORDER = static_cast<size_t>(-1);
+
+} // namespace
+
+// Implementation class using the PIMPL idiom
+class SimulatedGateway::Impl {
+public:
+    explicit Impl(const BacktestConfig& config)
+        : position(config.startingBase), quote(config.startingQuote), config(config) {}
+
+    std::string placeOrder(const OrderParams& params) {
+        std::string clientOrderId = params.newClientOrderId.value_or("bt-" + std::to_string(orders.size() + 1));
+
+        Order order;
+        order.update.symbol.assign(params.symbol);
+        order.update.clientOrderId.assign(clientOrderId);
+        order.update.side = params.side;
+        order.update.type = params.type;
+        order.update.price = params.price.value_or(Decimal());
+        order.update.quantity = params.quantity.value_or(Decimal());
+        order.hasPrice = params.price.has_value();
+        orders.push_back(order);
+        byClientId[clientOrderId] = orders.size() - 1;
+
+        requests.push_back(Request{now + config.latencyMicros, orders.size() - 1, false, {}});
+        return clientOrderId;
+    }
+
+    void cancelOrder(const std::string& symbol, const std::string& clientOrderId) {
+        Request request{now + config.latencyMicros, NO_ORDER, true, {}};
+        request.unknown.symbol.assign(symbol);
+        request.unknown.clientOrderId.assign(clientOrderId);
+        auto it = byClientId.find(clientOrderId);
+        if (it != byClientId.end() && orders[it->second].update.symbol == request.unknown.symbol.view()) {
+            request.order = it->second;
+        }
+        requests.push_back(request);
+    }
+
+    size_t poll(const std::function<void(const OrderUpdateEvent&)>& sink) {
+        if (outbox.empty()) {
+            return 0;
+        }
+        // The sink may send new requests; they only produce updates at a later match
+        delivering.swap(outbox);
+        for (const OrderUpdateEvent& update : delivering) {
+            sink(update);
+        }
+        size_t delivered = delivering.size();
+        delivering.clear();
+        return delivered;
+    }
+
+    void setTime(int64_t nowMicros) {
+        now = nowMicros;
+    }
+
+    size_t match(int64_t nowMicros, Decimal open, Decimal low, Decimal high) {
+        now = nowMicros;
+        while (!requests.empty() && requests.front().activeAt <= now) {
+            Request request = requests.front();
+            requests.pop_front();
+            if (request.cancel) {
+                arriveCancel(request);
+            } else {
+                arrive(request.order, open);
+            }
+        }
+
+        for (size_t i = 0; i < resting.size();) {
+            Order& order = orders[resting[i]];
+            bool crossed = order.update.side == OrderSide::BUY ? low <= order.update.price
+                                                               : high >= order.update.price;
+            if (crossed) {
+                fill(order, order.update.price, config.makerFee);
+                resting.erase(resting.begin() + static_cast<std::ptrdiff_t>(i));
+            } else {
+                ++i;
+            }
+        }
+        return outbox.size();
+    }
+
+    size_t orderCount() const { return orders.size(); }
+    size_t fillCount() const { return fills; }
+
+    Decimal position;
+    Decimal quote;
+    Decimal fees;
+
+private:
+    struct Order {
+        OrderUpdateEvent update;  // Current state of the order
+        bool hasPrice = false;
+    };
+
+    struct Request {
+        int64_t activeAt;
+        size_t order;              // NO_ORDER for a cancel of an unknown order
+        bool cancel;
+        OrderUpdateEvent unknown;  // Identifies the order of a failed cancel
+    };
+
+    const BacktestConfig config;
+    int64_t now = 0;
+    int64_t nextOrderId = 1;
+    size_t fills = 0;
+    std::vector<Order> orders;
+    std::unordered_map<std::string, size_t> byClientId;
+    std::deque<Request> requests;
+    std::vector<size_t> resting;
+    std::vector<OrderUpdateEvent> outbox;
+    std::vector<OrderUpdateEvent> delivering;
+
+    void emit(OrderUpdateEvent update) {
+        update.eventTime = now / 1000;
+        outbox.push_back(update);
+    }
+
+    void reject(Order& order, int errorCode) {
+        order.update.status = OrderStatus::REJECTED;
+        OrderUpdateEvent update = order.update;
+        update.errorCode = errorCode;
+        emit(update);
+    }
+
+    void arrive(size_t index, Decimal price) {
+        Order& order = orders[index];
+        OrderType type = order.update.type;
+        if (type != OrderType::MARKET && type != OrderType::LIMIT && type != OrderType::LIMIT_MAKER) {
+            reject(order, INVALID_ORDER_TYPE);
+            return;
+        }
+        if (order.update.quantity <= Decimal() || (type != OrderType::MARKET && !order.hasPrice)) {
+            reject(order, MANDATORY_PARAM_MISSING);
+            return;
+        }
+
+        order.update.orderId = nextOrderId++;
+        bool buy = order.update.side == OrderSide::BUY;
+        bool marketable = type == OrderType::MARKET ||
+                          (buy ? order.update.price >= price : order.update.price <= price);
+        if (!marketable) {
+            order.update.status = OrderStatus::NEW;
+            emit(order.update);
+            resting.push_back(index);
+        } else if (type == OrderType::LIMIT_MAKER) {
+            reject(order, NEW_ORDER_REJECTED);  // Would immediately match and take
+        } else {
+            fill(order, price, config.takerFee);
+        }
+    }
+
+    void arriveCancel(const Request& request) {
+        auto it = request.order == NO_ORDER ? resting.end()
+                                            : std::find(resting.begin(), resting.end(), request.order);
+        if (it == resting.end()) {
+            OrderUpdateEvent update = request.order == NO_ORDER ? request.unknown : orders[request.order].update;
+            update.errorCode = UNKNOWN_ORDER;
+            update.cancelRejected = true;
+            emit(update);
+            return;
+        }
+        resting.erase(it);
+        Order& order = orders[request.order];
+        order.update.status = OrderStatus::CANCELED;
+        emit(order.update);
+    }
+
+    void fill(Order& order, Decimal price, Decimal feeRate) {
+        Decimal quantity = order.update.quantity;
+        Decimal notional = price * quantity;
+        Decimal fee = notional * feeRate;
+        if (order.update.side == OrderSide::BUY) {
+            position += quantity;
+            quote -= notional + fee;
+        } else {
+            position -= quantity;
+            quote += notional - fee;
+        }
+        fees += fee;
+        ++fills;
+
+        order.update.status = OrderStatus::FILLED;
+        order.update.executedQty = quantity;
+        order.update.cumulativeQuoteQty = notional;
+        order.update.lastPrice = price;
+        order.update.lastQty = quantity;
+        emit(order.update);
+    }
+};
+
+SimulatedGateway::SimulatedGateway(const BacktestConfig& config) : pImpl(std::make_unique<Impl>(config)) {}
+
+SimulatedGateway::~SimulatedGateway() = default;
+
+std::string SimulatedGateway::placeOrder(const OrderParams& order) {
+    return pImpl->placeOrder(order);
+}
+
+void SimulatedGateway::cancelOrder(const std::string& symbol, const std::string& clientOrderId) {
+    pImpl->cancelOrder(symbol, clientOrderId);
+}
+
+size_t SimulatedGateway::poll(const std::function<void(const OrderUpdateEvent&)>& sink) {
+    return pImpl->poll(sink);
+}
+
+void SimulatedGateway::setTime(int64_t nowMicros) {
+    pImpl->setTime(nowMicros);
+}
+
+size_t SimulatedGateway::match(int64_t nowMicros, Decimal open, Decimal low, Decimal high) {
+    return pImpl->match(nowMicros, open, low, high);
+}
+
+size_t SimulatedGateway::orderCount() const {
+    return pImpl->orderCount();
+}
+
+size_t SimulatedGateway::fillCount() const {
+    return pImpl->fillCount();
+}
+
+Decimal SimulatedGateway::position() const {
+    return pImpl->position;
+}
+
+Decimal SimulatedGateway::quote() const {
+    return pImpl->quote;
+}
+
+Decimal SimulatedGateway::fees() const {
+    return pImpl->fees;
+}
+
+namespace {
+
+// Drives one strategy through one file on the file's clock
+class Replay : public StrategyContext {
+public:
+    Replay(const HistoryFile& history, const BacktestConfig& config, Strategy& strategy)
+        : history(history), config(config), strategy(strategy), gateway(config),
+          orderSink([this](const OrderUpdateEvent& update) { this->strategy.onOrderUpdate(update); }) {}
+
+    BacktestResult run() {
+        auto started = std::chrono::steady_clock::now();
+        // The clock starts at the first event, so timers set in onStart count from there
+        if (history.size() > 0) {
+            if (history.kind() == HistoryKind::TRADES) {
+                start(history.trades().time[0] * 1000, Decimal::fromUnits(history.trades().price[0]));
+            } else {
+                start(history.klines().openTime[0] * 1000, Decimal::fromUnits(history.klines().open[0]));
+            }
+        }
+        strategy.bind(this);
+        strategy.onStart();
+        if (history.kind() == HistoryKind::TRADES) {
+            replayTrades();
+        } else {
+            replayKlines();
+        }
+        strategy.onStop();
+        strategy.bind(nullptr);
+
+        BacktestResult result;
+        result.events = history.size();
+        result.orders = gateway.orderCount();
+        result.fills = gateway.fillCount();
+        result.position = gateway.position();
+        result.quote = gateway.quote();
+        result.fees = gateway.fees();
+        result.lastPrice = lastPrice;
+        result.pnl = history.size() == 0 ? 0 : equity - startingEquity;
+        result.maxDrawdown = maxDrawdown;
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        return result;
+    }
+
+    // StrategyContext
+
+    OrderGateway& orderGateway() override {
+        return gateway;
+    }
+
+    TimerId scheduleTimer(Strategy& target, int64_t delayMicros, int64_t periodMicros) override {
+        TimerId id = ++lastTimerId;
+        timers.push(Timer{now + std::max<int64_t>(delayMicros, 0), id, &target,
+                          std::max<int64_t>(periodMicros, 0)});
+        return id;
+    }
+
+    void cancelTimer(TimerId id) override {
+        if (id != 0 && id <= lastTimerId) {
+            cancelledTimers.insert(id);
+        }
+    }
+
+    int64_t nowMicros() const override {
+        return now;
+    }
+
+private:
+    struct Timer {
+        int64_t deadline;
+        TimerId id;
+        Strategy* strategy;
+        int64_t period;
+
+        bool operator>(const Timer& other) const {
+            return deadline != other.deadline ? deadline > other.deadline : id > other.id;
+        }
+    };
+
+    const HistoryFile& history;
+    const BacktestConfig& config;
+    Strategy& strategy;
+    SimulatedGateway gateway;
+    std::function<void(const OrderUpdateEvent&)> orderSink;
+    int64_t now = 0;
+
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> timers;
+    std::unordered_set<TimerId> cancelledTimers;
+    TimerId lastTimerId = 0;
+
+    // Balances as doubles for marking to market on every event
+    double position = 0;
+    double quote = 0;
+    double startingEquity = 0;
+    double equity = 0;
+    double peakEquity = 0;
+    double maxDrawdown = 0;
+    Decimal lastPrice;
+
+    void replayTrades() {
+        const TradeColumns& columns = history.trades();
+        TradeEvent trade;
+        trade.symbol.assign(history.symbol());
+        for (size_t i = 0; i < history.size(); ++i) {
+            int64_t time = columns.time[i] * 1000;
+            Decimal price = Decimal::fromUnits(columns.price[i]);
+            advanceTo(time);
+            if (gateway.match(time, price, price, price) != 0) {
+                deliverOrderUpdates();
+            }
+
+            trade.eventTime = columns.time[i];
+            trade.tradeTime = columns.time[i];
+            trade.tradeId = static_cast<int64_t>(i) + 1;
+            trade.price = price;
+            trade.quantity = Decimal::fromUnits(columns.quantity[i]);
+            trade.isBuyerMaker = columns.buyerMaker[i] != 0;
+            strategy.onTrade(trade);
+            mark(price);
+        }
+    }
+
+    void replayKlines() {
+        const KlineColumns& columns = history.klines();
+        KlineEvent kline;
+        kline.symbol.assign(history.symbol());
+        history.interval().copy(kline.interval, sizeof(kline.interval) - 1);
+        kline.closed = true;
+        for (size_t i = 0; i < history.size(); ++i) {
+            int64_t openTime = columns.openTime[i] * 1000;
+            Decimal open = Decimal::fromUnits(columns.open[i]);
+            advanceTo(openTime);
+            if (gateway.match(openTime, open, Decimal::fromUnits(columns.low[i]),
+                              Decimal::fromUnits(columns.high[i])) != 0) {
+                deliverOrderUpdates();
+            }
+
+            int64_t closeTime = columns.closeTime[i] * 1000;
+            advanceTo(closeTime);
+            gateway.setTime(closeTime);
+            kline.eventTime = columns.closeTime[i];
+            kline.startTime = columns.openTime[i];
+            kline.closeTime = columns.closeTime[i];
+            kline.open = open;
+            kline.high = Decimal::fromUnits(columns.high[i]);
+            kline.low = Decimal::fromUnits(columns.low[i]);
+            kline.close = Decimal::fromUnits(columns.close[i]);
+            kline.volume = Decimal::fromUnits(columns.volume[i]);
+            strategy.onKline(kline);
+            mark(kline.close);
+        }
+    }
+
+    void start(int64_t time, Decimal price) {
+        now = time;
+        gateway.setTime(time);
+        position = config.startingBase.toDouble();
+        quote = config.startingQuote.toDouble();
+        startingEquity = quote + position * price.toDouble();
+        equity = startingEquity;
+        peakEquity = startingEquity;
+    }
+
+    // Fire the timers due by the given time, each at its own deadline
+    void advanceTo(int64_t time) {
+        while (!timers.empty() && timers.top().deadline <= time) {
+            Timer timer = timers.top();
+            timers.pop();
+            if (!cancelledTimers.empty() && cancelledTimers.erase(timer.id) != 0) {
+                continue;
+            }
+            now = timer.deadline;
+            gateway.setTime(now);
+            if (timer.period > 0) {
+                timer.deadline += timer.period;
+                timers.push(timer);
+            }
+            timer.strategy->onTimer(timer.id);
+        }
+        now = time;
+    }
+
+    void deliverOrderUpdates() {
+        gateway.poll(orderSink);
+        position = gateway.position().toDouble();
+        quote = gateway.quote().toDouble();
+    }
+
+    void mark(Decimal price) {
+        lastPrice = price;
+        equity = quote + position * price.toDouble();
+        peakEquity = std::max(peakEquity, equity);
+        maxDrawdown = std::max(maxDrawdown, peakEquity - equity);
+    }
+};
+
+} // namespace
+
+Backtester::Backtester(const HistoryFile& history, const BacktestConfig& config)
+    : history_(history), config_(config) {}
+
+BacktestResult Backtester::run(Strategy& strategy) {
+    Replay replay(history_, config_, strategy);
+    return replay.run();
+}
+
+std::vector<BacktestResult> Backtester::sweep(const HistoryFile& history, size_t count,
+                                              const std::function<std::unique_ptr<Strategy>(size_t)>& factory,
+                                              const BacktestConfig& config, size_t threads) {
+    if (threads == 0) {
+        threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    threads = std::min(threads, count);
+
+    std::vector<BacktestResult> results(count);
+    std::atomic<size_t> next{0};
+    std::mutex errorMutex;
+    std::exception_ptr error;
+
+    auto worker = [&]() {
+        for (size_t index = next.fetch_add(1); index < count; index = next.fetch_add(1)) {
+            try {
+                std::unique_ptr<Strategy> strategy = factory(index);
+                if (!strategy) {
+                    throw std::invalid_argument("Strategy factory returned null for run " + std::to_string(index));
+                }
+                results[index] = Backtester(history, config).run(*strategy);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                next.store(count);
+                return;
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < threads; ++i) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    return results;
+}
+
+} // namespace binance
@@ -2,13 +2,102 @@
 #include "../include/HttpClient.h"
 #include "../include/BinanceAuth.h"
 #include "../include/BinanceTypes.h"
+#include "../include/RequestBuilder.h"
+#include "../include/RateLimiter.h"
+#include "../include/JsonReader.h"
+#include "../include/RiskEngine.h"
 #include <string>
+#include <string_view>
 #include <map>
-#include <sstream>
+#include <initializer_list>
+#include <functional>
 #include <stdexcept>
 
 namespace binance {
 
+namespace {
+
+// Copy the caller's extra parameters, leaving out the keys the endpoint sets itself
+void addParams(RequestBuilder& request, const std::map<std::string, std::string>& params,
+               std::initializer_list<std::string_view> reserved = {}) {
+    for (const auto& param : params) {
+        bool skip = false;
+        for (std::string_view key : reserved) {
+            if (param.first == key) {
+                skip = true;
+                break;
+            }
+        }
+        if (!skip) {
+            request.add(param.first, param.second);
+        }
+    }
+}
+
+// Value of a parameter in a query string, or empty if it is absent
+std::string_view paramValue(std::string_view query, std::string_view key) {
+    size_t pos = 0;
+    while (pos < query.size()) {
+        size_t end = query.find('&', pos);
+        if (end == std::string_view::npos) {
+            end = query.size();
+        }
+        std::string_view pair = query.substr(pos, end - pos);
+        if (pair.size() > key.size() && pair[key.size()] == '=' && pair.compare(0, key.size(), key) == 0) {
+            return pair.substr(key.size() + 1);
+        }
+        pos = end + 1;
+    }
+    return {};
+}
+
+Decimal decimalParam(std::string_view query, std::string_view key) {
+    std::string_view value = paramValue(query, key);
+    return value.empty() ? Decimal() : Decimal::parse(value);
+}
+
+// Parameter of one order in a list, named the way the exchange names it:
+// listKey("pendingAbove", "Price") is "pendingAbovePrice", listKey("", "Side") is "side"
+std::string listKey(const char* prefix, const char* name) {
+    std::string key(prefix);
+    key += name;
+    if (!*prefix) {
+        key[0] = static_cast<char>(key[0] - 'A' + 'a');
+    }
+    return key;
+}
+
+// A cancel-replace in ALLOW_FAILURE mode fails as a whole when the cancel
+// fails, but may still have placed its new order
+bool newOrderPlaced(std::string_view error) {
+    return error.find("\"newOrderResult\":\"SUCCESS\"") != std::string_view::npos;
+}
+
+// Wire names, without building a std::string per request
+const char* sideName(OrderSide side) {
+    return side == OrderSide::BUY ? "BUY" : "SELL";
+}
+
+const char* typeName(OrderType type) {
+    switch (type) {
+        case OrderType::LIMIT: return "LIMIT";
+        case OrderType::MARKET: return "MARKET";
+        case OrderType::STOP_LOSS: return "STOP_LOSS";
+        case OrderType::STOP_LOSS_LIMIT: return "STOP_LOSS_LIMIT";
+        case OrderType::TAKE_PROFIT: return "TAKE_PROFIT";
+        case OrderType::TAKE_PROFIT_LIMIT: return "TAKE_PROFIT_LIMIT";
+        case OrderType::LIMIT_MAKER: return "LIMIT_MAKER";
+    }
+    throw std::invalid_argument("Invalid order type");
+}
+
+// An order the risk engine stopped fails the way an exchange reject would
+std::string riskReject(RiskResult result) {
+    return std::string("{\"code\":-2010,\"msg\":\"Risk check failed: ") + toString(result) + "\"}";
+}
+
+} // namespace
+
 // Implementation class using the PIMPL idiom
 class BinanceAPI::Impl {
 public:
@@ -16,224 +105,589 @@ public:
         : auth(api_key, api_secret), base_url(base_url) {
         
         httpClient.init();
+        // The API key header never changes, so build it once for every request
+        httpClient.setDefaultHeaders(auth.createHeaders());
+        // Every response carries the exchange's view of our usage
+        httpClient.setResponseObserver([this](const ResponseInfo& info) { limiter.update(info); });
     }
 
     ~Impl() = default;
 
     std::string createOrder(const std::string& symbol, const std::string& side, const std::string& type, 
-                          const std::map<std::string, std::string>& params = {}) {
-        std::map<std::string, std::string> requestParams = params;
-        requestParams["symbol"] = symbol;
-        requestParams["side"] = side;
-        requestParams["type"] = type;
-        
-        return sendSignedRequest("POST", "/api/v3/order", requestParams);
+                          RequestBuilder& request) {
+        request.add("symbol", symbol).add("side", side).add("type", type);
+        RiskTicket ticket;
+        RiskResult risk = reserveRisk(symbol, side, type, request, ticket);
+        return sendOrder(request, risk, ticket);
+    }
+
+    std::string createOrder(SymbolId symbol, OrderSide side, OrderType type, RequestBuilder& request) {
+        request.addPair(symbols.param(symbol)).add("side", sideName(side)).add("type", typeName(type));
+        RiskTicket ticket;
+        RiskResult risk = reserveRisk(symbol, side, type, request, ticket);
+        return sendOrder(request, risk, ticket);
     }
 
     std::string testOrder(const std::string& symbol, const std::string& side, const std::string& type, 
-                        const std::map<std::string, std::string>& params = {}) {
-        std::map<std::string, std::string> requestParams = params;
-        requestParams["symbol"] = symbol;
-        requestParams["side"] = side;
-        requestParams["type"] = type;
-        
-        return sendSignedRequest("POST", "/api/v3/order/test", requestParams);
+                        RequestBuilder& request) {
+        request.add("symbol", symbol).add("side", side).add("type", type);
+        return sendSignedRequest(HttpMethod::POST, "/api/v3/order/test", request);
     }
 
-    std::string queryOrder(const std::string& symbol, const std::map<std::string, std::string>& params) {
-        std::map<std::string, std::string> requestParams = params;
-        requestParams["symbol"] = symbol;
-        
-        return sendSignedRequest("GET", "/api/v3/order", requestParams);
+    std::string testOrder(SymbolId symbol, OrderSide side, OrderType type, RequestBuilder& request) {
+        request.addPair(symbols.param(symbol)).add("side", sideName(side)).add("type", typeName(type));
+        return sendSignedRequest(HttpMethod::POST, "/api/v3/order/test", request);
     }
 
-    std::string cancelOrder(const std::string& symbol, const std::map<std::string, std::string>& params) {
-        std::map<std::string, std::string> requestParams = params;
-        requestParams["symbol"] = symbol;
-        
-        return sendSignedRequest("DELETE", "/api/v3/order", requestParams);
+    std::string queryOrder(const std::string& symbol, RequestBuilder& request) {
+        request.add("symbol", symbol);
+        return sendSignedRequest(HttpMethod::GET, "/api/v3/order", request, 4);
     }
 
-    std::string cancelAllOrders(const std::string& symbol, const std::map<std::string, std::string>& params = {}) {
-        std::map<std::string, std::string> requestParams = params;
-        requestParams["symbol"] = symbol;
-        
-        return sendSignedRequest("DELETE", "/api/v3/openOrders", requestParams);
+    std::string queryOrder(SymbolId symbol, RequestBuilder& request) {
+        request.addPair(symbols.param(symbol));
+        return sendSignedRequest(HttpMethod::GET, "/api/v3/order", request, 4);
+    }
+
+    std::string cancelOrder(const std::string& symbol, RequestBuilder& request) {
+        request.add("symbol", symbol);
+        return sendSignedRequest(HttpMethod::DEL, "/api/v3/order", request);
+    }
+
+    std::string cancelOrder(SymbolId symbol, RequestBuilder& request) {
+        request.addPair(symbols.param(symbol));
+        return sendSignedRequest(HttpMethod::DEL, "/api/v3/order", request);
+    }
+
+    std::string cancelAllOrders(const std::string& symbol, RequestBuilder& request) {
+        request.add("symbol", symbol);
+        return sendSignedRequest(HttpMethod::DEL, "/api/v3/openOrders", request);
+    }
+
+    std::string cancelAllOrders(SymbolId symbol, RequestBuilder& request) {
+        request.addPair(symbols.param(symbol));
+        return sendSignedRequest(HttpMethod::DEL, "/api/v3/openOrders", request);
     }
 
     std::string cancelReplaceOrder(const std::string& symbol, const std::string& side, 
                                  const std::string& type, const std::string& cancelReplaceMode,
-                                 const std::map<std::string, std::string>& params) {
-        std::map<std::string, std::string> requestParams = params;
-        requestParams["symbol"] = symbol;
-        requestParams["side"] = side;
-        requestParams["type"] = type;
-        requestParams["cancelReplaceMode"] = cancelReplaceMode;
-        
-        return sendSignedRequest("POST", "/api/v3/order/cancelReplace", requestParams);
+                                 RequestBuilder& request) {
+        request.add("symbol", symbol).add("side", side).add("type", type)
+               .add("cancelReplaceMode", cancelReplaceMode);
+        RiskTicket ticket;
+        RiskResult risk = reserveRisk(symbol, side, type, request, ticket);
+        return sendOrder(request, risk, ticket, "/api/v3/order/cancelReplace");
+    }
+
+    bool tryCreateOrder(const std::string& symbol, const std::string& side, const std::string& type,
+                        RequestBuilder& request, Response& response) {
+        request.add("symbol", symbol).add("side", side).add("type", type);
+        RiskTicket ticket;
+        RiskResult risk = reserveRisk(symbol, side, type, request, ticket);
+        return trySendOrder(request, risk, ticket, response);
+    }
+
+    bool tryCreateOrder(SymbolId symbol, OrderSide side, OrderType type, RequestBuilder& request,
+                        Response& response) {
+        request.addPair(symbols.param(symbol)).add("side", sideName(side)).add("type", typeName(type));
+        RiskTicket ticket;
+        RiskResult risk = reserveRisk(symbol, side, type, request, ticket);
+        return trySendOrder(request, risk, ticket, response);
+    }
+
+    bool tryTestOrder(const std::string& symbol, const std::string& side, const std::string& type,
+                      RequestBuilder& request, Response& response) {
+        request.add("symbol", symbol).add("side", side).add("type", type);
+        return trySendSignedRequest(HttpMethod::POST, "/api/v3/order/test", request, response);
     }
 
-    std::string getOpenOrders(const std::string& symbol = "", const std::map<std::string, std::string>& params = {}) {
-        std::map<std::string, std::string> requestParams = params;
+    bool tryTestOrder(SymbolId symbol, OrderSide side, OrderType type, RequestBuilder& request,
+                      Response& response) {
+        request.addPair(symbols.param(symbol)).add("side", sideName(side)).add("type", typeName(type));
+        return trySendSignedRequest(HttpMethod::POST, "/api/v3/order/test", request, response);
+    }
+
+    bool tryQueryOrder(const std::string& symbol, RequestBuilder& request, Response& response) {
+        request.add("symbol", symbol);
+        return trySendSignedRequest(HttpMethod::GET, "/api/v3/order", request, response, 4);
+    }
+
+    bool tryQueryOrder(SymbolId symbol, RequestBuilder& request, Response& response) {
+        request.addPair(symbols.param(symbol));
+        return trySendSignedRequest(HttpMethod::GET, "/api/v3/order", request, response, 4);
+    }
+
+    bool tryCancelOrder(const std::string& symbol, RequestBuilder& request, Response& response) {
+        request.add("symbol", symbol);
+        return trySendSignedRequest(HttpMethod::DEL, "/api/v3/order", request, response);
+    }
+
+    bool tryCancelOrder(SymbolId symbol, RequestBuilder& request, Response& response) {
+        request.addPair(symbols.param(symbol));
+        return trySendSignedRequest(HttpMethod::DEL, "/api/v3/order", request, response);
+    }
+
+    bool tryCancelReplaceOrder(const std::string& symbol, const std::string& side, const std::string& type,
+                               const std::string& cancelReplaceMode, RequestBuilder& request,
+                               Response& response) {
+        request.add("symbol", symbol).add("side", side).add("type", type)
+               .add("cancelReplaceMode", cancelReplaceMode);
+        RiskTicket ticket;
+        RiskResult risk = reserveRisk(symbol, side, type, request, ticket);
+        return trySendOrder(request, risk, ticket, response, "/api/v3/order/cancelReplace");
+    }
+
+    std::string getOpenOrders(const std::string& symbol, const std::map<std::string, std::string>& params) {
+        RequestBuilder request;
         if (!symbol.empty()) {
-            requestParams["symbol"] = symbol;
+            request.add("symbol", symbol);
+            addParams(request, params, {"symbol"});
+        } else {
+            addParams(request, params);
         }
-        
-        return sendSignedRequest("GET", "/api/v3/openOrders", requestParams);
+        return sendSignedRequest(HttpMethod::GET, "/api/v3/openOrders", request, symbol.empty() ? 80 : 6);
     }
 
-    std::string getAllOrders(const std::string& symbol, const std::map<std::string, std::string>& params = {}) {
-        std::map<std::string, std::string> requestParams = params;
-        requestParams["symbol"] = symbol;
-        
-        return sendSignedRequest("GET", "/api/v3/allOrders", requestParams);
+    std::string getAllOrders(const std::string& symbol, const std::map<std::string, std::string>& params) {
+        RequestBuilder request;
+        request.add("symbol", symbol);
+        addParams(request, params, {"symbol"});
+        return sendSignedRequest(HttpMethod::GET, "/api/v3/allOrders", request, 20);
     }
 
     std::string createOCO(const std::string& symbol, const std::string& side, const std::string& quantity,
                         const std::string& price, const std::string& stopPrice,
-                        const std::map<std::string, std::string>& params = {}) {
-        std::map<std::string, std::string> requestParams = params;
-        requestParams["symbol"] = symbol;
-        requestParams["side"] = side;
-        requestParams["quantity"] = quantity;
-        requestParams["price"] = price;
-        requestParams["stopPrice"] = stopPrice;
-        
-        return sendSignedRequest("POST", "/api/v3/order/oco", requestParams);
+                        const std::map<std::string, std::string>& params) {
+        RequestBuilder request;
+        request.add("symbol", symbol).add("side", side).add("quantity", quantity)
+               .add("price", price).add("stopPrice", stopPrice);
+        addParams(request, params, {"symbol", "side", "quantity", "price", "stopPrice"});
+        RiskTicket ticket;
+        RiskResult risk = RiskResult::OK;
+        if (riskEngine) {
+            // A limit maker, and a stop that is a limit order only with stopLimitPrice
+            OrderSide orderSide = orderSideFromString(side);
+            Decimal orderQuantity = Decimal::parse(quantity);
+            auto stopLimit = params.find("stopLimitPrice");
+            bool limited = stopLimit != params.end();
+            ListOrder orders[2] = {
+                {orderSide, OrderType::LIMIT_MAKER, Decimal::parse(price), orderQuantity},
+                {orderSide, limited ? OrderType::STOP_LOSS_LIMIT : OrderType::STOP_LOSS,
+                 limited ? Decimal::parse(stopLimit->second) : Decimal(), orderQuantity}};
+            risk = reserveOrders(riskEngine->registry().find(symbol), orders, 2, ticket);
+        }
+        return sendOrder(request, risk, ticket, "/api/v3/order/oco", 2);
     }
 
     std::string createOrderListOCO(const std::string& symbol, const std::string& side, 
                                  const std::string& quantity, 
                                  const std::map<std::string, std::string>& params) {
-        std::map<std::string, std::string> requestParams = params;
-        requestParams["symbol"] = symbol;
-        requestParams["side"] = side;
-        requestParams["quantity"] = quantity;
-        
-        return sendSignedRequest("POST", "/api/v3/orderList/oco", requestParams);
+        RequestBuilder request;
+        request.add("symbol", symbol).add("side", side).add("quantity", quantity);
+        addParams(request, params, {"symbol", "side", "quantity"});
+        RiskTicket ticket;
+        RiskResult risk = reserveListRisk(symbol, request, {{"above", ""}, {"below", ""}}, ticket);
+        return sendOrder(request, risk, ticket, "/api/v3/orderList/oco", 2);
     }
 
     std::string createOrderListOTO(const std::string& symbol,
                                  const std::map<std::string, std::string>& params) {
-        std::map<std::string, std::string> requestParams = params;
-        requestParams["symbol"] = symbol;
-        
-        return sendSignedRequest("POST", "/api/v3/orderList/oto", requestParams);
+        RequestBuilder request;
+        request.add("symbol", symbol);
+        addParams(request, params, {"symbol"});
+        RiskTicket ticket;
+        RiskResult risk = reserveListRisk(symbol, request, {{"working", "working"}, {"pending", "pending"}}, ticket);
+        return sendOrder(request, risk, ticket, "/api/v3/orderList/oto", 2);
     }
 
     std::string createOrderListOTOCO(const std::string& symbol,
                                    const std::map<std::string, std::string>& params) {
-        std::map<std::string, std::string> requestParams = params;
-        requestParams["symbol"] = symbol;
-        
-        return sendSignedRequest("POST", "/api/v3/orderList/otoco", requestParams);
+        RequestBuilder request;
+        request.add("symbol", symbol);
+        addParams(request, params, {"symbol"});
+        RiskTicket ticket;
+        RiskResult risk = reserveListRisk(
+            symbol, request, {{"working", "working"}, {"pendingAbove", "pending"}, {"pendingBelow", "pending"}}, ticket);
+        return sendOrder(request, risk, ticket, "/api/v3/orderList/otoco", 3);
     }
 
     std::string cancelOrderList(const std::string& symbol,
                               const std::map<std::string, std::string>& params) {
-        std::map<std::string, std::string> requestParams = params;
-        requestParams["symbol"] = symbol;
-        
-        return sendSignedRequest("DELETE", "/api/v3/orderList", requestParams);
+        RequestBuilder request;
+        request.add("symbol", symbol);
+        addParams(request, params, {"symbol"});
+        return sendSignedRequest(HttpMethod::DEL, "/api/v3/orderList", request);
     }
 
     std::string queryOrderList(const std::map<std::string, std::string>& params) {
-        return sendSignedRequest("GET", "/api/v3/orderList", params);
+        RequestBuilder request;
+        addParams(request, params);
+        return sendSignedRequest(HttpMethod::GET, "/api/v3/orderList", request, 4);
     }
 
-    std::string getAllOrderLists(const std::map<std::string, std::string>& params = {}) {
-        return sendSignedRequest("GET", "/api/v3/allOrderList", params);
+    std::string getAllOrderLists(const std::map<std::string, std::string>& params) {
+        RequestBuilder request;
+        addParams(request, params);
+        return sendSignedRequest(HttpMethod::GET, "/api/v3/allOrderList", request, 20);
     }
 
-    std::string getOpenOrderLists(const std::map<std::string, std::string>& params = {}) {
-        return sendSignedRequest("GET", "/api/v3/openOrderList", params);
+    std::string getOpenOrderLists(const std::map<std::string, std::string>& params) {
+        RequestBuilder request;
+        addParams(request, params);
+        return sendSignedRequest(HttpMethod::GET, "/api/v3/openOrderList", request, 6);
     }
 
     std::string createSOROrder(const std::string& symbol, const std::string& side, 
-                             const std::string& type, const std::map<std::string, std::string>& params = {}) {
-        std::map<std::string, std::string> requestParams = params;
-        requestParams["symbol"] = symbol;
-        requestParams["side"] = side;
-        requestParams["type"] = type;
-        
-        return sendSignedRequest("POST", "/api/v3/sor/order", requestParams);
+                             const std::string& type, const std::map<std::string, std::string>& params) {
+        RequestBuilder request;
+        request.add("symbol", symbol).add("side", side).add("type", type);
+        addParams(request, params, {"symbol", "side", "type"});
+        RiskTicket ticket;
+        RiskResult risk = reserveRisk(symbol, side, type, request, ticket);
+        return sendOrder(request, risk, ticket, "/api/v3/sor/order");
     }
 
     std::string testSOROrder(const std::string& symbol, const std::string& side, 
-                           const std::string& type, const std::map<std::string, std::string>& params = {}) {
-        std::map<std::string, std::string> requestParams = params;
-        requestParams["symbol"] = symbol;
-        requestParams["side"] = side;
-        requestParams["type"] = type;
-        
-        return sendSignedRequest("POST", "/api/v3/sor/order/test", requestParams);
+                           const std::string& type, const std::map<std::string, std::string>& params) {
+        RequestBuilder request;
+        request.add("symbol", symbol).add("side", side).add("type", type);
+        addParams(request, params, {"symbol", "side", "type"});
+        return sendSignedRequest(HttpMethod::POST, "/api/v3/sor/order/test", request);
     }
 
-    std::string sendPublicRequest(const std::string& endpoint, [[maybe_unused]] const std::string& method,
-                                 const std::map<std::string, std::string>& params) {
-        std::string url = base_url + endpoint;
-        std::string queryString = paramsToQueryString(params);
-        
-        if (!queryString.empty()) {
-            url += "?" + queryString;
+    std::future<std::string> createOrderAsync(const std::string& symbol, const std::string& side,
+                                              const std::string& type,
+                                              const std::map<std::string, std::string>& params) {
+        RequestBuilder request;
+        request.add("symbol", symbol).add("side", side).add("type", type);
+        addParams(request, params, {"symbol", "side", "type"});
+        RiskTicket ticket;
+        RiskResult risk = reserveRisk(symbol, side, type, request, ticket);
+        return sendOrderAsync(request, risk, ticket, "/api/v3/order");
+    }
+
+    std::future<std::string> testOrderAsync(const std::string& symbol, const std::string& side,
+                                            const std::string& type,
+                                            const std::map<std::string, std::string>& params) {
+        RequestBuilder request;
+        request.add("symbol", symbol).add("side", side).add("type", type);
+        addParams(request, params, {"symbol", "side", "type"});
+        return sendSignedRequestAsync(HttpMethod::POST, "/api/v3/order/test", request);
+    }
+
+    std::future<std::string> queryOrderAsync(const std::string& symbol,
+                                             const std::map<std::string, std::string>& params) {
+        RequestBuilder request;
+        request.add("symbol", symbol);
+        addParams(request, params, {"symbol"});
+        return sendSignedRequestAsync(HttpMethod::GET, "/api/v3/order", request, 4);
+    }
+
+    std::future<std::string> cancelOrderAsync(const std::string& symbol,
+                                              const std::map<std::string, std::string>& params) {
+        RequestBuilder request;
+        request.add("symbol", symbol);
+        addParams(request, params, {"symbol"});
+        return sendSignedRequestAsync(HttpMethod::DEL, "/api/v3/order", request);
+    }
+
+    std::future<std::string> cancelAllOrdersAsync(const std::string& symbol,
+                                                  const std::map<std::string, std::string>& params) {
+        RequestBuilder request;
+        request.add("symbol", symbol);
+        addParams(request, params, {"symbol"});
+        return sendSignedRequestAsync(HttpMethod::DEL, "/api/v3/openOrders", request);
+    }
+
+    std::future<std::string> cancelReplaceOrderAsync(const std::string& symbol, const std::string& side,
+                                                     const std::string& type,
+                                                     const std::string& cancelReplaceMode,
+                                                     const std::map<std::string, std::string>& params) {
+        RequestBuilder request;
+        request.add("symbol", symbol).add("side", side).add("type", type)
+               .add("cancelReplaceMode", cancelReplaceMode);
+        addParams(request, params, {"symbol", "side", "type", "cancelReplaceMode"});
+        RiskTicket ticket;
+        RiskResult risk = reserveRisk(symbol, side, type, request, ticket);
+        return sendOrderAsync(request, risk, ticket, "/api/v3/order/cancelReplace");
+    }
+
+    std::string sendPublicRequest(const char* endpoint, const RequestBuilder& request, int64_t weight = 1) {
+        limiter.acquire(RequestPriority::NORMAL, weight);
+
+        RequestBuilder url;
+        url.append(base_url).append(endpoint);
+        if (!request.empty()) {
+            url.append("?").append(request.view());
         }
-        
-        std::map<std::string, std::string> headers;
-        return httpClient.get(url, headers);
+        return httpClient.request(HttpMethod::GET, url.data());
     }
 
+    // User data stream requests carry the API key header but are not signed
+    std::string sendKeyedRequest(HttpMethod method, const char* endpoint, const RequestBuilder& request,
+                                 int64_t weight) {
+        limiter.acquire(priorityOf(method), weight);
+
+        RequestBuilder url;
+        url.append(base_url).append(endpoint);
+        if (method == HttpMethod::POST || method == HttpMethod::PUT) {
+            return httpClient.request(method, url.data(), request.data(), request.size());
+        }
+        if (!request.empty()) {
+            url.append("?").append(request.view());
+        }
+        return httpClient.request(method, url.data());
+    }
+
+    std::vector<EndpointMetrics> httpMetrics(bool reset) {
+        return httpClient.metrics(reset);
+    }
+
+    RateLimiter limiter;
+    RiskEngine* riskEngine = nullptr;
+    SymbolRegistry symbols;
+
 private:
     BinanceAuth auth;
     HttpClient httpClient;
     std::string base_url;
 
-    std::string paramsToQueryString(const std::map<std::string, std::string>& params) {
-        if (params.empty()) {
-            return "";
+    // What a request took from the risk engine, given back if it fails: one
+    // reservation per order it places, up to the three of an OTOCO list
+    struct RiskTicket {
+        struct Order {
+            SymbolId id = INVALID_SYMBOL;
+            OrderSide side = OrderSide::BUY;
+            Decimal quantity;
+        };
+        Order orders[3];
+        size_t count = 0;
+    };
+
+    // An order of a list
+    struct ListOrder {
+        OrderSide side;
+        OrderType type;
+        Decimal price;
+        Decimal quantity;
+    };
+
+    // Where a list's request names an order's parameters
+    struct ListOrderKeys {
+        const char* prefix;      // Of its type and price, e.g. "pendingAbove"
+        const char* sidePrefix;  // Of its side and quantity, e.g. "pending"
+    };
+
+    // Checks a new order with the risk engine before it is signed
+    RiskResult reserveRisk(const std::string& symbol, const std::string& side, const std::string& type,
+                           const RequestBuilder& request, RiskTicket& ticket) {
+        if (!riskEngine) {
+            return RiskResult::OK;
         }
-        
-        std::stringstream ss;
-        bool first = true;
-        for (const auto& pair : params) {
-            if (!first) {
-                ss << "&";
+        return reserveRiskAs(riskEngine->registry().find(symbol), orderSideFromString(side),
+                             orderTypeFromString(type), request, ticket);
+    }
+
+    RiskResult reserveRisk(SymbolId symbol, OrderSide side, OrderType type, const RequestBuilder& request,
+                           RiskTicket& ticket) {
+        if (!riskEngine) {
+            return RiskResult::OK;
+        }
+        // Ids carry over when the engine shares this client's registry
+        SymbolRegistry& engineSymbols = riskEngine->registry();
+        SymbolId id = &engineSymbols == &symbols ? symbol : engineSymbols.find(symbols.name(symbol));
+        return reserveRiskAs(id, side, type, request, ticket);
+    }
+
+    // id is in the risk engine's registry
+    RiskResult reserveRiskAs(SymbolId id, OrderSide side, OrderType type, const RequestBuilder& request,
+                             RiskTicket& ticket) {
+        std::string_view query = request.view();
+        return reserveLeg(id, side, type, decimalParam(query, "price"), decimalParam(query, "quantity"),
+                          decimalParam(query, "quoteOrderQty"), ticket);
+    }
+
+    // Checks every order of a list, named in the request the way the exchange names them
+    RiskResult reserveListRisk(const std::string& symbol, const RequestBuilder& request,
+                               std::initializer_list<ListOrderKeys> keys, RiskTicket& ticket) {
+        if (!riskEngine) {
+            return RiskResult::OK;
+        }
+        std::string_view query = request.view();
+        ListOrder orders[3];
+        size_t count = 0;
+        for (const ListOrderKeys& order : keys) {
+            orders[count++] = {orderSideFromString(paramValue(query, listKey(order.sidePrefix, "Side"))),
+                               orderTypeFromString(paramValue(query, listKey(order.prefix, "Type"))),
+                               decimalParam(query, listKey(order.prefix, "Price")),
+                               decimalParam(query, listKey(order.sidePrefix, "Quantity"))};
+        }
+        return reserveOrders(riskEngine->registry().find(symbol), orders, count, ticket);
+    }
+
+    // All or nothing: if one order fails, the ones before it are given back
+    RiskResult reserveOrders(SymbolId id, const ListOrder* orders, size_t count, RiskTicket& ticket) {
+        for (size_t i = 0; i < count; ++i) {
+            RiskResult result = reserveLeg(id, orders[i].side, orders[i].type, orders[i].price, orders[i].quantity,
+                                           Decimal(), ticket);
+            if (result != RiskResult::OK) {
+                releaseRisk(ticket);
+                return result;
             }
-            ss << pair.first << "=" << pair.second;
-            first = false;
         }
-        return ss.str();
+        return RiskResult::OK;
     }
 
-    std::string sendSignedRequest(const std::string& method, const std::string& endpoint, 
-                                std::map<std::string, std::string> params) {
-        // Add timestamp and signature
-        auth.signRequest(params);
-        
-        // Create URL with query string for GET requests or DELETE requests with params
-        std::string url = base_url + endpoint;
-        std::string queryString = paramsToQueryString(params);
-        
-        // Set headers
-        std::map<std::string, std::string> headers = auth.createHeaders();
-        
-        std::string response;
-        if (method == "GET") {
-            if (!queryString.empty()) {
-                url += "?" + queryString;
+    // Reserves one order and adds it to the ticket if it passes
+    RiskResult reserveLeg(SymbolId id, OrderSide side, OrderType type, Decimal price, Decimal quantity,
+                          Decimal quoteQuantity, RiskTicket& ticket) {
+        RiskResult result = riskEngine->reserve(id, side, type, price, quantity, quoteQuantity);
+        if (result == RiskResult::OK) {
+            RiskTicket::Order& order = ticket.orders[ticket.count++];
+            order.id = id;
+            order.side = side;
+            order.quantity = quantity;
+        }
+        return result;
+    }
+
+    // The request failed; a transport error may hide an order that did reach the
+    // exchange, but holding its reservation forever would block the symbol
+    static void releaseRisk(RiskEngine* engine, const RiskTicket& ticket) {
+        for (size_t i = 0; i < ticket.count; ++i) {
+            engine->release(ticket.orders[i].id, ticket.orders[i].side, ticket.orders[i].quantity);
+        }
+    }
+
+    void releaseRisk(RiskTicket& ticket) {
+        releaseRisk(riskEngine, ticket);
+        ticket.count = 0;
+    }
+
+    // Completion hook for an asynchronous order; it runs on the event loop
+    // thread, before the caller's future becomes ready
+    std::function<void(bool, std::string_view)> releaseOnFailure(const RiskTicket& ticket) {
+        if (ticket.count == 0) {
+            return nullptr;
+        }
+        RiskEngine* engine = riskEngine;
+        return [engine, ticket](bool ok, std::string_view body) {
+            if (!ok && !newOrderPlaced(body)) {
+                releaseRisk(engine, ticket);
             }
-            response = httpClient.get(url, headers);
-        } else if (method == "POST") {
-            response = httpClient.post(url, queryString, headers);
-        } else if (method == "DELETE") {
-            if (!queryString.empty()) {
-                url += "?" + queryString;
+        };
+    }
+
+    // Sends a request that places orders: orders counts them for the rate limiter
+    std::string sendOrder(RequestBuilder& request, RiskResult risk, RiskTicket& ticket,
+                          const char* endpoint = "/api/v3/order", int64_t orders = 1) {
+        if (risk != RiskResult::OK) {
+            throw std::runtime_error(riskReject(risk));
+        }
+        try {
+            return sendSignedRequest(HttpMethod::POST, endpoint, request, 1, orders);
+        } catch (const std::exception& e) {
+            if (!newOrderPlaced(e.what())) {
+                releaseRisk(ticket);
             }
-            response = httpClient.del(url, headers);
-        } else {
-            throw std::invalid_argument("Unsupported HTTP method: " + method);
+            throw;
+        } catch (...) {
+            releaseRisk(ticket);
+            throw;
         }
-        
-        return response;
+    }
+
+    bool trySendOrder(RequestBuilder& request, RiskResult risk, RiskTicket& ticket, Response& response,
+                      const char* endpoint = "/api/v3/order") {
+        if (risk != RiskResult::OK) {
+            // Answered here the way the exchange would have answered it
+            response.clear();
+            response.status = 400;
+            response.code = -2010;
+            response.body = riskReject(risk);
+            return false;
+        }
+        bool ok;
+        try {
+            ok = trySendSignedRequest(HttpMethod::POST, endpoint, request, response, 1, 1);
+        } catch (...) {
+            releaseRisk(ticket);
+            throw;
+        }
+        if (!ok && !newOrderPlaced(response.body)) {
+            releaseRisk(ticket);
+        }
+        return ok;
+    }
+
+    std::future<std::string> sendOrderAsync(RequestBuilder& request, RiskResult risk, RiskTicket& ticket,
+                                            const char* endpoint) {
+        if (risk != RiskResult::OK) {
+            throw std::runtime_error(riskReject(risk));
+        }
+        try {
+            return sendSignedRequestAsync(HttpMethod::POST, endpoint, request, 1, 1, releaseOnFailure(ticket));
+        } catch (...) {
+            releaseRisk(ticket);
+            throw;
+        }
+    }
+
+    // Cancels free up risk, so they are scheduled ahead of everything else
+    static RequestPriority priorityOf(HttpMethod method) {
+        return method == HttpMethod::DEL ? RequestPriority::HIGH : RequestPriority::NORMAL;
+    }
+
+    std::string sendSignedRequest(HttpMethod method, const char* endpoint, RequestBuilder& request,
+                                  int64_t weight = 1, int64_t orders = 0) {
+        // Wait for budget before signing, so the timestamp is fresh
+        limiter.acquire(priorityOf(method), weight, orders);
+
+        // Add timestamp and signature in place
+        auth.signRequest(request);
+
+        RequestBuilder url;
+        url.append(base_url).append(endpoint);
+        if (method == HttpMethod::POST) {
+            // The signed bytes go out as the body without another copy
+            return httpClient.request(method, url.data(), request.data(), request.size());
+        }
+        url.append("?").append(request.view());
+        return httpClient.request(method, url.data());
+    }
+
+    bool trySendSignedRequest(HttpMethod method, const char* endpoint, RequestBuilder& request,
+                              Response& response, int64_t weight = 1, int64_t orders = 0) {
+        limiter.acquire(priorityOf(method), weight, orders);
+        auth.signRequest(request);
+
+        RequestBuilder url;
+        url.append(base_url).append(endpoint);
+        if (method == HttpMethod::POST) {
+            return httpClient.tryRequest(method, url.data(), response, request.data(), request.size());
+        }
+        url.append("?").append(request.view());
+        return httpClient.tryRequest(method, url.data(), response);
+    }
+
+    std::future<std::string> sendSignedRequestAsync(HttpMethod method, const char* endpoint,
+                                                    RequestBuilder& request,
+                                                    int64_t weight = 1, int64_t orders = 0,
+                                                    std::function<void(bool, std::string_view)> onComplete = nullptr) {
+        // Wait for budget before signing, so the timestamp is fresh
+        limiter.acquire(priorityOf(method), weight, orders);
+
+        // Add timestamp and signature in place
+        auth.signRequest(request);
+
+        // The transfer outlives this call, so it takes its own copies
+        std::string url = base_url + endpoint;
+        if (method == HttpMethod::POST) {
+            return httpClient.requestAsync(method, url, request.str(), std::move(onComplete));
+        }
+        url += '?';
+        url.append(request.data(), request.size());
+        return httpClient.requestAsync(method, url, "", std::move(onComplete));
     }
 };
 
@@ -247,32 +701,134 @@ BinanceAPI::~BinanceAPI() = default;
 
 std::string BinanceAPI::createOrder(const std::string& symbol, const std::string& side, 
                                    const std::string& type, const std::map<std::string, std::string>& params) {
+    RequestBuilder request;
+    addParams(request, params, {"symbol", "side", "type"});
+    return pImpl->createOrder(symbol, side, type, request);
+}
+
+std::string BinanceAPI::createOrder(const std::string& symbol, const std::string& side,
+                                   const std::string& type, RequestBuilder& params) {
+    return pImpl->createOrder(symbol, side, type, params);
+}
+
+std::string BinanceAPI::createOrder(SymbolId symbol, OrderSide side, OrderType type, RequestBuilder& params) {
     return pImpl->createOrder(symbol, side, type, params);
 }
 
 std::string BinanceAPI::testOrder(const std::string& symbol, const std::string& side, 
                                  const std::string& type, const std::map<std::string, std::string>& params) {
+    RequestBuilder request;
+    addParams(request, params, {"symbol", "side", "type"});
+    return pImpl->testOrder(symbol, side, type, request);
+}
+
+std::string BinanceAPI::testOrder(const std::string& symbol, const std::string& side,
+                                 const std::string& type, RequestBuilder& params) {
+    return pImpl->testOrder(symbol, side, type, params);
+}
+
+std::string BinanceAPI::testOrder(SymbolId symbol, OrderSide side, OrderType type, RequestBuilder& params) {
     return pImpl->testOrder(symbol, side, type, params);
 }
 
 std::string BinanceAPI::queryOrder(const std::string& symbol, const std::map<std::string, std::string>& params) {
+    RequestBuilder request;
+    addParams(request, params, {"symbol"});
+    return pImpl->queryOrder(symbol, request);
+}
+
+std::string BinanceAPI::queryOrder(const std::string& symbol, RequestBuilder& params) {
+    return pImpl->queryOrder(symbol, params);
+}
+
+std::string BinanceAPI::queryOrder(SymbolId symbol, RequestBuilder& params) {
     return pImpl->queryOrder(symbol, params);
 }
 
 std::string BinanceAPI::cancelOrder(const std::string& symbol, const std::map<std::string, std::string>& params) {
+    RequestBuilder request;
+    addParams(request, params, {"symbol"});
+    return pImpl->cancelOrder(symbol, request);
+}
+
+std::string BinanceAPI::cancelOrder(const std::string& symbol, RequestBuilder& params) {
+    return pImpl->cancelOrder(symbol, params);
+}
+
+std::string BinanceAPI::cancelOrder(SymbolId symbol, RequestBuilder& params) {
     return pImpl->cancelOrder(symbol, params);
 }
 
 std::string BinanceAPI::cancelAllOrders(const std::string& symbol, const std::map<std::string, std::string>& params) {
+    RequestBuilder request;
+    addParams(request, params, {"symbol"});
+    return pImpl->cancelAllOrders(symbol, request);
+}
+
+std::string BinanceAPI::cancelAllOrders(const std::string& symbol, RequestBuilder& params) {
+    return pImpl->cancelAllOrders(symbol, params);
+}
+
+std::string BinanceAPI::cancelAllOrders(SymbolId symbol, RequestBuilder& params) {
     return pImpl->cancelAllOrders(symbol, params);
 }
 
 std::string BinanceAPI::cancelReplaceOrder(const std::string& symbol, const std::string& side, 
                                           const std::string& type, const std::string& cancelReplaceMode,
                                           const std::map<std::string, std::string>& params) {
+    RequestBuilder request;
+    addParams(request, params, {"symbol", "side", "type", "cancelReplaceMode"});
+    return pImpl->cancelReplaceOrder(symbol, side, type, cancelReplaceMode, request);
+}
+
+std::string BinanceAPI::cancelReplaceOrder(const std::string& symbol, const std::string& side,
+                                          const std::string& type, const std::string& cancelReplaceMode,
+                                          RequestBuilder& params) {
     return pImpl->cancelReplaceOrder(symbol, side, type, cancelReplaceMode, params);
 }
 
+bool BinanceAPI::tryCreateOrder(const std::string& symbol, const std::string& side, const std::string& type,
+                                RequestBuilder& params, Response& response) {
+    return pImpl->tryCreateOrder(symbol, side, type, params, response);
+}
+
+bool BinanceAPI::tryTestOrder(const std::string& symbol, const std::string& side, const std::string& type,
+                              RequestBuilder& params, Response& response) {
+    return pImpl->tryTestOrder(symbol, side, type, params, response);
+}
+
+bool BinanceAPI::tryQueryOrder(const std::string& symbol, RequestBuilder& params, Response& response) {
+    return pImpl->tryQueryOrder(symbol, params, response);
+}
+
+bool BinanceAPI::tryCancelOrder(const std::string& symbol, RequestBuilder& params, Response& response) {
+    return pImpl->tryCancelOrder(symbol, params, response);
+}
+
+bool BinanceAPI::tryCreateOrder(SymbolId symbol, OrderSide side, OrderType type, RequestBuilder& params,
+                                Response& response) {
+    return pImpl->tryCreateOrder(symbol, side, type, params, response);
+}
+
+bool BinanceAPI::tryTestOrder(SymbolId symbol, OrderSide side, OrderType type, RequestBuilder& params,
+                              Response& response) {
+    return pImpl->tryTestOrder(symbol, side, type, params, response);
+}
+
+bool BinanceAPI::tryQueryOrder(SymbolId symbol, RequestBuilder& params, Response& response) {
+    return pImpl->tryQueryOrder(symbol, params, response);
+}
+
+bool BinanceAPI::tryCancelOrder(SymbolId symbol, RequestBuilder& params, Response& response) {
+    return pImpl->tryCancelOrder(symbol, params, response);
+}
+
+bool BinanceAPI::tryCancelReplaceOrder(const std::string& symbol, const std::string& side, const std::string& type,
+                                       const std::string& cancelReplaceMode, RequestBuilder& params,
+                                       Response& response) {
+    return pImpl->tryCancelReplaceOrder(symbol, side, type, cancelReplaceMode, params, response);
+}
+
 std::string BinanceAPI::getOpenOrders(const std::string& symbol, const std::map<std::string, std::string>& params) {
     return pImpl->getOpenOrders(symbol, params);
 }
@@ -331,11 +887,181 @@ std::string BinanceAPI::testSOROrder(const std::string& symbol, const std::strin
 }
 
 std::string BinanceAPI::getSymbolPriceTicker(const std::string& symbol, const std::map<std::string, std::string>& params) {
-    std::map<std::string, std::string> queryParams = params;
+    RequestBuilder request;
     if (!symbol.empty()) {
-        queryParams["symbol"] = symbol;
+        request.add("symbol", symbol);
+        addParams(request, params, {"symbol"});
+    } else {
+        addParams(request, params);
+    }
+    return pImpl->sendPublicRequest("/api/v3/ticker/price", request, symbol.empty() ? 4 : 2);
+}
+
+std::string BinanceAPI::getOrderBook(const std::string& symbol, int limit) {
+    RequestBuilder request;
+    request.add("symbol", symbol).add("limit", static_cast<int64_t>(limit));
+    // Weight by limit as documented for GET /api/v3/depth
+    int64_t weight = limit <= 100 ? 5 : limit <= 500 ? 25 : limit <= 1000 ? 50 : 250;
+    return pImpl->sendPublicRequest("/api/v3/depth", request, weight);
+}
+
+DepthSnapshot BinanceAPI::getOrderBookTyped(const std::string& symbol, int limit) {
+    return parseDepthSnapshot(getOrderBook(symbol, limit));
+}
+
+OrderInfo BinanceAPI::createOrderTyped(const std::string& symbol, const std::string& side,
+                                       const std::string& type, const std::map<std::string, std::string>& params) {
+    return parseOrderInfo(createOrder(symbol, side, type, params));
+}
+
+TestOrderResult BinanceAPI::testOrderTyped(const std::string& symbol, const std::string& side,
+                                           const std::string& type, const std::map<std::string, std::string>& params) {
+    return parseTestOrderResult(testOrder(symbol, side, type, params));
+}
+
+OrderInfo BinanceAPI::queryOrderTyped(const std::string& symbol, const std::map<std::string, std::string>& params) {
+    return parseOrderInfo(queryOrder(symbol, params));
+}
+
+OrderInfo BinanceAPI::cancelOrderTyped(const std::string& symbol, const std::map<std::string, std::string>& params) {
+    return parseOrderInfo(cancelOrder(symbol, params));
+}
+
+CancelReplaceResult BinanceAPI::cancelReplaceOrderTyped(const std::string& symbol, const std::string& side,
+                                                        const std::string& type,
+                                                        const std::string& cancelReplaceMode,
+                                                        const std::map<std::string, std::string>& params) {
+    return parseCancelReplaceResult(cancelReplaceOrder(symbol, side, type, cancelReplaceMode, params));
+}
+
+std::vector<OrderInfo> BinanceAPI::getOpenOrdersTyped(const std::string& symbol, const std::map<std::string, std::string>& params) {
+    return parseOrderInfoList(getOpenOrders(symbol, params));
+}
+
+std::vector<OrderInfo> BinanceAPI::getAllOrdersTyped(const std::string& symbol, const std::map<std::string, std::string>& params) {
+    return parseOrderInfoList(getAllOrders(symbol, params));
+}
+
+OrderListInfo BinanceAPI::createOrderListOCOTyped(const std::string& symbol, const std::string& side,
+                                                  const std::string& quantity, const std::map<std::string, std::string>& params) {
+    return parseOrderListInfo(createOrderListOCO(symbol, side, quantity, params));
+}
+
+OrderListInfo BinanceAPI::createOrderListOTOTyped(const std::string& symbol, const std::map<std::string, std::string>& params) {
+    return parseOrderListInfo(createOrderListOTO(symbol, params));
+}
+
+OrderListInfo BinanceAPI::createOrderListOTOCOTyped(const std::string& symbol, const std::map<std::string, std::string>& params) {
+    return parseOrderListInfo(createOrderListOTOCO(symbol, params));
+}
+
+OrderListInfo BinanceAPI::cancelOrderListTyped(const std::string& symbol, const std::map<std::string, std::string>& params) {
+    return parseOrderListInfo(cancelOrderList(symbol, params));
+}
+
+OrderListInfo BinanceAPI::queryOrderListTyped(const std::map<std::string, std::string>& params) {
+    return parseOrderListInfo(queryOrderList(params));
+}
+
+std::future<std::string> BinanceAPI::createOrderAsync(const std::string& symbol, const std::string& side,
+                                                      const std::string& type,
+                                                      const std::map<std::string, std::string>& params) {
+    return pImpl->createOrderAsync(symbol, side, type, params);
+}
+
+std::future<std::string> BinanceAPI::testOrderAsync(const std::string& symbol, const std::string& side,
+                                                    const std::string& type,
+                                                    const std::map<std::string, std::string>& params) {
+    return pImpl->testOrderAsync(symbol, side, type, params);
+}
+
+std::future<std::string> BinanceAPI::queryOrderAsync(const std::string& symbol,
+                                                     const std::map<std::string, std::string>& params) {
+    return pImpl->queryOrderAsync(symbol, params);
+}
+
+std::future<std::string> BinanceAPI::cancelOrderAsync(const std::string& symbol,
+                                                      const std::map<std::string, std::string>& params) {
+    return pImpl->cancelOrderAsync(symbol, params);
+}
+
+std::future<std::string> BinanceAPI::cancelAllOrdersAsync(const std::string& symbol,
+                                                          const std::map<std::string, std::string>& params) {
+    return pImpl->cancelAllOrdersAsync(symbol, params);
+}
+
+std::future<std::string> BinanceAPI::cancelReplaceOrderAsync(const std::string& symbol, const std::string& side,
+                                                             const std::string& type,
+                                                             const std::string& cancelReplaceMode,
+                                                             const std::map<std::string, std::string>& params) {
+    return pImpl->cancelReplaceOrderAsync(symbol, side, type, cancelReplaceMode, params);
+}
+
+RateLimiter& BinanceAPI::rateLimiter() {
+    return pImpl->limiter;
+}
+
+void BinanceAPI::setRiskEngine(RiskEngine* engine) {
+    pImpl->riskEngine = engine;
+}
+
+RiskEngine* BinanceAPI::riskEngine() const {
+    return pImpl->riskEngine;
+}
+
+SymbolRegistry& BinanceAPI::symbols() {
+    return pImpl->symbols;
+}
+
+std::vector<EndpointMetrics> BinanceAPI::httpMetrics(bool reset) {
+    return pImpl->httpMetrics(reset);
+}
+
+std::string BinanceAPI::getExchangeInfo(const std::vector<std::string>& symbols) {
+    RequestBuilder request;
+    if (symbols.size() == 1) {
+        request.add("symbol", symbols.front());
+    } else if (!symbols.empty()) {
+        // symbols=["BTCUSDT","ETHUSDT"], percent-encoded
+        std::string list = "%5B";
+        for (size_t i = 0; i < symbols.size(); ++i) {
+            list += (i > 0 ? "%2C%22" : "%22") + symbols[i] + "%22";
+        }
+        request.add("symbols", list + "%5D");
+    }
+    return pImpl->sendPublicRequest("/api/v3/exchangeInfo", request, 20);
+}
+
+std::string BinanceAPI::ping() {
+    RequestBuilder request;
+    return pImpl->sendPublicRequest("/api/v3/ping", request);
+}
+
+std::string BinanceAPI::createListenKey() {
+    RequestBuilder request;
+    std::string response = pImpl->sendKeyedRequest(HttpMethod::POST, "/api/v3/userDataStream", request, 2);
+    JsonReader reader(response);
+    reader.beginObject();
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key == "listenKey") {
+            return std::string(reader.readString());
+        }
+        reader.skipValue();
     }
-    return pImpl->sendPublicRequest("/api/v3/ticker/price", "GET", queryParams);
+    throw std::runtime_error("No listenKey in response: " + response);
+}
+
+void BinanceAPI::keepAliveListenKey(const std::string& listenKey) {
+    RequestBuilder request;
+    request.add("listenKey", listenKey);
+    pImpl->sendKeyedRequest(HttpMethod::PUT, "/api/v3/userDataStream", request, 2);
+}
+
+void BinanceAPI::closeListenKey(const std::string& listenKey) {
+    RequestBuilder request;
+    request.add("listenKey", listenKey);
+    pImpl->sendKeyedRequest(HttpMethod::DEL, "/api/v3/userDataStream", request, 2);
 }
 
 } // namespace binance
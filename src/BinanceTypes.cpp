@@ -1,5 +1,6 @@
 #include "../include/BinanceTypes.h"
-#include <sstream>
+#include "../include/RequestBuilder.h"
+#include "../include/JsonReader.h"
 #include <stdexcept>
 #include <iomanip>
 
@@ -51,6 +52,7 @@ std::string toString(SelfTradePreventionMode mode) {
         case SelfTradePreventionMode::EXPIRE_TAKER: return "EXPIRE_TAKER";
         case SelfTradePreventionMode::EXPIRE_MAKER: return "EXPIRE_MAKER";
         case SelfTradePreventionMode::EXPIRE_BOTH: return "EXPIRE_BOTH";
+        case SelfTradePreventionMode::DECREMENT: return "DECREMENT";
         default: throw std::invalid_argument("Invalid SelfTradePreventionMode value");
     }
 }
@@ -66,16 +68,31 @@ std::string toString(CancelReplaceMode mode) {
 std::string toString(OrderStatus status) {
     switch (status) {
         case OrderStatus::NEW: return "NEW";
+        case OrderStatus::PENDING_NEW: return "PENDING_NEW";
         case OrderStatus::PARTIALLY_FILLED: return "PARTIALLY_FILLED";
         case OrderStatus::FILLED: return "FILLED";
         case OrderStatus::CANCELED: return "CANCELED";
         case OrderStatus::PENDING_CANCEL: return "PENDING_CANCEL";
         case OrderStatus::REJECTED: return "REJECTED";
         case OrderStatus::EXPIRED: return "EXPIRED";
+        case OrderStatus::EXPIRED_IN_MATCH: return "EXPIRED_IN_MATCH";
         default: throw std::invalid_argument("Invalid OrderStatus value");
     }
 }
 
+std::string toString(ExecutionType type) {
+    switch (type) {
+        case ExecutionType::NEW: return "NEW";
+        case ExecutionType::CANCELED: return "CANCELED";
+        case ExecutionType::REPLACED: return "REPLACED";
+        case ExecutionType::REJECTED: return "REJECTED";
+        case ExecutionType::TRADE: return "TRADE";
+        case ExecutionType::EXPIRED: return "EXPIRED";
+        case ExecutionType::TRADE_PREVENTION: return "TRADE_PREVENTION";
+        default: throw std::invalid_argument("Invalid ExecutionType value");
+    }
+}
+
 std::string toString(ContingencyType type) {
     switch (type) {
         case ContingencyType::OCO: return "OCO";
@@ -85,14 +102,33 @@ std::string toString(ContingencyType type) {
     }
 }
 
+std::string toString(ListStatusType type) {
+    switch (type) {
+        case ListStatusType::RESPONSE: return "RESPONSE";
+        case ListStatusType::EXEC_STARTED: return "EXEC_STARTED";
+        case ListStatusType::ALL_DONE: return "ALL_DONE";
+        case ListStatusType::REJECT: return "REJECT";
+        default: throw std::invalid_argument("Invalid ListStatusType value");
+    }
+}
+
+std::string toString(ListOrderStatus status) {
+    switch (status) {
+        case ListOrderStatus::EXECUTING: return "EXECUTING";
+        case ListOrderStatus::ALL_DONE: return "ALL_DONE";
+        case ListOrderStatus::REJECT: return "REJECT";
+        default: throw std::invalid_argument("Invalid ListOrderStatus value");
+    }
+}
+
 // String to enum conversion functions
-OrderSide orderSideFromString(const std::string& str) {
+OrderSide orderSideFromString(std::string_view str) {
     if (str == "BUY") return OrderSide::BUY;
     if (str == "SELL") return OrderSide::SELL;
-    throw std::invalid_argument("Invalid order side string: " + str);
+    throw std::invalid_argument("Invalid order side string: " + std::string(str));
 }
 
-OrderType orderTypeFromString(const std::string& str) {
+OrderType orderTypeFromString(std::string_view str) {
     if (str == "LIMIT") return OrderType::LIMIT;
     if (str == "MARKET") return OrderType::MARKET;
     if (str == "STOP_LOSS") return OrderType::STOP_LOSS;
@@ -100,71 +136,90 @@ OrderType orderTypeFromString(const std::string& str) {
     if (str == "TAKE_PROFIT") return OrderType::TAKE_PROFIT;
     if (str == "TAKE_PROFIT_LIMIT") return OrderType::TAKE_PROFIT_LIMIT;
     if (str == "LIMIT_MAKER") return OrderType::LIMIT_MAKER;
-    throw std::invalid_argument("Invalid order type string: " + str);
+    throw std::invalid_argument("Invalid order type string: " + std::string(str));
 }
 
-TimeInForce timeInForceFromString(const std::string& str) {
+TimeInForce timeInForceFromString(std::string_view str) {
     if (str == "GTC") return TimeInForce::GTC;
     if (str == "IOC") return TimeInForce::IOC;
     if (str == "FOK") return TimeInForce::FOK;
-    throw std::invalid_argument("Invalid time in force string: " + str);
+    throw std::invalid_argument("Invalid time in force string: " + std::string(str));
 }
 
-OrderResponseType orderResponseTypeFromString(const std::string& str) {
+OrderResponseType orderResponseTypeFromString(std::string_view str) {
     if (str == "ACK") return OrderResponseType::ACK;
     if (str == "RESULT") return OrderResponseType::RESULT;
     if (str == "FULL") return OrderResponseType::FULL;
-    throw std::invalid_argument("Invalid order response type string: " + str);
+    throw std::invalid_argument("Invalid order response type string: " + std::string(str));
 }
 
-SelfTradePreventionMode selfTradePreventionModeFromString(const std::string& str) {
+SelfTradePreventionMode selfTradePreventionModeFromString(std::string_view str) {
     if (str == "NONE") return SelfTradePreventionMode::NONE;
     if (str == "EXPIRE_TAKER") return SelfTradePreventionMode::EXPIRE_TAKER;
     if (str == "EXPIRE_MAKER") return SelfTradePreventionMode::EXPIRE_MAKER;
     if (str == "EXPIRE_BOTH") return SelfTradePreventionMode::EXPIRE_BOTH;
-    throw std::invalid_argument("Invalid self trade prevention mode string: " + str);
+    if (str == "DECREMENT") return SelfTradePreventionMode::DECREMENT;
+    throw std::invalid_argument("Invalid self trade prevention mode string: " + std::string(str));
 }
 
-CancelReplaceMode cancelReplaceModeFromString(const std::string& str) {
+CancelReplaceMode cancelReplaceModeFromString(std::string_view str) {
     if (str == "STOP_ON_FAILURE") return CancelReplaceMode::STOP_ON_FAILURE;
     if (str == "ALLOW_FAILURE") return CancelReplaceMode::ALLOW_FAILURE;
-    throw std::invalid_argument("Invalid cancel replace mode string: " + str);
+    throw std::invalid_argument("Invalid cancel replace mode string: " + std::string(str));
 }
 
-OrderStatus orderStatusFromString(const std::string& str) {
+OrderStatus orderStatusFromString(std::string_view str) {
     if (str == "NEW") return OrderStatus::NEW;
+    if (str == "PENDING_NEW") return OrderStatus::PENDING_NEW;
     if (str == "PARTIALLY_FILLED") return OrderStatus::PARTIALLY_FILLED;
     if (str == "FILLED") return OrderStatus::FILLED;
     if (str == "CANCELED") return OrderStatus::CANCELED;
     if (str == "PENDING_CANCEL") return OrderStatus::PENDING_CANCEL;
     if (str == "REJECTED") return OrderStatus::REJECTED;
     if (str == "EXPIRED") return OrderStatus::EXPIRED;
-    throw std::invalid_argument("Invalid order status string: " + str);
+    if (str == "EXPIRED_IN_MATCH") return OrderStatus::EXPIRED_IN_MATCH;
+    throw std::invalid_argument("Invalid order status string: " + std::string(str));
+}
+
+ExecutionType executionTypeFromString(std::string_view str) {
+    if (str == "NEW") return ExecutionType::NEW;
+    if (str == "CANCELED") return ExecutionType::CANCELED;
+    if (str == "REPLACED") return ExecutionType::REPLACED;
+    if (str == "REJECTED") return ExecutionType::REJECTED;
+    if (str == "TRADE") return ExecutionType::TRADE;
+    if (str == "EXPIRED") return ExecutionType::EXPIRED;
+    if (str == "TRADE_PREVENTION") return ExecutionType::TRADE_PREVENTION;
+    throw std::invalid_argument("Invalid execution type string: " + std::string(str));
 }
 
-ContingencyType contingencyTypeFromString(const std::string& str) {
+ContingencyType contingencyTypeFromString(std::string_view str) {
     if (str == "OCO") return ContingencyType::OCO;
     if (str == "OTO") return ContingencyType::OTO;
     if (str == "OTOCO") return ContingencyType::OTOCO;
-    throw std::invalid_argument("Invalid contingency type string: " + str);
+    throw std::invalid_argument("Invalid contingency type string: " + std::string(str));
+}
+
+ListStatusType listStatusTypeFromString(std::string_view str) {
+    if (str == "RESPONSE") return ListStatusType::RESPONSE;
+    if (str == "EXEC_STARTED") return ListStatusType::EXEC_STARTED;
+    if (str == "ALL_DONE") return ListStatusType::ALL_DONE;
+    if (str == "REJECT") return ListStatusType::REJECT;
+    throw std::invalid_argument("Invalid list status type string: " + std::string(str));
+}
+
+ListOrderStatus listOrderStatusFromString(std::string_view str) {
+    if (str == "EXECUTING") return ListOrderStatus::EXECUTING;
+    if (str == "ALL_DONE") return ListOrderStatus::ALL_DONE;
+    if (str == "REJECT") return ListOrderStatus::REJECT;
+    throw std::invalid_argument("Invalid list order status string: " + std::string(str));
 }
 
 // Utility function to convert parameters to query string
 std::string paramsToQueryString(const std::map<std::string, std::string>& params) {
-    if (params.empty()) {
-        return "";
-    }
-    
-    std::stringstream ss;
-    bool first = true;
-    for (const auto& param : params) {
-        if (!first) {
-            ss << "&";
-        }
-        ss << param.first << "=" << param.second;
-        first = false;
-    }
-    return ss.str();
+    // Same serializer as signed requests, so a query built here signs identically
+    RequestBuilder query;
+    query.add(params);
+    return query.str();
 }
 
 // Convert struct types to parameter maps
@@ -180,15 +235,15 @@ std::map<std::string, std::string> toParamMap(const OrderParams& params) {
     }
     
     if (params.quantity) {
-        result["quantity"] = *params.quantity;
+        result["quantity"] = params.quantity->toString();
     }
     
     if (params.quoteOrderQty) {
-        result["quoteOrderQty"] = *params.quoteOrderQty;
+        result["quoteOrderQty"] = params.quoteOrderQty->toString();
     }
     
     if (params.price) {
-        result["price"] = *params.price;
+        result["price"] = params.price->toString();
     }
     
     if (params.newClientOrderId) {
@@ -204,7 +259,7 @@ std::map<std::string, std::string> toParamMap(const OrderParams& params) {
     }
     
     if (params.stopPrice) {
-        result["stopPrice"] = *params.stopPrice;
+        result["stopPrice"] = params.stopPrice->toString();
     }
     
     if (params.trailingDelta) {
@@ -212,7 +267,7 @@ std::map<std::string, std::string> toParamMap(const OrderParams& params) {
     }
     
     if (params.icebergQty) {
-        result["icebergQty"] = *params.icebergQty;
+        result["icebergQty"] = params.icebergQty->toString();
     }
     
     if (params.newOrderRespType) {
@@ -231,9 +286,9 @@ std::map<std::string, std::string> toParamMap(const OCOOrderParams& params) {
     
     result["symbol"] = params.symbol;
     result["side"] = toString(params.side);
-    result["quantity"] = params.quantity;
-    result["price"] = params.price;
-    result["stopPrice"] = params.stopPrice;
+    result["quantity"] = params.quantity.toString();
+    result["price"] = params.price.toString();
+    result["stopPrice"] = params.stopPrice.toString();
     
     if (params.listClientOrderId) {
         result["listClientOrderId"] = *params.listClientOrderId;
@@ -252,7 +307,7 @@ std::map<std::string, std::string> toParamMap(const OCOOrderParams& params) {
     }
     
     if (params.limitIcebergQty) {
-        result["limitIcebergQty"] = *params.limitIcebergQty;
+        result["limitIcebergQty"] = params.limitIcebergQty->toString();
     }
     
     if (params.trailingDelta) {
@@ -272,11 +327,11 @@ std::map<std::string, std::string> toParamMap(const OCOOrderParams& params) {
     }
     
     if (params.stopLimitPrice) {
-        result["stopLimitPrice"] = *params.stopLimitPrice;
+        result["stopLimitPrice"] = params.stopLimitPrice->toString();
     }
     
     if (params.stopIcebergQty) {
-        result["stopIcebergQty"] = *params.stopIcebergQty;
+        result["stopIcebergQty"] = params.stopIcebergQty->toString();
     }
     
     if (params.stopLimitTimeInForce) {
@@ -319,11 +374,11 @@ std::map<std::string, std::string> toParamMap(const OTOOrderParams& params) {
         result["workingClientOrderId"] = *params.workingClientOrderId;
     }
     
-    result["workingPrice"] = params.workingPrice;
-    result["workingQuantity"] = params.workingQuantity;
+    result["workingPrice"] = params.workingPrice.toString();
+    result["workingQuantity"] = params.workingQuantity.toString();
     
     if (params.workingIcebergQty) {
-        result["workingIcebergQty"] = *params.workingIcebergQty;
+        result["workingIcebergQty"] = params.workingIcebergQty->toString();
     }
     
     if (params.workingTimeInForce) {
@@ -347,21 +402,21 @@ std::map<std::string, std::string> toParamMap(const OTOOrderParams& params) {
     }
     
     if (params.pendingPrice) {
-        result["pendingPrice"] = *params.pendingPrice;
+        result["pendingPrice"] = params.pendingPrice->toString();
     }
     
     if (params.pendingStopPrice) {
-        result["pendingStopPrice"] = *params.pendingStopPrice;
+        result["pendingStopPrice"] = params.pendingStopPrice->toString();
     }
     
     if (params.pendingTrailingDelta) {
         result["pendingTrailingDelta"] = *params.pendingTrailingDelta;
     }
     
-    result["pendingQuantity"] = params.pendingQuantity;
+    result["pendingQuantity"] = params.pendingQuantity.toString();
     
     if (params.pendingIcebergQty) {
-        result["pendingIcebergQty"] = *params.pendingIcebergQty;
+        result["pendingIcebergQty"] = params.pendingIcebergQty->toString();
     }
     
     if (params.pendingTimeInForce) {
@@ -404,11 +459,11 @@ std::map<std::string, std::string> toParamMap(const OTOCOOrderParams& params) {
         result["workingClientOrderId"] = *params.workingClientOrderId;
     }
     
-    result["workingPrice"] = params.workingPrice;
-    result["workingQuantity"] = params.workingQuantity;
+    result["workingPrice"] = params.workingPrice.toString();
+    result["workingQuantity"] = params.workingQuantity.toString();
     
     if (params.workingIcebergQty) {
-        result["workingIcebergQty"] = *params.workingIcebergQty;
+        result["workingIcebergQty"] = params.workingIcebergQty->toString();
     }
     
     if (params.workingTimeInForce) {
@@ -425,7 +480,7 @@ std::map<std::string, std::string> toParamMap(const OTOCOOrderParams& params) {
     
     // Pending parameters
     result["pendingSide"] = toString(params.pendingSide);
-    result["pendingQuantity"] = params.pendingQuantity;
+    result["pendingQuantity"] = params.pendingQuantity.toString();
     
     // Pending above order parameters
     result["pendingAboveType"] = toString(params.pendingAboveType);
@@ -435,11 +490,11 @@ std::map<std::string, std::string> toParamMap(const OTOCOOrderParams& params) {
     }
     
     if (params.pendingAbovePrice) {
-        result["pendingAbovePrice"] = *params.pendingAbovePrice;
+        result["pendingAbovePrice"] = params.pendingAbovePrice->toString();
     }
     
     if (params.pendingAboveStopPrice) {
-        result["pendingAboveStopPrice"] = *params.pendingAboveStopPrice;
+        result["pendingAboveStopPrice"] = params.pendingAboveStopPrice->toString();
     }
     
     if (params.pendingAboveTrailingDelta) {
@@ -447,7 +502,7 @@ std::map<std::string, std::string> toParamMap(const OTOCOOrderParams& params) {
     }
     
     if (params.pendingAboveIcebergQty) {
-        result["pendingAboveIcebergQty"] = *params.pendingAboveIcebergQty;
+        result["pendingAboveIcebergQty"] = params.pendingAboveIcebergQty->toString();
     }
     
     if (params.pendingAboveTimeInForce) {
@@ -470,11 +525,11 @@ std::map<std::string, std::string> toParamMap(const OTOCOOrderParams& params) {
     }
     
     if (params.pendingBelowPrice) {
-        result["pendingBelowPrice"] = *params.pendingBelowPrice;
+        result["pendingBelowPrice"] = params.pendingBelowPrice->toString();
     }
     
     if (params.pendingBelowStopPrice) {
-        result["pendingBelowStopPrice"] = *params.pendingBelowStopPrice;
+        result["pendingBelowStopPrice"] = params.pendingBelowStopPrice->toString();
     }
     
     if (params.pendingBelowTrailingDelta) {
@@ -482,7 +537,7 @@ std::map<std::string, std::string> toParamMap(const OTOCOOrderParams& params) {
     }
     
     if (params.pendingBelowIcebergQty) {
-        result["pendingBelowIcebergQty"] = *params.pendingBelowIcebergQty;
+        result["pendingBelowIcebergQty"] = params.pendingBelowIcebergQty->toString();
     }
     
     if (params.pendingBelowTimeInForce) {
@@ -500,4 +555,214 @@ std::map<std::string, std::string> toParamMap(const OTOCOOrderParams& params) {
     return result;
 }
 
+// JSON response parsing
+namespace {
+
+Decimal readDecimal(JsonReader& reader) {
+    return Decimal::parse(reader.readScalar());
+}
+
+void readOrderFill(JsonReader& reader, OrderFill& fill) {
+    reader.beginObject();
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key == "price") fill.price = readDecimal(reader);
+        else if (key == "qty") fill.qty = readDecimal(reader);
+        else if (key == "commission") fill.commission = readDecimal(reader);
+        else if (key == "commissionAsset") fill.commissionAsset = reader.readScalar();
+        else if (key == "tradeId") fill.tradeId = reader.readScalar();
+        else reader.skipValue();
+    }
+}
+
+void readOrderFills(JsonReader& reader, std::vector<OrderFill>& fills) {
+    reader.beginArray();
+    while (reader.nextElement()) {
+        readOrderFill(reader, fills.emplace_back());
+    }
+}
+
+// Reads an order object. Binance puts {"code":...,"msg":...} in the same
+// place when an order in a compound response fails; for that shape the
+// message is stored in errorMessage and false is returned.
+bool readOrderInfo(JsonReader& reader, OrderInfo& order, std::string* errorMessage = nullptr) {
+    bool isError = false;
+    reader.beginObject();
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        // Absent values (e.g. "preventedMatchId":null) leave the field at its default
+        if (reader.readNull()) continue;
+        else if (key == "symbol") order.symbol = reader.readString();
+        else if (key == "orderId") order.orderId = reader.readInt();
+        else if (key == "orderListId") order.orderListId = reader.readInt();
+        else if (key == "clientOrderId") order.clientOrderId = reader.readString();
+        else if (key == "transactTime") order.transactTime = reader.readInt();
+        else if (key == "price") order.price = readDecimal(reader);
+        else if (key == "origQty") order.origQty = readDecimal(reader);
+        else if (key == "executedQty") order.executedQty = readDecimal(reader);
+        else if (key == "origQuoteOrderQty") order.origQuoteOrderQty = readDecimal(reader);
+        else if (key == "cummulativeQuoteQty") order.cummulativeQuoteQty = readDecimal(reader);
+        else if (key == "status") order.status = orderStatusFromString(reader.readString());
+        else if (key == "timeInForce") order.timeInForce = timeInForceFromString(reader.readString());
+        else if (key == "type") order.type = orderTypeFromString(reader.readString());
+        else if (key == "side") order.side = orderSideFromString(reader.readString());
+        else if (key == "stopPrice") order.stopPrice = readDecimal(reader);
+        else if (key == "icebergQty") order.icebergQty = readDecimal(reader);
+        else if (key == "time") order.time = reader.readInt();
+        else if (key == "updateTime") order.updateTime = reader.readInt();
+        else if (key == "isWorking") order.isWorking = reader.readBool();
+        else if (key == "workingTime") order.workingTime = reader.readInt();
+        else if (key == "selfTradePreventionMode") order.selfTradePreventionMode = selfTradePreventionModeFromString(reader.readString());
+        else if (key == "usedSor") order.usedSor = reader.readBool();
+        else if (key == "workingFloor") order.workingFloor = std::string(reader.readString());
+        else if (key == "preventedMatchId") order.preventedMatchId = reader.readInt();
+        else if (key == "preventedQuantity") order.preventedQuantity = readDecimal(reader);
+        else if (key == "strategyId") order.strategyId = reader.readInt();
+        else if (key == "strategyType") order.strategyType = static_cast<int>(reader.readInt());
+        else if (key == "trailingDelta") order.trailingDelta = reader.readInt();
+        else if (key == "trailingTime") order.trailingTime = reader.readInt();
+        else if (key == "fills") readOrderFills(reader, order.fills);
+        else if (key == "code") { isError = true; reader.skipValue(); }
+        else if (key == "msg" && errorMessage) errorMessage->assign(reader.readString());
+        else reader.skipValue();
+    }
+    return !isError;
+}
+
+void readOrderItems(JsonReader& reader, std::vector<OrderItem>& items) {
+    reader.beginArray();
+    while (reader.nextElement()) {
+        OrderItem& item = items.emplace_back();
+        reader.beginObject();
+        std::string_view key;
+        while (reader.nextKey(key)) {
+            if (key == "symbol") item.symbol = reader.readString();
+            else if (key == "orderId") item.orderId = reader.readInt();
+            else if (key == "clientOrderId") item.clientOrderId = reader.readString();
+            else reader.skipValue();
+        }
+    }
+}
+
+void readOrderReports(JsonReader& reader, std::vector<OrderInfo>& orders) {
+    reader.beginArray();
+    while (reader.nextElement()) {
+        readOrderInfo(reader, orders.emplace_back());
+    }
+}
+
+void readOrderListInfo(JsonReader& reader, OrderListInfo& list) {
+    reader.beginObject();
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key == "orderListId") list.orderListId = reader.readInt();
+        else if (key == "contingencyType") list.contingencyType = contingencyTypeFromString(reader.readString());
+        else if (key == "listStatusType") list.listStatusType = listStatusTypeFromString(reader.readString());
+        else if (key == "listOrderStatus") list.listOrderStatus = listOrderStatusFromString(reader.readString());
+        else if (key == "listClientOrderId") list.listClientOrderId = reader.readString();
+        else if (key == "transactionTime") list.transactionTime = reader.readInt();
+        else if (key == "symbol") list.symbol = reader.readString();
+        else if (key == "orders") readOrderItems(reader, list.orders);
+        else if (key == "orderReports") readOrderReports(reader, list.orderReports);
+        else reader.skipValue();
+    }
+}
+
+void readOrderResponse(JsonReader& reader, std::variant<OrderInfo, std::string>& response) {
+    OrderInfo order{};
+    std::string errorMessage;
+    if (readOrderInfo(reader, order, &errorMessage)) {
+        response = std::move(order);
+    } else {
+        response = std::move(errorMessage);
+    }
+}
+
+void readCancelReplaceResult(JsonReader& reader, CancelReplaceResult& result) {
+    reader.beginObject();
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key == "cancelResult") result.cancelResult = reader.readString() == "SUCCESS";
+        else if (key == "newOrderResult") result.newOrderResult = reader.readString() == "SUCCESS";
+        else if (key == "cancelResponse") readOrderResponse(reader, result.cancelResponse);
+        else if (key == "newOrderResponse") readOrderResponse(reader, result.newOrderResponse);
+        // Partial failures wrap the usual body in {"code":...,"msg":...,"data":{...}}
+        else if (key == "data") readCancelReplaceResult(reader, result);
+        else reader.skipValue();
+    }
+}
+
+CommissionRates readCommissionRates(JsonReader& reader) {
+    CommissionRates rates;
+    reader.beginObject();
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key == "maker") rates.maker = readDecimal(reader);
+        else if (key == "taker") rates.taker = readDecimal(reader);
+        else reader.skipValue();
+    }
+    return rates;
+}
+
+Discount readDiscount(JsonReader& reader) {
+    Discount discount{};
+    reader.beginObject();
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key == "enabledForAccount") discount.enabledForAccount = reader.readBool();
+        else if (key == "enabledForSymbol") discount.enabledForSymbol = reader.readBool();
+        else if (key == "discountAsset") discount.discountAsset = reader.readString();
+        else if (key == "discount") discount.discount = readDecimal(reader);
+        else reader.skipValue();
+    }
+    return discount;
+}
+
+} // namespace
+
+OrderInfo parseOrderInfo(std::string_view json) {
+    JsonReader reader(json);
+    OrderInfo order{};
+    std::string errorMessage;
+    if (!readOrderInfo(reader, order, &errorMessage)) {
+        throw std::runtime_error("Order response is an error: " + errorMessage);
+    }
+    return order;
+}
+
+std::vector<OrderInfo> parseOrderInfoList(std::string_view json) {
+    JsonReader reader(json);
+    std::vector<OrderInfo> orders;
+    readOrderReports(reader, orders);
+    return orders;
+}
+
+OrderListInfo parseOrderListInfo(std::string_view json) {
+    JsonReader reader(json);
+    OrderListInfo list{};
+    readOrderListInfo(reader, list);
+    return list;
+}
+
+CancelReplaceResult parseCancelReplaceResult(std::string_view json) {
+    JsonReader reader(json);
+    CancelReplaceResult result{};
+    readCancelReplaceResult(reader, result);
+    return result;
+}
+
+TestOrderResult parseTestOrderResult(std::string_view json) {
+    JsonReader reader(json);
+    TestOrderResult result;
+    reader.beginObject();
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key == "standardCommissionForOrder") result.standardCommissionForOrder = readCommissionRates(reader);
+        else if (key == "taxCommissionForOrder") result.taxCommissionForOrder = readCommissionRates(reader);
+        else if (key == "discount") result.discount = readDiscount(reader);
+        else reader.skipValue();
+    }
+    return result;
+}
+
 } // namespace binance
@@ -0,0 +1,839 @@
+#include "../include/BinanceWsTradingClient.h"
+#include "../include/BinanceAuth.h"
+#include "../include/JsonReader.h"
+#include "../include/RiskEngine.h"
+#include "../include/WebSocketClient.h"
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace binance {
+
+namespace {
+
+struct Param {
+    std::string_view key;
+    std::string_view value;
+};
+
+// Parameters one request may carry, including apiKey and timestamp
+constexpr size_t MAX_PARAMS = 32;
+
+const char* const CONNECTION_CLOSED = "WebSocket API connection closed";
+const char* const RESPONSE_TIMED_OUT = "WebSocket API response timed out";
+
+// Copy the caller's extra parameters, leaving out the keys the method sets itself
+void addParams(RequestBuilder& request, const std::map<std::string, std::string>& params,
+               std::initializer_list<std::string_view> reserved = {}) {
+    for (const auto& param : params) {
+        if (std::find(reserved.begin(), reserved.end(), param.first) == reserved.end()) {
+            request.add(param.first, param.second);
+        }
+    }
+}
+
+// Integer and boolean parameters go out as JSON numbers and literals, everything else as strings
+bool isBare(const Param& param) {
+    static const std::string_view keys[] = {"timestamp", "recvWindow", "orderId", "cancelOrderId", "strategyId",
+                                            "strategyType", "trailingDelta", "computeCommissionRates"};
+    if (std::find(std::begin(keys), std::end(keys), param.key) == std::end(keys) || param.value.empty()) {
+        return false;
+    }
+    if (param.value == "true" || param.value == "false") {
+        return true;
+    }
+    return std::all_of(param.value.begin(), param.value.end(),
+                       [](char c) { return (c >= '0' && c <= '9') || c == '-'; });
+}
+
+// Splits a serialized RequestBuilder back into its key=value pairs
+size_t splitParams(std::string_view query, Param* params) {
+    size_t count = 0;
+    while (!query.empty()) {
+        size_t end = query.find('&');
+        std::string_view pair = query.substr(0, end);
+        if (!pair.empty()) {
+            if (count == MAX_PARAMS) {
+                throw std::invalid_argument("WebSocket API request has more than " + std::to_string(MAX_PARAMS) +
+                                            " parameters");
+            }
+            size_t equals = pair.find('=');
+            params[count++] = {pair.substr(0, equals),
+                               equals == std::string_view::npos ? std::string_view() : pair.substr(equals + 1)};
+        }
+        if (end == std::string_view::npos) break;
+        query.remove_prefix(end + 1);
+    }
+    return count;
+}
+
+// Value of a parameter in a query string, or empty if it is absent
+std::string_view paramValue(std::string_view query, std::string_view key) {
+    Param params[MAX_PARAMS];
+    size_t count = splitParams(query, params);
+    for (size_t i = 0; i < count; ++i) {
+        if (params[i].key == key) {
+            return params[i].value;
+        }
+    }
+    return {};
+}
+
+Decimal decimalParam(std::string_view query, std::string_view key) {
+    std::string_view value = paramValue(query, key);
+    return value.empty() ? Decimal() : Decimal::parse(value);
+}
+
+// An order the risk engine stopped fails the way an exchange reject would
+std::string riskReject(RiskResult result) {
+    return std::string("{\"code\":-2010,\"msg\":\"Risk check failed: ") + toString(result) + "\"}";
+}
+
+// A cancel-replace in ALLOW_FAILURE mode fails as a whole when the cancel
+// fails, but may still have placed its new order
+bool newOrderPlaced(std::string_view error) {
+    return error.find("\"newOrderResult\":\"SUCCESS\"") != std::string_view::npos;
+}
+
+// Reads the rateLimits array into the form the REST usage headers take
+void readRateLimits(JsonReader& reader, ResponseInfo& info) {
+    reader.beginArray();
+    while (reader.nextElement()) {
+        std::string_view type;
+        std::string_view interval;
+        int64_t intervalNum = 1;
+        int64_t count = 0;
+        reader.beginObject();
+        std::string_view key;
+        while (reader.nextKey(key)) {
+            if (key == "rateLimitType") type = reader.readString();
+            else if (key == "interval") interval = reader.readString();
+            else if (key == "intervalNum") intervalNum = reader.readInt();
+            else if (key == "count") count = reader.readInt();
+            else reader.skipValue();
+        }
+        int64_t unit = interval == "SECOND" ? 1 : interval == "MINUTE" ? 60 : interval == "HOUR" ? 3600
+                     : interval == "DAY" ? 86400 : 0;
+        if (unit == 0 || info.usageCount == ResponseInfo::MAX_USAGES) continue;
+        if (type == "REQUEST_WEIGHT") {
+            info.usages[info.usageCount++] = {RateLimitType::REQUEST_WEIGHT, unit * intervalNum, count};
+        } else if (type == "ORDERS") {
+            info.usages[info.usageCount++] = {RateLimitType::ORDERS, unit * intervalNum, count};
+        }
+    }
+}
+
+} // namespace
+
+// Implementation class using the PIMPL idiom
+class BinanceWsTradingClient::Impl {
+public:
+    Impl(const std::string& api_key, const std::string& api_secret, const std::string& url)
+        : auth(api_key, api_secret), url(url), slots(MAX_IN_FLIGHT) {}
+
+    ~Impl() {
+        close();
+    }
+
+    void connect(int timeoutMs) {
+        std::lock_guard<std::mutex> guard(connectMutex);
+        if (connected) {
+            return;
+        }
+        if (reader.joinable()) {
+            reader.join();
+        }
+        webSocket.connect(url, timeoutMs);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            connected = true;
+        }
+        reader = std::thread(&Impl::run, this);
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> guard(connectMutex);
+        webSocket.interrupt();
+        if (reader.joinable()) {
+            reader.join();
+        }
+        webSocket.close();
+    }
+
+    bool isConnected() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return connected;
+    }
+
+    void setResponseTimeout(int64_t milliseconds) {
+        responseTimeoutMs = milliseconds;
+    }
+
+    size_t inFlight() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return pending;
+    }
+
+    bool tryCreateOrder(const std::string& symbol, const std::string& side, const std::string& type,
+                        RequestBuilder& request, Response& response) {
+        request.add("symbol", symbol).add("side", side).add("type", type);
+        return placeOrder("order.place", symbol, side, type, request, response);
+    }
+
+    bool tryTestOrder(const std::string& symbol, const std::string& side, const std::string& type,
+                      RequestBuilder& request, Response& response) {
+        request.add("symbol", symbol).add("side", side).add("type", type);
+        return call("order.test", request, RequestPriority::NORMAL, 1, 0, response);
+    }
+
+    bool tryQueryOrder(const std::string& symbol, RequestBuilder& request, Response& response) {
+        request.add("symbol", symbol);
+        return call("order.status", request, RequestPriority::NORMAL, 4, 0, response);
+    }
+
+    bool tryCancelOrder(const std::string& symbol, RequestBuilder& request, Response& response) {
+        request.add("symbol", symbol);
+        return call("order.cancel", request, RequestPriority::HIGH, 1, 0, response);
+    }
+
+    bool tryCancelReplaceOrder(const std::string& symbol, const std::string& side, const std::string& type,
+                               const std::string& cancelReplaceMode, RequestBuilder& request,
+                               Response& response) {
+        request.add("symbol", symbol).add("side", side).add("type", type)
+               .add("cancelReplaceMode", cancelReplaceMode);
+        return placeOrder("order.cancelReplace", symbol, side, type, request, response);
+    }
+
+    std::string ping() {
+        Response response;
+        RequestBuilder request;
+        callUnsigned("ping", request, response);
+        return bodyOf(response);
+    }
+
+    std::future<std::string> createOrderAsync(const std::string& symbol, const std::string& side,
+                                              const std::string& type,
+                                              const std::map<std::string, std::string>& params) {
+        RequestBuilder request;
+        request.add("symbol", symbol).add("side", side).add("type", type);
+        addParams(request, params, {"symbol", "side", "type"});
+        return placeOrderAsync("order.place", symbol, side, type, request);
+    }
+
+    std::future<std::string> testOrderAsync(const std::string& symbol, const std::string& side,
+                                            const std::string& type,
+                                            const std::map<std::string, std::string>& params) {
+        RequestBuilder request;
+        request.add("symbol", symbol).add("side", side).add("type", type);
+        addParams(request, params, {"symbol", "side", "type"});
+        return callAsync("order.test", request, RequestPriority::NORMAL, 1, 0);
+    }
+
+    std::future<std::string> queryOrderAsync(const std::string& symbol,
+                                             const std::map<std::string, std::string>& params) {
+        RequestBuilder request;
+        request.add("symbol", symbol);
+        addParams(request, params, {"symbol"});
+        return callAsync("order.status", request, RequestPriority::NORMAL, 4, 0);
+    }
+
+    std::future<std::string> cancelOrderAsync(const std::string& symbol,
+                                              const std::map<std::string, std::string>& params) {
+        RequestBuilder request;
+        request.add("symbol", symbol);
+        addParams(request, params, {"symbol"});
+        return callAsync("order.cancel", request, RequestPriority::HIGH, 1, 0);
+    }
+
+    std::future<std::string> cancelReplaceOrderAsync(const std::string& symbol, const std::string& side,
+                                                     const std::string& type, const std::string& cancelReplaceMode,
+                                                     const std::map<std::string, std::string>& params) {
+        RequestBuilder request;
+        request.add("symbol", symbol).add("side", side).add("type", type)
+               .add("cancelReplaceMode", cancelReplaceMode);
+        addParams(request, params, {"symbol", "side", "type", "cancelReplaceMode"});
+        return placeOrderAsync("order.cancelReplace", symbol, side, type, request);
+    }
+
+    // The throwing methods report errors as BinanceAPI does, with the exchange's error object
+    static std::string bodyOf(Response& response) {
+        if (response.status == 0) {
+            throw std::runtime_error(response.transportError ? response.transportError : CONNECTION_CLOSED);
+        }
+        if (!response.ok()) {
+            throw std::runtime_error("WebSocket API error " + std::to_string(response.status) + ": " + response.body);
+        }
+        return std::move(response.body);
+    }
+
+    RateLimiter limiter;
+    RiskEngine* riskEngine = nullptr;
+
+private:
+    // A request awaiting its response; the slot of request id is slots[id % MAX_IN_FLIGHT]
+    struct Slot {
+        int64_t id = 0;                      // 0 when free
+        Response* response = nullptr;        // Blocking call: filled in place
+        std::promise<std::string> promise;   // Asynchronous call
+        std::function<void(bool, std::string_view)> onComplete;  // Asynchronous call: runs before the promise is set
+    };
+
+    // What an order took from the risk engine, given back if its request fails
+    struct RiskTicket {
+        SymbolId id = INVALID_SYMBOL;
+        OrderSide side = OrderSide::BUY;
+        Decimal quantity;
+    };
+
+    BinanceAuth auth;
+    std::string url;
+    WebSocketClient webSocket;
+    std::thread reader;
+    std::mutex connectMutex;                 // Serializes connect() and close()
+    std::atomic<int64_t> responseTimeoutMs{10000};
+
+    // Guarded by mutex
+    mutable std::mutex mutex;
+    std::condition_variable changed;
+    bool connected = false;
+    std::vector<Slot> slots;
+    size_t pending = 0;
+    int64_t nextId = 1;
+
+    // Checks a new order with the risk engine before it is signed
+    RiskResult reserveRisk(const std::string& symbol, const std::string& side, const std::string& type,
+                           const RequestBuilder& request, RiskTicket& ticket) {
+        if (!riskEngine) {
+            return RiskResult::OK;
+        }
+        std::string_view query = request.view();
+        SymbolId id = riskEngine->registry().find(symbol);
+        OrderSide orderSide = orderSideFromString(side);
+        Decimal quantity = decimalParam(query, "quantity");
+        RiskResult result = riskEngine->reserve(id, orderSide, orderTypeFromString(type), decimalParam(query, "price"),
+                                                quantity, decimalParam(query, "quoteOrderQty"));
+        if (result == RiskResult::OK) {
+            ticket.id = id;
+            ticket.side = orderSide;
+            ticket.quantity = quantity;
+        }
+        return result;
+    }
+
+    // The request failed; a dropped connection may hide an order that did reach
+    // the exchange, but holding its reservation forever would block the symbol
+    static void releaseRisk(RiskEngine* engine, const RiskTicket& ticket) {
+        if (ticket.id != INVALID_SYMBOL) {
+            engine->release(ticket.id, ticket.side, ticket.quantity);
+        }
+    }
+
+    // Sends order.place or order.cancelReplace once the risk engine passed its new order
+    bool placeOrder(const char* method, const std::string& symbol, const std::string& side, const std::string& type,
+                    RequestBuilder& request, Response& response) {
+        RiskTicket ticket;
+        RiskResult risk = reserveRisk(symbol, side, type, request, ticket);
+        if (risk != RiskResult::OK) {
+            // Answered here the way the exchange would have answered it
+            response.clear();
+            response.status = 400;
+            response.code = -2010;
+            response.body = riskReject(risk);
+            return false;
+        }
+        bool ok;
+        try {
+            ok = call(method, request, RequestPriority::NORMAL, 1, 1, response);
+        } catch (...) {
+            releaseRisk(riskEngine, ticket);
+            throw;
+        }
+        if (!ok && !newOrderPlaced(response.body)) {
+            releaseRisk(riskEngine, ticket);
+        }
+        return ok;
+    }
+
+    std::future<std::string> placeOrderAsync(const char* method, const std::string& symbol, const std::string& side,
+                                             const std::string& type, RequestBuilder& request) {
+        RiskTicket ticket;
+        RiskResult risk = reserveRisk(symbol, side, type, request, ticket);
+        if (risk != RiskResult::OK) {
+            throw std::runtime_error(riskReject(risk));
+        }
+        std::function<void(bool, std::string_view)> onComplete;
+        if (ticket.id != INVALID_SYMBOL) {
+            RiskEngine* engine = riskEngine;
+            onComplete = [engine, ticket](bool ok, std::string_view body) {
+                if (!ok && !newOrderPlaced(body)) {
+                    releaseRisk(engine, ticket);
+                }
+            };
+        }
+        try {
+            return callAsync(method, request, RequestPriority::NORMAL, 1, 1, std::move(onComplete));
+        } catch (...) {
+            releaseRisk(riskEngine, ticket);
+            throw;
+        }
+    }
+
+    bool call(const char* method, RequestBuilder& request, RequestPriority priority, int64_t weight,
+              int64_t orders, Response& response) {
+        // Wait for budget before signing, so the timestamp is fresh
+        limiter.acquire(priority, weight, orders);
+        response.clear();
+        RequestBuilder message;
+        compose(message, method, request, true);
+        return await(message, response);
+    }
+
+    bool callUnsigned(const char* method, RequestBuilder& request, Response& response) {
+        limiter.acquire(RequestPriority::NORMAL, 1);
+        response.clear();
+        RequestBuilder message;
+        compose(message, method, request, false);
+        return await(message, response);
+    }
+
+    std::future<std::string> callAsync(const char* method, RequestBuilder& request, RequestPriority priority,
+                                       int64_t weight, int64_t orders,
+                                       std::function<void(bool, std::string_view)> onComplete = nullptr) {
+        limiter.acquire(priority, weight, orders);
+        RequestBuilder message;
+        compose(message, method, request, true);
+
+        std::promise<std::string> promise;
+        std::future<std::string> future = promise.get_future();
+        int64_t id = reserve(nullptr, std::move(promise), std::move(onComplete));
+        transmit(id, message);
+        return future;
+    }
+
+    // Sends a request and blocks until its response, a timeout or the connection closing
+    bool await(RequestBuilder& message, Response& response) {
+        int64_t id = reserve(&response, std::promise<std::string>());
+        transmit(id, message);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        Slot& slot = slots[static_cast<size_t>(id % MAX_IN_FLIGHT)];
+        bool answered = changed.wait_for(lock, std::chrono::milliseconds(responseTimeoutMs.load()),
+                                         [&]() { return slot.id != id; });
+        if (!answered) {
+            release(slot);
+            response.status = 0;
+            response.transportError = RESPONSE_TIMED_OUT;
+        }
+        return response.ok();
+    }
+
+    // Writes the request after its id: ,"method":..,"params":{..}}
+    void compose(RequestBuilder& message, const char* method, RequestBuilder& request, bool sign) {
+        message.append(",\"method\":\"").append(method).append("\",\"params\":{");
+        if (sign) {
+            request.add("apiKey", auth.getApiKey());
+            if (!request.hasTimestamp()) {
+                request.add("timestamp", RateLimiter::nowMilliseconds());
+            }
+
+            // The signature covers the parameters sorted by name
+            Param params[MAX_PARAMS];
+            size_t count = splitParams(request.view(), params);
+            std::sort(params, params + count, [](const Param& a, const Param& b) { return a.key < b.key; });
+            RequestBuilder payload;
+            for (size_t i = 0; i < count; ++i) {
+                if (i > 0) payload.append("&");
+                payload.append(params[i].key).append("=").append(params[i].value);
+            }
+            char signature[BinanceAuth::SIGNATURE_LENGTH];
+            auth.sign(payload.view(), signature);
+
+            for (size_t i = 0; i < count; ++i) {
+                message.append("\"").append(params[i].key).append("\":");
+                if (isBare(params[i])) {
+                    message.append(params[i].value);
+                } else {
+                    message.append("\"").append(params[i].value).append("\"");
+                }
+                message.append(",");
+            }
+            message.append("\"signature\":\"").append(std::string_view(signature, sizeof(signature))).append("\"");
+        }
+        message.append("}}");
+    }
+
+    // Takes a free slot for the next id
+    int64_t reserve(Response* response, std::promise<std::string> promise,
+                    std::function<void(bool, std::string_view)> onComplete = nullptr) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!connected) {
+            throw std::runtime_error(CONNECTION_CLOSED);
+        }
+        int64_t id = nextId++;
+        Slot& slot = slots[static_cast<size_t>(id % MAX_IN_FLIGHT)];
+        changed.wait(lock, [&]() { return slot.id == 0 || !connected; });
+        if (!connected) {
+            throw std::runtime_error(CONNECTION_CLOSED);
+        }
+        slot.id = id;
+        slot.response = response;
+        slot.promise = std::move(promise);
+        slot.onComplete = std::move(onComplete);
+        ++pending;
+        return id;
+    }
+
+    void transmit(int64_t id, const RequestBuilder& message) {
+        char digits[24];
+        char* end = std::to_chars(digits, digits + sizeof(digits), id).ptr;
+        RequestBuilder frame;
+        frame.append("{\"id\":").append(std::string_view(digits, static_cast<size_t>(end - digits)))
+             .append(message.view());
+        try {
+            webSocket.sendText(frame.view());
+        } catch (const std::runtime_error&) {
+            std::lock_guard<std::mutex> lock(mutex);
+            Slot& slot = slots[static_cast<size_t>(id % MAX_IN_FLIGHT)];
+            if (slot.id == id) {
+                fail(slot, CONNECTION_CLOSED);
+            }
+        }
+    }
+
+    void release(Slot& slot) {
+        slot.id = 0;
+        slot.response = nullptr;
+        slot.promise = std::promise<std::string>();
+        slot.onComplete = nullptr;
+        --pending;
+        changed.notify_all();
+    }
+
+    void fail(Slot& slot, const char* reason) {
+        if (slot.response) {
+            slot.response->status = 0;
+            slot.response->transportError = reason;
+        } else {
+            if (slot.onComplete) {
+                slot.onComplete(false, {});
+            }
+            slot.promise.set_exception(std::make_exception_ptr(std::runtime_error(reason)));
+        }
+        release(slot);
+    }
+
+    void run() {
+        std::string message;
+        try {
+            while (webSocket.receive(message)) {
+                dispatch(message);
+            }
+        } catch (const std::exception&) {
+            // Treated like a close
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        connected = false;
+        for (Slot& slot : slots) {
+            if (slot.id != 0) {
+                fail(slot, CONNECTION_CLOSED);
+            }
+        }
+        changed.notify_all();
+    }
+
+    // Hands one response to the request with its id
+    void dispatch(std::string_view message) {
+        int64_t id = 0;
+        long status = 0;
+        std::string_view body;
+        ResponseInfo info;
+        JsonReader reader(message);
+        reader.beginObject();
+        std::string_view key;
+        while (reader.nextKey(key)) {
+            if (key == "id" && reader.peek() != 'n' && reader.peek() != '"') {
+                id = reader.readInt();
+            } else if (key == "status") {
+                status = static_cast<long>(reader.readInt());
+            } else if (key == "result" || key == "error") {
+                reader.peek();
+                size_t start = reader.offset();
+                reader.skipValue();
+                body = message.substr(start, reader.offset() - start);
+            } else if (key == "rateLimits") {
+                readRateLimits(reader, info);
+            } else {
+                reader.skipValue();
+            }
+        }
+        if (id <= 0) {
+            return;  // Not an answer to one of our requests
+        }
+
+        int64_t code = 0;
+        if (status >= 400) {
+            JsonReader error(body);
+            error.beginObject();
+            while (error.nextKey(key)) {
+                if (key == "code") {
+                    code = error.readInt();
+                } else if (key == "data" && error.peek() == '{') {
+                    // After a 429 or 418, the time requests are accepted again
+                    error.beginObject();
+                    std::string_view field;
+                    while (error.nextKey(field)) {
+                        if (field == "retryAfter") {
+                            int64_t wait = error.readInt() - RateLimiter::nowMilliseconds();
+                            info.retryAfter = wait > 0 ? (wait + 999) / 1000 : 0;
+                        } else {
+                            error.skipValue();
+                        }
+                    }
+                } else {
+                    error.skipValue();
+                }
+            }
+        }
+        info.status = status;
+        limiter.update(info);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        Slot& slot = slots[static_cast<size_t>(id % MAX_IN_FLIGHT)];
+        if (slot.id != id) {
+            return;  // Timed out and given up on
+        }
+        if (slot.response) {
+            Response& response = *slot.response;
+            response.status = status;
+            response.code = code;
+            response.headers = info;
+            response.body.assign(body);
+        } else if (status >= 200 && status < 300) {
+            if (slot.onComplete) {
+                slot.onComplete(true, body);
+            }
+            slot.promise.set_value(std::string(body));
+        } else {
+            if (slot.onComplete) {
+                slot.onComplete(false, body);
+            }
+            slot.promise.set_exception(std::make_exception_ptr(std::runtime_error(
+                "WebSocket API error " + std::to_string(status) + ": " + std::string(body))));
+        }
+        release(slot);
+    }
+};
+
+// BinanceWsTradingClient implementation
+
+BinanceWsTradingClient::BinanceWsTradingClient(const std::string& api_key, const std::string& api_secret,
+                                               const std::string& url)
+    : pImpl(new Impl(api_key, api_secret, url)) {
+}
+
+BinanceWsTradingClient::~BinanceWsTradingClient() = default;
+
+void BinanceWsTradingClient::connect(int timeoutMs) {
+    pImpl->connect(timeoutMs);
+}
+
+void BinanceWsTradingClient::close() {
+    pImpl->close();
+}
+
+bool BinanceWsTradingClient::isConnected() const {
+    return pImpl->isConnected();
+}
+
+void BinanceWsTradingClient::setResponseTimeout(int64_t milliseconds) {
+    pImpl->setResponseTimeout(milliseconds);
+}
+
+size_t BinanceWsTradingClient::inFlight() const {
+    return pImpl->inFlight();
+}
+
+std::string BinanceWsTradingClient::ping() {
+    return pImpl->ping();
+}
+
+std::string BinanceWsTradingClient::createOrder(const std::string& symbol, const std::string& side,
+                                                const std::string& type, RequestBuilder& params) {
+    Response response;
+    pImpl->tryCreateOrder(symbol, side, type, params, response);
+    return Impl::bodyOf(response);
+}
+
+std::string BinanceWsTradingClient::createOrder(const std::string& symbol, const std::string& side,
+                                                const std::string& type,
+                                                const std::map<std::string, std::string>& params) {
+    RequestBuilder request;
+    addParams(request, params, {"symbol", "side", "type"});
+    return createOrder(symbol, side, type, request);
+}
+
+std::string BinanceWsTradingClient::testOrder(const std::string& symbol, const std::string& side,
+                                              const std::string& type, RequestBuilder& params) {
+    Response response;
+    pImpl->tryTestOrder(symbol, side, type, params, response);
+    return Impl::bodyOf(response);
+}
+
+std::string BinanceWsTradingClient::testOrder(const std::string& symbol, const std::string& side,
+                                              const std::string& type,
+                                              const std::map<std::string, std::string>& params) {
+    RequestBuilder request;
+    addParams(request, params, {"symbol", "side", "type"});
+    return testOrder(symbol, side, type, request);
+}
+
+std::string BinanceWsTradingClient::queryOrder(const std::string& symbol, RequestBuilder& params) {
+    Response response;
+    pImpl->tryQueryOrder(symbol, params, response);
+    return Impl::bodyOf(response);
+}
+
+std::string BinanceWsTradingClient::queryOrder(const std::string& symbol,
+                                               const std::map<std::string, std::string>& params) {
+    RequestBuilder request;
+    addParams(request, params, {"symbol"});
+    return queryOrder(symbol, request);
+}
+
+std::string BinanceWsTradingClient::cancelOrder(const std::string& symbol, RequestBuilder& params) {
+    Response response;
+    pImpl->tryCancelOrder(symbol, params, response);
+    return Impl::bodyOf(response);
+}
+
+std::string BinanceWsTradingClient::cancelOrder(const std::string& symbol,
+                                                const std::map<std::string, std::string>& params) {
+    RequestBuilder request;
+    addParams(request, params, {"symbol"});
+    return cancelOrder(symbol, request);
+}
+
+std::string BinanceWsTradingClient::cancelReplaceOrder(const std::string& symbol, const std::string& side,
+                                                       const std::string& type,
+                                                       const std::string& cancelReplaceMode,
+                                                       RequestBuilder& params) {
+    Response response;
+    pImpl->tryCancelReplaceOrder(symbol, side, type, cancelReplaceMode, params, response);
+    return Impl::bodyOf(response);
+}
+
+std::string BinanceWsTradingClient::cancelReplaceOrder(const std::string& symbol, const std::string& side,
+                                                       const std::string& type,
+                                                       const std::string& cancelReplaceMode,
+                                                       const std::map<std::string, std::string>& params) {
+    RequestBuilder request;
+    addParams(request, params, {"symbol", "side", "type", "cancelReplaceMode"});
+    return cancelReplaceOrder(symbol, side, type, cancelReplaceMode, request);
+}
+
+bool BinanceWsTradingClient::tryCreateOrder(const std::string& symbol, const std::string& side,
+                                            const std::string& type, RequestBuilder& params,
+                                            Response& response) {
+    return pImpl->tryCreateOrder(symbol, side, type, params, response);
+}
+
+bool BinanceWsTradingClient::tryTestOrder(const std::string& symbol, const std::string& side,
+                                          const std::string& type, RequestBuilder& params, Response& response) {
+    return pImpl->tryTestOrder(symbol, side, type, params, response);
+}
+
+bool BinanceWsTradingClient::tryQueryOrder(const std::string& symbol, RequestBuilder& params,
+                                           Response& response) {
+    return pImpl->tryQueryOrder(symbol, params, response);
+}
+
+bool BinanceWsTradingClient::tryCancelOrder(const std::string& symbol, RequestBuilder& params,
+                                            Response& response) {
+    return pImpl->tryCancelOrder(symbol, params, response);
+}
+
+bool BinanceWsTradingClient::tryCancelReplaceOrder(const std::string& symbol, const std::string& side,
+                                                   const std::string& type, const std::string& cancelReplaceMode,
+                                                   RequestBuilder& params, Response& response) {
+    return pImpl->tryCancelReplaceOrder(symbol, side, type, cancelReplaceMode, params, response);
+}
+
+OrderInfo BinanceWsTradingClient::createOrderTyped(const std::string& symbol, const std::string& side,
+                                                   const std::string& type,
+                                                   const std::map<std::string, std::string>& params) {
+    return parseOrderInfo(createOrder(symbol, side, type, params));
+}
+
+TestOrderResult BinanceWsTradingClient::testOrderTyped(const std::string& symbol, const std::string& side,
+                                                       const std::string& type,
+                                                       const std::map<std::string, std::string>& params) {
+    return parseTestOrderResult(testOrder(symbol, side, type, params));
+}
+
+OrderInfo BinanceWsTradingClient::queryOrderTyped(const std::string& symbol,
+                                                  const std::map<std::string, std::string>& params) {
+    return parseOrderInfo(queryOrder(symbol, params));
+}
+
+OrderInfo BinanceWsTradingClient::cancelOrderTyped(const std::string& symbol,
+                                                   const std::map<std::string, std::string>& params) {
+    return parseOrderInfo(cancelOrder(symbol, params));
+}
+
+CancelReplaceResult BinanceWsTradingClient::cancelReplaceOrderTyped(
+    const std::string& symbol, const std::string& side, const std::string& type,
+    const std::string& cancelReplaceMode, const std::map<std::string, std::string>& params) {
+    return parseCancelReplaceResult(cancelReplaceOrder(symbol, side, type, cancelReplaceMode, params));
+}
+
+std::future<std::string> BinanceWsTradingClient::createOrderAsync(const std::string& symbol, const std::string& side,
+                                                                  const std::string& type,
+                                                                  const std::map<std::string, std::string>& params) {
+    return pImpl->createOrderAsync(symbol, side, type, params);
+}
+
+std::future<std::string> BinanceWsTradingClient::testOrderAsync(const std::string& symbol, const std::string& side,
+                                                                const std::string& type,
+                                                                const std::map<std::string, std::string>& params) {
+    return pImpl->testOrderAsync(symbol, side, type, params);
+}
+
+std::future<std::string> BinanceWsTradingClient::queryOrderAsync(const std::string& symbol,
+                                                                 const std::map<std::string, std::string>& params) {
+    return pImpl->queryOrderAsync(symbol, params);
+}
+
+std::future<std::string> BinanceWsTradingClient::cancelOrderAsync(const std::string& symbol,
+                                                                  const std::map<std::string, std::string>& params) {
+    return pImpl->cancelOrderAsync(symbol, params);
+}
+
+std::future<std::string> BinanceWsTradingClient::cancelReplaceOrderAsync(
+    const std::string& symbol, const std::string& side, const std::string& type,
+    const std::string& cancelReplaceMode, const std::map<std::string, std::string>& params) {
+    return pImpl->cancelReplaceOrderAsync(symbol, side, type, cancelReplaceMode, params);
+}
+
+RateLimiter& BinanceWsTradingClient::rateLimiter() {
+    return pImpl->limiter;
+}
+
+void BinanceWsTradingClient::setRiskEngine(RiskEngine* engine) {
+    pImpl->riskEngine = engine;
+}
+
+RiskEngine* BinanceWsTradingClient::riskEngine() const {
+    return pImpl->riskEngine;
+}
+
+} // namespace binance
@@ -0,0 +1,219 @@
+#include "../include/Decimal.h"
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+
+namespace binance {
+
+namespace {
+
+constexpr uint64_t POWERS_OF_TEN[Decimal::DIGITS + 1] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000
+};
+
+constexpr uint64_t MAX_UNITS = static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+
+// Divide, rounding half away from zero
+int64_t divideRounded(int64_t numerator, int64_t denominator) {
+    int64_t quotient = numerator / denominator;
+    int64_t remainder = numerator % denominator;
+    uint64_t twice = 2 * static_cast<uint64_t>(remainder < 0 ? -remainder : remainder);
+    if (twice >= static_cast<uint64_t>(denominator < 0 ? -denominator : denominator)) {
+        quotient += (numerator < 0) == (denominator < 0) ? 1 : -1;
+    }
+    return quotient;
+}
+
+// Write the magnitude with exactly `decimals` fraction digits
+std::to_chars_result writeFixed(char* first, char* last, bool negative, uint64_t magnitude, int decimals) {
+    char digits[32];
+    char* end = std::to_chars(digits, digits + sizeof(digits), magnitude / Decimal::SCALE).ptr;
+    if (decimals > 0) {
+        *end++ = '.';
+        uint64_t fraction = (magnitude % Decimal::SCALE) / POWERS_OF_TEN[Decimal::DIGITS - decimals];
+        for (int i = decimals - 1; i >= 0; --i) {
+            end[i] = static_cast<char>('0' + fraction % 10);
+            fraction /= 10;
+        }
+        end += decimals;
+    }
+
+    size_t length = static_cast<size_t>(end - digits) + (negative ? 1 : 0);
+    if (static_cast<size_t>(last - first) < length) {
+        return {last, std::errc::value_too_large};
+    }
+    if (negative) {
+        *first++ = '-';
+    }
+    std::memcpy(first, digits, static_cast<size_t>(end - digits));
+    return {first + (end - digits), std::errc()};
+}
+
+uint64_t magnitudeOf(int64_t units) {
+    return units < 0 ? 0 - static_cast<uint64_t>(units) : static_cast<uint64_t>(units);
+}
+
+} // namespace
+
+Decimal Decimal::fromDouble(double value) {
+    return fromUnits(std::llround(value * SCALE));
+}
+
+Decimal Decimal::parse(std::string_view text) {
+    Decimal value;
+    auto result = from_chars(text.data(), text.data() + text.size(), value);
+    if (result.ec != std::errc() || result.ptr != text.data() + text.size()) {
+        throw std::invalid_argument("Invalid decimal: " + std::string(text));
+    }
+    return value;
+}
+
+std::string Decimal::toString() const {
+    char buffer[32];
+    return std::string(buffer, to_chars(buffer, buffer + sizeof(buffer), *this).ptr);
+}
+
+std::string Decimal::toString(int decimals) const {
+    char buffer[32];
+    auto result = to_chars(buffer, buffer + sizeof(buffer), *this, decimals);
+    if (result.ec != std::errc()) {
+        throw std::invalid_argument("Invalid number of decimals: " + std::to_string(decimals));
+    }
+    return std::string(buffer, result.ptr);
+}
+
+Decimal Decimal::round(Decimal increment, Rounding mode) const {
+    if (increment.units_ <= 0) {
+        throw std::invalid_argument("Rounding increment must be positive");
+    }
+    int64_t step = increment.units_;
+    int64_t quotient = units_ / step;
+    int64_t remainder = units_ % step;
+    switch (mode) {
+        case Rounding::DOWN:
+            if (remainder < 0) --quotient;
+            break;
+        case Rounding::UP:
+            if (remainder > 0) ++quotient;
+            break;
+        case Rounding::NEAREST:
+            if (2 * magnitudeOf(remainder) >= static_cast<uint64_t>(step)) {
+                quotient += remainder < 0 ? -1 : 1;
+            }
+            break;
+    }
+    return Decimal(quotient * step);
+}
+
+Decimal Decimal::operator*(Decimal other) const {
+    // Split each factor into whole and fractional units so no partial
+    // product overflows: (ah*S + al)(bh*S + bl)/S = ah*bh*S + ah*bl + al*bh + al*bl/S
+    int64_t ah = units_ / SCALE, al = units_ % SCALE;
+    int64_t bh = other.units_ / SCALE, bl = other.units_ % SCALE;
+    return Decimal(ah * bh * SCALE + ah * bl + al * bh + divideRounded(al * bl, SCALE));
+}
+
+Decimal Decimal::operator/(Decimal other) const {
+    if (other.units_ == 0) {
+        throw std::invalid_argument("Decimal division by zero");
+    }
+    // Long division, one decimal digit of the scale at a time, so the
+    // numerator never has to be multiplied by SCALE up front
+    uint64_t divisor = magnitudeOf(other.units_);
+    uint64_t dividend = magnitudeOf(units_);
+    uint64_t quotient = dividend / divisor;
+    uint64_t remainder = dividend % divisor;
+    for (int i = 0; i < DIGITS; ++i) {
+        remainder *= 10;
+        quotient = quotient * 10 + remainder / divisor;
+        remainder %= divisor;
+    }
+    if (2 * remainder >= divisor) {
+        ++quotient;
+    }
+    int64_t units = static_cast<int64_t>(quotient);
+    return Decimal((units_ < 0) != (other.units_ < 0) ? -units : units);
+}
+
+std::from_chars_result from_chars(const char* first, const char* last, Decimal& value) {
+    const char* p = first;
+    bool negative = p < last && *p == '-';
+    if (negative) {
+        ++p;
+    }
+
+    uint64_t whole = 0;
+    const char* digitsStart = p;
+    while (p < last && *p >= '0' && *p <= '9') {
+        whole = whole * 10 + static_cast<uint64_t>(*p - '0');
+        if (whole > MAX_UNITS / Decimal::SCALE) {
+            while (p < last && *p >= '0' && *p <= '9') ++p;
+            return {p, std::errc::result_out_of_range};
+        }
+        ++p;
+    }
+    bool hasDigits = p != digitsStart;
+
+    uint64_t fraction = 0;
+    int fractionDigits = 0;
+    bool inexact = false;
+    if (p < last && *p == '.' && p + 1 < last && p[1] >= '0' && p[1] <= '9') {
+        ++p;
+        hasDigits = true;
+        for (; p < last && *p >= '0' && *p <= '9'; ++p) {
+            if (fractionDigits < Decimal::DIGITS) {
+                fraction = fraction * 10 + static_cast<uint64_t>(*p - '0');
+                ++fractionDigits;
+            } else if (*p != '0') {
+                inexact = true;
+            }
+        }
+    }
+    if (!hasDigits) {
+        return {first, std::errc::invalid_argument};
+    }
+    if (inexact) {
+        return {p, std::errc::result_out_of_range};
+    }
+
+    uint64_t magnitude = whole * Decimal::SCALE + fraction * POWERS_OF_TEN[Decimal::DIGITS - fractionDigits];
+    if (magnitude > MAX_UNITS) {
+        return {p, std::errc::result_out_of_range};
+    }
+    int64_t units = static_cast<int64_t>(magnitude);
+    value = Decimal::fromUnits(negative ? -units : units);
+    return {p, std::errc()};
+}
+
+std::to_chars_result to_chars(char* first, char* last, Decimal value) {
+    // Trailing zeros of the fraction are dropped
+    uint64_t magnitude = magnitudeOf(value.units());
+    int decimals = Decimal::DIGITS;
+    uint64_t fraction = magnitude % Decimal::SCALE;
+    if (fraction == 0) {
+        decimals = 0;
+    } else {
+        while (fraction % 10 == 0) {
+            fraction /= 10;
+            --decimals;
+        }
+    }
+    return writeFixed(first, last, value.units() < 0, magnitude, decimals);
+}
+
+std::to_chars_result to_chars(char* first, char* last, Decimal value, int decimals) {
+    if (decimals < 0 || decimals > Decimal::DIGITS) {
+        return {last, std::errc::invalid_argument};
+    }
+    Decimal rounded = value.round(Decimal::fromUnits(static_cast<int64_t>(POWERS_OF_TEN[Decimal::DIGITS - decimals])));
+    return writeFixed(first, last, rounded.units() < 0, magnitudeOf(rounded.units()), decimals);
+}
+
+std::ostream& operator<<(std::ostream& os, Decimal value) {
+    char buffer[32];
+    return os.write(buffer, to_chars(buffer, buffer + sizeof(buffer), value).ptr - buffer);
+}
+
+} // namespace binance
@@ -0,0 +1,334 @@
+#include "../include/ExchangeInfo.h"
+#include "../include/BinanceAPI.h"
+#include "../include/JsonReader.h"
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+
+namespace binance {
+
+namespace {
+
+constexpr char MAGIC[8] = {'B', 'N', 'X', 'I', 'N', 'F', 'O', '1'};
+
+struct Header {
+    char magic[8];
+    uint32_t recordSize;
+    uint32_t count;
+    int64_t savedTime;
+    uint8_t reserved[8];
+};
+static_assert(sizeof(Header) == 32, "exchange info snapshot header must be 32 bytes");
+static_assert(std::is_trivially_copyable<SymbolFilters>::value, "SymbolFilters is written to snapshots as is");
+
+int64_t nowMillis() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// Limits such as maxQty "92233720368.54775807" may not fit in a Decimal; treat those as no limit
+Decimal readLimit(JsonReader& reader) {
+    std::string_view text = reader.readScalar();
+    try {
+        return Decimal::parse(text);
+    } catch (const std::invalid_argument&) {
+        return Decimal::fromUnits(INT64_MAX);
+    }
+}
+
+int decimalPlaces(Decimal increment) {
+    if (increment.units() <= 0) return 8;
+    int places = 8;
+    for (int64_t units = increment.units(); places > 0 && units % 10 == 0; units /= 10) {
+        --places;
+    }
+    return places;
+}
+
+void readFilter(JsonReader& reader, SymbolFilters& filters) {
+    // Fields are gathered first; the filter type need not come first
+    std::string_view type;
+    Decimal low, high, step, up, down, bidUp, bidDown, askUp, askDown;
+    bool applyMin = true;
+    bool applyMax = false;
+    reader.beginObject();
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key == "filterType") type = reader.readString();
+        else if (key == "minPrice" || key == "minQty" || key == "minNotional") low = readLimit(reader);
+        else if (key == "maxPrice" || key == "maxQty" || key == "maxNotional") high = readLimit(reader);
+        else if (key == "tickSize" || key == "stepSize") step = readLimit(reader);
+        else if (key == "multiplierUp") up = readLimit(reader);
+        else if (key == "multiplierDown") down = readLimit(reader);
+        else if (key == "bidMultiplierUp") bidUp = readLimit(reader);
+        else if (key == "bidMultiplierDown") bidDown = readLimit(reader);
+        else if (key == "askMultiplierUp") askUp = readLimit(reader);
+        else if (key == "askMultiplierDown") askDown = readLimit(reader);
+        else if (key == "applyMinToMarket" || key == "applyToMarket") applyMin = reader.readBool();
+        else if (key == "applyMaxToMarket") applyMax = reader.readBool();
+        else reader.skipValue();
+    }
+
+    if (type == "PRICE_FILTER") {
+        filters.minPrice = low;
+        filters.maxPrice = high;
+        filters.tickSize = step;
+    } else if (type == "LOT_SIZE") {
+        filters.minQty = low;
+        filters.maxQty = high;
+        filters.stepSize = step;
+    } else if (type == "MARKET_LOT_SIZE") {
+        filters.marketMinQty = low;
+        filters.marketMaxQty = high;
+        filters.marketStepSize = step;
+    } else if (type == "NOTIONAL") {
+        filters.minNotional = low;
+        filters.maxNotional = high;
+        filters.applyMinToMarket = applyMin;
+        filters.applyMaxToMarket = applyMax;
+    } else if (type == "MIN_NOTIONAL") {
+        filters.minNotional = low;
+        filters.applyMinToMarket = applyMin;
+    } else if (type == "PERCENT_PRICE") {
+        filters.bidMultiplierUp = filters.askMultiplierUp = up;
+        filters.bidMultiplierDown = filters.askMultiplierDown = down;
+    } else if (type == "PERCENT_PRICE_BY_SIDE") {
+        filters.bidMultiplierUp = bidUp;
+        filters.bidMultiplierDown = bidDown;
+        filters.askMultiplierUp = askUp;
+        filters.askMultiplierDown = askDown;
+    }
+}
+
+void readSymbol(JsonReader& reader, SymbolFilters& filters) {
+    reader.beginObject();
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key == "symbol") filters.symbol.assign(reader.readString());
+        else if (key == "status") filters.trading = reader.readString() == "TRADING";
+        else if (key == "baseAsset") filters.baseAsset.assign(reader.readString());
+        else if (key == "quoteAsset") filters.quoteAsset.assign(reader.readString());
+        else if (key == "baseAssetPrecision") filters.baseAssetPrecision = static_cast<int32_t>(reader.readInt());
+        else if (key == "quoteAssetPrecision") filters.quoteAssetPrecision = static_cast<int32_t>(reader.readInt());
+        else if (key == "filters") {
+            reader.beginArray();
+            while (reader.nextElement()) {
+                readFilter(reader, filters);
+            }
+        } else {
+            reader.skipValue();
+        }
+    }
+}
+
+} // namespace
+
+const char* toString(FilterResult result) {
+    switch (result) {
+        case FilterResult::OK: return "OK";
+        case FilterResult::UNKNOWN_SYMBOL: return "UNKNOWN_SYMBOL";
+        case FilterResult::NOT_TRADING: return "NOT_TRADING";
+        case FilterResult::PRICE_FILTER: return "PRICE_FILTER";
+        case FilterResult::PERCENT_PRICE: return "PERCENT_PRICE";
+        case FilterResult::LOT_SIZE: return "LOT_SIZE";
+        case FilterResult::MARKET_LOT_SIZE: return "MARKET_LOT_SIZE";
+        case FilterResult::NOTIONAL: return "NOTIONAL";
+    }
+    return "UNKNOWN";
+}
+
+// SymbolFilters implementation
+
+int SymbolFilters::pricePrecision() const {
+    return decimalPlaces(tickSize);
+}
+
+int SymbolFilters::quantityPrecision() const {
+    return decimalPlaces(stepSize);
+}
+
+Decimal SymbolFilters::roundPrice(Decimal price, Decimal::Rounding mode) const {
+    return tickSize.units() > 0 ? price.round(tickSize, mode) : price;
+}
+
+Decimal SymbolFilters::roundQuantity(Decimal quantity, bool market) const {
+    Decimal step = market && marketStepSize.units() > 0 ? marketStepSize : stepSize;
+    return step.units() > 0 ? quantity.round(step, Decimal::Rounding::DOWN) : quantity;
+}
+
+FilterResult SymbolFilters::check(OrderSide side, OrderType type, Decimal price, Decimal quantity,
+                                  Decimal referencePrice) const {
+    if (!trading) {
+        return FilterResult::NOT_TRADING;
+    }
+    bool market = type == OrderType::MARKET;
+    if (!market) {
+        if (price < minPrice || (maxPrice.units() > 0 && price > maxPrice) ||
+            (tickSize.units() > 0 && !(price - minPrice).isMultipleOf(tickSize))) {
+            return FilterResult::PRICE_FILTER;
+        }
+        if (referencePrice.units() > 0) {
+            bool buy = side == OrderSide::BUY;
+            Decimal up = buy ? bidMultiplierUp : askMultiplierUp;
+            Decimal down = buy ? bidMultiplierDown : askMultiplierDown;
+            if ((up.units() > 0 && price > referencePrice * up) || (down.units() > 0 && price < referencePrice * down)) {
+                return FilterResult::PERCENT_PRICE;
+            }
+        }
+    }
+
+    if (quantity < minQty || (maxQty.units() > 0 && quantity > maxQty) ||
+        (stepSize.units() > 0 && !(quantity - minQty).isMultipleOf(stepSize))) {
+        return FilterResult::LOT_SIZE;
+    }
+    if (market && (quantity < marketMinQty || (marketMaxQty.units() > 0 && quantity > marketMaxQty) ||
+                   (marketStepSize.units() > 0 && !(quantity - marketMinQty).isMultipleOf(marketStepSize)))) {
+        return FilterResult::MARKET_LOT_SIZE;
+    }
+
+    Decimal notionalPrice = market ? referencePrice : price;
+    if (notionalPrice.units() > 0) {
+        Decimal notional = notionalPrice * quantity;
+        if ((!market || applyMinToMarket) && notional < minNotional) {
+            return FilterResult::NOTIONAL;
+        }
+        if ((!market || applyMaxToMarket) && maxNotional.units() > 0 && notional > maxNotional) {
+            return FilterResult::NOTIONAL;
+        }
+    }
+    return FilterResult::OK;
+}
+
+FilterResult SymbolFilters::normalize(OrderSide side, OrderType type, Decimal& price, Decimal& quantity,
+                                      Decimal referencePrice) const {
+    bool market = type == OrderType::MARKET;
+    if (!market) {
+        price = roundPrice(price, side == OrderSide::BUY ? Decimal::Rounding::DOWN : Decimal::Rounding::UP);
+    }
+    quantity = roundQuantity(quantity, market);
+    return check(side, type, price, quantity, referencePrice);
+}
+
+// ExchangeInfoCache implementation
+
+ExchangeInfoCache::ExchangeInfoCache(SymbolRegistry& registry) : registry_(registry) {
+}
+
+size_t ExchangeInfoCache::load(std::string_view exchangeInfoJson) {
+    std::vector<SymbolFilters> symbols;
+    int64_t serverTime = 0;
+    JsonReader reader(exchangeInfoJson);
+    reader.beginObject();
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key == "serverTime") {
+            serverTime = reader.readInt();
+        } else if (key == "symbols") {
+            reader.beginArray();
+            while (reader.nextElement()) {
+                symbols.emplace_back();
+                readSymbol(reader, symbols.back());
+            }
+        } else {
+            reader.skipValue();
+        }
+    }
+    store(symbols, serverTime != 0 ? serverTime : nowMillis());
+    return symbols.size();
+}
+
+size_t ExchangeInfoCache::fetch(BinanceAPI& api, const std::vector<std::string>& symbols) {
+    return load(api.getExchangeInfo(symbols));
+}
+
+void ExchangeInfoCache::saveSnapshot(const std::string& path) const {
+    std::vector<SymbolFilters> records;
+    records.reserve(count_);
+    for (size_t id = 0; id < filters_.size(); ++id) {
+        if (loaded_[id]) records.push_back(filters_[id]);
+    }
+
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.recordSize = sizeof(SymbolFilters);
+    header.count = static_cast<uint32_t>(records.size());
+    header.savedTime = updateTime_;
+
+    // Written beside the target and renamed over it, so a reader never sees half a file
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(records.data()),
+                  static_cast<std::streamsize>(records.size() * sizeof(SymbolFilters)));
+        out.flush();
+        if (!out) {
+            std::remove(temporary.c_str());
+            throw std::runtime_error("Failed to write exchange info snapshot " + path);
+        }
+    }
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        throw std::runtime_error("Failed to write exchange info snapshot " + path + ": " + std::strerror(errno));
+    }
+}
+
+bool ExchangeInfoCache::loadSnapshot(const std::string& path, int64_t maxAgeMs) {
+    std::ifstream in(path, std::ios::binary);
+    Header header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.recordSize != sizeof(SymbolFilters)) {
+        return false;
+    }
+    if (maxAgeMs >= 0 && nowMillis() - header.savedTime > maxAgeMs) {
+        return false;
+    }
+    std::vector<SymbolFilters> symbols(header.count);
+    if (!in.read(reinterpret_cast<char*>(symbols.data()),
+                 static_cast<std::streamsize>(symbols.size() * sizeof(SymbolFilters)))) {
+        return false;
+    }
+    for (SymbolFilters& filters : symbols) {
+        // Names come from disk; make sure they are terminated before they are used
+        filters.symbol.data[SymbolName::CAPACITY] = '\0';
+        filters.baseAsset.data[SymbolName::CAPACITY] = '\0';
+        filters.quoteAsset.data[SymbolName::CAPACITY] = '\0';
+    }
+    store(symbols, header.savedTime);
+    return true;
+}
+
+size_t ExchangeInfoCache::warmStart(BinanceAPI& api, const std::string& snapshotPath, int64_t maxAgeMs) {
+    if (loadSnapshot(snapshotPath, maxAgeMs)) {
+        return count_;
+    }
+    size_t loaded = fetch(api);
+    saveSnapshot(snapshotPath);
+    return loaded;
+}
+
+void ExchangeInfoCache::store(std::vector<SymbolFilters>& symbols, int64_t updateTime) {
+    std::vector<SymbolId> ids;
+    ids.reserve(symbols.size());
+    for (const SymbolFilters& filters : symbols) {
+        ids.push_back(filters.symbol.view().empty() ? INVALID_SYMBOL : registry_.intern(filters.symbol.view()));
+    }
+
+    filters_.assign(registry_.size(), SymbolFilters());
+    loaded_.assign(registry_.size(), 0);
+    count_ = 0;
+    for (size_t i = 0; i < symbols.size(); ++i) {
+        if (ids[i] == INVALID_SYMBOL) continue;
+        filters_[ids[i]] = symbols[i];
+        count_ += loaded_[ids[i]] ? 0 : 1;
+        loaded_[ids[i]] = 1;
+    }
+    updateTime_ = updateTime;
+}
+
+} // namespace binance
@@ -0,0 +1,2473 @@
+#include "../include/ExchangeSimulator.h"
+#include "../include/BinanceAuth.h"
+#include "../include/BinanceTypes.h"
+#include "../include/HttpClient.h"
+#include "../include/JsonReader.h"
+#include "../include/WebSocketClient.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace binance {
+
+namespace {
+
+using Params = std::map<std::string, std::string>;
+
+// A request rejected with the exchange's error code and message
+class ApiError : public std::runtime_error {
+public:
+    ApiError(int status, int code, const std::string& message, std::string body = {})
+        : std::runtime_error(message), status(status), code(code), body(std::move(body)) {}
+
+    int status;
+    int code;
+    std::string body;  // Replaces {"code":...,"msg":...} when set
+};
+
+[[noreturn]] void fail(int code, const std::string& message, int status = 400) {
+    throw ApiError(status, code, message);
+}
+
+int64_t nowMillis() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// --- JSON output ---
+
+void appendQuoted(std::string& out, std::string_view text) {
+    out += '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    out += '"';
+}
+
+// Starts a member, with a comma unless it is the first in its object or array
+void key(std::string& out, const char* name) {
+    if (out.back() != '{' && out.back() != '[') out += ',';
+    out += '"';
+    out += name;
+    out += "\":";
+}
+
+void element(std::string& out) {
+    if (out.back() != '[') out += ',';
+}
+
+void field(std::string& out, const char* name, std::string_view value) {
+    key(out, name);
+    appendQuoted(out, value);
+}
+
+void field(std::string& out, const char* name, int64_t value) {
+    key(out, name);
+    out += std::to_string(value);
+}
+
+// Decimals are quoted strings with eight places, as the exchange sends them
+void appendDecimal(std::string& out, Decimal value) {
+    char buffer[32];
+    auto result = to_chars(buffer, buffer + sizeof(buffer), value, Decimal::DIGITS);
+    out += '"';
+    out.append(buffer, result.ptr);
+    out += '"';
+}
+
+void field(std::string& out, const char* name, Decimal value) {
+    key(out, name);
+    appendDecimal(out, value);
+}
+
+void flag(std::string& out, const char* name, bool value) {
+    key(out, name);
+    out += value ? "true" : "false";
+}
+
+std::string errorBody(int code, const std::string& message) {
+    std::string out = "{";
+    field(out, "code", static_cast<int64_t>(code));
+    field(out, "msg", message);
+    out += '}';
+    return out;
+}
+
+// --- Request parameters ---
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+std::string percentDecode(std::string_view text) {
+    std::string out;
+    out.reserve(text.size());
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (text[i] == '+') {
+            out += ' ';
+        } else if (text[i] == '%' && i + 2 < text.size() && hexValue(text[i + 1]) >= 0 &&
+                   hexValue(text[i + 2]) >= 0) {
+            out += static_cast<char>(hexValue(text[i + 1]) * 16 + hexValue(text[i + 2]));
+            i += 2;
+        } else {
+            out += text[i];
+        }
+    }
+    return out;
+}
+
+void parseParams(std::string_view text, Params& params) {
+    while (!text.empty()) {
+        size_t end = text.find('&');
+        std::string_view pair = text.substr(0, end);
+        if (!pair.empty()) {
+            size_t equals = pair.find('=');
+            std::string value = equals == std::string_view::npos ? "" : percentDecode(pair.substr(equals + 1));
+            params[percentDecode(pair.substr(0, equals))] = std::move(value);
+        }
+        if (end == std::string_view::npos) break;
+        text.remove_prefix(end + 1);
+    }
+}
+
+// The signed payload is every parameter but the signature, in the order sent
+std::string withoutSignature(std::string_view total) {
+    for (size_t at = 0; at < total.size();) {
+        size_t end = total.find('&', at);
+        if (end == std::string_view::npos) end = total.size();
+        if (total.substr(at, end - at).rfind("signature=", 0) == 0) {
+            std::string payload(total.substr(0, at > 0 ? at - 1 : 0));
+            if (end < total.size()) {
+                payload.append(total.substr(at > 0 ? end : end + 1));
+            }
+            return payload;
+        }
+        at = end + 1;
+    }
+    return std::string(total);
+}
+
+const std::string* optionalParam(const Params& params, const std::string& name) {
+    auto found = params.find(name);
+    return found == params.end() || found->second.empty() ? nullptr : &found->second;
+}
+
+const std::string& mandatoryParam(const Params& params, const std::string& name) {
+    const std::string* value = optionalParam(params, name);
+    if (!value) {
+        fail(-1102, "Mandatory parameter '" + name + "' was not sent, was empty/null, or malformed.");
+    }
+    return *value;
+}
+
+Decimal decimalParam(const std::string& name, const std::string& value) {
+    try {
+        return Decimal::parse(value);
+    } catch (const std::invalid_argument&) {
+        fail(-1100, "Illegal characters found in parameter '" + name +
+                        "'; legal range is '^([0-9]{1,20})(\\.[0-9]{1,20})?$'.");
+    }
+}
+
+int64_t integerParam(const Params& params, const std::string& name, int64_t fallback) {
+    const std::string* value = optionalParam(params, name);
+    if (!value) return fallback;
+    int64_t result = 0;
+    auto parsed = std::from_chars(value->data(), value->data() + value->size(), result);
+    if (parsed.ec != std::errc() || parsed.ptr != value->data() + value->size()) {
+        fail(-1100, "Illegal characters found in parameter '" + name + "'; legal range is '^[0-9]{1,20}$'.");
+    }
+    return result;
+}
+
+template <typename Parse>
+auto enumParam(const std::string& value, Parse parse, int code, const char* message) -> decltype(parse(value)) {
+    try {
+        return parse(value);
+    } catch (const std::invalid_argument&) {
+        fail(code, message);
+    }
+}
+
+// Parameter names of an order leg: "price" on its own, "abovePrice" in a list
+std::string keyOf(const std::string& prefix, const char* name) {
+    if (prefix.empty()) {
+        std::string key(name);
+        key[0] = static_cast<char>(key[0] - 'A' + 'a');
+        return key;
+    }
+    return prefix + name;
+}
+
+// --- Orders ---
+
+bool hasLimit(OrderType type) {
+    return type == OrderType::LIMIT || type == OrderType::LIMIT_MAKER ||
+           type == OrderType::STOP_LOSS_LIMIT || type == OrderType::TAKE_PROFIT_LIMIT;
+}
+
+bool hasStop(OrderType type) {
+    return type == OrderType::STOP_LOSS || type == OrderType::STOP_LOSS_LIMIT ||
+           type == OrderType::TAKE_PROFIT || type == OrderType::TAKE_PROFIT_LIMIT;
+}
+
+struct Order {
+    int64_t orderId = 0;
+    int64_t orderListId = -1;
+    std::string symbol;
+    std::string clientOrderId;
+    OrderSide side = OrderSide::BUY;
+    OrderType type = OrderType::LIMIT;
+    TimeInForce timeInForce = TimeInForce::GTC;
+    Decimal price;
+    Decimal stopPrice;
+    Decimal origQty;
+    Decimal origQuoteOrderQty;
+    Decimal executedQty;
+    Decimal cumQuote;
+    OrderStatus status = OrderStatus::NEW;
+    int64_t time = 0;
+    int64_t updateTime = 0;
+    int64_t workingTime = -1;
+    bool isWorking = true;
+    bool usedSor = false;
+};
+
+bool isOpen(const Order& order) {
+    return order.status == OrderStatus::NEW || order.status == OrderStatus::PARTIALLY_FILLED;
+}
+
+// Orders sized in the quote asset (MARKET with quoteOrderQty) have no origQty until they fill
+bool quoteSized(const Order& order) {
+    return order.origQty.isZero() && !order.origQuoteOrderQty.isZero();
+}
+
+// Quantity the order can still take at a price
+Decimal fillable(const Order& order, Decimal price) {
+    if (quoteSized(order)) {
+        // Division rounds to nearest; never spend more than is left
+        Decimal quote = order.origQuoteOrderQty - order.cumQuote;
+        Decimal qty = quote / price;
+        return qty * price > quote ? qty - Decimal::fromUnits(1) : qty;
+    }
+    return order.origQty - order.executedQty;
+}
+
+// Stop-loss buys and take-profit sells trigger when the price rises to the stop price
+bool triggered(const Order& order, Decimal market) {
+    bool stopLoss = order.type == OrderType::STOP_LOSS || order.type == OrderType::STOP_LOSS_LIMIT;
+    bool rising = (order.side == OrderSide::BUY) == stopLoss;
+    return rising ? market >= order.stopPrice : market <= order.stopPrice;
+}
+
+int sideIndex(OrderSide side) {
+    return side == OrderSide::BUY ? 0 : 1;
+}
+
+// Book levels are keyed so that the best level comes first: asks by price, bids by negated price
+int64_t signOf(OrderSide side) {
+    return side == OrderSide::BUY ? -1 : 1;
+}
+
+struct Fill {
+    Decimal price;
+    Decimal qty;
+    Decimal commission;
+    std::string commissionAsset;
+    int64_t tradeId;
+};
+
+struct Book {
+    Decimal price;                                      // Market price
+    std::map<int64_t, std::deque<int64_t>> levels[2];   // Resting order ids per level, bids then asks
+    std::vector<int64_t> stops;                         // Untriggered stop and take-profit orders
+    std::string baseAsset;
+    std::string quoteAsset;
+    int64_t nextTradeId = 1;
+    int64_t updateId = 1;
+    SymbolFilters filters;                              // Reported by exchangeInfo
+    bool enforceFilters = false;                        // Set by setFilters; otherwise any price and quantity pass
+};
+
+// What exchangeInfo reports for a symbol without filters: any positive price and quantity
+SymbolFilters looseFilters(const std::string& symbol, const Book& book) {
+    SymbolFilters filters;
+    filters.symbol.assign(symbol);
+    filters.baseAsset.assign(book.baseAsset);
+    filters.quoteAsset.assign(book.quoteAsset);
+    filters.trading = true;
+    filters.minPrice = filters.tickSize = Decimal::fromUnits(1);
+    filters.minQty = filters.stepSize = Decimal::fromUnits(1);
+    return filters;
+}
+
+struct OrderList {
+    int64_t orderListId = 0;
+    ContingencyType contingencyType = ContingencyType::OCO;
+    std::string listClientOrderId;
+    std::string symbol;
+    std::vector<int64_t> orderIds;  // OTO and OTOCO lists start with the working order
+    int64_t transactionTime = 0;
+    bool done = false;
+};
+
+// Whether two orders of a list cancel each other when one of them executes
+bool linkedLegs(const OrderList& list, size_t first, size_t second) {
+    if (first == second) return false;
+    if (list.contingencyType == ContingencyType::OCO) return true;
+    return list.contingencyType == ContingencyType::OTOCO && first > 0 && second > 0;
+}
+
+void splitSymbol(const std::string& symbol, Book& book) {
+    static const char* const quotes[] = {"USDT", "FDUSD", "USDC", "TUSD", "BUSD", "BTC", "ETH", "BNB", "EUR", "TRY"};
+    for (const char* quote : quotes) {
+        size_t length = std::char_traits<char>::length(quote);
+        if (symbol.size() > length && symbol.compare(symbol.size() - length, length, quote) == 0) {
+            book.baseAsset = symbol.substr(0, symbol.size() - length);
+            book.quoteAsset = quote;
+            return;
+        }
+    }
+    size_t split = symbol.size() > 3 ? symbol.size() - 3 : 0;
+    book.baseAsset = symbol.substr(0, split);
+    book.quoteAsset = symbol.substr(split);
+}
+
+bool equalsNoCase(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const char* statusText(int status) {
+    switch (status) {
+        case 200: return "OK";
+        case 400: return "Bad Request";
+        case 401: return "Unauthorized";
+        case 404: return "Not Found";
+        case 409: return "Conflict";
+        case 429: return "Too Many Requests";
+        default: return "Error";
+    }
+}
+
+// An unmasked server-to-client frame
+std::string frameOf(int opcode, std::string_view payload) {
+    std::string frame;
+    frame += static_cast<char>(0x80 | opcode);
+    if (payload.size() < 126) {
+        frame += static_cast<char>(payload.size());
+    } else if (payload.size() <= 0xFFFF) {
+        frame += static_cast<char>(126);
+        frame += static_cast<char>(payload.size() >> 8);
+        frame += static_cast<char>(payload.size() & 0xFF);
+    } else {
+        frame += static_cast<char>(127);
+        for (int shift = 56; shift >= 0; shift -= 8) {
+            frame += static_cast<char>((static_cast<uint64_t>(payload.size()) >> shift) & 0xFF);
+        }
+    }
+    frame.append(payload);
+    return frame;
+}
+
+struct Request {
+    std::string method;
+    std::string path;
+    std::string query;
+    std::string body;
+    std::string apiKey;
+    std::string webSocketKey;  // Set on a WebSocket upgrade request
+};
+
+struct Reply {
+    int status = 200;
+    std::string headers;
+    std::string body;
+    // Usage after the request, for the WebSocket API's rateLimits; -1 if not counted
+    int64_t weightUsed = -1;
+    int64_t ordersUsed10s = -1;
+    int64_t ordersUsed1d = -1;
+    int64_t retryAfter = -1;   // Seconds, after a 429
+};
+
+} // namespace
+
+// Implementation class using the PIMPL idiom
+class ExchangeSimulator::Impl {
+public:
+    explicit Impl(const SimulatorConfig& config)
+        : config(config), auth(config.apiKey, config.apiSecret), rng(config.seed) {
+        listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+        int reuse = 1;
+        setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons(config.port);
+        if (listenFd < 0 || ::bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+            ::listen(listenFd, 64) != 0) {
+            if (listenFd >= 0) ::close(listenFd);
+            throw std::runtime_error("Exchange simulator: cannot listen on port " + std::to_string(config.port));
+        }
+        socklen_t length = sizeof(address);
+        getsockname(listenFd, reinterpret_cast<sockaddr*>(&address), &length);
+        boundPort = ntohs(address.sin_port);
+    }
+
+    ~Impl() {
+        stop();
+        ::close(listenFd);
+    }
+
+    void start() {
+        if (running || stopped) return;
+        running = true;
+        acceptor = std::thread(&Impl::acceptLoop, this);
+    }
+
+    void stop() {
+        running = false;
+        if (stopped) return;
+        stopped = true;
+        ::shutdown(listenFd, SHUT_RDWR);
+        if (acceptor.joinable()) acceptor.join();
+
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        for (auto& connection : connections) {
+            ::shutdown(connection->fd, SHUT_RDWR);
+        }
+        for (auto& connection : connections) {
+            connection->thread.join();
+            ::close(connection->fd);
+        }
+        connections.clear();
+    }
+
+    void setPrice(const std::string& symbol, Decimal price) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = books.find(symbol);
+        if (found == books.end()) {
+            Book& book = books[symbol];
+            book.price = price;
+            splitSymbol(symbol, book);
+            return;
+        }
+        int64_t now = nowMillis();
+        sweep(found->second, price, nullptr, now);
+        publish(now);
+    }
+
+    Decimal price(const std::string& symbol) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = books.find(symbol);
+        if (found == books.end()) throw std::invalid_argument("Symbol not listed: " + symbol);
+        return found->second.price;
+    }
+
+    Decimal trade(const std::string& symbol, Decimal price, Decimal quantity) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = books.find(symbol);
+        if (found == books.end()) throw std::invalid_argument("Symbol not listed: " + symbol);
+        int64_t now = nowMillis();
+        Decimal filled = sweep(found->second, price, &quantity, now);
+        publish(now);
+        return filled;
+    }
+
+    void setFilters(const std::string& symbol, const SymbolFilters& filters) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = books.find(symbol);
+        if (found == books.end()) throw std::invalid_argument("Symbol not listed: " + symbol);
+        found->second.filters = filters;
+        found->second.filters.symbol.assign(symbol);
+        found->second.enforceFilters = true;
+    }
+
+    void setBalance(const std::string& asset, Decimal free) {
+        std::lock_guard<std::mutex> lock(mutex);
+        balances[asset] = free;
+        noteChanged(asset);
+        publish(nowMillis());
+    }
+
+    Decimal balance(const std::string& asset) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = balances.find(asset);
+        return found == balances.end() ? Decimal() : found->second;
+    }
+
+    void expireListenKeys() {
+        std::lock_guard<std::mutex> lock(mutex);
+        int64_t now = nowMillis();
+        for (const UserStream& stream : userStreams) {
+            std::string event = "{";
+            field(event, "e", "listenKeyExpired");
+            field(event, "E", now);
+            field(event, "listenKey", stream.listenKey);
+            event += '}';
+            sendAll(stream.fd, frameOf(0x1, event));
+            ::shutdown(stream.fd, SHUT_RDWR);
+        }
+        userStreams.clear();
+        listenKeys.clear();
+    }
+
+    size_t openOrderCount() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        size_t count = 0;
+        for (const auto& entry : orders) {
+            if (isOpen(entry.second)) ++count;
+        }
+        return count;
+    }
+
+    SimulatorConfig config;
+    uint16_t boundPort = 0;
+    std::atomic<uint64_t> requests{0};
+    std::atomic<uint64_t> errors{0};
+
+private:
+    using Handler = std::string (Impl::*)(const Params&, int64_t);
+
+    enum class Security {
+        NONE,
+        API_KEY,  // The API key header, without a signature
+        SIGNED
+    };
+
+    struct Endpoint {
+        HttpMethod method;
+        const char* path;
+        int64_t weight;
+        int64_t orders;   // Counted against the order rate limits
+        Security security;
+        Handler handler;
+    };
+
+    struct Connection {
+        int fd = -1;
+        std::thread thread;
+        std::atomic<bool> done{false};
+    };
+
+    BinanceAuth auth;
+    int listenFd = -1;
+    std::atomic<bool> running{false};
+    bool stopped = false;
+    std::thread acceptor;
+    std::mutex connectionsMutex;
+    std::vector<std::unique_ptr<Connection>> connections;
+
+    std::mutex rngMutex;
+    std::mt19937_64 rng;
+
+    // Exchange state, guarded by mutex
+    mutable std::mutex mutex;
+    std::map<std::string, Book> books;
+    std::map<int64_t, Order> orders;
+    std::map<int64_t, OrderList> lists;
+    std::unordered_map<std::string, int64_t> clientOrderIds;  // "SYMBOL clientOrderId" -> orderId
+    std::unordered_map<std::string, int64_t> listClientOrderIds;
+    int64_t nextOrderId = 1;
+    int64_t nextListId = 1;
+    std::vector<int64_t> touched;  // Orders that filled, triggered or expired since the last settle()
+    std::map<std::string, Decimal> balances;
+
+    // User data streams, guarded by mutex like the state they report on
+    struct Execution {
+        Order order;                // As it was after the change
+        ExecutionType type = ExecutionType::NEW;
+        Decimal lastPrice;
+        Decimal lastQty;
+        Decimal commission;
+        std::string commissionAsset;
+        int64_t tradeId = -1;
+        bool maker = false;
+    };
+    struct UserStream {
+        int fd;
+        std::string listenKey;
+    };
+    std::map<std::string, int64_t> listenKeys;  // Listen key -> when it was created or last kept alive
+    std::vector<UserStream> userStreams;
+    std::vector<Execution> executions;          // Not yet sent to the streams
+    std::vector<std::string> changedAssets;
+
+    // Rate-limit windows, guarded by mutex
+    int64_t weightWindow = -1;
+    int64_t weightUsed = 0;
+    int64_t ordersWindow10s = -1;
+    int64_t ordersUsed10s = 0;
+    int64_t ordersWindow1d = -1;
+    int64_t ordersUsed1d = 0;
+
+    // --- Server ---
+
+    void acceptLoop() {
+        while (running) {
+            int fd = ::accept(listenFd, nullptr, nullptr);
+            if (fd < 0) {
+                if (running && (errno == EINTR || errno == ECONNABORTED)) continue;
+                break;
+            }
+            int noDelay = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+            std::lock_guard<std::mutex> lock(connectionsMutex);
+            // Reap connections the client has closed
+            for (auto it = connections.begin(); it != connections.end();) {
+                if ((*it)->done) {
+                    (*it)->thread.join();
+                    ::close((*it)->fd);
+                    it = connections.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            auto connection = std::make_unique<Connection>();
+            connection->fd = fd;
+            Connection* serving = connection.get();
+            connection->thread = std::thread([this, serving] {
+                serve(serving->fd);
+                serving->done = true;
+            });
+            connections.push_back(std::move(connection));
+        }
+    }
+
+    // Serves HTTP/1.1 requests on one keep-alive connection until it closes
+    void serve(int fd) {
+        std::string buffer;
+        char chunk[16384];
+        auto receive = [&]() {
+            ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+            if (n <= 0) return false;
+            buffer.append(chunk, static_cast<size_t>(n));
+            return true;
+        };
+
+        for (;;) {
+            size_t headerEnd;
+            while ((headerEnd = buffer.find("\r\n\r\n")) == std::string::npos) {
+                if (!receive()) return;
+            }
+
+            Request request;
+            size_t contentLength = 0;
+            bool expectContinue = false;
+            bool closeAfter = false;
+            std::string_view head(buffer.data(), headerEnd);
+            size_t lineEnd = head.find("\r\n");
+            std::string_view requestLine = head.substr(0, lineEnd);
+            size_t space = requestLine.find(' ');
+            size_t targetEnd = requestLine.find(' ', space + 1);
+            if (space == std::string_view::npos || targetEnd == std::string_view::npos) return;
+            request.method.assign(requestLine.substr(0, space));
+            std::string_view target = requestLine.substr(space + 1, targetEnd - space - 1);
+            size_t question = target.find('?');
+            request.path.assign(target.substr(0, question));
+            if (question != std::string_view::npos) request.query.assign(target.substr(question + 1));
+
+            while (lineEnd != std::string_view::npos && lineEnd < head.size()) {
+                size_t next = head.find("\r\n", lineEnd + 2);
+                std::string_view line = head.substr(lineEnd + 2, next == std::string_view::npos ? std::string_view::npos
+                                                                                             : next - lineEnd - 2);
+                lineEnd = next;
+                size_t colon = line.find(':');
+                if (colon == std::string_view::npos) continue;
+                std::string_view name = line.substr(0, colon);
+                std::string_view value = line.substr(colon + 1);
+                while (!value.empty() && value.front() == ' ') value.remove_prefix(1);
+                if (equalsNoCase(name, "content-length")) {
+                    std::from_chars(value.data(), value.data() + value.size(), contentLength);
+                } else if (equalsNoCase(name, "x-mbx-apikey")) {
+                    request.apiKey.assign(value);
+                } else if (equalsNoCase(name, "expect")) {
+                    expectContinue = equalsNoCase(value, "100-continue");
+                } else if (equalsNoCase(name, "connection")) {
+                    closeAfter = equalsNoCase(value, "close");
+                } else if (equalsNoCase(name, "sec-websocket-key")) {
+                    request.webSocketKey.assign(value);
+                }
+            }
+
+            size_t bodyStart = headerEnd + 4;
+            if (expectContinue && buffer.size() < bodyStart + contentLength) {
+                sendAll(fd, "HTTP/1.1 100 Continue\r\n\r\n");
+            }
+            while (buffer.size() < bodyStart + contentLength) {
+                if (!receive()) return;
+            }
+            request.body.assign(buffer, bodyStart, contentLength);
+            buffer.erase(0, bodyStart + contentLength);
+
+            if (!request.webSocketKey.empty() && request.path.rfind("/ws/", 0) == 0) {
+                serveUserStream(fd, request.path.substr(4), request.webSocketKey, buffer);
+                return;
+            }
+            if (!request.webSocketKey.empty() && request.path == "/ws-api/v3") {
+                serveTradingSession(fd, request.webSocketKey, buffer);
+                return;
+            }
+
+            Reply reply = handle(request);
+            ++requests;
+            if (reply.status >= 400) ++errors;
+
+            std::string response = "HTTP/1.1 " + std::to_string(reply.status) + " " + statusText(reply.status) +
+                                   "\r\nContent-Type: application/json;charset=UTF-8\r\nContent-Length: " +
+                                   std::to_string(reply.body.size()) + "\r\n" + reply.headers + "\r\n";
+            if (request.method != "HEAD") response += reply.body;
+
+            delay();
+            if (!sendAll(fd, response) || closeAfter) return;
+        }
+    }
+
+    static bool sendAll(int fd, const std::string& data) {
+        size_t sent = 0;
+        while (sent < data.size()) {
+            ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0) return false;
+            sent += static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    // Holds a user data stream open: events are pushed by whichever thread changes the account,
+    // and this thread only answers the client's control frames
+    void serveUserStream(int fd, const std::string& listenKey, const std::string& webSocketKey, std::string buffer) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (listenKeys.count(listenKey) == 0) {
+                sendAll(fd, "HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\n\r\n");
+                return;
+            }
+            sendAll(fd, "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                        "Sec-WebSocket-Accept: " + WebSocketClient::acceptKey(webSocketKey) + "\r\n\r\n");
+            userStreams.push_back({fd, listenKey});
+        }
+
+        int opcode = 0;
+        std::string payload;
+        while (readFrame(fd, buffer, opcode, payload)) {
+            if (opcode == 0x8 || opcode == 0x9) {
+                std::lock_guard<std::mutex> lock(mutex);
+                sendAll(fd, frameOf(opcode == 0x8 ? 0x8 : 0xA, payload));
+                if (opcode == 0x8) break;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        userStreams.erase(std::remove_if(userStreams.begin(), userStreams.end(),
+                                         [fd](const UserStream& stream) { return stream.fd == fd; }),
+                          userStreams.end());
+    }
+
+    // Takes one complete client frame off the buffer, if it holds one. Client frames are masked:
+    // 2 header bytes, the length, a 4-byte key, then the payload
+    static bool takeFrame(std::string& buffer, int& opcode, std::string& payload) {
+        if (buffer.size() < 2) return false;
+        size_t length = static_cast<unsigned char>(buffer[1]) & 0x7F;
+        size_t header = length == 126 ? 4 : length == 127 ? 10 : 2;
+        if (buffer.size() < header) return false;
+        if (header > 2) {
+            length = 0;
+            for (size_t i = 2; i < header; ++i) {
+                length = (length << 8) | static_cast<unsigned char>(buffer[i]);
+            }
+        }
+        header += 4;
+        if (buffer.size() < header + length) return false;
+        opcode = buffer[0] & 0x0F;
+        payload.assign(buffer, header, length);
+        for (size_t i = 0; i < payload.size(); ++i) {
+            payload[i] = static_cast<char>(payload[i] ^ buffer[header - 4 + i % 4]);
+        }
+        buffer.erase(0, header + length);
+        return true;
+    }
+
+    // Reads one client frame, blocking until it has arrived
+    static bool readFrame(int fd, std::string& buffer, int& opcode, std::string& payload) {
+        char chunk[4096];
+        while (!takeFrame(buffer, opcode, payload)) {
+            ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+            if (n <= 0) return false;
+            buffer.append(chunk, static_cast<size_t>(n));
+        }
+        return true;
+    }
+
+    // Serves the WebSocket API: each text frame is one request, answered in the order received.
+    // Requests are handled as they arrive and each answer is held back until the injected latency
+    // has passed since its request arrived, so pipelined requests overlap their latency.
+    void serveTradingSession(int fd, const std::string& webSocketKey, std::string buffer) {
+        if (!sendAll(fd, "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                         "Sec-WebSocket-Accept: " + WebSocketClient::acceptKey(webSocketKey) + "\r\n\r\n")) {
+            return;
+        }
+        std::deque<std::pair<std::chrono::steady_clock::time_point, std::string>> replies;
+        char chunk[4096];
+        int opcode = 0;
+        std::string payload;
+        for (;;) {
+            while (takeFrame(buffer, opcode, payload)) {
+                if (opcode == 0x8) {
+                    sendAll(fd, frameOf(0x8, payload));
+                    return;
+                }
+                if (opcode == 0x9) {
+                    replies.emplace_back(std::chrono::steady_clock::now(), frameOf(0xA, payload));
+                } else if (opcode == 0x1) {
+                    auto due = std::chrono::steady_clock::now() + std::chrono::microseconds(latency());
+                    replies.emplace_back(due, frameOf(0x1, handleWebSocketRequest(payload)));
+                }
+            }
+
+            auto now = std::chrono::steady_clock::now();
+            while (!replies.empty() && replies.front().first <= now) {
+                if (!sendAll(fd, replies.front().second)) return;
+                replies.pop_front();
+            }
+
+            int timeout = -1;
+            if (!replies.empty()) {
+                auto wait = std::chrono::ceil<std::chrono::milliseconds>(replies.front().first - now);
+                timeout = static_cast<int>(wait.count());
+            }
+            pollfd readable{fd, POLLIN, 0};
+            int ready = ::poll(&readable, 1, timeout);
+            if (ready < 0 && errno != EINTR) return;
+            if (ready > 0) {
+                ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+                if (n <= 0) return;
+                buffer.append(chunk, static_cast<size_t>(n));
+            }
+        }
+    }
+
+    int64_t latency() {
+        int64_t micros = config.latencyMicros;
+        if (config.jitterMicros > 0) {
+            std::lock_guard<std::mutex> lock(rngMutex);
+            micros += static_cast<int64_t>(rng() % static_cast<uint64_t>(config.jitterMicros + 1));
+        }
+        return micros;
+    }
+
+    void delay() {
+        int64_t micros = latency();
+        if (micros > 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(micros));
+        }
+    }
+
+    static const Endpoint* findEndpoint(HttpMethod method, std::string_view path) {
+        static const Endpoint endpoints[] = {
+            {HttpMethod::GET, "/api/v3/ping", 1, 0, Security::NONE, &Impl::ping},
+            {HttpMethod::GET, "/api/v3/time", 1, 0, Security::NONE, &Impl::serverTime},
+            {HttpMethod::GET, "/api/v3/ticker/price", 2, 0, Security::NONE, &Impl::tickerPrice},
+            {HttpMethod::GET, "/api/v3/depth", 5, 0, Security::NONE, &Impl::depth},
+            {HttpMethod::GET, "/api/v3/exchangeInfo", 20, 0, Security::NONE, &Impl::exchangeInfo},
+            {HttpMethod::POST, "/api/v3/order", 1, 1, Security::SIGNED, &Impl::newOrder},
+            {HttpMethod::POST, "/api/v3/order/test", 1, 0, Security::SIGNED, &Impl::testOrder},
+            {HttpMethod::GET, "/api/v3/order", 4, 0, Security::SIGNED, &Impl::queryOrder},
+            {HttpMethod::DEL, "/api/v3/order", 1, 0, Security::SIGNED, &Impl::cancelOrder},
+            {HttpMethod::POST, "/api/v3/order/cancelReplace", 1, 1, Security::SIGNED, &Impl::cancelReplace},
+            {HttpMethod::GET, "/api/v3/openOrders", 6, 0, Security::SIGNED, &Impl::openOrders},
+            {HttpMethod::DEL, "/api/v3/openOrders", 1, 0, Security::SIGNED, &Impl::cancelOpenOrders},
+            {HttpMethod::GET, "/api/v3/allOrders", 20, 0, Security::SIGNED, &Impl::allOrders},
+            {HttpMethod::POST, "/api/v3/order/oco", 1, 2, Security::SIGNED, &Impl::newLegacyOco},
+            {HttpMethod::POST, "/api/v3/orderList/oco", 1, 2, Security::SIGNED, &Impl::newOco},
+            {HttpMethod::POST, "/api/v3/orderList/oto", 1, 2, Security::SIGNED, &Impl::newOto},
+            {HttpMethod::POST, "/api/v3/orderList/otoco", 1, 3, Security::SIGNED, &Impl::newOtoco},
+            {HttpMethod::DEL, "/api/v3/orderList", 1, 0, Security::SIGNED, &Impl::cancelOrderList},
+            {HttpMethod::GET, "/api/v3/orderList", 4, 0, Security::SIGNED, &Impl::queryOrderList},
+            {HttpMethod::GET, "/api/v3/allOrderList", 20, 0, Security::SIGNED, &Impl::allOrderLists},
+            {HttpMethod::GET, "/api/v3/openOrderList", 6, 0, Security::SIGNED, &Impl::openOrderLists},
+            {HttpMethod::POST, "/api/v3/sor/order", 1, 1, Security::SIGNED, &Impl::newSorOrder},
+            {HttpMethod::POST, "/api/v3/sor/order/test", 1, 0, Security::SIGNED, &Impl::testSorOrder},
+            {HttpMethod::POST, "/api/v3/userDataStream", 2, 0, Security::API_KEY, &Impl::newListenKey},
+            {HttpMethod::PUT, "/api/v3/userDataStream", 2, 0, Security::API_KEY, &Impl::keepAliveListenKey},
+            {HttpMethod::DEL, "/api/v3/userDataStream", 2, 0, Security::API_KEY, &Impl::closeListenKey},
+        };
+
+        for (const Endpoint& candidate : endpoints) {
+            if (candidate.method == method && path == candidate.path) {
+                return &candidate;
+            }
+        }
+        return nullptr;
+    }
+
+    Reply handle(const Request& request) {
+        Reply reply;
+        HttpMethod method = request.method == "POST" ? HttpMethod::POST
+                          : request.method == "PUT" ? HttpMethod::PUT
+                          : request.method == "DELETE" ? HttpMethod::DEL
+                          : HttpMethod::GET;
+        const Endpoint* endpoint = findEndpoint(method, request.path);
+        if (!endpoint) {
+            reply.status = 404;
+            reply.body = errorBody(-1, "Unknown endpoint " + request.method + " " + request.path + ".");
+            return reply;
+        }
+
+        // The exchange reads parameters from the query string and the body alike
+        Params params;
+        parseParams(request.query, params);
+        parseParams(request.body, params);
+        process(*endpoint, params, request.apiKey, withoutSignature(request.query + request.body), reply);
+        return reply;
+    }
+
+    // Runs a request against the exchange state, from either the REST API or the WebSocket API
+    void process(const Endpoint& endpoint, const Params& params, const std::string& apiKey,
+                 const std::string& signedPayload, Reply& reply) {
+        int64_t now = nowMillis();
+        std::lock_guard<std::mutex> lock(mutex);
+        try {
+            charge(weightOf(endpoint, params), endpoint.orders, now, reply);
+            if (endpoint.security != Security::NONE) {
+                checkApiKey(apiKey);
+            }
+            if (endpoint.security == Security::SIGNED) {
+                authenticate(signedPayload, params, now);
+            }
+            reply.body = (this->*endpoint.handler)(params, now);
+        } catch (const ApiError& e) {
+            reply.status = e.status;
+            reply.body = e.body.empty() ? errorBody(e.code, e.what()) : e.body;
+        }
+        // A failed request may still have changed orders, e.g. the cancel of a cancel-replace
+        publish(now);
+    }
+
+    // One WebSocket API request: {"id":..,"method":"order.place","params":{..}}. The signature
+    // covers every parameter but itself, sorted by name, as the exchange expects.
+    std::string handleWebSocketRequest(std::string_view text) {
+        static const struct {
+            const char* name;
+            HttpMethod method;
+            const char* path;
+        } methods[] = {
+            {"ping", HttpMethod::GET, "/api/v3/ping"},
+            {"time", HttpMethod::GET, "/api/v3/time"},
+            {"exchangeInfo", HttpMethod::GET, "/api/v3/exchangeInfo"},
+            {"order.place", HttpMethod::POST, "/api/v3/order"},
+            {"order.test", HttpMethod::POST, "/api/v3/order/test"},
+            {"order.status", HttpMethod::GET, "/api/v3/order"},
+            {"order.cancel", HttpMethod::DEL, "/api/v3/order"},
+            {"order.cancelReplace", HttpMethod::POST, "/api/v3/order/cancelReplace"},
+            {"openOrders.status", HttpMethod::GET, "/api/v3/openOrders"},
+        };
+
+        std::string id = "null";
+        std::string name;
+        Params params;
+        Reply reply;
+        try {
+            JsonReader reader(text);
+            reader.beginObject();
+            std::string_view member;
+            while (reader.nextKey(member)) {
+                if (member == "id") {
+                    reader.peek();
+                    size_t start = reader.offset();
+                    reader.skipValue();
+                    id.assign(text.substr(start, reader.offset() - start));
+                } else if (member == "method") {
+                    name.assign(reader.readString());
+                } else if (member == "params") {
+                    reader.beginObject();
+                    std::string_view param;
+                    while (reader.nextKey(param)) {
+                        std::string& value = params[std::string(param)];
+                        value.assign(reader.peek() == '"' ? reader.readString() : reader.readScalar());
+                    }
+                } else {
+                    reader.skipValue();
+                }
+            }
+        } catch (const std::runtime_error&) {
+            reply.status = 400;
+            reply.body = errorBody(-1102, "Invalid JSON request.");
+        }
+
+        if (reply.status == 200) {
+            const Endpoint* endpoint = nullptr;
+            for (const auto& candidate : methods) {
+                if (name == candidate.name) {
+                    endpoint = findEndpoint(candidate.method, candidate.path);
+                    break;
+                }
+            }
+            if (!endpoint) {
+                reply.status = 400;
+                reply.body = errorBody(-1020, "Unsupported method '" + name + "'.");
+            } else {
+                std::string payload;
+                for (const auto& param : params) {
+                    if (param.first == "signature") continue;
+                    if (!payload.empty()) payload += '&';
+                    payload += param.first;
+                    payload += '=';
+                    payload += param.second;
+                }
+                auto apiKey = params.find("apiKey");
+                process(*endpoint, params, apiKey == params.end() ? std::string() : apiKey->second, payload, reply);
+            }
+        }
+        ++requests;
+        if (reply.status >= 400) ++errors;
+
+        std::string out = "{";
+        key(out, "id");
+        out += id;
+        field(out, "status", static_cast<int64_t>(reply.status));
+        if (reply.status < 400) {
+            key(out, "result");
+            out += reply.body;
+        } else if (reply.retryAfter >= 0) {
+            // The error object gains the time requests are accepted again
+            key(out, "error");
+            out.append(reply.body, 0, reply.body.size() - 1);
+            key(out, "data");
+            out += '{';
+            field(out, "retryAfter", nowMillis() + reply.retryAfter * 1000);
+            out += "}}";
+        } else {
+            key(out, "error");
+            out += reply.body;
+        }
+        if (reply.weightUsed >= 0) {
+            key(out, "rateLimits");
+            out += '[';
+            auto limit = [&out](const char* type, const char* interval, int64_t length, int64_t cap, int64_t used) {
+                element(out);
+                out += '{';
+                field(out, "rateLimitType", type);
+                field(out, "interval", interval);
+                field(out, "intervalNum", length);
+                field(out, "limit", cap);
+                field(out, "count", used);
+                out += '}';
+            };
+            limit("REQUEST_WEIGHT", "MINUTE", 1, config.weightLimit, reply.weightUsed);
+            if (reply.ordersUsed10s >= 0) {
+                limit("ORDERS", "SECOND", 10, config.orderLimit10s, reply.ordersUsed10s);
+                limit("ORDERS", "DAY", 1, config.orderLimit1d, reply.ordersUsed1d);
+            }
+            out += ']';
+        }
+        out += '}';
+        return out;
+    }
+
+    // Weights that depend on the parameters, as documented for each endpoint
+    static int64_t weightOf(const Endpoint& endpoint, const Params& params) {
+        std::string_view path = endpoint.path;
+        bool hasSymbol = optionalParam(params, "symbol") != nullptr;
+        if (path == "/api/v3/ticker/price") return hasSymbol ? 2 : 4;
+        if (path == "/api/v3/openOrders" && endpoint.method == HttpMethod::GET) return hasSymbol ? 6 : 80;
+        if (path == "/api/v3/depth") {
+            int64_t limit = integerParam(params, "limit", 100);
+            return limit <= 100 ? 5 : limit <= 500 ? 25 : limit <= 1000 ? 50 : 250;
+        }
+        if (path.size() > 5 && path.substr(path.size() - 5) == "/test") {
+            const std::string* rates = optionalParam(params, "computeCommissionRates");
+            return rates && *rates == "true" ? 20 : 1;
+        }
+        return endpoint.weight;
+    }
+
+    // Counts the request against the fixed rate-limit windows and reports the usage
+    void charge(int64_t weight, int64_t orderCount, int64_t now, Reply& reply) {
+        auto roll = [now](int64_t length, int64_t& window, int64_t& used) {
+            if (now / length != window) {
+                window = now / length;
+                used = 0;
+            }
+        };
+        roll(60000, weightWindow, weightUsed);
+        weightUsed += weight;
+        reply.weightUsed = weightUsed;
+        reply.headers += "X-MBX-USED-WEIGHT: " + std::to_string(weightUsed) + "\r\n";
+        reply.headers += "X-MBX-USED-WEIGHT-1M: " + std::to_string(weightUsed) + "\r\n";
+        if (orderCount > 0) {
+            roll(10000, ordersWindow10s, ordersUsed10s);
+            roll(86400000, ordersWindow1d, ordersUsed1d);
+            ordersUsed10s += orderCount;
+            ordersUsed1d += orderCount;
+            reply.ordersUsed10s = ordersUsed10s;
+            reply.ordersUsed1d = ordersUsed1d;
+            reply.headers += "X-MBX-ORDER-COUNT-10S: " + std::to_string(ordersUsed10s) + "\r\n";
+            reply.headers += "X-MBX-ORDER-COUNT-1D: " + std::to_string(ordersUsed1d) + "\r\n";
+        }
+
+        auto reject = [&](int code, const std::string& message, int64_t length) {
+            int64_t retryAfter = (length - now % length + 999) / 1000;
+            reply.headers += "Retry-After: " + std::to_string(retryAfter) + "\r\n";
+            reply.retryAfter = retryAfter;
+            fail(code, message, 429);
+        };
+        if (weightUsed > config.weightLimit) {
+            reject(-1003, "Too many requests; current limit of IP(s) request weight is " +
+                              std::to_string(config.weightLimit) + " per 1 MINUTE.", 60000);
+        }
+        if (orderCount > 0 && ordersUsed10s > config.orderLimit10s) {
+            reject(-1015, "Too many new orders; current limit is " + std::to_string(config.orderLimit10s) +
+                              " orders per TEN_SECONDS.", 10000);
+        }
+        if (orderCount > 0 && ordersUsed1d > config.orderLimit1d) {
+            reject(-1015, "Too many new orders; current limit is " + std::to_string(config.orderLimit1d) +
+                              " orders per DAY.", 86400000);
+        }
+    }
+
+    void checkApiKey(const std::string& apiKey) {
+        if (apiKey.empty()) {
+            fail(-2014, "API-key format invalid.", 401);
+        }
+        if (apiKey != config.apiKey) {
+            fail(-2015, "Invalid API-key, IP, or permissions for action.", 401);
+        }
+    }
+
+    void authenticate(const std::string& signedPayload, const Params& params, int64_t now) {
+        const std::string& signature = mandatoryParam(params, "signature");
+        char expected[BinanceAuth::SIGNATURE_LENGTH];
+        auth.sign(signedPayload, expected);
+        if (signature.size() != BinanceAuth::SIGNATURE_LENGTH ||
+            !equalsNoCase(signature, std::string_view(expected, sizeof(expected)))) {
+            fail(-1022, "Signature for this request is not valid.");
+        }
+
+        int64_t timestamp = integerParam(params, "timestamp", -1);
+        if (timestamp < 0) {
+            fail(-1102, "Mandatory parameter 'timestamp' was not sent, was empty/null, or malformed.");
+        }
+        int64_t recvWindow = integerParam(params, "recvWindow", 5000);
+        if (recvWindow > 60000) {
+            fail(-1131, "recvWindow must be less than 60000");
+        }
+        if (timestamp > now + 1000 || now - timestamp > recvWindow) {
+            fail(-1021, "Timestamp for this request is outside of the recvWindow.");
+        }
+    }
+
+    // --- Matching engine ---
+
+    Book& bookOf(const std::string& symbol) {
+        auto found = books.find(symbol);
+        if (found == books.end()) fail(-1121, "Invalid symbol.");
+        return found->second;
+    }
+
+    // Parses one order, or one leg of an order list; side and quantity may be shared by the legs
+    Order parseOrder(const Params& params, const std::string& prefix, const std::string& sharedPrefix) {
+        Order order;
+        order.symbol = mandatoryParam(params, "symbol");
+        bookOf(order.symbol);
+        order.type = enumParam(mandatoryParam(params, keyOf(prefix, "Type")), orderTypeFromString,
+                               -1116, "Invalid orderType.");
+        order.side = enumParam(mandatoryParam(params, keyOf(sharedPrefix, "Side")), orderSideFromString,
+                               -1117, "Invalid side.");
+
+        std::string tifKey = keyOf(prefix, "TimeInForce");
+        const std::string* tif = optionalParam(params, tifKey);
+        if (tif) {
+            order.timeInForce = enumParam(*tif, timeInForceFromString, -1115, "Invalid timeInForce.");
+        }
+        std::string quantityKey = keyOf(sharedPrefix, "Quantity");
+        const std::string* quantity = optionalParam(params, quantityKey);
+        const std::string* quoteQuantity = prefix.empty() ? optionalParam(params, "quoteOrderQty") : nullptr;
+        std::string priceKey = keyOf(prefix, "Price");
+        const std::string* price = optionalParam(params, priceKey);
+        std::string stopKey = keyOf(prefix, "StopPrice");
+        const std::string* stopPrice = optionalParam(params, stopKey);
+
+        if (hasLimit(order.type)) {
+            if (order.type != OrderType::LIMIT_MAKER && !tif) mandatoryParam(params, tifKey);
+            mandatoryParam(params, priceKey);
+        } else if (price) {
+            fail(-1106, "Parameter '" + priceKey + "' sent when not required.");
+        }
+        if (hasStop(order.type)) {
+            mandatoryParam(params, stopKey);
+        }
+        if (order.type == OrderType::MARKET) {
+            if (quantity && quoteQuantity) {
+                fail(-1106, "Parameter 'quoteOrderQty' sent when not required.");
+            }
+            if (!quantity && !quoteQuantity) {
+                fail(-1102, "Param 'quantity' or 'quoteOrderQty' must be sent, but both were empty/null!");
+            }
+        } else {
+            mandatoryParam(params, quantityKey);
+            quoteQuantity = nullptr;
+        }
+
+        if (quantity) order.origQty = decimalParam(quantityKey, *quantity);
+        if (quoteQuantity) order.origQuoteOrderQty = decimalParam("quoteOrderQty", *quoteQuantity);
+        if (price) order.price = decimalParam(priceKey, *price);
+        if (stopPrice) order.stopPrice = decimalParam(stopKey, *stopPrice);
+        if ((quantity && order.origQty.units() <= 0) || (quoteQuantity && order.origQuoteOrderQty.units() <= 0)) {
+            fail(-1013, "Filter failure: LOT_SIZE");
+        }
+        if ((price && order.price.units() <= 0) || (stopPrice && order.stopPrice.units() <= 0)) {
+            fail(-1013, "Filter failure: PRICE_FILTER");
+        }
+
+        const std::string* clientOrderId = optionalParam(params, prefix.empty() ? "newClientOrderId"
+                                                                                : prefix + "ClientOrderId");
+        if (clientOrderId) {
+            auto found = clientOrderIds.find(order.symbol + ' ' + *clientOrderId);
+            if (found != clientOrderIds.end()) {
+                const Order& existing = orders.at(found->second);
+                if (isOpen(existing) || existing.status == OrderStatus::PENDING_NEW) {
+                    fail(-2010, "Duplicate order sent.");
+                }
+            }
+            order.clientOrderId = *clientOrderId;
+        }
+        return order;
+    }
+
+    static OrderResponseType responseType(const Params& params, OrderType type) {
+        const std::string* value = optionalParam(params, "newOrderRespType");
+        if (value) {
+            return enumParam(*value, orderResponseTypeFromString, -1100, "Invalid newOrderRespType.");
+        }
+        return type == OrderType::MARKET || type == OrderType::LIMIT ? OrderResponseType::FULL
+                                                                     : OrderResponseType::ACK;
+    }
+
+    // Whether a limit order would take liquidity: from the market, or from a resting order
+    bool wouldTake(const Order& order, const Book& book) const {
+        int64_t sign = -signOf(order.side);
+        if (sign * order.price.units() >= sign * book.price.units()) return true;
+        const auto& opposite = book.levels[1 - sideIndex(order.side)];
+        return !opposite.empty() && opposite.begin()->first <= sign * order.price.units();
+    }
+
+    void checkPlaceable(const Order& order, const Book& book) const {
+        if (book.enforceFilters) {
+            // A quote-quantity market order has no base quantity to check
+            bool priced = order.price.units() > 0;
+            FilterResult result = FilterResult::OK;
+            if (priced || order.origQty.units() > 0) {
+                result = book.filters.check(order.side, priced ? OrderType::LIMIT : OrderType::MARKET, order.price,
+                                            order.origQty, book.price);
+            }
+            if (result == FilterResult::NOT_TRADING) {
+                fail(-1013, "Market is closed.");
+            } else if (result != FilterResult::OK) {
+                fail(-1013, std::string("Filter failure: ") + toString(result));
+            }
+        }
+        if (order.type == OrderType::LIMIT_MAKER && wouldTake(order, book)) {
+            fail(-2010, "Order would immediately match and take.");
+        }
+        if (hasStop(order.type) && triggered(order, book.price)) {
+            fail(-2010, "Order would trigger immediately.");
+        }
+    }
+
+    Order& addOrder(Order order, int64_t now, int64_t orderListId = -1) {
+        order.orderId = nextOrderId++;
+        order.orderListId = orderListId;
+        if (order.clientOrderId.empty()) {
+            order.clientOrderId = "sim" + std::to_string(order.orderId);
+        }
+        order.time = now;
+        order.updateTime = now;
+        clientOrderIds[order.symbol + ' ' + order.clientOrderId] = order.orderId;
+        int64_t id = order.orderId;
+        Order& added = orders.emplace(id, std::move(order)).first->second;
+        report(added, ExecutionType::NEW);
+        return added;
+    }
+
+    Order* findOrder(const Params& params, const std::string& symbol, const char* idKey, const char* clientKey) {
+        const std::string* clientOrderId = optionalParam(params, clientKey);
+        int64_t orderId = integerParam(params, idKey, -1);
+        if (orderId < 0 && !clientOrderId) {
+            fail(-1102, std::string("Param '") + clientKey + "' or '" + idKey +
+                            "' must be sent, but both were empty/null!");
+        }
+        if (orderId < 0) {
+            auto found = clientOrderIds.find(symbol + ' ' + *clientOrderId);
+            if (found == clientOrderIds.end()) return nullptr;
+            orderId = found->second;
+        }
+        auto found = orders.find(orderId);
+        return found == orders.end() || found->second.symbol != symbol ? nullptr : &found->second;
+    }
+
+    void rest(Order& order, Book& book) {
+        book.levels[sideIndex(order.side)][signOf(order.side) * order.price.units()].push_back(order.orderId);
+        ++book.updateId;
+    }
+
+    // Takes a resting or waiting order out of the book
+    void unlink(Order& order, Book& book) {
+        if (hasStop(order.type) && !order.isWorking) {
+            book.stops.erase(std::remove(book.stops.begin(), book.stops.end(), order.orderId), book.stops.end());
+            return;
+        }
+        auto& levels = book.levels[sideIndex(order.side)];
+        auto level = levels.find(signOf(order.side) * order.price.units());
+        if (level == levels.end()) return;
+        auto& queue = level->second;
+        queue.erase(std::remove(queue.begin(), queue.end(), order.orderId), queue.end());
+        if (queue.empty()) levels.erase(level);
+        ++book.updateId;
+    }
+
+    void retire(Order& order, OrderStatus status, int64_t now) {
+        if (isOpen(order)) unlink(order, bookOf(order.symbol));
+        order.status = status;
+        order.updateTime = now;
+        report(order, status == OrderStatus::CANCELED ? ExecutionType::CANCELED : ExecutionType::EXPIRED);
+    }
+
+    // Records one fill of an order: its totals, the account balances and an execution report
+    void fillOrder(Order& order, Book& book, Decimal price, Decimal qty, bool maker, int64_t now,
+                   std::vector<Fill>* fills = nullptr) {
+        order.executedQty += qty;
+        order.cumQuote += price * qty;
+        order.updateTime = now;
+        order.status = quoteSized(order) || order.executedQty < order.origQty ? OrderStatus::PARTIALLY_FILLED
+                                                                             : OrderStatus::FILLED;
+
+        bool buy = order.side == OrderSide::BUY;
+        Decimal quote = price * qty;
+        Decimal commission = (buy ? qty : quote) * (maker ? config.makerCommission : config.takerCommission);
+        const std::string& commissionAsset = buy ? book.baseAsset : book.quoteAsset;
+        credit(book.baseAsset, buy ? qty - commission : -qty);
+        credit(book.quoteAsset, buy ? -quote : quote - commission);
+
+        if (Execution* execution = report(order, ExecutionType::TRADE)) {
+            execution->lastPrice = price;
+            execution->lastQty = qty;
+            execution->commission = commission;
+            execution->commissionAsset = commissionAsset;
+            execution->tradeId = book.nextTradeId - 1;
+            execution->maker = maker;
+        }
+        if (!fills) return;
+        Fill& fill = fills->emplace_back();
+        fill.price = price;
+        fill.qty = qty;
+        fill.commission = commission;
+        fill.commissionAsset = commissionAsset;
+        fill.tradeId = book.nextTradeId - 1;
+    }
+
+    // Quantity a taker could get within its limit, from the book and the market
+    bool canFill(const Order& order, const Book& book) const {
+        int64_t sign = -signOf(order.side);
+        if (sign * order.price.units() >= sign * book.price.units()) return true;
+        Decimal available;
+        for (const auto& level : book.levels[1 - sideIndex(order.side)]) {
+            if (level.first > sign * order.price.units()) break;
+            for (int64_t id : level.second) {
+                const Order& maker = orders.at(id);
+                available += maker.origQty - maker.executedQty;
+            }
+        }
+        return available >= order.origQty;
+    }
+
+    // Matches a working order as the taker: first the resting orders priced better than the market,
+    // then the market itself, within the order's limit if it has one
+    void take(Order& order, Book& book, int64_t now, std::vector<Fill>* fills) {
+        bool limited = hasLimit(order.type);
+        int64_t sign = -signOf(order.side);
+        int64_t limit = sign * order.price.units();
+        int64_t market = sign * book.price.units();
+        auto& levels = book.levels[1 - sideIndex(order.side)];
+
+        for (auto level = levels.begin(); level != levels.end();) {
+            if (level->first >= market || (limited && level->first > limit)) break;
+            Decimal price = Decimal::fromUnits(level->first < 0 ? -level->first : level->first);
+            auto& queue = level->second;
+            while (!queue.empty()) {
+                Decimal wanted = fillable(order, price);
+                if (wanted.units() <= 0) break;
+                Order& maker = orders.at(queue.front());
+                Decimal qty = std::min(wanted, maker.origQty - maker.executedQty);
+                ++book.nextTradeId;
+                fillOrder(maker, book, price, qty, true, now);
+                fillOrder(order, book, price, qty, false, now, fills);
+                touched.push_back(maker.orderId);
+                if (maker.status == OrderStatus::FILLED) queue.pop_front();
+            }
+            ++book.updateId;
+            if (!queue.empty()) break;
+            level = levels.erase(level);
+        }
+
+        Decimal wanted = fillable(order, book.price);
+        if (wanted.units() > 0 && (!limited || limit >= market)) {
+            ++book.nextTradeId;
+            fillOrder(order, book, book.price, wanted, false, now, fills);
+        }
+    }
+
+    // Executes an order that is working: it takes what it can, then rests or expires
+    void execute(Order& order, Book& book, int64_t now, std::vector<Fill>* fills) {
+        if (order.type == OrderType::LIMIT_MAKER) {
+            if (wouldTake(order, book)) {
+                order.status = OrderStatus::EXPIRED;
+                report(order, ExecutionType::EXPIRED);
+                touched.push_back(order.orderId);
+            } else {
+                rest(order, book);
+            }
+            return;
+        }
+        bool limited = hasLimit(order.type);
+        if (limited && order.timeInForce == TimeInForce::FOK && !canFill(order, book)) {
+            order.status = OrderStatus::EXPIRED;
+            report(order, ExecutionType::EXPIRED);
+            touched.push_back(order.orderId);
+            return;
+        }
+
+        take(order, book, now, fills);
+        if (quoteSized(order)) {
+            // A quote-sized order reports what it bought or sold as its quantity
+            order.origQty = order.executedQty;
+            order.status = order.executedQty.isZero() ? OrderStatus::EXPIRED : OrderStatus::FILLED;
+            if (order.status == OrderStatus::EXPIRED) {
+                report(order, ExecutionType::EXPIRED);
+            } else if (!executions.empty() && executions.back().order.orderId == order.orderId) {
+                executions.back().order = order;  // Its last fill reports it filled
+            }
+        } else if (order.status != OrderStatus::FILLED) {
+            if (limited && order.timeInForce == TimeInForce::GTC) {
+                rest(order, book);
+            } else {
+                order.status = OrderStatus::EXPIRED;
+                report(order, ExecutionType::EXPIRED);
+            }
+        }
+        if (!order.executedQty.isZero() || order.status == OrderStatus::EXPIRED) {
+            touched.push_back(order.orderId);
+        }
+    }
+
+    // Puts a new order to work: stop and take-profit orders wait for their price
+    void submit(Order& order, int64_t now, std::vector<Fill>* fills) {
+        Book& book = bookOf(order.symbol);
+        if (hasStop(order.type) && !triggered(order, book.price)) {
+            order.isWorking = false;
+            book.stops.push_back(order.orderId);
+            return;
+        }
+        order.workingTime = now;
+        execute(order, book, now, fills);
+    }
+
+    void trigger(Order& order, Book& book, int64_t now) {
+        order.isWorking = true;
+        order.workingTime = now;
+        order.updateTime = now;
+        touched.push_back(order.orderId);
+        execute(order, book, now, nullptr);
+    }
+
+    // Applies the consequences of fills, triggers and expiries to order lists
+    void settle(int64_t now) {
+        while (!touched.empty()) {
+            Order& order = orders.at(touched.front());
+            touched.erase(touched.begin());
+            if (order.orderListId < 0) continue;
+            OrderList& list = lists.at(order.orderListId);
+            size_t index = static_cast<size_t>(
+                std::find(list.orderIds.begin(), list.orderIds.end(), order.orderId) - list.orderIds.begin());
+
+            for (size_t i = 0; i < list.orderIds.size(); ++i) {
+                Order& other = orders.at(list.orderIds[i]);
+                if (linkedLegs(list, index, i) && isOpen(other)) {
+                    retire(other, OrderStatus::EXPIRED, now);
+                }
+            }
+
+            bool working = index == 0 && list.contingencyType != ContingencyType::OCO;
+            if (working && order.status == OrderStatus::FILLED) {
+                for (size_t i = 1; i < list.orderIds.size(); ++i) {
+                    Order& pending = orders.at(list.orderIds[i]);
+                    if (pending.status != OrderStatus::PENDING_NEW) continue;
+                    pending.status = OrderStatus::NEW;
+                    pending.updateTime = now;
+                    report(pending, ExecutionType::NEW);
+                    submit(pending, now, nullptr);
+                }
+            } else if (working && !isOpen(order)) {
+                for (size_t i = 1; i < list.orderIds.size(); ++i) {
+                    Order& pending = orders.at(list.orderIds[i]);
+                    if (pending.status == OrderStatus::PENDING_NEW) retire(pending, OrderStatus::EXPIRED, now);
+                }
+            }
+            updateList(list);
+        }
+    }
+
+    void updateList(OrderList& list) {
+        list.done = std::none_of(list.orderIds.begin(), list.orderIds.end(), [this](int64_t id) {
+            const Order& order = orders.at(id);
+            return isOpen(order) || order.status == OrderStatus::PENDING_NEW;
+        });
+    }
+
+    // Trades the book against an outside order at a price, then moves the market there
+    Decimal sweep(Book& book, Decimal price, const Decimal* quantity, int64_t now) {
+        Decimal filled;
+        for (int side = 0; side < 2; ++side) {
+            auto& levels = book.levels[side];
+            int64_t sign = side == 0 ? -1 : 1;
+            for (auto level = levels.begin(); level != levels.end();) {
+                if (level->first > sign * price.units()) break;
+                Decimal levelPrice = Decimal::fromUnits(sign * level->first);
+                auto& queue = level->second;
+                while (!queue.empty() && (!quantity || filled < *quantity)) {
+                    Order& maker = orders.at(queue.front());
+                    Decimal qty = maker.origQty - maker.executedQty;
+                    if (quantity) qty = std::min(qty, *quantity - filled);
+                    ++book.nextTradeId;
+                    fillOrder(maker, book, levelPrice, qty, true, now);
+                    filled += qty;
+                    touched.push_back(maker.orderId);
+                    if (maker.status == OrderStatus::FILLED) queue.pop_front();
+                }
+                ++book.updateId;
+                if (!queue.empty()) break;
+                level = levels.erase(level);
+            }
+        }
+        book.price = price;
+        settle(now);
+
+        std::vector<int64_t> due;
+        for (int64_t id : book.stops) {
+            if (triggered(orders.at(id), price)) due.push_back(id);
+        }
+        for (int64_t id : due) {
+            Order& order = orders.at(id);
+            if (order.status != OrderStatus::NEW || order.isWorking) continue;  // Expired by an earlier trigger
+            book.stops.erase(std::remove(book.stops.begin(), book.stops.end(), id), book.stops.end());
+            trigger(order, book, now);
+            settle(now);
+        }
+        return filled;
+    }
+
+    // --- User data streams ---
+
+    void noteChanged(const std::string& asset) {
+        if (!userStreams.empty() && std::find(changedAssets.begin(), changedAssets.end(), asset) ==
+                                        changedAssets.end()) {
+            changedAssets.push_back(asset);
+        }
+    }
+
+    void credit(const std::string& asset, Decimal amount) {
+        balances[asset] += amount;
+        noteChanged(asset);
+    }
+
+    // Queues an execution report of the order's current state; nullptr unless a stream listens
+    Execution* report(const Order& order, ExecutionType type) {
+        if (userStreams.empty()) return nullptr;
+        Execution& execution = executions.emplace_back();
+        execution.order = order;
+        execution.type = type;
+        return &execution;
+    }
+
+    // Sends the reports and balance changes queued by the last request, in the order they happened
+    void publish(int64_t now) {
+        if (userStreams.empty()) {
+            executions.clear();
+            changedAssets.clear();
+            return;
+        }
+        for (const Execution& execution : executions) {
+            broadcast(executionReport(execution, now));
+        }
+        executions.clear();
+        if (!changedAssets.empty()) {
+            std::string out = "{";
+            field(out, "e", "outboundAccountPosition");
+            field(out, "E", now);
+            field(out, "u", now);
+            key(out, "B");
+            out += '[';
+            for (const std::string& asset : changedAssets) {
+                element(out);
+                out += '{';
+                field(out, "a", asset);
+                field(out, "f", balances[asset]);
+                field(out, "l", Decimal());
+                out += '}';
+            }
+            out += "]}";
+            changedAssets.clear();
+            broadcast(out);
+        }
+    }
+
+    void broadcast(const std::string& event) {
+        std::string frame = frameOf(0x1, event);
+        for (const UserStream& stream : userStreams) {
+            sendAll(stream.fd, frame);
+        }
+    }
+
+    static std::string executionReport(const Execution& execution, int64_t now) {
+        const Order& order = execution.order;
+        bool canceled = execution.type == ExecutionType::CANCELED;
+        std::string out = "{";
+        field(out, "e", "executionReport");
+        field(out, "E", now);
+        field(out, "s", order.symbol);
+        // A cancel names the cancel request in "c" and the order's own id in "C"
+        field(out, "c", canceled ? "sim-cancel" + std::to_string(order.orderId) : order.clientOrderId);
+        field(out, "S", toString(order.side));
+        field(out, "o", toString(order.type));
+        field(out, "f", toString(order.timeInForce));
+        field(out, "q", order.origQty);
+        field(out, "p", order.price);
+        field(out, "P", order.stopPrice);
+        field(out, "F", Decimal());
+        field(out, "g", order.orderListId);
+        field(out, "C", canceled ? order.clientOrderId : "");
+        field(out, "x", toString(execution.type));
+        field(out, "X", toString(order.status));
+        field(out, "r", "NONE");
+        field(out, "i", order.orderId);
+        field(out, "l", execution.lastQty);
+        field(out, "z", order.executedQty);
+        field(out, "L", execution.lastPrice);
+        field(out, "n", execution.commission);
+        key(out, "N");
+        if (execution.commissionAsset.empty()) {
+            out += "null";
+        } else {
+            appendQuoted(out, execution.commissionAsset);
+        }
+        field(out, "T", order.updateTime);
+        field(out, "t", execution.tradeId);
+        field(out, "I", static_cast<int64_t>(0));
+        flag(out, "w", isOpen(order) && order.isWorking);
+        flag(out, "m", execution.maker);
+        flag(out, "M", false);
+        field(out, "O", order.time);
+        field(out, "Z", order.cumQuote);
+        field(out, "Y", execution.lastPrice * execution.lastQty);
+        field(out, "Q", order.origQuoteOrderQty);
+        if (order.workingTime >= 0) field(out, "W", order.workingTime);
+        field(out, "V", "NONE");
+        out += '}';
+        return out;
+    }
+
+    std::string newListenKey(const Params&, int64_t now) {
+        // The exchange hands out the active key again while there is one
+        std::string listenKey;
+        if (listenKeys.empty()) {
+            static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+            std::lock_guard<std::mutex> lock(rngMutex);
+            for (int i = 0; i < 60; ++i) {
+                listenKey += alphabet[rng() % (sizeof(alphabet) - 1)];
+            }
+        } else {
+            listenKey = listenKeys.begin()->first;
+        }
+        listenKeys[listenKey] = now;
+        std::string out = "{";
+        field(out, "listenKey", listenKey);
+        out += '}';
+        return out;
+    }
+
+    std::string keepAliveListenKey(const Params& params, int64_t now) {
+        auto found = listenKeys.find(mandatoryParam(params, "listenKey"));
+        if (found == listenKeys.end()) fail(-1125, "This listenKey does not exist.");
+        found->second = now;
+        return "{}";
+    }
+
+    std::string closeListenKey(const Params& params, int64_t) {
+        const std::string& listenKey = mandatoryParam(params, "listenKey");
+        if (listenKeys.erase(listenKey) == 0) fail(-1125, "This listenKey does not exist.");
+        for (const UserStream& stream : userStreams) {
+            if (stream.listenKey == listenKey) ::shutdown(stream.fd, SHUT_RDWR);
+        }
+        return "{}";
+    }
+
+    // --- Responses ---
+
+    static void writeOrderCommon(std::string& out, const Order& order) {
+        field(out, "price", order.price);
+        field(out, "origQty", order.origQty);
+        field(out, "executedQty", order.executedQty);
+        field(out, "cummulativeQuoteQty", order.cumQuote);
+        field(out, "status", toString(order.status));
+        field(out, "timeInForce", toString(order.timeInForce));
+        field(out, "type", toString(order.type));
+        field(out, "side", toString(order.side));
+    }
+
+    static void writeOrderResult(std::string& out, const Order& order, OrderResponseType type,
+                                 const std::vector<Fill>& fills, int64_t now) {
+        out += '{';
+        field(out, "symbol", order.symbol);
+        field(out, "orderId", order.orderId);
+        field(out, "orderListId", order.orderListId);
+        field(out, "clientOrderId", order.clientOrderId);
+        field(out, "transactTime", now);
+        if (type != OrderResponseType::ACK) {
+            writeOrderCommon(out, order);
+            field(out, "origQuoteOrderQty", order.origQuoteOrderQty);
+            if (hasStop(order.type)) field(out, "stopPrice", order.stopPrice);
+            if (order.workingTime >= 0) field(out, "workingTime", order.workingTime);
+            field(out, "selfTradePreventionMode", "NONE");
+            if (order.usedSor) {
+                field(out, "workingFloor", "SOR");
+                flag(out, "usedSor", true);
+            }
+        }
+        if (type == OrderResponseType::FULL) {
+            key(out, "fills");
+            out += '[';
+            for (const Fill& fill : fills) {
+                element(out);
+                out += '{';
+                field(out, "price", fill.price);
+                field(out, "qty", fill.qty);
+                field(out, "commission", fill.commission);
+                field(out, "commissionAsset", fill.commissionAsset);
+                field(out, "tradeId", fill.tradeId);
+                out += '}';
+            }
+            out += ']';
+        }
+        out += '}';
+    }
+
+    static void writeOrderQuery(std::string& out, const Order& order) {
+        out += '{';
+        field(out, "symbol", order.symbol);
+        field(out, "orderId", order.orderId);
+        field(out, "orderListId", order.orderListId);
+        field(out, "clientOrderId", order.clientOrderId);
+        writeOrderCommon(out, order);
+        field(out, "stopPrice", order.stopPrice);
+        field(out, "icebergQty", Decimal());
+        field(out, "time", order.time);
+        field(out, "updateTime", order.updateTime);
+        flag(out, "isWorking", order.isWorking && order.status != OrderStatus::PENDING_NEW);
+        if (order.workingTime >= 0) field(out, "workingTime", order.workingTime);
+        field(out, "origQuoteOrderQty", order.origQuoteOrderQty);
+        field(out, "selfTradePreventionMode", "NONE");
+        if (order.usedSor) {
+            field(out, "workingFloor", "SOR");
+            flag(out, "usedSor", true);
+        }
+        out += '}';
+    }
+
+    static void writeCancel(std::string& out, const Order& order, const std::string& cancelClientOrderId,
+                            int64_t now) {
+        out += '{';
+        field(out, "symbol", order.symbol);
+        field(out, "origClientOrderId", order.clientOrderId);
+        field(out, "orderId", order.orderId);
+        field(out, "orderListId", order.orderListId);
+        field(out, "clientOrderId", cancelClientOrderId);
+        field(out, "transactTime", now);
+        writeOrderCommon(out, order);
+        if (hasStop(order.type)) field(out, "stopPrice", order.stopPrice);
+        field(out, "selfTradePreventionMode", "NONE");
+        out += '}';
+    }
+
+    enum class Reports { NONE, PLACED, CANCELED };
+
+    void writeList(std::string& out, const OrderList& list, Reports reports, int64_t now) const {
+        out += '{';
+        field(out, "orderListId", list.orderListId);
+        field(out, "contingencyType", toString(list.contingencyType));
+        field(out, "listStatusType", list.done ? "ALL_DONE" : "EXEC_STARTED");
+        field(out, "listOrderStatus", list.done ? "ALL_DONE" : "EXECUTING");
+        field(out, "listClientOrderId", list.listClientOrderId);
+        field(out, "transactionTime", list.transactionTime);
+        field(out, "symbol", list.symbol);
+        key(out, "orders");
+        out += '[';
+        for (int64_t id : list.orderIds) {
+            const Order& order = orders.at(id);
+            element(out);
+            out += '{';
+            field(out, "symbol", order.symbol);
+            field(out, "orderId", order.orderId);
+            field(out, "clientOrderId", order.clientOrderId);
+            out += '}';
+        }
+        out += ']';
+        if (reports != Reports::NONE) {
+            key(out, "orderReports");
+            out += '[';
+            for (int64_t id : list.orderIds) {
+                element(out);
+                if (reports == Reports::PLACED) {
+                    writeOrderResult(out, orders.at(id), OrderResponseType::RESULT, {}, list.transactionTime);
+                } else {
+                    writeCancel(out, orders.at(id), "sim-cancel" + std::to_string(id), now);
+                }
+            }
+            out += ']';
+        }
+        out += '}';
+    }
+
+    // --- Endpoints ---
+
+    std::string ping(const Params&, int64_t) {
+        return "{}";
+    }
+
+    std::string serverTime(const Params&, int64_t now) {
+        std::string out = "{";
+        field(out, "serverTime", now);
+        out += '}';
+        return out;
+    }
+
+    std::string tickerPrice(const Params& params, int64_t) {
+        auto write = [](std::string& out, const std::string& symbol, const Book& book) {
+            out += '{';
+            field(out, "symbol", symbol);
+            field(out, "price", book.price);
+            out += '}';
+        };
+        std::string out;
+        if (const std::string* symbol = optionalParam(params, "symbol")) {
+            write(out, *symbol, bookOf(*symbol));
+            return out;
+        }
+        out = "[";
+        for (const auto& entry : books) {
+            element(out);
+            write(out, entry.first, entry.second);
+        }
+        out += ']';
+        return out;
+    }
+
+    std::string depth(const Params& params, int64_t) {
+        const Book& book = bookOf(mandatoryParam(params, "symbol"));
+        int64_t limit = std::min<int64_t>(integerParam(params, "limit", 100), 5000);
+        std::string out = "{";
+        field(out, "lastUpdateId", book.updateId);
+        for (int side = 0; side < 2; ++side) {
+            key(out, side == 0 ? "bids" : "asks");
+            out += '[';
+            int64_t count = 0;
+            for (const auto& level : book.levels[side]) {
+                if (count++ == limit) break;
+                Decimal qty;
+                for (int64_t id : level.second) {
+                    const Order& order = orders.at(id);
+                    qty += order.origQty - order.executedQty;
+                }
+                element(out);
+                out += '[';
+                appendDecimal(out, Decimal::fromUnits(level.first < 0 ? -level.first : level.first));
+                out += ',';
+                appendDecimal(out, qty);
+                out += ']';
+            }
+            out += ']';
+        }
+        out += '}';
+        return out;
+    }
+
+    std::string exchangeInfo(const Params& params, int64_t now) {
+        std::vector<std::string> symbols;
+        if (const std::string* symbol = optionalParam(params, "symbol")) {
+            symbols.push_back(*symbol);
+        } else if (const std::string* list = optionalParam(params, "symbols")) {
+            // ["BTCUSDT","ETHUSDT"]
+            JsonReader reader(*list);
+            try {
+                reader.beginArray();
+                while (reader.nextElement()) {
+                    symbols.emplace_back(reader.readString());
+                }
+            } catch (const std::exception&) {
+                fail(-1100, "Illegal characters found in parameter 'symbols'.");
+            }
+        } else {
+            for (const auto& entry : books) {
+                symbols.push_back(entry.first);
+            }
+        }
+
+        std::string out = "{";
+        field(out, "timezone", "UTC");
+        field(out, "serverTime", now);
+        key(out, "rateLimits");
+        out += "[]";
+        key(out, "exchangeFilters");
+        out += "[]";
+        key(out, "symbols");
+        out += '[';
+        for (const std::string& symbol : symbols) {
+            const Book& book = bookOf(symbol);
+            const SymbolFilters filters = book.enforceFilters ? book.filters : looseFilters(symbol, book);
+            element(out);
+            out += '{';
+            field(out, "symbol", symbol);
+            field(out, "status", filters.trading ? "TRADING" : "BREAK");
+            field(out, "baseAsset", book.baseAsset);
+            field(out, "baseAssetPrecision", int64_t{8});
+            field(out, "quoteAsset", book.quoteAsset);
+            field(out, "quotePrecision", int64_t{8});
+            field(out, "quoteAssetPrecision", int64_t{8});
+            key(out, "orderTypes");
+            out += "[\"LIMIT\",\"LIMIT_MAKER\",\"MARKET\",\"STOP_LOSS\",\"STOP_LOSS_LIMIT\",\"TAKE_PROFIT\","
+                   "\"TAKE_PROFIT_LIMIT\"]";
+            key(out, "filters");
+            out += "[{";
+            field(out, "filterType", "PRICE_FILTER");
+            field(out, "minPrice", filters.minPrice);
+            field(out, "maxPrice", filters.maxPrice);
+            field(out, "tickSize", filters.tickSize);
+            out += "},{";
+            field(out, "filterType", "LOT_SIZE");
+            field(out, "minQty", filters.minQty);
+            field(out, "maxQty", filters.maxQty);
+            field(out, "stepSize", filters.stepSize);
+            out += "},{";
+            field(out, "filterType", "MARKET_LOT_SIZE");
+            field(out, "minQty", filters.marketMinQty);
+            field(out, "maxQty", filters.marketMaxQty);
+            field(out, "stepSize", filters.marketStepSize);
+            out += "},{";
+            field(out, "filterType", "NOTIONAL");
+            field(out, "minNotional", filters.minNotional);
+            flag(out, "applyMinToMarket", filters.applyMinToMarket);
+            field(out, "maxNotional", filters.maxNotional);
+            flag(out, "applyMaxToMarket", filters.applyMaxToMarket);
+            field(out, "avgPriceMins", int64_t{5});
+            out += '}';
+            if (filters.bidMultiplierUp.units() > 0 || filters.askMultiplierUp.units() > 0) {
+                out += ",{";
+                field(out, "filterType", "PERCENT_PRICE_BY_SIDE");
+                field(out, "bidMultiplierUp", filters.bidMultiplierUp);
+                field(out, "bidMultiplierDown", filters.bidMultiplierDown);
+                field(out, "askMultiplierUp", filters.askMultiplierUp);
+                field(out, "askMultiplierDown", filters.askMultiplierDown);
+                field(out, "avgPriceMins", int64_t{5});
+                out += '}';
+            }
+            out += "]}";
+        }
+        out += "]}";
+        return out;
+    }
+
+    std::string placeOrder(const Params& params, int64_t now, bool sor) {
+        Order parsed = parseOrder(params, "", "");
+        if (sor && parsed.type != OrderType::LIMIT && parsed.type != OrderType::MARKET) {
+            fail(-1116, "Invalid orderType.");
+        }
+        OrderResponseType type = responseType(params, parsed.type);
+        checkPlaceable(parsed, bookOf(parsed.symbol));
+
+        Order& order = addOrder(std::move(parsed), now);
+        order.usedSor = sor;
+        std::vector<Fill> fills;
+        submit(order, now, &fills);
+        settle(now);
+
+        std::string out;
+        writeOrderResult(out, order, type, fills, now);
+        return out;
+    }
+
+    std::string newOrder(const Params& params, int64_t now) {
+        return placeOrder(params, now, false);
+    }
+
+    std::string newSorOrder(const Params& params, int64_t now) {
+        return placeOrder(params, now, true);
+    }
+
+    std::string validateOrder(const Params& params, bool sor) {
+        Order order = parseOrder(params, "", "");
+        if (sor && order.type != OrderType::LIMIT && order.type != OrderType::MARKET) {
+            fail(-1116, "Invalid orderType.");
+        }
+        const std::string* rates = optionalParam(params, "computeCommissionRates");
+        if (!rates || *rates != "true") {
+            return "{}";
+        }
+        std::string out = "{";
+        key(out, "standardCommissionForOrder");
+        out += '{';
+        field(out, "maker", config.makerCommission);
+        field(out, "taker", config.takerCommission);
+        out += '}';
+        key(out, "taxCommissionForOrder");
+        out += '{';
+        field(out, "maker", Decimal());
+        field(out, "taker", Decimal());
+        out += '}';
+        key(out, "discount");
+        out += '{';
+        flag(out, "enabledForAccount", false);
+        flag(out, "enabledForSymbol", false);
+        field(out, "discountAsset", "BNB");
+        field(out, "discount", Decimal());
+        out += "}}";
+        return out;
+    }
+
+    std::string testOrder(const Params& params, int64_t) {
+        return validateOrder(params, false);
+    }
+
+    std::string testSorOrder(const Params& params, int64_t) {
+        return validateOrder(params, true);
+    }
+
+    std::string queryOrder(const Params& params, int64_t) {
+        const std::string& symbol = mandatoryParam(params, "symbol");
+        bookOf(symbol);
+        const Order* order = findOrder(params, symbol, "orderId", "origClientOrderId");
+        if (!order) fail(-2013, "Order does not exist.");
+        std::string out;
+        writeOrderQuery(out, *order);
+        return out;
+    }
+
+    // Cancels an order, or the whole list it belongs to
+    void cancel(Order& order, int64_t now) {
+        if (order.orderListId >= 0) {
+            OrderList& list = lists.at(order.orderListId);
+            for (int64_t id : list.orderIds) {
+                Order& leg = orders.at(id);
+                if (isOpen(leg) || leg.status == OrderStatus::PENDING_NEW) retire(leg, OrderStatus::CANCELED, now);
+            }
+            list.done = true;
+            return;
+        }
+        retire(order, OrderStatus::CANCELED, now);
+    }
+
+    Order* cancelable(const Params& params, const std::string& symbol, const char* idKey, const char* clientKey) {
+        Order* order = findOrder(params, symbol, idKey, clientKey);
+        return order && (isOpen(*order) || order->status == OrderStatus::PENDING_NEW) ? order : nullptr;
+    }
+
+    std::string cancelOrder(const Params& params, int64_t now) {
+        const std::string& symbol = mandatoryParam(params, "symbol");
+        bookOf(symbol);
+        Order* order = cancelable(params, symbol, "orderId", "origClientOrderId");
+        if (!order) fail(-2011, "Unknown order sent.");
+        cancel(*order, now);
+        const std::string* cancelId = optionalParam(params, "newClientOrderId");
+        std::string out;
+        writeCancel(out, *order, cancelId ? *cancelId : "sim-cancel" + std::to_string(order->orderId), now);
+        return out;
+    }
+
+    std::string cancelReplace(const Params& params, int64_t now) {
+        const std::string& modeName = mandatoryParam(params, "cancelReplaceMode");
+        bool stopOnFailure = enumParam(modeName, cancelReplaceModeFromString, -1100, "Invalid cancelReplaceMode.") ==
+                             CancelReplaceMode::STOP_ON_FAILURE;
+        Order parsed = parseOrder(params, "", "");
+        OrderResponseType type = responseType(params, parsed.type);
+
+        std::string cancelResponse;
+        Order* target = cancelable(params, parsed.symbol, "cancelOrderId", "cancelOrigClientOrderId");
+        if (target) {
+            cancel(*target, now);
+            const std::string* cancelId = optionalParam(params, "cancelNewClientOrderId");
+            writeCancel(cancelResponse, *target,
+                        cancelId ? *cancelId : "sim-cancel" + std::to_string(target->orderId), now);
+        } else {
+            cancelResponse = errorBody(-2011, "Unknown order sent.");
+        }
+
+        std::string newOrderResponse;
+        const char* newOrderResult = "NOT_ATTEMPTED";
+        if (target || !stopOnFailure) {
+            try {
+                checkPlaceable(parsed, bookOf(parsed.symbol));
+                Order& order = addOrder(std::move(parsed), now);
+                std::vector<Fill> fills;
+                submit(order, now, &fills);
+                settle(now);
+                writeOrderResult(newOrderResponse, order, type, fills, now);
+                newOrderResult = "SUCCESS";
+            } catch (const ApiError& e) {
+                newOrderResponse = errorBody(e.code, e.what());
+                newOrderResult = "FAILURE";
+            }
+        }
+
+        std::string data = "{";
+        field(data, "cancelResult", target ? "SUCCESS" : "FAILURE");
+        field(data, "newOrderResult", newOrderResult);
+        key(data, "cancelResponse");
+        data += cancelResponse;
+        key(data, "newOrderResponse");
+        data += newOrderResponse.empty() ? "null" : newOrderResponse;
+        data += '}';
+
+        bool placed = newOrderResult == std::string_view("SUCCESS");
+        if (target && placed) {
+            return data;
+        }
+        bool partial = target || placed;
+        int code = partial ? -2021 : -2022;
+        const char* message = partial ? "Order cancel-replace partially failed." : "Order cancel-replace failed.";
+        std::string body = "{";
+        field(body, "code", static_cast<int64_t>(code));
+        field(body, "msg", message);
+        key(body, "data");
+        body += data;
+        body += '}';
+        throw ApiError(partial ? 409 : 400, code, message, body);
+    }
+
+    std::string openOrders(const Params& params, int64_t) {
+        const std::string* symbol = optionalParam(params, "symbol");
+        if (symbol) bookOf(*symbol);
+        std::string out = "[";
+        for (const auto& entry : orders) {
+            if (!isOpen(entry.second) || (symbol && entry.second.symbol != *symbol)) continue;
+            element(out);
+            writeOrderQuery(out, entry.second);
+        }
+        out += ']';
+        return out;
+    }
+
+    std::string cancelOpenOrders(const Params& params, int64_t now) {
+        const std::string& symbol = mandatoryParam(params, "symbol");
+        bookOf(symbol);
+        std::vector<int64_t> standalone;
+        std::vector<int64_t> listIds;
+        for (auto& entry : orders) {
+            Order& order = entry.second;
+            if (order.symbol != symbol || !(isOpen(order) || order.status == OrderStatus::PENDING_NEW)) continue;
+            if (order.orderListId < 0) {
+                standalone.push_back(order.orderId);
+            } else if (std::find(listIds.begin(), listIds.end(), order.orderListId) == listIds.end()) {
+                listIds.push_back(order.orderListId);
+            }
+        }
+        if (standalone.empty() && listIds.empty()) {
+            fail(-2011, "Unknown order sent.");
+        }
+
+        std::string out = "[";
+        for (int64_t id : standalone) {
+            Order& order = orders.at(id);
+            cancel(order, now);
+            element(out);
+            writeCancel(out, order, "sim-cancel" + std::to_string(id), now);
+        }
+        for (int64_t id : listIds) {
+            OrderList& list = lists.at(id);
+            cancel(orders.at(list.orderIds.front()), now);
+            element(out);
+            writeList(out, list, Reports::CANCELED, now);
+        }
+        out += ']';
+        return out;
+    }
+
+    std::string allOrders(const Params& params, int64_t) {
+        const std::string& symbol = mandatoryParam(params, "symbol");
+        bookOf(symbol);
+        int64_t fromId = integerParam(params, "orderId", -1);
+        size_t limit = static_cast<size_t>(std::clamp<int64_t>(integerParam(params, "limit", 500), 1, 1000));
+        std::vector<const Order*> matching;
+        for (const auto& entry : orders) {
+            if (entry.second.symbol == symbol && entry.first >= fromId) matching.push_back(&entry.second);
+        }
+        // From an orderId the oldest come first; otherwise the most recent
+        size_t first = fromId >= 0 || matching.size() <= limit ? 0 : matching.size() - limit;
+        std::string out = "[";
+        for (size_t i = first; i < matching.size() && i - first < limit; ++i) {
+            element(out);
+            writeOrderQuery(out, *matching[i]);
+        }
+        out += ']';
+        return out;
+    }
+
+    OrderList& addList(ContingencyType type, const Params& params, const std::string& symbol, int64_t now) {
+        OrderList list;
+        list.orderListId = nextListId++;
+        list.contingencyType = type;
+        const std::string* clientId = optionalParam(params, "listClientOrderId");
+        list.listClientOrderId = clientId ? *clientId : "simlist" + std::to_string(list.orderListId);
+        list.symbol = symbol;
+        list.transactionTime = now;
+        listClientOrderIds[list.listClientOrderId] = list.orderListId;
+        int64_t id = list.orderListId;
+        return lists.emplace(id, std::move(list)).first->second;
+    }
+
+    // Places the legs of a new list; the first is the working order of OTO and OTOCO lists
+    std::string placeList(ContingencyType type, const Params& params, std::vector<Order> legs, int64_t now) {
+        Book& book = bookOf(legs.front().symbol);
+        bool contingent = type != ContingencyType::OCO;
+        for (size_t i = 0; i < legs.size(); ++i) {
+            if (contingent && i > 0) continue;
+            try {
+                checkPlaceable(legs[i], book);
+            } catch (const ApiError&) {
+                if (contingent) throw;
+                fail(-2010, "The relationship of the prices for the orders is not correct.");
+            }
+        }
+
+        OrderList& list = addList(type, params, legs.front().symbol, now);
+        for (size_t i = 0; i < legs.size(); ++i) {
+            if (contingent && i > 0) legs[i].status = OrderStatus::PENDING_NEW;
+            list.orderIds.push_back(addOrder(std::move(legs[i]), now, list.orderListId).orderId);
+        }
+        for (size_t i = 0; i < list.orderIds.size(); ++i) {
+            Order& order = orders.at(list.orderIds[i]);
+            if (order.status == OrderStatus::NEW) submit(order, now, nullptr);
+        }
+        settle(now);
+        updateList(list);
+
+        std::string out;
+        writeList(out, list, Reports::PLACED, now);
+        return out;
+    }
+
+    std::string newLegacyOco(const Params& params, int64_t now) {
+        const std::string& symbol = mandatoryParam(params, "symbol");
+        Params stop{{"symbol", symbol},
+                    {"side", mandatoryParam(params, "side")},
+                    {"quantity", mandatoryParam(params, "quantity")},
+                    {"stopPrice", mandatoryParam(params, "stopPrice")}};
+        if (const std::string* stopLimitPrice = optionalParam(params, "stopLimitPrice")) {
+            stop["type"] = "STOP_LOSS_LIMIT";
+            stop["price"] = *stopLimitPrice;
+            stop["timeInForce"] = mandatoryParam(params, "stopLimitTimeInForce");
+        } else {
+            stop["type"] = "STOP_LOSS";
+        }
+        if (const std::string* id = optionalParam(params, "stopClientOrderId")) stop["newClientOrderId"] = *id;
+
+        Params limit{{"symbol", symbol},
+                     {"type", "LIMIT_MAKER"},
+                     {"side", stop["side"]},
+                     {"quantity", stop["quantity"]},
+                     {"price", mandatoryParam(params, "price")}};
+        if (const std::string* id = optionalParam(params, "limitClientOrderId")) limit["newClientOrderId"] = *id;
+
+        std::vector<Order> legs;
+        legs.push_back(parseOrder(stop, "", ""));
+        legs.push_back(parseOrder(limit, "", ""));
+        return placeList(ContingencyType::OCO, params, std::move(legs), now);
+    }
+
+    std::string newOco(const Params& params, int64_t now) {
+        std::vector<Order> legs;
+        legs.push_back(parseOrder(params, "below", ""));
+        legs.push_back(parseOrder(params, "above", ""));
+        return placeList(ContingencyType::OCO, params, std::move(legs), now);
+    }
+
+    std::string newOto(const Params& params, int64_t now) {
+        std::vector<Order> legs;
+        legs.push_back(parseOrder(params, "working", "working"));
+        legs.push_back(parseOrder(params, "pending", "pending"));
+        if (!hasLimit(legs.front().type) || hasStop(legs.front().type)) fail(-1116, "Invalid orderType.");
+        return placeList(ContingencyType::OTO, params, std::move(legs), now);
+    }
+
+    std::string newOtoco(const Params& params, int64_t now) {
+        std::vector<Order> legs;
+        legs.push_back(parseOrder(params, "working", "working"));
+        legs.push_back(parseOrder(params, "pendingBelow", "pending"));
+        legs.push_back(parseOrder(params, "pendingAbove", "pending"));
+        if (!hasLimit(legs.front().type) || hasStop(legs.front().type)) fail(-1116, "Invalid orderType.");
+        return placeList(ContingencyType::OTOCO, params, std::move(legs), now);
+    }
+
+    OrderList* findList(const Params& params, const char* clientKey) {
+        int64_t listId = integerParam(params, "orderListId", -1);
+        const std::string* clientId = optionalParam(params, clientKey);
+        if (listId < 0 && !clientId) {
+            fail(-1102, std::string("Param '") + clientKey + "' or 'orderListId' must be sent, but both were empty/null!");
+        }
+        if (listId < 0) {
+            auto found = listClientOrderIds.find(*clientId);
+            if (found == listClientOrderIds.end()) return nullptr;
+            listId = found->second;
+        }
+        auto found = lists.find(listId);
+        return found == lists.end() ? nullptr : &found->second;
+    }
+
+    std::string cancelOrderList(const Params& params, int64_t now) {
+        const std::string& symbol = mandatoryParam(params, "symbol");
+        bookOf(symbol);
+        OrderList* list = findList(params, "listClientOrderId");
+        if (!list || list->symbol != symbol || list->done) fail(-2011, "Unknown order sent.");
+        cancel(orders.at(list->orderIds.front()), now);
+        std::string out;
+        writeList(out, *list, Reports::CANCELED, now);
+        return out;
+    }
+
+    std::string queryOrderList(const Params& params, int64_t now) {
+        const OrderList* list = findList(params, "origClientOrderId");
+        if (!list) fail(-2013, "Order list does not exist.");
+        std::string out;
+        writeList(out, *list, Reports::NONE, now);
+        return out;
+    }
+
+    std::string allOrderLists(const Params& params, int64_t now) {
+        int64_t fromId = integerParam(params, "fromId", -1);
+        size_t limit = static_cast<size_t>(std::clamp<int64_t>(integerParam(params, "limit", 500), 1, 1000));
+        std::string out = "[";
+        size_t count = 0;
+        for (const auto& entry : lists) {
+            if (entry.first < fromId) continue;
+            if (count++ == limit) break;
+            element(out);
+            writeList(out, entry.second, Reports::NONE, now);
+        }
+        out += ']';
+        return out;
+    }
+
+    std::string openOrderLists(const Params&, int64_t now) {
+        std::string out = "[";
+        for (const auto& entry : lists) {
+            if (entry.second.done) continue;
+            element(out);
+            writeList(out, entry.second, Reports::NONE, now);
+        }
+        out += ']';
+        return out;
+    }
+};
+
+// ExchangeSimulator implementation
+
+ExchangeSimulator::ExchangeSimulator(const SimulatorConfig& config)
+    : pImpl(std::make_unique<Impl>(config)) {
+}
+
+ExchangeSimulator::~ExchangeSimulator() = default;
+
+void ExchangeSimulator::start() {
+    pImpl->start();
+}
+
+void ExchangeSimulator::stop() {
+    pImpl->stop();
+}
+
+uint16_t ExchangeSimulator::port() const {
+    return pImpl->boundPort;
+}
+
+std::string ExchangeSimulator::baseUrl() const {
+    return "http://127.0.0.1:" + std::to_string(pImpl->boundPort);
+}
+
+std::string ExchangeSimulator::webSocketApiUrl() const {
+    return "ws://127.0.0.1:" + std::to_string(pImpl->boundPort) + "/ws-api/v3";
+}
+
+void ExchangeSimulator::setPrice(const std::string& symbol, Decimal price) {
+    pImpl->setPrice(symbol, price);
+}
+
+Decimal ExchangeSimulator::price(const std::string& symbol) const {
+    return pImpl->price(symbol);
+}
+
+Decimal ExchangeSimulator::trade(const std::string& symbol, Decimal price, Decimal quantity) {
+    return pImpl->trade(symbol, price, quantity);
+}
+
+uint64_t ExchangeSimulator::requestCount() const {
+    return pImpl->requests;
+}
+
+uint64_t ExchangeSimulator::errorCount() const {
+    return pImpl->errors;
+}
+
+size_t ExchangeSimulator::openOrderCount() const {
+    return pImpl->openOrderCount();
+}
+
+void ExchangeSimulator::setFilters(const std::string& symbol, const SymbolFilters& filters) {
+    pImpl->setFilters(symbol, filters);
+}
+
+void ExchangeSimulator::setBalance(const std::string& asset, Decimal free) {
+    pImpl->setBalance(asset, free);
+}
+
+Decimal ExchangeSimulator::balance(const std::string& asset) const {
+    return pImpl->balance(asset);
+}
+
+void ExchangeSimulator::expireListenKeys() {
+    pImpl->expireListenKeys();
+}
+
+} // namespace binance
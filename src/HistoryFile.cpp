@@ -0,0 +1,257 @@
+#include "../include/HistoryFile.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace binance {
+
+namespace {
+
+constexpr char MAGIC[8] = {'B', 'N', 'H', 'I', 'S', 'T', '1', '\0'};
+
+struct Header {
+    char magic[8];
+    HistoryKind kind;
+    char interval[4];
+    uint64_t count;
+    char symbol[24];
+    uint8_t reserved[16];
+};
+static_assert(sizeof(Header) == 64, "history file header must be 64 bytes");
+
+constexpr size_t KLINE_COLUMNS = 7;
+
+size_t paddedBytes(size_t bytes) {
+    return (bytes + 7) & ~static_cast<size_t>(7);
+}
+
+size_t expectedLength(HistoryKind kind, size_t count) {
+    if (kind == HistoryKind::TRADES) {
+        return sizeof(Header) + 3 * count * sizeof(int64_t) + paddedBytes(count);
+    }
+    return sizeof(Header) + KLINE_COLUMNS * count * sizeof(int64_t);
+}
+
+Header makeHeader(HistoryKind kind, const std::string& symbol, const std::string& interval, size_t count) {
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.kind = kind;
+    std::memcpy(header.interval, interval.data(), std::min(interval.size(), sizeof(header.interval)));
+    header.count = count;
+    std::memcpy(header.symbol, symbol.data(), std::min(symbol.size(), sizeof(header.symbol) - 1));
+    return header;
+}
+
+// Columns are gathered one at a time so writing needs a single buffer of one column
+class ColumnWriter {
+public:
+    explicit ColumnWriter(const std::string& path) : out(path, std::ios::binary | std::ios::trunc), path(path) {
+        if (!out) {
+            throw std::runtime_error("Failed to create history file " + path);
+        }
+    }
+
+    void write(const void* data, size_t bytes) {
+        out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+    }
+
+    template <typename Event, typename Field>
+    void column(const std::vector<Event>& events, Field field) {
+        buffer.resize(events.size());
+        for (size_t i = 0; i < events.size(); ++i) {
+            buffer[i] = field(events[i]);
+        }
+        write(buffer.data(), buffer.size() * sizeof(int64_t));
+    }
+
+    void finish() {
+        out.flush();
+        if (!out) {
+            throw std::runtime_error("Failed to write history file " + path);
+        }
+    }
+
+private:
+    std::ofstream out;
+    std::string path;
+    std::vector<int64_t> buffer;
+};
+
+// Splits a CSV row in place; returns the number of fields
+size_t splitRow(const std::string& line, std::string_view* fields, size_t maxFields) {
+    size_t count = 0;
+    size_t start = 0;
+    while (count < maxFields) {
+        size_t comma = line.find(',', start);
+        size_t end = comma == std::string::npos ? line.size() : comma;
+        fields[count++] = std::string_view(line).substr(start, end - start);
+        if (comma == std::string::npos) break;
+        start = comma + 1;
+    }
+    return count;
+}
+
+int64_t parseInteger(std::string_view text) {
+    if (text.empty()) {
+        throw std::runtime_error("Empty integer field");
+    }
+    int64_t value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') {
+            throw std::runtime_error("Invalid integer field: " + std::string(text));
+        }
+        value = value * 10 + (c - '0');
+    }
+    return value;
+}
+
+// Millisecond timestamps have 13 digits until the year 2286; anything larger is in microseconds
+int64_t toMilliseconds(int64_t time) {
+    return time >= 10000000000000LL ? time / 1000 : time;
+}
+
+} // namespace
+
+HistoryFile::HistoryFile(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open history file " + path + ": " + std::strerror(errno));
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(Header)) {
+        ::close(fd);
+        throw std::runtime_error("Not a history file: " + path);
+    }
+    length_ = static_cast<size_t>(info.st_size);
+    data_ = mmap(nullptr, length_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data_ == MAP_FAILED) {
+        data_ = nullptr;
+        throw std::runtime_error("Failed to map history file " + path + ": " + std::strerror(errno));
+    }
+    // Replay reads front to back
+    madvise(data_, length_, MADV_SEQUENTIAL);
+
+    Header header;
+    std::memcpy(&header, data_, sizeof(header));
+    bool knownKind = header.kind == HistoryKind::TRADES || header.kind == HistoryKind::KLINES;
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || !knownKind ||
+        header.count > length_ || expectedLength(header.kind, header.count) != length_) {
+        munmap(data_, length_);
+        data_ = nullptr;
+        throw std::runtime_error("Not a valid history file: " + path);
+    }
+
+    kind_ = header.kind;
+    count_ = header.count;
+    symbol_.assign(header.symbol, strnlen(header.symbol, sizeof(header.symbol)));
+    interval_.assign(header.interval, strnlen(header.interval, sizeof(header.interval)));
+
+    const int64_t* column = reinterpret_cast<const int64_t*>(static_cast<const char*>(data_) + sizeof(Header));
+    if (kind_ == HistoryKind::TRADES) {
+        trades_.time = column;
+        trades_.price = column + count_;
+        trades_.quantity = column + 2 * count_;
+        trades_.buyerMaker = reinterpret_cast<const uint8_t*>(column + 3 * count_);
+    } else {
+        const int64_t** columns[KLINE_COLUMNS] = {&klines_.openTime, &klines_.closeTime, &klines_.open,
+                                                  &klines_.high, &klines_.low, &klines_.close,
+                                                  &klines_.volume};
+        for (size_t i = 0; i < KLINE_COLUMNS; ++i) {
+            *columns[i] = column + i * count_;
+        }
+    }
+}
+
+HistoryFile::~HistoryFile() {
+    if (data_) {
+        munmap(data_, length_);
+    }
+}
+
+const TradeColumns& HistoryFile::trades() const {
+    if (kind_ != HistoryKind::TRADES) {
+        throw std::runtime_error("History file holds klines, not trades");
+    }
+    return trades_;
+}
+
+const KlineColumns& HistoryFile::klines() const {
+    if (kind_ != HistoryKind::KLINES) {
+        throw std::runtime_error("History file holds trades, not klines");
+    }
+    return klines_;
+}
+
+void HistoryFile::writeTrades(const std::string& path, const std::string& symbol,
+                              const std::vector<TradeEvent>& trades) {
+    ColumnWriter writer(path);
+    Header header = makeHeader(HistoryKind::TRADES, symbol, "", trades.size());
+    writer.write(&header, sizeof(header));
+    writer.column(trades, [](const TradeEvent& t) { return t.tradeTime; });
+    writer.column(trades, [](const TradeEvent& t) { return t.price.units(); });
+    writer.column(trades, [](const TradeEvent& t) { return t.quantity.units(); });
+
+    std::vector<uint8_t> flags(paddedBytes(trades.size()), 0);
+    for (size_t i = 0; i < trades.size(); ++i) {
+        flags[i] = trades[i].isBuyerMaker ? 1 : 0;
+    }
+    writer.write(flags.data(), flags.size());
+    writer.finish();
+}
+
+void HistoryFile::writeKlines(const std::string& path, const std::string& symbol, const std::string& interval,
+                              const std::vector<KlineEvent>& klines) {
+    ColumnWriter writer(path);
+    Header header = makeHeader(HistoryKind::KLINES, symbol, interval, klines.size());
+    writer.write(&header, sizeof(header));
+    writer.column(klines, [](const KlineEvent& k) { return k.startTime; });
+    writer.column(klines, [](const KlineEvent& k) { return k.closeTime; });
+    writer.column(klines, [](const KlineEvent& k) { return k.open.units(); });
+    writer.column(klines, [](const KlineEvent& k) { return k.high.units(); });
+    writer.column(klines, [](const KlineEvent& k) { return k.low.units(); });
+    writer.column(klines, [](const KlineEvent& k) { return k.close.units(); });
+    writer.column(klines, [](const KlineEvent& k) { return k.volume.units(); });
+    writer.finish();
+}
+
+std::vector<KlineEvent> HistoryFile::readKlineCsv(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("Failed to open " + path);
+    }
+    std::vector<KlineEvent> klines;
+    std::string line;
+    std::string_view fields[7];
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty() || line[0] < '0' || line[0] > '9') {
+            continue;  // Header row
+        }
+        if (splitRow(line, fields, 7) < 7) {
+            throw std::runtime_error("Malformed kline row in " + path + ": " + line);
+        }
+        KlineEvent& kline = klines.emplace_back();
+        kline.startTime = toMilliseconds(parseInteger(fields[0]));
+        kline.open = Decimal::parse(fields[1]);
+        kline.high = Decimal::parse(fields[2]);
+        kline.low = Decimal::parse(fields[3]);
+        kline.close = Decimal::parse(fields[4]);
+        kline.volume = Decimal::parse(fields[5]);
+        kline.closeTime = toMilliseconds(parseInteger(fields[6]));
+        kline.eventTime = kline.closeTime;
+        kline.closed = true;
+    }
+    return klines;
+}
+
+} // namespace binance
@@ -3,6 +3,11 @@
 #include <sstream>
 #include <iostream>
 #include <stdexcept>
+#include <mutex>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
 
 namespace binance {
 
@@ -18,100 +23,577 @@ static size_t WriteCallback(void* contents, size_t size, size_t nmemb, std::stri
     }
 }
 
+namespace {
+
+// Case-insensitive prefix match against a lower-case literal
+bool startsWithNoCase(std::string_view text, std::string_view prefix) {
+    if (text.size() < prefix.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < prefix.size(); ++i) {
+        char c = text[i];
+        if (c >= 'A' && c <= 'Z') {
+            c = static_cast<char>(c - 'A' + 'a');
+        }
+        if (c != prefix[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Parse leading digits; returns false if there are none
+bool parseCount(std::string_view& text, int64_t& value) {
+    size_t i = 0;
+    value = 0;
+    while (i < text.size() && text[i] >= '0' && text[i] <= '9') {
+        value = value * 10 + (text[i] - '0');
+        ++i;
+    }
+    text.remove_prefix(i);
+    return i > 0;
+}
+
+// Header value after the colon, without surrounding whitespace
+std::string_view headerValue(std::string_view line, size_t colon) {
+    std::string_view value = line.substr(colon + 1);
+    while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) value.remove_prefix(1);
+    while (!value.empty() && (value.back() == '\r' || value.back() == '\n' || value.back() == ' ')) {
+        value.remove_suffix(1);
+    }
+    return value;
+}
+
+} // namespace
+
+bool ResponseInfo::parseHeader(std::string_view line) {
+    // A new status line (e.g. after a redirect) starts a new response
+    if (startsWithNoCase(line, "http/")) {
+        usageCount = 0;
+        retryAfter = -1;
+        return false;
+    }
+
+    size_t colon = line.find(':');
+    if (colon == std::string_view::npos) {
+        return false;
+    }
+
+    if (startsWithNoCase(line, "retry-after")) {
+        std::string_view value = headerValue(line, colon);
+        return parseCount(value, retryAfter);
+    }
+
+    RateLimitType type;
+    std::string_view interval;
+    if (startsWithNoCase(line, "x-mbx-used-weight-")) {
+        type = RateLimitType::REQUEST_WEIGHT;
+        interval = line.substr(18, colon - 18);
+    } else if (startsWithNoCase(line, "x-mbx-order-count-")) {
+        type = RateLimitType::ORDERS;
+        interval = line.substr(18, colon - 18);
+    } else {
+        return false;
+    }
+
+    // Intervals look like "1m", "10s" or "1d"
+    int64_t length = 0;
+    if (!parseCount(interval, length) || interval.size() != 1) {
+        return false;
+    }
+    int64_t unit = 0;
+    switch (interval[0]) {
+        case 's': case 'S': unit = 1; break;
+        case 'm': case 'M': unit = 60; break;
+        case 'h': case 'H': unit = 3600; break;
+        case 'd': case 'D': unit = 86400; break;
+        default: return false;
+    }
+
+    int64_t count = 0;
+    std::string_view value = headerValue(line, colon);
+    if (!parseCount(value, count) || usageCount >= MAX_USAGES) {
+        return false;
+    }
+    usages[usageCount++] = RateLimitUsage{type, length * unit, count};
+    return true;
+}
+
+// Callback function to capture rate-limit headers as they arrive
+static size_t HeaderCallback(char* buffer, size_t size, size_t nitems, ResponseInfo* info) {
+    size_t length = size * nitems;
+    if (info) {
+        info->parseHeader(std::string_view(buffer, length));
+    }
+    return length;
+}
+
+// Lock callbacks for the shared DNS and TLS session caches
+static void ShareLock(CURL*, curl_lock_data data, curl_lock_access, void* userptr) {
+    static_cast<std::mutex*>(userptr)[data].lock();
+}
+
+static void ShareUnlock(CURL*, curl_lock_data data, void* userptr) {
+    static_cast<std::mutex*>(userptr)[data].unlock();
+}
+
+// Value of a top-level "key": in a small JSON object, without a full parse
+static std::string_view FieldOf(std::string_view json, std::string_view key) {
+    size_t at = json.find(key);
+    while (at != std::string_view::npos) {
+        size_t colon = at + key.size();
+        if (at > 0 && json[at - 1] == '"' && colon + 1 < json.size() && json[colon] == '"') {
+            size_t start = json.find_first_not_of(" \t\r\n", colon + 1);
+            if (start == std::string_view::npos || json[start] != ':') {
+                return {};
+            }
+            start = json.find_first_not_of(" \t\r\n", start + 1);
+            if (start == std::string_view::npos) {
+                return {};
+            }
+            if (json[start] == '"') {
+                size_t end = start + 1;
+                while (end < json.size() && json[end] != '"') {
+                    end += json[end] == '\\' ? 2 : 1;
+                }
+                return end < json.size() ? json.substr(start + 1, end - start - 1) : std::string_view();
+            }
+            size_t end = json.find_first_of(",} \t\r\n", start);
+            return json.substr(start, end == std::string_view::npos ? std::string_view::npos : end - start);
+        }
+        at = json.find(key, at + 1);
+    }
+    return {};
+}
+
+// Binance error code of a body like {"code":-2010,"msg":"..."}, 0 if there is none
+static int64_t ErrorCodeOf(std::string_view body) {
+    std::string_view text = FieldOf(body, "code");
+    bool negative = !text.empty() && text[0] == '-';
+    int64_t code = 0;
+    for (size_t i = negative ? 1 : 0; i < text.size(); ++i) {
+        if (text[i] < '0' || text[i] > '9') {
+            return 0;
+        }
+        code = code * 10 + (text[i] - '0');
+    }
+    return negative ? -code : code;
+}
+
+std::string_view Response::message() const {
+    return status >= 400 ? FieldOf(body, "msg") : std::string_view();
+}
+
+void Response::clear() {
+    status = 0;
+    code = 0;
+    transportError = nullptr;
+    headers = ResponseInfo();
+    body.clear();
+}
+
+// URL path without the scheme, host or query, e.g. "/api/v3/order"
+static std::string_view PathOf(const char* url) {
+    std::string_view view(url ? url : "");
+    size_t scheme = view.find("://");
+    size_t start = view.find('/', scheme == std::string_view::npos ? 0 : scheme + 3);
+    if (start == std::string_view::npos) {
+        return "/";
+    }
+    view.remove_prefix(start);
+    return view.substr(0, view.find('?'));
+}
+
+// FNV-1a over the method and path
+static uint64_t EndpointHash(HttpMethod method, std::string_view path) {
+    uint64_t hash = 14695981039346656037ULL ^ static_cast<uint64_t>(method);
+    for (char c : path) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Counters and phase histograms of one method and path
+struct EndpointStats {
+    EndpointStats(uint64_t hash, HttpMethod method, std::string_view path)
+        : hash(hash), method(method), path(path) {}
+
+    const uint64_t hash;
+    const HttpMethod method;
+    const std::string path;
+    std::atomic<uint64_t> requests{0};
+    std::atomic<uint64_t> failures{0};
+    std::atomic<uint64_t> reusedConnections{0};
+    std::atomic<uint64_t> bytesSent{0};
+    std::atomic<uint64_t> bytesReceived{0};
+    LatencyHistogram phases[HTTP_PHASE_COUNT];
+};
+
 // Implementation for the HttpClient class using the PIMPL idiom
 class HttpClient::Impl {
 public:
-    Impl() : curl(nullptr) {}
+    Impl() : share(nullptr), poolSize(0), multi(nullptr), stopping(false) {
+        for (auto& slot : endpoints) {
+            slot.store(nullptr, std::memory_order_relaxed);
+        }
+    }
 
     ~Impl() {
-        if (curl) {
-            curl_easy_cleanup(curl);
+        stopEventLoop();
+        for (auto& slot : endpoints) {
+            delete slot.load(std::memory_order_relaxed);
+        }
+        if (defaultHeaders) {
+            curl_slist_free_all(defaultHeaders);
+        }
+        for (CURL* handle : idle) {
+            curl_easy_cleanup(handle);
+        }
+        if (share) {
+            curl_share_cleanup(share);
         }
     }
 
-    bool init() {
-        curl_global_init(CURL_GLOBAL_ALL);
-        curl = curl_easy_init();
-        return (curl != nullptr);
-    }
+    bool init(size_t size) {
+        static std::once_flag globalInit;
+        std::call_once(globalInit, []() { curl_global_init(CURL_GLOBAL_ALL); });
+
+        std::lock_guard<std::mutex> lock(poolMutex);
+        if (!share) {
+            share = curl_share_init();
+            if (!share) {
+                return false;
+            }
+            curl_share_setopt(share, CURLSHOPT_LOCKFUNC, ShareLock);
+            curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, ShareUnlock);
+            curl_share_setopt(share, CURLSHOPT_USERDATA, shareLocks);
+            curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+            curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+            // Not CURL_LOCK_DATA_CONNECT: curl does not support one connection cache used
+            // from several threads at once, so each handle keeps its own connections
+        }
 
-    std::string get(const std::string& url, const std::map<std::string, std::string>& headers) {
-        return request("GET", url, "", headers);
+        poolSize = size > 0 ? size : 1;
+        while (idle.size() < poolSize) {
+            CURL* handle = createHandle();
+            if (!handle) {
+                return false;
+            }
+            idle.push_back(handle);
+        }
+        return true;
     }
 
-    std::string post(const std::string& url, const std::string& data, 
-                    const std::map<std::string, std::string>& headers) {
-        return request("POST", url, data, headers);
+    std::future<std::string> requestAsync(HttpMethod method, const std::string& url,
+                                          const std::string& data,
+                                          const std::map<std::string, std::string>& headers,
+                                          std::function<void(bool, std::string_view)> onComplete = nullptr) {
+        std::unique_ptr<Transfer> transfer(new Transfer());
+        transfer->method = method;
+        transfer->url = url;
+        transfer->data = data;
+        transfer->onComplete = std::move(onComplete);
+        std::future<std::string> result = transfer->promise.get_future();
+
+        // Before taking a handle, so a loop that cannot start leaks nothing
+        startEventLoop();
+        transfer->curl = acquire();
+        transfer->headers = prepare(transfer->curl, method, transfer->url.c_str(),
+                                    transfer->data.data(), transfer->data.size(),
+                                    headers, transfer->response, transfer->info);
+
+        // Wait for an existing HTTP/2 connection instead of opening a new one,
+        // so a burst of requests is multiplexed onto a single connection
+        curl_easy_setopt(transfer->curl, CURLOPT_PIPEWAIT, 1L);
+        curl_easy_setopt(transfer->curl, CURLOPT_PRIVATE, transfer.get());
+
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            pending.push_back(transfer.release());
+        }
+        curl_multi_wakeup(multi);
+        return result;
     }
 
-    std::string del(const std::string& url, const std::map<std::string, std::string>& headers) {
-        return request("DELETE", url, "", headers);
+    bool warmUp(const std::string& url) {
+        // Connections live on the handles, so open one on every handle in the pool
+        std::vector<CURL*> handles;
+        {
+            std::lock_guard<std::mutex> lock(poolMutex);
+            handles.swap(idle);
+        }
+        if (handles.empty()) {
+            handles.push_back(acquire());
+        }
+
+        static const std::map<std::string, std::string> noHeaders;
+        bool connected = true;
+        for (CURL* curl : handles) {
+            std::string responseString;
+            ResponseInfo info;
+            // prepare() resets the method a previous DELETE or PUT left on the handle
+            struct curl_slist* headersList = prepare(curl, HttpMethod::GET, url.c_str(), nullptr, 0, noHeaders,
+                                                     responseString, info);
+            curl_easy_setopt(curl, CURLOPT_NOBODY, 1L);
+            connected = curl_easy_perform(curl) == CURLE_OK && connected;
+            curl_easy_setopt(curl, CURLOPT_NOBODY, 0L);
+            curl_easy_setopt(curl, CURLOPT_HTTPHEADER, nullptr);
+            curl_easy_setopt(curl, CURLOPT_WRITEDATA, nullptr);
+            curl_easy_setopt(curl, CURLOPT_HEADERDATA, nullptr);
+            if (headersList) {
+                curl_slist_free_all(headersList);
+            }
+            release(curl);
+        }
+        return connected;
     }
 
 private:
-    CURL* curl;
-    
-    std::string request(const std::string& method, const std::string& url, 
-                       const std::string& data, 
-                       const std::map<std::string, std::string>& headers) {
+    CURLSH* share;
+    std::mutex shareLocks[CURL_LOCK_DATA_LAST];
+    std::mutex poolMutex;
+    std::vector<CURL*> idle;
+    size_t poolSize;
+
+    // Options that never change between requests are set once per handle
+    CURL* createHandle() {
+        CURL* curl = curl_easy_init();
         if (!curl) {
-            throw std::runtime_error("CURL not initialized");
+            return nullptr;
         }
-        
-        curl_easy_reset(curl);
-        
-        // Set URL
-        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
 
-        // Set response callback
-        std::string responseString;
+        curl_easy_setopt(curl, CURLOPT_SHARE, share);
         curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &responseString);
+        curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, HeaderCallback);
+
+        // Set timeouts
+        curl_easy_setopt(curl, CURLOPT_TIMEOUT, 30L);  // 30 seconds timeout
+        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 10L);  // 10 seconds connect timeout
+        curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);  // Required for multi-threaded use
+
+        // Keep connections to the API host warm between orders
+        curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+        curl_easy_setopt(curl, CURLOPT_TCP_NODELAY, 1L);
+        curl_easy_setopt(curl, CURLOPT_DNS_CACHE_TIMEOUT, 300L);
+
+        // Set SSL options
+        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 1L);
+        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 2L);
+
+        // Set verbose mode for debugging (comment out in production)
+        // curl_easy_setopt(curl, CURLOPT_VERBOSE, 1L);
+
+        return curl;
+    }
+
+    CURL* acquire() {
+        {
+            std::lock_guard<std::mutex> lock(poolMutex);
+            if (!share) {
+                throw std::runtime_error("CURL not initialized");
+            }
+            if (!idle.empty()) {
+                CURL* curl = idle.back();
+                idle.pop_back();
+                return curl;
+            }
+        }
+
+        // Pool exhausted: more threads than handles, grow on demand
+        CURL* curl = createHandle();
+        if (!curl) {
+            throw std::runtime_error("Failed to create CURL handle");
+        }
+        return curl;
+    }
+
+    void release(CURL* curl) {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        if (idle.size() < poolSize * 2) {
+            idle.push_back(curl);
+            return;
+        }
+        curl_easy_cleanup(curl);
+    }
+
+    // An in-flight request owned by the event loop
+    struct Transfer {
+        HttpMethod method = HttpMethod::GET;
+        CURL* curl = nullptr;
+        struct curl_slist* headers = nullptr;
+        std::string url;
+        std::string data;
+        std::string response;
+        ResponseInfo info;
+        std::promise<std::string> promise;
+        std::function<void(bool, std::string_view)> onComplete;  // Runs before the promise is fulfilled
+    };
+
+    CURLM* multi;
+    std::thread eventLoop;
+    std::mutex queueMutex;
+    std::vector<Transfer*> pending;
+    std::atomic<bool> stopping;
+
+    // Headers sent with every request, built once
+    std::vector<std::string> defaultHeaderLines;
+    struct curl_slist* defaultHeaders = nullptr;
+    bool defaultContentType = false;
+
+    std::function<void(const ResponseInfo&)> responseObserver;
+
+    // Open-addressed by EndpointHash; an entry is published once and lives as long as the client
+    static constexpr size_t ENDPOINT_SLOTS = 64;
+    std::atomic<EndpointStats*> endpoints[ENDPOINT_SLOTS];
+
+    EndpointStats* endpointStats(HttpMethod method, std::string_view path) {
+        uint64_t hash = EndpointHash(method, path);
+        for (size_t probe = 0; probe < ENDPOINT_SLOTS; ++probe) {
+            std::atomic<EndpointStats*>& slot = endpoints[(hash + probe) % ENDPOINT_SLOTS];
+            EndpointStats* stats = slot.load(std::memory_order_acquire);
+            if (!stats) {
+                std::unique_ptr<EndpointStats> created(new EndpointStats(hash, method, path));
+                if (slot.compare_exchange_strong(stats, created.get(), std::memory_order_acq_rel)) {
+                    return created.release();
+                }
+                // Another thread filled the slot first; stats now points at its entry
+            }
+            if (stats->hash == hash && stats->method == method && stats->path == path) {
+                return stats;
+            }
+        }
+        return nullptr;
+    }
+
+    // Reads curl's timings and sizes for a finished transfer into its endpoint's histograms
+    void recordMetrics(CURL* curl, HttpMethod method, CURLcode res, long httpCode) {
+        const char* url = nullptr;
+        curl_easy_getinfo(curl, CURLINFO_EFFECTIVE_URL, &url);
+        EndpointStats* stats = endpointStats(method, PathOf(url));
+        if (!stats) {
+            return;  // More distinct endpoints than slots
+        }
 
-        // Set method and data if needed
-        if (method == "POST") {
-            curl_easy_setopt(curl, CURLOPT_POST, 1L);
-            if (!data.empty()) {
-                curl_easy_setopt(curl, CURLOPT_POSTFIELDS, data.c_str());
+        curl_off_t nameLookup = 0, connect = 0, appConnect = 0, preTransfer = 0, startTransfer = 0, total = 0;
+        curl_off_t uploaded = 0, downloaded = 0;
+        long newConnections = 0, requestSize = 0, headerSize = 0;
+        curl_easy_getinfo(curl, CURLINFO_NAMELOOKUP_TIME_T, &nameLookup);
+        curl_easy_getinfo(curl, CURLINFO_CONNECT_TIME_T, &connect);
+        curl_easy_getinfo(curl, CURLINFO_APPCONNECT_TIME_T, &appConnect);
+        curl_easy_getinfo(curl, CURLINFO_PRETRANSFER_TIME_T, &preTransfer);
+        curl_easy_getinfo(curl, CURLINFO_STARTTRANSFER_TIME_T, &startTransfer);
+        curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME_T, &total);
+        curl_easy_getinfo(curl, CURLINFO_SIZE_UPLOAD_T, &uploaded);
+        curl_easy_getinfo(curl, CURLINFO_SIZE_DOWNLOAD_T, &downloaded);
+        curl_easy_getinfo(curl, CURLINFO_NUM_CONNECTS, &newConnections);
+        curl_easy_getinfo(curl, CURLINFO_REQUEST_SIZE, &requestSize);
+        curl_easy_getinfo(curl, CURLINFO_HEADER_SIZE, &headerSize);
+
+        stats->requests.fetch_add(1, std::memory_order_relaxed);
+        if (res != CURLE_OK || httpCode >= 400) {
+            stats->failures.fetch_add(1, std::memory_order_relaxed);
+        }
+        stats->bytesSent.fetch_add(requestSize + uploaded, std::memory_order_relaxed);
+        stats->bytesReceived.fetch_add(headerSize + downloaded, std::memory_order_relaxed);
+
+        // Connection phases only mean something when a connection was opened
+        if (newConnections > 0) {
+            stats->phases[static_cast<size_t>(HttpPhase::DNS)].record(nameLookup);
+            stats->phases[static_cast<size_t>(HttpPhase::CONNECT)].record(connect - nameLookup);
+            if (appConnect > 0) {
+                stats->phases[static_cast<size_t>(HttpPhase::TLS)].record(appConnect - connect);
             }
-        } else if (method == "DELETE") {
+        } else if (res == CURLE_OK) {
+            stats->reusedConnections.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (res == CURLE_OK) {
+            stats->phases[static_cast<size_t>(HttpPhase::FIRST_BYTE)].record(startTransfer - preTransfer);
+            stats->phases[static_cast<size_t>(HttpPhase::TRANSFER)].record(total - startTransfer);
+        }
+        stats->phases[static_cast<size_t>(HttpPhase::TOTAL)].record(total);
+    }
+
+    // Sets the per-request options on a pooled handle; returns the header list to free
+    struct curl_slist* prepare(CURL* curl, HttpMethod method, const char* url,
+                               const char* data, size_t size,
+                               const std::map<std::string, std::string>& headers,
+                               std::string& responseString, ResponseInfo& info) {
+        // Set URL
+        curl_easy_setopt(curl, CURLOPT_URL, url);
+
+        // Set response callbacks
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &responseString);
+        curl_easy_setopt(curl, CURLOPT_HEADERDATA, &info);
+
+        // Set method and data; every branch overrides what a previous request left behind
+        if (method == HttpMethod::POST || method == HttpMethod::PUT) {
+            curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, method == HttpMethod::PUT ? "PUT" : nullptr);
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, static_cast<long>(size));
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDS, size > 0 ? data : "");
+        } else if (method == HttpMethod::DEL) {
+            curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
             curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "DELETE");
+        } else {
+            curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
+            curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, nullptr);
+        }
+
+        // Requests without extra headers reuse the prebuilt default list
+        if (headers.empty() && defaultHeaders) {
+            curl_easy_setopt(curl, CURLOPT_HTTPHEADER, defaultHeaders);
+            return nullptr;
         }
 
         // Set headers
         struct curl_slist* headersList = NULL;
+        for (const auto& line : defaultHeaderLines) {
+            headersList = curl_slist_append(headersList, line.c_str());
+        }
         for (const auto& header : headers) {
             std::string headerLine = header.first + ": " + header.second;
             headersList = curl_slist_append(headersList, headerLine.c_str());
         }
 
         // Always set application/json content type if not specified
-        if (headers.find("Content-Type") == headers.end()) {
+        if (!defaultContentType && headers.find("Content-Type") == headers.end()) {
             headersList = curl_slist_append(headersList, "Content-Type: application/json");
         }
 
-        if (headersList) {
-            curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headersList);
-        }
-
-        // Set timeouts
-        curl_easy_setopt(curl, CURLOPT_TIMEOUT, 30L);  // 30 seconds timeout
-        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 10L);  // 10 seconds connect timeout
+        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headersList);
+        return headersList;
+    }
 
-        // Set SSL options
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 1L);
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 2L);
+    // Returns the handle to the pool and reports the response; returns the HTTP status
+    long settle(CURL* curl, HttpMethod method, struct curl_slist* headersList, CURLcode res,
+                ResponseInfo& info) {
+        // Get response code
+        long httpCode = 0;
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpCode);
+        recordMetrics(curl, method, res, httpCode);
 
-        // Set verbose mode for debugging (comment out in production)
-        // curl_easy_setopt(curl, CURLOPT_VERBOSE, 1L);
+        // Detach per-request state before the handle goes back to the pool
+        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, nullptr);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, nullptr);
+        curl_easy_setopt(curl, CURLOPT_HEADERDATA, nullptr);
+        release(curl);
 
-        // Perform the request
-        CURLcode res = curl_easy_perform(curl);
+        // Report usage before any error is raised, so 429s are seen too
+        info.status = res == CURLE_OK ? httpCode : 0;
+        if (responseObserver) {
+            responseObserver(info);
+        }
 
         // Clean up headers
         if (headersList) {
             curl_slist_free_all(headersList);
         }
+        return httpCode;
+    }
+
+    // Settles the transfer and turns a failure into an exception
+    void finish(CURL* curl, HttpMethod method, struct curl_slist* headersList, CURLcode res,
+                const std::string& responseString, ResponseInfo& info) {
+        long httpCode = settle(curl, method, headersList, res, info);
 
         // Check for errors
         if (res != CURLE_OK) {
@@ -120,19 +602,218 @@ private:
             throw std::runtime_error(ss.str());
         }
 
-        // Get response code
-        long httpCode = 0;
-        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpCode);
-
         // Check for HTTP error
         if (httpCode >= 400) {
             std::stringstream ss;
             ss << "HTTP error " << httpCode << ": " << responseString;
             throw std::runtime_error(ss.str());
         }
+    }
+
+public:
+    std::vector<EndpointMetrics> metrics(bool reset) {
+        std::vector<EndpointMetrics> snapshot;
+        auto take = [reset](std::atomic<uint64_t>& counter) {
+            return reset ? counter.exchange(0, std::memory_order_relaxed) : counter.load(std::memory_order_relaxed);
+        };
+        std::unique_ptr<LatencyHistogram> drained(reset ? new LatencyHistogram() : nullptr);
+        for (auto& slot : endpoints) {
+            EndpointStats* stats = slot.load(std::memory_order_acquire);
+            if (!stats) {
+                continue;
+            }
+            EndpointMetrics endpoint;
+            endpoint.method = stats->method;
+            endpoint.path = stats->path;
+            endpoint.requests = take(stats->requests);
+            endpoint.failures = take(stats->failures);
+            endpoint.reusedConnections = take(stats->reusedConnections);
+            endpoint.bytesSent = take(stats->bytesSent);
+            endpoint.bytesReceived = take(stats->bytesReceived);
+            for (size_t phase = 0; phase < HTTP_PHASE_COUNT; ++phase) {
+                if (reset) {
+                    drained->reset();
+                    stats->phases[phase].drainInto(*drained);
+                    endpoint.phases[phase] = drained->summary();
+                } else {
+                    endpoint.phases[phase] = stats->phases[phase].summary();
+                }
+            }
+            snapshot.push_back(std::move(endpoint));
+        }
+        return snapshot;
+    }
+
+    void setResponseObserver(std::function<void(const ResponseInfo&)> observer) {
+        responseObserver = std::move(observer);
+    }
+
+    void setDefaultHeaders(const std::map<std::string, std::string>& headers) {
+        if (defaultHeaders) {
+            curl_slist_free_all(defaultHeaders);
+            defaultHeaders = nullptr;
+        }
+        defaultHeaderLines.clear();
+        defaultContentType = headers.find("Content-Type") != headers.end();
+
+        for (const auto& header : headers) {
+            defaultHeaderLines.push_back(header.first + ": " + header.second);
+        }
+        if (!defaultContentType) {
+            defaultHeaderLines.push_back("Content-Type: application/json");
+            defaultContentType = true;
+        }
+        for (const auto& line : defaultHeaderLines) {
+            defaultHeaders = curl_slist_append(defaultHeaders, line.c_str());
+        }
+    }
+
+    std::string request(HttpMethod method, const char* url, const char* data, size_t size,
+                        const std::map<std::string, std::string>& headers) {
+        CURL* curl = acquire();
+
+        std::string responseString;
+        ResponseInfo info;
+        struct curl_slist* headersList = prepare(curl, method, url, data, size, headers, responseString, info);
+
+        // Perform the request
+        CURLcode res = curl_easy_perform(curl);
 
+        finish(curl, method, headersList, res, responseString, info);
         return responseString;
     }
+
+    bool tryRequest(HttpMethod method, const char* url, const char* data, size_t size,
+                    const std::map<std::string, std::string>& headers, Response& response) {
+        response.clear();
+        CURL* curl = acquire();
+        struct curl_slist* headersList = prepare(curl, method, url, data, size, headers,
+                                                 response.body, response.headers);
+        CURLcode res = curl_easy_perform(curl);
+        long httpCode = settle(curl, method, headersList, res, response.headers);
+
+        if (res != CURLE_OK) {
+            response.transportError = curl_easy_strerror(res);
+            return false;
+        }
+        response.status = httpCode;
+        if (httpCode >= 400) {
+            response.code = ErrorCodeOf(response.body);
+        }
+        return response.ok();
+    }
+
+private:
+    void complete(Transfer* transfer, CURLcode res) {
+        std::unique_ptr<Transfer> owned(transfer);
+        CURL* curl = transfer->curl;
+        curl_easy_setopt(curl, CURLOPT_PIPEWAIT, 0L);
+        curl_easy_setopt(curl, CURLOPT_PRIVATE, nullptr);
+        std::exception_ptr error;
+        try {
+            finish(curl, transfer->method, transfer->headers, res, transfer->response, transfer->info);
+        } catch (...) {
+            error = std::current_exception();
+        }
+        if (transfer->onComplete) {
+            try {
+                transfer->onComplete(!error, transfer->response);
+            } catch (...) {
+                // A hook must not take the event loop down
+            }
+        }
+        if (error) {
+            transfer->promise.set_exception(error);
+        } else {
+            transfer->promise.set_value(std::move(transfer->response));
+        }
+    }
+
+    void startEventLoop() {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (stopping) {
+            throw std::runtime_error("HTTP client is shutting down");
+        }
+        if (multi) {
+            return;
+        }
+        multi = curl_multi_init();
+        if (!multi) {
+            throw std::runtime_error("Failed to create CURL multi handle");
+        }
+        curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+        eventLoop = std::thread(&Impl::runEventLoop, this);
+    }
+
+    void stopEventLoop() {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            if (!multi) {
+                return;
+            }
+            stopping = true;
+        }
+        curl_multi_wakeup(multi);
+        eventLoop.join();
+        curl_multi_cleanup(multi);
+        multi = nullptr;
+    }
+
+    void runEventLoop() {
+        std::vector<Transfer*> active;
+        std::vector<Transfer*> incoming;
+
+        while (!stopping) {
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                incoming.swap(pending);
+            }
+            for (Transfer* transfer : incoming) {
+                curl_multi_add_handle(multi, transfer->curl);
+                active.push_back(transfer);
+            }
+            incoming.clear();
+
+            int running = 0;
+            curl_multi_perform(multi, &running);
+
+            CURLMsg* msg;
+            int queued = 0;
+            while ((msg = curl_multi_info_read(multi, &queued))) {
+                if (msg->msg != CURLMSG_DONE) {
+                    continue;
+                }
+                CURL* curl = msg->easy_handle;
+                CURLcode res = msg->data.result;
+                Transfer* transfer = nullptr;
+                curl_easy_getinfo(curl, CURLINFO_PRIVATE, &transfer);
+                curl_multi_remove_handle(multi, curl);
+                active.erase(std::find(active.begin(), active.end(), transfer));
+                complete(transfer, res);
+            }
+
+            curl_multi_poll(multi, nullptr, 0, 1000, nullptr);
+        }
+
+        // Fail whatever is still queued or in flight. Hooks run outside the
+        // lock, so one that sends another request is refused, not deadlocked;
+        // repeat for requests queued just before the loop began to stop
+        while (true) {
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                active.insert(active.end(), pending.begin(), pending.end());
+                pending.clear();
+            }
+            if (active.empty()) {
+                break;
+            }
+            for (Transfer* transfer : active) {
+                curl_multi_remove_handle(multi, transfer->curl);
+                complete(transfer, CURLE_ABORTED_BY_CALLBACK);
+            }
+            active.clear();
+        }
+    }
 };
 
 // HttpClient implementation
@@ -140,21 +821,68 @@ HttpClient::HttpClient() : pImpl(new Impl()) {}
 
 HttpClient::~HttpClient() = default;
 
-bool HttpClient::init() {
-    return pImpl->init();
+bool HttpClient::init(size_t poolSize) {
+    return pImpl->init(poolSize);
+}
+
+bool HttpClient::warmUp(const std::string& url) {
+    return pImpl->warmUp(url);
+}
+
+void HttpClient::setDefaultHeaders(const std::map<std::string, std::string>& headers) {
+    pImpl->setDefaultHeaders(headers);
+}
+
+void HttpClient::setResponseObserver(std::function<void(const ResponseInfo&)> observer) {
+    pImpl->setResponseObserver(std::move(observer));
 }
 
 std::string HttpClient::get(const std::string& url, const std::map<std::string, std::string>& headers) {
-    return pImpl->get(url, headers);
+    return pImpl->request(HttpMethod::GET, url.c_str(), nullptr, 0, headers);
 }
 
-std::string HttpClient::post(const std::string& url, const std::string& data, 
+std::string HttpClient::post(const std::string& url, const std::string& data,
                            const std::map<std::string, std::string>& headers) {
-    return pImpl->post(url, data, headers);
+    return pImpl->request(HttpMethod::POST, url.c_str(), data.data(), data.size(), headers);
 }
 
 std::string HttpClient::del(const std::string& url, const std::map<std::string, std::string>& headers) {
-    return pImpl->del(url, headers);
+    return pImpl->request(HttpMethod::DEL, url.c_str(), nullptr, 0, headers);
+}
+
+std::string HttpClient::request(HttpMethod method, const char* url, const char* data, size_t size) {
+    static const std::map<std::string, std::string> noHeaders;
+    return pImpl->request(method, url, data, size, noHeaders);
+}
+
+std::vector<EndpointMetrics> HttpClient::metrics(bool reset) {
+    return pImpl->metrics(reset);
+}
+
+bool HttpClient::tryRequest(HttpMethod method, const char* url, Response& response, const char* data, size_t size) {
+    static const std::map<std::string, std::string> noHeaders;
+    return pImpl->tryRequest(method, url, data, size, noHeaders, response);
+}
+
+std::future<std::string> HttpClient::getAsync(const std::string& url,
+                                              const std::map<std::string, std::string>& headers) {
+    return pImpl->requestAsync(HttpMethod::GET, url, "", headers);
+}
+
+std::future<std::string> HttpClient::postAsync(const std::string& url, const std::string& data,
+                                               const std::map<std::string, std::string>& headers) {
+    return pImpl->requestAsync(HttpMethod::POST, url, data, headers);
+}
+
+std::future<std::string> HttpClient::delAsync(const std::string& url,
+                                              const std::map<std::string, std::string>& headers) {
+    return pImpl->requestAsync(HttpMethod::DEL, url, "", headers);
+}
+
+std::future<std::string> HttpClient::requestAsync(HttpMethod method, const std::string& url,
+                                                  const std::string& data, std::function<void(bool, std::string_view)> onComplete) {
+    static const std::map<std::string, std::string> noHeaders;
+    return pImpl->requestAsync(method, url, data, noHeaders, std::move(onComplete));
 }
 
 } // namespace binance
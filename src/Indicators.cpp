@@ -0,0 +1,505 @@
+#include "../include/Indicators.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define BINANCE_INDICATORS_X86 1
+#include <immintrin.h>
+#endif
+
+namespace binance {
+
+namespace {
+
+// Decayed weights below this no longer change a double result; stopping
+// there also keeps the loops out of denormal arithmetic
+constexpr double NEGLIGIBLE_WEIGHT = 1e-30;
+
+size_t checkedPeriod(size_t period) {
+    if (period == 0) {
+        throw std::invalid_argument("Indicator period must be positive");
+    }
+    return period;
+}
+
+double sumScalar(const double* values, size_t count) {
+    double total = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        total += values[i];
+    }
+    return total;
+}
+
+double sumSquaredDeviationsScalar(const double* values, size_t count, double mean) {
+    double total = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        double deviation = values[i] - mean;
+        total += deviation * deviation;
+    }
+    return total;
+}
+
+double dotScalar(const double* a, const double* b, size_t count) {
+    double total = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        total += a[i] * b[i];
+    }
+    return total;
+}
+
+double decayedSumScalar(const double* values, size_t count, double decay) {
+    double total = 0.0;
+    double weight = 1.0;
+    for (size_t i = count; i-- > 0 && weight > NEGLIGIBLE_WEIGHT;) {
+        total += weight * values[i];
+        weight *= decay;
+    }
+    return total;
+}
+
+void decayedGainLossScalar(const double* prices, size_t count, double decay, double& gains, double& losses) {
+    gains = 0.0;
+    losses = 0.0;
+    double weight = 1.0;
+    for (size_t i = count; i-- > 1 && weight > NEGLIGIBLE_WEIGHT;) {
+        double change = prices[i] - prices[i - 1];
+        gains += weight * std::max(change, 0.0);
+        losses += weight * std::max(-change, 0.0);
+        weight *= decay;
+    }
+}
+
+#ifdef BINANCE_INDICATORS_X86
+bool cpuHasAvx2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+const bool useAvx2 = cpuHasAvx2();
+
+__attribute__((target("avx2")))
+double horizontalSum(__m256d v) {
+    __m128d low = _mm256_castpd256_pd128(v);
+    __m128d high = _mm256_extractf128_pd(v, 1);
+    low = _mm_add_pd(low, high);
+    return _mm_cvtsd_f64(_mm_add_sd(low, _mm_unpackhi_pd(low, low)));
+}
+
+// Two accumulators of four lanes hide the latency of the adds
+__attribute__((target("avx2")))
+double sumAvx2(const double* values, size_t count) {
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(values + i));
+        acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(values + i + 4));
+    }
+    double total = horizontalSum(_mm256_add_pd(acc0, acc1));
+    return total + sumScalar(values + i, count - i);
+}
+
+__attribute__((target("avx2")))
+double sumSquaredDeviationsAvx2(const double* values, size_t count, double mean) {
+    const __m256d center = _mm256_set1_pd(mean);
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256d d0 = _mm256_sub_pd(_mm256_loadu_pd(values + i), center);
+        __m256d d1 = _mm256_sub_pd(_mm256_loadu_pd(values + i + 4), center);
+        acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(d0, d0));
+        acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(d1, d1));
+    }
+    double total = horizontalSum(_mm256_add_pd(acc0, acc1));
+    return total + sumSquaredDeviationsScalar(values + i, count - i, mean);
+}
+
+__attribute__((target("avx2")))
+double dotAvx2(const double* a, const double* b, size_t count) {
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+        acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4)));
+    }
+    double total = horizontalSum(_mm256_add_pd(acc0, acc1));
+    return total + dotScalar(a + i, b + i, count - i);
+}
+
+// Walks back from the newest value four at a time; lane j of the weight
+// vector holds decay^(3 - j) times the decay of the block
+__attribute__((target("avx2")))
+double decayedSumAvx2(const double* values, size_t count, double decay) {
+    const double decay2 = decay * decay;
+    const __m256d step = _mm256_set1_pd(decay2 * decay2);
+    __m256d weights = _mm256_setr_pd(decay2 * decay, decay2, decay, 1.0);
+    __m256d acc = _mm256_setzero_pd();
+    double blockWeight = 1.0;
+    size_t end = count;
+    while (end >= 4 && blockWeight > NEGLIGIBLE_WEIGHT) {
+        end -= 4;
+        acc = _mm256_add_pd(acc, _mm256_mul_pd(weights, _mm256_loadu_pd(values + end)));
+        weights = _mm256_mul_pd(weights, step);
+        blockWeight *= decay2 * decay2;
+    }
+    double total = horizontalSum(acc);
+    if (blockWeight > NEGLIGIBLE_WEIGHT && end > 0) {
+        total += blockWeight * decayedSumScalar(values, end, decay);
+    }
+    return total;
+}
+
+__attribute__((target("avx2")))
+void decayedGainLossAvx2(const double* prices, size_t count, double decay, double& gains, double& losses) {
+    const double decay2 = decay * decay;
+    const __m256d step = _mm256_set1_pd(decay2 * decay2);
+    const __m256d zero = _mm256_setzero_pd();
+    __m256d weights = _mm256_setr_pd(decay2 * decay, decay2, decay, 1.0);
+    __m256d gainAcc = zero;
+    __m256d lossAcc = zero;
+    double blockWeight = 1.0;
+    size_t end = count;  // Changes end..count-1 are done; change i is prices[i] - prices[i - 1]
+    while (end >= 5 && blockWeight > NEGLIGIBLE_WEIGHT) {
+        end -= 4;
+        __m256d change = _mm256_sub_pd(_mm256_loadu_pd(prices + end), _mm256_loadu_pd(prices + end - 1));
+        gainAcc = _mm256_add_pd(gainAcc, _mm256_mul_pd(weights, _mm256_max_pd(change, zero)));
+        lossAcc = _mm256_add_pd(lossAcc, _mm256_mul_pd(weights, _mm256_max_pd(_mm256_sub_pd(zero, change), zero)));
+        weights = _mm256_mul_pd(weights, step);
+        blockWeight *= decay2 * decay2;
+    }
+    gains = horizontalSum(gainAcc);
+    losses = horizontalSum(lossAcc);
+    if (blockWeight > NEGLIGIBLE_WEIGHT && end > 1) {
+        double headGains;
+        double headLosses;
+        decayedGainLossScalar(prices, end, decay, headGains, headLosses);
+        gains += blockWeight * headGains;
+        losses += blockWeight * headLosses;
+    }
+}
+#endif
+
+} // namespace
+
+namespace indicators {
+
+double sum(const double* values, size_t count) {
+#ifdef BINANCE_INDICATORS_X86
+    if (useAvx2) return sumAvx2(values, count);
+#endif
+    return sumScalar(values, count);
+}
+
+double sumSquaredDeviations(const double* values, size_t count, double mean) {
+#ifdef BINANCE_INDICATORS_X86
+    if (useAvx2) return sumSquaredDeviationsAvx2(values, count, mean);
+#endif
+    return sumSquaredDeviationsScalar(values, count, mean);
+}
+
+double dot(const double* a, const double* b, size_t count) {
+#ifdef BINANCE_INDICATORS_X86
+    if (useAvx2) return dotAvx2(a, b, count);
+#endif
+    return dotScalar(a, b, count);
+}
+
+double decayedSum(const double* values, size_t count, double decay) {
+#ifdef BINANCE_INDICATORS_X86
+    if (useAvx2) return decayedSumAvx2(values, count, decay);
+#endif
+    return decayedSumScalar(values, count, decay);
+}
+
+void decayedGainLoss(const double* prices, size_t count, double decay, double& gains, double& losses) {
+#ifdef BINANCE_INDICATORS_X86
+    if (useAvx2) {
+        decayedGainLossAvx2(prices, count, decay, gains, losses);
+        return;
+    }
+#endif
+    decayedGainLossScalar(prices, count, decay, gains, losses);
+}
+
+} // namespace indicators
+
+// RollingWindow
+
+RollingWindow::RollingWindow(size_t capacity) : values_(checkedPeriod(capacity)) {}
+
+void RollingWindow::assign(const double* values, size_t count) {
+    size_t kept = std::min(count, values_.size());
+    std::copy(values + count - kept, values + count, values_.begin());
+    size_ = kept;
+    next_ = kept == values_.size() ? 0 : kept;
+}
+
+// SMA
+
+SMA::SMA(size_t period) : window_(period) {}
+
+void SMA::update(double value) {
+    double evicted;
+    if (window_.push(value, evicted)) {
+        sum_.add(value - evicted);
+    } else {
+        sum_.add(value);
+    }
+}
+
+void SMA::warmUp(const double* values, size_t count) {
+    if (count < period()) {
+        for (size_t i = 0; i < count; ++i) {
+            update(values[i]);
+        }
+        return;
+    }
+    const double* last = values + count - period();
+    window_.assign(last, period());
+    sum_.set(indicators::sum(last, period()));
+}
+
+void SMA::reset() {
+    window_.clear();
+    sum_.set(0.0);
+}
+
+// EMA
+
+EMA::EMA(size_t period) : period_(checkedPeriod(period)), alpha_(2.0 / (static_cast<double>(period) + 1.0)) {}
+
+void EMA::update(double value) {
+    if (seeded_) {
+        value_ += alpha_ * (value - value_);
+        return;
+    }
+    seedSum_ += value;
+    if (++count_ == period_) {
+        value_ = seedSum_ / static_cast<double>(period_);
+        seeded_ = true;
+    }
+}
+
+void EMA::warmUp(const double* values, size_t count) {
+    size_t i = 0;
+    if (!seeded_) {
+        size_t take = std::min(period_ - count_, count);
+        seedSum_ += indicators::sum(values, take);
+        count_ += take;
+        i = take;
+        if (count_ == period_) {
+            value_ = seedSum_ / static_cast<double>(period_);
+            seeded_ = true;
+        }
+    }
+    if (i < count) {
+        // e_m = (1 - a)^m e_0 + a * sum over k of (1 - a)^(m - k) x_k
+        size_t m = count - i;
+        double decay = 1.0 - alpha_;
+        value_ = std::pow(decay, static_cast<double>(m)) * value_ +
+                 alpha_ * indicators::decayedSum(values + i, m, decay);
+    }
+}
+
+void EMA::reset() {
+    value_ = 0.0;
+    seedSum_ = 0.0;
+    count_ = 0;
+    seeded_ = false;
+}
+
+// VWAP
+
+VWAP::VWAP(size_t period) : prices_(period), quantities_(period) {}
+
+void VWAP::update(double price, double quantity) {
+    double evictedPrice;
+    double evictedQuantity;
+    prices_.push(price, evictedPrice);
+    if (quantities_.push(quantity, evictedQuantity)) {
+        notional_.add(price * quantity - evictedPrice * evictedQuantity);
+        volume_.add(quantity - evictedQuantity);
+    } else {
+        notional_.add(price * quantity);
+        volume_.add(quantity);
+    }
+}
+
+void VWAP::warmUp(const double* prices, const double* quantities, size_t count) {
+    size_t period = quantities_.capacity();
+    if (count < period) {
+        for (size_t i = 0; i < count; ++i) {
+            update(prices[i], quantities[i]);
+        }
+        return;
+    }
+    size_t first = count - period;
+    prices_.assign(prices + first, period);
+    quantities_.assign(quantities + first, period);
+    notional_.set(indicators::dot(prices + first, quantities + first, period));
+    volume_.set(indicators::sum(quantities + first, period));
+}
+
+double VWAP::value() const {
+    double volume = volume_.value();
+    return volume > 0.0 ? notional_.value() / volume : 0.0;
+}
+
+void VWAP::reset() {
+    prices_.clear();
+    quantities_.clear();
+    notional_.set(0.0);
+    volume_.set(0.0);
+}
+
+// RollingVariance
+
+RollingVariance::RollingVariance(size_t period) : window_(period) {}
+
+void RollingVariance::update(double value) {
+    double evicted;
+    if (!window_.push(value, evicted)) {
+        double delta = value - mean_;
+        mean_ += delta / static_cast<double>(window_.size());
+        m2_ += delta * (value - mean_);
+        return;
+    }
+    double oldMean = mean_;
+    mean_ += (value - evicted) / static_cast<double>(window_.size());
+    m2_ += (value - evicted) * (value - mean_ + evicted - oldMean);
+    if (m2_ < 0.0) {
+        m2_ = 0.0;  // Rounding when the window is (nearly) constant
+    }
+}
+
+void RollingVariance::warmUp(const double* values, size_t count) {
+    if (count < period()) {
+        for (size_t i = 0; i < count; ++i) {
+            update(values[i]);
+        }
+        return;
+    }
+    const double* last = values + count - period();
+    window_.assign(last, period());
+    mean_ = indicators::sum(last, period()) / static_cast<double>(period());
+    m2_ = indicators::sumSquaredDeviations(last, period(), mean_);
+}
+
+double RollingVariance::variance() const {
+    return window_.size() ? m2_ / static_cast<double>(window_.size()) : 0.0;
+}
+
+double RollingVariance::sampleVariance() const {
+    return window_.size() > 1 ? m2_ / static_cast<double>(window_.size() - 1) : 0.0;
+}
+
+double RollingVariance::stddev() const {
+    return std::sqrt(variance());
+}
+
+void RollingVariance::reset() {
+    window_.clear();
+    mean_ = 0.0;
+    m2_ = 0.0;
+}
+
+// BollingerBands
+
+BollingerBands::BollingerBands(size_t period, double width) : stats_(period), width_(width) {}
+
+double BollingerBands::percentB(double value) const {
+    double range = upper() - lower();
+    return range > 0.0 ? (value - lower()) / range : 0.5;
+}
+
+// RSI
+
+RSI::RSI(size_t period) : period_(checkedPeriod(period)) {}
+
+void RSI::update(double price) {
+    if (!hasPrice_) {
+        lastPrice_ = price;
+        hasPrice_ = true;
+        return;
+    }
+    double change = price - lastPrice_;
+    lastPrice_ = price;
+    double gain = std::max(change, 0.0);
+    double loss = std::max(-change, 0.0);
+    if (seeded_) {
+        double weight = static_cast<double>(period_ - 1);
+        averageGain_ = (averageGain_ * weight + gain) / static_cast<double>(period_);
+        averageLoss_ = (averageLoss_ * weight + loss) / static_cast<double>(period_);
+        return;
+    }
+    averageGain_ += gain;
+    averageLoss_ += loss;
+    if (++changes_ == period_) {
+        averageGain_ /= static_cast<double>(period_);
+        averageLoss_ /= static_cast<double>(period_);
+        seeded_ = true;
+    }
+}
+
+void RSI::warmUp(const double* prices, size_t count) {
+    if (count == 0) {
+        return;
+    }
+    // After this, prices[i - 1] is always the last price seen
+    update(prices[0]);
+    size_t i = 1;
+
+    if (!seeded_ && i < count) {
+        size_t take = std::min(period_ - changes_, count - i);
+        double gains;
+        double losses;
+        indicators::decayedGainLoss(prices + i - 1, take + 1, 1.0, gains, losses);
+        averageGain_ += gains;
+        averageLoss_ += losses;
+        changes_ += take;
+        i += take;
+        if (changes_ == period_) {
+            averageGain_ /= static_cast<double>(period_);
+            averageLoss_ /= static_cast<double>(period_);
+            seeded_ = true;
+        }
+    }
+
+    if (seeded_ && i < count) {
+        // Wilder's smoothing is an EMA with weight 1 / period
+        size_t m = count - i;
+        double alpha = 1.0 / static_cast<double>(period_);
+        double decay = 1.0 - alpha;
+        double gains;
+        double losses;
+        indicators::decayedGainLoss(prices + i - 1, m + 1, decay, gains, losses);
+        double carried = std::pow(decay, static_cast<double>(m));
+        averageGain_ = carried * averageGain_ + alpha * gains;
+        averageLoss_ = carried * averageLoss_ + alpha * losses;
+    }
+    lastPrice_ = prices[count - 1];
+}
+
+double RSI::value() const {
+    if (!seeded_) {
+        return 50.0;
+    }
+    if (averageLoss_ == 0.0) {
+        return averageGain_ == 0.0 ? 50.0 : 100.0;
+    }
+    return 100.0 - 100.0 / (1.0 + averageGain_ / averageLoss_);
+}
+
+void RSI::reset() {
+    averageGain_ = 0.0;
+    averageLoss_ = 0.0;
+    lastPrice_ = 0.0;
+    changes_ = 0;
+    hasPrice_ = false;
+    seeded_ = false;
+}
+
+} // namespace binance
@@ -0,0 +1,187 @@
+#include "../include/JsonReader.h"
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace binance {
+
+JsonReader::JsonReader(std::string_view json)
+    : begin_(json.data()), pos_(json.data()), end_(json.data() + json.size()) {
+}
+
+void JsonReader::fail(const char* what) const {
+    throw std::runtime_error("JSON parse error at offset " + std::to_string(offset()) + ": " + what);
+}
+
+void JsonReader::skipWhitespace() {
+    while (pos_ < end_ && (*pos_ == ' ' || *pos_ == '\n' || *pos_ == '\r' || *pos_ == '\t')) {
+        ++pos_;
+    }
+}
+
+char JsonReader::peek() {
+    skipWhitespace();
+    return pos_ < end_ ? *pos_ : '\0';
+}
+
+void JsonReader::expect(char c) {
+    if (peek() != c) {
+        char what[] = "expected ' '";
+        what[10] = c;
+        fail(what);
+    }
+    ++pos_;
+}
+
+const char* JsonReader::findStringEnd(const char* open) const {
+    // Jump from quote to quote; a quote preceded by an odd run of
+    // backslashes is escaped and does not end the string
+    const char* p = open + 1;
+    for (;;) {
+        const char* quote = static_cast<const char*>(std::memchr(p, '"', end_ - p));
+        if (!quote) {
+            fail("unterminated string");
+        }
+        size_t backslashes = 0;
+        for (const char* q = quote; q > open + 1 && q[-1] == '\\'; --q) {
+            ++backslashes;
+        }
+        if (backslashes % 2 == 0) {
+            return quote;
+        }
+        p = quote + 1;
+    }
+}
+
+void JsonReader::beginObject() {
+    expect('{');
+}
+
+bool JsonReader::nextKey(std::string_view& key) {
+    char c = peek();
+    if (c == '}') {
+        ++pos_;
+        return false;
+    }
+    if (c == ',') {
+        ++pos_;
+    }
+    key = readString();
+    expect(':');
+    return true;
+}
+
+void JsonReader::beginArray() {
+    expect('[');
+}
+
+bool JsonReader::nextElement() {
+    char c = peek();
+    if (c == ']') {
+        ++pos_;
+        return false;
+    }
+    if (c == ',') {
+        ++pos_;
+        skipWhitespace();
+    }
+    if (pos_ >= end_) {
+        fail("unterminated array");
+    }
+    return true;
+}
+
+std::string_view JsonReader::readString() {
+    if (peek() != '"') {
+        fail("expected string");
+    }
+    const char* close = findStringEnd(pos_);
+    std::string_view value(pos_ + 1, close - pos_ - 1);
+    pos_ = close + 1;
+    return value;
+}
+
+std::string_view JsonReader::readToken() {
+    const char* start = pos_;
+    while (pos_ < end_ && *pos_ != ',' && *pos_ != '}' && *pos_ != ']' &&
+           *pos_ != ' ' && *pos_ != '\n' && *pos_ != '\r' && *pos_ != '\t') {
+        ++pos_;
+    }
+    if (pos_ == start) {
+        fail("expected value");
+    }
+    return std::string_view(start, pos_ - start);
+}
+
+std::string_view JsonReader::readScalar() {
+    char c = peek();
+    if (c == '"') {
+        return readString();
+    }
+    if (c == '{' || c == '[') {
+        fail("expected scalar");
+    }
+    return readToken();
+}
+
+int64_t JsonReader::readInt() {
+    std::string_view text = readScalar();
+    int64_t value = 0;
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (result.ec != std::errc() || result.ptr != text.data() + text.size()) {
+        fail("expected integer");
+    }
+    return value;
+}
+
+bool JsonReader::readBool() {
+    std::string_view text = readScalar();
+    if (text == "true") {
+        return true;
+    }
+    if (text != "false") {
+        fail("expected boolean");
+    }
+    return false;
+}
+
+bool JsonReader::readNull() {
+    if (peek() == 'n' && end_ - pos_ >= 4 && std::memcmp(pos_, "null", 4) == 0) {
+        pos_ += 4;
+        return true;
+    }
+    return false;
+}
+
+void JsonReader::skipValue() {
+    char c = peek();
+    if (c == '"') {
+        pos_ = findStringEnd(pos_) + 1;
+        return;
+    }
+    if (c != '{' && c != '[') {
+        readToken();
+        return;
+    }
+
+    // Nested containers only need their brackets balanced; strings are
+    // jumped over so brackets inside them do not count
+    size_t depth = 0;
+    while (pos_ < end_) {
+        char ch = *pos_;
+        if (ch == '"') {
+            pos_ = findStringEnd(pos_) + 1;
+            continue;
+        }
+        ++pos_;
+        if (ch == '{' || ch == '[') {
+            ++depth;
+        } else if ((ch == '}' || ch == ']') && --depth == 0) {
+            return;
+        }
+    }
+    fail("unterminated container");
+}
+
+} // namespace binance
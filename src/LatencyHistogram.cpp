@@ -0,0 +1,107 @@
+#include "../include/LatencyHistogram.h"
+#include <cmath>
+
+namespace binance {
+
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+void LatencyHistogram::add(const LatencyHistogram& other) {
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        uint64_t count = other.counts_[i].load(std::memory_order_relaxed);
+        if (count != 0) {
+            counts_[i].fetch_add(count, std::memory_order_relaxed);
+        }
+    }
+    total_.fetch_add(other.total_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    sum_.fetch_add(other.sum_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    uint64_t otherMax = other.max_.load(std::memory_order_relaxed);
+    uint64_t seen = max_.load(std::memory_order_relaxed);
+    while (otherMax > seen && !max_.compare_exchange_weak(seen, otherMax, std::memory_order_relaxed)) {
+    }
+}
+
+void LatencyHistogram::drainInto(LatencyHistogram& target) {
+    // The maximum cannot be split between two histograms, so the target
+    // takes it and this one starts over from the values recorded from now on
+    uint64_t drainedMax = max_.exchange(0, std::memory_order_relaxed);
+    uint64_t drained = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        if (counts_[i].load(std::memory_order_relaxed) == 0) {
+            continue;
+        }
+        uint64_t count = counts_[i].exchange(0, std::memory_order_acquire);
+        target.counts_[i].fetch_add(count, std::memory_order_relaxed);
+        drained += count;
+    }
+    // Totals follow the buckets, so a value recorded mid-drain is never counted twice
+    total_.fetch_sub(drained, std::memory_order_relaxed);
+    target.total_.fetch_add(drained, std::memory_order_relaxed);
+    uint64_t drainedSum = sum_.exchange(0, std::memory_order_relaxed);
+    target.sum_.fetch_add(drainedSum, std::memory_order_relaxed);
+    if (drainedMax > target.max_.load(std::memory_order_relaxed)) {
+        target.max_.store(drainedMax, std::memory_order_relaxed);
+    }
+}
+
+void LatencyHistogram::reset() {
+    for (auto& count : counts_) {
+        count.store(0, std::memory_order_relaxed);
+    }
+    total_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+double LatencyHistogram::mean() const {
+    uint64_t total = count();
+    return total == 0 ? 0.0 : static_cast<double>(sum_.load(std::memory_order_relaxed)) / total;
+}
+
+int64_t LatencyHistogram::valueAtPercentile(double percentile) const {
+    // Rank against the buckets themselves, which may run ahead of total_ during a record()
+    uint64_t total = 0;
+    for (const auto& count : counts_) {
+        total += count.load(std::memory_order_relaxed);
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    double clamped = percentile < 0.0 ? 0.0 : percentile > 100.0 ? 100.0 : percentile;
+    uint64_t rank = static_cast<uint64_t>(std::ceil(clamped / 100.0 * total));
+    rank = rank == 0 ? 1 : rank;
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        seen += counts_[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            int64_t highest = highestInBucket(i);
+            return highest < max() ? highest : max();
+        }
+    }
+    return max();
+}
+
+LatencySummary LatencyHistogram::summary() const {
+    LatencySummary summary;
+    summary.count = count();
+    summary.mean = mean();
+    summary.p50 = valueAtPercentile(50.0);
+    summary.p99 = valueAtPercentile(99.0);
+    summary.p999 = valueAtPercentile(99.9);
+    summary.max = max();
+    return summary;
+}
+
+int64_t LatencyHistogram::highestInBucket(size_t bucket) {
+    if (bucket < 2 * SUB_BUCKET_COUNT) {
+        return static_cast<int64_t>(bucket);
+    }
+    size_t shift = bucket / SUB_BUCKET_COUNT - 1;
+    uint64_t top = bucket - shift * SUB_BUCKET_COUNT;
+    return static_cast<int64_t>(((top + 1) << shift) - 1);
+}
+
+} // namespace binance
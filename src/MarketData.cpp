@@ -0,0 +1,243 @@
+#include "../include/MarketData.h"
+#include "../include/JsonReader.h"
+#include <algorithm>
+#include <cstring>
+
+namespace binance {
+
+void SymbolName::assign(std::string_view symbol) {
+    size_t length = std::min(symbol.size(), CAPACITY);
+    for (size_t i = 0; i < length; ++i) {
+        char c = symbol[i];
+        data[i] = (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+    }
+    data[length] = '\0';
+}
+
+namespace {
+
+enum class StreamKind {
+    UNKNOWN,
+    TRADE,
+    BOOK_TICKER,
+    DIFF_DEPTH,
+    PARTIAL_DEPTH,
+    KLINE
+};
+
+// Classify a stream name such as "btcusdt@depth20@100ms"; symbol receives the part before '@'
+StreamKind classifyStream(std::string_view stream, std::string_view& symbol) {
+    size_t at = stream.find('@');
+    if (at == std::string_view::npos) {
+        return StreamKind::UNKNOWN;
+    }
+    symbol = stream.substr(0, at);
+    std::string_view type = stream.substr(at + 1);
+    if (type == "trade") return StreamKind::TRADE;
+    if (type == "bookTicker") return StreamKind::BOOK_TICKER;
+    if (type.substr(0, 6) == "kline_") return StreamKind::KLINE;
+    if (type.substr(0, 5) == "depth") {
+        return type.size() > 5 && type[5] >= '0' && type[5] <= '9' ? StreamKind::PARTIAL_DEPTH
+                                                                     : StreamKind::DIFF_DEPTH;
+    }
+    return StreamKind::UNKNOWN;
+}
+
+Decimal readDecimal(JsonReader& reader) {
+    return Decimal::parse(reader.readScalar());
+}
+
+void readTrade(JsonReader& reader, TradeEvent& trade) {
+    reader.beginObject();
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key == "E") trade.eventTime = reader.readInt();
+        else if (key == "s") trade.symbol.assign(reader.readString());
+        else if (key == "t") trade.tradeId = reader.readInt();
+        else if (key == "p") trade.price = readDecimal(reader);
+        else if (key == "q") trade.quantity = readDecimal(reader);
+        else if (key == "T") trade.tradeTime = reader.readInt();
+        else if (key == "m") trade.isBuyerMaker = reader.readBool();
+        else reader.skipValue();
+    }
+}
+
+void readBookTicker(JsonReader& reader, BookTickerEvent& ticker) {
+    reader.beginObject();
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key == "u") ticker.updateId = reader.readInt();
+        else if (key == "s") ticker.symbol.assign(reader.readString());
+        else if (key == "b") ticker.bidPrice = readDecimal(reader);
+        else if (key == "B") ticker.bidQty = readDecimal(reader);
+        else if (key == "a") ticker.askPrice = readDecimal(reader);
+        else if (key == "A") ticker.askQty = readDecimal(reader);
+        else reader.skipValue();
+    }
+}
+
+// Reads [["price","qty"], ...] into the chunk, emitting full chunks as it goes
+size_t readLevels(JsonReader& reader, DepthUpdateEvent& depth, MarketEvent& event, bool bids,
+                  const std::function<void(const MarketEvent&)>& sink) {
+    size_t emitted = 0;
+    reader.beginArray();
+    while (reader.nextElement()) {
+        uint16_t& count = bids ? depth.bidCount : depth.askCount;
+        if (count == DepthUpdateEvent::MAX_LEVELS) {
+            depth.last = false;
+            sink(event);
+            ++emitted;
+            depth.bidCount = 0;
+            depth.askCount = 0;
+        }
+        PriceLevel& level = (bids ? depth.bids : depth.asks)[count++];
+        reader.beginArray();
+        reader.nextElement();
+        level.price = readDecimal(reader);
+        reader.nextElement();
+        level.quantity = readDecimal(reader);
+        while (reader.nextElement()) {
+            reader.skipValue();
+        }
+    }
+    return emitted;
+}
+
+size_t readDepth(JsonReader& reader, MarketEvent& event, bool snapshot,
+                 const std::function<void(const MarketEvent&)>& sink) {
+    DepthUpdateEvent& depth = std::get<DepthUpdateEvent>(event);
+    depth.snapshot = snapshot;
+    size_t emitted = 0;
+    reader.beginObject();
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key == "E") depth.eventTime = reader.readInt();
+        else if (key == "s") depth.symbol.assign(reader.readString());
+        else if (key == "U") depth.firstUpdateId = reader.readInt();
+        else if (key == "u") depth.finalUpdateId = reader.readInt();
+        else if (key == "lastUpdateId") depth.firstUpdateId = depth.finalUpdateId = reader.readInt();
+        else if (key == "b" || key == "bids") emitted += readLevels(reader, depth, event, true, sink);
+        else if (key == "a" || key == "asks") emitted += readLevels(reader, depth, event, false, sink);
+        else reader.skipValue();
+    }
+    depth.last = true;
+    sink(event);
+    return emitted + 1;
+}
+
+void readKlineBody(JsonReader& reader, KlineEvent& kline) {
+    reader.beginObject();
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key == "t") kline.startTime = reader.readInt();
+        else if (key == "T") kline.closeTime = reader.readInt();
+        else if (key == "i") {
+            std::string_view interval = reader.readString();
+            size_t length = std::min(interval.size(), sizeof(kline.interval) - 1);
+            std::memcpy(kline.interval, interval.data(), length);
+            kline.interval[length] = '\0';
+        }
+        else if (key == "o") kline.open = readDecimal(reader);
+        else if (key == "h") kline.high = readDecimal(reader);
+        else if (key == "l") kline.low = readDecimal(reader);
+        else if (key == "c") kline.close = readDecimal(reader);
+        else if (key == "v") kline.volume = readDecimal(reader);
+        else if (key == "q") kline.quoteVolume = readDecimal(reader);
+        else if (key == "n") kline.tradeCount = reader.readInt();
+        else if (key == "x") kline.closed = reader.readBool();
+        else reader.skipValue();
+    }
+}
+
+void readKline(JsonReader& reader, KlineEvent& kline) {
+    reader.beginObject();
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key == "E") kline.eventTime = reader.readInt();
+        else if (key == "s") kline.symbol.assign(reader.readString());
+        else if (key == "k") readKlineBody(reader, kline);
+        else reader.skipValue();
+    }
+}
+
+void readSnapshotLevels(JsonReader& reader, std::vector<PriceLevel>& levels) {
+    reader.beginArray();
+    while (reader.nextElement()) {
+        PriceLevel& level = levels.emplace_back();
+        reader.beginArray();
+        reader.nextElement();
+        level.price = readDecimal(reader);
+        reader.nextElement();
+        level.quantity = readDecimal(reader);
+        while (reader.nextElement()) {
+            reader.skipValue();
+        }
+    }
+}
+
+} // namespace
+
+DepthSnapshot parseDepthSnapshot(std::string_view json) {
+    JsonReader reader(json);
+    DepthSnapshot snapshot;
+    reader.beginObject();
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key == "lastUpdateId") snapshot.lastUpdateId = reader.readInt();
+        else if (key == "bids") readSnapshotLevels(reader, snapshot.bids);
+        else if (key == "asks") readSnapshotLevels(reader, snapshot.asks);
+        else reader.skipValue();
+    }
+    return snapshot;
+}
+
+size_t parseStreamMessage(std::string_view message, const std::function<void(const MarketEvent&)>& sink) {
+    JsonReader reader(message);
+    if (reader.peek() != '{') {
+        return 0;
+    }
+    reader.beginObject();
+
+    StreamKind kind = StreamKind::UNKNOWN;
+    std::string_view symbol;
+    size_t emitted = 0;
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key == "stream") {
+            kind = classifyStream(reader.readString(), symbol);
+            continue;
+        }
+        if (key != "data" || kind == StreamKind::UNKNOWN) {
+            reader.skipValue();
+            continue;
+        }
+
+        // The event lives on the stack and is handed to the sink by reference
+        MarketEvent event;
+        switch (kind) {
+            case StreamKind::TRADE:
+                readTrade(reader, event.emplace<TradeEvent>());
+                break;
+            case StreamKind::BOOK_TICKER:
+                readBookTicker(reader, event.emplace<BookTickerEvent>());
+                break;
+            case StreamKind::DIFF_DEPTH:
+            case StreamKind::PARTIAL_DEPTH: {
+                // Partial book payloads name no symbol; take it from the stream
+                event.emplace<DepthUpdateEvent>().symbol.assign(symbol);
+                emitted += readDepth(reader, event, kind == StreamKind::PARTIAL_DEPTH, sink);
+                continue;
+            }
+            case StreamKind::KLINE:
+                readKline(reader, event.emplace<KlineEvent>());
+                break;
+            case StreamKind::UNKNOWN:
+                break;
+        }
+        sink(event);
+        ++emitted;
+    }
+    return emitted;
+}
+
+} // namespace binance
@@ -0,0 +1,262 @@
+#include "../include/MarketDataStream.h"
+#include "../include/WebSocketClient.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace binance {
+
+namespace {
+
+std::string lowercase(const std::string& symbol) {
+    std::string result = symbol;
+    std::transform(result.begin(), result.end(), result.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return result;
+}
+
+} // namespace
+
+// Implementation class using the PIMPL idiom
+class MarketDataStream::Impl {
+public:
+    explicit Impl(const std::string& base_url) : base_url(base_url) {}
+
+    ~Impl() {
+        stop();
+    }
+
+    void subscribe(const std::vector<std::string>& newStreams) {
+        std::lock_guard<std::mutex> lock(mutex);
+        streams.insert(streams.end(), newStreams.begin(), newStreams.end());
+        if (connected) {
+            std::string request = "{\"method\":\"SUBSCRIBE\",\"params\":[";
+            for (size_t i = 0; i < newStreams.size(); ++i) {
+                request += (i ? ",\"" : "\"") + newStreams[i] + "\"";
+            }
+            request += "],\"id\":" + std::to_string(++requestId) + "}";
+            try {
+                webSocket.sendText(request);
+            } catch (const std::exception&) {
+                // The connection dropped; the reconnect URL includes the new streams
+            }
+        }
+    }
+
+    std::shared_ptr<MarketEventQueue> addConsumer(size_t capacity) {
+        if (running) {
+            throw std::runtime_error("Consumers must be added before the stream starts");
+        }
+        consumers.push_back(std::make_shared<MarketEventQueue>(capacity));
+        return consumers.back();
+    }
+
+    void setReadTimeout(std::chrono::milliseconds timeout) {
+        webSocket.setReadTimeout(static_cast<int>(timeout.count()));
+    }
+
+    void start() {
+        if (running) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (streams.empty()) {
+                throw std::runtime_error("No market data streams subscribed");
+            }
+        }
+        running = true;
+        ioThread = std::thread(&Impl::run, this);
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!running) {
+                return;
+            }
+            running = false;
+        }
+        webSocket.interrupt();
+        wakeUp.notify_all();
+        if (ioThread.joinable()) {
+            ioThread.join();
+        }
+        webSocket.close();
+    }
+
+    bool isConnected() const { return connected; }
+
+    std::string lastError() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return lastErrorText;
+    }
+
+    std::atomic<uint64_t> messages{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> errors{0};
+    std::atomic<uint64_t> connectionErrors{0};
+    std::atomic<uint64_t> reconnectCount{0};
+
+private:
+    std::string base_url;
+    std::vector<std::string> streams;
+    std::vector<std::shared_ptr<MarketEventQueue>> consumers;
+    WebSocketClient webSocket;
+    std::thread ioThread;
+    mutable std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::atomic<bool> running{false};
+    std::atomic<bool> connected{false};
+    uint64_t requestId = 0;
+    std::string lastErrorText;
+
+    std::string streamUrl() {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::string url = base_url + "/stream?streams=";
+        for (size_t i = 0; i < streams.size(); ++i) {
+            if (i) url += '/';
+            url += streams[i];
+        }
+        return url;
+    }
+
+    void publish(const MarketEvent& event) {
+        for (const auto& consumer : consumers) {
+            if (!consumer->tryPush(event)) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void run() {
+        std::string message;
+        auto sink = [this](const MarketEvent& event) { publish(event); };
+        std::chrono::milliseconds backoff(250);
+        bool firstConnection = true;
+
+        while (running) {
+            try {
+                webSocket.connect(streamUrl());
+                {
+                    // A stop() that raced with connect() must still be able to interrupt
+                    std::lock_guard<std::mutex> lock(mutex);
+                    connected = running.load();
+                }
+                if (!firstConnection) {
+                    reconnectCount.fetch_add(1, std::memory_order_relaxed);
+                }
+                firstConnection = false;
+                backoff = std::chrono::milliseconds(250);
+
+                while (running && webSocket.receive(message)) {
+                    messages.fetch_add(1, std::memory_order_relaxed);
+                    try {
+                        parseStreamMessage(message, sink);
+                    } catch (const std::exception&) {
+                        errors.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            } catch (const std::exception& e) {
+                if (running) {
+                    connectionErrors.fetch_add(1, std::memory_order_relaxed);
+                    std::lock_guard<std::mutex> lock(mutex);
+                    lastErrorText = e.what();
+                }
+            }
+            connected = false;
+            webSocket.close();
+
+            // Wait before reconnecting, doubling up to 30 seconds
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeUp.wait_for(lock, backoff, [this] { return !running; });
+            backoff = std::min(backoff * 2, std::chrono::milliseconds(30000));
+        }
+    }
+};
+
+// MarketDataStream implementation
+
+MarketDataStream::MarketDataStream(const std::string& base_url)
+    : pImpl(new Impl(base_url)) {
+}
+
+MarketDataStream::~MarketDataStream() = default;
+
+void MarketDataStream::subscribe(const std::vector<std::string>& streams) {
+    pImpl->subscribe(streams);
+}
+
+std::shared_ptr<MarketEventQueue> MarketDataStream::addConsumer(size_t capacity) {
+    return pImpl->addConsumer(capacity);
+}
+
+void MarketDataStream::setReadTimeout(std::chrono::milliseconds timeout) {
+    pImpl->setReadTimeout(timeout);
+}
+
+void MarketDataStream::start() {
+    pImpl->start();
+}
+
+void MarketDataStream::stop() {
+    pImpl->stop();
+}
+
+bool MarketDataStream::isConnected() const {
+    return pImpl->isConnected();
+}
+
+uint64_t MarketDataStream::messagesReceived() const {
+    return pImpl->messages.load(std::memory_order_relaxed);
+}
+
+uint64_t MarketDataStream::eventsDropped() const {
+    return pImpl->dropped.load(std::memory_order_relaxed);
+}
+
+uint64_t MarketDataStream::decodeErrors() const {
+    return pImpl->errors.load(std::memory_order_relaxed);
+}
+
+uint64_t MarketDataStream::connectionErrors() const {
+    return pImpl->connectionErrors.load(std::memory_order_relaxed);
+}
+
+std::string MarketDataStream::lastError() const {
+    return pImpl->lastError();
+}
+
+uint64_t MarketDataStream::reconnects() const {
+    return pImpl->reconnectCount.load(std::memory_order_relaxed);
+}
+
+std::string MarketDataStream::tradeStream(const std::string& symbol) {
+    return lowercase(symbol) + "@trade";
+}
+
+std::string MarketDataStream::bookTickerStream(const std::string& symbol) {
+    return lowercase(symbol) + "@bookTicker";
+}
+
+std::string MarketDataStream::depthStream(const std::string& symbol, int levels, bool fast) {
+    std::string stream = lowercase(symbol) + "@depth";
+    if (levels > 0) {
+        stream += std::to_string(levels);
+    }
+    if (fast) {
+        stream += "@100ms";
+    }
+    return stream;
+}
+
+std::string MarketDataStream::klineStream(const std::string& symbol, const std::string& interval) {
+    return lowercase(symbol) + "@kline_" + interval;
+}
+
+} // namespace binance
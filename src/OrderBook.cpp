@@ -0,0 +1,343 @@
+#include "../include/OrderBook.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace binance {
+
+namespace {
+
+bool better(bool isBid, int64_t tick, int64_t than) {
+    return isBid ? tick > than : tick < than;
+}
+
+} // namespace
+
+OrderBook::OrderBook(const std::string& symbol, Decimal tickSize, size_t windowTicks)
+    : symbol_(symbol), tickUnits_(tickSize.units()),
+      windowTicks_(std::max<size_t>(64, (windowTicks + 63) & ~static_cast<size_t>(63))) {
+    if (tickUnits_ <= 0) {
+        throw std::invalid_argument("Order book tick size must be positive");
+    }
+    for (Side* side : {&bids_, &asks_}) {
+        side->quantities.assign(windowTicks_, 0);
+        side->occupied.assign(windowTicks_ / 64, 0);
+    }
+    bids_.isBid = true;
+}
+
+void OrderBook::setSnapshotSource(std::function<DepthSnapshot()> source) {
+    snapshotSource_ = std::move(source);
+}
+
+int64_t OrderBook::toTick(Decimal price) const {
+    return price.units() / tickUnits_;
+}
+
+// Place the window so the anchor sits a quarter in from the better edge,
+// leaving most of the window for levels behind the best price
+void OrderBook::position(Side& side, int64_t anchor) {
+    int64_t width = static_cast<int64_t>(windowTicks_);
+    side.base = side.isBid ? anchor - (width - width / 4) : anchor - width / 4;
+}
+
+int64_t OrderBook::quantityAt(const Side& side, int64_t tick) const {
+    uint64_t slot = static_cast<uint64_t>(tick - side.base);
+    if (slot < windowTicks_) {
+        return side.quantities[slot];
+    }
+    auto it = std::lower_bound(side.far.begin(), side.far.end(), tick,
+                               [](const FarLevel& level, int64_t t) { return level.tick < t; });
+    return it != side.far.end() && it->tick == tick ? it->quantity : 0;
+}
+
+PriceLevel OrderBook::levelAt(const Side& side, int64_t tick) const {
+    if (tick == NONE) {
+        return PriceLevel{};
+    }
+    return PriceLevel{Decimal::fromUnits(tick * tickUnits_), Decimal::fromUnits(quantityAt(side, tick))};
+}
+
+void OrderBook::set(Side& side, int64_t tick, int64_t quantity) {
+    if (side.count == 0 && quantity != 0) {
+        position(side, tick);
+    }
+
+    bool existed;
+    uint64_t slot = static_cast<uint64_t>(tick - side.base);
+    if (slot < windowTicks_) {
+        uint64_t bit = 1ULL << (slot & 63);
+        uint64_t& word = side.occupied[slot >> 6];
+        existed = (word & bit) != 0;
+        side.quantities[slot] = quantity;
+        word = quantity != 0 ? (word | bit) : (word & ~bit);
+    } else {
+        auto it = std::lower_bound(side.far.begin(), side.far.end(), tick,
+                                   [](const FarLevel& level, int64_t t) { return level.tick < t; });
+        existed = it != side.far.end() && it->tick == tick;
+        if (quantity == 0) {
+            if (existed) side.far.erase(it);
+        } else if (existed) {
+            it->quantity = quantity;
+        } else {
+            side.far.insert(it, FarLevel{tick, quantity});
+        }
+    }
+
+    if (quantity != 0) {
+        if (!existed) {
+            ++side.count;
+            if (side.best == NONE || better(side.isBid, tick, side.best)) {
+                side.best = tick;
+                keepBestInWindow(side);
+            }
+        }
+    } else if (existed) {
+        --side.count;
+        if (tick == side.best) {
+            side.best = side.count != 0 ? nextBest(side, tick) : NONE;
+            keepBestInWindow(side);
+        }
+    }
+}
+
+// Re-center once the best price nears the better edge of the window or
+// drifts far enough behind that many live levels would fall outside it
+void OrderBook::keepBestInWindow(Side& side) {
+    if (side.best == NONE) {
+        return;
+    }
+    int64_t width = static_cast<int64_t>(windowTicks_);
+    int64_t slot = side.best - side.base;
+    bool misplaced = side.isBid ? (slot < width / 2 || slot >= width - width / 16)
+                                : (slot < width / 16 || slot >= width / 2);
+    if (misplaced) {
+        recenter(side, side.best);
+    }
+}
+
+void OrderBook::recenter(Side& side, int64_t anchor) {
+    std::vector<FarLevel> levels;
+    levels.swap(side.far);
+    for (size_t w = 0; w < side.occupied.size(); ++w) {
+        uint64_t bits = side.occupied[w];
+        while (bits != 0) {
+            size_t slot = w * 64 + static_cast<size_t>(__builtin_ctzll(bits));
+            levels.push_back(FarLevel{side.base + static_cast<int64_t>(slot), side.quantities[slot]});
+            side.quantities[slot] = 0;
+            bits &= bits - 1;
+        }
+        side.occupied[w] = 0;
+    }
+
+    position(side, anchor);
+    std::sort(levels.begin(), levels.end(),
+              [](const FarLevel& a, const FarLevel& b) { return a.tick < b.tick; });
+    side.far.clear();
+    for (const FarLevel& level : levels) {
+        uint64_t slot = static_cast<uint64_t>(level.tick - side.base);
+        if (slot < windowTicks_) {
+            side.quantities[slot] = level.quantity;
+            side.occupied[slot >> 6] |= 1ULL << (slot & 63);
+        } else {
+            side.far.push_back(level);
+        }
+    }
+}
+
+// Best level strictly behind the given tick: the highest bid below it or the lowest ask above it
+int64_t OrderBook::nextBest(const Side& side, int64_t from) const {
+    int64_t width = static_cast<int64_t>(windowTicks_);
+    int64_t found = NONE;
+
+    if (side.isBid) {
+        int64_t slot = std::min(from - 1 - side.base, width - 1);
+        if (slot >= 0) {
+            for (int64_t w = slot >> 6; w >= 0; --w) {
+                uint64_t bits = side.occupied[static_cast<size_t>(w)];
+                if (w == (slot >> 6)) {
+                    bits &= ~0ULL >> (63 - (slot & 63));
+                }
+                if (bits != 0) {
+                    found = side.base + w * 64 + 63 - __builtin_clzll(bits);
+                    break;
+                }
+            }
+        }
+        auto it = std::lower_bound(side.far.begin(), side.far.end(), from,
+                                   [](const FarLevel& level, int64_t t) { return level.tick < t; });
+        if (it != side.far.begin()) {
+            int64_t farTick = std::prev(it)->tick;
+            if (found == NONE || farTick > found) found = farTick;
+        }
+    } else {
+        int64_t slot = std::max<int64_t>(from + 1 - side.base, 0);
+        if (slot < width) {
+            int64_t words = width / 64;
+            for (int64_t w = slot >> 6; w < words; ++w) {
+                uint64_t bits = side.occupied[static_cast<size_t>(w)];
+                if (w == (slot >> 6)) {
+                    bits &= ~0ULL << (slot & 63);
+                }
+                if (bits != 0) {
+                    found = side.base + w * 64 + __builtin_ctzll(bits);
+                    break;
+                }
+            }
+        }
+        auto it = std::upper_bound(side.far.begin(), side.far.end(), from,
+                                   [](int64_t t, const FarLevel& level) { return t < level.tick; });
+        if (it != side.far.end()) {
+            if (found == NONE || it->tick < found) found = it->tick;
+        }
+    }
+    return found;
+}
+
+size_t OrderBook::top(const Side& side, PriceLevel* out, size_t count) const {
+    size_t written = 0;
+    for (int64_t tick = side.best; tick != NONE && written < count; tick = nextBest(side, tick)) {
+        out[written++] = levelAt(side, tick);
+    }
+    return written;
+}
+
+void OrderBook::setLevel(bool isBid, Decimal price, Decimal quantity) {
+    set(isBid ? bids_ : asks_, toTick(price), quantity.units());
+}
+
+void OrderBook::resetSide(Side& side) {
+    if (side.count != 0) {
+        std::fill(side.quantities.begin(), side.quantities.end(), 0);
+        std::fill(side.occupied.begin(), side.occupied.end(), 0);
+    }
+    side.far.clear();
+    side.best = NONE;
+    side.count = 0;
+}
+
+void OrderBook::clear() {
+    resetSide(bids_);
+    resetSide(asks_);
+    synced_ = false;
+    inMessage_ = false;
+    lastUpdateId_ = 0;
+    pending_.clear();
+}
+
+Decimal OrderBook::midPrice() const {
+    if (bids_.best == NONE || asks_.best == NONE) {
+        return Decimal();
+    }
+    return Decimal::fromUnits((bids_.best + asks_.best) * tickUnits_ / 2);
+}
+
+void OrderBook::applyLevels(const DepthUpdateEvent& event) {
+    for (uint16_t i = 0; i < event.bidCount; ++i) {
+        set(bids_, toTick(event.bids[i].price), event.bids[i].quantity.units());
+    }
+    for (uint16_t i = 0; i < event.askCount; ++i) {
+        set(asks_, toTick(event.asks[i].price), event.asks[i].quantity.units());
+    }
+}
+
+bool OrderBook::applySnapshot(const DepthSnapshot& snapshot) {
+    resetSide(bids_);
+    resetSide(asks_);
+    for (const PriceLevel& level : snapshot.bids) {
+        set(bids_, toTick(level.price), level.quantity.units());
+    }
+    for (const PriceLevel& level : snapshot.asks) {
+        set(asks_, toTick(level.price), level.quantity.units());
+    }
+    lastUpdateId_ = snapshot.lastUpdateId;
+    synced_ = true;
+    inMessage_ = false;
+
+    // Replay what arrived while waiting; stale updates are ignored and a
+    // snapshot older than the buffer shows up as a gap, left for the next
+    // update to resolve rather than fetching again from inside the replay
+    std::vector<DepthUpdateEvent> buffered;
+    buffered.swap(pending_);
+    bool wasResyncing = resyncing_;
+    resyncing_ = true;
+    for (const DepthUpdateEvent& event : buffered) {
+        apply(event);
+    }
+    resyncing_ = wasResyncing;
+    return synced_;
+}
+
+void OrderBook::buffer(const DepthUpdateEvent& event) {
+    if (pending_.size() == MAX_PENDING) {
+        pending_.erase(pending_.begin());
+    }
+    pending_.push_back(event);
+}
+
+void OrderBook::resync() {
+    // Fetch only between updates so a split update is replayed whole
+    if (!snapshotSource_ || resyncing_ || inMessage_) {
+        return;
+    }
+    resyncing_ = true;
+    try {
+        applySnapshot(snapshotSource_());
+    } catch (...) {
+        resyncing_ = false;
+        throw;
+    }
+    resyncing_ = false;
+}
+
+DepthApplyResult OrderBook::apply(const DepthUpdateEvent& event) {
+    if (event.snapshot) {
+        resetSide(bids_);
+        resetSide(asks_);
+        pending_.clear();
+        applyLevels(event);
+        lastUpdateId_ = event.finalUpdateId;
+        synced_ = true;
+        inMessage_ = false;
+        return DepthApplyResult::APPLIED;
+    }
+
+    bool continuation = inMessage_ && event.finalUpdateId == messageUpdateId_;
+    inMessage_ = !event.last;
+    messageUpdateId_ = event.finalUpdateId;
+
+    if (continuation && synced_ &&
+        (messageResult_ == DepthApplyResult::APPLIED || messageResult_ == DepthApplyResult::IGNORED)) {
+        if (messageResult_ == DepthApplyResult::APPLIED) {
+            applyLevels(event);
+        }
+        return messageResult_;
+    }
+
+    if (!synced_) {
+        buffer(event);
+        messageResult_ = DepthApplyResult::BUFFERED;
+        resync();
+        return synced_ ? DepthApplyResult::APPLIED : DepthApplyResult::BUFFERED;
+    }
+
+    if (event.finalUpdateId <= lastUpdateId_) {
+        messageResult_ = DepthApplyResult::IGNORED;
+        return messageResult_;
+    }
+
+    if (event.firstUpdateId > lastUpdateId_ + 1) {
+        synced_ = false;
+        pending_.clear();
+        buffer(event);
+        messageResult_ = DepthApplyResult::BUFFERED;
+        resync();
+        return DepthApplyResult::GAP;
+    }
+
+    applyLevels(event);
+    lastUpdateId_ = event.finalUpdateId;
+    messageResult_ = DepthApplyResult::APPLIED;
+    return messageResult_;
+}
+
+} // namespace binance
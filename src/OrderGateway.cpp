@@ -0,0 +1,205 @@
+#include "../include/OrderGateway.h"
+#include "../include/BinanceAPI.h"
+#include "../include/ExchangeInfo.h"
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <vector>
+
+namespace binance {
+
+namespace {
+
+// The exchange's error code from an "HTTP error 400: {"code":-2010,...}" message
+int errorCodeOf(const std::string& message) {
+    size_t pos = message.find("\"code\":");
+    return pos == std::string::npos ? 0 : std::atoi(message.c_str() + pos + 7);
+}
+
+} // namespace
+
+// Implementation class using the PIMPL idiom
+class RestOrderGateway::Impl {
+public:
+    Impl(BinanceAPI& api, const std::string& clientIdPrefix)
+        : api(api),
+          idPrefix(clientIdPrefix + "-" +
+                   std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(
+                       std::chrono::system_clock::now().time_since_epoch()).count()) + "-") {}
+
+    ~Impl() {
+        for (Pending& request : pending) {
+            request.response.wait();
+        }
+    }
+
+    std::string placeOrder(const OrderParams& order) {
+        OrderParams params = order;
+        if (!params.newClientOrderId) {
+            params.newClientOrderId = idPrefix + std::to_string(++sequence);
+        }
+        if (!params.newOrderRespType) {
+            params.newOrderRespType = OrderResponseType::RESULT;
+        }
+
+        FilterResult filterResult = FilterResult::OK;
+        if (const SymbolFilters* symbolFilters = filters ? filters->find(params.symbol) : nullptr) {
+            filterResult = applyFilters(*symbolFilters, params);
+        }
+
+        Pending request;
+        request.cancel = false;
+        request.update.symbol.assign(params.symbol);
+        request.update.clientOrderId.assign(*params.newClientOrderId);
+        request.update.side = params.side;
+        request.update.type = params.type;
+        request.update.price = params.price.value_or(Decimal());
+        request.update.quantity = params.quantity.value_or(Decimal());
+        if (filterResult == FilterResult::OK || filterResult == FilterResult::UNKNOWN_SYMBOL) {
+            try {
+                request.response = api.createOrderAsync(params.symbol, toString(params.side),
+                                                        toString(params.type), toParamMap(params));
+            } catch (...) {
+                // Stopped by the risk engine or the rate limiter before it was sent
+                std::promise<std::string> reject;
+                reject.set_exception(std::current_exception());
+                request.response = reject.get_future();
+            }
+        } else {
+            // Answered here the way the exchange would have answered it
+            ++rejected;
+            std::promise<std::string> reject;
+            reject.set_exception(std::make_exception_ptr(std::runtime_error(
+                std::string("{\"code\":-1013,\"msg\":\"Filter failure: ") + toString(filterResult) + "\"}")));
+            request.response = reject.get_future();
+        }
+        pending.push_back(std::move(request));
+        return *params.newClientOrderId;
+    }
+
+    void setFilters(const ExchangeInfoCache* cache) {
+        filters = cache;
+    }
+
+    uint64_t filterRejects() const {
+        return rejected;
+    }
+
+    void cancelOrder(const std::string& symbol, const std::string& clientOrderId) {
+        Pending request;
+        request.cancel = true;
+        request.update.symbol.assign(symbol);
+        request.update.clientOrderId.assign(clientOrderId);
+        request.response = api.cancelOrderAsync(symbol, {{"origClientOrderId", clientOrderId}});
+        pending.push_back(std::move(request));
+    }
+
+    size_t poll(const std::function<void(const OrderUpdateEvent&)>& sink) {
+        size_t delivered = 0;
+        for (size_t i = 0; i < pending.size();) {
+            Pending& request = pending[i];
+            if (request.response.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                ++i;
+                continue;
+            }
+
+            OrderUpdateEvent update = request.update;
+            try {
+                OrderInfo info = parseOrderInfo(request.response.get());
+                update.orderId = info.orderId;
+                update.eventTime = info.transactTime;
+                update.status = info.status;
+                update.price = info.price;
+                update.quantity = info.origQty;
+                update.executedQty = info.executedQty;
+                update.cumulativeQuoteQty = info.cummulativeQuoteQty;
+            } catch (const std::exception& e) {
+                update.errorCode = errorCodeOf(e.what());
+                if (request.cancel) {
+                    update.cancelRejected = true;
+                } else {
+                    update.status = OrderStatus::REJECTED;
+                }
+            }
+
+            pending[i] = std::move(pending.back());
+            pending.pop_back();
+            sink(update);
+            ++delivered;
+        }
+        return delivered;
+    }
+
+    size_t inFlight() const {
+        return pending.size();
+    }
+
+private:
+    struct Pending {
+        std::future<std::string> response;
+        OrderUpdateEvent update;  // What was asked for, completed from the response
+        bool cancel = false;
+    };
+
+    // Rounds the order's prices and quantity in place and checks what is left
+    static FilterResult applyFilters(const SymbolFilters& symbolFilters, OrderParams& params) {
+        if (params.stopPrice) {
+            params.stopPrice = symbolFilters.roundPrice(*params.stopPrice, Decimal::Rounding::NEAREST);
+        }
+        if (params.icebergQty) {
+            params.icebergQty = symbolFilters.roundQuantity(*params.icebergQty);
+        }
+        if (!params.quantity) {
+            // A quote-quantity market order: only the price can be checked, and it has none
+            return FilterResult::OK;
+        }
+        bool market = params.type == OrderType::MARKET || !params.price;
+        Decimal price = params.price.value_or(Decimal());
+        Decimal quantity = *params.quantity;
+        FilterResult result = symbolFilters.normalize(params.side, market ? OrderType::MARKET : OrderType::LIMIT,
+                                                      price, quantity);
+        if (params.price) {
+            params.price = price;
+        }
+        params.quantity = quantity;
+        return result;
+    }
+
+    BinanceAPI& api;
+    const ExchangeInfoCache* filters = nullptr;
+    uint64_t rejected = 0;
+    std::string idPrefix;
+    uint64_t sequence = 0;
+    std::vector<Pending> pending;
+};
+
+RestOrderGateway::RestOrderGateway(BinanceAPI& api, const std::string& clientIdPrefix)
+    : pImpl(std::make_unique<Impl>(api, clientIdPrefix)) {}
+
+RestOrderGateway::~RestOrderGateway() = default;
+
+std::string RestOrderGateway::placeOrder(const OrderParams& order) {
+    return pImpl->placeOrder(order);
+}
+
+void RestOrderGateway::cancelOrder(const std::string& symbol, const std::string& clientOrderId) {
+    pImpl->cancelOrder(symbol, clientOrderId);
+}
+
+size_t RestOrderGateway::poll(const std::function<void(const OrderUpdateEvent&)>& sink) {
+    return pImpl->poll(sink);
+}
+
+void RestOrderGateway::setFilters(const ExchangeInfoCache* filters) {
+    pImpl->setFilters(filters);
+}
+
+uint64_t RestOrderGateway::filterRejects() const {
+    return pImpl->filterRejects();
+}
+
+size_t RestOrderGateway::inFlight() const {
+    return pImpl->inFlight();
+}
+
+} // namespace binance
@@ -0,0 +1,227 @@
+#include "../include/OrderStore.h"
+#include <stdexcept>
+
+namespace binance {
+
+namespace {
+
+// How far along its life a status is; an update may not move an order back
+int rankOf(OrderStatus status) {
+    switch (status) {
+        case OrderStatus::PENDING_NEW: return 0;
+        case OrderStatus::NEW: return 1;
+        case OrderStatus::PARTIALLY_FILLED: return 2;
+        case OrderStatus::PENDING_CANCEL: return 3;
+        default: return 4;
+    }
+}
+
+} // namespace
+
+OrderStore::OrderStore(size_t capacity) {
+    if (capacity == 0 || capacity >= EMPTY / 2) {
+        throw std::invalid_argument("Order store capacity must be between 1 and 2^31");
+    }
+    // Tables at most half full keep probe sequences short
+    size_t tableSize = 8;
+    while (tableSize < capacity * 2) {
+        tableSize *= 2;
+    }
+    slots_.resize(capacity);
+    byId_.resize(tableSize);
+    byClientId_.resize(tableSize);
+    mask_ = tableSize - 1;
+    finished_.resize(capacity);
+    clear();
+}
+
+OrderApplyResult OrderStore::apply(const OrderUpdateEvent& update, OrderExecution* fill) {
+    if (fill) {
+        *fill = OrderExecution();
+    }
+    if (update.orderId < 0 || update.cancelRejected) {
+        return OrderApplyResult::IGNORED;
+    }
+
+    size_t position = positionOf(update.orderId);
+    if (byId_[position].slot == EMPTY) {
+        if (size_ == slots_.size()) {
+            if (finishedCount_ == 0) {
+                return OrderApplyResult::FULL;
+            }
+            evictOldest();
+        }
+        insert(update);
+        if (fill) {
+            // Whatever it executed before we heard of it is news to us
+            fill->quantity = update.executedQty;
+            fill->quoteQuantity = update.cumulativeQuoteQty;
+        }
+        return OrderApplyResult::APPLIED;
+    }
+
+    uint32_t slot = byId_[position].slot;
+    OrderState& order = slots_[slot];
+    if (update.executedQty < order.executedQty ||
+        (update.executedQty == order.executedQty &&
+         (update.status == order.status || rankOf(update.status) < rankOf(order.status)))) {
+        ++stale_;
+        return OrderApplyResult::STALE;
+    }
+    if (!isValidTransition(order.status, update.status)) {
+        ++invalid_;
+        return OrderApplyResult::INVALID_TRANSITION;
+    }
+
+    if (fill) {
+        fill->quantity = update.executedQty - order.executedQty;
+        fill->quoteQuantity = update.cumulativeQuoteQty - order.cumulativeQuoteQty;
+    }
+    order.status = update.status;
+    order.executedQty = update.executedQty;
+    order.cumulativeQuoteQty = update.cumulativeQuoteQty;
+    order.updateTime = update.eventTime;
+    if (!update.quantity.isZero()) {
+        order.quantity = update.quantity;  // Orders sized in the quote asset learn theirs as they fill
+    }
+    if (order.clientOrderId.empty() && !update.clientOrderId.empty()) {
+        order.clientOrderId = update.clientOrderId;
+        indexClientId(slot);
+    }
+    if (isFinal(order.status)) {
+        --openCount_;
+        finished_[(finishedHead_ + finishedCount_++) % finished_.size()] = slot;
+    }
+    return OrderApplyResult::APPLIED;
+}
+
+void OrderStore::clear() {
+    for (OrderState& order : slots_) {
+        order = OrderState();
+    }
+    for (IndexEntry& entry : byId_) {
+        entry = IndexEntry();
+    }
+    for (IndexEntry& entry : byClientId_) {
+        entry = IndexEntry();
+    }
+    // Hand out low slots first, so a lightly used store touches little memory
+    freeSlots_.clear();
+    for (size_t i = slots_.size(); i-- > 0;) {
+        freeSlots_.push_back(static_cast<uint32_t>(i));
+    }
+    finishedHead_ = 0;
+    finishedCount_ = 0;
+    size_ = 0;
+    openCount_ = 0;
+    stale_ = 0;
+    invalid_ = 0;
+    evictions_ = 0;
+}
+
+bool OrderStore::isValidTransition(OrderStatus from, OrderStatus to) {
+    if (isFinal(from) || to == OrderStatus::PENDING_NEW) {
+        return false;
+    }
+    if (from == OrderStatus::PENDING_NEW) {
+        return true;
+    }
+    // Once working, an order can fill, be cancelled or expire, but never start over
+    if (to == OrderStatus::NEW || to == OrderStatus::REJECTED) {
+        return false;
+    }
+    return !(from == OrderStatus::PENDING_CANCEL && to == OrderStatus::PENDING_CANCEL);
+}
+
+uint32_t OrderStore::insert(const OrderUpdateEvent& update) {
+    uint32_t slot = freeSlots_.back();
+    freeSlots_.pop_back();
+    OrderState& order = slots_[slot];
+    order.symbol = update.symbol;
+    order.clientOrderId = update.clientOrderId;
+    order.orderId = update.orderId;
+    order.side = update.side;
+    order.type = update.type;
+    order.status = update.status;
+    order.price = update.price;
+    order.quantity = update.quantity;
+    order.executedQty = update.executedQty;
+    order.cumulativeQuoteQty = update.cumulativeQuoteQty;
+    order.updateTime = update.eventTime;
+
+    IndexEntry& entry = byId_[positionOf(update.orderId)];
+    entry.slot = slot;
+    entry.hash = hashId(update.orderId);
+    indexClientId(slot);
+
+    ++size_;
+    if (isFinal(order.status)) {
+        finished_[(finishedHead_ + finishedCount_++) % finished_.size()] = slot;
+    } else {
+        ++openCount_;
+    }
+    return slot;
+}
+
+void OrderStore::evictOldest() {
+    uint32_t slot = finished_[finishedHead_];
+    finishedHead_ = (finishedHead_ + 1) % finished_.size();
+    --finishedCount_;
+
+    OrderState& order = slots_[slot];
+    erase(byId_, positionOf(order.orderId));
+    if (!order.clientOrderId.empty()) {
+        uint32_t hash = hashClientId(order.clientOrderId.view());
+        for (size_t i = hash & mask_; byClientId_[i].slot != EMPTY; i = (i + 1) & mask_) {
+            if (byClientId_[i].slot == slot) {
+                erase(byClientId_, i);
+                break;
+            }
+        }
+    }
+    order = OrderState();
+    freeSlots_.push_back(slot);
+    --size_;
+    ++evictions_;
+}
+
+void OrderStore::indexClientId(uint32_t slot) {
+    const ClientOrderId& id = slots_[slot].clientOrderId;
+    if (id.empty()) {
+        return;
+    }
+    uint32_t hash = hashClientId(id.view());
+    size_t i = hash & mask_;
+    for (; byClientId_[i].slot != EMPTY; i = (i + 1) & mask_) {
+        if (byClientId_[i].hash == hash && slots_[byClientId_[i].slot].clientOrderId == id.view()) {
+            break;  // A reused id now means the newer order
+        }
+    }
+    byClientId_[i].slot = slot;
+    byClientId_[i].hash = hash;
+}
+
+void OrderStore::erase(std::vector<IndexEntry>& table, size_t position) {
+    // Backward-shift deletion: pull later entries of the probe run into the hole,
+    // unless that would move one before its home position
+    size_t hole = position;
+    for (size_t i = (hole + 1) & mask_; table[i].slot != EMPTY; i = (i + 1) & mask_) {
+        size_t home = table[i].hash & mask_;
+        if (((i - home) & mask_) >= ((i - hole) & mask_)) {
+            table[hole] = table[i];
+            hole = i;
+        }
+    }
+    table[hole] = IndexEntry();
+}
+
+size_t OrderStore::positionOf(int64_t orderId) const {
+    uint32_t hash = hashId(orderId);
+    size_t i = hash & mask_;
+    while (byId_[i].slot != EMPTY && !(byId_[i].hash == hash && slots_[byId_[i].slot].orderId == orderId)) {
+        i = (i + 1) & mask_;
+    }
+    return i;
+}
+
+} // namespace binance
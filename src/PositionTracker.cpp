@@ -0,0 +1,112 @@
+#include "../include/PositionTracker.h"
+#include <stdexcept>
+
+namespace binance {
+
+void PositionTracker::apply(const BalanceUpdateEvent& update) {
+    AssetBalance* entry = &balanceOf(update.asset.view());
+    if (update.isDelta) {
+        entry->free += update.free;
+    } else {
+        entry->free = update.free;
+        entry->locked = update.locked;
+    }
+    entry->updateTime = update.eventTime;
+}
+
+void PositionTracker::applyFill(std::string_view symbol, OrderSide side, const OrderExecution& fill) {
+    if (fill.quantity.units() <= 0) {
+        return;
+    }
+    applyFill(positionOf(symbol), side, fill);
+}
+
+void PositionTracker::applyFill(SymbolId symbol, OrderSide side, const OrderExecution& fill) {
+    if (!symbols_) {
+        throw std::out_of_range("PositionTracker has no symbol registry");
+    }
+    std::string_view name = symbols_->name(symbol);
+    if (fill.quantity.units() <= 0) {
+        return;
+    }
+    applyFill(positionOf(symbol, name), side, fill);
+}
+
+void PositionTracker::applyFill(Position& position, OrderSide side, const OrderExecution& fill) {
+    Position* entry = &position;
+
+    Decimal price = fill.quoteQuantity / fill.quantity;
+    Decimal signedQty = side == OrderSide::BUY ? fill.quantity : -fill.quantity;
+    Decimal held = entry->quantity;
+    entry->volume += fill.quantity;
+
+    bool adding = held.isZero() || (held.units() > 0) == (signedQty.units() > 0);
+    if (adding) {
+        Decimal heldSize = held.units() < 0 ? -held : held;
+        entry->averagePrice = (entry->averagePrice * heldSize + fill.quoteQuantity) / (heldSize + fill.quantity);
+        entry->quantity = held + signedQty;
+        return;
+    }
+
+    // Reducing: the closed part realizes its difference to the average price
+    Decimal heldSize = held.units() < 0 ? -held : held;
+    Decimal closed = fill.quantity < heldSize ? fill.quantity : heldSize;
+    Decimal gain = (price - entry->averagePrice) * closed;
+    entry->realizedPnl += held.units() > 0 ? gain : -gain;
+    entry->quantity = held + signedQty;
+    if (entry->quantity.isZero()) {
+        entry->averagePrice = Decimal();
+    } else if ((entry->quantity.units() > 0) != (held.units() > 0)) {
+        entry->averagePrice = price;  // Flipped sides; the remainder opened at this fill
+    }
+}
+
+AssetBalance& PositionTracker::balanceOf(std::string_view asset) {
+    for (AssetBalance& entry : balances_) {
+        if (entry.asset == asset) return entry;
+    }
+    AssetBalance& entry = balances_.emplace_back();
+    entry.asset.assign(asset);
+    return entry;
+}
+
+Position& PositionTracker::positionOf(std::string_view symbol) {
+    SymbolId id = symbols_ ? symbols_->find(symbol) : INVALID_SYMBOL;
+    if (id != INVALID_SYMBOL) {
+        return positionOf(id, symbol);
+    }
+    for (Position& entry : positions_) {
+        if (entry.symbol == symbol) return entry;
+    }
+    Position& entry = positions_.emplace_back();
+    entry.symbol.assign(symbol);
+    return entry;
+}
+
+Position& PositionTracker::positionOf(SymbolId id, std::string_view symbol) {
+    if (id < slots_.size() && slots_[id] >= 0) {
+        return positions_[slots_[id]];
+    }
+    if (id >= slots_.size()) {
+        slots_.resize(symbols_->size() > id ? symbols_->size() : id + 1, -1);
+    }
+    // Interned after its first fill, the symbol may already have a position
+    for (size_t i = 0; i < positions_.size(); ++i) {
+        if (positions_[i].symbol == symbols_->name(id)) {
+            slots_[id] = static_cast<int32_t>(i);
+            return positions_[i];
+        }
+    }
+    slots_[id] = static_cast<int32_t>(positions_.size());
+    Position& entry = positions_.emplace_back();
+    entry.symbol.assign(symbol);
+    return entry;
+}
+
+void PositionTracker::clear() {
+    balances_.clear();
+    positions_.clear();
+    slots_.clear();
+}
+
+} // namespace binance
@@ -0,0 +1,217 @@
+#include "../include/RateLimiter.h"
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace binance {
+
+namespace {
+
+constexpr uint64_t USAGE_MASK = 0xFFFFFFFFull;
+
+uint64_t pack(uint64_t window, uint64_t used) {
+    return (window << 32) | (used & USAGE_MASK);
+}
+
+// Usage in the given window; a counter left over from an older window is empty
+uint64_t usageIn(uint64_t state, uint64_t window) {
+    return (state >> 32) == window ? state & USAGE_MASK : 0;
+}
+
+// Cost of a request against a limit of the given type
+int64_t costFor(RateLimitType type, int64_t weight, int64_t orders) {
+    return type == RateLimitType::REQUEST_WEIGHT ? weight : orders;
+}
+
+} // namespace
+
+RateLimiter::RateLimiter() {
+    setLimit(RateLimitType::REQUEST_WEIGHT, 60, 6000);
+    setLimit(RateLimitType::ORDERS, 10, 100);
+    setLimit(RateLimitType::ORDERS, 86400, 200000);
+}
+
+int64_t RateLimiter::nowMilliseconds() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+RateLimiter::Limit* RateLimiter::find(RateLimitType type, int64_t intervalMs) {
+    for (size_t i = 0; i < limitCount_; ++i) {
+        if (limits_[i].type == type && limits_[i].intervalMs == intervalMs) {
+            return &limits_[i];
+        }
+    }
+    return nullptr;
+}
+
+const RateLimiter::Limit* RateLimiter::find(RateLimitType type, int64_t intervalMs) const {
+    return const_cast<RateLimiter*>(this)->find(type, intervalMs);
+}
+
+void RateLimiter::setLimit(RateLimitType type, int64_t intervalSeconds, int64_t limit) {
+    if (intervalSeconds <= 0 || limit <= 0 || limit > static_cast<int64_t>(USAGE_MASK)) {
+        throw std::invalid_argument("Invalid rate limit");
+    }
+    Limit* existing = find(type, intervalSeconds * 1000);
+    if (!existing) {
+        if (limitCount_ == MAX_LIMITS) {
+            throw std::invalid_argument("Too many rate limits");
+        }
+        existing = &limits_[limitCount_++];
+        existing->type = type;
+        existing->intervalMs = intervalSeconds * 1000;
+        existing->state.store(0);
+    }
+    existing->limit = limit;
+}
+
+void RateLimiter::setCancelReserve(double fraction) {
+    if (fraction < 0 || fraction > 1) {
+        throw std::invalid_argument("Cancel reserve must be between 0 and 1");
+    }
+    cancelReserve_ = fraction;
+}
+
+void RateLimiter::setMaxWait(int64_t milliseconds) {
+    maxWaitMs_ = milliseconds;
+}
+
+void RateLimiter::setEnabled(bool enabled) {
+    enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+void RateLimiter::release(size_t count, const int64_t* charged, int64_t nowMs) {
+    // Give back budget taken from the first count limits
+    for (size_t i = 0; i < count; ++i) {
+        if (charged[i] == 0) {
+            continue;
+        }
+        Limit& limit = limits_[i];
+        uint64_t window = static_cast<uint64_t>(nowMs / limit.intervalMs);
+        uint64_t state = limit.state.load(std::memory_order_relaxed);
+        for (;;) {
+            uint64_t used = usageIn(state, window);
+            if (used == 0) {
+                break;
+            }
+            uint64_t back = std::min<uint64_t>(used, static_cast<uint64_t>(charged[i]));
+            if (limit.state.compare_exchange_weak(state, pack(window, used - back),
+                                                  std::memory_order_relaxed)) {
+                break;
+            }
+        }
+    }
+}
+
+int64_t RateLimiter::tryAcquire(RequestPriority priority, int64_t weight, int64_t orders, int64_t nowMs) {
+    bool high = priority == RequestPriority::HIGH;
+    bool pacing = enabled_.load(std::memory_order_relaxed);
+    if (pacing) {
+        int64_t blockedUntil = blockedUntilMs_.load(std::memory_order_relaxed);
+        if (nowMs < blockedUntil) {
+            return blockedUntil - nowMs;
+        }
+        // Cancels waiting for budget go first
+        if (!high && highWaiting_.load(std::memory_order_acquire) > 0) {
+            return 1;
+        }
+    }
+
+    int64_t charged[MAX_LIMITS] = {};
+    for (size_t i = 0; i < limitCount_; ++i) {
+        Limit& limit = limits_[i];
+        int64_t cost = costFor(limit.type, weight, orders);
+        if (cost <= 0) {
+            continue;
+        }
+        int64_t capacity = limit.limit;
+        if (!high && limit.type == RateLimitType::REQUEST_WEIGHT) {
+            capacity -= static_cast<int64_t>(limit.limit * cancelReserve_);
+        }
+
+        uint64_t window = static_cast<uint64_t>(nowMs / limit.intervalMs);
+        uint64_t state = limit.state.load(std::memory_order_relaxed);
+        for (;;) {
+            uint64_t used = usageIn(state, window);
+            if (pacing && static_cast<int64_t>(used) + cost > capacity) {
+                release(i, charged, nowMs);
+                return limit.intervalMs - nowMs % limit.intervalMs;
+            }
+            if (limit.state.compare_exchange_weak(state, pack(window, used + cost),
+                                                  std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        charged[i] = cost;
+    }
+    return 0;
+}
+
+void RateLimiter::acquire(RequestPriority priority, int64_t weight, int64_t orders) {
+    int64_t now = nowMilliseconds();
+    int64_t wait = tryAcquire(priority, weight, orders, now);
+    if (wait == 0) {
+        return;
+    }
+
+    // Announce a waiting cancel so new orders stop taking its budget
+    struct HighWaiter {
+        std::atomic<int>* count;
+        ~HighWaiter() { if (count) count->fetch_sub(1, std::memory_order_release); }
+    } waiter{nullptr};
+    if (priority == RequestPriority::HIGH) {
+        highWaiting_.fetch_add(1, std::memory_order_release);
+        waiter.count = &highWaiting_;
+    }
+
+    int64_t deadline = now + maxWaitMs_;
+    while (wait > 0) {
+        if (now + wait > deadline) {
+            throw std::runtime_error("Rate limit: request would wait " + std::to_string(wait) +
+                                     " ms, more than the maximum of " + std::to_string(maxWaitMs_) + " ms");
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(wait));
+        now = nowMilliseconds();
+        wait = tryAcquire(priority, weight, orders, now);
+    }
+}
+
+void RateLimiter::update(const ResponseInfo& info, int64_t nowMs) {
+    for (size_t i = 0; i < info.usageCount; ++i) {
+        const RateLimitUsage& usage = info.usages[i];
+        Limit* limit = find(usage.type, usage.intervalSeconds * 1000);
+        if (!limit || usage.count < 0) {
+            continue;
+        }
+        uint64_t window = static_cast<uint64_t>(nowMs / limit->intervalMs);
+        uint64_t reported = std::min<uint64_t>(static_cast<uint64_t>(usage.count), USAGE_MASK);
+        uint64_t state = limit->state.load(std::memory_order_relaxed);
+        while (usageIn(state, window) < reported &&
+               !limit->state.compare_exchange_weak(state, pack(window, reported),
+                                                   std::memory_order_relaxed)) {
+        }
+    }
+
+    // 429 asks us to back off; 418 means the IP is already banned
+    if ((info.status == 429 || info.status == 418) && info.retryAfter >= 0) {
+        int64_t until = nowMs + info.retryAfter * 1000;
+        int64_t current = blockedUntilMs_.load(std::memory_order_relaxed);
+        while (current < until &&
+               !blockedUntilMs_.compare_exchange_weak(current, until, std::memory_order_relaxed)) {
+        }
+    }
+}
+
+int64_t RateLimiter::used(RateLimitType type, int64_t intervalSeconds, int64_t nowMs) const {
+    const Limit* limit = find(type, intervalSeconds * 1000);
+    if (!limit) {
+        return -1;
+    }
+    uint64_t window = static_cast<uint64_t>(nowMs / limit->intervalMs);
+    return static_cast<int64_t>(usageIn(limit->state.load(std::memory_order_relaxed), window));
+}
+
+} // namespace binance
@@ -0,0 +1,85 @@
+#include "../include/RequestBuilder.h"
+#include <charconv>
+#include <cstring>
+
+namespace binance {
+
+RequestBuilder::RequestBuilder()
+    : data_(inline_), size_(0), capacity_(INLINE_CAPACITY - 1), hasTimestamp_(false) {
+    inline_[0] = '\0';
+}
+
+char* RequestBuilder::grow(size_t extra) {
+    size_t needed = size_ + extra;
+    if (needed > capacity_) {
+        size_t capacity = capacity_ * 2 > needed ? capacity_ * 2 : needed;
+        std::unique_ptr<char[]> heap(new char[capacity + 1]);
+        std::memcpy(heap.get(), data_, size_);
+        heap_ = std::move(heap);
+        data_ = heap_.get();
+        capacity_ = capacity;
+    }
+    char* out = data_ + size_;
+    size_ = needed;
+    data_[size_] = '\0';
+    return out;
+}
+
+RequestBuilder& RequestBuilder::add(std::string_view key, std::string_view value) {
+    const size_t separator = size_ > 0 ? 1 : 0;
+    char* out = grow(separator + key.size() + 1 + value.size());
+    if (separator) {
+        *out++ = '&';
+    }
+    std::memcpy(out, key.data(), key.size());
+    out += key.size();
+    *out++ = '=';
+    std::memcpy(out, value.data(), value.size());
+
+    if (key == "timestamp") {
+        hasTimestamp_ = true;
+    }
+    return *this;
+}
+
+RequestBuilder& RequestBuilder::add(std::string_view key, int64_t value) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    return add(key, std::string_view(digits, result.ptr - digits));
+}
+
+RequestBuilder& RequestBuilder::add(std::string_view key, Decimal value) {
+    char digits[32];
+    auto result = to_chars(digits, digits + sizeof(digits), value);
+    return add(key, std::string_view(digits, result.ptr - digits));
+}
+
+RequestBuilder& RequestBuilder::addPair(std::string_view pair) {
+    const size_t separator = size_ > 0 ? 1 : 0;
+    char* out = grow(separator + pair.size());
+    if (separator) {
+        *out++ = '&';
+    }
+    std::memcpy(out, pair.data(), pair.size());
+    return *this;
+}
+
+RequestBuilder& RequestBuilder::add(const std::map<std::string, std::string>& params) {
+    for (const auto& param : params) {
+        add(param.first, param.second);
+    }
+    return *this;
+}
+
+RequestBuilder& RequestBuilder::append(std::string_view text) {
+    std::memcpy(grow(text.size()), text.data(), text.size());
+    return *this;
+}
+
+void RequestBuilder::clear() {
+    size_ = 0;
+    data_[0] = '\0';
+    hasTimestamp_ = false;
+}
+
+} // namespace binance
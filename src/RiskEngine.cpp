@@ -0,0 +1,281 @@
+#include "../include/RiskEngine.h"
+#include "../include/OrderStore.h"
+#include <algorithm>
+#include <climits>
+#include <stdexcept>
+#include <thread>
+
+namespace binance {
+
+namespace {
+
+uint64_t magnitudeOf(int64_t units) {
+    return units < 0 ? 0 - static_cast<uint64_t>(units) : static_cast<uint64_t>(units);
+}
+
+// Full 128-bit product of two 64-bit values, as high and low halves
+void multiplyWide(uint64_t a, uint64_t b, uint64_t& high, uint64_t& low) {
+    uint64_t aLow = a & 0xFFFFFFFF, aHigh = a >> 32;
+    uint64_t bLow = b & 0xFFFFFFFF, bHigh = b >> 32;
+    uint64_t lowLow = aLow * bLow;
+    uint64_t lowHigh = aLow * bHigh;
+    uint64_t highLow = aHigh * bLow;
+    uint64_t middle = (lowLow >> 32) + (lowHigh & 0xFFFFFFFF) + (highLow & 0xFFFFFFFF);
+    low = (middle << 32) | (lowLow & 0xFFFFFFFF);
+    high = aHigh * bHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+}
+
+// price * quantity against a notional limit, exactly: the product of two
+// Decimals can leave int64's range, and a wrapped product would pass
+bool exceedsNotional(Decimal price, Decimal quantity, int64_t maxNotional) {
+    uint64_t productHigh, productLow, limitHigh, limitLow;
+    multiplyWide(magnitudeOf(price.units()), magnitudeOf(quantity.units()), productHigh, productLow);
+    multiplyWide(static_cast<uint64_t>(maxNotional), Decimal::SCALE, limitHigh, limitLow);
+    return productHigh > limitHigh || (productHigh == limitHigh && productLow > limitLow);
+}
+
+// |price - last| against last * band, exactly: a band can be up to 21.47
+// times the last price, which for a large price leaves int64's range
+bool exceedsBand(Decimal price, Decimal last, int32_t band) {
+    // Unsigned, so the distance is exact even between prices of opposite sign
+    uint64_t distance = price > last
+        ? static_cast<uint64_t>(price.units()) - static_cast<uint64_t>(last.units())
+        : static_cast<uint64_t>(last.units()) - static_cast<uint64_t>(price.units());
+    uint64_t distanceHigh, distanceLow, boundHigh, boundLow;
+    multiplyWide(distance, Decimal::SCALE, distanceHigh, distanceLow);
+    multiplyWide(magnitudeOf(last.units()), static_cast<uint64_t>(band), boundHigh, boundLow);
+    return distanceHigh > boundHigh || (distanceHigh == boundHigh && distanceLow > boundLow);
+}
+
+} // namespace
+
+const char* toString(RiskResult result) {
+    switch (result) {
+        case RiskResult::OK: return "OK";
+        case RiskResult::UNKNOWN_SYMBOL: return "UNKNOWN_SYMBOL";
+        case RiskResult::ORDER_SIZE: return "ORDER_SIZE";
+        case RiskResult::NOTIONAL: return "NOTIONAL";
+        case RiskResult::PRICE_BAND: return "PRICE_BAND";
+        case RiskResult::NO_REFERENCE_PRICE: return "NO_REFERENCE_PRICE";
+        case RiskResult::OPEN_ORDERS: return "OPEN_ORDERS";
+        case RiskResult::POSITION: return "POSITION";
+    }
+    return "UNKNOWN";
+}
+
+// Holds a symbol's spin lock; the sections it guards are a few dozen instructions
+class RiskEngine::Guard {
+public:
+    explicit Guard(SymbolState& state) : state_(state) {
+        while (state_.locked.exchange(true, std::memory_order_acquire)) {
+            while (state_.locked.load(std::memory_order_relaxed)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    ~Guard() { state_.locked.store(false, std::memory_order_release); }
+
+    Guard(const Guard&) = delete;
+    Guard& operator=(const Guard&) = delete;
+
+private:
+    SymbolState& state_;
+};
+
+RiskEngine::RiskEngine(SymbolRegistry& registry) : registry_(registry) {
+}
+
+RiskEngine::~RiskEngine() = default;
+
+void RiskEngine::setLimits(std::string_view symbol, const RiskLimits& limits) {
+    if (limits.priceBand.units() < 0 || limits.priceBand.units() > INT32_MAX) {
+        throw std::invalid_argument("Price band must be between 0 and 21.47");
+    }
+    SymbolId id = registry_.intern(symbol);
+    if (id >= capacity_) {
+        size_t capacity = std::max<size_t>(64, capacity_ * 2);
+        while (capacity <= id) {
+            capacity *= 2;
+        }
+        std::unique_ptr<SymbolState[]> states(new SymbolState[capacity]);
+        std::unique_ptr<PriceLine[]> prices(new PriceLine[capacity]);
+        for (size_t i = 0; i < capacity_; ++i) {
+            SymbolState& from = states_[i];
+            SymbolState& to = states[i];
+            to.active = from.active;
+            to.maxOpenOrders = from.maxOpenOrders;
+            to.openOrders = from.openOrders;
+            to.maxOrderQty = from.maxOrderQty;
+            to.maxNotional = from.maxNotional;
+            to.priceBand = from.priceBand;
+            to.maxPosition = from.maxPosition;
+            to.position = from.position;
+            to.openBuyQty = from.openBuyQty;
+            to.openSellQty = from.openSellQty;
+            prices[i].price.store(prices_[i].price.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        states_ = std::move(states);
+        prices_ = std::move(prices);
+        capacity_ = capacity;
+    }
+
+    SymbolState& state = states_[id];
+    Guard guard(state);
+    state.active = true;
+    state.maxOrderQty = limits.maxOrderQty.units();
+    state.maxNotional = limits.maxNotional.units();
+    state.priceBand = static_cast<int32_t>(limits.priceBand.units());
+    state.maxOpenOrders = limits.maxOpenOrders;
+    state.maxPosition = limits.maxPosition.units();
+}
+
+RiskLimits RiskEngine::limits(SymbolId id) const {
+    RiskLimits limits;
+    if (id >= capacity_) return limits;
+    SymbolState& state = states_[id];
+    Guard guard(state);
+    limits.maxOrderQty = Decimal::fromUnits(state.maxOrderQty);
+    limits.maxNotional = Decimal::fromUnits(state.maxNotional);
+    limits.priceBand = Decimal::fromUnits(state.priceBand);
+    limits.maxOpenOrders = state.maxOpenOrders;
+    limits.maxPosition = Decimal::fromUnits(state.maxPosition);
+    return limits;
+}
+
+RiskResult RiskEngine::evaluate(const SymbolState& state, const std::atomic<int64_t>& lastPrice, OrderSide side,
+                                OrderType type, Decimal price, Decimal quantity, Decimal quoteQuantity) const {
+    if (!state.active) {
+        return RiskResult::UNKNOWN_SYMBOL;
+    }
+    if (state.maxOrderQty != 0 && quantity.units() > state.maxOrderQty) {
+        return RiskResult::ORDER_SIZE;
+    }
+
+    // Stop and take-profit orders without a limit price execute as market orders
+    bool priced = type != OrderType::MARKET && !price.isZero();
+    Decimal last = Decimal::fromUnits(lastPrice.load(std::memory_order_relaxed));
+    if (state.maxNotional != 0) {
+        if (!quantity.isZero()) {
+            if (!priced && last.isZero()) {
+                return RiskResult::NO_REFERENCE_PRICE;
+            }
+            if (exceedsNotional(priced ? price : last, quantity, state.maxNotional)) {
+                return RiskResult::NOTIONAL;
+            }
+        } else if (quoteQuantity.units() > state.maxNotional) {
+            return RiskResult::NOTIONAL;
+        }
+    }
+    if (state.priceBand != 0 && priced) {
+        if (last.isZero()) {
+            return RiskResult::NO_REFERENCE_PRICE;
+        }
+        if (exceedsBand(price, last, state.priceBand)) {
+            return RiskResult::PRICE_BAND;
+        }
+    }
+    if (state.maxOpenOrders != 0 && state.openOrders >= state.maxOpenOrders) {
+        return RiskResult::OPEN_ORDERS;
+    }
+    if (state.maxPosition != 0) {
+        // Worst case: every open order on this side fills, and so does this one.
+        // Compared as headroom, so a huge quantity cannot wrap the sum below the limit.
+        int64_t reached = side == OrderSide::BUY ? state.position + state.openBuyQty
+                                                 : state.openSellQty - state.position;
+        if (quantity.units() > state.maxPosition - reached) {
+            return RiskResult::POSITION;
+        }
+    }
+    return RiskResult::OK;
+}
+
+RiskResult RiskEngine::check(SymbolId id, OrderSide side, OrderType type, Decimal price, Decimal quantity,
+                             Decimal quoteQuantity) const {
+    if (id >= capacity_) {
+        return RiskResult::UNKNOWN_SYMBOL;
+    }
+    SymbolState& state = states_[id];
+    Guard guard(state);
+    return evaluate(state, prices_[id].price, side, type, price, quantity, quoteQuantity);
+}
+
+RiskResult RiskEngine::reserve(SymbolId id, OrderSide side, OrderType type, Decimal price, Decimal quantity,
+                               Decimal quoteQuantity) {
+    checked_.fetch_add(1, std::memory_order_relaxed);
+    RiskResult result = RiskResult::UNKNOWN_SYMBOL;
+    if (id < capacity_) {
+        SymbolState& state = states_[id];
+        Guard guard(state);
+        result = evaluate(state, prices_[id].price, side, type, price, quantity, quoteQuantity);
+        if (result == RiskResult::OK) {
+            ++state.openOrders;
+            (side == OrderSide::BUY ? state.openBuyQty : state.openSellQty) += quantity.units();
+            return result;
+        }
+    }
+    rejects_[static_cast<size_t>(result)].fetch_add(1, std::memory_order_relaxed);
+    return result;
+}
+
+void RiskEngine::close(SymbolState& state, OrderSide side, int64_t quantity) {
+    // Clamped, since orders placed elsewhere finish here without having been reserved
+    state.openOrders = std::max(0, state.openOrders - 1);
+    int64_t& open = side == OrderSide::BUY ? state.openBuyQty : state.openSellQty;
+    open = std::max<int64_t>(0, open - quantity);
+}
+
+void RiskEngine::release(SymbolId id, OrderSide side, Decimal quantity) {
+    if (id >= capacity_) return;
+    SymbolState& state = states_[id];
+    Guard guard(state);
+    close(state, side, quantity.units());
+}
+
+void RiskEngine::apply(const OrderUpdateEvent& update, const OrderExecution& fill) {
+    SymbolId id = registry_.find(update.symbol.view());
+    if (id >= capacity_) return;
+    SymbolState& state = states_[id];
+    Guard guard(state);
+
+    bool buy = update.side == OrderSide::BUY;
+    if (!fill.empty()) {
+        int64_t quantity = fill.quantity.units();
+        state.position += buy ? quantity : -quantity;
+        int64_t& open = buy ? state.openBuyQty : state.openSellQty;
+        open = std::max<int64_t>(0, open - quantity);
+    }
+    switch (update.status) {
+        case OrderStatus::FILLED:
+        case OrderStatus::CANCELED:
+        case OrderStatus::REJECTED:
+        case OrderStatus::EXPIRED:
+        case OrderStatus::EXPIRED_IN_MATCH:
+            close(state, update.side, (update.quantity - update.executedQty).units());
+            break;
+        default:
+            break;
+    }
+}
+
+void RiskEngine::setPosition(SymbolId id, Decimal position) {
+    if (id >= capacity_) return;
+    SymbolState& state = states_[id];
+    Guard guard(state);
+    state.position = position.units();
+}
+
+RiskExposure RiskEngine::exposure(SymbolId id) const {
+    RiskExposure exposure;
+    if (id >= capacity_) return exposure;
+    SymbolState& state = states_[id];
+    Guard guard(state);
+    exposure.position = Decimal::fromUnits(state.position);
+    exposure.openBuyQty = Decimal::fromUnits(state.openBuyQty);
+    exposure.openSellQty = Decimal::fromUnits(state.openSellQty);
+    exposure.openOrders = state.openOrders;
+    exposure.lastPrice = Decimal::fromUnits(prices_[id].price.load(std::memory_order_relaxed));
+    return exposure;
+}
+
+} // namespace binance
@@ -0,0 +1,547 @@
+#include "../include/Sha256.h"
+#include <atomic>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define BINANCE_SHA256_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+namespace {
+    using binance::Sha256;
+
+    // SHA-256 Constants
+    alignas(16) constexpr uint32_t K[64] = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+    };
+
+    // Helper functions for SHA-256
+    constexpr uint32_t rotr(uint32_t x, uint32_t n) {
+        return (x >> n) | (x << (32 - n));
+    }
+
+    constexpr uint32_t ch(uint32_t x, uint32_t y, uint32_t z) {
+        return (x & y) ^ (~x & z);
+    }
+
+    constexpr uint32_t maj(uint32_t x, uint32_t y, uint32_t z) {
+        return (x & y) ^ (x & z) ^ (y & z);
+    }
+
+    constexpr uint32_t sigma0(uint32_t x) {
+        return rotr(x, 2) ^ rotr(x, 13) ^ rotr(x, 22);
+    }
+
+    constexpr uint32_t sigma1(uint32_t x) {
+        return rotr(x, 6) ^ rotr(x, 11) ^ rotr(x, 25);
+    }
+
+    constexpr uint32_t gamma0(uint32_t x) {
+        return rotr(x, 7) ^ rotr(x, 18) ^ (x >> 3);
+    }
+
+    constexpr uint32_t gamma1(uint32_t x) {
+        return rotr(x, 17) ^ rotr(x, 19) ^ (x >> 10);
+    }
+
+    // Portable compression function
+    void compressScalar(Sha256::State& state, const uint8_t* blocks, size_t count) {
+        for (size_t n = 0; n < count; ++n, blocks += Sha256::BLOCK_SIZE) {
+            uint32_t w[64];
+
+            // Prepare the message schedule
+            for (int i = 0; i < 16; ++i) {
+                w[i] = static_cast<uint32_t>(blocks[i * 4]) << 24 |
+                       static_cast<uint32_t>(blocks[i * 4 + 1]) << 16 |
+                       static_cast<uint32_t>(blocks[i * 4 + 2]) << 8 |
+                       static_cast<uint32_t>(blocks[i * 4 + 3]);
+            }
+
+            for (int i = 16; i < 64; ++i) {
+                w[i] = gamma1(w[i-2]) + w[i-7] + gamma0(w[i-15]) + w[i-16];
+            }
+
+            // Initialize working variables
+            uint32_t a = state[0];
+            uint32_t b = state[1];
+            uint32_t c = state[2];
+            uint32_t d = state[3];
+            uint32_t e = state[4];
+            uint32_t f = state[5];
+            uint32_t g = state[6];
+            uint32_t h = state[7];
+
+            // Compression function main loop
+            for (int i = 0; i < 64; ++i) {
+                uint32_t temp1 = h + sigma1(e) + ch(e, f, g) + K[i] + w[i];
+                uint32_t temp2 = sigma0(a) + maj(a, b, c);
+
+                h = g;
+                g = f;
+                f = e;
+                e = d + temp1;
+                d = c;
+                c = b;
+                b = a;
+                a = temp1 + temp2;
+            }
+
+            // Update hash values
+            state[0] += a;
+            state[1] += b;
+            state[2] += c;
+            state[3] += d;
+            state[4] += e;
+            state[5] += f;
+            state[6] += g;
+            state[7] += h;
+        }
+    }
+
+#ifdef BINANCE_SHA256_X86
+    // Compression with the SHA extensions. The hardware works on the state
+    // split as ABEF / CDGH and performs two rounds per SHA256RNDS2.
+    __attribute__((target("sha,sse4.1")))
+    void compressShaNi(Sha256::State& state, const uint8_t* blocks, size_t count) {
+        const __m128i MASK = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+        // Load initial values
+        __m128i tmp = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0]));
+        __m128i state1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4]));
+
+        tmp = _mm_shuffle_epi32(tmp, 0xB1);              // CDAB
+        state1 = _mm_shuffle_epi32(state1, 0x1B);        // EFGH
+        __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);  // ABEF
+        state1 = _mm_blend_epi16(state1, tmp, 0xF0);     // CDGH
+
+        for (size_t n = 0; n < count; ++n, blocks += Sha256::BLOCK_SIZE) {
+            const __m128i abefSave = state0;
+            const __m128i cdghSave = state1;
+            __m128i msg[4];
+
+            // 16 groups of four rounds; the schedule rotates through msg[0..3]
+            for (int i = 0; i < 16; ++i) {
+                __m128i& cur = msg[i & 3];
+                if (i < 4) {
+                    cur = _mm_shuffle_epi8(
+                        _mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks + i * 16)), MASK);
+                }
+
+                __m128i m = _mm_add_epi32(cur, _mm_load_si128(reinterpret_cast<const __m128i*>(&K[i * 4])));
+                state1 = _mm_sha256rnds2_epu32(state1, state0, m);
+
+                if (i >= 3 && i <= 14) {
+                    __m128i& next = msg[(i + 1) & 3];
+                    next = _mm_add_epi32(next, _mm_alignr_epi8(cur, msg[(i + 3) & 3], 4));
+                    next = _mm_sha256msg2_epu32(next, cur);
+                }
+
+                m = _mm_shuffle_epi32(m, 0x0E);
+                state0 = _mm_sha256rnds2_epu32(state0, state1, m);
+
+                if (i >= 1 && i <= 12) {
+                    __m128i& prev = msg[(i + 3) & 3];
+                    prev = _mm_sha256msg1_epu32(prev, cur);
+                }
+            }
+
+            // Combine state
+            state0 = _mm_add_epi32(state0, abefSave);
+            state1 = _mm_add_epi32(state1, cdghSave);
+        }
+
+        tmp = _mm_shuffle_epi32(state0, 0x1B);           // FEBA
+        state1 = _mm_shuffle_epi32(state1, 0xB1);        // DCHG
+        state0 = _mm_blend_epi16(tmp, state1, 0xF0);     // DCBA
+        state1 = _mm_alignr_epi8(state1, tmp, 8);        // ABEF
+
+        // Save state
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), state0);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), state1);
+    }
+
+    bool cpuHasShaNi() {
+        unsigned int eax, ebx, ecx, edx;
+        if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+            return false;
+        }
+        const bool ssse3 = (ecx & (1u << 9)) != 0;
+        const bool sse41 = (ecx & (1u << 19)) != 0;
+        if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+            return false;
+        }
+        const bool sha = (ebx & (1u << 29)) != 0;
+        return ssse3 && sse41 && sha;
+    }
+
+    bool cpuHasAvx2() {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+    }
+
+    // Eight-lane SHA-256: lane i of every register belongs to message i
+    __attribute__((target("avx2")))
+    inline __m256i rotr8(__m256i x, int n) {
+        return _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n));
+    }
+
+    __attribute__((target("avx2")))
+    inline uint32_t loadBigEndian(const uint8_t* p) {
+        uint32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return __builtin_bswap32(v);
+    }
+
+    __attribute__((target("avx2")))
+    void compressAvx2x8(__m256i state[8], const uint8_t* const blocks[8]) {
+        __m256i w[16];
+        for (int i = 0; i < 16; ++i) {
+            w[i] = _mm256_setr_epi32(
+                loadBigEndian(blocks[0] + i * 4), loadBigEndian(blocks[1] + i * 4),
+                loadBigEndian(blocks[2] + i * 4), loadBigEndian(blocks[3] + i * 4),
+                loadBigEndian(blocks[4] + i * 4), loadBigEndian(blocks[5] + i * 4),
+                loadBigEndian(blocks[6] + i * 4), loadBigEndian(blocks[7] + i * 4));
+        }
+
+        __m256i a = state[0], b = state[1], c = state[2], d = state[3];
+        __m256i e = state[4], f = state[5], g = state[6], h = state[7];
+
+        for (int i = 0; i < 64; ++i) {
+            __m256i wi;
+            if (i < 16) {
+                wi = w[i];
+            } else {
+                // w[i] = gamma1(w[i-2]) + w[i-7] + gamma0(w[i-15]) + w[i-16], kept in a 16-entry ring
+                __m256i w2 = w[(i - 2) & 15];
+                __m256i w15 = w[(i - 15) & 15];
+                __m256i g1 = _mm256_xor_si256(_mm256_xor_si256(rotr8(w2, 17), rotr8(w2, 19)),
+                                              _mm256_srli_epi32(w2, 10));
+                __m256i g0 = _mm256_xor_si256(_mm256_xor_si256(rotr8(w15, 7), rotr8(w15, 18)),
+                                              _mm256_srli_epi32(w15, 3));
+                wi = _mm256_add_epi32(_mm256_add_epi32(g1, w[(i - 7) & 15]),
+                                      _mm256_add_epi32(g0, w[i & 15]));
+                w[i & 15] = wi;
+            }
+
+            __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(rotr8(e, 6), rotr8(e, 11)), rotr8(e, 25));
+            __m256i chv = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+            __m256i temp1 = _mm256_add_epi32(_mm256_add_epi32(h, s1),
+                                             _mm256_add_epi32(chv, _mm256_add_epi32(
+                                                 _mm256_set1_epi32(static_cast<int>(K[i])), wi)));
+            __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(rotr8(a, 2), rotr8(a, 13)), rotr8(a, 22));
+            __m256i majv = _mm256_xor_si256(_mm256_xor_si256(_mm256_and_si256(a, b), _mm256_and_si256(a, c)),
+                                            _mm256_and_si256(b, c));
+            __m256i temp2 = _mm256_add_epi32(s0, majv);
+
+            h = g;
+            g = f;
+            f = e;
+            e = _mm256_add_epi32(d, temp1);
+            d = c;
+            c = b;
+            b = a;
+            a = _mm256_add_epi32(temp1, temp2);
+        }
+
+        state[0] = _mm256_add_epi32(state[0], a);
+        state[1] = _mm256_add_epi32(state[1], b);
+        state[2] = _mm256_add_epi32(state[2], c);
+        state[3] = _mm256_add_epi32(state[3], d);
+        state[4] = _mm256_add_epi32(state[4], e);
+        state[5] = _mm256_add_epi32(state[5], f);
+        state[6] = _mm256_add_epi32(state[6], g);
+        state[7] = _mm256_add_epi32(state[7], h);
+    }
+
+    // Finish up to eight messages together. Lanes whose message has fewer
+    // blocks hash a dummy block and have their state restored by a blend.
+    __attribute__((target("avx2")))
+    void finishAvx2x8(const Sha256::State& midstate, uint64_t absorbed,
+                      const uint8_t* const* messages, const size_t* lengths,
+                      size_t count, Sha256::Digest* digests) {
+        alignas(32) static const uint8_t dummy[Sha256::BLOCK_SIZE] = {};
+        uint8_t tails[Sha256::MAX_LANES][Sha256::BLOCK_SIZE * 2];
+        size_t fullBlocks[Sha256::MAX_LANES] = {};
+        alignas(32) int32_t totalBlocks[Sha256::MAX_LANES] = {};
+
+        size_t maxBlocks = 0;
+        for (size_t lane = 0; lane < count; ++lane) {
+            size_t len = lengths[lane];
+            size_t rem = len % Sha256::BLOCK_SIZE;
+            fullBlocks[lane] = len / Sha256::BLOCK_SIZE;
+
+            // Pad the tail: 1 bit, zeros, then the total length in bits
+            uint8_t* tail = tails[lane];
+            std::memset(tail, 0, sizeof(tails[lane]));
+            std::memcpy(tail, messages[lane] + fullBlocks[lane] * Sha256::BLOCK_SIZE, rem);
+            tail[rem] = 0x80;
+            size_t tailLen = rem + 9 > Sha256::BLOCK_SIZE ? Sha256::BLOCK_SIZE * 2 : Sha256::BLOCK_SIZE;
+            uint64_t bitsLen = (absorbed + len) * 8;
+            for (int i = 0; i < 8; ++i) {
+                tail[tailLen - 8 + i] = (bitsLen >> (56 - i * 8)) & 0xFF;
+            }
+
+            totalBlocks[lane] = static_cast<int32_t>(fullBlocks[lane] + tailLen / Sha256::BLOCK_SIZE);
+            if (static_cast<size_t>(totalBlocks[lane]) > maxBlocks) {
+                maxBlocks = totalBlocks[lane];
+            }
+        }
+
+        __m256i state[8];
+        for (int i = 0; i < 8; ++i) {
+            state[i] = _mm256_set1_epi32(static_cast<int>(midstate[i]));
+        }
+        const __m256i laneBlocks = _mm256_load_si256(reinterpret_cast<const __m256i*>(totalBlocks));
+
+        for (size_t block = 0; block < maxBlocks; ++block) {
+            const uint8_t* ptrs[Sha256::MAX_LANES];
+            for (size_t lane = 0; lane < Sha256::MAX_LANES; ++lane) {
+                if (lane >= count || block >= static_cast<size_t>(totalBlocks[lane])) {
+                    ptrs[lane] = dummy;
+                } else if (block < fullBlocks[lane]) {
+                    ptrs[lane] = messages[lane] + block * Sha256::BLOCK_SIZE;
+                } else {
+                    ptrs[lane] = tails[lane] + (block - fullBlocks[lane]) * Sha256::BLOCK_SIZE;
+                }
+            }
+
+            __m256i saved[8];
+            for (int i = 0; i < 8; ++i) {
+                saved[i] = state[i];
+            }
+            compressAvx2x8(state, ptrs);
+
+            // Keep the new state only in lanes that still had a block to hash
+            __m256i active = _mm256_cmpgt_epi32(laneBlocks, _mm256_set1_epi32(static_cast<int>(block)));
+            for (int i = 0; i < 8; ++i) {
+                state[i] = _mm256_blendv_epi8(saved[i], state[i], active);
+            }
+        }
+
+        alignas(32) uint32_t words[8][Sha256::MAX_LANES];
+        for (int i = 0; i < 8; ++i) {
+            _mm256_store_si256(reinterpret_cast<__m256i*>(words[i]), state[i]);
+        }
+        for (size_t lane = 0; lane < count; ++lane) {
+            for (int i = 0; i < 8; ++i) {
+                uint32_t h = words[i][lane];
+                digests[lane][i * 4] = (h >> 24) & 0xFF;
+                digests[lane][i * 4 + 1] = (h >> 16) & 0xFF;
+                digests[lane][i * 4 + 2] = (h >> 8) & 0xFF;
+                digests[lane][i * 4 + 3] = h & 0xFF;
+            }
+        }
+    }
+#endif
+
+    using CompressFn = void (*)(Sha256::State&, const uint8_t*, size_t);
+
+    CompressFn backendFunction(Sha256::Backend backend) {
+        switch (backend) {
+#ifdef BINANCE_SHA256_X86
+            case Sha256::Backend::SHA_NI: return compressShaNi;
+#endif
+            default: return compressScalar;
+        }
+    }
+
+    Sha256::Backend detectBackend() {
+#ifdef BINANCE_SHA256_X86
+        if (cpuHasShaNi()) {
+            return Sha256::Backend::SHA_NI;
+        }
+#endif
+        return Sha256::Backend::SCALAR;
+    }
+
+    void compressResolve(Sha256::State& state, const uint8_t* blocks, size_t count);
+
+    // Starts out pointing at the resolver, which installs the real backend on first use.
+    // Constant-initialized, so it is valid even during static initialization of other files.
+    std::atomic<CompressFn> activeCompress{compressResolve};
+    std::atomic<Sha256::Backend> activeBackendId{Sha256::Backend::SCALAR};
+
+    // 0 = not yet decided, 1 = enabled, 2 = disabled
+    std::atomic<int> multiBufferMode{0};
+
+    bool multiBufferDefault() {
+#ifdef BINANCE_SHA256_X86
+        return cpuHasAvx2();
+#else
+        return false;
+#endif
+    }
+
+    void compressResolve(Sha256::State& state, const uint8_t* blocks, size_t count) {
+        Sha256::Backend backend = detectBackend();
+        activeBackendId.store(backend, std::memory_order_relaxed);
+        activeCompress.store(backendFunction(backend), std::memory_order_relaxed);
+        backendFunction(backend)(state, blocks, count);
+    }
+}
+
+namespace binance {
+
+const Sha256::State Sha256::INITIAL_STATE = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+Sha256::Sha256() : Sha256(INITIAL_STATE, 0) {}
+
+Sha256::Sha256(const State& midstate, uint64_t absorbed)
+    : state_(midstate), length_(absorbed), buffered_(0) {
+}
+
+void Sha256::update(const void* data, size_t len) {
+    const uint8_t* msg = static_cast<const uint8_t*>(data);
+    length_ += len;
+
+    // Top up a partially filled block first
+    if (buffered_ > 0) {
+        size_t take = BLOCK_SIZE - buffered_ < len ? BLOCK_SIZE - buffered_ : len;
+        std::memcpy(buffer_ + buffered_, msg, take);
+        buffered_ += take;
+        msg += take;
+        len -= take;
+        if (buffered_ < BLOCK_SIZE) {
+            return;
+        }
+        compress(state_, buffer_, 1);
+        buffered_ = 0;
+    }
+
+    // Whole blocks are hashed straight from the caller's buffer
+    size_t blocks = len / BLOCK_SIZE;
+    if (blocks > 0) {
+        compress(state_, msg, blocks);
+        msg += blocks * BLOCK_SIZE;
+        len -= blocks * BLOCK_SIZE;
+    }
+
+    std::memcpy(buffer_, msg, len);
+    buffered_ = len;
+}
+
+Sha256::Digest Sha256::finish() {
+    // Pre-processing: append 1 bit followed by zeros and the length in bits
+    uint8_t tail[BLOCK_SIZE * 2] = {};
+    std::memcpy(tail, buffer_, buffered_);
+    tail[buffered_] = 0x80;
+    size_t tailLen = buffered_ + 9 > BLOCK_SIZE ? BLOCK_SIZE * 2 : BLOCK_SIZE;
+
+    uint64_t bitsLen = length_ * 8;
+    for (int i = 0; i < 8; ++i) {
+        tail[tailLen - 8 + i] = (bitsLen >> (56 - i * 8)) & 0xFF;
+    }
+    compress(state_, tail, tailLen / BLOCK_SIZE);
+
+    // Produce the final hash value
+    Digest hash;
+    int idx = 0;
+    for (uint32_t h : state_) {
+        hash[idx++] = (h >> 24) & 0xFF;
+        hash[idx++] = (h >> 16) & 0xFF;
+        hash[idx++] = (h >> 8) & 0xFF;
+        hash[idx++] = h & 0xFF;
+    }
+    return hash;
+}
+
+Sha256::Digest Sha256::hash(const void* data, size_t len) {
+    Sha256 sha;
+    sha.update(data, len);
+    return sha.finish();
+}
+
+void Sha256::compress(State& state, const uint8_t* blocks, size_t count) {
+    activeCompress.load(std::memory_order_relaxed)(state, blocks, count);
+}
+
+void Sha256::finishMany(const State& midstate, uint64_t absorbed,
+                        const uint8_t* const* messages, const size_t* lengths,
+                        size_t count, Digest* digests) {
+#ifdef BINANCE_SHA256_X86
+    if (count > 1 && isMultiBufferEnabled()) {
+        for (size_t first = 0; first < count; first += MAX_LANES) {
+            size_t lanes = count - first < MAX_LANES ? count - first : MAX_LANES;
+            finishAvx2x8(midstate, absorbed, messages + first, lengths + first, lanes, digests + first);
+        }
+        return;
+    }
+#endif
+    for (size_t i = 0; i < count; ++i) {
+        Sha256 sha(midstate, absorbed);
+        sha.update(messages[i], lengths[i]);
+        digests[i] = sha.finish();
+    }
+}
+
+bool Sha256::isMultiBufferSupported() {
+#ifdef BINANCE_SHA256_X86
+    return cpuHasAvx2();
+#else
+    return false;
+#endif
+}
+
+bool Sha256::isMultiBufferEnabled() {
+    int mode = multiBufferMode.load(std::memory_order_relaxed);
+    if (mode == 0) {
+        mode = multiBufferDefault() ? 1 : 2;
+        multiBufferMode.store(mode, std::memory_order_relaxed);
+    }
+    return mode == 1;
+}
+
+bool Sha256::setMultiBuffer(bool enabled) {
+    if (enabled && !isMultiBufferSupported()) {
+        return false;
+    }
+    multiBufferMode.store(enabled ? 1 : 2, std::memory_order_relaxed);
+    return true;
+}
+
+Sha256::Backend Sha256::activeBackend() {
+    if (activeCompress.load(std::memory_order_relaxed) == compressResolve) {
+        return detectBackend();
+    }
+    return activeBackendId.load(std::memory_order_relaxed);
+}
+
+bool Sha256::isSupported(Backend backend) {
+    switch (backend) {
+        case Backend::SCALAR: return true;
+#ifdef BINANCE_SHA256_X86
+        case Backend::SHA_NI: return cpuHasShaNi();
+#endif
+        default: return false;
+    }
+}
+
+bool Sha256::setBackend(Backend backend) {
+    if (!isSupported(backend)) {
+        return false;
+    }
+    activeBackendId.store(backend, std::memory_order_relaxed);
+    activeCompress.store(backendFunction(backend), std::memory_order_relaxed);
+    return true;
+}
+
+const char* toString(Sha256::Backend backend) {
+    switch (backend) {
+        case Sha256::Backend::SCALAR: return "scalar";
+        case Sha256::Backend::SHA_NI: return "sha-ni";
+        default: return "unknown";
+    }
+}
+
+} // namespace binance
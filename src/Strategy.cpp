@@ -0,0 +1,29 @@
+#include "../include/Strategy.h"
+#include <stdexcept>
+
+namespace binance {
+
+StrategyContext& Strategy::context() const {
+    if (!context_) {
+        throw std::runtime_error("Strategy is not attached to a runtime");
+    }
+    return *context_;
+}
+
+OrderGateway& Strategy::orders() {
+    return context().orderGateway();
+}
+
+TimerId Strategy::scheduleTimer(int64_t delayMicros, int64_t periodMicros) {
+    return context().scheduleTimer(*this, delayMicros, periodMicros);
+}
+
+void Strategy::cancelTimer(TimerId id) {
+    context().cancelTimer(id);
+}
+
+int64_t Strategy::now() const {
+    return context().nowMicros();
+}
+
+} // namespace binance
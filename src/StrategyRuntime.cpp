@@ -0,0 +1,493 @@
+#include "../include/StrategyRuntime.h"
+#include "../include/OrderBook.h"
+#include "../include/OrderGateway.h"
+#include "../include/OrderStore.h"
+#include "../include/PositionTracker.h"
+#include "../include/RiskEngine.h"
+#include "../include/SymbolRegistry.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include <pthread.h>
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace binance {
+
+namespace {
+
+// Events taken from one queue before moving on, so a busy feed cannot starve the others
+constexpr size_t BATCH_SIZE = 64;
+
+void pinThread(std::thread::native_handle_type thread, int cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    int error = pthread_setaffinity_np(thread, sizeof(set), &set);
+    if (error != 0) {
+        throw std::runtime_error("Failed to pin strategy thread to CPU " + std::to_string(cpu) + ": " +
+                                 std::strerror(error));
+    }
+#else
+    (void)thread;
+    throw std::runtime_error("Pinning threads to a CPU is not supported on this platform");
+#endif
+}
+
+void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+} // namespace
+
+// Implementation class using the PIMPL idiom
+class StrategyRuntime::Impl : public StrategyContext {
+public:
+    Impl() : orderSink([this](const OrderUpdateEvent& update) { dispatch(update); }) {}
+
+    ~Impl() override {
+        stop();
+    }
+
+    void addStrategy(Strategy& strategy) {
+        requireStopped();
+        strategy.bind(this);
+        strategies.push_back(&strategy);
+    }
+
+    void addMarketData(std::shared_ptr<MarketEventQueue> queue) {
+        requireStopped();
+        marketQueues.push_back(std::move(queue));
+    }
+
+    void addOrderUpdates(std::shared_ptr<OrderUpdateQueue> queue) {
+        requireStopped();
+        orderQueues.push_back(std::move(queue));
+    }
+
+    void addBalanceUpdates(std::shared_ptr<BalanceUpdateQueue> queue) {
+        requireStopped();
+        balanceQueues.push_back(std::move(queue));
+    }
+
+    OrderStore& trackOrders(size_t capacity) {
+        requireStopped();
+        if (!orderStore || orderStore->capacity() != capacity) {
+            orderStore = std::make_unique<OrderStore>(capacity);
+        }
+        return *orderStore;
+    }
+
+    PositionTracker& trackPositions() {
+        requireStopped();
+        if (!orderStore) {
+            orderStore = std::make_unique<OrderStore>();
+        }
+        if (!positions) {
+            positions = std::make_unique<PositionTracker>(&symbols);
+        }
+        return *positions;
+    }
+
+    void trackRisk(RiskEngine& engine) {
+        requireStopped();
+        if (!orderStore) {
+            orderStore = std::make_unique<OrderStore>();
+        }
+        risk = &engine;
+    }
+
+    void setOrderGateway(OrderGateway& newGateway) {
+        requireStopped();
+        gateway = &newGateway;
+    }
+
+    OrderBook& trackOrderBook(const std::string& symbol, Decimal tickSize,
+                              std::function<DepthSnapshot()> snapshotSource) {
+        requireStopped();
+        books.push_back(std::make_unique<OrderBook>(symbol, tickSize));
+        if (snapshotSource) {
+            books.back()->setSnapshotSource(std::move(snapshotSource));
+        }
+        SymbolId id = symbols.intern(symbol);
+        if (id >= booksById.size()) {
+            booksById.resize(id + 1, nullptr);
+        }
+        if (!booksById[id]) {
+            booksById[id] = books.back().get();  // The first book tracked for a symbol gets its updates
+        }
+        return *books.back();
+    }
+
+    void setCpu(int newCpu) {
+        requireStopped();
+        cpu = newCpu;
+    }
+
+    void setIdleMode(IdleMode mode) {
+        idleMode = mode;
+    }
+
+    void run() {
+        if (running.exchange(true)) {
+            throw std::runtime_error("Strategy runtime is already running");
+        }
+        try {
+            if (cpu >= 0) {
+                pinThread(pthread_self(), cpu);
+            }
+        } catch (...) {
+            running = false;
+            throw;
+        }
+        loop();
+    }
+
+    void start() {
+        if (running.exchange(true)) {
+            return;
+        }
+        if (loopThread.joinable()) {
+            loopThread.join();  // Finished after a stop() from inside a callback
+        }
+        loopThread = std::thread(&Impl::loop, this);
+        if (cpu >= 0) {
+            try {
+                pinThread(loopThread.native_handle(), cpu);
+            } catch (...) {
+                stop();
+                throw;
+            }
+        }
+    }
+
+    void stop() {
+        running = false;
+        if (loopThread.joinable() && loopThread.get_id() != std::this_thread::get_id()) {
+            loopThread.join();
+        }
+    }
+
+    bool isRunning() const {
+        return running;
+    }
+
+    uint64_t eventsDispatched() const {
+        return dispatched.load(std::memory_order_relaxed);
+    }
+
+    uint64_t callbackErrors() const {
+        return errors.load(std::memory_order_relaxed);
+    }
+
+    // StrategyContext
+
+    OrderGateway& orderGateway() override {
+        if (!gateway) {
+            throw std::runtime_error("No order gateway configured");
+        }
+        return *gateway;
+    }
+
+    TimerId scheduleTimer(Strategy& strategy, int64_t delayMicros, int64_t periodMicros) override {
+        TimerId id = ++lastTimerId;
+        timers.push(Timer{nowMicros() + std::max<int64_t>(delayMicros, 0), id, &strategy,
+                          std::max<int64_t>(periodMicros, 0)});
+        return id;
+    }
+
+    void cancelTimer(TimerId id) override {
+        if (id != 0 && id <= lastTimerId) {
+            cancelledTimers.insert(id);
+        }
+    }
+
+    int64_t nowMicros() const override {
+        return StrategyRuntime::nowMicros();
+    }
+
+private:
+    struct Timer {
+        int64_t deadline;
+        TimerId id;
+        Strategy* strategy;
+        int64_t period;
+
+        bool operator>(const Timer& other) const {
+            return deadline != other.deadline ? deadline > other.deadline : id > other.id;
+        }
+    };
+
+    std::vector<Strategy*> strategies;
+    std::vector<std::shared_ptr<MarketEventQueue>> marketQueues;
+    std::vector<std::shared_ptr<OrderUpdateQueue>> orderQueues;
+    std::vector<std::shared_ptr<BalanceUpdateQueue>> balanceQueues;
+    std::vector<std::unique_ptr<OrderBook>> books;
+    SymbolRegistry symbols;                  // Symbols of the tracked books
+    std::vector<OrderBook*> booksById;       // Indexed by SymbolId
+    std::unique_ptr<OrderStore> orderStore;
+    std::unique_ptr<PositionTracker> positions;
+    RiskEngine* risk = nullptr;
+    OrderGateway* gateway = nullptr;
+    std::function<void(const OrderUpdateEvent&)> orderSink;
+    int cpu = -1;
+    std::atomic<IdleMode> idleMode{IdleMode::YIELD};
+
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> timers;
+    std::unordered_set<TimerId> cancelledTimers;
+    TimerId lastTimerId = 0;
+
+    std::atomic<bool> running{false};
+    std::thread loopThread;
+    std::atomic<uint64_t> dispatched{0};
+    std::atomic<uint64_t> errors{0};
+
+    // Counters have a single writer, so a plain store is enough
+    static void increment(std::atomic<uint64_t>& counter, uint64_t by = 1) {
+        counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+    }
+
+    void requireStopped() const {
+        if (running) {
+            throw std::runtime_error("Strategy runtime must be configured before it starts");
+        }
+    }
+
+    template <typename Callback>
+    void each(Callback&& callback) {
+        for (Strategy* strategy : strategies) {
+            try {
+                callback(*strategy);
+            } catch (const std::exception&) {
+                increment(errors);
+            }
+        }
+    }
+
+    void loop() {
+        each([](Strategy& strategy) { strategy.onStart(); });
+
+        MarketEvent event;
+        OrderUpdateEvent update;
+        BalanceUpdateEvent balance;
+        while (running.load(std::memory_order_relaxed)) {
+            size_t work = 0;
+            for (const auto& queue : marketQueues) {
+                for (size_t n = 0; n < BATCH_SIZE && queue->tryPop(event); ++n) {
+                    dispatch(event);
+                    ++work;
+                }
+            }
+            for (const auto& queue : orderQueues) {
+                for (size_t n = 0; n < BATCH_SIZE && queue->tryPop(update); ++n) {
+                    dispatch(update);
+                    ++work;
+                }
+            }
+            for (const auto& queue : balanceQueues) {
+                for (size_t n = 0; n < BATCH_SIZE && queue->tryPop(balance); ++n) {
+                    dispatch(balance);
+                    ++work;
+                }
+            }
+            if (gateway) {
+                try {
+                    work += gateway->poll(orderSink);
+                } catch (const std::exception&) {
+                    increment(errors);
+                }
+            }
+            if (!timers.empty()) {
+                work += fireTimers();
+            }
+
+            if (work == 0) {
+                if (idleMode.load(std::memory_order_relaxed) == IdleMode::SPIN) {
+                    cpuRelax();
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        each([](Strategy& strategy) { strategy.onStop(); });
+    }
+
+    void dispatch(const MarketEvent& event) {
+        increment(dispatched);
+        if (const auto* trade = std::get_if<TradeEvent>(&event)) {
+            if (risk) {
+                risk->onTrade(risk->registry().find(trade->symbol.view()), trade->price);
+            }
+            each([trade](Strategy& strategy) { strategy.onTrade(*trade); });
+        } else if (const auto* ticker = std::get_if<BookTickerEvent>(&event)) {
+            each([ticker](Strategy& strategy) { strategy.onBookTicker(*ticker); });
+        } else if (const auto* depth = std::get_if<DepthUpdateEvent>(&event)) {
+            dispatch(*depth);
+        } else if (const auto* kline = std::get_if<KlineEvent>(&event)) {
+            each([kline](Strategy& strategy) { strategy.onKline(*kline); });
+        }
+    }
+
+    void dispatch(const DepthUpdateEvent& depth) {
+        SymbolId id = symbols.find(depth.symbol.view());
+        if (id >= booksById.size() || !booksById[id]) {
+            return;
+        }
+        OrderBook* book = booksById[id];
+        DepthApplyResult result;
+        try {
+            result = book->apply(depth);
+        } catch (const std::exception&) {
+            increment(errors);  // The snapshot fetch failed; the next update retries
+            return;
+        }
+        if (result == DepthApplyResult::APPLIED && depth.last && book->isSynced()) {
+            const OrderBook& current = *book;
+            each([&current](Strategy& strategy) { strategy.onBookUpdate(current); });
+        }
+    }
+
+    void dispatch(const OrderUpdateEvent& update) {
+        if (orderStore) {
+            OrderExecution fill;
+            OrderApplyResult result = orderStore->apply(update, &fill);
+            if (result == OrderApplyResult::STALE) {
+                return;  // Already reported, e.g. by the response after the stream
+            }
+            if (risk && result == OrderApplyResult::APPLIED) {
+                risk->apply(update, fill);
+            }
+            if (positions && !fill.empty()) {
+                positions->applyFill(update.symbol.view(), update.side, fill);
+            }
+        }
+        increment(dispatched);
+        each([&update](Strategy& strategy) { strategy.onOrderUpdate(update); });
+    }
+
+    void dispatch(const BalanceUpdateEvent& balance) {
+        if (positions) {
+            positions->apply(balance);
+        }
+        increment(dispatched);
+        each([&balance](Strategy& strategy) { strategy.onBalanceUpdate(balance); });
+    }
+
+    size_t fireTimers() {
+        size_t fired = 0;
+        int64_t now = nowMicros();
+        while (!timers.empty() && timers.top().deadline <= now) {
+            Timer timer = timers.top();
+            timers.pop();
+            if (!cancelledTimers.empty() && cancelledTimers.erase(timer.id) != 0) {
+                continue;
+            }
+            if (timer.period > 0) {
+                // Keep the cadence, but skip ticks missed while the loop was busy
+                timer.deadline += timer.period;
+                if (timer.deadline <= now) {
+                    timer.deadline = now + timer.period;
+                }
+                timers.push(timer);
+            }
+            try {
+                timer.strategy->onTimer(timer.id);
+            } catch (const std::exception&) {
+                increment(errors);
+            }
+            ++fired;
+        }
+        return fired;
+    }
+};
+
+StrategyRuntime::StrategyRuntime() : pImpl(std::make_unique<Impl>()) {}
+
+StrategyRuntime::~StrategyRuntime() = default;
+
+void StrategyRuntime::addStrategy(Strategy& strategy) {
+    pImpl->addStrategy(strategy);
+}
+
+void StrategyRuntime::addMarketData(std::shared_ptr<MarketEventQueue> queue) {
+    pImpl->addMarketData(std::move(queue));
+}
+
+void StrategyRuntime::addOrderUpdates(std::shared_ptr<OrderUpdateQueue> queue) {
+    pImpl->addOrderUpdates(std::move(queue));
+}
+
+void StrategyRuntime::addBalanceUpdates(std::shared_ptr<BalanceUpdateQueue> queue) {
+    pImpl->addBalanceUpdates(std::move(queue));
+}
+
+OrderStore& StrategyRuntime::trackOrders(size_t capacity) {
+    return pImpl->trackOrders(capacity);
+}
+
+PositionTracker& StrategyRuntime::trackPositions() {
+    return pImpl->trackPositions();
+}
+
+void StrategyRuntime::trackRisk(RiskEngine& risk) {
+    pImpl->trackRisk(risk);
+}
+
+void StrategyRuntime::setOrderGateway(OrderGateway& gateway) {
+    pImpl->setOrderGateway(gateway);
+}
+
+OrderBook& StrategyRuntime::trackOrderBook(const std::string& symbol, Decimal tickSize,
+                                           std::function<DepthSnapshot()> snapshotSource) {
+    return pImpl->trackOrderBook(symbol, tickSize, std::move(snapshotSource));
+}
+
+void StrategyRuntime::setCpu(int cpu) {
+    pImpl->setCpu(cpu);
+}
+
+void StrategyRuntime::setIdleMode(IdleMode mode) {
+    pImpl->setIdleMode(mode);
+}
+
+void StrategyRuntime::run() {
+    pImpl->run();
+}
+
+void StrategyRuntime::start() {
+    pImpl->start();
+}
+
+void StrategyRuntime::stop() {
+    pImpl->stop();
+}
+
+bool StrategyRuntime::isRunning() const {
+    return pImpl->isRunning();
+}
+
+uint64_t StrategyRuntime::eventsDispatched() const {
+    return pImpl->eventsDispatched();
+}
+
+uint64_t StrategyRuntime::callbackErrors() const {
+    return pImpl->callbackErrors();
+}
+
+int64_t StrategyRuntime::nowMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace binance
@@ -0,0 +1,78 @@
+#include "../include/SymbolRegistry.h"
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace binance {
+
+SymbolRegistry::SymbolRegistry() : table_(64, INVALID_SYMBOL), mask_(63) {
+}
+
+SymbolId SymbolRegistry::intern(std::string_view symbol) {
+    if (symbol.empty()) {
+        throw std::invalid_argument("Symbol must not be empty");
+    }
+    SymbolName name;
+    name.assign(symbol);
+    uint32_t hash = hashName(name.view());
+    size_t i = hash & mask_;
+    for (; table_[i] != INVALID_SYMBOL; i = (i + 1) & mask_) {
+        if (entries_[table_[i]].name.view() == name.view()) return table_[i];
+    }
+    if (entries_.size() == MAX_SYMBOLS) {
+        throw std::length_error("Symbol registry is full");
+    }
+
+    SymbolId id = static_cast<SymbolId>(entries_.size());
+    Entry entry;
+    entry.name = name;
+    std::string_view stored = name.view();
+    std::memcpy(entry.param, "symbol=", 7);
+    std::memcpy(entry.param + 7, stored.data(), stored.size());
+    entry.paramSize = static_cast<uint8_t>(7 + stored.size());
+    entries_.push_back(entry);
+    table_[i] = id;
+    // Keep the table at most half full, so probe runs stay short
+    if (entries_.size() * 2 > table_.size()) {
+        grow();
+    }
+    return id;
+}
+
+SymbolId SymbolRegistry::find(std::string_view symbol) const {
+    SymbolName name;
+    name.assign(symbol);
+    for (size_t i = hashName(name.view()) & mask_;; i = (i + 1) & mask_) {
+        SymbolId id = table_[i];
+        if (id == INVALID_SYMBOL) return INVALID_SYMBOL;
+        if (entries_[id].name.view() == name.view()) return id;
+    }
+}
+
+std::string_view SymbolRegistry::name(SymbolId id) const {
+    if (id >= entries_.size()) {
+        throw std::out_of_range("Unknown symbol id " + std::to_string(id));
+    }
+    return entries_[id].name.view();
+}
+
+std::string_view SymbolRegistry::param(SymbolId id) const {
+    if (id >= entries_.size()) {
+        throw std::out_of_range("Unknown symbol id " + std::to_string(id));
+    }
+    return std::string_view(entries_[id].param, entries_[id].paramSize);
+}
+
+void SymbolRegistry::grow() {
+    table_.assign(table_.size() * 2, INVALID_SYMBOL);
+    mask_ = table_.size() - 1;
+    for (size_t id = 0; id < entries_.size(); ++id) {
+        size_t i = hashName(entries_[id].name.view()) & mask_;
+        while (table_[i] != INVALID_SYMBOL) {
+            i = (i + 1) & mask_;
+        }
+        table_[i] = static_cast<SymbolId>(id);
+    }
+}
+
+} // namespace binance
@@ -0,0 +1,712 @@
+#include "../include/TickFile.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace binance {
+
+namespace {
+
+constexpr char FILE_MAGIC[8] = {'B', 'N', 'T', 'I', 'C', 'K', '1', '\0'};
+constexpr char INDEX_MAGIC[8] = {'B', 'N', 'T', 'I', 'N', 'D', 'X', '1'};
+constexpr uint32_t CHUNK_MAGIC = 0x4B484354;  // "TCHK"
+constexpr uint32_t FORMAT_VERSION = 1;
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint8_t reserved[52];
+};
+static_assert(sizeof(FileHeader) == 64, "tick file header must be 64 bytes");
+
+// Followed by the chunk's symbol table, its column lengths and its columns
+struct ChunkHeader {
+    uint32_t magic;
+    uint32_t rows;
+    uint32_t payloadBytes;  // Everything after this header
+    uint16_t symbolCount;
+    uint16_t columnCount;
+    int64_t firstTime;
+    int64_t lastTime;
+};
+static_assert(sizeof(ChunkHeader) == 32, "chunk header must be 32 bytes");
+
+struct IndexEntry {
+    int64_t firstTime;
+    int64_t lastTime;
+    uint64_t offset;
+    uint32_t rows;
+    uint32_t reserved;
+};
+static_assert(sizeof(IndexEntry) == 32, "index entry must be 32 bytes");
+
+// Last bytes of a file whose recorder stopped cleanly
+struct Trailer {
+    uint64_t indexOffset;
+    uint64_t chunkCount;
+    char magic[8];
+};
+
+constexpr size_t SYMBOL_BYTES = sizeof(SymbolName::data);
+
+enum Kind : uint8_t {
+    KIND_TRADE = 0,
+    KIND_BOOK_TICKER = 1,
+    KIND_DEPTH = 2
+};
+
+// One byte stream per field. Values are zigzag varints of the difference
+// from the previous value of the same field and symbol unless noted;
+// "Decimal" columns hold Decimal units in the form written by
+// ColumnBuffer::decimal.
+enum Column : size_t {
+    COL_KIND,              // Raw byte
+    COL_SYMBOL,            // Varint index into the chunk's symbol table
+    COL_TIME,              // Difference from the previous row of any symbol
+    COL_TRADE_ID,
+    COL_TRADE_TIME,
+    COL_TRADE_EVENT_TIME,  // Difference from the trade time
+    COL_TRADE_PRICE,       // Decimal difference
+    COL_TRADE_QTY,         // Decimal
+    COL_TRADE_MAKER,       // Raw byte
+    COL_TICKER_ID,
+    COL_TICKER_BID,        // Decimal difference
+    COL_TICKER_BID_QTY,    // Decimal
+    COL_TICKER_SPREAD,     // Decimal: ask minus bid
+    COL_TICKER_ASK_QTY,    // Decimal
+    COL_DEPTH_EVENT_TIME,
+    COL_DEPTH_FIRST_ID,
+    COL_DEPTH_SPAN,        // Plain varint: final minus first update id
+    COL_DEPTH_FLAGS,       // Raw byte: 1 = snapshot, 2 = last
+    COL_DEPTH_COUNTS,      // Plain varints: bid count, ask count
+    COL_DEPTH_PRICE,       // Decimal difference: first level from the symbol's previous first level, then from the level before
+    COL_DEPTH_QTY,         // Decimal
+    COLUMN_COUNT
+};
+
+// Delta bases, reset at the start of each chunk so chunks decode on their own
+struct SymbolState {
+    int64_t tradeId = 0;
+    int64_t tradeTime = 0;
+    int64_t tradePrice = 0;
+    int64_t tickerId = 0;
+    int64_t tickerBid = 0;
+    int64_t depthTime = 0;
+    int64_t depthFirstId = 0;
+    int64_t bidPrice = 0;
+    int64_t askPrice = 0;
+};
+
+uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unzigzag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+constexpr int64_t POWERS_OF_TEN[15] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000,
+                                       1000000000, 10000000000, 100000000000, 1000000000000,
+                                       10000000000000, 100000000000000};
+constexpr uint64_t RAW_DECIMAL = 15;  // Zero count marking a value stored whole
+
+class ColumnBuffer {
+public:
+    void byte(uint8_t value) {
+        bytes.push_back(value);
+    }
+
+    void varint(uint64_t value) {
+        while (value >= 0x80) {
+            bytes.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        bytes.push_back(static_cast<uint8_t>(value));
+    }
+
+    // Append the difference from base and make value the new base
+    void delta(int64_t value, int64_t& base) {
+        varint(zigzag(value - base));
+        base = value;
+    }
+
+    // Prices and quantities are multiples of the tick and lot sizes, so most
+    // Decimal units end in zeros: store the other digits and the zero count
+    void decimal(int64_t units) {
+        int64_t digits = units;
+        uint64_t zeros = 0;
+        while (digits != 0 && digits % 10 == 0 && zeros < RAW_DECIMAL - 1) {
+            digits /= 10;
+            ++zeros;
+        }
+        uint64_t encoded = zigzag(digits);
+        if (encoded >> 59) {
+            varint(RAW_DECIMAL);
+            varint(zigzag(units));
+        } else {
+            varint(encoded << 4 | zeros);
+        }
+    }
+
+    void decimalDelta(int64_t units, int64_t& base) {
+        decimal(units - base);
+        base = units;
+    }
+
+    std::vector<uint8_t> bytes;
+};
+
+class ColumnReader {
+public:
+    ColumnReader() = default;
+    ColumnReader(const uint8_t* begin, const uint8_t* end) : position(begin), end(end) {}
+
+    uint8_t byte() {
+        if (position == end) {
+            throw std::runtime_error("Corrupt tick file chunk: column overrun");
+        }
+        return *position++;
+    }
+
+    uint64_t varint() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t b = byte();
+            value |= static_cast<uint64_t>(b & 0x7F) << shift;
+            if ((b & 0x80) == 0) {
+                return value;
+            }
+        }
+        throw std::runtime_error("Corrupt tick file chunk: varint too long");
+    }
+
+    int64_t delta(int64_t& base) {
+        base += unzigzag(varint());
+        return base;
+    }
+
+    int64_t decimal() {
+        uint64_t encoded = varint();
+        uint64_t zeros = encoded & 15;
+        if (zeros == RAW_DECIMAL) {
+            return unzigzag(varint());
+        }
+        return unzigzag(encoded >> 4) * POWERS_OF_TEN[zeros];
+    }
+
+    int64_t decimalDelta(int64_t& base) {
+        base += decimal();
+        return base;
+    }
+
+private:
+    const uint8_t* position = nullptr;
+    const uint8_t* end = nullptr;
+};
+
+int64_t wallClockMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+// Implementation class using the PIMPL idiom
+class TickRecorder::Impl {
+public:
+    Impl(const std::string& path, size_t chunkRows, int64_t flushIntervalMillis)
+        : out(path, std::ios::binary | std::ios::trunc), path(path),
+          chunkRows(std::max<size_t>(chunkRows, 1)), flushInterval(std::chrono::milliseconds(flushIntervalMillis)) {
+        if (!out) {
+            throw std::runtime_error("Failed to create tick file " + path);
+        }
+        FileHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+        header.version = FORMAT_VERSION;
+        write(&header, sizeof(header));
+        out.flush();
+    }
+
+    ~Impl() {
+        try {
+            stop();
+        } catch (const std::exception&) {
+            // Destructors must not throw; the chunks written so far stay readable
+        }
+    }
+
+    void addSource(std::shared_ptr<MarketEventQueue> queue) {
+        if (running || finished) {
+            throw std::runtime_error("Sources must be added before the recorder starts");
+        }
+        sources.push_back(std::move(queue));
+    }
+
+    void start() {
+        if (running || finished) {
+            throw std::runtime_error("Recorder already started");
+        }
+        running = true;
+        writer = std::thread(&Impl::run, this);
+    }
+
+    void stop() {
+        if (writer.joinable()) {
+            running = false;
+            writer.join();
+        }
+        if (!finished) {
+            finished = true;
+            drain();
+            flush();
+            writeIndex();
+        }
+    }
+
+    std::atomic<uint64_t> recorded{0};
+    std::atomic<uint64_t> skipped{0};
+    std::atomic<uint64_t> chunks{0};
+    std::atomic<uint64_t> bytes{0};
+
+private:
+    std::ofstream out;
+    std::string path;
+    const size_t chunkRows;
+    const std::chrono::steady_clock::duration flushInterval;
+    std::vector<std::shared_ptr<MarketEventQueue>> sources;
+    std::thread writer;
+    std::atomic<bool> running{false};
+    bool finished = false;
+
+    // The chunk being built
+    ColumnBuffer columns[COLUMN_COUNT];
+    std::vector<SymbolName> symbols;
+    std::vector<SymbolState> states;
+    uint32_t rows = 0;
+    int64_t firstTime = 0;
+    int64_t lastTime = 0;
+    std::chrono::steady_clock::time_point chunkStarted;
+    std::vector<IndexEntry> index;
+    MarketEvent event;
+
+    void run() {
+        while (running) {
+            size_t drained = drain();
+            if (rows > 0 && std::chrono::steady_clock::now() - chunkStarted >= flushInterval) {
+                flush();
+            }
+            if (drained == 0) {
+                // Nothing waits on the writer, so it can sleep instead of spinning
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+    }
+
+    size_t drain() {
+        size_t drained = 0;
+        for (const std::shared_ptr<MarketEventQueue>& queue : sources) {
+            while (queue->tryPop(event)) {
+                record(wallClockMicros(), event);
+                ++drained;
+            }
+        }
+        return drained;
+    }
+
+    size_t symbolIndex(const SymbolName& symbol) {
+        for (size_t i = 0; i < symbols.size(); ++i) {
+            if (std::memcmp(symbols[i].data, symbol.data, SYMBOL_BYTES) == 0) {
+                return i;
+            }
+        }
+        if (symbols.size() == UINT16_MAX) {
+            flush();
+        }
+        symbols.push_back(symbol);
+        states.emplace_back();
+        return symbols.size() - 1;
+    }
+
+    void record(int64_t time, const MarketEvent& marketEvent) {
+        const SymbolName* symbol = std::visit([](const auto& e) { return &e.symbol; }, marketEvent);
+        if (std::holds_alternative<KlineEvent>(marketEvent)) {
+            skipped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        // May start a new chunk if the symbol table is full
+        size_t s = symbolIndex(*symbol);
+        SymbolState& state = states[s];
+
+        // Chunks must stay in time order for the index, even if the wall clock steps back
+        time = std::max(time, lastTime);
+        if (rows == 0) {
+            firstTime = time;
+            lastTime = time;
+            chunkStarted = std::chrono::steady_clock::now();
+        }
+        columns[COL_SYMBOL].varint(s);
+        columns[COL_TIME].delta(time, lastTime);
+
+        if (const TradeEvent* trade = std::get_if<TradeEvent>(&marketEvent)) {
+            columns[COL_KIND].byte(KIND_TRADE);
+            columns[COL_TRADE_ID].delta(trade->tradeId, state.tradeId);
+            columns[COL_TRADE_TIME].delta(trade->tradeTime, state.tradeTime);
+            columns[COL_TRADE_EVENT_TIME].varint(zigzag(trade->eventTime - trade->tradeTime));
+            columns[COL_TRADE_PRICE].decimalDelta(trade->price.units(), state.tradePrice);
+            columns[COL_TRADE_QTY].decimal(trade->quantity.units());
+            columns[COL_TRADE_MAKER].byte(trade->isBuyerMaker ? 1 : 0);
+        } else if (const BookTickerEvent* ticker = std::get_if<BookTickerEvent>(&marketEvent)) {
+            columns[COL_KIND].byte(KIND_BOOK_TICKER);
+            columns[COL_TICKER_ID].delta(ticker->updateId, state.tickerId);
+            columns[COL_TICKER_BID].decimalDelta(ticker->bidPrice.units(), state.tickerBid);
+            columns[COL_TICKER_BID_QTY].decimal(ticker->bidQty.units());
+            columns[COL_TICKER_SPREAD].decimal(ticker->askPrice.units() - ticker->bidPrice.units());
+            columns[COL_TICKER_ASK_QTY].decimal(ticker->askQty.units());
+        } else {
+            const DepthUpdateEvent& depth = std::get<DepthUpdateEvent>(marketEvent);
+            columns[COL_KIND].byte(KIND_DEPTH);
+            columns[COL_DEPTH_EVENT_TIME].delta(depth.eventTime, state.depthTime);
+            columns[COL_DEPTH_FIRST_ID].delta(depth.firstUpdateId, state.depthFirstId);
+            columns[COL_DEPTH_SPAN].varint(static_cast<uint64_t>(depth.finalUpdateId - depth.firstUpdateId));
+            columns[COL_DEPTH_FLAGS].byte(static_cast<uint8_t>((depth.snapshot ? 1 : 0) | (depth.last ? 2 : 0)));
+            columns[COL_DEPTH_COUNTS].varint(depth.bidCount);
+            columns[COL_DEPTH_COUNTS].varint(depth.askCount);
+            recordLevels(depth.bids, depth.bidCount, state.bidPrice);
+            recordLevels(depth.asks, depth.askCount, state.askPrice);
+        }
+
+        recorded.fetch_add(1, std::memory_order_relaxed);
+        if (++rows >= chunkRows) {
+            flush();
+        }
+    }
+
+    void recordLevels(const PriceLevel* levels, size_t count, int64_t& firstPrice) {
+        int64_t previous = firstPrice;
+        for (size_t i = 0; i < count; ++i) {
+            columns[COL_DEPTH_PRICE].decimalDelta(levels[i].price.units(), previous);
+            columns[COL_DEPTH_QTY].decimal(levels[i].quantity.units());
+            if (i == 0) {
+                firstPrice = previous;
+            }
+        }
+    }
+
+    void write(const void* data, size_t size) {
+        out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    void flush() {
+        if (rows == 0) {
+            return;
+        }
+        ChunkHeader header;
+        header.magic = CHUNK_MAGIC;
+        header.rows = rows;
+        header.symbolCount = static_cast<uint16_t>(symbols.size());
+        header.columnCount = COLUMN_COUNT;
+        header.firstTime = firstTime;
+        header.lastTime = lastTime;
+        size_t payload = symbols.size() * SYMBOL_BYTES + COLUMN_COUNT * sizeof(uint32_t);
+        uint32_t lengths[COLUMN_COUNT];
+        for (size_t i = 0; i < COLUMN_COUNT; ++i) {
+            lengths[i] = static_cast<uint32_t>(columns[i].bytes.size());
+            payload += lengths[i];
+        }
+        header.payloadBytes = static_cast<uint32_t>(payload);
+
+        index.push_back(IndexEntry{firstTime, lastTime, bytes.load(std::memory_order_relaxed), rows, 0});
+        write(&header, sizeof(header));
+        for (const SymbolName& symbol : symbols) {
+            write(symbol.data, SYMBOL_BYTES);
+        }
+        write(lengths, sizeof(lengths));
+        for (ColumnBuffer& column : columns) {
+            write(column.bytes.data(), column.bytes.size());
+            column.bytes.clear();
+        }
+        // Each chunk reaches the file whole, so a crash loses at most the chunk being built
+        out.flush();
+        if (!out) {
+            throw std::runtime_error("Failed to write tick file " + path);
+        }
+
+        symbols.clear();
+        states.clear();
+        rows = 0;
+        chunks.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void writeIndex() {
+        Trailer trailer;
+        trailer.indexOffset = bytes.load(std::memory_order_relaxed);
+        trailer.chunkCount = index.size();
+        std::memcpy(trailer.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+        write(index.data(), index.size() * sizeof(IndexEntry));
+        write(&trailer, sizeof(trailer));
+        out.flush();
+        if (!out) {
+            throw std::runtime_error("Failed to write tick file " + path);
+        }
+    }
+};
+
+TickRecorder::TickRecorder(const std::string& path, size_t chunkRows, int64_t flushIntervalMillis)
+    : pImpl(std::make_unique<Impl>(path, chunkRows, flushIntervalMillis)) {}
+
+TickRecorder::~TickRecorder() = default;
+
+void TickRecorder::addSource(std::shared_ptr<MarketEventQueue> queue) {
+    pImpl->addSource(std::move(queue));
+}
+
+void TickRecorder::start() {
+    pImpl->start();
+}
+
+void TickRecorder::stop() {
+    pImpl->stop();
+}
+
+uint64_t TickRecorder::eventsRecorded() const {
+    return pImpl->recorded.load(std::memory_order_relaxed);
+}
+
+uint64_t TickRecorder::eventsSkipped() const {
+    return pImpl->skipped.load(std::memory_order_relaxed);
+}
+
+uint64_t TickRecorder::chunksWritten() const {
+    return pImpl->chunks.load(std::memory_order_relaxed);
+}
+
+uint64_t TickRecorder::bytesWritten() const {
+    return pImpl->bytes.load(std::memory_order_relaxed);
+}
+
+TickFile::TickFile(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open tick file " + path + ": " + std::strerror(errno));
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(FileHeader)) {
+        ::close(fd);
+        throw std::runtime_error("Not a tick file: " + path);
+    }
+    length_ = static_cast<size_t>(info.st_size);
+    data_ = mmap(nullptr, length_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data_ == MAP_FAILED) {
+        data_ = nullptr;
+        throw std::runtime_error("Failed to map tick file " + path + ": " + std::strerror(errno));
+    }
+
+    const char* bytes = static_cast<const char*>(data_);
+    FileHeader header;
+    std::memcpy(&header, bytes, sizeof(header));
+    if (std::memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 || header.version != FORMAT_VERSION) {
+        munmap(data_, length_);
+        data_ = nullptr;
+        throw std::runtime_error("Not a valid tick file: " + path);
+    }
+
+    // Use the index if the recorder wrote one
+    Trailer trailer;
+    bool indexed = false;
+    if (length_ >= sizeof(FileHeader) + sizeof(Trailer)) {
+        std::memcpy(&trailer, bytes + length_ - sizeof(Trailer), sizeof(trailer));
+        indexed = std::memcmp(trailer.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) == 0 &&
+                  trailer.indexOffset >= sizeof(FileHeader) && trailer.chunkCount <= length_ &&
+                  trailer.indexOffset + trailer.chunkCount * sizeof(IndexEntry) + sizeof(Trailer) == length_;
+    }
+    size_t chunkEnd = indexed ? trailer.indexOffset : length_;
+    if (indexed) {
+        chunks_.resize(trailer.chunkCount);
+        for (size_t i = 0; i < chunks_.size(); ++i) {
+            IndexEntry entry;
+            std::memcpy(&entry, bytes + trailer.indexOffset + i * sizeof(IndexEntry), sizeof(entry));
+            if (entry.offset < sizeof(FileHeader) || entry.offset + sizeof(ChunkHeader) > chunkEnd) {
+                munmap(data_, length_);
+                data_ = nullptr;
+                throw std::runtime_error("Corrupt tick file index: " + path);
+            }
+            chunks_[i] = Chunk{entry.firstTime, entry.lastTime, entry.offset, entry.rows};
+        }
+    } else {
+        // Rebuild from the chunk headers, ignoring a chunk cut short by a crash
+        size_t offset = sizeof(FileHeader);
+        ChunkHeader chunk;
+        while (offset + sizeof(ChunkHeader) <= chunkEnd) {
+            std::memcpy(&chunk, bytes + offset, sizeof(chunk));
+            size_t next = offset + sizeof(ChunkHeader) + chunk.payloadBytes;
+            if (chunk.magic != CHUNK_MAGIC || next > chunkEnd) {
+                break;
+            }
+            chunks_.push_back(Chunk{chunk.firstTime, chunk.lastTime, offset, chunk.rows});
+            offset = next;
+        }
+    }
+    for (const Chunk& chunk : chunks_) {
+        events_ += chunk.rows;
+    }
+}
+
+TickFile::~TickFile() {
+    if (data_) {
+        munmap(data_, length_);
+    }
+}
+
+int64_t TickFile::firstTime() const {
+    return chunks_.empty() ? 0 : chunks_.front().firstTime;
+}
+
+int64_t TickFile::lastTime() const {
+    return chunks_.empty() ? 0 : chunks_.back().lastTime;
+}
+
+size_t TickFile::findChunk(int64_t timeMicros) const {
+    auto it = std::partition_point(chunks_.begin(), chunks_.end(),
+                                   [timeMicros](const Chunk& chunk) { return chunk.lastTime < timeMicros; });
+    return static_cast<size_t>(it - chunks_.begin());
+}
+
+size_t TickFile::replay(int64_t fromMicros, int64_t toMicros,
+                        const std::function<void(int64_t, const MarketEvent&)>& sink) const {
+    size_t delivered = 0;
+    bool done = false;
+    for (size_t i = findChunk(fromMicros); i < chunks_.size() && !done && chunks_[i].firstTime < toMicros; ++i) {
+        decodeChunk(chunks_[i], fromMicros, toMicros, sink, delivered, done);
+    }
+    return delivered;
+}
+
+size_t TickFile::replay(const std::function<void(int64_t, const MarketEvent&)>& sink) const {
+    return replay(INT64_MIN, INT64_MAX, sink);
+}
+
+void TickFile::decodeChunk(const Chunk& chunk, int64_t fromMicros, int64_t toMicros,
+                           const std::function<void(int64_t, const MarketEvent&)>& sink, size_t& delivered,
+                           bool& done) const {
+    const uint8_t* begin = static_cast<const uint8_t*>(data_) + chunk.offset;
+    const uint8_t* limit = static_cast<const uint8_t*>(data_) + length_;
+    ChunkHeader header;
+    std::memcpy(&header, begin, sizeof(header));
+    const uint8_t* position = begin + sizeof(ChunkHeader);
+    size_t tableBytes = header.symbolCount * SYMBOL_BYTES + header.columnCount * sizeof(uint32_t);
+    if (header.magic != CHUNK_MAGIC || header.columnCount < COLUMN_COUNT ||
+        header.payloadBytes > static_cast<size_t>(limit - position) || tableBytes > header.payloadBytes) {
+        throw std::runtime_error("Corrupt tick file chunk header");
+    }
+    const uint8_t* end = position + header.payloadBytes;
+
+    std::vector<SymbolName> symbols(header.symbolCount);
+    for (SymbolName& symbol : symbols) {
+        std::memcpy(symbol.data, position, SYMBOL_BYTES);
+        symbol.data[SymbolName::CAPACITY] = '\0';
+        position += SYMBOL_BYTES;
+    }
+    const uint8_t* columnStart = position + header.columnCount * sizeof(uint32_t);
+    ColumnReader columns[COLUMN_COUNT];
+    for (size_t i = 0; i < header.columnCount; ++i) {
+        uint32_t columnBytes;
+        std::memcpy(&columnBytes, position + i * sizeof(uint32_t), sizeof(columnBytes));
+        if (columnBytes > static_cast<size_t>(end - columnStart)) {
+            throw std::runtime_error("Corrupt tick file chunk: column length");
+        }
+        // Columns added by later versions are skipped
+        if (i < COLUMN_COUNT) {
+            columns[i] = ColumnReader(columnStart, columnStart + columnBytes);
+        }
+        columnStart += columnBytes;
+    }
+
+    std::vector<SymbolState> states(symbols.size());
+    // One event per kind, indexed by Kind; decoding overwrites every field, so they are never reset
+    MarketEvent events[3] = {TradeEvent(), BookTickerEvent(), DepthUpdateEvent()};
+    int64_t time = chunk.firstTime;
+    for (uint32_t row = 0; row < header.rows; ++row) {
+        uint8_t kind = columns[COL_KIND].byte();
+        uint64_t s = columns[COL_SYMBOL].varint();
+        if (s >= symbols.size()) {
+            throw std::runtime_error("Corrupt tick file chunk: symbol index");
+        }
+        SymbolState& state = states[s];
+        columns[COL_TIME].delta(time);
+
+        if (kind == KIND_TRADE) {
+            TradeEvent& trade = std::get<TradeEvent>(events[kind]);
+            trade.symbol = symbols[s];
+            trade.tradeId = columns[COL_TRADE_ID].delta(state.tradeId);
+            trade.tradeTime = columns[COL_TRADE_TIME].delta(state.tradeTime);
+            trade.eventTime = trade.tradeTime + unzigzag(columns[COL_TRADE_EVENT_TIME].varint());
+            trade.price = Decimal::fromUnits(columns[COL_TRADE_PRICE].decimalDelta(state.tradePrice));
+            trade.quantity = Decimal::fromUnits(columns[COL_TRADE_QTY].decimal());
+            trade.isBuyerMaker = columns[COL_TRADE_MAKER].byte() != 0;
+        } else if (kind == KIND_BOOK_TICKER) {
+            BookTickerEvent& ticker = std::get<BookTickerEvent>(events[kind]);
+            ticker.symbol = symbols[s];
+            ticker.updateId = columns[COL_TICKER_ID].delta(state.tickerId);
+            int64_t bid = columns[COL_TICKER_BID].decimalDelta(state.tickerBid);
+            ticker.bidPrice = Decimal::fromUnits(bid);
+            ticker.bidQty = Decimal::fromUnits(columns[COL_TICKER_BID_QTY].decimal());
+            ticker.askPrice = Decimal::fromUnits(bid + columns[COL_TICKER_SPREAD].decimal());
+            ticker.askQty = Decimal::fromUnits(columns[COL_TICKER_ASK_QTY].decimal());
+        } else if (kind == KIND_DEPTH) {
+            DepthUpdateEvent& depth = std::get<DepthUpdateEvent>(events[kind]);
+            depth.symbol = symbols[s];
+            depth.eventTime = columns[COL_DEPTH_EVENT_TIME].delta(state.depthTime);
+            depth.firstUpdateId = columns[COL_DEPTH_FIRST_ID].delta(state.depthFirstId);
+            depth.finalUpdateId = depth.firstUpdateId + static_cast<int64_t>(columns[COL_DEPTH_SPAN].varint());
+            uint8_t flags = columns[COL_DEPTH_FLAGS].byte();
+            depth.snapshot = (flags & 1) != 0;
+            depth.last = (flags & 2) != 0;
+            uint64_t bidCount = columns[COL_DEPTH_COUNTS].varint();
+            uint64_t askCount = columns[COL_DEPTH_COUNTS].varint();
+            if (bidCount > DepthUpdateEvent::MAX_LEVELS || askCount > DepthUpdateEvent::MAX_LEVELS) {
+                throw std::runtime_error("Corrupt tick file chunk: level count");
+            }
+            depth.bidCount = static_cast<uint16_t>(bidCount);
+            depth.askCount = static_cast<uint16_t>(askCount);
+            PriceLevel* sides[2] = {depth.bids, depth.asks};
+            uint64_t counts[2] = {bidCount, askCount};
+            int64_t* firstPrices[2] = {&state.bidPrice, &state.askPrice};
+            for (size_t side = 0; side < 2; ++side) {
+                int64_t previous = *firstPrices[side];
+                for (size_t i = 0; i < counts[side]; ++i) {
+                    sides[side][i].price = Decimal::fromUnits(columns[COL_DEPTH_PRICE].decimalDelta(previous));
+                    sides[side][i].quantity = Decimal::fromUnits(columns[COL_DEPTH_QTY].decimal());
+                    if (i == 0) {
+                        *firstPrices[side] = previous;
+                    }
+                }
+            }
+        } else {
+            throw std::runtime_error("Corrupt tick file chunk: unknown event kind");
+        }
+
+        if (time >= toMicros) {
+            done = true;
+            return;
+        }
+        if (time >= fromMicros) {
+            sink(time, events[kind]);
+            ++delivered;
+        }
+    }
+}
+
+} // namespace binance
@@ -0,0 +1,159 @@
+#include "../include/UserData.h"
+#include "../include/JsonReader.h"
+#include <algorithm>
+#include <cstring>
+
+namespace binance {
+
+void ClientOrderId::assign(std::string_view id) {
+    size_t length = std::min(id.size(), CAPACITY);
+    std::memcpy(data, id.data(), length);
+    data[length] = '\0';
+}
+
+namespace {
+
+UserDataMessage classifyEvent(std::string_view type) {
+    if (type == "executionReport") return UserDataMessage::EXECUTION_REPORT;
+    if (type == "outboundAccountPosition") return UserDataMessage::ACCOUNT_POSITION;
+    if (type == "balanceUpdate") return UserDataMessage::BALANCE_UPDATE;
+    if (type == "listenKeyExpired" || type == "eventStreamTerminated") return UserDataMessage::STREAM_EXPIRED;
+    return UserDataMessage::OTHER;
+}
+
+// Looks ahead for the event type without moving the reader; the exchange sends it first
+UserDataMessage eventKindOf(const JsonReader& reader) {
+    JsonReader scan = reader;
+    scan.beginObject();
+    std::string_view key;
+    while (scan.nextKey(key)) {
+        if (key == "e") {
+            return scan.peek() == '"' ? classifyEvent(scan.readString()) : UserDataMessage::OTHER;
+        }
+        scan.skipValue();
+    }
+    return UserDataMessage::OTHER;
+}
+
+Decimal readDecimal(JsonReader& reader) {
+    return Decimal::parse(reader.readScalar());
+}
+
+void readExecutionReport(JsonReader& reader, OrderUpdateEvent& update) {
+    std::string_view clientOrderId;
+    std::string_view originalClientOrderId;
+    reader.beginObject();
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key == "E") update.eventTime = reader.readInt();
+        else if (key == "s") update.symbol.assign(reader.readString());
+        else if (key == "c") clientOrderId = reader.readString();
+        else if (key == "C") originalClientOrderId = reader.readString();
+        else if (key == "S") update.side = orderSideFromString(reader.readString());
+        else if (key == "o") update.type = orderTypeFromString(reader.readString());
+        else if (key == "q") update.quantity = readDecimal(reader);
+        else if (key == "p") update.price = readDecimal(reader);
+        else if (key == "x") update.executionType = executionTypeFromString(reader.readString());
+        else if (key == "X") update.status = orderStatusFromString(reader.readString());
+        else if (key == "i") update.orderId = reader.readInt();
+        else if (key == "l") update.lastQty = readDecimal(reader);
+        else if (key == "z") update.executedQty = readDecimal(reader);
+        else if (key == "L") update.lastPrice = readDecimal(reader);
+        else if (key == "Z") update.cumulativeQuoteQty = readDecimal(reader);
+        else if (key == "n") update.commission = readDecimal(reader);
+        else if (key == "N") {
+            if (!reader.readNull()) update.commissionAsset.assign(reader.readString());
+        }
+        else if (key == "t") update.tradeId = reader.readInt();
+        else if (key == "m") update.isMaker = reader.readBool();
+        else reader.skipValue();
+    }
+    // A cancel reports the cancel request's id in "c" and the order's own in "C"
+    update.clientOrderId.assign(originalClientOrderId.empty() ? clientOrderId : originalClientOrderId);
+}
+
+void readAccountPosition(JsonReader& reader, const std::function<void(const UserDataEvent&)>& sink) {
+    UserDataEvent event{BalanceUpdateEvent()};
+    BalanceUpdateEvent& balance = std::get<BalanceUpdateEvent>(event);
+    reader.beginObject();
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key == "E") {
+            balance.eventTime = reader.readInt();
+        } else if (key == "B") {
+            // Balances follow the event time in the exchange's messages
+            reader.beginArray();
+            while (reader.nextElement()) {
+                reader.beginObject();
+                std::string_view field;
+                while (reader.nextKey(field)) {
+                    if (field == "a") balance.asset.assign(reader.readString());
+                    else if (field == "f") balance.free = readDecimal(reader);
+                    else if (field == "l") balance.locked = readDecimal(reader);
+                    else reader.skipValue();
+                }
+                sink(event);
+            }
+        } else {
+            reader.skipValue();
+        }
+    }
+}
+
+void readBalanceUpdate(JsonReader& reader, BalanceUpdateEvent& balance) {
+    balance.isDelta = true;
+    reader.beginObject();
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key == "E") balance.eventTime = reader.readInt();
+        else if (key == "a") balance.asset.assign(reader.readString());
+        else if (key == "d") balance.free = readDecimal(reader);
+        else reader.skipValue();
+    }
+}
+
+UserDataMessage readEvent(JsonReader& reader, const std::function<void(const UserDataEvent&)>& sink) {
+    UserDataMessage kind = eventKindOf(reader);
+    UserDataEvent event;
+    switch (kind) {
+        case UserDataMessage::EXECUTION_REPORT:
+            readExecutionReport(reader, std::get<OrderUpdateEvent>(event));
+            sink(event);
+            return kind;
+        case UserDataMessage::ACCOUNT_POSITION:
+            readAccountPosition(reader, sink);
+            return kind;
+        case UserDataMessage::BALANCE_UPDATE:
+            readBalanceUpdate(reader, event.emplace<BalanceUpdateEvent>());
+            sink(event);
+            return kind;
+        case UserDataMessage::STREAM_EXPIRED:
+        case UserDataMessage::OTHER:
+            break;
+    }
+
+    // Not an event we decode, or a wrapper around one
+    reader.beginObject();
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (kind == UserDataMessage::OTHER && (key == "data" || key == "event") && reader.peek() == '{') {
+            kind = readEvent(reader, sink);
+        } else {
+            reader.skipValue();
+        }
+    }
+    return kind;
+}
+
+} // namespace
+
+UserDataMessage parseUserDataMessage(std::string_view message,
+                                     const std::function<void(const UserDataEvent&)>& sink) {
+    JsonReader reader(message);
+    if (reader.peek() != '{') {
+        return UserDataMessage::OTHER;
+    }
+    return readEvent(reader, sink);
+}
+
+} // namespace binance
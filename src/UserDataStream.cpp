@@ -0,0 +1,286 @@
+#include "../include/UserDataStream.h"
+#include "../include/BinanceAPI.h"
+#include "../include/WebSocketClient.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace binance {
+
+// Implementation class using the PIMPL idiom
+class UserDataStream::Impl {
+public:
+    Impl(BinanceAPI& api, const std::string& base_url) : api(api), base_url(base_url) {}
+
+    ~Impl() {
+        stop();
+    }
+
+    std::shared_ptr<OrderUpdateQueue> addOrderConsumer(size_t capacity) {
+        requireStopped();
+        orderConsumers.push_back(std::make_shared<OrderUpdateQueue>(capacity));
+        return orderConsumers.back();
+    }
+
+    std::shared_ptr<BalanceUpdateQueue> addBalanceConsumer(size_t capacity) {
+        requireStopped();
+        balanceConsumers.push_back(std::make_shared<BalanceUpdateQueue>(capacity));
+        return balanceConsumers.back();
+    }
+
+    void setKeepAliveInterval(std::chrono::milliseconds interval) {
+        std::lock_guard<std::mutex> lock(mutex);
+        keepAliveInterval = interval;
+    }
+
+    void start() {
+        if (running) {
+            return;
+        }
+        running = true;
+        ioThread = std::thread(&Impl::run, this);
+        keepAliveThread = std::thread(&Impl::keepAliveLoop, this);
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!running) {
+                return;
+            }
+            running = false;
+        }
+        webSocket.interrupt();
+        wakeUp.notify_all();
+        if (ioThread.joinable()) {
+            ioThread.join();
+        }
+        if (keepAliveThread.joinable()) {
+            keepAliveThread.join();
+        }
+        webSocket.close();
+
+        std::string key = currentKey();
+        if (!key.empty()) {
+            try {
+                api.closeListenKey(key);
+            } catch (const std::exception&) {
+                // The key expires on its own
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            activeKey.clear();
+        }
+    }
+
+    bool isConnected() const { return connected; }
+
+    std::string currentKey() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return activeKey;
+    }
+
+    std::string lastError() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return lastErrorText;
+    }
+
+    std::atomic<uint64_t> messages{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> errors{0};
+    std::atomic<uint64_t> connectionErrors{0};
+    std::atomic<uint64_t> reconnectCount{0};
+    std::atomic<uint64_t> keepAliveCount{0};
+
+private:
+    BinanceAPI& api;
+    std::string base_url;
+    std::vector<std::shared_ptr<OrderUpdateQueue>> orderConsumers;
+    std::vector<std::shared_ptr<BalanceUpdateQueue>> balanceConsumers;
+    WebSocketClient webSocket;
+    std::thread ioThread;
+    std::thread keepAliveThread;
+    mutable std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::atomic<bool> running{false};
+    std::atomic<bool> connected{false};
+    std::string activeKey;
+    std::string lastErrorText;
+    std::chrono::milliseconds keepAliveInterval{30 * 60 * 1000};
+
+    // Called without the mutex held
+    void recordError(std::string message) {
+        connectionErrors.fetch_add(1, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(mutex);
+        lastErrorText = std::move(message);
+    }
+
+    void requireStopped() const {
+        if (running) {
+            throw std::runtime_error("Consumers must be added before the stream starts");
+        }
+    }
+
+    template <typename Event>
+    void publish(const std::vector<std::shared_ptr<SpscRingBuffer<Event>>>& consumers, const Event& event) {
+        for (const auto& consumer : consumers) {
+            if (!consumer->tryPush(event)) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void publish(const UserDataEvent& event) {
+        if (const auto* update = std::get_if<OrderUpdateEvent>(&event)) {
+            publish(orderConsumers, *update);
+        } else if (const auto* balance = std::get_if<BalanceUpdateEvent>(&event)) {
+            publish(balanceConsumers, *balance);
+        }
+    }
+
+    void run() {
+        std::string message;
+        auto sink = [this](const UserDataEvent& event) { publish(event); };
+        std::chrono::milliseconds backoff(250);
+        bool firstConnection = true;
+
+        while (running) {
+            try {
+                // The exchange returns the active key while there is one, so asking again is cheap
+                std::string key = api.createListenKey();
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    activeKey = key;
+                }
+                webSocket.connect(base_url + "/ws/" + key);
+                {
+                    // A stop() that raced with connect() must still be able to interrupt
+                    std::lock_guard<std::mutex> lock(mutex);
+                    connected = running.load();
+                }
+                if (!firstConnection) {
+                    reconnectCount.fetch_add(1, std::memory_order_relaxed);
+                }
+                firstConnection = false;
+                backoff = std::chrono::milliseconds(250);
+
+                while (running && webSocket.receive(message)) {
+                    messages.fetch_add(1, std::memory_order_relaxed);
+                    UserDataMessage kind = UserDataMessage::OTHER;
+                    try {
+                        kind = parseUserDataMessage(message, sink);
+                    } catch (const std::exception&) {
+                        errors.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    if (kind == UserDataMessage::STREAM_EXPIRED) {
+                        // The key is gone; forget it so the next connection gets a new one
+                        std::lock_guard<std::mutex> lock(mutex);
+                        activeKey.clear();
+                        break;
+                    }
+                }
+            } catch (const std::exception& e) {
+                if (running) {
+                    recordError(e.what());
+                }
+            }
+            connected = false;
+            webSocket.close();
+
+            // Wait before reconnecting, doubling up to 30 seconds
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeUp.wait_for(lock, backoff, [this] { return !running; });
+            backoff = std::min(backoff * 2, std::chrono::milliseconds(30000));
+        }
+    }
+
+    void keepAliveLoop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (running) {
+            wakeUp.wait_for(lock, keepAliveInterval, [this] { return !running; });
+            if (!running || activeKey.empty()) {
+                continue;
+            }
+            std::string key = activeKey;
+            lock.unlock();
+            try {
+                api.keepAliveListenKey(key);
+                keepAliveCount.fetch_add(1, std::memory_order_relaxed);
+            } catch (const std::exception& e) {
+                // Most likely the key expired; reconnecting creates a new one
+                recordError(std::string("keepalive failed: ") + e.what());
+                webSocket.interrupt();
+            }
+            lock.lock();
+        }
+    }
+};
+
+// UserDataStream implementation
+
+UserDataStream::UserDataStream(BinanceAPI& api, const std::string& base_url)
+    : pImpl(new Impl(api, base_url)) {
+}
+
+UserDataStream::~UserDataStream() = default;
+
+std::shared_ptr<OrderUpdateQueue> UserDataStream::addOrderConsumer(size_t capacity) {
+    return pImpl->addOrderConsumer(capacity);
+}
+
+std::shared_ptr<BalanceUpdateQueue> UserDataStream::addBalanceConsumer(size_t capacity) {
+    return pImpl->addBalanceConsumer(capacity);
+}
+
+void UserDataStream::setKeepAliveInterval(std::chrono::milliseconds interval) {
+    pImpl->setKeepAliveInterval(interval);
+}
+
+void UserDataStream::start() {
+    pImpl->start();
+}
+
+void UserDataStream::stop() {
+    pImpl->stop();
+}
+
+bool UserDataStream::isConnected() const {
+    return pImpl->isConnected();
+}
+
+std::string UserDataStream::listenKey() const {
+    return pImpl->currentKey();
+}
+
+uint64_t UserDataStream::messagesReceived() const {
+    return pImpl->messages.load(std::memory_order_relaxed);
+}
+
+uint64_t UserDataStream::eventsDropped() const {
+    return pImpl->dropped.load(std::memory_order_relaxed);
+}
+
+uint64_t UserDataStream::decodeErrors() const {
+    return pImpl->errors.load(std::memory_order_relaxed);
+}
+
+uint64_t UserDataStream::connectionErrors() const {
+    return pImpl->connectionErrors.load(std::memory_order_relaxed);
+}
+
+std::string UserDataStream::lastError() const {
+    return pImpl->lastError();
+}
+
+uint64_t UserDataStream::reconnects() const {
+    return pImpl->reconnectCount.load(std::memory_order_relaxed);
+}
+
+uint64_t UserDataStream::keepAlives() const {
+    return pImpl->keepAliveCount.load(std::memory_order_relaxed);
+}
+
+} // namespace binance
@@ -0,0 +1,634 @@
+#include "../include/WebSocketClient.h"
+#include <openssl/ssl.h>
+#include <openssl/err.h>
+#include <openssl/rand.h>
+#include <openssl/sha.h>
+#include <openssl/evp.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <strings.h>
+#include <unistd.h>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+
+namespace binance {
+
+namespace {
+
+// Opcodes from RFC 6455 section 5.2
+constexpr uint8_t OP_CONTINUATION = 0x0;
+constexpr uint8_t OP_TEXT = 0x1;
+constexpr uint8_t OP_BINARY = 0x2;
+constexpr uint8_t OP_CLOSE = 0x8;
+constexpr uint8_t OP_PING = 0x9;
+constexpr uint8_t OP_PONG = 0xA;
+
+// Largest message accepted from the server
+constexpr size_t MAX_MESSAGE_SIZE = 64 * 1024 * 1024;
+
+constexpr const char* HANDSHAKE_GUID = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+std::string base64(const unsigned char* data, size_t length) {
+    std::string encoded(4 * ((length + 2) / 3), '\0');
+    int written = EVP_EncodeBlock(reinterpret_cast<unsigned char*>(&encoded[0]), data, static_cast<int>(length));
+    encoded.resize(static_cast<size_t>(written));
+    return encoded;
+}
+
+struct ParsedUrl {
+    bool secure = false;
+    std::string host;
+    std::string port;
+    std::string target;
+};
+
+ParsedUrl parseUrl(const std::string& url) {
+    ParsedUrl parsed;
+    size_t rest;
+    if (url.compare(0, 6, "wss://") == 0) {
+        parsed.secure = true;
+        rest = 6;
+    } else if (url.compare(0, 5, "ws://") == 0) {
+        rest = 5;
+    } else {
+        throw std::runtime_error("Unsupported WebSocket URL: " + url);
+    }
+
+    size_t slash = url.find('/', rest);
+    std::string authority = url.substr(rest, slash == std::string::npos ? std::string::npos : slash - rest);
+    parsed.target = slash == std::string::npos ? "/" : url.substr(slash);
+
+    size_t colon = authority.rfind(':');
+    if (colon != std::string::npos) {
+        parsed.host = authority.substr(0, colon);
+        parsed.port = authority.substr(colon + 1);
+    } else {
+        parsed.host = authority;
+        parsed.port = parsed.secure ? "443" : "80";
+    }
+    if (parsed.host.empty()) {
+        throw std::runtime_error("Missing host in WebSocket URL: " + url);
+    }
+    return parsed;
+}
+
+// Case-insensitive search for a header and its value in a raw response head
+std::string headerValue(const std::string& head, const char* name) {
+    size_t nameLength = std::strlen(name);
+    size_t lineStart = head.find("\r\n");
+    while (lineStart != std::string::npos) {
+        lineStart += 2;
+        size_t lineEnd = head.find("\r\n", lineStart);
+        if (lineEnd == std::string::npos) {
+            lineEnd = head.size();
+        }
+        if (lineEnd - lineStart > nameLength && head[lineStart + nameLength] == ':' &&
+            strncasecmp(head.c_str() + lineStart, name, nameLength) == 0) {
+            size_t valueStart = head.find_first_not_of(' ', lineStart + nameLength + 1);
+            return head.substr(valueStart, lineEnd - valueStart);
+        }
+        lineStart = lineEnd == head.size() ? std::string::npos : lineEnd;
+    }
+    return std::string();
+}
+
+// OpenSSL writes with write(2), which raises SIGPIPE on a dead connection.
+// Keep it blocked for the duration of a write and swallow it if it was raised.
+class SigpipeGuard {
+public:
+    SigpipeGuard() {
+        sigemptyset(&pipeSet);
+        sigaddset(&pipeSet, SIGPIPE);
+        sigset_t pending;
+        sigpending(&pending);
+        alreadyPending = sigismember(&pending, SIGPIPE) == 1;
+        pthread_sigmask(SIG_BLOCK, &pipeSet, &previous);
+    }
+
+    ~SigpipeGuard() {
+        if (!alreadyPending) {
+            timespec zero{0, 0};
+            while (sigtimedwait(&pipeSet, nullptr, &zero) > 0) {
+            }
+        }
+        pthread_sigmask(SIG_SETMASK, &previous, nullptr);
+    }
+
+private:
+    sigset_t pipeSet;
+    sigset_t previous;
+    bool alreadyPending = false;
+};
+
+} // namespace
+
+class WebSocketClient::Impl {
+public:
+    Impl() = default;
+
+    ~Impl() {
+        close();
+    }
+
+    void connect(const std::string& url, int timeoutMs) {
+        close();
+        ParsedUrl parsed = parseUrl(url);
+        interrupted = false;
+        setupTimeoutMs = timeoutMs;
+        try {
+            openSocket(parsed);
+            if (parsed.secure) {
+                startTls(parsed.host);
+            }
+            handshake(parsed);
+        } catch (...) {
+            teardown();
+            throw;
+        }
+        setupTimeoutMs = -1;
+        open = true;
+    }
+
+    void setReadTimeout(int timeoutMs) {
+        readTimeoutMs = timeoutMs;
+    }
+
+    bool isOpen() const {
+        return open;
+    }
+
+    void sendText(std::string_view message) {
+        sendFrame(OP_TEXT, message.data(), message.size());
+    }
+
+    bool receive(std::string& message) {
+        message.clear();
+        bool inMessage = false;
+        while (open) {
+            uint8_t opcode;
+            bool fin;
+            std::string_view payload;
+            if (!readFrame(opcode, fin, payload)) {
+                teardown();
+                return false;
+            }
+
+            switch (opcode) {
+                case OP_PING:
+                    sendFrame(OP_PONG, payload.data(), payload.size());
+                    break;
+                case OP_PONG:
+                    break;
+                case OP_CLOSE:
+                    // Echo the status code back, then drop the connection
+                    try {
+                        sendFrame(OP_CLOSE, payload.data(), payload.size() < 2 ? payload.size() : 2);
+                    } catch (const std::exception&) {
+                    }
+                    teardown();
+                    return false;
+                case OP_TEXT:
+                case OP_BINARY:
+                case OP_CONTINUATION:
+                    if ((opcode == OP_CONTINUATION) != inMessage) {
+                        throw std::runtime_error("WebSocket protocol error: unexpected frame sequence");
+                    }
+                    if (message.size() + payload.size() > MAX_MESSAGE_SIZE) {
+                        throw std::runtime_error("WebSocket message too large");
+                    }
+                    message.append(payload.data(), payload.size());
+                    if (fin) {
+                        return true;
+                    }
+                    inMessage = true;
+                    break;
+                default:
+                    throw std::runtime_error("WebSocket protocol error: unknown opcode");
+            }
+        }
+        return false;
+    }
+
+    void close() {
+        if (open) {
+            try {
+                const char normalClosure[2] = {0x03, static_cast<char>(0xE8)};  // 1000
+                sendFrame(OP_CLOSE, normalClosure, sizeof(normalClosure));
+            } catch (const std::exception&) {
+            }
+        }
+        teardown();
+    }
+
+    void interrupt() {
+        interrupted = true;
+        int fd = socketFd.load();
+        if (fd >= 0) {
+            ::shutdown(fd, SHUT_RDWR);
+        }
+    }
+
+private:
+    std::atomic<int> socketFd{-1};
+    SSL_CTX* sslContext = nullptr;
+    SSL* ssl = nullptr;
+    std::atomic<bool> open{false};
+    std::atomic<bool> interrupted{false};
+    int setupTimeoutMs = -1;  // Bounds each wait while connecting; -1 once open
+    std::atomic<int> readTimeoutMs{60000};  // Bounds each wait for data once open; 0 for none
+
+    // Received bytes not yet consumed; frames are parsed in place
+    std::string readBuffer;
+    size_t readPos = 0;
+
+    // sendMutex orders whole frames; ioMutex guards each individual read or
+    // write call, since one SSL object must not be used by two threads at once
+    std::mutex sendMutex;
+    std::mutex ioMutex;
+    std::string sendBuffer;
+
+    void openSocket(const ParsedUrl& parsed) {
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* addresses = nullptr;
+        int rc = getaddrinfo(parsed.host.c_str(), parsed.port.c_str(), &hints, &addresses);
+        if (rc != 0) {
+            throw std::runtime_error("WebSocket DNS lookup failed for " + parsed.host + ": " + gai_strerror(rc));
+        }
+
+        // The socket is non-blocking from the start, so the connect can time
+        // out and a send from another thread never waits behind a parked read
+        int fd = -1;
+        std::string error = "connection failed";
+        for (addrinfo* address = addresses; address && fd < 0; address = address->ai_next) {
+            fd = ::socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+            if (fd < 0) {
+                continue;
+            }
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+            socketFd = fd;
+            if (interrupted) {
+                error = "interrupted";
+            } else if (::connect(fd, address->ai_addr, address->ai_addrlen) == 0) {
+                break;
+            } else if (errno == EINPROGRESS && waitReady(POLLOUT)) {
+                int socketError = 0;
+                socklen_t length = sizeof(socketError);
+                getsockopt(fd, SOL_SOCKET, SO_ERROR, &socketError, &length);
+                if (socketError == 0) {
+                    break;
+                }
+                error = std::strerror(socketError);
+            } else {
+                error = errno == EINPROGRESS ? "timed out" : std::strerror(errno);
+            }
+            socketFd = -1;
+            ::close(fd);
+            fd = -1;
+        }
+        freeaddrinfo(addresses);
+        if (fd < 0) {
+            throw std::runtime_error("WebSocket connection to " + parsed.host + ":" + parsed.port + " failed: " + error);
+        }
+
+        // Market data is latency sensitive; never hold small frames back
+        int noDelay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+        readBuffer.clear();
+        readPos = 0;
+    }
+
+    void startTls(const std::string& host) {
+        sslContext = SSL_CTX_new(TLS_client_method());
+        if (!sslContext) {
+            throw std::runtime_error("Failed to create TLS context");
+        }
+        SSL_CTX_set_default_verify_paths(sslContext);
+        SSL_CTX_set_verify(sslContext, SSL_VERIFY_PEER, nullptr);
+
+        ssl = SSL_new(sslContext);
+        SSL_set_tlsext_host_name(ssl, host.c_str());
+        SSL_set1_host(ssl, host.c_str());
+        SSL_set_fd(ssl, socketFd);
+        for (;;) {
+            int rc = SSL_connect(ssl);
+            if (rc == 1) {
+                break;
+            }
+            int error = SSL_get_error(ssl, rc);
+            if ((error == SSL_ERROR_WANT_READ && waitReady(POLLIN)) ||
+                (error == SSL_ERROR_WANT_WRITE && waitReady(POLLOUT))) {
+                continue;
+            }
+            char message[256];
+            ERR_error_string_n(ERR_get_error(), message, sizeof(message));
+            throw std::runtime_error(std::string("TLS handshake failed: ") + message);
+        }
+    }
+
+    void handshake(const ParsedUrl& parsed) {
+        unsigned char nonce[16];
+        if (RAND_bytes(nonce, sizeof(nonce)) != 1) {
+            throw std::runtime_error("Failed to generate WebSocket key");
+        }
+        std::string key = base64(nonce, sizeof(nonce));
+
+        std::string request = "GET " + parsed.target + " HTTP/1.1\r\n"
+                              "Host: " + parsed.host + "\r\n"
+                              "Upgrade: websocket\r\n"
+                              "Connection: Upgrade\r\n"
+                              "Sec-WebSocket-Key: " + key + "\r\n"
+                              "Sec-WebSocket-Version: 13\r\n\r\n";
+        writeAll(request.data(), request.size());
+
+        size_t headEnd;
+        while ((headEnd = readBuffer.find("\r\n\r\n")) == std::string::npos) {
+            if (readBuffer.size() > 16384 || !fill()) {
+                throw std::runtime_error("WebSocket handshake failed: incomplete response");
+            }
+        }
+        std::string head = readBuffer.substr(0, headEnd);
+        readPos = headEnd + 4;  // Anything after the head is already frame data
+
+        if (head.compare(0, 12, "HTTP/1.1 101") != 0) {
+            throw std::runtime_error("WebSocket handshake rejected: " + head.substr(0, head.find("\r\n")));
+        }
+        if (headerValue(head, "Sec-WebSocket-Accept") != WebSocketClient::acceptKey(key)) {
+            throw std::runtime_error("WebSocket handshake failed: bad Sec-WebSocket-Accept");
+        }
+    }
+
+    void teardown() {
+        open = false;
+        std::lock_guard<std::mutex> lock(ioMutex);
+        if (ssl) {
+            SSL_free(ssl);
+            ssl = nullptr;
+        }
+        if (sslContext) {
+            SSL_CTX_free(sslContext);
+            sslContext = nullptr;
+        }
+        int fd = socketFd.exchange(-1);
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+
+    // Read whatever is available into the buffer; false on EOF or error
+    bool fill() {
+        if (readPos > 0 && readPos == readBuffer.size()) {
+            readBuffer.clear();
+            readPos = 0;
+        } else if (readPos > 65536 && readPos * 2 > readBuffer.size()) {
+            readBuffer.erase(0, readPos);
+            readPos = 0;
+        }
+
+        char chunk[16384];
+        for (;;) {
+            short waitFor = POLLIN;
+            {
+                std::lock_guard<std::mutex> lock(ioMutex);
+                if (socketFd < 0) {
+                    return false;
+                }
+                ssize_t received;
+                if (ssl) {
+                    int n = SSL_read(ssl, chunk, sizeof(chunk));
+                    if (n > 0) {
+                        readBuffer.append(chunk, static_cast<size_t>(n));
+                        return true;
+                    }
+                    int error = SSL_get_error(ssl, n);
+                    if (error == SSL_ERROR_WANT_WRITE) {
+                        waitFor = POLLOUT;
+                    } else if (error != SSL_ERROR_WANT_READ) {
+                        return false;
+                    }
+                } else {
+                    received = ::recv(socketFd, chunk, sizeof(chunk), 0);
+                    if (received > 0) {
+                        readBuffer.append(chunk, static_cast<size_t>(received));
+                        return true;
+                    }
+                    if (received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+                        return false;
+                    }
+                }
+            }
+            int timeoutMs = setupTimeoutMs;
+            if (open && waitFor == POLLIN && readTimeoutMs > 0) {
+                timeoutMs = readTimeoutMs;
+            }
+            bool timedOut = false;
+            if (!waitReady(waitFor, timeoutMs, &timedOut)) {
+                if (timedOut && open) {
+                    teardown();
+                    throw std::runtime_error("WebSocket read timed out: no data for " +
+                                             std::to_string(timeoutMs) + " ms");
+                }
+                return false;
+            }
+        }
+    }
+
+    // Wait until the socket is readable or writable; false if it was shut
+    // down or, while connecting, the setup timeout passed
+    bool waitReady(short events) {
+        return waitReady(events, setupTimeoutMs, nullptr);
+    }
+
+    // As above with its own timeout; timedOut is set if that is why it failed
+    bool waitReady(short events, int timeoutMs, bool* timedOut) {
+        pollfd descriptor{socketFd.load(), events, 0};
+        if (descriptor.fd < 0 || interrupted) {
+            return false;
+        }
+        int rc;
+        do {
+            rc = ::poll(&descriptor, 1, timeoutMs);
+        } while (rc < 0 && errno == EINTR);
+        if (rc == 0 && timedOut) {
+            *timedOut = true;
+        }
+        return rc > 0 && !(descriptor.revents & (POLLERR | POLLNVAL)) &&
+               (!(descriptor.revents & POLLHUP) || (descriptor.revents & POLLIN));
+    }
+
+    void writeAll(const char* data, size_t size) {
+        while (size > 0) {
+            short waitFor = POLLOUT;
+            {
+                std::lock_guard<std::mutex> lock(ioMutex);
+                if (socketFd < 0) {
+                    throw std::runtime_error("WebSocket is not connected");
+                }
+                ssize_t written;
+                if (ssl) {
+                    SigpipeGuard guard;
+                    int n = SSL_write(ssl, data, static_cast<int>(size));
+                    written = n;
+                    if (n <= 0) {
+                        int error = SSL_get_error(ssl, n);
+                        if (error == SSL_ERROR_WANT_READ) {
+                            waitFor = POLLIN;
+                        } else if (error != SSL_ERROR_WANT_WRITE) {
+                            throw std::runtime_error("WebSocket write failed");
+                        }
+                    }
+                } else {
+                    written = ::send(socketFd, data, size, MSG_NOSIGNAL);
+                    if (written < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                        throw std::runtime_error("WebSocket write failed");
+                    }
+                }
+                if (written > 0) {
+                    data += written;
+                    size -= static_cast<size_t>(written);
+                    continue;
+                }
+            }
+            if (!waitReady(waitFor)) {
+                throw std::runtime_error("WebSocket write failed");
+            }
+        }
+    }
+
+    // Parse the next frame; payload points into the read buffer until the next call
+    bool readFrame(uint8_t& opcode, bool& fin, std::string_view& payload) {
+        for (;;) {
+            size_t available = readBuffer.size() - readPos;
+            const auto* p = reinterpret_cast<const uint8_t*>(readBuffer.data() + readPos);
+            if (available >= 2) {
+                size_t headerSize = 2;
+                uint64_t length = p[1] & 0x7F;
+                bool masked = (p[1] & 0x80) != 0;
+                if (length == 126) {
+                    headerSize += 2;
+                } else if (length == 127) {
+                    headerSize += 8;
+                }
+                if (masked) {
+                    headerSize += 4;
+                }
+                if (available >= headerSize) {
+                    if (length == 126) {
+                        length = (static_cast<uint64_t>(p[2]) << 8) | p[3];
+                    } else if (length == 127) {
+                        length = 0;
+                        for (int i = 0; i < 8; ++i) {
+                            length = (length << 8) | p[2 + i];
+                        }
+                    }
+                    if (length > MAX_MESSAGE_SIZE) {
+                        throw std::runtime_error("WebSocket frame too large");
+                    }
+                    if (available >= headerSize + length) {
+                        fin = (p[0] & 0x80) != 0;
+                        opcode = p[0] & 0x0F;
+                        char* data = &readBuffer[readPos + headerSize];
+                        if (masked) {
+                            const uint8_t* mask = p + headerSize - 4;
+                            for (uint64_t i = 0; i < length; ++i) {
+                                data[i] = static_cast<char>(data[i] ^ mask[i & 3]);
+                            }
+                        }
+                        payload = std::string_view(data, length);
+                        readPos += headerSize + length;
+                        return true;
+                    }
+                }
+            }
+            if (!fill()) {
+                return false;
+            }
+        }
+    }
+
+    void sendFrame(uint8_t opcode, const char* data, size_t size) {
+        std::lock_guard<std::mutex> lock(sendMutex);
+
+        // Client frames are always masked (RFC 6455 section 5.3)
+        uint8_t mask[4];
+        RAND_bytes(mask, sizeof(mask));
+
+        sendBuffer.clear();
+        sendBuffer.push_back(static_cast<char>(0x80 | opcode));
+        if (size < 126) {
+            sendBuffer.push_back(static_cast<char>(0x80 | size));
+        } else if (size <= 0xFFFF) {
+            sendBuffer.push_back(static_cast<char>(0x80 | 126));
+            sendBuffer.push_back(static_cast<char>(size >> 8));
+            sendBuffer.push_back(static_cast<char>(size));
+        } else {
+            sendBuffer.push_back(static_cast<char>(0x80 | 127));
+            for (int shift = 56; shift >= 0; shift -= 8) {
+                sendBuffer.push_back(static_cast<char>(static_cast<uint64_t>(size) >> shift));
+            }
+        }
+        sendBuffer.append(reinterpret_cast<const char*>(mask), sizeof(mask));
+        size_t payloadStart = sendBuffer.size();
+        sendBuffer.append(data, size);
+        for (size_t i = 0; i < size; ++i) {
+            sendBuffer[payloadStart + i] = static_cast<char>(sendBuffer[payloadStart + i] ^ mask[i & 3]);
+        }
+        writeAll(sendBuffer.data(), sendBuffer.size());
+    }
+};
+
+// WebSocketClient implementation
+
+WebSocketClient::WebSocketClient() : pImpl(new Impl()) {
+}
+
+WebSocketClient::~WebSocketClient() = default;
+
+void WebSocketClient::connect(const std::string& url, int timeoutMs) {
+    pImpl->connect(url, timeoutMs);
+}
+
+void WebSocketClient::setReadTimeout(int timeoutMs) {
+    pImpl->setReadTimeout(timeoutMs);
+}
+
+bool WebSocketClient::isOpen() const {
+    return pImpl->isOpen();
+}
+
+void WebSocketClient::sendText(std::string_view message) {
+    pImpl->sendText(message);
+}
+
+bool WebSocketClient::receive(std::string& message) {
+    return pImpl->receive(message);
+}
+
+void WebSocketClient::close() {
+    pImpl->close();
+}
+
+void WebSocketClient::interrupt() {
+    pImpl->interrupt();
+}
+
+std::string WebSocketClient::acceptKey(std::string_view key) {
+    std::string input(key);
+    input += HANDSHAKE_GUID;
+    unsigned char digest[SHA_DIGEST_LENGTH];
+    SHA1(reinterpret_cast<const unsigned char*>(input.data()), input.size(), digest);
+    return base64(digest, sizeof(digest));
+}
+
+} // namespace binance
@@ -1,5 +1,6 @@
 #include "../include/BinanceAPI.h"
 #include "../include/BinanceTypes.h"
+#include "../include/JsonReader.h"
 #include <iostream>
 #include <string>
 #include <map>
@@ -7,7 +8,6 @@
 #include <chrono>
 #include <thread>
 #include <iomanip>
-#include <regex>
 
 // Simple JSON pretty-print function for demonstration purposes
 void prettyPrintJSON(const std::string& json) {
@@ -65,22 +65,28 @@ void runTest(const std::string& testName, std::function<void()> testFunction) {
 
 // Extract price from ticker response
 double extractPrice(const std::string& response) {
-    std::regex priceRegex("\"price\":\"([0-9.]+)\"");
-    std::smatch match;
-    if (std::regex_search(response, match, priceRegex) && match.size() > 1) {
-        return std::stod(match.str(1));
+    binance::JsonReader reader(response);
+    reader.beginObject();
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key == "price") {
+            return std::stod(std::string(reader.readScalar()));
+        }
+        reader.skipValue();
     }
     throw std::runtime_error("Could not extract price from response");
 }
 
 int main(int argc, char** argv) {
     if (argc < 3) {
-        std::cerr << "Usage: " << argv[0] << " <api_key> <api_secret>" << std::endl;
+        std::cerr << "Usage: " << argv[0] << " <api_key> <api_secret> [base_url]" << std::endl;
         return 1;
     }
     
     std::string api_key = argv[1];
     std::string api_secret = argv[2];
+    // Testnet unless another host, such as a local exchange_simulator, is given
+    std::string base_url = argc > 3 ? argv[3] : "https://testnet.binance.vision";
     double currentPrice = 0.0;
     
     try {
@@ -89,7 +95,7 @@ int main(int argc, char** argv) {
         std::cout << "==========================================" << std::endl;
         
         // Initialize the Binance API client with testnet URL
-        binance::BinanceAPI api(api_key, api_secret, "https://testnet.binance.vision");
+        binance::BinanceAPI api(api_key, api_secret, base_url);
         
         // Test 1: Get Current Price (for simplicity, we'll use a reasonable test price)
         runTest("Set Test Symbol Price", [&currentPrice]() {
@@ -114,15 +120,9 @@ int main(int argc, char** argv) {
             double orderPrice = currentPrice * 0.95; // 5% below current price
             params["price"] = std::to_string(orderPrice);
             
-            std::string response = api.createOrder("BTCUSDT", "BUY", "LIMIT", params);
-            prettyPrintJSON(response);
-            
-            // Extract orderId for possible future use
-            std::regex orderIdRegex("\"orderId\":([0-9]+)");
-            std::smatch match;
-            if (std::regex_search(response, match, orderIdRegex) && match.size() > 1) {
-                std::cout << "Order created with ID: " << match.str(1) << std::endl;
-            }
+            binance::OrderInfo order = api.createOrderTyped("BTCUSDT", "BUY", "LIMIT", params);
+            std::cout << "Order created with ID: " << order.orderId
+                      << " (" << binance::toString(order.status) << ")" << std::endl;
         });
         
         // Test 3: Get Open Orders
@@ -0,0 +1,476 @@
+#include "../include/Backtester.h"
+#include "../include/HistoryFile.h"
+#include "../include/Indicators.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <functional>
+#include <stdexcept>
+#include <chrono>
+#include <vector>
+#include <random>
+#include <memory>
+#include <cmath>
+#include <thread>
+#include <cstdio>
+#include <unistd.h>
+
+namespace {
+
+int failures = 0;
+
+void printTestResult(const std::string& testName, bool success) {
+    std::cout << std::left << std::setw(50) << testName << " : "
+              << (success ? "PASSED" : "FAILED") << std::endl;
+}
+
+void runTest(const std::string& testName, std::function<void()> testFunction) {
+    std::cout << "\n=== Running test: " << testName << " ===" << std::endl;
+    try {
+        testFunction();
+        printTestResult(testName, true);
+    } catch (const std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        printTestResult(testName, false);
+        ++failures;
+    }
+}
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        throw std::runtime_error("check failed: " + what);
+    }
+}
+
+binance::Decimal dec(const char* text) {
+    return binance::Decimal::parse(text);
+}
+
+// A file in the temporary directory, removed when it goes out of scope
+struct TempFile {
+    std::string path;
+
+    explicit TempFile(const std::string& name)
+        : path("/tmp/backtest_test_" + std::to_string(getpid()) + "_" + name) {}
+    ~TempFile() { std::remove(path.c_str()); }
+};
+
+binance::TradeEvent trade(int64_t time, const char* price, const char* quantity, bool buyerMaker = false) {
+    binance::TradeEvent event;
+    event.tradeTime = time;
+    event.price = dec(price);
+    event.quantity = dec(quantity);
+    event.isBuyerMaker = buyerMaker;
+    return event;
+}
+
+binance::KlineEvent kline(int64_t openTime, const char* open, const char* high, const char* low, const char* close) {
+    binance::KlineEvent event;
+    event.startTime = openTime;
+    event.closeTime = openTime + 59999;
+    event.open = dec(open);
+    event.high = dec(high);
+    event.low = dec(low);
+    event.close = dec(close);
+    event.volume = dec("10");
+    return event;
+}
+
+// A random walk of trades, one per millisecond
+std::vector<binance::TradeEvent> syntheticTrades(size_t count, uint64_t seed = 7) {
+    std::mt19937_64 rng(seed);
+    std::vector<binance::TradeEvent> trades(count);
+    int64_t price = 3000000000000;  // 30000.00000000
+    for (size_t i = 0; i < count; ++i) {
+        price += static_cast<int64_t>(rng() % 2001) * 100000 - 100000000;
+        trades[i].tradeTime = 1700000000000 + static_cast<int64_t>(i);
+        trades[i].price = binance::Decimal::fromUnits(price);
+        trades[i].quantity = binance::Decimal::fromUnits(static_cast<int64_t>(rng() % 100000000) + 1);
+        trades[i].isBuyerMaker = (rng() & 1) != 0;
+    }
+    return trades;
+}
+
+binance::OrderParams order(binance::OrderSide side, binance::OrderType type, const char* quantity,
+                           const char* price = nullptr) {
+    binance::OrderParams params;
+    params.symbol = "BTCUSDT";
+    params.side = side;
+    params.type = type;
+    params.quantity = dec(quantity);
+    if (price) {
+        params.price = dec(price);
+    }
+    return params;
+}
+
+std::vector<binance::OrderUpdateEvent> drain(binance::SimulatedGateway& gateway) {
+    std::vector<binance::OrderUpdateEvent> updates;
+    gateway.poll([&updates](const binance::OrderUpdateEvent& update) { updates.push_back(update); });
+    return updates;
+}
+
+// Buys once on the first trade and sells after a fixed number of trades
+class RoundTripStrategy : public binance::Strategy {
+public:
+    explicit RoundTripStrategy(size_t holdTrades) : holdTrades(holdTrades) {}
+
+    void onStart() override { startTime = now(); }
+    void onStop() override { stopped = true; }
+
+    void onTrade(const binance::TradeEvent& trade) override {
+        ++trades;
+        expect(trade.symbol == "BTCUSDT", "trade symbol");
+        expect(now() == trade.tradeTime * 1000, "clock follows trade time");
+        if (trades == 1) {
+            orders().placeOrder(order(binance::OrderSide::BUY, binance::OrderType::MARKET, "0.5"));
+            scheduleTimer(2500, 1000);
+        } else if (trades == 1 + holdTrades) {
+            orders().placeOrder(order(binance::OrderSide::SELL, binance::OrderType::MARKET, "0.5"));
+        }
+    }
+
+    void onOrderUpdate(const binance::OrderUpdateEvent& update) override {
+        updates.push_back(update);
+    }
+
+    void onTimer(binance::TimerId id) override {
+        timerTimes.push_back(now());
+        if (timerTimes.size() == 3) {
+            cancelTimer(id);
+        }
+    }
+
+    size_t holdTrades;
+    size_t trades = 0;
+    int64_t startTime = -1;
+    bool stopped = false;
+    std::vector<binance::OrderUpdateEvent> updates;
+    std::vector<int64_t> timerTimes;
+};
+
+// Moving average crossover on closed candles, long or flat
+class CrossoverStrategy : public binance::Strategy {
+public:
+    CrossoverStrategy(size_t fast, size_t slow) : fast(fast), slow(slow) {}
+
+    void onKline(const binance::KlineEvent& kline) override {
+        expect(kline.closed && kline.eventTime == kline.closeTime, "klines arrive closed at their close time");
+        fast.update(kline.close.toDouble());
+        slow.update(kline.close.toDouble());
+        if (!slow.isReady() || pending) {
+            return;
+        }
+        bool up = fast.value() > slow.value();
+        if (up != inPosition) {
+            orders().placeOrder(order(up ? binance::OrderSide::BUY : binance::OrderSide::SELL,
+                                      binance::OrderType::MARKET, "1"));
+            pending = true;
+        }
+    }
+
+    void onTrade(const binance::TradeEvent& trade) override {
+        fast.update(trade.price.toDouble());
+        slow.update(trade.price.toDouble());
+        if (!slow.isReady() || pending) {
+            return;
+        }
+        bool up = fast.value() > slow.value();
+        if (up != inPosition) {
+            orders().placeOrder(order(up ? binance::OrderSide::BUY : binance::OrderSide::SELL,
+                                      binance::OrderType::MARKET, "0.01"));
+            pending = true;
+        }
+    }
+
+    void onOrderUpdate(const binance::OrderUpdateEvent& update) override {
+        pending = false;
+        if (update.status == binance::OrderStatus::FILLED) {
+            inPosition = update.side == binance::OrderSide::BUY;
+        }
+    }
+
+private:
+    binance::SMA fast;
+    binance::SMA slow;
+    bool inPosition = false;
+    bool pending = false;
+};
+
+// Only reads the events, to measure the replay itself
+class CountingStrategy : public binance::Strategy {
+public:
+    void onTrade(const binance::TradeEvent& trade) override { sum += trade.price.units(); }
+    int64_t sum = 0;
+};
+
+void benchmark() {
+    const size_t count = 10000000;
+    TempFile file("bench.bin");
+    binance::HistoryFile::writeTrades(file.path, "BTCUSDT", syntheticTrades(count));
+    binance::HistoryFile history(file.path);
+
+    CountingStrategy counting;
+    binance::BacktestResult result = binance::Backtester(history).run(counting);
+    std::cout << "  Replay, counting strategy      " << std::fixed << std::setprecision(1)
+              << (result.events / result.seconds / 1e6) << " M events/s" << std::endl;
+
+    CrossoverStrategy crossover(50, 200);
+    result = binance::Backtester(history).run(crossover);
+    std::cout << "  Replay, SMA crossover          " << (result.events / result.seconds / 1e6)
+              << " M events/s (" << result.fills << " fills)" << std::endl;
+
+    size_t threads = std::max<unsigned>(std::thread::hardware_concurrency(), 1);
+    size_t runs = threads * 2;
+    auto start = std::chrono::steady_clock::now();
+    std::vector<binance::BacktestResult> results = binance::Backtester::sweep(
+        history, runs, [](size_t index) { return std::make_unique<CrossoverStrategy>(10 + index, 200); });
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "  Sweep, " << runs << " runs on " << threads << " threads   "
+              << (runs * count / elapsed / 1e6) << " M events/s" << std::endl;
+    std::cout << (counting.sum == 0 || results.empty() ? " " : "");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool runBenchmark = argc > 1 && std::string(argv[1]) == "--bench";
+
+    std::cout << "\n\n=======================================" << std::endl;
+    std::cout << "BACKTEST TESTS" << std::endl;
+    std::cout << "=======================================" << std::endl;
+
+    runTest("Trade file round trip", []() {
+        TempFile file("trades.bin");
+        binance::HistoryFile::writeTrades(file.path, "BTCUSDT", {trade(1000, "30000.5", "0.1", true),
+                                                                 trade(1001, "30001", "2"),
+                                                                 trade(1005, "29999.99", "0.003", true)});
+        binance::HistoryFile history(file.path);
+        expect(history.kind() == binance::HistoryKind::TRADES, "kind");
+        expect(history.size() == 3, "count");
+        expect(history.symbol() == "BTCUSDT", "symbol");
+        const binance::TradeColumns& columns = history.trades();
+        expect(columns.time[2] == 1005, "time column");
+        expect(columns.price[0] == dec("30000.5").units(), "price column");
+        expect(columns.quantity[2] == dec("0.003").units(), "quantity column");
+        expect(columns.buyerMaker[0] == 1 && columns.buyerMaker[1] == 0, "buyer maker column");
+
+        bool wrongKind = false;
+        try {
+            history.klines();
+        } catch (const std::runtime_error&) {
+            wrongKind = true;
+        }
+        expect(wrongKind, "kline columns of a trade file are refused");
+    });
+
+    runTest("Kline file and CSV import", []() {
+        TempFile csv("klines.csv");
+        {
+            std::ofstream out(csv.path);
+            out << "open_time,open,high,low,close,volume,close_time,quote_volume,count,tb,tq,ignore\r\n"
+                << "1735689600000000,93576.00,93610.93,93537.50,93610.93,8.21827,1735689659999999,769030.5,2631,3.9,369979.5,0\r\n"
+                << "1735689660000,93610.93,93652.00,93606.00,93650.00,4.5,1735689719999,1,1,1,1,0\n";
+        }
+        std::vector<binance::KlineEvent> klines = binance::HistoryFile::readKlineCsv(csv.path);
+        expect(klines.size() == 2, "header skipped");
+        expect(klines[0].startTime == 1735689600000 && klines[0].closeTime == 1735689659999,
+               "microsecond times converted");
+        expect(klines[1].close == dec("93650") && klines[0].volume == dec("8.21827"), "prices");
+
+        TempFile file("klines.bin");
+        binance::HistoryFile::writeKlines(file.path, "BTCUSDT", "1m", klines);
+        binance::HistoryFile history(file.path);
+        expect(history.kind() == binance::HistoryKind::KLINES && history.interval() == "1m", "kind and interval");
+        const binance::KlineColumns& columns = history.klines();
+        expect(columns.openTime[1] == 1735689660000 && columns.closeTime[0] == 1735689659999, "time columns");
+        expect(columns.high[0] == dec("93610.93").units() && columns.low[1] == dec("93606").units(),
+               "price columns");
+    });
+
+    runTest("Rejects files that are not history files", []() {
+        TempFile file("garbage.bin");
+        {
+            std::ofstream out(file.path, std::ios::binary);
+            out << std::string(200, 'x');
+        }
+        bool rejected = false;
+        try {
+            binance::HistoryFile history(file.path);
+        } catch (const std::runtime_error&) {
+            rejected = true;
+        }
+        expect(rejected, "garbage rejected");
+
+        // A valid header whose columns were cut short
+        TempFile truncated("truncated.bin");
+        binance::HistoryFile::writeTrades(truncated.path, "BTCUSDT", syntheticTrades(10));
+        expect(truncate(truncated.path.c_str(), 100) == 0, "truncate");
+        rejected = false;
+        try {
+            binance::HistoryFile history(truncated.path);
+        } catch (const std::runtime_error&) {
+            rejected = true;
+        }
+        expect(rejected, "truncated file rejected");
+    });
+
+    runTest("Market order fills after the latency with taker fee", []() {
+        binance::BacktestConfig config;
+        config.latencyMicros = 100;
+        config.takerFee = dec("0.001");
+        config.startingQuote = dec("1000");
+        binance::SimulatedGateway gateway(config);
+        gateway.setTime(1000);
+        std::string id = gateway.placeOrder(order(binance::OrderSide::BUY, binance::OrderType::MARKET, "2"));
+
+        expect(gateway.match(1050, dec("100"), dec("100"), dec("100")) == 0, "not arrived before the latency");
+        expect(gateway.match(1100, dec("101"), dec("101"), dec("101")) == 1, "arrived at the latency");
+        std::vector<binance::OrderUpdateEvent> updates = drain(gateway);
+        expect(updates.size() == 1 && updates[0].clientOrderId == id, "one update for the order");
+        expect(updates[0].status == binance::OrderStatus::FILLED && updates[0].orderId == 1, "filled");
+        expect(updates[0].lastPrice == dec("101") && updates[0].executedQty == dec("2"), "fill price and size");
+        expect(updates[0].cumulativeQuoteQty == dec("202"), "notional");
+        expect(gateway.fees() == dec("0.202"), "taker fee");
+        expect(gateway.position() == dec("2") && gateway.quote() == dec("797.798"), "balances");
+        expect(gateway.poll([](const binance::OrderUpdateEvent&) {}) == 0, "updates delivered once");
+    });
+
+    runTest("Limit orders rest, fill as maker and cancel", []() {
+        binance::BacktestConfig config;
+        config.makerFee = dec("0.0005");
+        config.takerFee = dec("0.001");
+        binance::SimulatedGateway gateway(config);
+
+        std::string bid = gateway.placeOrder(order(binance::OrderSide::BUY, binance::OrderType::LIMIT, "1", "99"));
+        std::string ask = gateway.placeOrder(order(binance::OrderSide::SELL, binance::OrderType::LIMIT, "1", "105"));
+        gateway.match(0, dec("100"), dec("100"), dec("100"));
+        std::vector<binance::OrderUpdateEvent> updates = drain(gateway);
+        expect(updates.size() == 2 && updates[0].status == binance::OrderStatus::NEW &&
+               updates[1].status == binance::OrderStatus::NEW, "both rest");
+
+        // A candle whose low reaches the bid fills it at the limit price
+        gateway.match(10, dec("100"), dec("98.5"), dec("101"));
+        updates = drain(gateway);
+        expect(updates.size() == 1 && updates[0].clientOrderId == bid, "bid filled");
+        expect(updates[0].lastPrice == dec("99") && gateway.fees() == dec("0.0495"), "maker fill at the limit");
+
+        gateway.cancelOrder("BTCUSDT", ask);
+        gateway.cancelOrder("BTCUSDT", bid);
+        gateway.cancelOrder("BTCUSDT", "nope");
+        gateway.match(20, dec("100"), dec("100"), dec("100"));
+        updates = drain(gateway);
+        expect(updates.size() == 3, "three cancel outcomes");
+        expect(updates[0].status == binance::OrderStatus::CANCELED && !updates[0].cancelRejected, "resting canceled");
+        expect(updates[1].cancelRejected && updates[1].errorCode == -2011, "filled order cannot be canceled");
+        expect(updates[2].cancelRejected && updates[2].clientOrderId == "nope", "unknown order");
+
+        // A marketable limit takes at the print; a marketable limit maker is refused
+        gateway.placeOrder(order(binance::OrderSide::BUY, binance::OrderType::LIMIT, "1", "110"));
+        gateway.placeOrder(order(binance::OrderSide::BUY, binance::OrderType::LIMIT_MAKER, "1", "110"));
+        gateway.placeOrder(order(binance::OrderSide::SELL, binance::OrderType::STOP_LOSS, "1", "90"));
+        binance::OrderParams noPrice = order(binance::OrderSide::BUY, binance::OrderType::LIMIT, "1");
+        gateway.placeOrder(noPrice);
+        gateway.match(30, dec("100"), dec("100"), dec("100"));
+        updates = drain(gateway);
+        expect(updates.size() == 4, "four outcomes");
+        expect(updates[0].status == binance::OrderStatus::FILLED && updates[0].lastPrice == dec("100"),
+               "marketable limit fills at the print");
+        expect(updates[1].status == binance::OrderStatus::REJECTED && updates[1].errorCode == -2010,
+               "limit maker would take");
+        expect(updates[2].errorCode == -1116 && updates[2].orderId == -1, "unsupported type");
+        expect(updates[3].errorCode == -1102, "missing price");
+        expect(gateway.orderCount() == 6 && gateway.fillCount() == 2, "counts");
+    });
+
+    runTest("Trade replay drives callbacks on the data clock", []() {
+        TempFile file("replay.bin");
+        binance::HistoryFile::writeTrades(file.path, "BTCUSDT", {trade(1000, "100", "1"), trade(1001, "101", "1"),
+                                                                 trade(1003, "102", "1"), trade(1010, "104", "1"),
+                                                                 trade(1011, "103", "1")});
+        binance::HistoryFile history(file.path);
+        binance::BacktestConfig config;
+        config.latencyMicros = 500;
+        config.takerFee = dec("0.001");
+        config.startingQuote = dec("1000");
+
+        RoundTripStrategy strategy(3);
+        binance::BacktestResult result = binance::Backtester(history, config).run(strategy);
+        expect(strategy.stopped && strategy.trades == 5, "every trade and lifecycle callback");
+        expect(strategy.startTime == 1000000, "clock starts at the first event");
+        expect(result.events == 5 && result.orders == 2 && result.fills == 2, "counts");
+
+        // Bought at the second trade (101), sold at the last (103), 0.5 each
+        expect(strategy.updates.size() == 2, "two fills delivered");
+        expect(strategy.updates[0].lastPrice == dec("101") && strategy.updates[1].lastPrice == dec("103"),
+               "fills at the first print after the latency");
+        expect(result.position == dec("0") && result.fees == dec("0.102"), "flat, fees paid");
+        expect(result.quote == dec("1000.898"), "quote balance");
+        expect(std::fabs(result.pnl - 0.898) < 1e-9, "pnl");
+        expect(result.lastPrice == dec("103"), "last price");
+
+        // Timer at 1000000 + 2500, then every 1000, cancelled on its third call
+        expect(strategy.timerTimes == std::vector<int64_t>({1002500, 1003500, 1004500}), "timer deadlines");
+    });
+
+    runTest("Kline replay and drawdown", []() {
+        TempFile file("klines.bin");
+        std::vector<binance::KlineEvent> klines;
+        const char* closes[] = {"100", "101", "102", "103", "104", "100", "95", "90", "92", "97"};
+        for (size_t i = 0; i < 10; ++i) {
+            klines.push_back(kline(60000 * static_cast<int64_t>(i), closes[i], "200", "1", closes[i]));
+        }
+        binance::HistoryFile::writeKlines(file.path, "BTCUSDT", "1m", klines);
+        binance::HistoryFile history(file.path);
+
+        CrossoverStrategy strategy(2, 3);
+        binance::BacktestResult result = binance::Backtester(history).run(strategy);
+        // Long after the third candle (fills at the fourth's open, 103),
+        // flat after the sixth (fills at the seventh's open, 95)
+        expect(result.fills == 2, "entry and exit");
+        expect(result.quote == dec("-8") && result.position == dec("0"), "lost 8");
+        expect(std::fabs(result.pnl + 8) < 1e-9, "pnl");
+        expect(result.maxDrawdown >= 8, "drawdown covers the loss");
+    });
+
+    runTest("Sweep matches serial runs", []() {
+        TempFile file("sweep.bin");
+        binance::HistoryFile::writeTrades(file.path, "BTCUSDT", syntheticTrades(200000));
+        binance::HistoryFile history(file.path);
+        binance::BacktestConfig config;
+        config.latencyMicros = 2000;
+        config.takerFee = dec("0.00075");
+
+        auto factory = [](size_t index) { return std::make_unique<CrossoverStrategy>(5 + index * 5, 100); };
+        std::vector<binance::BacktestResult> parallel = binance::Backtester::sweep(history, 6, factory, config, 3);
+        expect(parallel.size() == 6, "one result per run");
+        for (size_t i = 0; i < parallel.size(); ++i) {
+            std::unique_ptr<binance::Strategy> strategy = factory(i);
+            binance::BacktestResult serial = binance::Backtester(history, config).run(*strategy);
+            expect(serial.fills > 0, "strategy trades");
+            expect(serial.fills == parallel[i].fills && serial.quote == parallel[i].quote &&
+                   serial.position == parallel[i].position && serial.pnl == parallel[i].pnl &&
+                   serial.maxDrawdown == parallel[i].maxDrawdown, "run " + std::to_string(i) + " identical");
+        }
+
+        bool propagated = false;
+        try {
+            binance::Backtester::sweep(history, 4, [](size_t) { return std::unique_ptr<binance::Strategy>(); });
+        } catch (const std::invalid_argument&) {
+            propagated = true;
+        }
+        expect(propagated, "factory errors reach the caller");
+    });
+
+    if (runBenchmark) {
+        std::cout << "\n=== Benchmark ===" << std::endl;
+        benchmark();
+    }
+
+    std::cout << "\n=======================================" << std::endl;
+    std::cout << (failures == 0 ? "ALL TESTS PASSED" : "SOME TESTS FAILED") << std::endl;
+    std::cout << "=======================================" << std::endl;
+
+    return failures == 0 ? 0 : 1;
+}
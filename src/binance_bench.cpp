@@ -0,0 +1,452 @@
+#include "../include/BinanceAPI.h"
+#include "../include/BinanceAuth.h"
+#include "../include/BinanceTypes.h"
+#include "../include/BinanceWsTradingClient.h"
+#include "../include/ExchangeSimulator.h"
+#include "../include/HttpClient.h"
+#include "../include/LatencyHistogram.h"
+#include "../include/RateLimiter.h"
+#include "../include/RequestBuilder.h"
+#include <curl/curl.h>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <new>
+#include <chrono>
+#include <stdexcept>
+
+// Allocations made by the measuring thread, through operator new or libcurl.
+// The simulator's threads keep their own counts, so they do not pollute ours.
+namespace {
+thread_local uint64_t allocations = 0;
+}
+
+void* operator new(std::size_t size) {
+    ++allocations;
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+namespace {
+
+const char* API_KEY = "bench-key";
+const char* API_SECRET = "bench-secret";
+
+void* countedMalloc(size_t size) {
+    ++allocations;
+    return std::malloc(size);
+}
+
+void* countedRealloc(void* memory, size_t size) {
+    ++allocations;
+    return std::realloc(memory, size);
+}
+
+char* countedStrdup(const char* text) {
+    ++allocations;
+    size_t size = std::strlen(text) + 1;
+    char* copy = static_cast<char*>(std::malloc(size));
+    if (copy) {
+        std::memcpy(copy, text, size);
+    }
+    return copy;
+}
+
+void* countedCalloc(size_t count, size_t size) {
+    ++allocations;
+    return std::calloc(count, size);
+}
+
+size_t collectBody(char* data, size_t size, size_t count, std::string* body) {
+    body->append(data, size * count);
+    return size * count;
+}
+
+size_t collectHeader(char* data, size_t size, size_t count, binance::ResponseInfo* info) {
+    info->parseHeader(std::string_view(data, size * count));
+    return size * count;
+}
+
+// Latency and allocations of one stage of the order path
+struct Stage {
+    const char* name;
+    const char* description;
+    binance::LatencyHistogram latency;
+    uint64_t allocations = 0;
+
+    Stage(const char* name, const char* description) : name(name), description(description) {}
+
+    void record(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end,
+                uint64_t allocated) {
+        latency.record(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        allocations += allocated;
+    }
+
+    double allocationsPerCall() const {
+        return latency.count() == 0 ? 0.0 : static_cast<double>(allocations) / latency.count();
+    }
+};
+
+enum StageIndex { PARAMS, SIGN, SERIALIZE, CURL_SETUP, ROUND_TRIP, PARSE, TOTAL, END_TO_END, REJECT_THROW, REJECT_TRY,
+                  WS_END_TO_END, WS_REJECT_TRY, STAGE_COUNT };
+
+struct Options {
+    int iterations = 20000;
+    int warmup = 1000;
+    int64_t latencyMicros = 0;
+    std::string jsonPath;
+    std::string label;
+};
+
+Options parseOptions(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string option = argv[i];
+        if (i + 1 >= argc) {
+            throw std::invalid_argument("Missing value for " + option);
+        }
+        std::string value = argv[++i];
+        if (option == "--iterations") {
+            options.iterations = std::stoi(value);
+        } else if (option == "--warmup") {
+            options.warmup = std::stoi(value);
+        } else if (option == "--latency") {
+            options.latencyMicros = std::stoll(value);
+        } else if (option == "--json") {
+            options.jsonPath = value;
+        } else if (option == "--label") {
+            options.label = value;
+        } else {
+            throw std::invalid_argument("Unknown option " + option);
+        }
+    }
+    if (options.iterations <= 0 || options.warmup < 0) {
+        throw std::invalid_argument("--iterations must be positive and --warmup not negative");
+    }
+    return options;
+}
+
+/**
+ * Drives the order path one stage at a time, the way BinanceAPI::createOrder
+ * does, so each stage can be timed on its own. The transport uses libcurl
+ * directly with the options HttpClient sets, which lets curl setup and the
+ * round trip be told apart.
+ */
+class StagedOrderPath {
+public:
+    explicit StagedOrderPath(const std::string& baseUrl)
+        : auth(API_KEY, API_SECRET), baseUrl(baseUrl), curl(curl_easy_init()) {
+        if (!curl) {
+            throw std::runtime_error("curl_easy_init failed");
+        }
+        for (const auto& header : auth.createHeaders()) {
+            headers = curl_slist_append(headers, (header.first + ": " + header.second).c_str());
+        }
+        headers = curl_slist_append(headers, "Content-Type: application/json");
+
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, collectBody);
+        curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, collectHeader);
+        curl_easy_setopt(curl, CURLOPT_TIMEOUT, 30L);
+        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 10L);
+        curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+        curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+        curl_easy_setopt(curl, CURLOPT_TCP_NODELAY, 1L);
+        curl_easy_setopt(curl, CURLOPT_DNS_CACHE_TIMEOUT, 300L);
+    }
+
+    ~StagedOrderPath() {
+        curl_slist_free_all(headers);
+        curl_easy_cleanup(curl);
+    }
+
+    StagedOrderPath(const StagedOrderPath&) = delete;
+    StagedOrderPath& operator=(const StagedOrderPath&) = delete;
+
+    // One LIMIT IOC order at the market price, which fills immediately and leaves the book empty
+    void placeOrder(bool buy, Stage* stages) {
+        using Clock = std::chrono::steady_clock;
+
+        const uint64_t allocatedBefore = allocations;
+        uint64_t allocated = allocatedBefore;
+        auto start = Clock::now();
+        binance::RequestBuilder request;
+        request.add("symbol", "BTCUSDT").add("side", buy ? "BUY" : "SELL").add("type", "LIMIT")
+               .add("timeInForce", "IOC").add("quantity", quantity).add("price", price);
+        auto signStart = Clock::now();
+        stages[PARAMS].record(start, signStart, allocations - allocated);
+
+        allocated = allocations;
+        auth.signRequest(request);
+        auto serializeStart = Clock::now();
+        stages[SIGN].record(signStart, serializeStart, allocations - allocated);
+
+        allocated = allocations;
+        binance::RequestBuilder url;
+        url.append(baseUrl).append("/api/v3/order");
+        auto setupStart = Clock::now();
+        stages[SERIALIZE].record(serializeStart, setupStart, allocations - allocated);
+
+        allocated = allocations;
+        std::string response;
+        binance::ResponseInfo info;
+        curl_easy_setopt(curl, CURLOPT_URL, url.data());
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
+        curl_easy_setopt(curl, CURLOPT_HEADERDATA, &info);
+        curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, nullptr);
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, static_cast<long>(request.size()));
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, request.data());
+        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+        auto performStart = Clock::now();
+        stages[CURL_SETUP].record(setupStart, performStart, allocations - allocated);
+
+        allocated = allocations;
+        CURLcode result = curl_easy_perform(curl);
+        long status = 0;
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &status);
+        auto parseStart = Clock::now();
+        stages[ROUND_TRIP].record(performStart, parseStart, allocations - allocated);
+        if (result != CURLE_OK || status != 200) {
+            throw std::runtime_error("Order failed (" + std::string(curl_easy_strerror(result)) + ", HTTP " +
+                                     std::to_string(status) + "): " + response);
+        }
+
+        allocated = allocations;
+        binance::OrderInfo order = binance::parseOrderInfo(response);
+        auto end = Clock::now();
+        stages[PARSE].record(parseStart, end, allocations - allocated);
+        stages[TOTAL].record(start, end, allocations - allocatedBefore);
+        if (order.status != binance::OrderStatus::FILLED) {
+            throw std::runtime_error("Order did not fill: " + response);
+        }
+    }
+
+private:
+    binance::BinanceAuth auth;
+    std::string baseUrl;
+    CURL* curl;
+    struct curl_slist* headers = nullptr;
+    binance::Decimal quantity = binance::Decimal::parse("0.001");
+    binance::Decimal price = binance::Decimal::fromInteger(50000);
+};
+
+// The same order through the public API, rate limiter and all; over REST or the WebSocket API
+template <typename Client>
+void placeOrderThroughApi(Client& api, bool buy, Stage& stage) {
+    uint64_t allocated = allocations;
+    auto start = std::chrono::steady_clock::now();
+    binance::RequestBuilder request;
+    request.add("timeInForce", "IOC").add("quantity", "0.001").add("price", "50000");
+    std::string response = api.createOrder("BTCUSDT", buy ? "BUY" : "SELL", "LIMIT", request);
+    binance::OrderInfo order = binance::parseOrderInfo(response);
+    stage.record(start, std::chrono::steady_clock::now(), allocations - allocated);
+    if (order.status != binance::OrderStatus::FILLED) {
+        throw std::runtime_error("Order did not fill: " + response);
+    }
+}
+
+// A LIMIT_MAKER that would take is rejected with -2010, caught as an exception
+void rejectThroughApi(binance::BinanceAPI& api, Stage& stage) {
+    uint64_t allocated = allocations;
+    auto start = std::chrono::steady_clock::now();
+    binance::RequestBuilder request;
+    request.add("quantity", "0.001").add("price", "51000");
+    try {
+        api.createOrder("BTCUSDT", "BUY", "LIMIT_MAKER", request);
+        throw std::logic_error("LIMIT_MAKER was not rejected");
+    } catch (const std::runtime_error&) {
+    }
+    stage.record(start, std::chrono::steady_clock::now(), allocations - allocated);
+}
+
+// The same reject reported in a reused Response
+template <typename Client>
+void rejectWithoutThrowing(Client& api, binance::Response& response, Stage& stage) {
+    uint64_t allocated = allocations;
+    auto start = std::chrono::steady_clock::now();
+    binance::RequestBuilder request;
+    request.add("quantity", "0.001").add("price", "51000");
+    bool placed = api.tryCreateOrder("BTCUSDT", "BUY", "LIMIT_MAKER", request, response);
+    stage.record(start, std::chrono::steady_clock::now(), allocations - allocated);
+    if (placed || response.code != -2010) {
+        throw std::runtime_error("Unexpected response to LIMIT_MAKER: " + response.body);
+    }
+}
+
+double micros(int64_t nanos) {
+    return nanos / 1000.0;
+}
+
+void printReport(const Options& options, const Stage* stages) {
+    std::cout << "\ncreateOrder against the local simulator, " << options.iterations << " orders";
+    if (options.latencyMicros > 0) {
+        std::cout << ", " << options.latencyMicros << " us injected latency";
+    }
+    std::cout << " (microseconds)\n" << std::endl;
+    std::cout << std::left << std::setw(14) << "stage" << std::right << std::setw(10) << "p50"
+              << std::setw(10) << "p99" << std::setw(10) << "p99.9" << std::setw(10) << "max"
+              << std::setw(10) << "mean" << std::setw(12) << "allocs" << "  " << "measures" << std::endl;
+    for (int i = 0; i < STAGE_COUNT; ++i) {
+        const Stage& stage = stages[i];
+        std::cout << std::left << std::setw(14) << stage.name << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(10) << micros(stage.latency.valueAtPercentile(50))
+                  << std::setw(10) << micros(stage.latency.valueAtPercentile(99))
+                  << std::setw(10) << micros(stage.latency.valueAtPercentile(99.9))
+                  << std::setw(10) << micros(stage.latency.max())
+                  << std::setw(10) << stage.latency.mean() / 1000.0
+                  << std::setw(12) << stage.allocationsPerCall() << "  " << stage.description << std::endl;
+    }
+}
+
+std::string jsonEscape(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if (static_cast<unsigned char>(c) >= 0x20) {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+// One object per stage, in nanoseconds, stable enough to diff from commit to commit
+std::string jsonReport(const Options& options, const Stage* stages) {
+    std::ostringstream json;
+    json << "{\n  \"benchmark\": \"createOrder\",\n  \"label\": \"" << jsonEscape(options.label) << "\",\n"
+         << "  \"iterations\": " << options.iterations << ",\n"
+         << "  \"injectedLatencyMicros\": " << options.latencyMicros << ",\n"
+         << "  \"unit\": \"ns\",\n  \"stages\": [";
+    for (int i = 0; i < STAGE_COUNT; ++i) {
+        const Stage& stage = stages[i];
+        json << (i == 0 ? "\n" : ",\n") << std::fixed << std::setprecision(2)
+             << "    {\"name\": \"" << stage.name << "\", \"count\": " << stage.latency.count()
+             << ", \"p50\": " << stage.latency.valueAtPercentile(50)
+             << ", \"p99\": " << stage.latency.valueAtPercentile(99)
+             << ", \"p999\": " << stage.latency.valueAtPercentile(99.9)
+             << ", \"max\": " << stage.latency.max()
+             << ", \"mean\": " << stage.latency.mean()
+             << ", \"allocationsPerCall\": " << stage.allocationsPerCall() << "}";
+    }
+    json << "\n  ]\n}\n";
+    return json.str();
+}
+
+} // namespace
+
+// Times every stage of createOrder against a loopback ExchangeSimulator
+int main(int argc, char** argv) {
+    Options options;
+    try {
+        options = parseOptions(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n\nUsage: " << argv[0]
+                  << " [--iterations N] [--warmup N] [--latency MICROS] [--json FILE|-] [--label TEXT]" << std::endl;
+        return 1;
+    }
+
+    // Route libcurl's allocations through the counters; must precede any other curl call
+    curl_global_init_mem(CURL_GLOBAL_ALL, countedMalloc, std::free, countedRealloc, countedStrdup, countedCalloc);
+
+    try {
+        binance::SimulatorConfig config;
+        config.apiKey = API_KEY;
+        config.apiSecret = API_SECRET;
+        config.latencyMicros = options.latencyMicros;
+        config.weightLimit = int64_t(1) << 40;
+        config.orderLimit10s = int64_t(1) << 40;
+        config.orderLimit1d = int64_t(1) << 40;
+        binance::ExchangeSimulator simulator(config);
+        simulator.setPrice("BTCUSDT", binance::Decimal::fromInteger(50000));
+        simulator.start();
+
+        Stage stages[STAGE_COUNT] = {
+            {"params", "RequestBuilder with symbol, side, type, TIF, quantity, price"},
+            {"sign", "timestamp and HMAC-SHA256 signature"},
+            {"serialize", "URL assembly; the signed query is the body"},
+            {"curl_setup", "per-request curl options"},
+            {"round_trip", "curl_easy_perform over loopback keep-alive"},
+            {"parse", "parseOrderInfo of the FULL response"},
+            {"total", "sum of the stages above"},
+            {"end_to_end", "BinanceAPI::createOrder plus parseOrderInfo"},
+            {"reject_throw", "-2010 reject caught as an exception"},
+            {"reject_try", "-2010 reject from tryCreateOrder"},
+            {"ws_end_to_end", "BinanceWsTradingClient::createOrder plus parseOrderInfo"},
+            {"ws_reject_try", "-2010 reject from BinanceWsTradingClient::tryCreateOrder"},
+        };
+        Stage discarded[STAGE_COUNT] = {
+            {"", ""}, {"", ""}, {"", ""}, {"", ""}, {"", ""}, {"", ""}, {"", ""}, {"", ""}, {"", ""}, {"", ""},
+            {"", ""}, {"", ""},
+        };
+        binance::Response response;
+
+        StagedOrderPath staged(simulator.baseUrl());
+        binance::BinanceAPI api(API_KEY, API_SECRET, simulator.baseUrl());
+        api.rateLimiter().setEnabled(false);
+        binance::BinanceWsTradingClient wsApi(API_KEY, API_SECRET, simulator.webSocketApiUrl());
+        wsApi.rateLimiter().setEnabled(false);
+        wsApi.connect();
+
+        for (int i = 0; i < options.warmup; ++i) {
+            staged.placeOrder(i % 2 == 0, discarded);
+            placeOrderThroughApi(api, i % 2 == 0, discarded[END_TO_END]);
+            rejectThroughApi(api, discarded[REJECT_THROW]);
+            rejectWithoutThrowing(api, response, discarded[REJECT_TRY]);
+            placeOrderThroughApi(wsApi, i % 2 == 0, discarded[WS_END_TO_END]);
+            rejectWithoutThrowing(wsApi, response, discarded[WS_REJECT_TRY]);
+        }
+        for (int i = 0; i < options.iterations; ++i) {
+            staged.placeOrder(i % 2 == 0, stages);
+        }
+        for (int i = 0; i < options.iterations; ++i) {
+            placeOrderThroughApi(api, i % 2 == 0, stages[END_TO_END]);
+        }
+        for (int i = 0; i < options.iterations; ++i) {
+            rejectThroughApi(api, stages[REJECT_THROW]);
+        }
+        for (int i = 0; i < options.iterations; ++i) {
+            rejectWithoutThrowing(api, response, stages[REJECT_TRY]);
+        }
+        for (int i = 0; i < options.iterations; ++i) {
+            placeOrderThroughApi(wsApi, i % 2 == 0, stages[WS_END_TO_END]);
+        }
+        for (int i = 0; i < options.iterations; ++i) {
+            rejectWithoutThrowing(wsApi, response, stages[WS_REJECT_TRY]);
+        }
+        wsApi.close();
+        simulator.stop();
+
+        printReport(options, stages);
+        if (options.jsonPath == "-") {
+            std::cout << "\n" << jsonReport(options, stages);
+        } else if (!options.jsonPath.empty()) {
+            std::ofstream file(options.jsonPath);
+            file << jsonReport(options, stages);
+            if (!file) {
+                throw std::runtime_error("Could not write " + options.jsonPath);
+            }
+            std::cout << "\nWrote " << options.jsonPath << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Fatal error: " << e.what() << std::endl;
+        curl_global_cleanup();
+        return 1;
+    }
+
+    curl_global_cleanup();
+    return 0;
+}
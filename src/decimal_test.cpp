@@ -0,0 +1,152 @@
+#include "../include/Decimal.h"
+#include "../include/RequestBuilder.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <functional>
+#include <stdexcept>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+int failures = 0;
+
+void printTestResult(const std::string& testName, bool success) {
+    std::cout << std::left << std::setw(50) << testName << " : "
+              << (success ? "PASSED" : "FAILED") << std::endl;
+}
+
+void runTest(const std::string& testName, std::function<void()> testFunction) {
+    std::cout << "\n=== Running test: " << testName << " ===" << std::endl;
+    try {
+        testFunction();
+        printTestResult(testName, true);
+    } catch (const std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        printTestResult(testName, false);
+        ++failures;
+    }
+}
+
+void expectEqual(const std::string& actual, const std::string& expected, const std::string& what) {
+    if (actual != expected) {
+        throw std::runtime_error(what + ": expected " + expected + ", got " + actual);
+    }
+}
+
+using binance::Decimal;
+
+Decimal d(const char* text) {
+    return Decimal::parse(text);
+}
+
+void benchmark() {
+    const char* samples[] = {"0.00100000", "50000.01000000", "19.99500000", "0.00000114"};
+    const size_t iterations = 5000000;
+    char buffer[32];
+    int64_t sink = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        Decimal value;
+        const char* text = samples[i & 3];
+        binance::from_chars(text, text + std::char_traits<char>::length(text), value);
+        sink += binance::to_chars(buffer, buffer + sizeof(buffer), value).ptr - buffer;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "  Decimal parse+format: " << std::fixed << std::setprecision(1)
+              << (elapsed.count() / iterations * 1e9) << " ns" << std::endl;
+
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        const char* text = samples[i & 3];
+        double value = std::strtod(text, nullptr);
+        sink += std::snprintf(buffer, sizeof(buffer), "%.8f", value);
+    }
+    elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "  strtod+snprintf:      " << std::fixed << std::setprecision(1)
+              << (elapsed.count() / iterations * 1e9) << " ns" << (sink == 0 ? " " : "") << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool runBenchmark = argc > 1 && std::string(argv[1]) == "--bench";
+
+    std::cout << "\n\n=======================================" << std::endl;
+    std::cout << "DECIMAL TESTS" << std::endl;
+    std::cout << "=======================================" << std::endl;
+
+    runTest("Parse and format", []() {
+        expectEqual(d("0.00100000").toString(), "0.001", "trailing zeros");
+        expectEqual(d("50000").toString(), "50000", "integer");
+        expectEqual(d("-12.5").toString(), "-12.5", "negative");
+        expectEqual(d(".5").toString(), "0.5", "leading dot");
+        expectEqual(d("0.00000001").toString(), "0.00000001", "smallest unit");
+        expectEqual(d("92233720368.54775807").toString(), "92233720368.54775807", "largest value");
+        expectEqual(d("1.2300000000").toString(), "1.23", "zero digits past the scale");
+        expectEqual(d("3999.99999").toString(2), "4000.00", "fixed places round");
+        expectEqual(d("-0.005").toString(2), "-0.01", "fixed places half away from zero");
+        expectEqual(d("7").toString(0), "7", "no places");
+
+        for (const char* bad : {"", "-", "abc", "1.000000001", "92233720369", "1e5", "1.2.3"}) {
+            bool threw = false;
+            try {
+                Decimal::parse(bad);
+            } catch (const std::invalid_argument&) {
+                threw = true;
+            }
+            if (!threw) {
+                throw std::runtime_error(std::string("accepted ") + bad);
+            }
+        }
+    });
+
+    runTest("Arithmetic", []() {
+        expectEqual((d("0.1") + d("0.2")).toString(), "0.3", "exact addition");
+        expectEqual((d("0.3") - d("0.1") - d("0.2")).toString(), "0", "exact subtraction");
+        expectEqual((d("50000.01") * d("0.001")).toString(), "50.00001", "multiplication");
+        expectEqual((d("1.5") * d("-2.25")).toString(), "-3.375", "signed multiplication");
+        expectEqual((d("0.00000001") * d("0.5")).toString(), "0.00000001", "product rounds half away");
+        expectEqual((d("12345678.9") * d("7000")).toString(), "86419752300", "large product");
+        expectEqual((d("1") / d("3")).toString(), "0.33333333", "division");
+        expectEqual((d("-2") / d("3")).toString(), "-0.66666667", "signed division rounds");
+        expectEqual((d("500") / d("0.00000001")).toString(), "50000000000", "division by small value");
+        if (!(d("0.1") < d("0.10000001")) || d("2") != Decimal::fromInteger(2)) {
+            throw std::runtime_error("comparison");
+        }
+    });
+
+    runTest("Tick and step rounding", []() {
+        Decimal tick = d("0.01");
+        expectEqual(d("50000.015").round(tick).toString(), "50000.02", "nearest");
+        expectEqual(d("50000.014").round(tick).toString(), "50000.01", "nearest below half");
+        expectEqual(d("50000.019").round(tick, Decimal::Rounding::DOWN).toString(), "50000.01", "down");
+        expectEqual(d("50000.011").round(tick, Decimal::Rounding::UP).toString(), "50000.02", "up");
+        expectEqual(d("-1.005").round(tick, Decimal::Rounding::DOWN).toString(), "-1.01", "down is floor");
+        expectEqual(d("0.123456").round(d("0.00001"), Decimal::Rounding::DOWN).toString(), "0.12345", "step");
+        expectEqual(d("7").round(d("0.25")).toString(), "7", "already on tick");
+        if (!d("1.25").isMultipleOf(d("0.05")) || d("1.26").isMultipleOf(d("0.05"))) {
+            throw std::runtime_error("isMultipleOf");
+        }
+        expectEqual(Decimal::fromDouble(0.1 + 0.2).toString(), "0.3", "fromDouble snaps float noise");
+    });
+
+    runTest("Request builder", []() {
+        binance::RequestBuilder request;
+        request.add("quantity", d("0.00100000")).add("price", d("50000.10"));
+        expectEqual(request.str(), "quantity=0.001&price=50000.1", "formatted parameters");
+    });
+
+    if (runBenchmark) {
+        benchmark();
+    }
+
+    std::cout << "\n=======================================" << std::endl;
+    std::cout << (failures == 0 ? "ALL TESTS PASSED" : "SOME TESTS FAILED") << std::endl;
+    std::cout << "=======================================" << std::endl;
+
+    return failures == 0 ? 0 : 1;
+}
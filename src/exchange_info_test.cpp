@@ -0,0 +1,493 @@
+#include "../include/ExchangeInfo.h"
+#include "../include/SymbolRegistry.h"
+#include "../include/BinanceAPI.h"
+#include "../include/BinanceUtils.h"
+#include "../include/ExchangeSimulator.h"
+#include "../include/OrderGateway.h"
+#include "../include/RequestBuilder.h"
+#include "../include/RiskEngine.h"
+#include "test_exchange.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <functional>
+#include <stdexcept>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <fstream>
+#include <cstdio>
+#include <unistd.h>
+
+namespace {
+
+using binance::Decimal;
+using binance::FilterResult;
+using binance::OrderSide;
+using binance::OrderType;
+using binance::SymbolFilters;
+using binance::SymbolId;
+
+int failures = 0;
+
+void printTestResult(const std::string& testName, bool success) {
+    std::cout << std::left << std::setw(50) << testName << " : "
+              << (success ? "PASSED" : "FAILED") << std::endl;
+}
+
+void runTest(const std::string& testName, std::function<void()> testFunction) {
+    std::cout << "\n=== Running test: " << testName << " ===" << std::endl;
+    try {
+        testFunction();
+        printTestResult(testName, true);
+    } catch (const std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        printTestResult(testName, false);
+        ++failures;
+    }
+}
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        throw std::runtime_error("check failed: " + what);
+    }
+}
+
+Decimal dec(const char* text) {
+    return Decimal::parse(text);
+}
+
+std::string tempPath(const char* name) {
+    return "/tmp/exchange_info_test_" + std::to_string(::getpid()) + "_" + name;
+}
+
+// Shaped like the exchange's response: a legacy MIN_NOTIONAL, PERCENT_PRICE and an oversized maxQty
+const char* const EXCHANGE_INFO = R"({
+  "timezone": "UTC", "serverTime": 1700000000000,
+  "rateLimits": [{"rateLimitType": "REQUEST_WEIGHT", "interval": "MINUTE", "intervalNum": 1, "limit": 6000}],
+  "exchangeFilters": [],
+  "symbols": [
+    {"symbol": "BTCUSDT", "status": "TRADING", "baseAsset": "BTC", "baseAssetPrecision": 8,
+     "quoteAsset": "USDT", "quotePrecision": 8, "quoteAssetPrecision": 8, "orderTypes": ["LIMIT", "MARKET"],
+     "filters": [
+       {"filterType": "PRICE_FILTER", "minPrice": "0.01000000", "maxPrice": "1000000.00000000", "tickSize": "0.01000000"},
+       {"filterType": "LOT_SIZE", "minQty": "0.00001000", "maxQty": "9000.00000000", "stepSize": "0.00001000"},
+       {"filterType": "ICEBERG_PARTS", "limit": 10},
+       {"filterType": "MARKET_LOT_SIZE", "minQty": "0.00000000", "maxQty": "120.00000000", "stepSize": "0.00000000"},
+       {"filterType": "NOTIONAL", "minNotional": "5.00000000", "applyMinToMarket": true,
+        "maxNotional": "9000000.00000000", "applyMaxToMarket": false, "avgPriceMins": 5},
+       {"filterType": "PERCENT_PRICE_BY_SIDE", "bidMultiplierUp": "5", "bidMultiplierDown": "0.2",
+        "askMultiplierUp": "5", "askMultiplierDown": "0.2", "avgPriceMins": 5}
+     ],
+     "permissions": [], "permissionSets": [["SPOT"]], "defaultSelfTradePreventionMode": "EXPIRE_MAKER"},
+    {"symbol": "SHIBUSDT", "status": "TRADING", "baseAsset": "SHIB", "quoteAsset": "USDT",
+     "baseAssetPrecision": 2, "quoteAssetPrecision": 8,
+     "filters": [
+       {"tickSize": "0.00000001", "minPrice": "0.00000001", "maxPrice": "1.00000000", "filterType": "PRICE_FILTER"},
+       {"filterType": "LOT_SIZE", "minQty": "1.00", "maxQty": "92233720368547758.07", "stepSize": "1.00"},
+       {"filterType": "MIN_NOTIONAL", "minNotional": "1.00000000", "applyToMarket": false, "avgPriceMins": 5},
+       {"filterType": "PERCENT_PRICE", "multiplierUp": "1.3", "multiplierDown": "0.7", "avgPriceMins": 5}
+     ]},
+    {"symbol": "OLDUSDT", "status": "BREAK", "baseAsset": "OLD", "quoteAsset": "USDT", "filters": []}
+  ]
+})";
+
+// The test exchange with ETHUSDT listed too and exchange-like BTCUSDT filters
+struct FilteredExchange : binance::test::Exchange {
+    FilteredExchange() {
+        simulator.setPrice("ETHUSDT", dec("3000"));
+        SymbolFilters filters;
+        filters.trading = true;
+        filters.minPrice = filters.tickSize = dec("0.01");
+        filters.maxPrice = dec("1000000");
+        filters.minQty = filters.stepSize = dec("0.00001");
+        filters.maxQty = dec("9000");
+        filters.minNotional = dec("5");
+        filters.bidMultiplierUp = filters.askMultiplierUp = dec("5");
+        filters.bidMultiplierDown = filters.askMultiplierDown = dec("0.2");
+        simulator.setFilters("BTCUSDT", filters);
+    }
+};
+
+void benchmark() {
+    // A table the size of the exchange's, to time the cold and warm loads
+    std::string json = R"({"serverTime":1700000000000,"symbols":[)";
+    for (int i = 0; i < 2000; ++i) {
+        if (i > 0) json += ',';
+        json += R"({"symbol":"SYM)" + std::to_string(i) + R"(USDT","status":"TRADING","baseAsset":"SYM","quoteAsset":"USDT",)"
+                R"("orderTypes":["LIMIT","LIMIT_MAKER","MARKET","STOP_LOSS_LIMIT","TAKE_PROFIT_LIMIT"],"filters":[)"
+                R"({"filterType":"PRICE_FILTER","minPrice":"0.01000000","maxPrice":"1000000.00000000","tickSize":"0.01000000"},)"
+                R"({"filterType":"LOT_SIZE","minQty":"0.00001000","maxQty":"9000.00000000","stepSize":"0.00001000"},)"
+                R"({"filterType":"NOTIONAL","minNotional":"5.00000000","applyMinToMarket":true,"maxNotional":"9000000.00000000","applyMaxToMarket":false,"avgPriceMins":5}]})";
+    }
+    json += "]}";
+
+    binance::SymbolRegistry registry;
+    binance::ExchangeInfoCache cache(registry);
+    const int loads = 20;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < loads; ++i) cache.load(json);
+    double parseMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / loads;
+
+    std::string path = tempPath("bench.bin");
+    cache.saveSnapshot(path);
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < loads; ++i) cache.loadSnapshot(path);
+    double snapshotMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / loads;
+    std::remove(path.c_str());
+    std::cout << "Load 2000 symbols (" << json.size() / 1024 << " KiB): JSON " << parseMs << " ms, snapshot "
+              << snapshotMs << " ms" << std::endl;
+
+    const int rounds = 10000000;
+    SymbolId id = registry.find("SYM1234USDT");
+    int64_t sink = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; ++i) {
+        sink += cache.find(static_cast<SymbolId>(id ^ (i & 1)))->tickSize.units();
+    }
+    double byId = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / rounds;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds / 10; ++i) {
+        sink += cache.find(i & 1 ? "SYM1234USDT" : "SYM77USDT")->tickSize.units();
+    }
+    double byName = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (rounds / 10);
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; ++i) {
+        Decimal price = Decimal::fromUnits(5000012345678 + i);
+        Decimal quantity = Decimal::fromUnits(123456 + i);
+        sink += static_cast<int64_t>(cache.normalize(id, OrderSide::BUY, OrderType::LIMIT, price, quantity));
+        sink += price.units() + quantity.units();
+    }
+    double normalize = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / rounds;
+    std::cout << "find by id " << byId << " ns, by name " << byName << " ns, normalize + check " << normalize
+              << " ns (" << sink % 10 << ")" << std::endl;
+
+    // The order prefix and risk lookup as the string and id overloads of createOrder build them
+    binance::RiskEngine risk(registry);
+    binance::RiskLimits limits;
+    limits.maxOrderQty = Decimal::fromUnits(100000000);
+    risk.setLimits("SYM1234USDT", limits);
+    binance::RequestBuilder request;
+    std::string symbol = "SYM1234USDT";
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; ++i) {
+        request.clear();
+        request.add("symbol", symbol).add("side", "BUY").add("type", "LIMIT");
+        sink += static_cast<int64_t>(risk.check(registry.find(symbol), OrderSide::BUY, OrderType::LIMIT,
+                                                Decimal(), Decimal::fromUnits(1000)));
+        sink += request.size();
+    }
+    double prefixByName = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / rounds;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; ++i) {
+        request.clear();
+        request.addPair(registry.param(id)).add("side", "BUY").add("type", "LIMIT");
+        sink += static_cast<int64_t>(risk.check(id, OrderSide::BUY, OrderType::LIMIT, Decimal(),
+                                                Decimal::fromUnits(1000)));
+        sink += request.size();
+    }
+    double prefixById = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / rounds;
+    std::cout << "order prefix + risk check by name " << prefixByName << " ns, by id " << prefixById
+              << " ns (" << sink % 10 << ")" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool runBenchmark = argc > 1 && std::string(argv[1]) == "--bench";
+
+    std::cout << "\n\n=======================================" << std::endl;
+    std::cout << "EXCHANGE INFO TESTS" << std::endl;
+    std::cout << "=======================================" << std::endl;
+
+    runTest("Symbol registry", []() {
+        binance::SymbolRegistry registry;
+        SymbolId btc = registry.intern("BTCUSDT");
+        expect(btc == 0 && registry.intern("ETHUSDT") == 1, "dense ids in order");
+        expect(registry.intern("btcusdt") == btc && registry.find("BtcUsdt") == btc, "names are upper-cased");
+        expect(registry.find("XRPUSDT") == binance::INVALID_SYMBOL, "unknown symbol");
+        expect(registry.name(1) == "ETHUSDT", "name of id");
+        for (int i = 0; i < 1000; ++i) {
+            registry.intern("SYM" + std::to_string(i));
+        }
+        expect(registry.size() == 1002, "grown");
+        expect(registry.find("SYM999") == 1001 && registry.find("BTCUSDT") == btc, "ids stable across growth");
+        bool threw = false;
+        try {
+            registry.intern("");
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        expect(threw, "empty symbol rejected");
+
+        expect(registry.param(btc) == "symbol=BTCUSDT", "pre-rendered parameter");
+        binance::RequestBuilder request;
+        request.addPair(registry.param(1)).add("side", "BUY").addPair("type=LIMIT");
+        expect(request.view() == "symbol=ETHUSDT&side=BUY&type=LIMIT", "pairs joined like parameters");
+        threw = false;
+        try {
+            registry.param(binance::INVALID_SYMBOL);
+        } catch (const std::out_of_range&) {
+            threw = true;
+        }
+        expect(threw, "parameter of an unknown id");
+    });
+
+    runTest("Parse exchangeInfo filters", []() {
+        binance::SymbolRegistry registry;
+        registry.intern("ETHUSDT");
+        binance::ExchangeInfoCache cache(registry);
+        expect(cache.load(EXCHANGE_INFO) == 3 && cache.size() == 3, "three symbols");
+        expect(cache.updateTime() == 1700000000000, "server time kept");
+
+        const SymbolFilters* btc = cache.find("BTCUSDT");
+        expect(btc && btc->trading && btc->baseAsset == "BTC" && btc->quoteAsset == "USDT", "symbol fields");
+        expect(cache.find(registry.find("BTCUSDT")) == btc, "lookup by id");
+        expect(btc->tickSize == dec("0.01") && btc->maxPrice == dec("1000000"), "price filter");
+        expect(btc->stepSize == dec("0.00001") && btc->maxQty == dec("9000"), "lot size");
+        expect(btc->marketMaxQty == dec("120") && btc->marketStepSize.isZero(), "market lot size");
+        expect(btc->minNotional == dec("5") && btc->applyMinToMarket && !btc->applyMaxToMarket, "notional");
+        expect(btc->bidMultiplierUp == dec("5") && btc->askMultiplierDown == dec("0.2"), "percent price by side");
+        expect(btc->pricePrecision() == 2 && btc->quantityPrecision() == 5, "precisions");
+
+        const SymbolFilters* shib = cache.find("SHIBUSDT");
+        expect(shib && shib->pricePrecision() == 8 && shib->quantityPrecision() == 0, "small tick");
+        expect(shib->maxQty == Decimal::fromUnits(INT64_MAX), "oversized limit means no limit");
+        expect(shib->minNotional == dec("1") && !shib->applyMinToMarket, "legacy MIN_NOTIONAL");
+        expect(shib->bidMultiplierUp == dec("1.3") && shib->askMultiplierDown == dec("0.7"), "PERCENT_PRICE on both sides");
+        expect(!cache.find("OLDUSDT")->trading, "status");
+        expect(cache.find("ETHUSDT") == nullptr, "interned but not loaded");
+    });
+
+    runTest("Rounding and local checks", []() {
+        binance::SymbolRegistry registry;
+        binance::ExchangeInfoCache cache(registry);
+        cache.load(EXCHANGE_INFO);
+        const SymbolFilters& btc = *cache.find("BTCUSDT");
+
+        expect(btc.roundPrice(dec("50000.005")) == dec("50000.01"), "nearest tick");
+        expect(btc.roundQuantity(dec("0.12345678")) == dec("0.12345"), "step rounds down");
+        expect(btc.check(OrderSide::BUY, OrderType::LIMIT, dec("50000.01"), dec("0.001")) == FilterResult::OK, "valid");
+        expect(btc.check(OrderSide::BUY, OrderType::LIMIT, dec("50000.015"), dec("0.001")) == FilterResult::PRICE_FILTER,
+               "off tick");
+        expect(btc.check(OrderSide::BUY, OrderType::LIMIT, dec("2000000"), dec("0.001")) == FilterResult::PRICE_FILTER,
+               "above max price");
+        expect(btc.check(OrderSide::BUY, OrderType::LIMIT, dec("50000"), dec("0.0000123")) == FilterResult::LOT_SIZE,
+               "off step");
+        expect(btc.check(OrderSide::BUY, OrderType::LIMIT, dec("50000"), dec("10000")) == FilterResult::LOT_SIZE,
+               "above max quantity");
+        expect(btc.check(OrderSide::BUY, OrderType::LIMIT, dec("50000"), dec("0.00005")) == FilterResult::NOTIONAL,
+               "below min notional");
+        expect(btc.check(OrderSide::BUY, OrderType::MARKET, Decimal(), dec("200")) == FilterResult::MARKET_LOT_SIZE,
+               "above market max quantity");
+        expect(btc.check(OrderSide::BUY, OrderType::MARKET, Decimal(), dec("0.00005"), dec("50000")) ==
+               FilterResult::NOTIONAL, "market notional from the reference price");
+        expect(btc.check(OrderSide::SELL, OrderType::LIMIT, dec("9000"), dec("0.001"), dec("50000")) ==
+               FilterResult::PERCENT_PRICE, "ask below the band");
+        expect(btc.check(OrderSide::SELL, OrderType::LIMIT, dec("9000"), dec("0.001")) == FilterResult::OK,
+               "no band without a reference price");
+        expect(cache.find("OLDUSDT")->check(OrderSide::BUY, OrderType::LIMIT, dec("1"), dec("1")) ==
+               FilterResult::NOT_TRADING, "halted symbol");
+        expect(cache.check(binance::INVALID_SYMBOL, OrderSide::BUY, OrderType::LIMIT, dec("1"), dec("1")) ==
+               FilterResult::UNKNOWN_SYMBOL, "unknown symbol");
+
+        Decimal bid = dec("50000.019");
+        Decimal quantity = dec("0.0012345");
+        expect(btc.normalize(OrderSide::BUY, OrderType::LIMIT, bid, quantity) == FilterResult::OK, "bid normalized");
+        expect(bid == dec("50000.01") && quantity == dec("0.00123"), "bid rounded down, quantity down");
+        Decimal ask = dec("50000.011");
+        quantity = dec("0.001");
+        btc.normalize(OrderSide::SELL, OrderType::LIMIT, ask, quantity);
+        expect(ask == dec("50000.02"), "ask rounded up");
+        expect(std::string(binance::toString(FilterResult::LOT_SIZE)) == "LOT_SIZE", "filter names");
+    });
+
+    runTest("Binary snapshot", []() {
+        binance::SymbolRegistry registry;
+        binance::ExchangeInfoCache cache(registry);
+        cache.load(EXCHANGE_INFO);
+        std::string path = tempPath("snapshot.bin");
+        cache.saveSnapshot(path);
+
+        binance::SymbolRegistry otherRegistry;
+        otherRegistry.intern("XRPUSDT");
+        binance::ExchangeInfoCache restored(otherRegistry);
+        expect(restored.loadSnapshot(path), "loaded");
+        expect(restored.size() == 3 && restored.updateTime() == cache.updateTime(), "same table");
+        const SymbolFilters* btc = restored.find("BTCUSDT");
+        expect(btc && otherRegistry.find("BTCUSDT") == 1, "interned into the new registry");
+        expect(btc->tickSize == dec("0.01") && btc->minNotional == dec("5") && btc->baseAsset == "BTC", "filters kept");
+
+        // Saved with the exchange's serverTime, long ago
+        expect(!restored.loadSnapshot(path, 60000), "too old");
+        expect(restored.loadSnapshot(path, -1), "any age");
+
+        {
+            std::ofstream corrupt(path, std::ios::binary | std::ios::trunc);
+            corrupt << "not a snapshot";
+        }
+        expect(!restored.loadSnapshot(path), "corrupt file refused");
+        expect(restored.size() == 3, "table untouched after a refused load");
+        std::remove(path.c_str());
+        expect(!restored.loadSnapshot(path), "missing file");
+    });
+
+    runTest("Fetch, warm start and simulator filters", []() {
+        FilteredExchange exchange;
+        binance::SymbolRegistry registry;
+        binance::ExchangeInfoCache cache(registry);
+        expect(cache.fetch(exchange.api, {"BTCUSDT"}) == 1, "one symbol fetched");
+        expect(cache.fetch(exchange.api, {"BTCUSDT", "ETHUSDT"}) == 2, "symbols list");
+        const SymbolFilters* btc = cache.find("BTCUSDT");
+        expect(btc->tickSize == dec("0.01") && btc->bidMultiplierUp == dec("5"), "simulator filters reported");
+        expect(cache.find("ETHUSDT")->tickSize == dec("0.00000001"), "unfiltered symbol reports the finest tick");
+
+        // The simulator rejects what the cache would have caught
+        try {
+            exchange.api.createOrder("BTCUSDT", "BUY", "LIMIT",
+                                     {{"timeInForce", "GTC"}, {"price", "49000.005"}, {"quantity", "0.001"}});
+            expect(false, "off-tick order accepted");
+        } catch (const std::runtime_error& e) {
+            expect(std::string(e.what()).find("Filter failure: PRICE_FILTER") != std::string::npos, "exchange reject");
+        }
+        Decimal price = dec("49000.005");
+        Decimal quantity = dec("0.0010001");
+        expect(btc->normalize(OrderSide::BUY, OrderType::LIMIT, price, quantity, dec("50000")) == FilterResult::OK,
+               "normalized");
+        exchange.api.createOrder("BTCUSDT", "BUY", "LIMIT", {{"timeInForce", "GTC"}, {"price", price.toString()},
+                                                             {"quantity", quantity.toString()}});
+
+        std::string path = tempPath("warm.bin");
+        std::remove(path.c_str());
+        binance::ExchangeInfoCache cold(registry);
+        uint64_t before = exchange.simulator.requestCount();
+        expect(cold.warmStart(exchange.api, path) == 2, "cold start fetched");
+        expect(exchange.simulator.requestCount() == before + 1, "one request");
+        binance::ExchangeInfoCache warm(registry);
+        expect(warm.warmStart(exchange.api, path) == 2, "warm start");
+        expect(exchange.simulator.requestCount() == before + 1, "no request on a warm start");
+        std::remove(path.c_str());
+    });
+
+    runTest("Order helpers use the symbol's precision", []() {
+        binance::SymbolRegistry registry;
+        binance::ExchangeInfoCache cache(registry);
+        cache.load(EXCHANGE_INFO);
+        expect(binance::getPricePrecision(cache, "SHIBUSDT") == 8, "precision from tick size");
+        expect(binance::getPricePrecision(cache, "XRPUSDT") == 2, "fallback for unknown symbols");
+        expect(binance::getPricePrecision(cache, registry.find("SHIBUSDT")) == 8, "precision by id");
+
+        const SymbolFilters& shib = *cache.find("SHIBUSDT");
+        binance::OCODecimalPrices prices = binance::calculateOCOPrices(dec("0.00001234"), true, shib);
+        expect(prices.limitPrice > prices.stopPrice && prices.stopPrice > prices.stopLimitPrice, "sell OCO ordering");
+        std::map<std::string, std::string> params =
+            binance::createOCOParams(prices, dec("1000000.7"), OrderSide::SELL, shib);
+        expect(params["stopLimitPrice"].size() == 10 && params["stopLimitPrice"].compare(0, 2, "0.") == 0,
+               "eight places, not two");
+        expect(params["quantity"] == "1000000", "quantity on the step");
+
+        bool threw = false;
+        try {
+            binance::createOCOParams(prices, dec("10"), OrderSide::SELL, shib);
+        } catch (const std::invalid_argument& e) {
+            threw = std::string(e.what()).find("NOTIONAL") != std::string::npos;
+        }
+        expect(threw, "notional checked before sending");
+    });
+
+    runTest("Order gateway rejects locally", []() {
+        FilteredExchange exchange;
+        binance::SymbolRegistry registry;
+        binance::ExchangeInfoCache cache(registry);
+        cache.fetch(exchange.api);
+        binance::RestOrderGateway gateway(exchange.api);
+        gateway.setFilters(&cache);
+
+        binance::OrderParams order;
+        order.symbol = "BTCUSDT";
+        order.side = OrderSide::BUY;
+        order.type = OrderType::LIMIT;
+        order.timeInForce = binance::TimeInForce::GTC;
+        order.price = dec("49000.019");
+        order.quantity = dec("0.0010009");
+        gateway.placeOrder(order);
+
+        order.quantity = dec("0.00001");  // 0.49 USDT, under the minimum notional
+        uint64_t before = exchange.simulator.requestCount();
+        gateway.placeOrder(order);
+        expect(exchange.simulator.requestCount() == before, "not sent");
+
+        std::vector<binance::OrderUpdateEvent> updates;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (updates.size() < 2 && std::chrono::steady_clock::now() < deadline) {
+            gateway.poll([&](const binance::OrderUpdateEvent& update) { updates.push_back(update); });
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        expect(updates.size() == 2, "both answered");
+        int accepted = updates[0].status == binance::OrderStatus::NEW ? 0 : 1;
+        expect(updates[accepted].status == binance::OrderStatus::NEW, "rounded order accepted");
+        expect(updates[accepted].price == dec("49000.01") && updates[accepted].quantity == dec("0.001"), "rounded");
+        const binance::OrderUpdateEvent& rejected = updates[1 - accepted];
+        expect(rejected.status == binance::OrderStatus::REJECTED && rejected.errorCode == -1013, "rejected locally");
+        expect(gateway.filterRejects() == 1, "counted");
+    });
+
+    runTest("Orders by symbol id", []() {
+        FilteredExchange exchange;
+        binance::BinanceAPI& api = exchange.api;
+        SymbolId btc = api.symbols().intern("BTCUSDT");
+
+        binance::RequestBuilder params;
+        params.add("timeInForce", "GTC").add("price", dec("49000")).add("quantity", dec("0.001"));
+        binance::OrderInfo order = binance::parseOrderInfo(api.createOrder(btc, OrderSide::BUY, OrderType::LIMIT, params));
+        expect(order.symbol == "BTCUSDT" && order.side == OrderSide::BUY && order.type == OrderType::LIMIT,
+               "symbol, side and type sent");
+        expect(order.price == dec("49000") && order.status == binance::OrderStatus::NEW, "order placed");
+
+        params.clear();
+        params.add("orderId", order.orderId);
+        expect(binance::parseOrderInfo(api.queryOrder(btc, params)).orderId == order.orderId, "queried by id");
+        params.clear();
+        params.add("orderId", order.orderId);
+        expect(binance::parseOrderInfo(api.cancelOrder(btc, params)).status == binance::OrderStatus::CANCELED,
+               "canceled by id");
+
+        // A risk engine on the API's registry checks the same id
+        binance::RiskEngine risk(api.symbols());
+        binance::RiskLimits limits;
+        limits.maxOrderQty = dec("0.01");
+        risk.setLimits("BTCUSDT", limits);
+        api.setRiskEngine(&risk);
+        binance::Response response;
+        params.clear();
+        params.add("timeInForce", "GTC").add("price", dec("49000")).add("quantity", dec("1"));
+        expect(!api.tryCreateOrder(btc, OrderSide::BUY, OrderType::LIMIT, params, response) && response.code == -2010,
+               "risk reject");
+        expect(risk.rejects(binance::RiskResult::ORDER_SIZE) == 1, "checked by id");
+        params.clear();
+        params.add("timeInForce", "GTC").add("price", dec("49000")).add("quantity", dec("0.002"));
+        expect(api.tryCreateOrder(btc, OrderSide::BUY, OrderType::LIMIT, params, response), "accepted");
+        expect(risk.exposure(btc).openBuyQty == dec("0.002"), "reserved under the same id");
+        api.setRiskEngine(nullptr);
+
+        bool threw = false;
+        try {
+            params.clear();
+            api.queryOrder(static_cast<SymbolId>(btc + 100), params);
+        } catch (const std::out_of_range&) {
+            threw = true;
+        }
+        expect(threw, "unknown id rejected before sending");
+    });
+
+    if (runBenchmark) {
+        std::cout << "\n=== Benchmark ===" << std::endl;
+        benchmark();
+    }
+
+    std::cout << "\n=======================================" << std::endl;
+    std::cout << (failures == 0 ? "ALL TESTS PASSED" : "SOME TESTS FAILED") << std::endl;
+    std::cout << "=======================================" << std::endl;
+
+    return failures == 0 ? 0 : 1;
+}
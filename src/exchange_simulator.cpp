@@ -0,0 +1,65 @@
+#include "../include/ExchangeSimulator.h"
+#include <iostream>
+#include <string>
+#include <stdexcept>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <csignal>
+
+namespace {
+
+std::atomic<bool> stopRequested(false);
+
+void onSignal(int) {
+    stopRequested = true;
+}
+
+} // namespace
+
+// Serves the Spot REST API on the loopback interface, so the examples and
+// testnet tests can run offline: pass the printed URL as their base_url
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <api_key> <api_secret> [port] [SYMBOL=price ...]" << std::endl;
+        std::cerr << "       e.g. " << argv[0] << " key secret 8090 BTCUSDT=50000 ETHUSDT=2500" << std::endl;
+        return 1;
+    }
+
+    try {
+        binance::SimulatorConfig config;
+        config.apiKey = argv[1];
+        config.apiSecret = argv[2];
+        config.port = static_cast<uint16_t>(argc > 3 ? std::stoi(argv[3]) : 0);
+
+        binance::ExchangeSimulator simulator(config);
+        if (argc <= 4) {
+            simulator.setPrice("BTCUSDT", binance::Decimal::fromInteger(50000));
+        }
+        for (int i = 4; i < argc; ++i) {
+            std::string listing = argv[i];
+            size_t equals = listing.find('=');
+            if (equals == std::string::npos) {
+                throw std::invalid_argument("Expected SYMBOL=price, got " + listing);
+            }
+            simulator.setPrice(listing.substr(0, equals), binance::Decimal::parse(listing.substr(equals + 1)));
+        }
+
+        std::signal(SIGINT, onSignal);
+        std::signal(SIGTERM, onSignal);
+        simulator.start();
+        std::cout << "Exchange simulator listening on " << simulator.baseUrl() << " (Ctrl-C to stop)" << std::endl;
+
+        while (!stopRequested) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        simulator.stop();
+        std::cout << "Served " << simulator.requestCount() << " requests (" << simulator.errorCount()
+                  << " rejected)" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Fatal error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,188 @@
+#include "../include/LatencyHistogram.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <functional>
+#include <stdexcept>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+int failures = 0;
+
+void printTestResult(const std::string& testName, bool success) {
+    std::cout << std::left << std::setw(50) << testName << " : "
+              << (success ? "PASSED" : "FAILED") << std::endl;
+}
+
+void runTest(const std::string& testName, std::function<void()> testFunction) {
+    std::cout << "\n=== Running test: " << testName << " ===" << std::endl;
+    try {
+        testFunction();
+        printTestResult(testName, true);
+    } catch (const std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        printTestResult(testName, false);
+        ++failures;
+    }
+}
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        throw std::runtime_error("check failed: " + what);
+    }
+}
+
+// Percentile of a sorted sample, by the same nearest-rank rule as the histogram
+int64_t exactPercentile(const std::vector<int64_t>& sorted, double percentile) {
+    size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0 * sorted.size()));
+    return sorted[rank == 0 ? 0 : rank - 1];
+}
+
+void benchmark() {
+    binance::LatencyHistogram histogram;
+    const int64_t rounds = 20000000;
+    auto start = std::chrono::steady_clock::now();
+    for (int64_t i = 0; i < rounds; ++i) {
+        histogram.record((i * 7919) & 0xFFFFF);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "record(): " << std::fixed << std::setprecision(2) << seconds * 1e9 / rounds
+              << " ns per value" << std::endl;
+
+    start = std::chrono::steady_clock::now();
+    int64_t sink = 0;
+    for (int i = 0; i < 1000; ++i) {
+        sink += histogram.valueAtPercentile(99.9);
+    }
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "valueAtPercentile(): " << std::fixed << std::setprecision(2) << seconds * 1e6 / 1000
+              << " us (" << sink / 1000 << ")" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool runBenchmark = argc > 1 && std::string(argv[1]) == "--bench";
+
+    std::cout << "\n\n=======================================" << std::endl;
+    std::cout << "LATENCY HISTOGRAM TESTS" << std::endl;
+    std::cout << "=======================================" << std::endl;
+
+    runTest("Bucket boundaries", []() {
+        using binance::LatencyHistogram;
+        for (uint64_t value = 0; value < 128; ++value) {
+            expect(LatencyHistogram::bucketOf(value) == value, "small values are exact");
+        }
+        size_t previous = LatencyHistogram::bucketOf(127);
+        for (uint64_t value = 128; value < (1u << 20); ++value) {
+            size_t bucket = LatencyHistogram::bucketOf(value);
+            expect(bucket == previous || bucket == previous + 1, "buckets are contiguous");
+            expect(LatencyHistogram::highestInBucket(bucket) >= static_cast<int64_t>(value), "value within bucket");
+            if (bucket != previous) {
+                expect(LatencyHistogram::highestInBucket(previous) == static_cast<int64_t>(value) - 1,
+                       "bucket ends where the next begins");
+            }
+            previous = bucket;
+        }
+        expect(LatencyHistogram::bucketOf(LatencyHistogram::HIGHEST_TRACKABLE) ==
+               LatencyHistogram::BUCKET_COUNT - 1, "last bucket");
+        expect(LatencyHistogram::highestInBucket(LatencyHistogram::BUCKET_COUNT - 1) ==
+               LatencyHistogram::HIGHEST_TRACKABLE, "last bucket ends at the trackable limit");
+    });
+
+    runTest("Percentiles against a sorted sample", []() {
+        std::mt19937_64 rng(7);
+        std::lognormal_distribution<double> latency(10.0, 1.0);
+        binance::LatencyHistogram histogram;
+        std::vector<int64_t> values;
+        for (int i = 0; i < 100000; ++i) {
+            values.push_back(static_cast<int64_t>(latency(rng)));
+            histogram.record(values.back());
+        }
+        std::sort(values.begin(), values.end());
+
+        expect(histogram.count() == values.size(), "count");
+        expect(histogram.max() == values.back(), "max is exact");
+        for (double percentile : {0.0, 1.0, 50.0, 90.0, 99.0, 99.9, 99.99, 100.0}) {
+            int64_t exact = exactPercentile(values, percentile);
+            int64_t reported = histogram.valueAtPercentile(percentile);
+            expect(reported >= exact && reported <= exact + exact / 64 + 1,
+                   "p" + std::to_string(percentile) + " within one bucket");
+        }
+        double sum = 0;
+        for (int64_t value : values) {
+            sum += static_cast<double>(value);
+        }
+        expect(std::abs(histogram.mean() - sum / values.size()) < 1e-6 * sum, "mean is exact");
+    });
+
+    runTest("Clamping and empty histograms", []() {
+        binance::LatencyHistogram histogram;
+        expect(histogram.valueAtPercentile(99) == 0 && histogram.max() == 0 && histogram.mean() == 0, "empty");
+        histogram.record(-5);
+        histogram.record(int64_t(1) << 40);
+        expect(histogram.valueAtPercentile(0) == 0, "negative counts as zero");
+        expect(histogram.max() == binance::LatencyHistogram::HIGHEST_TRACKABLE, "large values clamped");
+        histogram.reset();
+        expect(histogram.count() == 0 && histogram.valueAtPercentile(100) == 0, "reset");
+    });
+
+    runTest("Add and drain", []() {
+        binance::LatencyHistogram first;
+        binance::LatencyHistogram second;
+        for (int64_t value = 1; value <= 100; ++value) {
+            first.record(value);
+            second.record(value * 1000);
+        }
+        first.add(second);
+        expect(first.count() == 200 && first.max() == 100000, "added");
+        expect(first.valueAtPercentile(50) == 100, "median of the union");
+
+        binance::LatencyHistogram target;
+        first.drainInto(target);
+        expect(first.count() == 0 && first.valueAtPercentile(100) == 0, "source emptied");
+        expect(target.count() == 200 && target.max() == 100000, "target took everything");
+    });
+
+    runTest("Concurrent recording and draining loses nothing", []() {
+        binance::LatencyHistogram histogram;
+        binance::LatencyHistogram drained;
+        const int threads = 4;
+        const int perThread = 200000;
+        std::vector<std::thread> writers;
+        for (int t = 0; t < threads; ++t) {
+            writers.emplace_back([&histogram, t]() {
+                for (int i = 0; i < perThread; ++i) {
+                    histogram.record(t * 1000 + i % 1000);
+                }
+            });
+        }
+        for (int i = 0; i < 50; ++i) {
+            histogram.drainInto(drained);
+            std::this_thread::yield();
+        }
+        for (auto& writer : writers) {
+            writer.join();
+        }
+        histogram.drainInto(drained);
+        expect(drained.count() == static_cast<uint64_t>(threads) * perThread, "every value drained once");
+        expect(histogram.count() == 0, "source empty");
+    });
+
+    if (runBenchmark) {
+        std::cout << "\n=== Benchmark ===" << std::endl;
+        benchmark();
+    }
+
+    std::cout << "\n=======================================" << std::endl;
+    std::cout << (failures == 0 ? "ALL TESTS PASSED" : "SOME TESTS FAILED") << std::endl;
+    std::cout << "=======================================" << std::endl;
+
+    return failures == 0 ? 0 : 1;
+}
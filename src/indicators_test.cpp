@@ -0,0 +1,339 @@
+#include "../include/Indicators.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <functional>
+#include <stdexcept>
+#include <chrono>
+#include <vector>
+#include <random>
+#include <cmath>
+#include <algorithm>
+
+namespace {
+
+int failures = 0;
+
+void printTestResult(const std::string& testName, bool success) {
+    std::cout << std::left << std::setw(50) << testName << " : "
+              << (success ? "PASSED" : "FAILED") << std::endl;
+}
+
+void runTest(const std::string& testName, std::function<void()> testFunction) {
+    std::cout << "\n=== Running test: " << testName << " ===" << std::endl;
+    try {
+        testFunction();
+        printTestResult(testName, true);
+    } catch (const std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        printTestResult(testName, false);
+        ++failures;
+    }
+}
+
+void expectNear(double actual, double expected, const std::string& what, double tolerance = 1e-9) {
+    double scale = std::max(1.0, std::fabs(expected));
+    if (!(std::fabs(actual - expected) <= tolerance * scale)) {
+        std::ostringstream message;
+        message << std::setprecision(17) << "check failed: " << what << " (got " << actual
+                << ", expected " << expected << ")";
+        throw std::runtime_error(message.str());
+    }
+}
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        throw std::runtime_error("check failed: " + what);
+    }
+}
+
+// A random walk around 30000 with occasional jumps
+std::vector<double> priceSeries(size_t count, uint64_t seed = 42) {
+    std::mt19937_64 rng(seed);
+    std::normal_distribution<double> step(0.0, 5.0);
+    std::vector<double> prices(count);
+    double price = 30000.0;
+    for (size_t i = 0; i < count; ++i) {
+        price += step(rng) + (i % 997 == 0 ? 200.0 : 0.0);
+        prices[i] = price;
+    }
+    return prices;
+}
+
+// Straightforward recomputations over the last period values
+double referenceMean(const std::vector<double>& values, size_t end, size_t period) {
+    size_t begin = end > period ? end - period : 0;
+    double total = 0.0;
+    for (size_t i = begin; i < end; ++i) total += values[i];
+    return total / static_cast<double>(end - begin);
+}
+
+double referenceVariance(const std::vector<double>& values, size_t end, size_t period) {
+    size_t begin = end > period ? end - period : 0;
+    double mean = referenceMean(values, end, period);
+    double total = 0.0;
+    for (size_t i = begin; i < end; ++i) total += (values[i] - mean) * (values[i] - mean);
+    return total / static_cast<double>(end - begin);
+}
+
+// The SMA strategy_example used before: erase the oldest, re-sum on read
+class VectorSMA {
+public:
+    explicit VectorSMA(size_t period) : period(period) {}
+    void addPrice(double price) {
+        prices.push_back(price);
+        if (prices.size() > period) prices.erase(prices.begin());
+    }
+    double getValue() const {
+        double sum = 0;
+        for (double price : prices) sum += price;
+        return sum / prices.size();
+    }
+private:
+    std::vector<double> prices;
+    size_t period;
+};
+
+void benchmark() {
+    const size_t count = 2000000;
+    const size_t period = 200;
+    std::vector<double> prices = priceSeries(count);
+    double sink = 0;
+
+    auto report = [](const char* name, std::chrono::duration<double> elapsed, size_t n) {
+        std::cout << "  " << std::left << std::setw(30) << name << std::fixed << std::setprecision(1)
+                  << (elapsed.count() / n * 1e9) << " ns/update" << std::endl;
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    binance::SMA sma(period);
+    for (double price : prices) { sma.update(price); sink += sma.value(); }
+    report("SMA(200)", std::chrono::steady_clock::now() - start, count);
+
+    start = std::chrono::steady_clock::now();
+    VectorSMA old(period);
+    for (size_t i = 0; i < count / 10; ++i) { old.addPrice(prices[i]); sink += old.getValue(); }
+    report("vector-erase SMA(200)", std::chrono::steady_clock::now() - start, count / 10);
+
+    start = std::chrono::steady_clock::now();
+    binance::EMA ema(period);
+    for (double price : prices) { ema.update(price); sink += ema.value(); }
+    report("EMA(200)", std::chrono::steady_clock::now() - start, count);
+
+    start = std::chrono::steady_clock::now();
+    binance::BollingerBands bands(period);
+    for (double price : prices) { bands.update(price); sink += bands.upper(); }
+    report("Bollinger(200)", std::chrono::steady_clock::now() - start, count);
+
+    start = std::chrono::steady_clock::now();
+    binance::RSI rsi(14);
+    for (double price : prices) { rsi.update(price); sink += rsi.value(); }
+    report("RSI(14)", std::chrono::steady_clock::now() - start, count);
+
+    // Warming up from history: per-value updates against the batch path
+    binance::EMA slow(count);
+    start = std::chrono::steady_clock::now();
+    for (double price : prices) slow.update(price);
+    report("EMA warm-up, update()", std::chrono::steady_clock::now() - start, count);
+    binance::EMA fast(count);
+    start = std::chrono::steady_clock::now();
+    fast.warmUp(prices.data(), prices.size());
+    report("EMA warm-up, warmUp()", std::chrono::steady_clock::now() - start, count);
+
+    binance::RSI slowRsi(100000);
+    start = std::chrono::steady_clock::now();
+    for (double price : prices) slowRsi.update(price);
+    report("RSI warm-up, update()", std::chrono::steady_clock::now() - start, count);
+    binance::RSI fastRsi(100000);
+    start = std::chrono::steady_clock::now();
+    fastRsi.warmUp(prices.data(), prices.size());
+    report("RSI warm-up, warmUp()", std::chrono::steady_clock::now() - start, count);
+
+    std::cout << (sink + slow.value() + fast.value() + slowRsi.value() + fastRsi.value() == 0 ? " " : "");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool runBenchmark = argc > 1 && std::string(argv[1]) == "--bench";
+
+    std::cout << "\n\n=======================================" << std::endl;
+    std::cout << "INDICATOR TESTS" << std::endl;
+    std::cout << "=======================================" << std::endl;
+
+    const std::vector<double> prices = priceSeries(5000);
+
+    runTest("Rolling window", []() {
+        binance::RollingWindow window(3);
+        double evicted = 0;
+        expect(!window.push(1, evicted) && !window.push(2, evicted) && !window.push(3, evicted), "filling");
+        expect(window.push(4, evicted) && evicted == 1, "oldest evicted");
+        expect(window.back() == 4 && window.back(2) == 2, "newest first");
+        const double series[] = {5, 6, 7, 8};
+        window.assign(series, 4);
+        expect(window.full() && window.back() == 8 && window.back(2) == 6, "assigned tail");
+        expect(window.push(9, evicted) && evicted == 6, "evicts after assign");
+    });
+
+    runTest("SMA, variance and Bollinger against recomputation", [&]() {
+        const size_t period = 20;
+        binance::SMA sma(period);
+        binance::RollingVariance variance(period);
+        binance::BollingerBands bands(period, 2.0);
+        for (size_t i = 0; i < prices.size(); ++i) {
+            sma.update(prices[i]);
+            variance.update(prices[i]);
+            bands.update(prices[i]);
+            double mean = referenceMean(prices, i + 1, period);
+            double var = referenceVariance(prices, i + 1, period);
+            expectNear(sma.value(), mean, "SMA");
+            expectNear(variance.mean(), mean, "rolling mean");
+            expectNear(variance.variance(), var, "rolling variance", 1e-6);
+            expectNear(bands.upper(), mean + 2.0 * std::sqrt(var), "upper band", 1e-7);
+        }
+        expect(sma.isReady() && variance.isReady() && bands.isReady(), "ready");
+        expectNear(bands.percentB(bands.upper()), 1.0, "percent B at the upper band");
+    });
+
+    runTest("EMA and VWAP", [&]() {
+        binance::EMA ema(10);
+        for (int i = 0; i < 9; ++i) ema.update(i);
+        expect(!ema.isReady(), "not ready before the period");
+        ema.update(9);
+        expectNear(ema.value(), 4.5, "seeded with the SMA");
+        ema.update(20);
+        expectNear(ema.value(), 4.5 + (2.0 / 11.0) * (20 - 4.5), "smoothing weight");
+
+        binance::VWAP vwap(3);
+        vwap.update(10, 1);
+        vwap.update(20, 3);
+        expectNear(vwap.value(), 17.5, "partial window");
+        vwap.update(30, 1);
+        vwap.update(40, 1);  // Evicts the first trade
+        expectNear(vwap.value(), (60.0 + 30.0 + 40.0) / 5.0, "rolling window");
+        expectNear(vwap.volume(), 5.0, "volume");
+    });
+
+    runTest("RSI", []() {
+        binance::RSI rsi(3);
+        for (double price : {10.0, 11.0, 12.0}) rsi.update(price);
+        expect(!rsi.isReady() && rsi.value() == 50.0, "not ready");
+        rsi.update(11.0);  // Changes +1, +1, -1
+        expectNear(rsi.value(), 100.0 - 100.0 / (1.0 + (2.0 / 3.0) / (1.0 / 3.0)), "seeded");
+        rsi.update(14.0);  // Wilder: (avg * 2 + change) / 3
+        double gain = (2.0 / 3.0 * 2.0 + 3.0) / 3.0;
+        double loss = (1.0 / 3.0 * 2.0) / 3.0;
+        expectNear(rsi.value(), 100.0 - 100.0 / (1.0 + gain / loss), "smoothed");
+
+        binance::RSI rising(2);
+        for (double price : {1.0, 2.0, 3.0, 4.0}) rising.update(price);
+        expect(rising.value() == 100.0, "no losses");
+    });
+
+    runTest("Batch warm-up matches per-value updates", [&]() {
+        for (size_t count : {0ul, 1ul, 7ul, 19ul, 20ul, 21ul, 100ul, 4999ul}) {
+            binance::SMA sma1(20), sma2(20);
+            binance::EMA ema1(20), ema2(20);
+            binance::RollingVariance var1(20), var2(20);
+            binance::RSI rsi1(14), rsi2(14);
+            binance::VWAP vwap1(20), vwap2(20);
+            std::vector<double> quantities(count);
+            for (size_t i = 0; i < count; ++i) quantities[i] = 1.0 + static_cast<double>(i % 7);
+
+            // Some history first, so warm-up continues existing state
+            for (size_t i = 0; i < 5; ++i) {
+                sma1.update(prices[i]); sma2.update(prices[i]);
+                ema1.update(prices[i]); ema2.update(prices[i]);
+                var1.update(prices[i]); var2.update(prices[i]);
+                rsi1.update(prices[i]); rsi2.update(prices[i]);
+            }
+            for (size_t i = 0; i < count; ++i) {
+                sma1.update(prices[i]);
+                ema1.update(prices[i]);
+                var1.update(prices[i]);
+                rsi1.update(prices[i]);
+                vwap1.update(prices[i], quantities[i]);
+            }
+            sma2.warmUp(prices.data(), count);
+            ema2.warmUp(prices.data(), count);
+            var2.warmUp(prices.data(), count);
+            rsi2.warmUp(prices.data(), count);
+            vwap2.warmUp(prices.data(), quantities.data(), count);
+
+            std::string at = " after " + std::to_string(count);
+            expectNear(sma2.value(), sma1.value(), "SMA" + at);
+            expectNear(ema2.value(), ema1.value(), "EMA" + at);
+            expect(ema2.isReady() == ema1.isReady(), "EMA readiness" + at);
+            expectNear(var2.variance(), var1.variance(), "variance" + at, 1e-6);
+            expectNear(rsi2.value(), rsi1.value(), "RSI" + at);
+            expect(rsi2.isReady() == rsi1.isReady(), "RSI readiness" + at);
+            expectNear(vwap2.value(), vwap1.value(), "VWAP" + at);
+
+            // Updates after a warm-up carry on from the same state
+            if (count > 0) {
+                sma1.update(1.0); sma2.update(1.0);
+                rsi1.update(1.0); rsi2.update(1.0);
+                expectNear(sma2.value(), sma1.value(), "SMA update after warm-up" + at);
+                expectNear(rsi2.value(), rsi1.value(), "RSI update after warm-up" + at);
+            }
+        }
+    });
+
+    runTest("Batch kernels", [&]() {
+        for (size_t count : {0ul, 1ul, 3ul, 4ul, 5ul, 8ul, 13ul, 1000ul}) {
+            double sum = 0, squares = 0, products = 0, decayed = 0;
+            double mean = count ? referenceMean(prices, count, count) : 0.0;
+            double weight = 1.0;
+            for (size_t i = count; i-- > 0;) {
+                sum += prices[i];
+                squares += (prices[i] - mean) * (prices[i] - mean);
+                products += prices[i] * prices[i + 1];
+                decayed += weight * prices[i];
+                weight *= 0.9;
+            }
+            std::string at = " over " + std::to_string(count);
+            expectNear(binance::indicators::sum(prices.data(), count), sum, "sum" + at);
+            expectNear(binance::indicators::sumSquaredDeviations(prices.data(), count, mean), squares,
+                       "squared deviations" + at, 1e-6);
+            expectNear(binance::indicators::dot(prices.data(), prices.data() + 1, count), products, "dot" + at);
+            expectNear(binance::indicators::decayedSum(prices.data(), count, 0.9), decayed, "decayed sum" + at);
+
+            // The newest change (between the last two prices) has weight 1
+            double g = 0, l = 0;
+            binance::indicators::decayedGainLoss(prices.data(), count, 0.9, g, l);
+            double expectedGains = 0, expectedLosses = 0;
+            weight = 1.0;
+            for (size_t i = count; i-- > 1;) {
+                double change = prices[i] - prices[i - 1];
+                expectedGains += weight * std::max(change, 0.0);
+                expectedLosses += weight * std::max(-change, 0.0);
+                weight *= 0.9;
+            }
+            expectNear(g, expectedGains, "decayed gains" + at);
+            expectNear(l, expectedLosses, "decayed losses" + at);
+        }
+    });
+
+    bool rejected = false;
+    try {
+        binance::SMA sma(0);
+    } catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    printTestResult("Rejects a zero period", rejected);
+    if (!rejected) {
+        ++failures;
+    }
+
+    if (runBenchmark) {
+        std::cout << "\n=== Benchmark ===" << std::endl;
+        benchmark();
+    }
+
+    std::cout << "\n=======================================" << std::endl;
+    std::cout << (failures == 0 ? "ALL TESTS PASSED" : "SOME TESTS FAILED") << std::endl;
+    std::cout << "=======================================" << std::endl;
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,241 @@
+#include "../include/JsonReader.h"
+#include "../include/BinanceTypes.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <functional>
+#include <stdexcept>
+#include <chrono>
+
+namespace {
+
+int failures = 0;
+
+void printTestResult(const std::string& testName, bool success) {
+    std::cout << std::left << std::setw(50) << testName << " : "
+              << (success ? "PASSED" : "FAILED") << std::endl;
+}
+
+void runTest(const std::string& testName, std::function<void()> testFunction) {
+    std::cout << "\n=== Running test: " << testName << " ===" << std::endl;
+    try {
+        testFunction();
+        printTestResult(testName, true);
+    } catch (const std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        printTestResult(testName, false);
+        ++failures;
+    }
+}
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        throw std::runtime_error("check failed: " + what);
+    }
+}
+
+// Responses as documented for the Binance Spot REST API
+const char* fullOrderResponse = R"({
+  "symbol": "BTCUSDT",
+  "orderId": 28,
+  "orderListId": -1,
+  "clientOrderId": "6gCrw2kRUAF9CvJDGP16IP",
+  "transactTime": 1507725176595,
+  "price": "0.00000000",
+  "origQty": "10.00000000",
+  "executedQty": "10.00000000",
+  "origQuoteOrderQty": "0.000000",
+  "cummulativeQuoteQty": "10.00000000",
+  "status": "FILLED",
+  "timeInForce": "GTC",
+  "type": "MARKET",
+  "side": "SELL",
+  "workingTime": 1507725176595,
+  "selfTradePreventionMode": "NONE",
+  "fills": [
+    {"price": "4000.00000000", "qty": "1.00000000", "commission": "4.00000000",
+     "commissionAsset": "USDT", "tradeId": 56},
+    {"price": "3999.00000000", "qty": "5.00000000", "commission": "19.99500000",
+     "commissionAsset": "USDT", "tradeId": 57}
+  ]
+})";
+
+const char* openOrdersResponse = R"([
+  {"symbol":"LTCBTC","orderId":1,"orderListId":-1,"clientOrderId":"myOrder1","price":"0.1",
+   "origQty":"1.0","executedQty":"0.0","cummulativeQuoteQty":"0.0","status":"NEW",
+   "timeInForce":"GTC","type":"LIMIT","side":"BUY","stopPrice":"0.0","icebergQty":"0.0",
+   "time":1499827319559,"updateTime":1499827319559,"isWorking":true,
+   "workingTime":1499827319559,"origQuoteOrderQty":"0.000000",
+   "selfTradePreventionMode":"NONE","preventedMatchId":null,"unknownField":{"a":[1,"]}"]}},
+  {"symbol":"LTCBTC","orderId":2,"orderListId":-1,"clientOrderId":"quote\"d","price":"0.2",
+   "origQty":"2.0","executedQty":"1.0","cummulativeQuoteQty":"0.2","status":"PARTIALLY_FILLED",
+   "timeInForce":"IOC","type":"LIMIT","side":"SELL","time":1499827319560,
+   "updateTime":1499827319561,"isWorking":true,"workingTime":1499827319560,
+   "selfTradePreventionMode":"EXPIRE_MAKER"}
+])";
+
+const char* orderListResponse = R"({
+  "orderListId": 1,
+  "contingencyType": "OCO",
+  "listStatusType": "EXEC_STARTED",
+  "listOrderStatus": "EXECUTING",
+  "listClientOrderId": "lH1YDkuQKWiXVXHPSKYEIp",
+  "transactionTime": 1710485608839,
+  "symbol": "LTCBTC",
+  "orders": [
+    {"symbol": "LTCBTC", "orderId": 10, "clientOrderId": "44nZvqpemY7sVYgPYbvPih"},
+    {"symbol": "LTCBTC", "orderId": 11, "clientOrderId": "NuMp0nVYnciDiFmVqfpBqK"}
+  ],
+  "orderReports": [
+    {"symbol": "LTCBTC", "orderId": 10, "orderListId": 1, "clientOrderId": "44nZvqpemY7sVYgPYbvPih",
+     "transactTime": 1710485608839, "price": "1.00000000", "origQty": "5.00000000",
+     "executedQty": "0.00000000", "origQuoteOrderQty": "0.00000000", "cummulativeQuoteQty": "0.00000000",
+     "status": "NEW", "timeInForce": "GTC", "type": "STOP_LOSS_LIMIT", "side": "SELL",
+     "stopPrice": "1.00000000", "workingTime": -1, "icebergQty": "1.00000000",
+     "selfTradePreventionMode": "NONE"},
+    {"symbol": "LTCBTC", "orderId": 11, "orderListId": 1, "clientOrderId": "NuMp0nVYnciDiFmVqfpBqK",
+     "transactTime": 1710485608839, "price": "3.00000000", "origQty": "5.00000000",
+     "executedQty": "0.00000000", "origQuoteOrderQty": "0.00000000", "cummulativeQuoteQty": "0.00000000",
+     "status": "NEW", "timeInForce": "GTC", "type": "LIMIT_MAKER", "side": "SELL",
+     "workingTime": 1710485608839, "selfTradePreventionMode": "NONE"}
+  ]
+})";
+
+const char* cancelReplaceFailure = R"({
+  "code": -2021,
+  "msg": "Order cancel-replace partially failed.",
+  "data": {
+    "cancelResult": "SUCCESS",
+    "newOrderResult": "FAILURE",
+    "cancelResponse": {
+      "symbol": "BTCUSDT", "origClientOrderId": "86M8erehfExV8z2RC8Zo8k", "orderId": 3,
+      "orderListId": -1, "clientOrderId": "G1kLo6aDv2KGNTFcjfTSFq", "transactTime": 1684804350068,
+      "price": "0.01000000", "origQty": "0.000100", "executedQty": "0.00000000",
+      "cummulativeQuoteQty": "0.00000000", "status": "CANCELED", "timeInForce": "GTC",
+      "type": "LIMIT_MAKER", "side": "SELL", "selfTradePreventionMode": "NONE"
+    },
+    "newOrderResponse": {
+      "code": -2010,
+      "msg": "Order would immediately match and take."
+    }
+  }
+})";
+
+const char* testOrderResponse = R"({
+  "standardCommissionForOrder": {"maker": "0.00000112", "taker": "0.00000114"},
+  "taxCommissionForOrder": {"maker": "0.00000112", "taker": "0.00000114"},
+  "discount": {"enabledForAccount": true, "enabledForSymbol": true,
+               "discountAsset": "BNB", "discount": "0.25000000"}
+})";
+
+void benchmarkParse() {
+    const size_t iterations = 200000;
+    auto start = std::chrono::steady_clock::now();
+    size_t sink = 0;
+    for (size_t i = 0; i < iterations; ++i) {
+        sink += binance::parseOrderInfo(fullOrderResponse).fills.size();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "  FULL order response: " << std::fixed << std::setprecision(0)
+              << (elapsed.count() / iterations * 1e9) << " ns per parse"
+              << (sink == 0 ? " " : "") << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool runBenchmark = argc > 1 && std::string(argv[1]) == "--bench";
+
+    std::cout << "\n\n=======================================" << std::endl;
+    std::cout << "JSON RESPONSE PARSING TESTS" << std::endl;
+    std::cout << "=======================================" << std::endl;
+
+    runTest("Reader primitives", []() {
+        binance::JsonReader reader(R"( {"a" : [1, -2, "3"], "b":true, "c":null, "d":"x\\\"y"} )");
+        reader.beginObject();
+        std::string_view key;
+        expect(reader.nextKey(key) && key == "a", "first key");
+        reader.beginArray();
+        int64_t sum = 0;
+        while (reader.nextElement()) {
+            sum += reader.readInt();
+        }
+        expect(sum == 2, "array sum");
+        expect(reader.nextKey(key) && key == "b" && reader.readBool(), "bool");
+        expect(reader.nextKey(key) && key == "c" && reader.readNull(), "null");
+        expect(reader.nextKey(key) && reader.readString() == "x\\\\\\\"y", "escaped string kept raw");
+        expect(!reader.nextKey(key), "end of object");
+    });
+
+    runTest("FULL order response", []() {
+        binance::OrderInfo order = binance::parseOrderInfo(fullOrderResponse);
+        expect(order.symbol == "BTCUSDT" && order.orderId == 28 && order.orderListId == -1, "ids");
+        expect(order.transactTime == 1507725176595, "transactTime");
+        expect(order.executedQty == binance::Decimal::fromInteger(10), "executedQty");
+        expect(order.status == binance::OrderStatus::FILLED, "status");
+        expect(order.type == binance::OrderType::MARKET && order.side == binance::OrderSide::SELL, "type/side");
+        expect(!order.stopPrice, "absent optional");
+        expect(order.fills.size() == 2 && order.fills[1].price == binance::Decimal::fromInteger(3999), "fills");
+        expect(order.fills[0].tradeId == "56", "numeric tradeId");
+    });
+
+    runTest("Open orders list", []() {
+        auto orders = binance::parseOrderInfoList(openOrdersResponse);
+        expect(orders.size() == 2, "count");
+        expect(orders[0].isWorking && orders[0].stopPrice && orders[0].stopPrice->isZero(), "first order");
+        expect(!orders[0].preventedMatchId, "null field");
+        expect(orders[1].clientOrderId == "quote\\\"d", "escaped quote");
+        expect(orders[1].status == binance::OrderStatus::PARTIALLY_FILLED, "second status");
+        expect(orders[1].selfTradePreventionMode == binance::SelfTradePreventionMode::EXPIRE_MAKER, "stp");
+    });
+
+    runTest("OCO order list", []() {
+        binance::OrderListInfo list = binance::parseOrderListInfo(orderListResponse);
+        expect(list.orderListId == 1 && list.contingencyType == binance::ContingencyType::OCO, "list");
+        expect(list.listStatusType == binance::ListStatusType::EXEC_STARTED, "listStatusType");
+        expect(list.orders.size() == 2 && list.orders[1].orderId == 11, "orders");
+        expect(list.orderReports.size() == 2, "reports");
+        expect(list.orderReports[0].type == binance::OrderType::STOP_LOSS_LIMIT, "report type");
+        expect(list.orderReports[0].workingTime == -1, "negative number");
+    });
+
+    runTest("Cancel-replace partial failure", []() {
+        binance::CancelReplaceResult result = binance::parseCancelReplaceResult(cancelReplaceFailure);
+        expect(result.cancelResult && !result.newOrderResult, "results");
+        const auto* canceled = std::get_if<binance::OrderInfo>(&result.cancelResponse);
+        expect(canceled && canceled->status == binance::OrderStatus::CANCELED, "cancel response");
+        const auto* error = std::get_if<std::string>(&result.newOrderResponse);
+        expect(error && *error == "Order would immediately match and take.", "new order error");
+    });
+
+    runTest("Test order commission rates", []() {
+        binance::TestOrderResult result = binance::parseTestOrderResult(testOrderResponse);
+        expect(result.standardCommissionForOrder && result.standardCommissionForOrder->taker.units() == 114,
+               "standard commission");
+        expect(result.discount && result.discount->enabledForAccount && result.discount->discount == binance::Decimal::parse("0.25"),
+               "discount");
+        expect(!binance::parseTestOrderResult("{}").discount, "empty response");
+    });
+
+    runTest("Malformed input throws", []() {
+        for (const char* json : {"", "{\"symbol\":\"BTC", "{\"orderId\":\"abc\"}", "[1,2", "{\"a\" 1}"}) {
+            bool threw = false;
+            try {
+                binance::parseOrderInfo(json);
+            } catch (const std::runtime_error&) {
+                threw = true;
+            }
+            expect(threw, std::string("rejects ") + json);
+        }
+    });
+
+    if (runBenchmark) {
+        benchmarkParse();
+    }
+
+    std::cout << "\n=======================================" << std::endl;
+    std::cout << (failures == 0 ? "ALL TESTS PASSED" : "SOME TESTS FAILED") << std::endl;
+    std::cout << "=======================================" << std::endl;
+
+    return failures == 0 ? 0 : 1;
+}
@@ -40,16 +40,18 @@ void prettyPrintJSON(const std::string& json) {
 int main(int argc, char** argv) {
     // Check for API key and secret as command-line arguments
     if (argc < 3) {
-        std::cerr << "Usage: " << argv[0] << " <api_key> <api_secret>" << std::endl;
+        std::cerr << "Usage: " << argv[0] << " <api_key> <api_secret> [base_url]" << std::endl;
         return 1;
     }
     
     std::string api_key = argv[1];
     std::string api_secret = argv[2];
+    // Testnet unless another host, such as a local exchange_simulator, is given
+    std::string base_url = argc > 3 ? argv[3] : "https://testnet.binance.vision";
     
     try {
         // Initialize the Binance API client with testnet URL
-        binance::BinanceAPI api(api_key, api_secret, "https://testnet.binance.vision");
+        binance::BinanceAPI api(api_key, api_secret, base_url);
         
         std::cout << "Binance Trading API Testnet Example" << std::endl;
         std::cout << "=================================" << std::endl << std::endl;
@@ -0,0 +1,412 @@
+#include "../include/MarketDataStream.h"
+#include "../include/WebSocketClient.h"
+#include "../include/RingBuffer.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <cstring>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+namespace {
+
+int failures = 0;
+
+void printTestResult(const std::string& testName, bool success) {
+    std::cout << std::left << std::setw(50) << testName << " : "
+              << (success ? "PASSED" : "FAILED") << std::endl;
+}
+
+void runTest(const std::string& testName, std::function<void()> testFunction) {
+    std::cout << "\n=== Running test: " << testName << " ===" << std::endl;
+    try {
+        testFunction();
+        printTestResult(testName, true);
+    } catch (const std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        printTestResult(testName, false);
+        ++failures;
+    }
+}
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        throw std::runtime_error("check failed: " + what);
+    }
+}
+
+using binance::Decimal;
+using binance::MarketEvent;
+
+// Payloads as documented for the Binance WebSocket market streams
+const char* tradeMessage = R"({"stream":"btcusdt@trade","data":{"e":"trade","E":1672515782136,"s":"BTCUSDT",)"
+                           R"("t":12345,"p":"16500.01000000","q":"0.00100000","T":1672515782136,"m":true,"M":true}})";
+
+const char* bookTickerMessage = R"({"stream":"bnbusdt@bookTicker","data":{"u":400900217,"s":"BNBUSDT",)"
+                                R"("b":"25.35190000","B":"31.21000000","a":"25.36520000","A":"40.66000000"}})";
+
+const char* partialDepthMessage = R"({"stream":"ethusdt@depth5@100ms","data":{"lastUpdateId":160,)"
+                                  R"("bids":[["0.0024","10"],["0.0023","5"]],"asks":[["0.0026","100"]]}})";
+
+const char* klineMessage = R"({"stream":"btcusdt@kline_1m","data":{"e":"kline","E":1672515782136,"s":"BTCUSDT",)"
+                           R"("k":{"t":1672515780000,"T":1672515839999,"s":"BTCUSDT","i":"1m","f":100,"L":200,)"
+                           R"("o":"0.0010","c":"0.0020","h":"0.0025","l":"0.0015","v":"1000","n":100,"x":false,)"
+                           R"("q":"1.0000","V":"500","Q":"0.500","B":"123456"}}})";
+
+// A diff-depth update with the given number of bid levels and one ask
+std::string diffDepthMessage(int bids) {
+    std::string message = R"({"stream":"btcusdt@depth@100ms","data":{"e":"depthUpdate","E":1672515782136,)"
+                          R"("s":"BTCUSDT","U":157,"u":160,"b":[)";
+    for (int i = 0; i < bids; ++i) {
+        message += (i ? "," : "");
+        message += "[\"" + std::to_string(1000 - i) + ".5\",\"1\"]";
+    }
+    message += R"(],"a":[["2000","0"]]}})";
+    return message;
+}
+
+std::vector<MarketEvent> parseAll(const std::string& message) {
+    std::vector<MarketEvent> events;
+    binance::parseStreamMessage(message, [&](const MarketEvent& event) { events.push_back(event); });
+    return events;
+}
+
+// Minimal WebSocket server standing in for the exchange on a loopback port
+class StandInServer {
+public:
+    StandInServer() {
+        listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+        int reuse = 1;
+        setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (::bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+            ::listen(listenFd, 1) != 0) {
+            throw std::runtime_error("stand-in server: cannot listen");
+        }
+        socklen_t length = sizeof(address);
+        getsockname(listenFd, reinterpret_cast<sockaddr*>(&address), &length);
+        port = ntohs(address.sin_port);
+    }
+
+    ~StandInServer() {
+        if (clientFd >= 0) ::close(clientFd);
+        for (int fd : earlierFds) ::close(fd);
+        ::close(listenFd);
+    }
+
+    std::string url() const { return "ws://127.0.0.1:" + std::to_string(port); }
+
+    // Accept one client and answer its opening handshake; returns the request target
+    std::string accept() {
+        if (clientFd >= 0) earlierFds.push_back(clientFd);  // Left open, so the client sees no close
+        clientFd = ::accept(listenFd, nullptr, nullptr);
+        std::string request;
+        char buffer[4096];
+        while (request.find("\r\n\r\n") == std::string::npos) {
+            ssize_t n = ::recv(clientFd, buffer, sizeof(buffer), 0);
+            if (n <= 0) throw std::runtime_error("stand-in server: handshake read failed");
+            request.append(buffer, static_cast<size_t>(n));
+        }
+        size_t keyStart = request.find("Sec-WebSocket-Key: ") + 19;
+        std::string key = request.substr(keyStart, request.find("\r\n", keyStart) - keyStart);
+        std::string response = "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\n"
+                               "Connection: Upgrade\r\nSec-WebSocket-Accept: " +
+                               binance::WebSocketClient::acceptKey(key) + "\r\n\r\n";
+        sendRaw(response);
+        return request.substr(4, request.find(' ', 4) - 4);
+    }
+
+    // Send one unmasked server frame
+    void sendFrame(uint8_t opcode, const std::string& payload, bool fin = true) {
+        std::string frame(1, static_cast<char>((fin ? 0x80 : 0) | opcode));
+        if (payload.size() < 126) {
+            frame += static_cast<char>(payload.size());
+        } else if (payload.size() <= 0xFFFF) {
+            frame += static_cast<char>(126);
+            frame += static_cast<char>(payload.size() >> 8);
+            frame += static_cast<char>(payload.size() & 0xFF);
+        } else {
+            frame += static_cast<char>(127);
+            for (int shift = 56; shift >= 0; shift -= 8) {
+                frame += static_cast<char>((static_cast<uint64_t>(payload.size()) >> shift) & 0xFF);
+            }
+        }
+        sendRaw(frame + payload);
+    }
+
+    // Read one masked client frame and return its payload
+    std::string readFrame(uint8_t& opcode) {
+        uint8_t header[2];
+        readExact(header, 2);
+        opcode = header[0] & 0x0F;
+        if (!(header[1] & 0x80)) throw std::runtime_error("client frame not masked");
+        uint64_t length = header[1] & 0x7F;
+        if (length == 126) {
+            uint8_t extended[2];
+            readExact(extended, 2);
+            length = (extended[0] << 8) | extended[1];
+        } else if (length == 127) {
+            throw std::runtime_error("unexpected large client frame");
+        }
+        uint8_t mask[4];
+        readExact(mask, 4);
+        std::string payload(length, '\0');
+        readExact(&payload[0], length);
+        for (size_t i = 0; i < length; ++i) payload[i] = static_cast<char>(payload[i] ^ mask[i & 3]);
+        return payload;
+    }
+
+private:
+    int listenFd = -1;
+    int clientFd = -1;
+    std::vector<int> earlierFds;
+    uint16_t port = 0;
+
+    void sendRaw(const std::string& data) {
+        size_t sent = 0;
+        while (sent < data.size()) {
+            ssize_t n = ::send(clientFd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0) throw std::runtime_error("stand-in server: write failed");
+            sent += static_cast<size_t>(n);
+        }
+    }
+
+    void readExact(void* out, size_t size) {
+        auto* p = static_cast<char*>(out);
+        while (size > 0) {
+            ssize_t n = ::recv(clientFd, p, size, 0);
+            if (n <= 0) throw std::runtime_error("stand-in server: read failed");
+            p += n;
+            size -= static_cast<size_t>(n);
+        }
+    }
+};
+
+// Pop from a queue until count events arrived or a second passed
+std::vector<MarketEvent> drain(binance::MarketEventQueue& queue, size_t count) {
+    std::vector<MarketEvent> events;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    MarketEvent event;
+    while (events.size() < count && std::chrono::steady_clock::now() < deadline) {
+        if (queue.tryPop(event)) {
+            events.push_back(event);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    return events;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "\n\n=======================================" << std::endl;
+    std::cout << "MARKET DATA STREAM TESTS" << std::endl;
+    std::cout << "=======================================" << std::endl;
+
+    runTest("SPSC ring buffer", []() {
+        binance::SpscRingBuffer<int> ring(3);
+        expect(ring.capacity() == 4, "capacity rounded up");
+        for (int i = 0; i < 4; ++i) expect(ring.tryPush(i), "push");
+        expect(!ring.tryPush(4), "full");
+        int value = -1;
+        expect(ring.tryPop(value) && value == 0, "FIFO order");
+
+        binance::SpscRingBuffer<uint64_t> threaded(1024);
+        const uint64_t count = 200000;
+        std::thread producer([&]() {
+            for (uint64_t i = 1; i <= count; ++i) {
+                while (!threaded.tryPush(i)) std::this_thread::yield();
+            }
+        });
+        uint64_t expected = 1, item;
+        bool ordered = true;
+        while (expected <= count) {
+            if (threaded.tryPop(item)) {
+                ordered &= item == expected;
+                ++expected;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        producer.join();
+        expect(ordered, "ordered across threads");
+    });
+
+    runTest("MPSC ring buffer", []() {
+        binance::MpscRingBuffer<uint64_t> ring(256);
+        const int producers = 4;
+        const uint64_t perProducer = 50000;
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; ++p) {
+            threads.emplace_back([&ring, p, perProducer]() {
+                for (uint64_t i = 0; i < perProducer; ++i) {
+                    uint64_t value = (static_cast<uint64_t>(p) << 32) | i;
+                    while (!ring.tryPush(value)) std::this_thread::yield();
+                }
+            });
+        }
+        uint64_t next[producers] = {};
+        uint64_t received = 0, value;
+        bool ordered = true;
+        while (received < producers * perProducer) {
+            if (ring.tryPop(value)) {
+                uint64_t p = value >> 32;
+                ordered &= (value & 0xFFFFFFFF) == next[p];
+                ++next[p];
+                ++received;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        for (auto& thread : threads) thread.join();
+        expect(ordered, "per-producer order");
+    });
+
+    runTest("Decode stream payloads", []() {
+        auto events = parseAll(tradeMessage);
+        const auto* trade = std::get_if<binance::TradeEvent>(&events.at(0));
+        expect(events.size() == 1 && trade, "trade event");
+        expect(trade->symbol == "BTCUSDT" && trade->tradeId == 12345, "trade ids");
+        expect(trade->price == Decimal::parse("16500.01") && trade->quantity == Decimal::parse("0.001"), "trade price");
+        expect(trade->isBuyerMaker && trade->tradeTime == 1672515782136, "trade flags");
+
+        events = parseAll(bookTickerMessage);
+        const auto* ticker = std::get_if<binance::BookTickerEvent>(&events.at(0));
+        expect(ticker && ticker->updateId == 400900217 && ticker->symbol == "BNBUSDT", "book ticker");
+        expect(ticker->bidPrice < ticker->askPrice && ticker->askQty == Decimal::parse("40.66"), "book ticker prices");
+
+        events = parseAll(partialDepthMessage);
+        const auto* book = std::get_if<binance::DepthUpdateEvent>(&events.at(0));
+        expect(book && book->snapshot && book->last && book->symbol == "ETHUSDT", "partial depth");
+        expect(book->finalUpdateId == 160 && book->bidCount == 2 && book->askCount == 1, "partial depth levels");
+
+        events = parseAll(klineMessage);
+        const auto* kline = std::get_if<binance::KlineEvent>(&events.at(0));
+        expect(kline && std::string(kline->interval) == "1m" && !kline->closed, "kline");
+        expect(kline->high == Decimal::parse("0.0025") && kline->tradeCount == 100, "kline values");
+
+        expect(parseAll(R"({"result":null,"id":1})").empty(), "subscription reply ignored");
+        expect(parseAll(R"({"stream":"btcusdt@aggTrade","data":{"e":"aggTrade"}})").empty(), "unsupported stream");
+    });
+
+    runTest("Large depth updates are chunked", []() {
+        auto events = parseAll(diffDepthMessage(45));
+        expect(events.size() == 3, "three chunks");
+        size_t bids = 0, asks = 0;
+        for (size_t i = 0; i < events.size(); ++i) {
+            const auto& depth = std::get<binance::DepthUpdateEvent>(events[i]);
+            expect(depth.firstUpdateId == 157 && depth.finalUpdateId == 160 && !depth.snapshot, "shared ids");
+            expect(depth.last == (i + 1 == events.size()), "last flag");
+            bids += depth.bidCount;
+            asks += depth.askCount;
+        }
+        const auto& first = std::get<binance::DepthUpdateEvent>(events[0]);
+        expect(bids == 45 && asks == 1, "all levels delivered");
+        expect(first.bids[0].price == Decimal::parse("1000.5"), "first level");
+        expect(std::get<binance::DepthUpdateEvent>(events[2]).asks[0].quantity.isZero(), "removed level");
+    });
+
+    runTest("Stream against local WebSocket server", []() {
+        StandInServer server;
+        binance::MarketDataStream stream(server.url());
+        stream.subscribe({binance::MarketDataStream::tradeStream("BTCUSDT"),
+                          binance::MarketDataStream::bookTickerStream("BNBUSDT")});
+        auto strategyA = stream.addConsumer(64);
+        auto strategyB = stream.addConsumer(64);
+
+        std::string target;
+        std::string pong;
+        std::string serverError;
+        std::thread serverThread([&]() {
+            try {
+                target = server.accept();
+                // Fragmented trade message
+                std::string trade = tradeMessage;
+                server.sendFrame(0x1, trade.substr(0, 40), false);
+                server.sendFrame(0x0, trade.substr(40));
+                // The client must answer pings with the same payload
+                server.sendFrame(0x9, "keepalive");
+                uint8_t opcode = 0;
+                pong = server.readFrame(opcode);
+                if (opcode != 0xA) pong.clear();
+                // 16-bit and 64-bit length frames
+                server.sendFrame(0x1, std::string(bookTickerMessage) + std::string(200, ' '));
+                server.sendFrame(0x1, diffDepthMessage(4000));
+                server.sendFrame(0x8, std::string("\x03\xE8", 2));
+                server.readFrame(opcode);
+            } catch (const std::exception& e) {
+                serverError = e.what();
+            }
+        });
+
+        stream.start();
+        auto eventsA = drain(*strategyA, 2);
+        serverThread.join();
+        expect(serverError.empty(), "server: " + serverError);
+        expect(target == "/stream?streams=btcusdt@trade/bnbusdt@bookTicker", "combined stream URL: " + target);
+        expect(pong == "keepalive", "pong echoes the ping payload");
+
+        expect(eventsA.size() == 2, "consumer A received trade and ticker");
+        expect(std::holds_alternative<binance::TradeEvent>(eventsA[0]), "trade first");
+        expect(std::get<binance::BookTickerEvent>(eventsA[1]).symbol == "BNBUSDT", "ticker second");
+
+        // 4000 levels become 200 chunks, more than the 64-slot queues hold
+        auto eventsB = drain(*strategyB, 64);
+        MarketEvent extra;
+        expect(eventsB.size() == 64 && !strategyB->tryPop(extra), "consumer B's queue filled independently");
+        expect(stream.eventsDropped() > 0, "overflow counted as drops");
+        expect(stream.messagesReceived() == 3 && stream.decodeErrors() == 0, "message counters");
+        expect(stream.connectionErrors() == 0 && stream.lastError().empty(), "closed without an error");
+
+        stream.stop();
+        expect(!stream.isConnected(), "stopped");
+    });
+
+    runTest("Silent connection is reconnected", []() {
+        StandInServer server;
+        binance::MarketDataStream stream(server.url());
+        stream.subscribe({binance::MarketDataStream::tradeStream("BTCUSDT")});
+        stream.setReadTimeout(std::chrono::milliseconds(200));
+        auto consumer = stream.addConsumer(64);
+
+        std::string serverError;
+        std::thread serverThread([&]() {
+            try {
+                // Accept and then say nothing, like a connection a NAT dropped
+                server.accept();
+                server.accept();
+                server.sendFrame(0x1, tradeMessage);
+            } catch (const std::exception& e) {
+                serverError = e.what();
+            }
+        });
+
+        auto start = std::chrono::steady_clock::now();
+        stream.start();
+        serverThread.join();
+        expect(serverError.empty(), "server: " + serverError);
+        expect(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(200), "waited for the timeout");
+        expect(drain(*consumer, 1).size() == 1, "data after reconnecting");
+        expect(stream.reconnects() == 1, "reconnected once");
+        expect(stream.connectionErrors() == 1 && stream.lastError().find("timed out") != std::string::npos,
+               "timeout kept as the last error");
+        stream.stop();
+    });
+
+    std::cout << "\n=======================================" << std::endl;
+    std::cout << (failures == 0 ? "ALL TESTS PASSED" : "SOME TESTS FAILED") << std::endl;
+    std::cout << "=======================================" << std::endl;
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,366 @@
+#include "../include/OrderBook.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <functional>
+#include <stdexcept>
+#include <chrono>
+#include <vector>
+#include <map>
+#include <random>
+
+namespace {
+
+int failures = 0;
+
+void printTestResult(const std::string& testName, bool success) {
+    std::cout << std::left << std::setw(50) << testName << " : "
+              << (success ? "PASSED" : "FAILED") << std::endl;
+}
+
+void runTest(const std::string& testName, std::function<void()> testFunction) {
+    std::cout << "\n=== Running test: " << testName << " ===" << std::endl;
+    try {
+        testFunction();
+        printTestResult(testName, true);
+    } catch (const std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        printTestResult(testName, false);
+        ++failures;
+    }
+}
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        throw std::runtime_error("check failed: " + what);
+    }
+}
+
+using binance::Decimal;
+using binance::DepthApplyResult;
+using binance::DepthSnapshot;
+using binance::DepthUpdateEvent;
+using binance::OrderBook;
+using binance::PriceLevel;
+
+Decimal d(const char* text) {
+    return Decimal::parse(text);
+}
+
+DepthUpdateEvent update(int64_t first, int64_t last, std::vector<PriceLevel> bids, std::vector<PriceLevel> asks) {
+    DepthUpdateEvent event;
+    event.symbol.assign("BTCUSDT");
+    event.firstUpdateId = first;
+    event.finalUpdateId = last;
+    for (const PriceLevel& level : bids) event.bids[event.bidCount++] = level;
+    for (const PriceLevel& level : asks) event.asks[event.askCount++] = level;
+    return event;
+}
+
+DepthSnapshot snapshot(int64_t lastUpdateId) {
+    DepthSnapshot snap;
+    snap.lastUpdateId = lastUpdateId;
+    snap.bids = {{d("100.00"), d("1")}, {d("99.99"), d("2")}, {d("99.50"), d("3")}};
+    snap.asks = {{d("100.01"), d("4")}, {d("100.05"), d("5")}};
+    return snap;
+}
+
+// Combined-stream diff-depth messages for a random walk around 30000.00
+std::vector<std::string> synthesizeRecording(size_t messages) {
+    std::mt19937_64 rng(12345);
+    std::vector<std::string> lines;
+    lines.reserve(messages);
+    int64_t mid = 3000000;  // In 0.01 ticks
+    int64_t updateId = 1000;
+    for (size_t m = 0; m < messages; ++m) {
+        mid += static_cast<int64_t>(rng() % 5) - 2;
+        std::string line = R"({"stream":"btcusdt@depth@100ms","data":{"e":"depthUpdate","E":1672515782136,)"
+                           R"("s":"BTCUSDT","U":)" + std::to_string(updateId + 1) +
+                           R"(,"u":)" + std::to_string(updateId + 10) + R"(,"b":[)";
+        updateId += 10;
+        for (int side = 0; side < 2; ++side) {
+            if (side == 1) line += R"(],"a":[)";
+            for (int i = 0; i < 10; ++i) {
+                int64_t offset = static_cast<int64_t>(rng() % 200) + 1;
+                int64_t tick = side == 0 ? mid - offset : mid + offset;
+                bool remove = rng() % 4 == 0;
+                line += (i ? "," : "");
+                line += "[\"" + std::to_string(tick / 100) + "." + std::to_string(100 + tick % 100).substr(1) +
+                        "\",\"" + (remove ? "0.00000000" : std::to_string(rng() % 1000) + ".125") + "\"]";
+            }
+        }
+        line += "]}}";
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+void benchmark(const char* path) {
+    std::vector<std::string> lines;
+    if (path != nullptr) {
+        std::ifstream in(path);
+        if (!in) {
+            throw std::runtime_error(std::string("cannot open ") + path);
+        }
+        for (std::string line; std::getline(in, line);) {
+            lines.push_back(line);
+        }
+    } else {
+        lines = synthesizeRecording(200000);
+    }
+
+    std::vector<DepthUpdateEvent> events;
+    for (const std::string& line : lines) {
+        binance::parseStreamMessage(line, [&](const binance::MarketEvent& event) {
+            if (const auto* depth = std::get_if<DepthUpdateEvent>(&event)) {
+                events.push_back(*depth);
+            }
+        });
+    }
+    size_t levels = 0;
+    for (const DepthUpdateEvent& event : events) {
+        levels += event.bidCount + event.askCount;
+    }
+    std::cout << "  " << events.size() << " depth events, " << levels << " level updates"
+              << (path != nullptr ? "" : " (synthetic)") << std::endl;
+    if (levels == 0) {
+        return;
+    }
+
+    // Start from an empty book at the first update, as if the snapshot had been empty
+    OrderBook book("BTCUSDT", d("0.01"));
+    DepthSnapshot empty;
+    empty.lastUpdateId = events.front().firstUpdateId - 1;
+    book.applySnapshot(empty);
+    auto start = std::chrono::steady_clock::now();
+    for (const DepthUpdateEvent& event : events) {
+        book.apply(event);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "  OrderBook:                 " << std::fixed << std::setprecision(1)
+              << (levels / elapsed.count() / 1e6) << " M updates/s"
+              << (book.isSynced() ? "" : " (lost sync)") << std::endl;
+
+    std::map<double, double, std::greater<double>> bids;
+    std::map<double, double> asks;
+    double sink = 0;
+    start = std::chrono::steady_clock::now();
+    for (const DepthUpdateEvent& event : events) {
+        for (uint16_t i = 0; i < event.bidCount; ++i) {
+            if (event.bids[i].quantity.isZero()) bids.erase(event.bids[i].price.toDouble());
+            else bids[event.bids[i].price.toDouble()] = event.bids[i].quantity.toDouble();
+        }
+        for (uint16_t i = 0; i < event.askCount; ++i) {
+            if (event.asks[i].quantity.isZero()) asks.erase(event.asks[i].price.toDouble());
+            else asks[event.asks[i].price.toDouble()] = event.asks[i].quantity.toDouble();
+        }
+        if (!bids.empty()) sink += bids.begin()->first;
+    }
+    elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "  std::map<double, double>:  " << std::fixed << std::setprecision(1)
+              << (levels / elapsed.count() / 1e6) << " M updates/s" << (sink == 0 ? " " : "") << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool runBenchmark = argc > 1 && std::string(argv[1]) == "--bench";
+
+    std::cout << "\n\n=======================================" << std::endl;
+    std::cout << "ORDER BOOK TESTS" << std::endl;
+    std::cout << "=======================================" << std::endl;
+
+    runTest("Best levels and top of book", []() {
+        OrderBook book("BTCUSDT", d("0.01"));
+        expect(!book.hasBid() && !book.hasAsk(), "starts empty");
+        expect(book.bestBid().quantity.isZero(), "empty best bid");
+        book.setLevel(true, d("100.00"), d("1"));
+        book.setLevel(true, d("99.98"), d("2"));
+        book.setLevel(true, d("100.02"), d("3"));
+        book.setLevel(false, d("100.05"), d("4"));
+        book.setLevel(false, d("100.03"), d("5"));
+        expect(book.bestBid().price == d("100.02") && book.bestBid().quantity == d("3"), "best bid");
+        expect(book.bestAsk().price == d("100.03") && book.bestAsk().quantity == d("5"), "best ask");
+        expect(book.midPrice() == d("100.025"), "mid price");
+
+        PriceLevel top[5];
+        expect(book.topBids(top, 5) == 3, "three bids");
+        expect(top[0].price == d("100.02") && top[1].price == d("100.00") && top[2].price == d("99.98"),
+               "bids best first");
+        expect(book.topAsks(top, 1) == 1 && top[0].price == d("100.03"), "top ask only");
+
+        book.setLevel(true, d("100.02"), d("0"));
+        expect(book.bestBid().price == d("100.00"), "next bid after removing the best");
+        book.setLevel(true, d("100.00"), d("7"));
+        expect(book.bestBid().quantity == d("7"), "quantity replaced");
+        expect(book.levelCount(true) == 2, "bid count");
+        book.setLevel(true, d("99.00"), d("0"));
+        expect(book.levelCount(true) == 2, "removing an absent level");
+    });
+
+    runTest("Levels outside the window", []() {
+        OrderBook book("BTCUSDT", d("0.01"), 128);
+        book.setLevel(true, d("100.00"), d("1"));
+        book.setLevel(true, d("50.00"), d("2"));   // Far below the window
+        book.setLevel(true, d("100.50"), d("3"));  // Past the top edge; re-centers
+        book.setLevel(false, d("100.51"), d("1"));
+        book.setLevel(false, d("200.00"), d("1"));
+        PriceLevel top[4];
+        expect(book.topBids(top, 4) == 3, "all bids found");
+        expect(top[0].price == d("100.50") && top[1].price == d("100.00") && top[2].price == d("50.00"),
+               "bid order across window and overflow");
+        book.setLevel(true, d("100.50"), d("0"));
+        book.setLevel(true, d("100.00"), d("0"));
+        expect(book.bestBid().price == d("50.00") && book.bestBid().quantity == d("2"), "best from overflow");
+        book.setLevel(false, d("100.51"), d("0"));
+        expect(book.bestAsk().price == d("200.00"), "ask from overflow");
+    });
+
+    runTest("Matches a reference map under random updates", []() {
+        std::mt19937_64 rng(7);
+        OrderBook book("BTCUSDT", d("0.01"), 256);
+        std::map<int64_t, int64_t, std::greater<int64_t>> bids;
+        std::map<int64_t, int64_t> asks;
+        int64_t mid = 1000000;
+        for (int i = 0; i < 50000; ++i) {
+            if (i % 1000 == 0) {
+                mid += static_cast<int64_t>(rng() % 2001) - 1000;  // Jumps force re-centering
+            }
+            bool isBid = rng() & 1;
+            int64_t offset = static_cast<int64_t>(rng() % 400) + 1;
+            int64_t tick = isBid ? mid - offset : mid + offset;
+            int64_t quantity = rng() % 3 == 0 ? 0 : static_cast<int64_t>(rng() % 1000 + 1);
+            book.setLevel(isBid, Decimal::fromUnits(tick * 1000000), Decimal::fromUnits(quantity));
+            if (isBid) {
+                if (quantity == 0) bids.erase(tick); else bids[tick] = quantity;
+            } else {
+                if (quantity == 0) asks.erase(tick); else asks[tick] = quantity;
+            }
+        }
+        expect(book.levelCount(true) == bids.size() && book.levelCount(false) == asks.size(), "level counts");
+        std::vector<PriceLevel> top(bids.size() + asks.size());
+        size_t n = book.topBids(top.data(), top.size());
+        expect(n == bids.size(), "all bids listed");
+        size_t i = 0;
+        for (const auto& [tick, quantity] : bids) {
+            expect(top[i].price.units() == tick * 1000000 && top[i].quantity.units() == quantity, "bid level");
+            ++i;
+        }
+        n = book.topAsks(top.data(), top.size());
+        expect(n == asks.size(), "all asks listed");
+        i = 0;
+        for (const auto& [tick, quantity] : asks) {
+            expect(top[i].price.units() == tick * 1000000 && top[i].quantity.units() == quantity, "ask level");
+            ++i;
+        }
+    });
+
+    runTest("Snapshot with buffered updates", []() {
+        OrderBook book("BTCUSDT", d("0.01"));
+        expect(book.apply(update(95, 100, {{d("100.00"), d("9")}}, {})) == DepthApplyResult::BUFFERED,
+               "buffered before snapshot");
+        expect(book.apply(update(101, 104, {{d("99.99"), d("0")}}, {{d("100.02"), d("1")}})) ==
+               DepthApplyResult::BUFFERED, "second buffered");
+        expect(!book.isSynced(), "not synced yet");
+
+        expect(book.applySnapshot(snapshot(102)), "synced after snapshot");
+        expect(book.lastUpdateId() == 104, "buffered update replayed");
+        expect(book.bestBid().quantity == d("1"), "update older than the snapshot ignored");
+        expect(book.levelCount(true) == 2, "level removed by replayed update");
+        expect(book.levelCount(false) == 3, "level added by replayed update");
+
+        expect(book.apply(update(100, 104, {{d("100.00"), d("8")}}, {})) == DepthApplyResult::IGNORED,
+               "stale update ignored");
+        expect(book.apply(update(105, 106, {{d("100.00"), d("8")}}, {})) == DepthApplyResult::APPLIED,
+               "next update applied");
+        expect(book.bestBid().quantity == d("8"), "quantity updated");
+    });
+
+    runTest("Gap detection and resync", []() {
+        OrderBook book("BTCUSDT", d("0.01"));
+        int fetches = 0;
+        book.setSnapshotSource([&]() {
+            ++fetches;
+            return snapshot(fetches == 1 ? 100 : 120);
+        });
+        expect(book.apply(update(98, 101, {}, {})) == DepthApplyResult::APPLIED, "fetched and replayed");
+        expect(fetches == 1 && book.isSynced() && book.lastUpdateId() == 101, "synced from source");
+
+        expect(book.apply(update(110, 121, {{d("100.00"), d("5")}}, {})) == DepthApplyResult::GAP, "gap");
+        expect(fetches == 2 && book.isSynced(), "resynced after the gap");
+        expect(book.lastUpdateId() == 121 && book.bestBid().quantity == d("5"), "gap update replayed");
+
+        book.setSnapshotSource(nullptr);
+        expect(book.apply(update(130, 131, {}, {})) == DepthApplyResult::GAP, "second gap");
+        expect(!book.isSynced(), "out of sync without a source");
+        expect(book.apply(update(132, 133, {}, {})) == DepthApplyResult::BUFFERED, "buffering");
+        expect(!book.applySnapshot(snapshot(120)), "snapshot older than the buffer leaves a gap");
+        expect(book.applySnapshot(snapshot(131)) && book.lastUpdateId() == 133, "fresh snapshot syncs");
+    });
+
+    runTest("Chunked updates and partial depth", []() {
+        OrderBook book("BTCUSDT", d("0.01"));
+        book.applySnapshot(snapshot(100));
+
+        DepthUpdateEvent first = update(101, 102, {{d("98.00"), d("1")}}, {});
+        first.last = false;
+        DepthUpdateEvent second = update(101, 102, {{d("97.00"), d("1")}}, {});
+        expect(book.apply(first) == DepthApplyResult::APPLIED, "first chunk");
+        expect(book.apply(second) == DepthApplyResult::APPLIED, "continuation chunk");
+        expect(book.levelCount(true) == 5, "both chunks applied");
+
+        DepthUpdateEvent staleFirst = update(90, 102, {{d("96.00"), d("1")}}, {});
+        staleFirst.last = false;
+        DepthUpdateEvent staleSecond = update(90, 102, {{d("95.00"), d("1")}}, {});
+        expect(book.apply(staleFirst) == DepthApplyResult::IGNORED, "stale first chunk");
+        expect(book.apply(staleSecond) == DepthApplyResult::IGNORED, "stale continuation");
+        expect(book.levelCount(true) == 5, "stale chunks not applied");
+
+        DepthUpdateEvent partial = update(500, 500, {{d("101.00"), d("1")}}, {{d("101.01"), d("2")}});
+        partial.snapshot = true;
+        expect(book.apply(partial) == DepthApplyResult::APPLIED, "partial depth");
+        expect(book.levelCount(true) == 1 && book.bestAsk().price == d("101.01"), "partial replaces the book");
+        expect(book.lastUpdateId() == 500, "partial update id");
+    });
+
+    runTest("Snapshot parsing", []() {
+        DepthSnapshot snap = binance::parseDepthSnapshot(
+            R"({"lastUpdateId":1027024,"bids":[["4.00000000","431.00000000"]],)"
+            R"("asks":[["4.00000200","12.00000000"],["4.00000300","1.00000000"]]})");
+        expect(snap.lastUpdateId == 1027024, "last update id");
+        expect(snap.bids.size() == 1 && snap.bids[0].quantity == d("431"), "bids");
+        expect(snap.asks.size() == 2 && snap.asks[1].price == d("4.000003"), "asks");
+
+        OrderBook book("BNBBTC", d("0.000001"));
+        expect(book.applySnapshot(snap), "applied");
+        expect(book.bestAsk().price == d("4.000002"), "best ask");
+    });
+
+    bool badTick = false;
+    try {
+        OrderBook book("BTCUSDT", Decimal());
+    } catch (const std::invalid_argument&) {
+        badTick = true;
+    }
+    printTestResult("Rejects a zero tick size", badTick);
+    if (!badTick) {
+        ++failures;
+    }
+
+    if (runBenchmark) {
+        std::cout << "\n=== Benchmark ===" << std::endl;
+        try {
+            benchmark(argc > 2 ? argv[2] : nullptr);
+        } catch (const std::exception& e) {
+            std::cout << "Error: " << e.what() << std::endl;
+            ++failures;
+        }
+    }
+
+    std::cout << "\n=======================================" << std::endl;
+    std::cout << (failures == 0 ? "ALL TESTS PASSED" : "SOME TESTS FAILED") << std::endl;
+    std::cout << "=======================================" << std::endl;
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,143 @@
+#include "../include/RateLimiter.h"
+#include "../include/HttpClient.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <functional>
+#include <stdexcept>
+
+namespace {
+
+int failures = 0;
+
+void printTestResult(const std::string& testName, bool success) {
+    std::cout << std::left << std::setw(50) << testName << " : "
+              << (success ? "PASSED" : "FAILED") << std::endl;
+}
+
+void runTest(const std::string& testName, std::function<void()> testFunction) {
+    std::cout << "\n=== Running test: " << testName << " ===" << std::endl;
+    try {
+        testFunction();
+        printTestResult(testName, true);
+    } catch (const std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        printTestResult(testName, false);
+        ++failures;
+    }
+}
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        throw std::runtime_error("check failed: " + what);
+    }
+}
+
+using binance::RateLimiter;
+using binance::RateLimitType;
+using binance::RequestPriority;
+
+// 12:00:30.000 on some day, in the middle of a minute window
+const int64_t NOW = 1700000000000 - 1700000000000 % 60000 + 30000;
+
+} // namespace
+
+int main() {
+    std::cout << "\n\n=======================================" << std::endl;
+    std::cout << "RATE LIMITER TESTS" << std::endl;
+    std::cout << "=======================================" << std::endl;
+
+    runTest("Response header parsing", []() {
+        binance::ResponseInfo info;
+        expect(info.parseHeader("x-mbx-used-weight-1m: 23\r\n"), "weight header");
+        expect(info.parseHeader("X-MBX-ORDER-COUNT-10S: 4\r\n"), "order count header, upper case");
+        expect(info.parseHeader("x-mbx-order-count-1d: 150\r\n"), "daily order count");
+        expect(info.parseHeader("Retry-After: 7\r\n"), "retry-after");
+        expect(!info.parseHeader("x-mbx-used-weight: 23\r\n"), "header without interval ignored");
+        expect(!info.parseHeader("content-type: application/json\r\n"), "unrelated header ignored");
+        expect(info.usageCount == 3 && info.retryAfter == 7, "captured count");
+        expect(info.usages[0].type == RateLimitType::REQUEST_WEIGHT && info.usages[0].intervalSeconds == 60 &&
+               info.usages[0].count == 23, "weight usage");
+        expect(info.usages[1].type == RateLimitType::ORDERS && info.usages[1].intervalSeconds == 10 &&
+               info.usages[1].count == 4, "order usage");
+        expect(info.usages[2].intervalSeconds == 86400, "daily interval");
+        info.parseHeader("HTTP/2 200\r\n");
+        expect(info.usageCount == 0 && info.retryAfter == -1, "status line starts a new response");
+    });
+
+    runTest("Weight budget and pacing", []() {
+        RateLimiter limiter;
+        limiter.setLimit(RateLimitType::REQUEST_WEIGHT, 60, 100);
+        limiter.setCancelReserve(0);
+        expect(limiter.tryAcquire(RequestPriority::NORMAL, 60, 0, NOW) == 0, "first request");
+        expect(limiter.tryAcquire(RequestPriority::NORMAL, 40, 0, NOW) == 0, "fills the budget");
+        expect(limiter.tryAcquire(RequestPriority::NORMAL, 1, 0, NOW) == 30000, "waits for the next minute");
+        expect(limiter.used(RateLimitType::REQUEST_WEIGHT, 60, NOW) == 100, "usage");
+        expect(limiter.tryAcquire(RequestPriority::NORMAL, 1, 0, NOW + 30000) == 0, "new window");
+        expect(limiter.used(RateLimitType::REQUEST_WEIGHT, 60, NOW + 30000) == 1, "usage reset");
+    });
+
+    runTest("Order count limits", []() {
+        RateLimiter limiter;
+        limiter.setLimit(RateLimitType::ORDERS, 10, 3);
+        expect(limiter.tryAcquire(RequestPriority::NORMAL, 1, 2, NOW) == 0, "two orders");
+        expect(limiter.tryAcquire(RequestPriority::NORMAL, 1, 2, NOW) == 10000, "third and fourth exceed");
+        expect(limiter.used(RateLimitType::REQUEST_WEIGHT, 60, NOW) == 1, "weight of the refused request rolled back");
+        expect(limiter.used(RateLimitType::ORDERS, 86400, NOW) == 2, "daily count");
+        expect(limiter.tryAcquire(RequestPriority::NORMAL, 1, 0, NOW) == 0, "queries are not orders");
+    });
+
+    runTest("Cancels keep a reserve", []() {
+        RateLimiter limiter;
+        limiter.setLimit(RateLimitType::REQUEST_WEIGHT, 60, 100);
+        limiter.setCancelReserve(0.1);
+        expect(limiter.tryAcquire(RequestPriority::NORMAL, 90, 0, NOW) == 0, "orders up to the reserve");
+        expect(limiter.tryAcquire(RequestPriority::NORMAL, 1, 0, NOW) > 0, "orders stop at the reserve");
+        for (int i = 0; i < 10; ++i) {
+            expect(limiter.tryAcquire(RequestPriority::HIGH, 1, 0, NOW) == 0, "cancel uses the reserve");
+        }
+        expect(limiter.tryAcquire(RequestPriority::HIGH, 1, 0, NOW) > 0, "reserve exhausted");
+    });
+
+    runTest("Reported usage and bans", []() {
+        RateLimiter limiter;
+        binance::ResponseInfo info;
+        info.status = 200;
+        info.parseHeader("x-mbx-used-weight-1m: 5990\r\n");
+        limiter.update(info, NOW);
+        expect(limiter.used(RateLimitType::REQUEST_WEIGHT, 60, NOW) == 5990, "raised to reported usage");
+        expect(limiter.tryAcquire(RequestPriority::NORMAL, 1, 0, NOW) > 0, "budget gone");
+
+        binance::ResponseInfo lower;
+        lower.parseHeader("x-mbx-used-weight-1m: 10\r\n");
+        limiter.update(lower, NOW);
+        expect(limiter.used(RateLimitType::REQUEST_WEIGHT, 60, NOW) == 5990, "never lowered");
+
+        RateLimiter banned;
+        binance::ResponseInfo tooMany;
+        tooMany.status = 429;
+        tooMany.retryAfter = 120;
+        banned.update(tooMany, NOW);
+        expect(banned.tryAcquire(RequestPriority::HIGH, 1, 0, NOW + 1000) == 119000, "blocked by Retry-After");
+        expect(banned.tryAcquire(RequestPriority::HIGH, 1, 0, NOW + 120000) == 0, "unblocked");
+
+        RateLimiter live;
+        live.update(tooMany);
+        live.setMaxWait(100);
+        bool threw = false;
+        try {
+            live.acquire(RequestPriority::NORMAL, 1);
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        expect(threw, "acquire gives up past the maximum wait");
+        live.setEnabled(false);
+        live.acquire(RequestPriority::NORMAL, 1);
+    });
+
+    std::cout << "\n=======================================" << std::endl;
+    std::cout << (failures == 0 ? "ALL TESTS PASSED" : "SOME TESTS FAILED") << std::endl;
+    std::cout << "=======================================" << std::endl;
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,526 @@
+#include "../include/RiskEngine.h"
+#include "../include/SymbolRegistry.h"
+#include "../include/OrderStore.h"
+#include "../include/BinanceAPI.h"
+#include "../include/ExchangeSimulator.h"
+#include "../include/OrderGateway.h"
+#include "test_exchange.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <functional>
+#include <stdexcept>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <future>
+
+namespace {
+
+using binance::Decimal;
+using binance::OrderSide;
+using binance::OrderStatus;
+using binance::OrderType;
+using binance::RiskEngine;
+using binance::RiskLimits;
+using binance::RiskResult;
+using binance::SymbolId;
+using binance::test::Exchange;
+
+int failures = 0;
+
+void printTestResult(const std::string& testName, bool success) {
+    std::cout << std::left << std::setw(50) << testName << " : "
+              << (success ? "PASSED" : "FAILED") << std::endl;
+}
+
+void runTest(const std::string& testName, std::function<void()> testFunction) {
+    std::cout << "\n=== Running test: " << testName << " ===" << std::endl;
+    try {
+        testFunction();
+        printTestResult(testName, true);
+    } catch (const std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        printTestResult(testName, false);
+        ++failures;
+    }
+}
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        throw std::runtime_error("check failed: " + what);
+    }
+}
+
+Decimal dec(const char* text) {
+    return Decimal::parse(text);
+}
+
+// 1 BTC per order, 60000 USDT notional, 5% band, 3 open orders and 2 BTC either way
+RiskLimits btcLimits() {
+    RiskLimits limits;
+    limits.maxOrderQty = dec("1");
+    limits.maxNotional = dec("60000");
+    limits.priceBand = dec("0.05");
+    limits.maxOpenOrders = 3;
+    limits.maxPosition = dec("2");
+    return limits;
+}
+
+// An order update for OrderStore::apply
+binance::OrderUpdateEvent update(int64_t orderId, OrderSide side, OrderStatus status, const char* quantity,
+                                 const char* executed) {
+    binance::OrderUpdateEvent event;
+    event.symbol.assign("BTCUSDT");
+    event.clientOrderId.assign("risk-" + std::to_string(orderId));
+    event.orderId = orderId;
+    event.side = side;
+    event.type = OrderType::LIMIT;
+    event.status = status;
+    event.price = dec("50000");
+    event.quantity = dec(quantity);
+    event.executedQty = dec(executed);
+    event.eventTime = orderId * 10 + static_cast<int64_t>(status);
+    return event;
+}
+
+void benchmark() {
+    binance::SymbolRegistry registry;
+    RiskEngine risk(registry);
+    for (int i = 0; i < 2000; ++i) {
+        RiskLimits limits = btcLimits();
+        limits.maxOpenOrders = 1000000;
+        limits.maxPosition = dec("1000000");
+        risk.setLimits("SYM" + std::to_string(i) + "USDT", limits);
+    }
+    SymbolId id = registry.find("SYM1234USDT");
+    risk.onTrade(id, dec("50000"));
+
+    const int rounds = 10000000;
+    const Decimal small = dec("0.01"), large = dec("2"), far = dec("80000");
+    int64_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; ++i) {
+        Decimal price = Decimal::fromUnits(4990000000000 + (i & 1023) * 1000000);
+        sink += static_cast<int64_t>(risk.check(id, OrderSide::BUY, OrderType::LIMIT, price, small));
+    }
+    double check = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / rounds;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; ++i) {
+        Decimal price = Decimal::fromUnits(4990000000000 + (i & 1023) * 1000000);
+        OrderSide side = i & 1 ? OrderSide::SELL : OrderSide::BUY;
+        sink += static_cast<int64_t>(risk.reserve(id, side, OrderType::LIMIT, price, small));
+        risk.release(id, side, small);
+    }
+    double reserve = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / rounds;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; ++i) {
+        // Alternating reasons, so the counters and early exits are both exercised
+        Decimal quantity = i & 1 ? large : small;
+        sink += static_cast<int64_t>(risk.reserve(id, OrderSide::BUY, OrderType::LIMIT, far, quantity));
+    }
+    double reject = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / rounds;
+
+    std::cout << "check " << check << " ns, reserve + release " << reserve << " ns, reject " << reject
+              << " ns per order (" << sink % 10 << ")" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool runBenchmark = argc > 1 && std::string(argv[1]) == "--bench";
+
+    std::cout << "\n\n=======================================" << std::endl;
+    std::cout << "RISK ENGINE TESTS" << std::endl;
+    std::cout << "=======================================" << std::endl;
+
+    runTest("Limits and reject reasons", []() {
+        binance::SymbolRegistry registry;
+        RiskEngine risk(registry);
+        risk.setLimits("btcusdt", btcLimits());
+        SymbolId btc = registry.find("BTCUSDT");
+        expect(btc != binance::INVALID_SYMBOL && risk.limits(btc).maxOpenOrders == 3, "limits set by name");
+
+        expect(risk.reserve(registry.intern("ETHUSDT"), OrderSide::BUY, OrderType::LIMIT, dec("3000"), dec("1")) ==
+               RiskResult::UNKNOWN_SYMBOL, "symbols without limits are refused");
+        expect(risk.reserve(btc, OrderSide::BUY, OrderType::LIMIT, dec("50000"), dec("0.1")) ==
+               RiskResult::NO_REFERENCE_PRICE, "band needs a last trade");
+        expect(risk.reserve(btc, OrderSide::BUY, OrderType::MARKET, Decimal(), dec("0.1")) ==
+               RiskResult::NO_REFERENCE_PRICE, "market notional needs a last trade");
+
+        risk.onTrade(btc, dec("50000"));
+        expect(risk.exposure(btc).lastPrice == dec("50000"), "last trade");
+        expect(risk.check(btc, OrderSide::BUY, OrderType::LIMIT, dec("50000"), dec("1.5")) == RiskResult::ORDER_SIZE,
+               "order size");
+        expect(risk.check(btc, OrderSide::BUY, OrderType::LIMIT, dec("50000"), dec("1")) == RiskResult::OK,
+               "50000 USDT is under the notional");
+        expect(risk.check(btc, OrderSide::SELL, OrderType::LIMIT, dec("61000"), dec("1")) == RiskResult::NOTIONAL,
+               "notional at the limit price");
+        expect(risk.check(btc, OrderSide::BUY, OrderType::MARKET, Decimal(), Decimal(), dec("70000")) ==
+               RiskResult::NOTIONAL, "quote quantity is the notional");
+        expect(risk.check(btc, OrderSide::BUY, OrderType::LIMIT, dec("47500"), dec("0.1")) == RiskResult::OK,
+               "edge of the band");
+        expect(risk.check(btc, OrderSide::BUY, OrderType::LIMIT, dec("47499.99"), dec("0.1")) == RiskResult::PRICE_BAND,
+               "below the band");
+        expect(risk.check(btc, OrderSide::SELL, OrderType::LIMIT, dec("52500.01"), dec("0.1")) == RiskResult::PRICE_BAND,
+               "above the band");
+        expect(risk.check(btc, OrderSide::SELL, OrderType::STOP_LOSS, Decimal(), dec("0.1")) == RiskResult::OK,
+               "stop orders without a price are valued at the last trade");
+        expect(risk.exposure(btc).openOrders == 0, "check() reserves nothing");
+
+        expect(risk.checked() == 3, "reserve() calls counted");
+        expect(risk.rejects(RiskResult::UNKNOWN_SYMBOL) == 1 && risk.rejects(RiskResult::NO_REFERENCE_PRICE) == 2,
+               "rejects counted by reason");
+        expect(std::string(binance::toString(RiskResult::PRICE_BAND)) == "PRICE_BAND", "reason names");
+    });
+
+    runTest("Orders too large to value are rejected", []() {
+        binance::SymbolRegistry registry;
+        RiskEngine risk(registry);
+        RiskLimits notionalOnly;
+        notionalOnly.maxNotional = dec("1000");
+        risk.setLimits("BTCUSDT", notionalOnly);
+        SymbolId btc = registry.find("BTCUSDT");
+
+        // 100000 * 1000000 is 1e11 USDT, past Decimal's range; a wrapped product would pass
+        expect(risk.reserve(btc, OrderSide::BUY, OrderType::LIMIT, dec("100000"), dec("1000000")) ==
+               RiskResult::NOTIONAL, "overflowing notional");
+        risk.onTrade(btc, dec("90000000"));
+        expect(risk.check(btc, OrderSide::SELL, OrderType::MARKET, Decimal(), dec("90000000")) == RiskResult::NOTIONAL,
+               "overflowing market notional");
+        expect(risk.check(btc, OrderSide::BUY, OrderType::LIMIT, dec("1000"), dec("1")) == RiskResult::OK, "at the limit");
+        expect(risk.check(btc, OrderSide::BUY, OrderType::LIMIT, dec("1000"), dec("1.00000001")) == RiskResult::NOTIONAL,
+               "one unit over the limit");
+
+        RiskLimits positionOnly;
+        positionOnly.maxPosition = dec("2");
+        risk.setLimits("ETHUSDT", positionOnly);
+        SymbolId eth = registry.find("ETHUSDT");
+        expect(risk.reserve(eth, OrderSide::BUY, OrderType::LIMIT, dec("3000"), dec("1")) == RiskResult::OK, "reserved");
+        expect(risk.check(eth, OrderSide::BUY, OrderType::LIMIT, dec("3000"), Decimal::fromUnits(INT64_MAX)) ==
+               RiskResult::POSITION, "position sum cannot wrap");
+        expect(risk.exposure(eth).openOrders == 1, "nothing reserved for the rejects");
+
+        // 21 times 5e9 is past Decimal's range; a wrapped bound would refuse every price
+        RiskLimits wideBand;
+        wideBand.priceBand = dec("21");
+        risk.setLimits("XYZUSDT", wideBand);
+        SymbolId xyz = registry.find("XYZUSDT");
+        risk.onTrade(xyz, dec("5000000000"));
+        expect(risk.check(xyz, OrderSide::SELL, OrderType::LIMIT, dec("90000000000"), dec("1")) == RiskResult::OK,
+               "band bound past Decimal's range");
+        risk.onTrade(xyz, dec("4000000000"));
+        expect(risk.check(xyz, OrderSide::SELL, OrderType::LIMIT, dec("88000000000"), dec("1")) == RiskResult::OK,
+               "edge of a wide band");
+        expect(risk.check(xyz, OrderSide::SELL, OrderType::LIMIT, dec("88000000000.00000001"), dec("1")) ==
+               RiskResult::PRICE_BAND, "one unit past a wide band");
+
+        bool threw = false;
+        try {
+            RiskLimits wide;
+            wide.priceBand = dec("25");
+            risk.setLimits("BTCUSDT", wide);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        expect(threw, "price band out of range");
+    });
+
+    runTest("Open orders, fills and positions", []() {
+        binance::SymbolRegistry registry;
+        RiskEngine risk(registry);
+        risk.setLimits("BTCUSDT", btcLimits());
+        SymbolId btc = registry.find("BTCUSDT");
+        risk.onTrade(btc, dec("50000"));
+        binance::OrderStore store;
+        auto feed = [&](const binance::OrderUpdateEvent& event) {
+            binance::OrderExecution fill;
+            if (store.apply(event, &fill) == binance::OrderApplyResult::APPLIED) {
+                risk.apply(event, fill);
+            }
+        };
+
+        // Two buys of 1 reach the 2 BTC limit once both are open
+        expect(risk.reserve(btc, OrderSide::BUY, OrderType::LIMIT, dec("50000"), dec("1")) == RiskResult::OK, "first");
+        expect(risk.reserve(btc, OrderSide::BUY, OrderType::LIMIT, dec("50000"), dec("1")) == RiskResult::OK, "second");
+        expect(risk.reserve(btc, OrderSide::BUY, OrderType::LIMIT, dec("50000"), dec("0.1")) == RiskResult::POSITION,
+               "open buys count towards the position");
+        expect(risk.reserve(btc, OrderSide::SELL, OrderType::LIMIT, dec("50000"), dec("1")) == RiskResult::OK,
+               "sells are checked against the short side");
+        expect(risk.reserve(btc, OrderSide::SELL, OrderType::LIMIT, dec("50000"), dec("0.1")) == RiskResult::OPEN_ORDERS,
+               "open order count");
+        binance::RiskExposure exposure = risk.exposure(btc);
+        expect(exposure.openOrders == 3 && exposure.openBuyQty == dec("2") && exposure.openSellQty == dec("1"),
+               "reserved");
+
+        feed(update(1, OrderSide::BUY, OrderStatus::NEW, "1", "0"));
+        feed(update(1, OrderSide::BUY, OrderStatus::PARTIALLY_FILLED, "1", "0.4"));
+        feed(update(1, OrderSide::BUY, OrderStatus::PARTIALLY_FILLED, "1", "0.4"));  // Duplicate, dropped by the store
+        exposure = risk.exposure(btc);
+        expect(exposure.position == dec("0.4") && exposure.openBuyQty == dec("1.6") && exposure.openOrders == 3,
+               "fill moves quantity into the position");
+
+        feed(update(1, OrderSide::BUY, OrderStatus::CANCELED, "1", "0.4"));
+        exposure = risk.exposure(btc);
+        expect(exposure.openOrders == 2 && exposure.openBuyQty == dec("1"), "cancel frees the rest");
+
+        feed(update(2, OrderSide::BUY, OrderStatus::FILLED, "1", "1"));
+        exposure = risk.exposure(btc);
+        expect(exposure.position == dec("1.4") && exposure.openBuyQty.isZero() && exposure.openOrders == 1, "filled");
+        expect(risk.reserve(btc, OrderSide::BUY, OrderType::LIMIT, dec("50000"), dec("0.7")) == RiskResult::POSITION,
+               "filled position counts");
+        expect(risk.reserve(btc, OrderSide::BUY, OrderType::LIMIT, dec("50000"), dec("0.6")) == RiskResult::OK,
+               "up to the limit");
+
+        risk.release(btc, OrderSide::BUY, dec("0.6"));
+        risk.release(btc, OrderSide::SELL, dec("1"));
+        risk.release(btc, OrderSide::SELL, dec("1"));  // Never reserved: clamped
+        exposure = risk.exposure(btc);
+        expect(exposure.openOrders == 0 && exposure.openSellQty.isZero(), "released");
+        risk.setPosition(btc, dec("-2"));
+        expect(risk.check(btc, OrderSide::SELL, OrderType::LIMIT, dec("50000"), dec("0.01")) == RiskResult::POSITION,
+               "short limit");
+        expect(risk.check(btc, OrderSide::BUY, OrderType::LIMIT, dec("50000"), dec("1")) == RiskResult::OK,
+               "buying reduces a short");
+    });
+
+    runTest("Concurrent reserves respect the open-order limit", []() {
+        binance::SymbolRegistry registry;
+        RiskEngine risk(registry);
+        RiskLimits limits;
+        limits.maxOpenOrders = 1000;
+        risk.setLimits("BTCUSDT", limits);
+        SymbolId btc = registry.find("BTCUSDT");
+
+        std::atomic<int> accepted{0};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&]() {
+                for (int i = 0; i < 5000; ++i) {
+                    if (risk.reserve(btc, OrderSide::BUY, OrderType::LIMIT, dec("50000"), dec("0.001")) ==
+                        RiskResult::OK) {
+                        ++accepted;
+                    }
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        expect(accepted == 1000 && risk.exposure(btc).openOrders == 1000, "exactly the limit");
+        expect(risk.exposure(btc).openBuyQty == dec("1"), "quantity of the accepted orders");
+        expect(risk.rejects(RiskResult::OPEN_ORDERS) == 19000 && risk.checked() == 20000, "rest rejected");
+    });
+
+    runTest("BinanceAPI checks orders before signing", []() {
+        Exchange exchange;
+        binance::SymbolRegistry registry;
+        RiskEngine risk(registry);
+        risk.setLimits("BTCUSDT", btcLimits());
+        risk.setLimits("XRPUSDT", btcLimits());
+        risk.onTrade(registry.find("BTCUSDT"), dec("50000"));
+        risk.onTrade(registry.find("XRPUSDT"), dec("0.5"));
+        exchange.api.setRiskEngine(&risk);
+        expect(exchange.api.riskEngine() == &risk, "set");
+
+        std::map<std::string, std::string> params = {{"timeInForce", "GTC"}, {"price", "49000"}, {"quantity", "0.5"}};
+        binance::OrderInfo order = exchange.api.createOrderTyped("BTCUSDT", "BUY", "LIMIT", params);
+        expect(order.status == OrderStatus::NEW && risk.exposure(registry.find("BTCUSDT")).openOrders == 1,
+               "accepted order reserved");
+
+        uint64_t before = exchange.simulator.requestCount();
+        params["price"] = "40000";
+        std::string error;
+        try {
+            exchange.api.createOrder("BTCUSDT", "BUY", "LIMIT", params);
+        } catch (const std::runtime_error& e) {
+            error = e.what();
+        }
+        expect(error.find("-2010") != std::string::npos && error.find("PRICE_BAND") != std::string::npos,
+               "fat finger refused: " + error);
+
+        binance::RequestBuilder request;
+        request.add("timeInForce", "GTC").add("price", "49000").add("quantity", "5");
+        binance::Response response;
+        expect(!exchange.api.tryCreateOrder("BTCUSDT", "BUY", "LIMIT", request, response), "try variant refused");
+        expect(response.status == 400 && response.code == -2010 && response.message().find("ORDER_SIZE") != std::string_view::npos,
+               "answered like the exchange");
+
+        bool threw = false;
+        try {
+            exchange.api.createOrderAsync("ETHUSDT", "SELL", "MARKET", {{"quantity", "1"}});
+        } catch (const std::runtime_error& e) {
+            threw = std::string(e.what()).find("UNKNOWN_SYMBOL") != std::string::npos;
+        }
+        expect(threw, "async refused before sending");
+        expect(exchange.simulator.requestCount() == before, "nothing sent");
+
+        // The simulator does not list XRPUSDT, so the order is rejected there and its reservation returned
+        threw = false;
+        try {
+            exchange.api.createOrder("XRPUSDT", "BUY", "LIMIT", {{"timeInForce", "GTC"}, {"price", "0.5"}, {"quantity", "1"}});
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        expect(threw && risk.exposure(registry.find("XRPUSDT")).openOrders == 0, "released after an exchange reject");
+
+        // An async reject is released by the client before the future throws
+        std::future<std::string> rejected = exchange.api.createOrderAsync(
+            "XRPUSDT", "BUY", "LIMIT", {{"timeInForce", "GTC"}, {"price", "0.5"}, {"quantity", "1"}});
+        threw = false;
+        try {
+            rejected.get();
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        binance::RiskExposure xrp = risk.exposure(registry.find("XRPUSDT"));
+        expect(threw && xrp.openOrders == 0 && xrp.openBuyQty == Decimal(), "released after an async reject");
+        expect(risk.checked() == 6 && risk.rejects(RiskResult::PRICE_BAND) == 1, "counted");
+
+        exchange.api.setRiskEngine(nullptr);
+        expect(exchange.api.tryCreateOrder("BTCUSDT", "BUY", "LIMIT", request, response), "checking off");
+    });
+
+    runTest("Cancel-replace, SOR and order lists are checked", []() {
+        Exchange exchange;
+        binance::SymbolRegistry registry;
+        RiskEngine risk(registry);
+        RiskLimits limits = btcLimits();
+        limits.maxOpenOrders = 20;
+        limits.maxPosition = dec("10");
+        risk.setLimits("BTCUSDT", limits);
+        SymbolId btc = registry.find("BTCUSDT");
+        risk.onTrade(btc, dec("50000"));
+        exchange.api.setRiskEngine(&risk);
+        binance::BinanceAPI& api = exchange.api;
+
+        auto failure = [](const std::function<void()>& send) {
+            try {
+                send();
+            } catch (const std::runtime_error& e) {
+                return std::string(e.what());
+            }
+            return std::string();
+        };
+        auto refused = [&](const std::string& error, const char* reason) {
+            return error.find("-2010") != std::string::npos && error.find(reason) != std::string::npos;
+        };
+        std::map<std::string, std::string> otoco = {
+            {"workingType", "LIMIT"}, {"workingSide", "BUY"}, {"workingPrice", "49000"},
+            {"workingQuantity", "0.5"}, {"workingTimeInForce", "GTC"}, {"pendingSide", "SELL"},
+            {"pendingQuantity", "0.5"}, {"pendingAboveType", "LIMIT_MAKER"}, {"pendingAbovePrice", "60000"},
+            {"pendingBelowType", "STOP_LOSS"}, {"pendingBelowStopPrice", "45000"}};
+        std::map<std::string, std::string> replace = {{"cancelOrderId", "999999"}, {"timeInForce", "GTC"},
+                                                      {"price", "40000"}, {"quantity", "0.1"}};
+
+        uint64_t before = exchange.simulator.requestCount();
+        expect(refused(failure([&]() { api.createOrderListOTOCO("BTCUSDT", otoco); }), "PRICE_BAND"),
+               "list with one order out of band refused");
+        expect(risk.exposure(btc).openOrders == 0, "orders of a refused list given back");
+        expect(refused(failure([&]() {
+                   api.createSOROrder("BTCUSDT", "BUY", "MARKET", {{"quantity", "2"}});
+               }), "ORDER_SIZE"),
+               "SOR order refused");
+        expect(refused(failure([&]() {
+                   api.cancelReplaceOrder("BTCUSDT", "BUY", "LIMIT", "STOP_ON_FAILURE", replace);
+               }), "PRICE_BAND"),
+               "replacement refused");
+        expect(exchange.simulator.requestCount() == before, "nothing sent");
+        replace["price"] = "49000";
+
+        otoco["pendingAbovePrice"] = "51000";
+        api.createOrderListOTOCO("BTCUSDT", otoco);
+        binance::RiskExposure exposure = risk.exposure(btc);
+        expect(exposure.openOrders == 3 && exposure.openBuyQty == dec("0.5") && exposure.openSellQty == dec("1"),
+               "one reservation per order of a list");
+        api.createOCO("BTCUSDT", "SELL", "0.5", "51000", "49000",
+                      {{"stopLimitPrice", "48900"}, {"stopLimitTimeInForce", "GTC"}});
+        api.createOrderListOCO("BTCUSDT", "SELL", "0.5",
+                               {{"aboveType", "LIMIT_MAKER"}, {"abovePrice", "51000"},
+                                {"belowType", "STOP_LOSS_LIMIT"}, {"belowPrice", "48900"},
+                                {"belowStopPrice", "49000"}, {"belowTimeInForce", "GTC"}});
+        api.createSOROrder("BTCUSDT", "BUY", "LIMIT", {{"timeInForce", "GTC"}, {"price", "49000"}, {"quantity", "0.1"}});
+        expect(risk.exposure(btc).openOrders == 8, "OCO lists and SOR order reserved");
+
+        // Nothing to cancel: STOP_ON_FAILURE places nothing, ALLOW_FAILURE still places the new order
+        expect(!failure([&]() {
+                   api.cancelReplaceOrder("BTCUSDT", "BUY", "LIMIT", "STOP_ON_FAILURE", replace);
+               }).empty(), "failed cancel-replace");
+        binance::Response response;
+        binance::RequestBuilder request;
+        request.add("cancelOrderId", "999999").add("timeInForce", "GTC").add("price", "49000").add("quantity", "0.1");
+        expect(!api.tryCancelReplaceOrder("BTCUSDT", "BUY", "LIMIT", "STOP_ON_FAILURE", request, response),
+               "failed try variant");
+        std::future<std::string> future =
+            api.cancelReplaceOrderAsync("BTCUSDT", "BUY", "LIMIT", "STOP_ON_FAILURE", replace);
+        expect(!failure([&]() { future.get(); }).empty(), "failed async variant");
+        expect(risk.exposure(btc).openOrders == 8, "reservations of the new orders given back");
+
+        std::string partial = failure([&]() {
+            api.cancelReplaceOrder("BTCUSDT", "BUY", "LIMIT", "ALLOW_FAILURE", replace);
+        });
+        expect(partial.find("-2021") != std::string::npos, "partially failed: " + partial);
+        future = api.cancelReplaceOrderAsync("BTCUSDT", "BUY", "LIMIT", "ALLOW_FAILURE", replace);
+        expect(!failure([&]() { future.get(); }).empty(), "async variant partially failed");
+        exposure = risk.exposure(btc);
+        expect(exposure.openOrders == 10 && exposure.openBuyQty == dec("0.8"), "placed orders stay reserved");
+    });
+
+    runTest("Order gateway reports risk rejects", []() {
+        Exchange exchange;
+        binance::SymbolRegistry registry;
+        RiskEngine risk(registry);
+        risk.setLimits("BTCUSDT", btcLimits());
+        risk.setLimits("XRPUSDT", btcLimits());
+        risk.onTrade(registry.find("BTCUSDT"), dec("50000"));
+        risk.onTrade(registry.find("XRPUSDT"), dec("0.5"));
+        exchange.api.setRiskEngine(&risk);
+        binance::RestOrderGateway gateway(exchange.api);
+
+        binance::OrderParams order;
+        order.symbol = "BTCUSDT";
+        order.side = OrderSide::BUY;
+        order.type = OrderType::LIMIT;
+        order.timeInForce = binance::TimeInForce::GTC;
+        order.price = dec("49000");
+        order.quantity = dec("0.5");
+        gateway.placeOrder(order);
+        order.quantity = dec("3");
+        gateway.placeOrder(order);
+        order.symbol = "XRPUSDT";
+        order.price = dec("0.5");
+        order.quantity = dec("1");
+        gateway.placeOrder(order);
+
+        std::vector<binance::OrderUpdateEvent> updates;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (updates.size() < 3 && std::chrono::steady_clock::now() < deadline) {
+            gateway.poll([&](const binance::OrderUpdateEvent& update) { updates.push_back(update); });
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        expect(updates.size() == 3, "all answered");
+        int accepted = 0, riskRejected = 0, exchangeRejected = 0;
+        for (const binance::OrderUpdateEvent& update : updates) {
+            if (update.status == OrderStatus::NEW) ++accepted;
+            if (update.status == OrderStatus::REJECTED && update.errorCode == -2010) ++riskRejected;
+            if (update.status == OrderStatus::REJECTED && update.symbol == "XRPUSDT") ++exchangeRejected;
+        }
+        expect(accepted == 1 && riskRejected == 1 && exchangeRejected == 1, "one of each");
+        expect(risk.exposure(registry.find("BTCUSDT")).openOrders == 1, "accepted order still reserved");
+        expect(risk.exposure(registry.find("XRPUSDT")).openOrders == 0, "failed order released");
+    });
+
+    if (runBenchmark) {
+        std::cout << "\n=== Benchmark ===" << std::endl;
+        benchmark();
+    }
+
+    std::cout << "\n=======================================" << std::endl;
+    std::cout << (failures == 0 ? "ALL TESTS PASSED" : "SOME TESTS FAILED") << std::endl;
+    std::cout << "=======================================" << std::endl;
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,262 @@
+#include "../include/Sha256.h"
+#include "../include/BinanceAuth.h"
+#include "../include/BinanceTypes.h"
+#include "../include/RequestBuilder.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <functional>
+#include <stdexcept>
+#include <string_view>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+int failures = 0;
+
+void printTestResult(const std::string& testName, bool success) {
+    std::cout << std::left << std::setw(50) << testName << " : "
+              << (success ? "PASSED" : "FAILED") << std::endl;
+}
+
+void runTest(const std::string& testName, std::function<void()> testFunction) {
+    std::cout << "\n=== Running test: " << testName << " ===" << std::endl;
+    try {
+        testFunction();
+        printTestResult(testName, true);
+    } catch (const std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        printTestResult(testName, false);
+        ++failures;
+    }
+}
+
+std::string toHex(const binance::Sha256::Digest& digest) {
+    static const char digits[] = "0123456789abcdef";
+    std::string hex;
+    for (uint8_t byte : digest) {
+        hex += digits[byte >> 4];
+        hex += digits[byte & 0x0F];
+    }
+    return hex;
+}
+
+void expectEqual(const std::string& actual, const std::string& expected, const std::string& what) {
+    if (actual != expected) {
+        throw std::runtime_error(what + ": expected " + expected + ", got " + actual);
+    }
+}
+
+// FIPS 180-4 / NIST CAVP known-answer vectors
+struct KnownAnswer {
+    std::string message;
+    size_t repeat;
+    std::string digest;
+};
+
+const std::vector<KnownAnswer> knownAnswers = {
+    {"", 1, "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"},
+    {"abc", 1, "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"},
+    {"abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 1,
+     "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"},
+    {"abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu", 1,
+     "cf5b16a778af8380036ce59e7b0492370b249b11e8f07a51afac45037afee9d1"},
+    {"a", 1000000, "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0"},
+};
+
+void checkKnownAnswers() {
+    for (const auto& kat : knownAnswers) {
+        std::string message;
+        for (size_t i = 0; i < kat.repeat; ++i) {
+            message += kat.message;
+        }
+        expectEqual(toHex(binance::Sha256::hash(message.data(), message.size())), kat.digest,
+                    "one-shot digest of " + std::to_string(message.size()) + " bytes");
+
+        // Feed the same message in uneven pieces to exercise the streaming buffer
+        binance::Sha256 sha;
+        size_t offset = 0;
+        size_t piece = 1;
+        while (offset < message.size()) {
+            size_t len = std::min(piece, message.size() - offset);
+            sha.update(message.data() + offset, len);
+            offset += len;
+            piece = piece * 3 + 1;
+        }
+        expectEqual(toHex(sha.finish()), kat.digest,
+                    "streamed digest of " + std::to_string(message.size()) + " bytes");
+    }
+}
+
+// Batch signatures must match one-at-a-time signatures for every length and lane count
+void checkBatchSigning() {
+    binance::BinanceAuth auth("key", "NhqPtmdSJYdKjVHjA7PZj4Mge3R5YNiP1e3UZjInClVN65XAbvqqM6A7H5fATj0j");
+    std::vector<std::string> queries;
+    for (size_t len = 0; len < 200; len += 7) {
+        std::string value(len, 'x');
+        for (size_t i = 0; i < len; ++i) {
+            value[i] = static_cast<char>('0' + (i * 13 + len) % 43);
+        }
+        queries.push_back("q=" + value);
+    }
+
+    for (size_t count : {size_t(1), size_t(3), size_t(8), size_t(9), queries.size()}) {
+        std::vector<std::string_view> payloads(queries.begin(), queries.begin() + count);
+        std::string signatures(count * binance::BinanceAuth::SIGNATURE_LENGTH, '\0');
+        auth.signBatch(payloads.data(), count, &signatures[0]);
+
+        for (size_t i = 0; i < count; ++i) {
+            std::map<std::string, std::string> params = {{"q", queries[i].substr(2)}};
+            expectEqual(signatures.substr(i * 64, 64), auth.generateSignature(params),
+                        "batch of " + std::to_string(count) + ", lane " + std::to_string(i));
+        }
+    }
+}
+
+// A request signed in place must carry the same bytes and signature as the map path
+void checkSignedRequest() {
+    binance::BinanceAuth auth("key", "NhqPtmdSJYdKjVHjA7PZj4Mge3R5YNiP1e3UZjInClVN65XAbvqqM6A7H5fATj0j");
+    std::map<std::string, std::string> params = {
+        {"price", "50000.00"}, {"quantity", "0.001"}, {"side", "BUY"}, {"symbol", "BTCUSDT"},
+        {"timeInForce", "GTC"}, {"timestamp", "1499827319559"}, {"type", "LIMIT"}
+    };
+
+    binance::RequestBuilder request;
+    request.add(params);
+    auth.signRequest(request);
+
+    const std::string query = binance::paramsToQueryString(params);
+    expectEqual(request.str(), query + "&signature=" + auth.generateSignature(params), "signed request");
+
+    // Long requests spill to the heap without changing the bytes
+    binance::RequestBuilder longRequest;
+    std::string expected;
+    for (int i = 0; i < 100; ++i) {
+        longRequest.add("k" + std::to_string(i), static_cast<int64_t>(i) * 1000003);
+        expected += (i ? "&k" : "k") + std::to_string(i) + "=" + std::to_string(i * 1000003);
+    }
+    expectEqual(longRequest.str(), expected, "spilled request");
+    expectEqual(std::to_string(std::strlen(longRequest.data())), std::to_string(expected.size()),
+                "NUL-terminated request");
+}
+
+void benchmarkBatch() {
+    binance::BinanceAuth auth("key", "NhqPtmdSJYdKjVHjA7PZj4Mge3R5YNiP1e3UZjInClVN65XAbvqqM6A7H5fATj0j");
+
+    // A 32-level quote ladder
+    std::vector<std::string> ladder;
+    for (int level = 0; level < 32; ++level) {
+        ladder.push_back("symbol=BTCUSDT&side=" + std::string(level < 16 ? "BUY" : "SELL") +
+                         "&type=LIMIT&timeInForce=GTC&quantity=0.00100000&price=" +
+                         std::to_string(50000 + (level - 16) * 5) +
+                         ".00&newClientOrderId=ladder-" + std::to_string(level) +
+                         "&timestamp=1499827319559");
+    }
+    std::vector<std::string_view> payloads(ladder.begin(), ladder.end());
+    std::string signatures(ladder.size() * binance::BinanceAuth::SIGNATURE_LENGTH, '\0');
+
+    const size_t refreshes = 20000;
+    for (bool multiBuffer : {false, true}) {
+        if (!binance::Sha256::setMultiBuffer(multiBuffer)) {
+            continue;
+        }
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < refreshes; ++i) {
+            auth.signBatch(payloads.data(), payloads.size(), &signatures[0]);
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << "  ladder of " << ladder.size() << " (" << (multiBuffer ? "avx2 x8" : "sequential")
+                  << "): " << std::fixed << std::setprecision(2)
+                  << (elapsed.count() / refreshes * 1e6) << " us per refresh" << std::endl;
+    }
+}
+
+void benchmark(binance::Sha256::Backend backend) {
+    std::vector<uint8_t> data(16384, 0xA5);
+    for (size_t size : {64, 256, 1024, 16384}) {
+        size_t iterations = (64u << 20) / size;
+        auto start = std::chrono::steady_clock::now();
+        uint8_t sink = 0;
+        for (size_t i = 0; i < iterations; ++i) {
+            sink ^= binance::Sha256::hash(data.data(), size)[0];
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << "  " << std::left << std::setw(8) << binance::toString(backend)
+                  << std::right << std::setw(6) << size << " B: "
+                  << std::fixed << std::setprecision(1)
+                  << (iterations * size / elapsed.count() / (1 << 20)) << " MB/s"
+                  << (sink == 0xFF ? " " : "") << std::endl;
+    }
+
+    binance::BinanceAuth auth("key", "NhqPtmdSJYdKjVHjA7PZj4Mge3R5YNiP1e3UZjInClVN65XAbvqqM6A7H5fATj0j");
+    std::map<std::string, std::string> params = {
+        {"symbol", "BTCUSDT"}, {"side", "BUY"}, {"type", "LIMIT"}, {"timeInForce", "GTC"},
+        {"quantity", "0.001"}, {"price", "50000.00"}, {"timestamp", "1499827319559"}
+    };
+    const size_t signatures = 200000;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < signatures; ++i) {
+        auth.generateSignature(params);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "  " << std::left << std::setw(8) << binance::toString(backend)
+              << " signatures: " << std::fixed << std::setprecision(0)
+              << (signatures / elapsed.count()) << " /s" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool runBenchmark = argc > 1 && std::string(argv[1]) == "--bench";
+
+    std::cout << "\n\n=======================================" << std::endl;
+    std::cout << "SHA-256 BACKEND TESTS" << std::endl;
+    std::cout << "=======================================" << std::endl;
+    std::cout << "Detected backend: " << binance::toString(binance::Sha256::activeBackend()) << std::endl;
+
+    const binance::Sha256::Backend detected = binance::Sha256::activeBackend();
+    for (auto backend : {binance::Sha256::Backend::SCALAR, binance::Sha256::Backend::SHA_NI}) {
+        if (!binance::Sha256::setBackend(backend)) {
+            std::cout << "\nSkipping " << binance::toString(backend) << ": not supported on this CPU" << std::endl;
+            continue;
+        }
+
+        runTest(std::string("Known answers (") + binance::toString(backend) + ")", checkKnownAnswers);
+
+        runTest(std::string("HMAC signature (") + binance::toString(backend) + ")", []() {
+            // Long keys are hashed first; 80 bytes exercises that path as well
+            binance::BinanceAuth auth("key", std::string(80, 'k'));
+            expectEqual(auth.generateSignature({{"symbol", "BTCUSDT"}, {"timestamp", "1499827319559"}}),
+                        "d35d1945bfe696883adbcac7e34bfce4ecfefc19b73179099dc3b9d25f4dd971",
+                        "HMAC-SHA256");
+        });
+
+        if (runBenchmark) {
+            benchmark(backend);
+        }
+    }
+    binance::Sha256::setBackend(detected);
+
+    const bool multiBuffer = binance::Sha256::isMultiBufferEnabled();
+    for (bool enabled : {false, true}) {
+        if (!binance::Sha256::setMultiBuffer(enabled)) {
+            std::cout << "\nSkipping multi-buffer batch signing: AVX2 not supported on this CPU" << std::endl;
+            continue;
+        }
+        runTest(std::string("Batch signing (") + (enabled ? "avx2 x8" : "sequential") + ")", checkBatchSigning);
+    }
+    runTest("Signed request serialization", checkSignedRequest);
+    if (runBenchmark) {
+        benchmarkBatch();
+    }
+    binance::Sha256::setMultiBuffer(multiBuffer);
+
+    std::cout << "\n=======================================" << std::endl;
+    std::cout << (failures == 0 ? "ALL TESTS PASSED" : "SOME TESTS FAILED") << std::endl;
+    std::cout << "=======================================" << std::endl;
+
+    return failures == 0 ? 0 : 1;
+}
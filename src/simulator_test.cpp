@@ -0,0 +1,535 @@
+#include "../include/ExchangeSimulator.h"
+#include "../include/BinanceAPI.h"
+#include "../include/RateLimiter.h"
+#include "../include/HttpClient.h"
+#include "test_exchange.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <functional>
+#include <stdexcept>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <future>
+#include <thread>
+#include <atomic>
+
+namespace {
+
+using binance::test::API_KEY;
+using binance::test::API_SECRET;
+using binance::test::Exchange;
+using binance::test::simulatorConfig;
+
+int failures = 0;
+
+void printTestResult(const std::string& testName, bool success) {
+    std::cout << std::left << std::setw(50) << testName << " : "
+              << (success ? "PASSED" : "FAILED") << std::endl;
+}
+
+void runTest(const std::string& testName, std::function<void()> testFunction) {
+    std::cout << "\n=== Running test: " << testName << " ===" << std::endl;
+    try {
+        testFunction();
+        printTestResult(testName, true);
+    } catch (const std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        printTestResult(testName, false);
+        ++failures;
+    }
+}
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        throw std::runtime_error("check failed: " + what);
+    }
+}
+
+// Expects the call to fail with an exchange error code, e.g. "-2010"
+void expectError(const std::function<void()>& call, const std::string& code, const std::string& what) {
+    try {
+        call();
+    } catch (const std::exception& e) {
+        if (std::string(e.what()).find("\"code\":" + code) == std::string::npos) {
+            throw std::runtime_error("check failed: " + what + " (got " + e.what() + ")");
+        }
+        return;
+    }
+    throw std::runtime_error("check failed: " + what + " (no error)");
+}
+
+binance::Decimal dec(const char* text) {
+    return binance::Decimal::parse(text);
+}
+
+std::map<std::string, std::string> limitParams(const char* price, const char* quantity, const char* tif = "GTC") {
+    return {{"timeInForce", tif}, {"price", price}, {"quantity", quantity}};
+}
+
+void benchmark() {
+    // Lift the order limits on both sides, so the loop measures round trips and not throttling
+    binance::SimulatorConfig config = simulatorConfig();
+    config.orderLimit10s = 1000000;
+    Exchange exchange(config);
+    exchange.api.rateLimiter().setEnabled(false);
+    const int rounds = 2000;
+
+    std::vector<double> latencies;
+    latencies.reserve(rounds);
+    for (int i = 0; i < rounds; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        exchange.api.ping();
+        latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::sort(latencies.begin(), latencies.end());
+    std::cout << "Public round trip: p50 " << latencies[rounds / 2] << " us, p99 "
+              << latencies[rounds * 99 / 100] << " us" << std::endl;
+
+    latencies.clear();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; ++i) {
+        auto placed = std::chrono::steady_clock::now();
+        binance::OrderInfo order = exchange.api.createOrderTyped("BTCUSDT", "BUY", "LIMIT",
+                                                                 limitParams("40000", "0.001"));
+        exchange.api.cancelOrderTyped("BTCUSDT", {{"orderId", std::to_string(order.orderId)}});
+        latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - placed).count());
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::sort(latencies.begin(), latencies.end());
+    std::cout << "Signed place + cancel: " << static_cast<int>(rounds / seconds) << " pairs/s, p50 "
+              << latencies[rounds / 2] << " us, p99 " << latencies[rounds * 99 / 100] << " us" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool runBenchmark = argc > 1 && std::string(argv[1]) == "--bench";
+
+    std::cout << "\n\n=======================================" << std::endl;
+    std::cout << "EXCHANGE SIMULATOR TESTS" << std::endl;
+    std::cout << "=======================================" << std::endl;
+
+    runTest("Public endpoints", []() {
+        Exchange exchange;
+        expect(exchange.api.ping() == "{}", "ping");
+        std::string ticker = exchange.api.getSymbolPriceTicker("BTCUSDT");
+        expect(ticker == "{\"symbol\":\"BTCUSDT\",\"price\":\"50000.00000000\"}", "ticker: " + ticker);
+        expectError([&]() { exchange.api.getSymbolPriceTicker("NOPEUSDT"); }, "-1121", "unknown symbol");
+
+        exchange.api.createOrder("BTCUSDT", "BUY", "LIMIT", limitParams("49000", "0.5"));
+        exchange.api.createOrder("BTCUSDT", "BUY", "LIMIT", limitParams("49000", "0.25"));
+        exchange.api.createOrder("BTCUSDT", "SELL", "LIMIT", limitParams("51000", "1"));
+        binance::DepthSnapshot book = exchange.api.getOrderBookTyped("BTCUSDT", 5);
+        expect(book.bids.size() == 1 && book.bids[0].price == dec("49000") && book.bids[0].quantity == dec("0.75"),
+               "bids aggregated per level");
+        expect(book.asks.size() == 1 && book.asks[0].price == dec("51000"), "asks");
+    });
+
+    runTest("API key and signature are verified", []() {
+        Exchange exchange;
+        binance::BinanceAPI wrongSecret(API_KEY, "not-the-secret", exchange.simulator.baseUrl());
+        expectError([&]() { wrongSecret.getOpenOrders("BTCUSDT"); }, "-1022", "bad signature");
+        binance::BinanceAPI wrongKey("not-the-key", API_SECRET, exchange.simulator.baseUrl());
+        expectError([&]() { wrongKey.getOpenOrders("BTCUSDT"); }, "-2015", "bad key");
+        expectError([&]() { exchange.api.getOpenOrders("BTCUSDT", {{"timestamp", "1000"}}); }, "-1021",
+                    "stale timestamp");
+        expect(exchange.api.getOpenOrders("BTCUSDT") == "[]", "good request");
+        expect(exchange.simulator.errorCount() == 3, "errors counted");
+    });
+
+    runTest("Market and limit orders", []() {
+        Exchange exchange;
+        binance::OrderInfo market = exchange.api.createOrderTyped("BTCUSDT", "BUY", "MARKET", {{"quantity", "0.01"}});
+        expect(market.status == binance::OrderStatus::FILLED, "market order filled");
+        expect(market.fills.size() == 1 && market.fills[0].price == dec("50000"), "filled at the market");
+        expect(market.cummulativeQuoteQty == dec("500"), "quote quantity");
+        expect(market.fills[0].commission == dec("0.00001") && market.fills[0].commissionAsset == "BTC",
+               "taker commission in the asset bought");
+
+        binance::OrderInfo quoted = exchange.api.createOrderTyped("BTCUSDT", "SELL", "MARKET",
+                                                                  {{"quoteOrderQty", "1000"}});
+        expect(quoted.executedQty == dec("0.02") && quoted.origQty == dec("0.02"), "quote-sized market order");
+
+        binance::OrderInfo resting = exchange.api.createOrderTyped("BTCUSDT", "BUY", "LIMIT",
+                                                                   limitParams("49000", "0.1"));
+        expect(resting.status == binance::OrderStatus::NEW && resting.fills.empty(), "limit below the market rests");
+        binance::OrderInfo crossing = exchange.api.createOrderTyped("BTCUSDT", "BUY", "LIMIT",
+                                                                    limitParams("50100", "0.1"));
+        expect(crossing.status == binance::OrderStatus::FILLED && crossing.fills[0].price == dec("50000"),
+               "marketable limit fills at the better market price");
+        expect(exchange.api.getOpenOrdersTyped("BTCUSDT").size() == 1, "one open order");
+
+        exchange.simulator.setPrice("BTCUSDT", dec("48500"));
+        binance::OrderInfo queried = exchange.api.queryOrderTyped(
+            "BTCUSDT", {{"orderId", std::to_string(resting.orderId)}});
+        expect(queried.status == binance::OrderStatus::FILLED && queried.cummulativeQuoteQty == dec("4900"),
+               "market move fills the resting order at its price");
+        expect(exchange.api.getAllOrdersTyped("BTCUSDT").size() == 4, "all orders");
+        expectError([&]() { exchange.api.createOrder("BTCUSDT", "BUY", "LIMIT", {{"quantity", "1"}, {"price", "1"}}); },
+                    "-1102", "missing timeInForce");
+        expectError([&]() { exchange.api.createOrder("BTCUSDT", "BUY", "LIMIT_MAKER", {{"quantity", "1"}, {"price", "49000"}}); },
+                    "-2010", "marketable LIMIT_MAKER");
+    });
+
+    runTest("Price-time priority", []() {
+        Exchange exchange;
+        long first = exchange.api.createOrderTyped("BTCUSDT", "BUY", "LIMIT", limitParams("49000", "1")).orderId;
+        long second = exchange.api.createOrderTyped("BTCUSDT", "BUY", "LIMIT", limitParams("49000", "1")).orderId;
+        long better = exchange.api.createOrderTyped("BTCUSDT", "BUY", "LIMIT", limitParams("49500", "1")).orderId;
+
+        expect(exchange.simulator.trade("BTCUSDT", dec("49000"), dec("1.5")) == dec("1.5"), "quantity traded");
+        auto status = [&](long orderId) {
+            return exchange.api.queryOrderTyped("BTCUSDT", {{"orderId", std::to_string(orderId)}});
+        };
+        expect(status(better).status == binance::OrderStatus::FILLED, "best price first");
+        binance::OrderInfo oldest = status(first);
+        expect(oldest.status == binance::OrderStatus::PARTIALLY_FILLED && oldest.executedQty == dec("0.5"),
+               "then the oldest order at the price");
+        expect(status(second).status == binance::OrderStatus::NEW, "newest untouched");
+
+        // A resting ask left below the market is taken before the market itself
+        exchange.api.createOrder("BTCUSDT", "SELL", "LIMIT", limitParams("49800", "0.3"));
+        exchange.simulator.trade("BTCUSDT", dec("50200"), dec("0"));
+        binance::OrderInfo taker = exchange.api.createOrderTyped("BTCUSDT", "BUY", "MARKET", {{"quantity", "0.5"}});
+        expect(taker.fills.size() == 2 && taker.fills[0].price == dec("49800") && taker.fills[0].qty == dec("0.3") &&
+               taker.fills[1].price == dec("50200"), "book before market");
+    });
+
+    runTest("Time in force", []() {
+        Exchange exchange;
+        exchange.api.createOrder("BTCUSDT", "SELL", "LIMIT", limitParams("50500", "0.2"));
+        exchange.api.createOrder("BTCUSDT", "SELL", "LIMIT", limitParams("50500", "0.2"));
+        exchange.simulator.trade("BTCUSDT", dec("51000"), dec("0"));
+        binance::OrderInfo fok = exchange.api.createOrderTyped("BTCUSDT", "BUY", "LIMIT", limitParams("50600", "0.5", "FOK"));
+        expect(fok.status == binance::OrderStatus::EXPIRED && fok.executedQty.isZero(), "FOK fills all or nothing");
+        expect(exchange.simulator.openOrderCount() == 2, "asks untouched");
+        binance::OrderInfo ioc = exchange.api.createOrderTyped("BTCUSDT", "BUY", "LIMIT", limitParams("50600", "0.5", "IOC"));
+        expect(ioc.status == binance::OrderStatus::EXPIRED && ioc.executedQty == dec("0.4"), "IOC remainder expires");
+        expect(exchange.simulator.openOrderCount() == 0, "asks taken");
+    });
+
+    runTest("OCO, OTO and OTOCO lists", []() {
+        Exchange exchange;
+        binance::OrderListInfo oco = binance::parseOrderListInfo(exchange.api.createOCO(
+            "BTCUSDT", "SELL", "0.1", "55000", "45000", {{"stopLimitPrice", "44900"}, {"stopLimitTimeInForce", "GTC"}}));
+        expect(oco.orders.size() == 2 && oco.listOrderStatus == binance::ListOrderStatus::EXECUTING, "OCO placed");
+        exchange.simulator.setPrice("BTCUSDT", dec("56000"));
+        binance::OrderListInfo done = exchange.api.queryOrderListTyped({{"orderListId", std::to_string(oco.orderListId)}});
+        expect(done.listOrderStatus == binance::ListOrderStatus::ALL_DONE, "OCO done");
+        binance::OrderInfo stop = exchange.api.queryOrderTyped("BTCUSDT", {{"orderId", std::to_string(oco.orders[0].orderId)}});
+        binance::OrderInfo limit = exchange.api.queryOrderTyped("BTCUSDT", {{"orderId", std::to_string(oco.orders[1].orderId)}});
+        expect(limit.status == binance::OrderStatus::FILLED && stop.status == binance::OrderStatus::EXPIRED,
+               "limit leg filled, stop leg expired");
+        expectError([&]() { exchange.api.createOCO("BTCUSDT", "SELL", "0.1", "50000", "57000"); }, "-2010",
+                    "OCO prices on the wrong sides of the market");
+
+        binance::OrderListInfo oto = exchange.api.createOrderListOTOTyped("BTCUSDT", {
+            {"workingType", "LIMIT"}, {"workingSide", "BUY"}, {"workingPrice", "55000"}, {"workingQuantity", "0.1"},
+            {"workingTimeInForce", "GTC"}, {"pendingType", "LIMIT_MAKER"}, {"pendingSide", "SELL"},
+            {"pendingPrice", "58000"}, {"pendingQuantity", "0.1"}});
+        expect(oto.orderReports.size() == 2 && oto.orderReports[1].status == binance::OrderStatus::PENDING_NEW,
+               "pending order waits");
+        exchange.simulator.setPrice("BTCUSDT", dec("54900"));
+        binance::OrderInfo pending = exchange.api.queryOrderTyped("BTCUSDT", {{"orderId", std::to_string(oto.orders[1].orderId)}});
+        expect(pending.status == binance::OrderStatus::NEW, "pending order placed once the working order fills");
+
+        binance::OrderListInfo otoco = exchange.api.createOrderListOTOCOTyped("BTCUSDT", {
+            {"workingType", "LIMIT"}, {"workingSide", "BUY"}, {"workingPrice", "54000"}, {"workingQuantity", "0.1"},
+            {"workingTimeInForce", "GTC"}, {"pendingSide", "SELL"}, {"pendingQuantity", "0.1"},
+            {"pendingAboveType", "LIMIT_MAKER"}, {"pendingAbovePrice", "60000"},
+            {"pendingBelowType", "STOP_LOSS"}, {"pendingBelowStopPrice", "50000"}});
+        expect(otoco.orders.size() == 3, "OTOCO placed");
+        exchange.simulator.setPrice("BTCUSDT", dec("53000"));
+        exchange.simulator.setPrice("BTCUSDT", dec("49000"));
+        binance::OrderInfo above = exchange.api.queryOrderTyped("BTCUSDT", {{"orderId", std::to_string(otoco.orders[2].orderId)}});
+        binance::OrderInfo below = exchange.api.queryOrderTyped("BTCUSDT", {{"orderId", std::to_string(otoco.orders[1].orderId)}});
+        expect(below.status == binance::OrderStatus::FILLED && below.isWorking, "stop leg triggered and filled");
+        expect(above.status == binance::OrderStatus::EXPIRED, "other leg expired");
+
+        binance::OrderListInfo canceled = exchange.api.cancelOrderListTyped(
+            "BTCUSDT", {{"orderListId", std::to_string(oto.orderListId)}});
+        expect(canceled.orderReports.size() == 2 && canceled.orderReports[1].status == binance::OrderStatus::CANCELED,
+               "list canceled");
+    });
+
+    runTest("Cancel and cancel-replace", []() {
+        Exchange exchange;
+        binance::OrderInfo order = exchange.api.createOrderTyped("BTCUSDT", "BUY", "LIMIT",
+                                                                 {{"timeInForce", "GTC"}, {"price", "48000"},
+                                                                  {"quantity", "0.1"}, {"newClientOrderId", "mine"}});
+        expectError([&]() {
+            exchange.api.createOrder("BTCUSDT", "BUY", "LIMIT", {{"timeInForce", "GTC"}, {"price", "48000"},
+                                                                  {"quantity", "0.1"}, {"newClientOrderId", "mine"}});
+        }, "-2010", "duplicate client order id");
+
+        binance::CancelReplaceResult replaced = exchange.api.cancelReplaceOrderTyped(
+            "BTCUSDT", "BUY", "LIMIT", "STOP_ON_FAILURE",
+            {{"cancelOrigClientOrderId", "mine"}, {"timeInForce", "GTC"}, {"price", "48500"}, {"quantity", "0.2"}});
+        expect(replaced.cancelResult && replaced.newOrderResult, "replaced");
+        expect(std::get<binance::OrderInfo>(replaced.cancelResponse).orderId == order.orderId, "old order canceled");
+        long replacement = std::get<binance::OrderInfo>(replaced.newOrderResponse).orderId;
+
+        expectError([&]() {
+            exchange.api.cancelReplaceOrder("BTCUSDT", "BUY", "LIMIT", "STOP_ON_FAILURE",
+                                            {{"cancelOrderId", std::to_string(order.orderId)}, {"timeInForce", "GTC"},
+                                             {"price", "48500"}, {"quantity", "0.2"}});
+        }, "-2022", "cancel of a canceled order stops the replace");
+
+        binance::OrderInfo canceled = exchange.api.cancelOrderTyped("BTCUSDT", {{"orderId", std::to_string(replacement)}});
+        expect(canceled.status == binance::OrderStatus::CANCELED, "canceled");
+        expectError([&]() { exchange.api.cancelOrder("BTCUSDT", {{"orderId", std::to_string(replacement)}}); },
+                    "-2011", "cancel twice");
+
+        exchange.api.createOrder("BTCUSDT", "BUY", "LIMIT", limitParams("47000", "0.1"));
+        exchange.api.createOrder("BTCUSDT", "SELL", "LIMIT", limitParams("53000", "0.1"));
+        exchange.api.cancelAllOrders("BTCUSDT");
+        expect(exchange.simulator.openOrderCount() == 0, "cancel all");
+    });
+
+    runTest("Test and SOR endpoints", []() {
+        Exchange exchange;
+        expect(exchange.api.testOrder("BTCUSDT", "BUY", "LIMIT", limitParams("50000", "0.001")) == "{}", "test order");
+        binance::TestOrderResult rates = exchange.api.testOrderTyped(
+            "BTCUSDT", "BUY", "MARKET", {{"quantity", "0.001"}, {"computeCommissionRates", "true"}});
+        expect(rates.standardCommissionForOrder && rates.standardCommissionForOrder->taker == dec("0.001"),
+               "commission rates");
+        expect(exchange.simulator.openOrderCount() == 0, "test orders are not placed");
+
+        std::string sor = exchange.api.createSOROrder("BTCUSDT", "BUY", "MARKET", {{"quantity", "0.001"}});
+        binance::OrderInfo order = binance::parseOrderInfo(sor);
+        expect(order.status == binance::OrderStatus::FILLED && order.usedSor && *order.usedSor, "SOR order");
+        expectError([&]() { exchange.api.testSOROrder("BTCUSDT", "BUY", "STOP_LOSS", {{"quantity", "1"}, {"stopPrice", "1"}}); },
+                    "-1116", "SOR takes LIMIT and MARKET only");
+    });
+
+    runTest("Non-throwing requests", []() {
+        Exchange exchange;
+        binance::Response response;
+
+        binance::RequestBuilder placed;
+        placed.add("timeInForce", "GTC").add("price", "49000").add("quantity", "0.01");
+        expect(exchange.api.tryCreateOrder("BTCUSDT", "BUY", "LIMIT", placed, response), "order placed");
+        expect(response.status == 200 && response.code == 0 && response.message().empty(), "success fields");
+        expect(response.headers.usageCount > 0, "usage headers kept");
+        binance::OrderInfo order = binance::parseOrderInfo(response.body);
+        expect(order.status == binance::OrderStatus::NEW, "body parsed");
+
+        const char* bufferBefore = response.body.data();
+        binance::RequestBuilder maker;
+        maker.add("price", "51000").add("quantity", "0.01");
+        expect(!exchange.api.tryCreateOrder("BTCUSDT", "BUY", "LIMIT_MAKER", maker, response), "maker rejected");
+        expect(response.status == 400 && response.code == -2010, "reject code");
+        expect(response.message() == "Order would immediately match and take.", "reject message");
+        expect(response.body.data() == bufferBefore, "body buffer reused");
+
+        binance::RequestBuilder cancel;
+        cancel.add("orderId", order.orderId);
+        expect(exchange.api.tryCancelOrder("BTCUSDT", cancel, response), "canceled");
+        binance::RequestBuilder again;
+        again.add("orderId", order.orderId);
+        expect(!exchange.api.tryCancelOrder("BTCUSDT", again, response) && response.code == -2011, "unknown order");
+
+        binance::RequestBuilder query;
+        query.add("orderId", order.orderId);
+        expect(exchange.api.tryQueryOrder("BTCUSDT", query, response) &&
+               binance::parseOrderInfo(response.body).status == binance::OrderStatus::CANCELED, "query");
+
+        binance::RequestBuilder test;
+        test.add("quantity", "0.001");
+        expect(exchange.api.tryTestOrder("BTCUSDT", "BUY", "MARKET", test, response) && response.body == "{}", "test");
+
+        binance::RequestBuilder replace;
+        replace.add("cancelOrderId", order.orderId).add("quantity", "0.001");
+        expect(!exchange.api.tryCancelReplaceOrder("BTCUSDT", "BUY", "MARKET", "STOP_ON_FAILURE", replace, response),
+               "replace of a canceled order fails");
+        expect(response.status == 400 && response.code == -2022, "cancel-replace failure code");
+
+        uint16_t port = exchange.simulator.port();
+        exchange.simulator.stop();
+        binance::BinanceAPI offline(API_KEY, API_SECRET, "http://127.0.0.1:" + std::to_string(port));
+        binance::RequestBuilder unreachable;
+        unreachable.add("quantity", "0.001");
+        expect(!offline.tryCreateOrder("BTCUSDT", "BUY", "MARKET", unreachable, response), "transport failure");
+        expect(response.status == 0 && response.transportError != nullptr, "transport error reported");
+    });
+
+    runTest("Asynchronous requests", []() {
+        Exchange exchange;
+        binance::BinanceAPI& api = exchange.api;
+
+        // Blocking calls from another thread while the event loop is busy
+        std::atomic<bool> done{false};
+        std::atomic<int> pings{0};
+        std::thread blocking([&]() {
+            do {
+                api.ping();
+                ++pings;
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            } while (!done);
+        });
+
+        const int burst = 20;
+        std::vector<std::future<std::string>> placed;
+        for (int i = 0; i < burst; ++i) {
+            placed.push_back(api.createOrderAsync("BTCUSDT", "BUY", "LIMIT",
+                                                  limitParams(std::to_string(40000 + i).c_str(), "0.001")));
+        }
+        std::future<std::string> rejected = api.createOrderAsync("BTCUSDT", "BUY", "LIMIT_MAKER",
+                                                                 {{"price", "51000"}, {"quantity", "0.001"}});
+
+        std::vector<std::future<std::string>> canceled;
+        for (auto& future : placed) {
+            expect(future.wait_for(std::chrono::seconds(5)) == std::future_status::ready, "order resolved");
+            binance::OrderInfo order = binance::parseOrderInfo(future.get());
+            expect(order.status == binance::OrderStatus::NEW, "order placed");
+            canceled.push_back(api.cancelOrderAsync("BTCUSDT", {{"orderId", std::to_string(order.orderId)}}));
+        }
+        expectError([&]() { rejected.get(); }, "-2010", "reject rethrown by get()");
+        for (auto& future : canceled) {
+            expect(future.wait_for(std::chrono::seconds(5)) == std::future_status::ready, "cancel resolved");
+            expect(binance::parseOrderInfo(future.get()).status == binance::OrderStatus::CANCELED, "order canceled");
+        }
+        expectError([&]() { api.cancelOrderAsync("BTCUSDT", {{"orderId", "999999"}}).get(); }, "-2011",
+                    "cancel reject rethrown by get()");
+
+        done = true;
+        blocking.join();
+        expect(pings > 0, "blocking requests served alongside the event loop");
+        expect(api.getOpenOrdersTyped("BTCUSDT").empty(), "nothing left open");
+
+        // The raw client's GET, POST and DELETE
+        binance::HttpClient http;
+        expect(http.init(2), "client initialized");
+        std::string base = exchange.simulator.baseUrl();
+        std::map<std::string, std::string> apiKey = {{"X-MBX-APIKEY", API_KEY}};
+        std::future<std::string> ping = http.getAsync(base + "/api/v3/ping");
+        std::future<std::string> opened = http.postAsync(base + "/api/v3/userDataStream", "", apiKey);
+        std::future<std::string> missing = http.getAsync(base + "/api/v3/nothing");
+        expect(ping.get() == "{}", "GET");
+        std::string body = opened.get();
+        size_t key = body.find("\"listenKey\":\"");
+        expect(key != std::string::npos, "POST");
+        std::string listenKey = body.substr(key + 13, body.find('"', key + 13) - key - 13);
+        expect(http.delAsync(base + "/api/v3/userDataStream?listenKey=" + listenKey, apiKey).get() == "{}", "DELETE");
+        expectError([&]() { missing.get(); }, "-1", "HTTP error rethrown by get()");
+    });
+
+    runTest("Shutdown fails requests in flight", []() {
+        binance::SimulatorConfig config = simulatorConfig();
+        config.latencyMicros = 1000000;  // Still waiting for the response when the client goes
+        Exchange exchange(config);
+        std::string ping = exchange.simulator.baseUrl() + "/api/v3/ping";
+
+        std::future<std::string> inFlight;
+        bool failed = false;
+        bool refused = false;
+        {
+            binance::HttpClient http;
+            expect(http.init(1), "client initialized");
+            // The hook runs during shutdown and sends another request on the same client
+            inFlight = http.requestAsync(binance::HttpMethod::GET, ping, "", [&](bool ok, std::string_view) {
+                failed = !ok;
+                try {
+                    http.requestAsync(binance::HttpMethod::GET, ping, "", nullptr);
+                } catch (const std::runtime_error&) {
+                    refused = true;
+                }
+            });
+        }
+        expect(inFlight.wait_for(std::chrono::seconds(0)) == std::future_status::ready, "failed before the client went");
+        bool threw = false;
+        try {
+            inFlight.get();
+        } catch (const std::exception&) {
+            threw = true;
+        }
+        expect(threw && failed, "request failed by the shutdown");
+        expect(refused, "request from the hook refused instead of deadlocking");
+    });
+
+    runTest("Rate-limit headers and 429", []() {
+        binance::SimulatorConfig config = simulatorConfig();
+        config.weightLimit = 20;
+        Exchange exchange(config);
+        exchange.api.getOpenOrders("BTCUSDT");
+        exchange.api.createOrder("BTCUSDT", "BUY", "LIMIT", limitParams("49000", "0.1"));
+        binance::RateLimiter& limiter = exchange.api.rateLimiter();
+        expect(limiter.used(binance::RateLimitType::REQUEST_WEIGHT, 60) == 7, "weight reported");
+        expect(limiter.used(binance::RateLimitType::ORDERS, 10) == 1, "orders reported");
+        expectError([&]() { exchange.api.getAllOrders("BTCUSDT"); }, "-1003", "weight limit exceeded");
+    });
+
+    runTest("Injected latency and jitter", []() {
+        binance::SimulatorConfig config = simulatorConfig();
+        config.latencyMicros = 20000;
+        config.jitterMicros = 10000;
+        Exchange exchange(config);
+        exchange.api.ping();
+        for (int i = 0; i < 3; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            exchange.api.ping();
+            double millis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            expect(millis >= 20 && millis < 200, "delay within latency and jitter");
+        }
+    });
+
+    runTest("Per-endpoint HTTP metrics", []() {
+        binance::SimulatorConfig config = simulatorConfig();
+        config.latencyMicros = 5000;
+        Exchange exchange(config);
+        for (int i = 0; i < 3; ++i) {
+            exchange.api.ping();
+        }
+        exchange.api.createOrder("BTCUSDT", "BUY", "MARKET", {{"quantity", "0.001"}});
+        expectError([&]() { exchange.api.createOrder("BTCUSDT", "BUY", "MARKET", {}); }, "-1102", "rejected order");
+
+        auto find = [](const std::vector<binance::EndpointMetrics>& metrics, binance::HttpMethod method,
+                       const std::string& path) {
+            for (const auto& endpoint : metrics) {
+                if (endpoint.method == method && endpoint.path == path) {
+                    return endpoint;
+                }
+            }
+            throw std::runtime_error("no metrics for " + path);
+        };
+        auto phase = [](const binance::EndpointMetrics& endpoint, binance::HttpPhase phase) {
+            return endpoint.phases[static_cast<size_t>(phase)];
+        };
+
+        std::vector<binance::EndpointMetrics> metrics = exchange.api.httpMetrics();
+        expect(metrics.size() == 2, "one entry per method and path");
+        binance::EndpointMetrics ping = find(metrics, binance::HttpMethod::GET, "/api/v3/ping");
+        expect(ping.requests == 3 && ping.failures == 0, "ping counted");
+        expect(phase(ping, binance::HttpPhase::TOTAL).count == 3, "every ping timed");
+        expect(phase(ping, binance::HttpPhase::FIRST_BYTE).p50 >= 5000, "server latency lands in first byte");
+        expect(phase(ping, binance::HttpPhase::TOTAL).max >= phase(ping, binance::HttpPhase::FIRST_BYTE).max,
+               "total covers first byte");
+        expect(phase(ping, binance::HttpPhase::TLS).count == 0, "no TLS over plain HTTP");
+
+        binance::EndpointMetrics order = find(metrics, binance::HttpMethod::POST, "/api/v3/order");
+        expect(order.requests == 2 && order.failures == 1, "rejects counted as failures");
+        expect(order.bytesSent > 100 && order.bytesReceived > 100, "bytes counted");
+
+        uint64_t opened = phase(ping, binance::HttpPhase::CONNECT).count + phase(order, binance::HttpPhase::CONNECT).count;
+        expect(opened >= 1 && opened + ping.reusedConnections + order.reusedConnections == 5,
+               "every request opened or reused a connection");
+
+        exchange.api.httpMetrics(true);
+        for (const auto& endpoint : exchange.api.httpMetrics()) {
+            expect(endpoint.requests == 0 && phase(endpoint, binance::HttpPhase::TOTAL).count == 0, "reset");
+        }
+    });
+
+    if (runBenchmark) {
+        std::cout << "\n=== Benchmark ===" << std::endl;
+        benchmark();
+    }
+
+    std::cout << "\n=======================================" << std::endl;
+    std::cout << (failures == 0 ? "ALL TESTS PASSED" : "SOME TESTS FAILED") << std::endl;
+    std::cout << "=======================================" << std::endl;
+
+    return failures == 0 ? 0 : 1;
+}
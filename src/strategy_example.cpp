@@ -1,146 +1,195 @@
+#include "../include/Backtester.h"
 #include "../include/BinanceAPI.h"
 #include "../include/BinanceTypes.h"
+#include "../include/HistoryFile.h"
+#include "../include/Indicators.h"
+#include "../include/MarketDataStream.h"
+#include "../include/OrderGateway.h"
+#include "../include/StrategyRuntime.h"
 #include <iostream>
 #include <string>
-#include <map>
-#include <vector>
-#include <chrono>
-#include <thread>
-#include <cmath>
 #include <iomanip>
+#include <memory>
+#include <vector>
 
-// Simple moving average calculator
-class SMA {
+// Trading strategy class, driven by closed one-minute candles
+class SimpleCrossoverStrategy : public binance::Strategy {
 private:
-    std::vector<double> prices;
-    size_t period;
+    std::string symbol;
+    binance::Decimal quantity;
+    
+    binance::SMA fastSMA;
+    binance::SMA slowSMA;
+    
+    bool inPosition;
+    bool orderPending;
+    bool verbose;
     
 public:
-    SMA(size_t p) : period(p) {}
+    SimpleCrossoverStrategy(const std::string& symbol, binance::Decimal quantity,
+                           size_t fastPeriod = 10, size_t slowPeriod = 20, bool verbose = true)
+        : symbol(symbol), quantity(quantity),
+          fastSMA(fastPeriod), slowSMA(slowPeriod), inPosition(false), orderPending(false),
+          verbose(verbose) {}
     
-    void addPrice(double price) {
-        prices.push_back(price);
-        if (prices.size() > period) {
-            prices.erase(prices.begin());
+    void onKline(const binance::KlineEvent& kline) override {
+        if (kline.closed && kline.symbol == symbol) {
+            update(kline.close.toDouble());
         }
     }
     
-    double getValue() const {
-        if (prices.size() < period) return 0;
-        double sum = 0;
-        for (double price : prices) {
-            sum += price;
+    void onOrderUpdate(const binance::OrderUpdateEvent& order) override {
+        if (order.status == binance::OrderStatus::NEW ||
+            order.status == binance::OrderStatus::PARTIALLY_FILLED) {
+            return;
         }
-        return sum / prices.size();
-    }
-    
-    bool isReady() const {
-        return prices.size() >= period;
+        orderPending = false;
+        if (order.status == binance::OrderStatus::FILLED) {
+            inPosition = order.side == binance::OrderSide::BUY;
+        }
+        if (!verbose) {
+            return;
+        }
+        std::cout << binance::toString(order.side) << " order " << order.clientOrderId.view()
+                  << ": " << binance::toString(order.status);
+        if (order.errorCode != 0) {
+            std::cout << " (error " << order.errorCode << ")";
+        }
+        std::cout << std::endl;
     }
-};
-
-// Trading strategy class
-class SimpleCrossoverStrategy {
-private:
-    binance::BinanceAPI& api;
-    std::string symbol;
-    double quantity;
     
-    SMA fastSMA;
-    SMA slowSMA;
-    
-    bool inPosition;
-    std::string currentOrderId;
-    
-    double extractPrice(const std::string& response) {
-        size_t pos = response.find("\"price\":\"");
-        if (pos != std::string::npos) {
-            pos += 9;  // length of "\"price\":\""
-            size_t endPos = response.find("\"", pos);
-            if (endPos != std::string::npos) {
-                return std::stod(response.substr(pos, endPos - pos));
-            }
+    void onTimer(binance::TimerId) override {
+        if (!verbose) {
+            return;
         }
-        throw std::runtime_error("Could not extract price from response");
+        std::cout << "Heartbeat: " << (inPosition ? "in position" : "flat") << std::endl;
     }
     
-public:
-    SimpleCrossoverStrategy(binance::BinanceAPI& api, const std::string& symbol, 
-                           double quantity, size_t fastPeriod = 10, size_t slowPeriod = 20)
-        : api(api), symbol(symbol), quantity(quantity),
-          fastSMA(fastPeriod), slowSMA(slowPeriod), inPosition(false) {}
+    void onStart() override {
+        scheduleTimer(60000000, 60000000);  // Heartbeat every minute
+    }
     
-    void update() {
-        try {
-            // Get current price
-            std::map<std::string, std::string> params;
-            params["symbol"] = symbol;
-            
-            // In a real implementation, you would use the proper endpoint
-            // Here we're using a test response
-            std::string response = api.getOpenOrders(symbol, params);
-            double currentPrice = 50000.00; // Using a test price
-            
-            // Update moving averages
-            fastSMA.addPrice(currentPrice);
-            slowSMA.addPrice(currentPrice);
-            
-            if (!fastSMA.isReady() || !slowSMA.isReady()) {
+private:
+    void update(double currentPrice) {
+        // Update moving averages
+        fastSMA.update(currentPrice);
+        slowSMA.update(currentPrice);
+        
+        if (!fastSMA.isReady() || !slowSMA.isReady()) {
+            if (verbose) {
                 std::cout << "Collecting data... " 
-                         << "Fast SMA: " << fastSMA.getValue() 
-                         << " Slow SMA: " << slowSMA.getValue() << std::endl;
-                return;
+                         << "Fast SMA: " << fastSMA.value() 
+                         << " Slow SMA: " << slowSMA.value() << std::endl;
             }
-            
-            double fastValue = fastSMA.getValue();
-            double slowValue = slowSMA.getValue();
-            
+            return;
+        }
+        
+        double fastValue = fastSMA.value();
+        double slowValue = slowSMA.value();
+        
+        if (verbose) {
             std::cout << std::fixed << std::setprecision(2)
                      << "Price: " << currentPrice 
                      << " Fast SMA: " << fastValue 
                      << " Slow SMA: " << slowValue << std::endl;
+        }
+        
+        if (orderPending) {
+            return;
+        }
+        
+        // Trading logic
+        if ((fastValue > slowValue && !inPosition) || (fastValue < slowValue && inPosition)) {
+            binance::OrderParams order;
+            order.symbol = symbol;
+            order.side = inPosition ? binance::OrderSide::SELL : binance::OrderSide::BUY;
+            order.type = binance::OrderType::MARKET;
+            order.quantity = quantity;
             
-            // Trading logic
-            if (fastValue > slowValue && !inPosition) {
-                // Buy signal
-                std::map<std::string, std::string> orderParams;
-                orderParams["quantity"] = std::to_string(quantity);
-                
-                std::string response = api.createOrder(
-                    symbol,
-                    "BUY",
-                    "MARKET",
-                    orderParams
-                );
-                
-                std::cout << "BUY signal! Order response: " << response << std::endl;
-                inPosition = true;
-                
-            } else if (fastValue < slowValue && inPosition) {
-                // Sell signal
-                std::map<std::string, std::string> orderParams;
-                orderParams["quantity"] = std::to_string(quantity);
-                
-                std::string response = api.createOrder(
-                    symbol,
-                    "SELL",
-                    "MARKET",
-                    orderParams
-                );
-                
-                std::cout << "SELL signal! Order response: " << response << std::endl;
-                inPosition = false;
+            try {
+                // Returns as soon as the order is signed; the fill arrives in onOrderUpdate
+                std::string clientOrderId = orders().placeOrder(order);
+                if (verbose) {
+                    std::cout << binance::toString(order.side) << " signal! Sent order " << clientOrderId << std::endl;
+                }
+                orderPending = true;
+            } catch (const std::exception& e) {
+                std::cerr << "Error in strategy update: " << e.what() << std::endl;
             }
-            
-        } catch (const std::exception& e) {
-            std::cerr << "Error in strategy update: " << e.what() << std::endl;
         }
     }
 };
 
+void printResult(const binance::BacktestResult& result) {
+    std::cout << std::fixed << std::setprecision(2)
+              << "Fills: " << result.fills
+              << " Fees: " << result.fees.toDouble()
+              << " PnL: " << result.pnl
+              << " Max drawdown: " << result.maxDrawdown << std::endl;
+}
+
+// Replay historical klines through the strategy instead of trading live
+int runBacktest(const std::string& path, bool sweep) {
+    std::string historyPath = path;
+    if (path.size() > 4 && path.compare(path.size() - 4, 4, ".csv") == 0) {
+        // Convert a data.binance.vision CSV once; later runs can use the .bin directly
+        std::vector<binance::KlineEvent> klines = binance::HistoryFile::readKlineCsv(path);
+        historyPath = path.substr(0, path.size() - 4) + ".bin";
+        binance::HistoryFile::writeKlines(historyPath, "BTCUSDT", "1m", klines);
+        std::cout << "Converted " << klines.size() << " klines to " << historyPath << std::endl;
+    }
+    
+    binance::HistoryFile history(historyPath);
+    std::string symbol = history.symbol();
+    binance::Decimal quantity = binance::Decimal::parse("0.001");
+    binance::BacktestConfig config;
+    config.latencyMicros = 50000;                    // 50 ms to the exchange
+    config.takerFee = binance::Decimal::parse("0.001");
+    config.makerFee = binance::Decimal::parse("0.001");
+    
+    if (!sweep) {
+        SimpleCrossoverStrategy strategy(symbol, quantity);
+        binance::BacktestResult result = binance::Backtester(history, config).run(strategy);
+        std::cout << "Replayed " << result.events << " events in " << result.seconds << " s" << std::endl;
+        printResult(result);
+        return 0;
+    }
+    
+    // Every fast/slow pair, run in parallel over the same mapped file
+    std::vector<std::pair<size_t, size_t>> periods;
+    for (size_t fast = 5; fast <= 30; fast += 5) {
+        for (size_t slow = fast + 10; slow <= 100; slow += 10) {
+            periods.emplace_back(fast, slow);
+        }
+    }
+    std::vector<binance::BacktestResult> results = binance::Backtester::sweep(
+        history, periods.size(),
+        [&](size_t index) {
+            return std::make_unique<SimpleCrossoverStrategy>(symbol, quantity, periods[index].first,
+                                                             periods[index].second, false);
+        },
+        config);
+    for (size_t i = 0; i < results.size(); ++i) {
+        std::cout << "Fast " << std::setw(3) << periods[i].first << " Slow " << std::setw(3) << periods[i].second
+                  << "  ";
+        printResult(results[i]);
+    }
+    return 0;
+}
+
 int main(int argc, char** argv) {
+    if (argc >= 3 && std::string(argv[1]) == "--backtest") {
+        try {
+            return runBacktest(argv[2], argc > 3 && std::string(argv[3]) == "--sweep");
+        } catch (const std::exception& e) {
+            std::cerr << "Backtest failed: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+    
     if (argc < 3) {
         std::cerr << "Usage: " << argv[0] << " <api_key> <api_secret>" << std::endl;
+        std::cerr << "       " << argv[0] << " --backtest <klines.bin|klines.csv> [--sweep]" << std::endl;
         return 1;
     }
     
@@ -151,24 +200,30 @@ int main(int argc, char** argv) {
             argv[2],
             "https://testnet.binance.vision"
         );
+        binance::RestOrderGateway gateway(api);
         
         // Create strategy instance
         SimpleCrossoverStrategy strategy(
-            api,
-            "BTCUSDT",    // trading pair
-            0.001         // trading quantity
+            "BTCUSDT",                            // trading pair
+            binance::Decimal::parse("0.001")      // trading quantity
         );
         
+        // One-minute candles arrive on the stream's I/O thread and are
+        // handed to the strategy thread through a lock-free queue
+        binance::MarketDataStream stream("wss://stream.testnet.binance.vision");
+        stream.subscribe({binance::MarketDataStream::klineStream("BTCUSDT", "1m")});
+        
+        binance::StrategyRuntime runtime;
+        runtime.addStrategy(strategy);
+        runtime.addMarketData(stream.addConsumer());
+        runtime.setOrderGateway(gateway);
+        stream.start();
+        
         std::cout << "Starting Simple SMA Crossover Strategy..." << std::endl;
         std::cout << "Press Ctrl+C to exit" << std::endl;
         
-        // Main loop
-        while (true) {
-            strategy.update();
-            
-            // Sleep for 5 seconds between updates
-            std::this_thread::sleep_for(std::chrono::seconds(5));
-        }
+        // Dispatch events until the process is stopped
+        runtime.run();
         
     } catch (const std::exception& e) {
         std::cerr << "Fatal error: " << e.what() << std::endl;
@@ -0,0 +1,489 @@
+#include "../include/StrategyRuntime.h"
+#include "../include/OrderBook.h"
+#include "../include/OrderGateway.h"
+#include "../include/RiskEngine.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+
+namespace {
+
+int failures = 0;
+
+void printTestResult(const std::string& testName, bool success) {
+    std::cout << std::left << std::setw(50) << testName << " : "
+              << (success ? "PASSED" : "FAILED") << std::endl;
+}
+
+void runTest(const std::string& testName, std::function<void()> testFunction) {
+    std::cout << "\n=== Running test: " << testName << " ===" << std::endl;
+    try {
+        testFunction();
+        printTestResult(testName, true);
+    } catch (const std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        printTestResult(testName, false);
+        ++failures;
+    }
+}
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        throw std::runtime_error("check failed: " + what);
+    }
+}
+
+using binance::Decimal;
+using binance::MarketEvent;
+using binance::MarketEventQueue;
+using binance::OrderUpdateEvent;
+using binance::StrategyRuntime;
+
+// Wait for a condition while the runtime works on another thread
+void waitFor(const std::function<bool()>& done, const std::string& what) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            throw std::runtime_error("timed out waiting for " + what);
+        }
+        std::this_thread::yield();
+    }
+}
+
+MarketEvent trade(const char* symbol, int64_t id, const char* price) {
+    binance::TradeEvent event;
+    event.symbol.assign(symbol);
+    event.tradeId = id;
+    event.price = Decimal::parse(price);
+    event.quantity = Decimal::parse("1");
+    return event;
+}
+
+// Fills every order in full on the next poll
+class InstantGateway : public binance::OrderGateway {
+public:
+    std::string placeOrder(const binance::OrderParams& order) override {
+        OrderUpdateEvent update;
+        std::string id = "test-" + std::to_string(++sequence);
+        update.symbol.assign(order.symbol);
+        update.clientOrderId.assign(id);
+        update.orderId = static_cast<int64_t>(sequence);
+        update.side = order.side;
+        update.type = order.type;
+        update.status = binance::OrderStatus::FILLED;
+        update.quantity = update.executedQty = order.quantity.value_or(Decimal());
+        ready.push_back(update);
+        return id;
+    }
+
+    void cancelOrder(const std::string&, const std::string&) override {}
+
+    size_t poll(const std::function<void(const OrderUpdateEvent&)>& sink) override {
+        std::vector<OrderUpdateEvent> updates;
+        updates.swap(ready);
+        for (const OrderUpdateEvent& update : updates) {
+            sink(update);
+        }
+        return updates.size();
+    }
+
+private:
+    uint64_t sequence = 0;
+    std::vector<OrderUpdateEvent> ready;
+};
+
+// Records what it sees; buys once on the first BTCUSDT trade
+class RecordingStrategy : public binance::Strategy {
+public:
+    std::atomic<int> started{0};
+    std::atomic<int> stopped{0};
+    std::vector<int64_t> tradeIds;
+    std::vector<std::string> orderIds;
+    std::atomic<int> trades{0};
+    std::atomic<int> klines{0};
+    std::atomic<int> bookUpdates{0};
+    std::atomic<int> orderUpdates{0};
+    Decimal bestBid;
+
+    void onStart() override { ++started; }
+    void onStop() override { ++stopped; }
+
+    void onTrade(const binance::TradeEvent& event) override {
+        tradeIds.push_back(event.tradeId);
+        if (event.symbol == "BTCUSDT" && tradeIds.size() == 1) {
+            binance::OrderParams order;
+            order.symbol = "BTCUSDT";
+            order.side = binance::OrderSide::BUY;
+            order.type = binance::OrderType::MARKET;
+            order.quantity = Decimal::parse("0.5");
+            orderIds.push_back(orders().placeOrder(order));
+        }
+        if (event.tradeId < 0) {
+            throw std::runtime_error("bad trade");
+        }
+        ++trades;
+    }
+
+    void onKline(const binance::KlineEvent&) override { ++klines; }
+
+    void onBookUpdate(const binance::OrderBook& book) override {
+        bestBid = book.bestBid().price;
+        ++bookUpdates;
+    }
+
+    void onOrderUpdate(const OrderUpdateEvent& update) override {
+        orderIds.push_back(std::string(update.clientOrderId.view()) + ":" + binance::toString(update.status));
+        ++orderUpdates;
+    }
+};
+
+// Records when each timer fires; stops the runtime on the last periodic tick
+class TimerStrategy : public binance::Strategy {
+public:
+    static constexpr int TICKS = 5;
+    static constexpr int64_t PERIOD = 1000;
+    static constexpr int64_t ONE_SHOT_DELAY = 3000;
+
+    explicit TimerStrategy(StrategyRuntime& runtime) : runtime(runtime) {}
+
+    std::vector<int64_t> periodicAt;
+    std::vector<int64_t> oneShotAt;
+    int cancelledCalls = 0;
+    int64_t startedAt = 0;
+
+    void onStart() override {
+        startedAt = now();
+        periodic = scheduleTimer(PERIOD, PERIOD);
+        cancelled = scheduleTimer(2000);
+        cancelTimer(cancelled);
+        oneShot = scheduleTimer(ONE_SHOT_DELAY);
+    }
+
+    void onTimer(binance::TimerId id) override {
+        if (id == periodic) {
+            periodicAt.push_back(now());
+            if (periodicAt.size() == TICKS) {
+                cancelTimer(periodic);
+                runtime.stop();
+            }
+        }
+        if (id == cancelled) ++cancelledCalls;
+        if (id == oneShot) oneShotAt.push_back(now());
+    }
+
+private:
+    StrategyRuntime& runtime;
+    binance::TimerId periodic = 0;
+    binance::TimerId cancelled = 0;
+    binance::TimerId oneShot = 0;
+};
+
+// Holds orders until released, then fills the odd ones and cancels the even ones
+class ClosingGateway : public binance::OrderGateway {
+public:
+    std::atomic<bool> released{false};
+
+    std::string placeOrder(const binance::OrderParams& order) override {
+        OrderUpdateEvent update;
+        std::string id = "risk-" + std::to_string(++sequence);
+        update.symbol.assign(order.symbol);
+        update.clientOrderId.assign(id);
+        update.orderId = static_cast<int64_t>(sequence);
+        update.side = order.side;
+        update.type = order.type;
+        update.price = order.price.value_or(Decimal());
+        update.quantity = order.quantity.value_or(Decimal());
+        if (sequence % 2) {
+            update.status = binance::OrderStatus::FILLED;
+            update.executedQty = update.quantity;
+            update.cumulativeQuoteQty = update.price * update.quantity;
+        } else {
+            update.status = binance::OrderStatus::CANCELED;
+        }
+        held.push_back(update);
+        return id;
+    }
+
+    void cancelOrder(const std::string&, const std::string&) override {}
+
+    size_t poll(const std::function<void(const OrderUpdateEvent&)>& sink) override {
+        if (!released.load(std::memory_order_acquire)) {
+            return 0;
+        }
+        std::vector<OrderUpdateEvent> updates;
+        updates.swap(held);
+        for (const OrderUpdateEvent& update : updates) {
+            sink(update);
+        }
+        return updates.size();
+    }
+
+private:
+    uint64_t sequence = 0;
+    std::vector<OrderUpdateEvent> held;
+};
+
+// Buys 0.1 at the price of every trade that the risk engine lets through
+class RiskCheckedStrategy : public binance::Strategy {
+public:
+    explicit RiskCheckedStrategy(binance::RiskEngine& risk) : risk(risk) {}
+
+    std::atomic<int> trades{0};
+    std::atomic<int> placed{0};
+    std::atomic<int> rejected{0};
+
+    void onTrade(const binance::TradeEvent& event) override {
+        binance::SymbolId id = risk.registry().find(event.symbol.view());
+        Decimal quantity = Decimal::parse("0.1");
+        if (risk.reserve(id, binance::OrderSide::BUY, binance::OrderType::LIMIT, event.price, quantity) ==
+            binance::RiskResult::OK) {
+            binance::OrderParams order;
+            order.symbol = "BTCUSDT";
+            order.side = binance::OrderSide::BUY;
+            order.type = binance::OrderType::LIMIT;
+            order.price = event.price;
+            order.quantity = quantity;
+            orders().placeOrder(order);
+            ++placed;
+        } else {
+            ++rejected;
+        }
+        ++trades;
+    }
+
+private:
+    binance::RiskEngine& risk;
+};
+
+void benchmark() {
+    // Time from pushing an event to the strategy seeing it, with the loop spinning
+    class LatencyStrategy : public binance::Strategy {
+    public:
+        std::vector<int64_t> samples;
+        std::atomic<int> seen{0};
+        void onTrade(const binance::TradeEvent& event) override {
+            samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count() - event.eventTime);
+            seen.store(seen.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+    };
+
+    const int iterations = 20000;
+    LatencyStrategy strategy;
+    strategy.samples.reserve(iterations);
+    auto queue = std::make_shared<MarketEventQueue>(1024);
+    StrategyRuntime runtime;
+    runtime.addStrategy(strategy);
+    runtime.addMarketData(queue);
+    bool spare = std::thread::hardware_concurrency() > 1;
+    runtime.setIdleMode(spare ? binance::IdleMode::SPIN : binance::IdleMode::YIELD);
+    runtime.start();
+
+    MarketEvent event = trade("BTCUSDT", 1, "100");
+    for (int i = 0; i < iterations; ++i) {
+        std::get<binance::TradeEvent>(event).eventTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        while (!queue->tryPush(event)) std::this_thread::yield();
+        while (strategy.seen.load(std::memory_order_acquire) <= i) {
+            if (!spare) std::this_thread::yield();
+        }
+    }
+    runtime.stop();
+
+    std::sort(strategy.samples.begin(), strategy.samples.end());
+    auto percentile = [&](double p) {
+        return strategy.samples[static_cast<size_t>(p * (strategy.samples.size() - 1))] / 1000.0;
+    };
+    std::cout << "  Queue to onTrade (" << (spare ? "spinning" : "yielding, single CPU") << "): p50 "
+              << std::fixed << std::setprecision(2) << percentile(0.5) << " us, p99 " << percentile(0.99)
+              << " us" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool runBenchmark = argc > 1 && std::string(argv[1]) == "--bench";
+
+    std::cout << "\n\n=======================================" << std::endl;
+    std::cout << "STRATEGY RUNTIME TESTS" << std::endl;
+    std::cout << "=======================================" << std::endl;
+
+    runTest("Market data, order gateway and order book", []() {
+        RecordingStrategy strategy;
+        InstantGateway gateway;
+        auto trades = std::make_shared<MarketEventQueue>(64);
+        auto klines = std::make_shared<MarketEventQueue>(64);
+        auto userData = std::make_shared<binance::OrderUpdateQueue>(16);
+
+        StrategyRuntime runtime;
+        runtime.addStrategy(strategy);
+        runtime.addMarketData(trades);
+        runtime.addMarketData(klines);
+        runtime.addOrderUpdates(userData);
+        runtime.setOrderGateway(gateway);
+        binance::OrderBook& book = runtime.trackOrderBook("BTCUSDT", Decimal::parse("0.01"), []() {
+            binance::DepthSnapshot snapshot;
+            snapshot.lastUpdateId = 10;
+            snapshot.bids = {{Decimal::parse("99.00"), Decimal::parse("1")}};
+            return snapshot;
+        });
+
+        for (int64_t id = 1; id <= 20; ++id) {
+            trades->tryPush(trade(id % 2 ? "BTCUSDT" : "ETHUSDT", id, "100"));
+        }
+        trades->tryPush(trade("BTCUSDT", -1, "100"));  // The strategy throws on this one
+        klines->tryPush(binance::KlineEvent());
+
+        binance::DepthUpdateEvent depth;
+        depth.symbol.assign("BTCUSDT");
+        depth.firstUpdateId = 9;
+        depth.finalUpdateId = 11;
+        depth.bids[depth.bidCount++] = {Decimal::parse("99.50"), Decimal::parse("2")};
+        klines->tryPush(depth);
+        depth.symbol.assign("ETHUSDT");
+        klines->tryPush(depth);  // Not tracked
+
+        OrderUpdateEvent fromStream;
+        fromStream.clientOrderId.assign("stream-1");
+        fromStream.status = binance::OrderStatus::CANCELED;
+        userData->tryPush(fromStream);
+
+        runtime.start();
+        expect(runtime.isRunning(), "running");
+        waitFor([&]() {
+            return strategy.trades == 20 && strategy.klines == 1 && strategy.bookUpdates == 1 &&
+                   strategy.orderUpdates == 2;
+        }, "events");
+        waitFor([&]() { return runtime.callbackErrors() == 1; }, "the callback error");
+        runtime.stop();
+        expect(!runtime.isRunning(), "stopped");
+
+        expect(strategy.started == 1 && strategy.stopped == 1, "start and stop callbacks");
+        for (int64_t id = 1; id <= 20; ++id) {
+            expect(strategy.tradeIds[static_cast<size_t>(id - 1)] == id, "trades in queue order");
+        }
+        expect(runtime.eventsDispatched() == 26, "events counted");
+        expect(book.isSynced() && book.lastUpdateId() == 11, "book synced from the source");
+        expect(strategy.bestBid == Decimal::parse("99.50"), "strategy saw the updated book");
+        expect(std::find(strategy.orderIds.begin(), strategy.orderIds.end(), "test-1:FILLED") !=
+               strategy.orderIds.end(), "fill delivered from the gateway");
+        expect(std::find(strategy.orderIds.begin(), strategy.orderIds.end(), "stream-1:CANCELED") !=
+               strategy.orderIds.end(), "update delivered from the queue");
+
+        bool threw = false;
+        try {
+            runtime.addMarketData(trades);
+            runtime.start();
+            runtime.addMarketData(trades);
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        runtime.stop();
+        expect(threw, "configuration rejected while running");
+    });
+
+    runTest("Timers", []() {
+        StrategyRuntime runtime;
+        TimerStrategy strategy(runtime);
+        runtime.addStrategy(strategy);
+        runtime.run();  // Returns when the strategy stops the runtime
+
+        // Each tick is due a period after the previous deadline, or later if the loop fell behind
+        expect(strategy.periodicAt.size() == TimerStrategy::TICKS, "periodic timer fired until stopped");
+        for (size_t tick = 0; tick < strategy.periodicAt.size(); ++tick) {
+            int64_t deadline = strategy.startedAt + TimerStrategy::PERIOD * static_cast<int64_t>(tick + 1);
+            expect(strategy.periodicAt[tick] >= deadline, "periodic tick not before its deadline");
+        }
+        // Its deadline is before the last tick's, so it has always fired by the time the loop stops
+        expect(strategy.oneShotAt.size() == 1, "one-shot timer fired once");
+        expect(strategy.oneShotAt[0] >= strategy.startedAt + TimerStrategy::ONE_SHOT_DELAY,
+               "one-shot timer waited its delay");
+        expect(strategy.cancelledCalls == 0, "cancelled timer never fired");
+    });
+
+    runTest("Risk engine kept current by the runtime", []() {
+        binance::SymbolRegistry registry;
+        binance::RiskEngine risk(registry);
+        binance::RiskLimits limits;
+        limits.maxOpenOrders = 2;
+        limits.priceBand = Decimal::parse("0.05");
+        risk.setLimits("BTCUSDT", limits);
+        binance::SymbolId id = registry.find("BTCUSDT");
+
+        RiskCheckedStrategy strategy(risk);
+        ClosingGateway gateway;
+        auto trades = std::make_shared<MarketEventQueue>(64);
+        StrategyRuntime runtime;
+        runtime.addStrategy(strategy);
+        runtime.addMarketData(trades);
+        runtime.setOrderGateway(gateway);
+        runtime.trackRisk(risk);
+        runtime.start();
+
+        // The band needs a last price, which only the runtime's trades give it
+        for (int64_t tradeId = 1; tradeId <= 3; ++tradeId) {
+            trades->tryPush(trade("BTCUSDT", tradeId, "100"));
+        }
+        waitFor([&]() { return strategy.trades == 3; }, "the first trades");
+        expect(risk.exposure(id).lastPrice == Decimal::parse("100"), "last price fed from the trades");
+        expect(strategy.placed == 2 && strategy.rejected == 1, "third order over maxOpenOrders");
+        expect(risk.rejects(binance::RiskResult::OPEN_ORDERS) == 1, "rejected for open orders");
+
+        // One fills, one is canceled; both stop counting as open
+        gateway.released.store(true, std::memory_order_release);
+        waitFor([&]() { return risk.exposure(id).openOrders == 0; }, "the orders to close");
+        binance::RiskExposure exposure = risk.exposure(id);
+        expect(exposure.position == Decimal::parse("0.1"), "fill counted in the position");
+        expect(exposure.openBuyQty.isZero(), "no open quantity left");
+
+        // Two rounds of maxOpenOrders each, every one passing once the last round closed
+        for (int64_t tradeId = 4; tradeId <= 7; tradeId += 2) {
+            trades->tryPush(trade("BTCUSDT", tradeId, "101"));
+            trades->tryPush(trade("BTCUSDT", tradeId + 1, "101"));
+            waitFor([&]() { return strategy.trades == tradeId + 1; }, "the later trades");
+            waitFor([&]() { return risk.exposure(id).openOrders == 0; }, "the later orders to close");
+        }
+        runtime.stop();
+
+        expect(strategy.placed == 6 && strategy.rejected == 1, "orders past maxOpenOrders accepted once closed");
+        expect(risk.exposure(id).position == Decimal::parse("0.3"), "every fill counted");
+        expect(risk.exposure(id).lastPrice == Decimal::parse("101"), "last price followed the trades");
+    });
+
+    runTest("Strategy without a runtime", []() {
+        class Orphan : public binance::Strategy {
+        public:
+            bool tryOrders() {
+                try {
+                    orders();
+                } catch (const std::runtime_error&) {
+                    return true;
+                }
+                return false;
+            }
+        } orphan;
+        expect(orphan.tryOrders(), "orders() throws when unattached");
+
+        StrategyRuntime runtime;
+        runtime.addStrategy(orphan);
+        expect(orphan.tryOrders(), "orders() throws without a gateway");
+    });
+
+    if (runBenchmark) {
+        std::cout << "\n=== Benchmark ===" << std::endl;
+        benchmark();
+    }
+
+    std::cout << "\n=======================================" << std::endl;
+    std::cout << (failures == 0 ? "ALL TESTS PASSED" : "SOME TESTS FAILED") << std::endl;
+    std::cout << "=======================================" << std::endl;
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,59 @@
+#ifndef TEST_EXCHANGE_H
+#define TEST_EXCHANGE_H
+
+#include "../include/ExchangeSimulator.h"
+#include "../include/BinanceAPI.h"
+#include "../include/BinanceWsTradingClient.h"
+#include "../include/Decimal.h"
+
+namespace binance {
+namespace test {
+
+// Credentials the simulator is started with
+const char* const API_KEY = "simulator-key";
+const char* const API_SECRET = "simulator-secret";
+
+/**
+ * @brief Simulator settings the tests start from: the test credentials, default limits
+ */
+inline SimulatorConfig simulatorConfig() {
+    SimulatorConfig config;
+    config.apiKey = API_KEY;
+    config.apiSecret = API_SECRET;
+    return config;
+}
+
+/**
+ * @struct Exchange
+ * @brief A started simulator listing BTCUSDT at 50000, with a REST client for it
+ *
+ * Tests that need more symbols or filters set them on the started simulator.
+ */
+struct Exchange {
+    ExchangeSimulator simulator;
+    BinanceAPI api;
+
+    explicit Exchange(const SimulatorConfig& config = simulatorConfig())
+        : simulator(config), api(API_KEY, API_SECRET, simulator.baseUrl()) {
+        simulator.setPrice("BTCUSDT", Decimal::fromInteger(50000));
+        simulator.start();
+    }
+};
+
+/**
+ * @struct WsExchange
+ * @brief The same exchange with a connected WebSocket API client as well
+ */
+struct WsExchange : Exchange {
+    BinanceWsTradingClient client;
+
+    explicit WsExchange(const SimulatorConfig& config = simulatorConfig())
+        : Exchange(config), client(API_KEY, API_SECRET, simulator.webSocketApiUrl()) {
+        client.connect();
+    }
+};
+
+} // namespace test
+} // namespace binance
+
+#endif // TEST_EXCHANGE_H
@@ -64,12 +64,14 @@ void runTest(const std::string& testName, std::function<void()> testFunction) {
 
 int main(int argc, char** argv) {
     if (argc < 3) {
-        std::cerr << "Usage: " << argv[0] << " <api_key> <api_secret>" << std::endl;
+        std::cerr << "Usage: " << argv[0] << " <api_key> <api_secret> [base_url]" << std::endl;
         return 1;
     }
     
     std::string api_key = argv[1];
     std::string api_secret = argv[2];
+    // Testnet unless another host, such as a local exchange_simulator, is given
+    std::string base_url = argc > 3 ? argv[3] : "https://testnet.binance.vision";
     
     try {
         std::cout << "\n\n=======================================" << std::endl;
@@ -77,7 +79,7 @@ int main(int argc, char** argv) {
         std::cout << "=======================================" << std::endl;
         
         // Initialize the Binance API client with testnet URL
-        binance::BinanceAPI api(api_key, api_secret, "https://testnet.binance.vision");
+        binance::BinanceAPI api(api_key, api_secret, base_url);
         
         // Test 1: Check Server Time (Public Endpoint)
         runTest("Server Time (Public Endpoint)", [&api]() {
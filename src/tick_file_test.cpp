@@ -0,0 +1,341 @@
+#include "../include/TickFile.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <functional>
+#include <stdexcept>
+#include <chrono>
+#include <vector>
+#include <random>
+#include <thread>
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
+
+namespace {
+
+int failures = 0;
+
+void printTestResult(const std::string& testName, bool success) {
+    std::cout << std::left << std::setw(50) << testName << " : "
+              << (success ? "PASSED" : "FAILED") << std::endl;
+}
+
+void runTest(const std::string& testName, std::function<void()> testFunction) {
+    std::cout << "\n=== Running test: " << testName << " ===" << std::endl;
+    try {
+        testFunction();
+        printTestResult(testName, true);
+    } catch (const std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        printTestResult(testName, false);
+        ++failures;
+    }
+}
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        throw std::runtime_error("check failed: " + what);
+    }
+}
+
+// A file in the temporary directory, removed when it goes out of scope
+struct TempFile {
+    std::string path;
+
+    explicit TempFile(const std::string& name)
+        : path("/tmp/tick_file_test_" + std::to_string(getpid()) + "_" + name) {}
+    ~TempFile() { std::remove(path.c_str()); }
+};
+
+// A random mix of trades, book tickers and depth updates on two symbols
+std::vector<binance::MarketEvent> syntheticEvents(size_t count, uint64_t seed = 11) {
+    std::mt19937_64 rng(seed);
+    std::vector<binance::MarketEvent> events;
+    events.reserve(count);
+    int64_t prices[2] = {3000000000000, 200000000000};
+    int64_t tradeIds[2] = {1000, 5000};
+    int64_t updateIds[2] = {70000, 90000};
+    int64_t time = 1700000000000;
+    const char* symbols[2] = {"BTCUSDT", "ETHUSDT"};
+    for (size_t i = 0; i < count; ++i) {
+        size_t s = rng() % 4 == 0 ? 1 : 0;
+        int64_t tick = s == 0 ? 1000000 : 100000;
+        prices[s] += (static_cast<int64_t>(rng() % 5) - 2) * tick;
+        time += static_cast<int64_t>(rng() % 3);
+        unsigned kind = rng() % 10;
+        if (kind < 6) {
+            binance::TradeEvent trade;
+            trade.symbol.assign(symbols[s]);
+            trade.tradeId = ++tradeIds[s];
+            trade.tradeTime = time;
+            trade.eventTime = time + static_cast<int64_t>(rng() % 2);
+            trade.price = binance::Decimal::fromUnits(prices[s]);
+            trade.quantity = binance::Decimal::fromUnits(static_cast<int64_t>(rng() % 100000) * 1000);
+            trade.isBuyerMaker = (rng() & 1) != 0;
+            events.emplace_back(trade);
+        } else if (kind < 9) {
+            binance::BookTickerEvent ticker;
+            ticker.symbol.assign(symbols[s]);
+            ticker.updateId = ++updateIds[s];
+            ticker.bidPrice = binance::Decimal::fromUnits(prices[s]);
+            ticker.askPrice = binance::Decimal::fromUnits(prices[s] + tick);
+            ticker.bidQty = binance::Decimal::fromUnits(static_cast<int64_t>(rng() % 1000000) * 100);
+            ticker.askQty = binance::Decimal::fromUnits(static_cast<int64_t>(rng() % 1000000) * 100);
+            events.emplace_back(ticker);
+        } else {
+            binance::DepthUpdateEvent depth;
+            depth.symbol.assign(symbols[s]);
+            depth.eventTime = time;
+            depth.firstUpdateId = updateIds[s] + 1;
+            updateIds[s] += 1 + static_cast<int64_t>(rng() % 20);
+            depth.finalUpdateId = updateIds[s];
+            depth.last = (rng() % 4) != 0;
+            depth.bidCount = static_cast<uint16_t>(rng() % (binance::DepthUpdateEvent::MAX_LEVELS + 1));
+            depth.askCount = static_cast<uint16_t>(rng() % 8);
+            for (uint16_t l = 0; l < depth.bidCount; ++l) {
+                depth.bids[l] = {binance::Decimal::fromUnits(prices[s] - tick * (l + 1)),
+                                 binance::Decimal::fromUnits(static_cast<int64_t>(rng() % 3) * 50000000)};
+            }
+            for (uint16_t l = 0; l < depth.askCount; ++l) {
+                depth.asks[l] = {binance::Decimal::fromUnits(prices[s] + tick * (l + 1)),
+                                 binance::Decimal::fromUnits(static_cast<int64_t>(rng() % 3) * 50000000)};
+            }
+            events.emplace_back(depth);
+        }
+    }
+    return events;
+}
+
+bool sameLevels(const binance::PriceLevel* a, const binance::PriceLevel* b, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        if (a[i].price != b[i].price || a[i].quantity != b[i].quantity) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool sameEvent(const binance::MarketEvent& a, const binance::MarketEvent& b) {
+    if (a.index() != b.index()) {
+        return false;
+    }
+    if (const auto* x = std::get_if<binance::TradeEvent>(&a)) {
+        const auto& y = std::get<binance::TradeEvent>(b);
+        return x->symbol.view() == y.symbol.view() && x->tradeId == y.tradeId && x->tradeTime == y.tradeTime &&
+               x->eventTime == y.eventTime && x->price == y.price && x->quantity == y.quantity &&
+               x->isBuyerMaker == y.isBuyerMaker;
+    }
+    if (const auto* x = std::get_if<binance::BookTickerEvent>(&a)) {
+        const auto& y = std::get<binance::BookTickerEvent>(b);
+        return x->symbol.view() == y.symbol.view() && x->updateId == y.updateId && x->bidPrice == y.bidPrice &&
+               x->bidQty == y.bidQty && x->askPrice == y.askPrice && x->askQty == y.askQty;
+    }
+    const auto& x = std::get<binance::DepthUpdateEvent>(a);
+    const auto& y = std::get<binance::DepthUpdateEvent>(b);
+    return x.symbol.view() == y.symbol.view() && x.eventTime == y.eventTime &&
+           x.firstUpdateId == y.firstUpdateId && x.finalUpdateId == y.finalUpdateId &&
+           x.snapshot == y.snapshot && x.last == y.last && x.bidCount == y.bidCount &&
+           x.askCount == y.askCount && sameLevels(x.bids, y.bids, x.bidCount) &&
+           sameLevels(x.asks, y.asks, x.askCount);
+}
+
+// Push every event through a queue into a recorder, waiting for room when the queue is full
+void record(const std::string& path, const std::vector<binance::MarketEvent>& events, size_t chunkRows,
+            uint64_t* bytes = nullptr) {
+    auto queue = std::make_shared<binance::MarketEventQueue>(4096);
+    binance::TickRecorder recorder(path, chunkRows, 60000);
+    recorder.addSource(queue);
+    recorder.start();
+    for (const binance::MarketEvent& event : events) {
+        while (!queue->tryPush(event)) {
+            std::this_thread::yield();
+        }
+    }
+    recorder.stop();
+    if (bytes) {
+        *bytes = recorder.bytesWritten();
+    }
+}
+
+struct Recorded {
+    int64_t time;
+    binance::MarketEvent event;
+};
+
+std::vector<Recorded> readAll(const binance::TickFile& file) {
+    std::vector<Recorded> events;
+    file.replay([&events](int64_t time, const binance::MarketEvent& event) { events.push_back({time, event}); });
+    return events;
+}
+
+void benchmark() {
+    const size_t count = 2000000;
+    std::vector<binance::MarketEvent> events = syntheticEvents(count);
+    TempFile file("bench.tick");
+
+    auto start = std::chrono::steady_clock::now();
+    uint64_t bytes = 0;
+    record(file.path, events, 4096, &bytes);
+    double recordSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    binance::TickFile tick(file.path);
+    start = std::chrono::steady_clock::now();
+    size_t depthLevels = 0;
+    size_t decoded = tick.replay([&depthLevels](int64_t, const binance::MarketEvent& event) {
+        if (const auto* depth = std::get_if<binance::DepthUpdateEvent>(&event)) {
+            depthLevels += depth->bidCount;
+        }
+    });
+    double decodeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Seek to random times and decode the first event at or after each
+    std::mt19937_64 rng(3);
+    const size_t seeks = 10000;
+    int64_t span = tick.lastTime() - tick.firstTime() + 1;
+    start = std::chrono::steady_clock::now();
+    size_t found = 0;
+    for (size_t i = 0; i < seeks; ++i) {
+        int64_t from = tick.firstTime() + static_cast<int64_t>(rng() % static_cast<uint64_t>(span));
+        found += tick.replay(from, from + 1, [](int64_t, const binance::MarketEvent&) {});
+    }
+    double seekSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "  Record (queue -> file)     " << (count / recordSeconds / 1e6) << " M events/s" << std::endl
+              << "  File size                  " << (static_cast<double>(bytes) / count) << " bytes/event vs "
+              << sizeof(binance::MarketEvent) << " in memory" << std::endl
+              << "  Decode                     " << (decoded / decodeSeconds / 1e6) << " M events/s" << std::endl
+              << "  Seek + decode to a time    " << (seekSeconds / seeks * 1e6) << " us" << std::endl;
+    std::cout << (depthLevels + found == 0 ? " " : "");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool runBenchmark = argc > 1 && std::string(argv[1]) == "--bench";
+
+    std::cout << "\n\n=======================================" << std::endl;
+    std::cout << "TICK FILE TESTS" << std::endl;
+    std::cout << "=======================================" << std::endl;
+
+    runTest("Round trip of every event kind", []() {
+        TempFile file("roundtrip.tick");
+        std::vector<binance::MarketEvent> events = syntheticEvents(5000);
+        binance::KlineEvent kline;
+        kline.symbol.assign("BTCUSDT");
+        events.insert(events.begin() + 100, kline);
+        binance::TradeEvent extreme;  // Too many significant digits for the compact form
+        extreme.symbol.assign("BTCUSDT");
+        extreme.price = binance::Decimal::fromUnits(9000000000000000007);
+        extreme.quantity = binance::Decimal::fromUnits(-123456789012345678);
+        events.push_back(extreme);
+
+        auto queue = std::make_shared<binance::MarketEventQueue>(8192);
+        binance::TickRecorder recorder(file.path, 256, 60000);
+        recorder.addSource(queue);
+        for (const binance::MarketEvent& event : events) {
+            expect(queue->tryPush(event), "queue has room");
+        }
+        recorder.start();
+        recorder.stop();
+        expect(recorder.eventsRecorded() == 5001 && recorder.eventsSkipped() == 1, "klines skipped");
+        expect(recorder.chunksWritten() == 20, "chunks of 256 rows");
+
+        events.erase(events.begin() + 100);
+        binance::TickFile tick(file.path);
+        expect(tick.size() == 5001 && tick.chunkCount() == 20, "file holds every event");
+        std::vector<Recorded> decoded = readAll(tick);
+        expect(decoded.size() == events.size(), "decoded count");
+        for (size_t i = 0; i < events.size(); ++i) {
+            expect(sameEvent(decoded[i].event, events[i]), "event " + std::to_string(i) + " round trips");
+            expect(i == 0 || decoded[i].time >= decoded[i - 1].time, "times in order");
+        }
+        expect(decoded.front().time == tick.firstTime() && decoded.back().time == tick.lastTime(), "time range");
+    });
+
+    runTest("Seeking by time", []() {
+        TempFile file("seek.tick");
+        std::vector<binance::MarketEvent> events = syntheticEvents(20000);
+        record(file.path, events, 100);
+        binance::TickFile tick(file.path);
+        std::vector<Recorded> all = readAll(tick);
+        expect(all.size() == events.size(), "all recorded");
+
+        for (size_t pick : {size_t(0), size_t(1), size_t(99), size_t(100), size_t(12345), all.size() - 1}) {
+            int64_t from = all[pick].time;
+            int64_t to = all[std::min(pick + 500, all.size() - 1)].time;
+            size_t expected = 0;
+            size_t first = all.size();
+            for (size_t i = 0; i < all.size(); ++i) {
+                if (all[i].time >= from && all[i].time < to) {
+                    first = std::min(first, i);
+                    ++expected;
+                }
+            }
+            std::vector<Recorded> range;
+            tick.replay(from, to, [&range](int64_t time, const binance::MarketEvent& event) {
+                range.push_back({time, event});
+            });
+            expect(range.size() == expected, "range size at " + std::to_string(pick));
+            expect(range.empty() || sameEvent(range.front().event, all[first].event), "first event of the range");
+            size_t chunk = tick.findChunk(from);
+            expect(chunk < tick.chunkCount(), "chunk found");
+        }
+        expect(tick.findChunk(tick.lastTime() + 1) == tick.chunkCount(), "nothing after the end");
+        expect(tick.replay(tick.lastTime() + 1, INT64_MAX, [](int64_t, const binance::MarketEvent&) {}) == 0,
+               "empty range");
+    });
+
+    runTest("File cut short by a crash", []() {
+        TempFile file("crash.tick");
+        record(file.path, syntheticEvents(1000), 100);
+        binance::TickFile complete(file.path);
+        expect(complete.chunkCount() == 10, "ten chunks");
+
+        // Drop the index and half of the last chunk
+        std::ifstream in(file.path, std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        size_t indexBytes = 10 * 32 + 24;
+        size_t cut = bytes.size() - indexBytes - 40;
+        TempFile truncated("crash_cut.tick");
+        std::ofstream(truncated.path, std::ios::binary).write(bytes.data(), static_cast<std::streamsize>(cut));
+
+        binance::TickFile partial(truncated.path);
+        expect(partial.chunkCount() == 9 && partial.size() == 900, "complete chunks survive");
+        expect(readAll(partial).size() == 900, "and decode");
+    });
+
+    runTest("Rejects files that are not tick files", []() {
+        TempFile file("garbage.tick");
+        std::ofstream(file.path, std::ios::binary) << std::string(100, 'x');
+        bool rejected = false;
+        try {
+            binance::TickFile tick(file.path);
+        } catch (const std::runtime_error&) {
+            rejected = true;
+        }
+        expect(rejected, "garbage rejected");
+    });
+
+    runTest("Compact encoding", []() {
+        TempFile file("size.tick");
+        uint64_t bytes = 0;
+        record(file.path, syntheticEvents(100000), 4096, &bytes);
+        double perEvent = static_cast<double>(bytes) / 100000;
+        std::cout << "  " << std::fixed << std::setprecision(1) << perEvent << " bytes per event" << std::endl;
+        expect(perEvent < 20, "a few bytes per event");
+    });
+
+    if (runBenchmark) {
+        std::cout << "\n=== Benchmark ===" << std::endl;
+        benchmark();
+    }
+
+    std::cout << "\n=======================================" << std::endl;
+    std::cout << (failures == 0 ? "ALL TESTS PASSED" : "SOME TESTS FAILED") << std::endl;
+    std::cout << "=======================================" << std::endl;
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,504 @@
+#include "../include/UserData.h"
+#include "../include/UserDataStream.h"
+#include "../include/OrderStore.h"
+#include "../include/PositionTracker.h"
+#include "../include/StrategyRuntime.h"
+#include "../include/Strategy.h"
+#include "../include/ExchangeSimulator.h"
+#include "../include/BinanceAPI.h"
+#include "test_exchange.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <functional>
+#include <stdexcept>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <vector>
+
+namespace {
+
+using binance::Decimal;
+using binance::OrderApplyResult;
+using binance::OrderExecution;
+using binance::OrderStatus;
+using binance::OrderStore;
+using binance::OrderUpdateEvent;
+using binance::BalanceUpdateEvent;
+using binance::UserDataEvent;
+using binance::UserDataMessage;
+
+int failures = 0;
+
+void printTestResult(const std::string& testName, bool success) {
+    std::cout << std::left << std::setw(50) << testName << " : "
+              << (success ? "PASSED" : "FAILED") << std::endl;
+}
+
+void runTest(const std::string& testName, std::function<void()> testFunction) {
+    std::cout << "\n=== Running test: " << testName << " ===" << std::endl;
+    try {
+        testFunction();
+        printTestResult(testName, true);
+    } catch (const std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        printTestResult(testName, false);
+        ++failures;
+    }
+}
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        throw std::runtime_error("check failed: " + what);
+    }
+}
+
+void waitFor(const std::function<bool()>& done, const std::string& what) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            throw std::runtime_error("timed out waiting for " + what);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+Decimal dec(const char* text) {
+    return Decimal::parse(text);
+}
+
+std::vector<UserDataEvent> parse(std::string_view message, UserDataMessage expected) {
+    std::vector<UserDataEvent> events;
+    UserDataMessage kind = binance::parseUserDataMessage(message, [&](const UserDataEvent& event) {
+        events.push_back(event);
+    });
+    expect(kind == expected, "message kind of " + std::string(message.substr(0, 40)));
+    return events;
+}
+
+OrderUpdateEvent update(int64_t orderId, const char* clientOrderId, OrderStatus status, const char* executed,
+                        const char* quote = "0") {
+    OrderUpdateEvent event;
+    event.symbol.assign("BTCUSDT");
+    event.clientOrderId.assign(clientOrderId);
+    event.orderId = orderId;
+    event.status = status;
+    event.price = dec("100");
+    event.quantity = dec("1");
+    event.executedQty = dec(executed);
+    event.cumulativeQuoteQty = dec(quote);
+    return event;
+}
+
+const char* const EXECUTION_REPORT =
+    "{\"e\":\"executionReport\",\"E\":1499405658658,\"s\":\"ETHBTC\",\"c\":\"mUvoqJxFIILMdfAW5iGSOW\","
+    "\"S\":\"BUY\",\"o\":\"LIMIT\",\"f\":\"GTC\",\"q\":\"1.00000000\",\"p\":\"0.10264410\",\"P\":\"0.00000000\","
+    "\"F\":\"0.00000000\",\"g\":-1,\"C\":\"\",\"x\":\"TRADE\",\"X\":\"PARTIALLY_FILLED\",\"r\":\"NONE\","
+    "\"i\":4293153,\"l\":\"0.40000000\",\"z\":\"0.40000000\",\"L\":\"0.10264410\",\"n\":\"0.00040000\","
+    "\"N\":\"ETH\",\"T\":1499405658657,\"t\":718,\"I\":8641984,\"w\":false,\"m\":true,\"M\":false,"
+    "\"O\":1499405658657,\"Z\":\"0.04105764\",\"Y\":\"0.04105764\",\"Q\":\"0.00000000\",\"W\":1499405658657,"
+    "\"V\":\"NONE\"}";
+
+void benchmark() {
+    const size_t orders = 4096;
+    OrderStore store(orders);
+    std::vector<std::string> clientIds;
+    for (size_t i = 0; i < orders; ++i) {
+        clientIds.push_back("bench-" + std::to_string(i));
+        store.apply(update(static_cast<int64_t>(1000000 + i), clientIds.back().c_str(), OrderStatus::NEW, "0"));
+    }
+
+    const int rounds = 200;
+    size_t found = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        for (size_t i = 0; i < orders; ++i) {
+            found += store.find(static_cast<int64_t>(1000000 + i)) != nullptr;
+        }
+    }
+    double byId = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+                  (rounds * orders);
+    start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        for (size_t i = 0; i < orders; ++i) {
+            found += store.findByClientId(clientIds[i]) != nullptr;
+        }
+    }
+    double byClientId = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+                        (rounds * orders);
+
+    // Alternating fills of the same order, as a busy order sees them
+    OrderUpdateEvent partial = update(1000000, "bench-0", OrderStatus::PARTIALLY_FILLED, "0");
+    OrderExecution fill;
+    start = std::chrono::steady_clock::now();
+    const int fills = 1000000;
+    for (int i = 1; i <= fills; ++i) {
+        partial.executedQty = Decimal::fromUnits(i);
+        store.apply(partial, &fill);
+    }
+    double apply = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / fills;
+
+    std::cout << "  OrderStore with " << orders << " orders: find " << std::fixed << std::setprecision(1) << byId
+              << " ns, findByClientId " << byClientId << " ns, apply " << apply << " ns ("
+              << found << " found)" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool runBenchmark = argc > 1 && std::string(argv[1]) == "--bench";
+
+    std::cout << "\n\n=======================================" << std::endl;
+    std::cout << "USER DATA STREAM TESTS" << std::endl;
+    std::cout << "=======================================" << std::endl;
+
+    runTest("Decode execution reports", []() {
+        std::vector<UserDataEvent> events = parse(EXECUTION_REPORT, UserDataMessage::EXECUTION_REPORT);
+        expect(events.size() == 1, "one event");
+        const OrderUpdateEvent& report = std::get<OrderUpdateEvent>(events[0]);
+        expect(report.symbol == "ETHBTC" && report.clientOrderId == "mUvoqJxFIILMdfAW5iGSOW", "ids");
+        expect(report.orderId == 4293153 && report.eventTime == 1499405658658, "order id and time");
+        expect(report.executionType == binance::ExecutionType::TRADE &&
+               report.status == OrderStatus::PARTIALLY_FILLED, "execution type and status");
+        expect(report.lastQty == dec("0.4") && report.lastPrice == dec("0.1026441") &&
+               report.executedQty == dec("0.4") && report.cumulativeQuoteQty == dec("0.04105764"), "quantities");
+        expect(report.commission == dec("0.0004") && report.commissionAsset == "ETH", "commission");
+        expect(report.tradeId == 718 && report.isMaker, "trade id and maker flag");
+
+        std::vector<UserDataEvent> canceled = parse(
+            "{\"e\":\"executionReport\",\"E\":1,\"s\":\"BTCUSDT\",\"c\":\"cancel-request\",\"S\":\"SELL\","
+            "\"o\":\"LIMIT\",\"q\":\"1\",\"p\":\"2\",\"C\":\"original\",\"x\":\"CANCELED\",\"X\":\"CANCELED\","
+            "\"i\":7,\"l\":\"0\",\"z\":\"0\",\"L\":\"0\",\"n\":\"0\",\"N\":null,\"t\":-1,\"m\":false,\"Z\":\"0\"}",
+            UserDataMessage::EXECUTION_REPORT);
+        const OrderUpdateEvent& cancel = std::get<OrderUpdateEvent>(canceled.at(0));
+        expect(cancel.clientOrderId == "original", "cancel carries the order's own client id");
+        expect(cancel.commissionAsset == "" && cancel.tradeId == -1, "no fill");
+
+        std::string wrapped = std::string("{\"subscriptionId\":0,\"event\":") + EXECUTION_REPORT + "}";
+        expect(parse(wrapped, UserDataMessage::EXECUTION_REPORT).size() == 1, "WebSocket API wrapper");
+        std::string combined = std::string("{\"stream\":\"key\",\"data\":") + EXECUTION_REPORT + "}";
+        expect(parse(combined, UserDataMessage::EXECUTION_REPORT).size() == 1, "combined stream wrapper");
+        expect(parse("{\"result\":null,\"id\":1}", UserDataMessage::OTHER).empty(), "reply ignored");
+        expect(parse("[]", UserDataMessage::OTHER).empty(), "array ignored");
+
+        bool threw = false;
+        try {
+            parse("{\"e\":\"executionReport\",\"i\":\"x\"}", UserDataMessage::EXECUTION_REPORT);
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        expect(threw, "malformed report rejected");
+    });
+
+    runTest("Decode balance and expiry events", []() {
+        std::vector<UserDataEvent> positions = parse(
+            "{\"e\":\"outboundAccountPosition\",\"E\":1564034571105,\"u\":1564034571073,\"B\":["
+            "{\"a\":\"ETH\",\"f\":\"10000.000000\",\"l\":\"0.000000\"},"
+            "{\"a\":\"BTC\",\"f\":\"1.5\",\"l\":\"0.25\"}]}",
+            UserDataMessage::ACCOUNT_POSITION);
+        expect(positions.size() == 2, "one event per asset");
+        const BalanceUpdateEvent& btc = std::get<BalanceUpdateEvent>(positions[1]);
+        expect(btc.asset == "BTC" && btc.free == dec("1.5") && btc.locked == dec("0.25") && !btc.isDelta,
+               "absolute balance");
+        expect(btc.eventTime == 1564034571105, "event time");
+
+        std::vector<UserDataEvent> delta = parse(
+            "{\"e\":\"balanceUpdate\",\"E\":1573200697110,\"a\":\"BTC\",\"d\":\"-100.000000\",\"T\":1573200697068}",
+            UserDataMessage::BALANCE_UPDATE);
+        const BalanceUpdateEvent& change = std::get<BalanceUpdateEvent>(delta.at(0));
+        expect(change.isDelta && change.free == dec("-100"), "balance delta");
+
+        expect(parse("{\"e\":\"listenKeyExpired\",\"E\":1576653824250,\"listenKey\":\"abc\"}",
+                     UserDataMessage::STREAM_EXPIRED).empty(), "listen key expiry");
+        expect(parse("{\"subscriptionId\":0,\"event\":{\"e\":\"eventStreamTerminated\",\"E\":1}}",
+                     UserDataMessage::STREAM_EXPIRED).empty(), "subscription terminated");
+    });
+
+    runTest("Order status transitions", []() {
+        expect(OrderStore::isValidTransition(OrderStatus::NEW, OrderStatus::PARTIALLY_FILLED), "NEW to partial");
+        expect(OrderStore::isValidTransition(OrderStatus::PARTIALLY_FILLED, OrderStatus::PARTIALLY_FILLED),
+               "partial to partial");
+        expect(OrderStore::isValidTransition(OrderStatus::PENDING_NEW, OrderStatus::FILLED), "pending to filled");
+        expect(OrderStore::isValidTransition(OrderStatus::PENDING_CANCEL, OrderStatus::CANCELED), "cancel completes");
+        expect(!OrderStore::isValidTransition(OrderStatus::FILLED, OrderStatus::CANCELED), "out of FILLED");
+        expect(!OrderStore::isValidTransition(OrderStatus::PARTIALLY_FILLED, OrderStatus::NEW), "back to NEW");
+        expect(!OrderStore::isValidTransition(OrderStatus::NEW, OrderStatus::PENDING_NEW), "to PENDING_NEW");
+        expect(!OrderStore::isValidTransition(OrderStatus::NEW, OrderStatus::REJECTED), "rejected after acceptance");
+    });
+
+    runTest("Order store applies updates once", []() {
+        OrderStore store(16);
+        OrderExecution fill;
+        expect(store.apply(update(1, "a", OrderStatus::NEW, "0"), &fill) == OrderApplyResult::APPLIED && fill.empty(),
+               "placed");
+        expect(store.openCount() == 1 && store.find(1)->status == OrderStatus::NEW, "open");
+
+        // The stream reports a fill before the REST response of the placement arrives
+        expect(store.apply(update(1, "a", OrderStatus::PARTIALLY_FILLED, "0.4", "40"), &fill) ==
+               OrderApplyResult::APPLIED, "partial fill");
+        expect(fill.quantity == dec("0.4") && fill.quoteQuantity == dec("40"), "first fill");
+        expect(store.apply(update(1, "a", OrderStatus::NEW, "0"), &fill) == OrderApplyResult::STALE && fill.empty(),
+               "late response is stale");
+        expect(store.apply(update(1, "a", OrderStatus::PARTIALLY_FILLED, "0.4", "40"), &fill) ==
+               OrderApplyResult::STALE, "duplicate is stale");
+        expect(store.apply(update(1, "a", OrderStatus::FILLED, "1", "101"), &fill) == OrderApplyResult::APPLIED,
+               "filled");
+        expect(fill.quantity == dec("0.6") && fill.quoteQuantity == dec("61"), "fill is the increase only");
+        expect(store.openCount() == 0 && store.size() == 1, "no longer open");
+
+        expect(store.apply(update(1, "a", OrderStatus::CANCELED, "1", "101"), &fill) ==
+               OrderApplyResult::INVALID_TRANSITION, "cancel after fill");
+        expect(store.find(1)->status == OrderStatus::FILLED, "state kept");
+        expect(store.staleUpdates() == 2 && store.invalidTransitions() == 1, "counters");
+
+        // A client id reused once its order finished names the newer order
+        store.apply(update(4, "a", OrderStatus::NEW, "0"));
+        expect(store.findByClientId("a")->orderId == 4 && store.find(1)->clientOrderId == "a", "reused client id");
+
+        OrderUpdateEvent rejectedCancel = update(2, "b", OrderStatus::NEW, "0");
+        rejectedCancel.cancelRejected = true;
+        expect(store.apply(rejectedCancel) == OrderApplyResult::IGNORED, "failed cancel ignored");
+        expect(store.apply(update(-1, "c", OrderStatus::REJECTED, "0")) == OrderApplyResult::IGNORED,
+               "rejected placement ignored");
+
+        // First seen mid-life, e.g. placed before the stream connected
+        expect(store.apply(update(3, "d", OrderStatus::PARTIALLY_FILLED, "0.5", "50"), &fill) ==
+               OrderApplyResult::APPLIED && fill.quantity == dec("0.5"), "unknown order inserted with its fill");
+        expect(store.findByClientId("d") == store.find(3) && store.findByClientId("e") == nullptr, "client id index");
+
+        int open = 0;
+        store.forEachOpen([&](const binance::OrderState& order) { open += order.orderId == 3 || order.orderId == 4; });
+        expect(open == 2 && store.openCount() == 2, "open orders listed");
+        store.clear();
+        expect(store.size() == 0 && store.find(3) == nullptr && store.staleUpdates() == 0, "cleared");
+    });
+
+    runTest("Order store eviction and lookup", []() {
+        OrderStore store(8);
+        for (int64_t id = 1; id <= 8; ++id) {
+            std::string clientId = "o" + std::to_string(id);
+            store.apply(update(id, clientId.c_str(), OrderStatus::NEW, "0"));
+        }
+        expect(store.apply(update(9, "o9", OrderStatus::NEW, "0")) == OrderApplyResult::FULL, "full of live orders");
+
+        store.apply(update(5, "o5", OrderStatus::CANCELED, "0"));
+        store.apply(update(2, "o2", OrderStatus::FILLED, "1", "100"));
+        expect(store.apply(update(9, "o9", OrderStatus::NEW, "0")) == OrderApplyResult::APPLIED, "room made");
+        expect(store.evictions() == 1 && store.find(5) == nullptr && store.findByClientId("o5") == nullptr,
+               "oldest finished order evicted");
+        expect(store.find(2) != nullptr, "later finished order kept");
+        for (int64_t id : {1, 2, 3, 4, 6, 7, 8, 9}) {
+            std::string clientId = "o" + std::to_string(id);
+            expect(store.find(id) != nullptr && store.findByClientId(clientId) == store.find(id),
+                   "lookup after deletion of " + clientId);
+        }
+
+        // Order 2 is now the oldest finished one, and makes room for an order reusing its client id
+        store.apply(update(10, "o2", OrderStatus::NEW, "0"));
+        expect(store.find(2) == nullptr && store.findByClientId("o2")->orderId == 10, "evicted id reused");
+
+        bool threw = false;
+        try {
+            OrderStore empty(0);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        expect(threw, "zero capacity rejected");
+    });
+
+    runTest("Position tracker", []() {
+        binance::PositionTracker tracker;
+        tracker.applyFill("BTCUSDT", binance::OrderSide::BUY, {dec("1"), dec("100")});
+        tracker.applyFill("BTCUSDT", binance::OrderSide::BUY, {dec("1"), dec("120")});
+        const binance::Position* position = tracker.position("BTCUSDT");
+        expect(position->quantity == dec("2") && position->averagePrice == dec("110"), "average cost");
+        expect(position->unrealizedPnl(dec("115")) == dec("10"), "unrealized");
+
+        tracker.applyFill("BTCUSDT", binance::OrderSide::SELL, {dec("0.5"), dec("65")});
+        expect(position->quantity == dec("1.5") && position->averagePrice == dec("110") &&
+               position->realizedPnl == dec("10"), "reduce realizes");
+        tracker.applyFill("BTCUSDT", binance::OrderSide::SELL, {dec("2.5"), dec("300")});
+        expect(position->quantity == dec("-1") && position->averagePrice == dec("120") &&
+               position->realizedPnl == dec("25"), "flip opens short at the fill price");
+        tracker.applyFill("BTCUSDT", binance::OrderSide::BUY, {dec("1"), dec("100")});
+        expect(position->quantity.isZero() && position->averagePrice.isZero() && position->realizedPnl == dec("45"),
+               "flat");
+        expect(position->volume == dec("6") && tracker.position("ETHUSDT") == nullptr, "volume");
+
+        BalanceUpdateEvent usdt;
+        usdt.asset.assign("USDT");
+        usdt.free = dec("1000");
+        usdt.locked = dec("50");
+        tracker.apply(usdt);
+        usdt.isDelta = true;
+        usdt.free = dec("-100");
+        usdt.locked = Decimal();
+        tracker.apply(usdt);
+        expect(tracker.balance("USDT")->free == dec("900") && tracker.balance("USDT")->total() == dec("950"),
+               "delta adjusts the free amount");
+        tracker.clear();
+        expect(tracker.balances().empty() && tracker.positions().empty(), "cleared");
+    });
+
+    runTest("Position tracker by symbol id", []() {
+        binance::SymbolRegistry symbols;
+        binance::SymbolId btc = symbols.intern("BTCUSDT");
+        binance::PositionTracker tracker(&symbols);
+        tracker.applyFill("ETHUSDT", binance::OrderSide::BUY, {dec("1"), dec("3000")});
+        tracker.applyFill(btc, binance::OrderSide::BUY, {dec("2"), dec("100")});
+        tracker.applyFill("BTCUSDT", binance::OrderSide::SELL, {dec("1"), dec("60")});
+        const binance::Position* position = tracker.position(btc);
+        expect(position && position == tracker.position("BTCUSDT"), "one position by id and by name");
+        expect(position->quantity == dec("1") && position->realizedPnl == dec("10"), "fills by both paths");
+
+        // A symbol interned after its first fill keeps that position
+        binance::SymbolId eth = symbols.intern("ETHUSDT");
+        expect(tracker.position(eth) == nullptr, "not indexed yet");
+        tracker.applyFill(eth, binance::OrderSide::BUY, {dec("1"), dec("3100")});
+        expect(tracker.position(eth) == tracker.position("ETHUSDT") && tracker.position(eth)->quantity == dec("2"),
+               "adopted on the first fill by id");
+        expect(tracker.positions().size() == 2, "no duplicate");
+
+        bool threw = false;
+        try {
+            binance::PositionTracker unindexed;
+            unindexed.applyFill(btc, binance::OrderSide::BUY, {dec("1"), dec("100")});
+        } catch (const std::out_of_range&) {
+            threw = true;
+        }
+        expect(threw, "ids need a registry");
+        tracker.clear();
+        expect(tracker.position(btc) == nullptr, "cleared");
+    });
+
+    runTest("Stream from the simulator", []() {
+        binance::test::Exchange exchange;
+        binance::ExchangeSimulator& simulator = exchange.simulator;
+        binance::BinanceAPI& api = exchange.api;
+
+        std::string wsUrl = "ws://127.0.0.1:" + std::to_string(simulator.port());
+        binance::UserDataStream stream(api, wsUrl);
+        auto orders = stream.addOrderConsumer(64);
+        auto balances = stream.addBalanceConsumer(64);
+        stream.start();
+        waitFor([&]() { return stream.isConnected(); }, "the connection");
+        expect(stream.listenKey().size() == 60, "listen key created");
+
+        OrderStore store;
+        binance::PositionTracker tracker;
+        std::vector<OrderUpdateEvent> seen;
+        auto drain = [&]() {
+            OrderUpdateEvent event;
+            while (orders->tryPop(event)) {
+                seen.push_back(event);
+                OrderExecution fill;
+                store.apply(event, &fill);
+                if (!fill.empty()) tracker.applyFill(event.symbol.view(), event.side, fill);
+            }
+            BalanceUpdateEvent balance;
+            while (balances->tryPop(balance)) tracker.apply(balance);
+        };
+        // Balances are pushed as they change, not on connect
+        simulator.setBalance("USDT", dec("10000"));
+        waitFor([&]() { drain(); return tracker.balance("USDT") != nullptr; }, "the initial balance");
+
+        binance::OrderInfo placed = api.createOrderTyped("BTCUSDT", "BUY", "LIMIT", {
+            {"timeInForce", "GTC"}, {"price", "49000"}, {"quantity", "0.1"}, {"newClientOrderId", "stream-buy"}});
+        // The REST response and the stream both report the placement
+        OrderUpdateEvent response = update(placed.orderId, "stream-buy", OrderStatus::NEW, "0");
+        response.price = dec("49000");
+        response.quantity = dec("0.1");
+        store.apply(response);
+
+        simulator.trade("BTCUSDT", dec("48900"), dec("1"));
+        waitFor([&]() { drain(); return store.findByClientId("stream-buy")->status == OrderStatus::FILLED; },
+                "the fill");
+        expect(seen.size() == 2 && seen[0].executionType == binance::ExecutionType::NEW &&
+               seen[1].executionType == binance::ExecutionType::TRADE, "NEW then TRADE");
+        expect(seen[1].lastPrice == dec("49000") && seen[1].lastQty == dec("0.1") && seen[1].isMaker &&
+               seen[1].tradeId >= 0, "fill details");
+        const binance::Position* position = tracker.position("BTCUSDT");
+        expect(position && position->quantity == dec("0.1") && position->averagePrice == dec("49000"),
+               "position counts the fill once");
+        waitFor([&]() { drain(); return tracker.balance("USDT")->free == dec("5100"); }, "the quote balance");
+        expect(tracker.balance("BTC")->free == simulator.balance("BTC"), "base balance matches the exchange");
+
+        binance::OrderInfo resting = api.createOrderTyped("BTCUSDT", "SELL", "LIMIT", {
+            {"timeInForce", "GTC"}, {"price", "60000"}, {"quantity", "0.05"}, {"newClientOrderId", "stream-sell"}});
+        api.cancelOrder("BTCUSDT", {{"orderId", std::to_string(resting.orderId)}});
+        waitFor([&]() {
+            drain();
+            const binance::OrderState* order = store.findByClientId("stream-sell");
+            return order && order->status == OrderStatus::CANCELED;
+        }, "the cancel");
+        expect(seen.back().executionType == binance::ExecutionType::CANCELED, "cancel by original client id");
+
+        // An expired key is replaced and the stream carries on
+        std::string firstKey = stream.listenKey();
+        simulator.expireListenKeys();
+        waitFor([&]() { return stream.reconnects() == 1 && stream.isConnected(); }, "the reconnect");
+        expect(stream.listenKey() != firstKey, "new listen key");
+        api.createOrder("BTCUSDT", "BUY", "LIMIT", {{"timeInForce", "GTC"}, {"price", "40000"}, {"quantity", "0.01"},
+                                                    {"newClientOrderId", "after-expiry"}});
+        waitFor([&]() { drain(); return store.findByClientId("after-expiry") != nullptr; }, "events after expiry");
+
+        stream.stop();
+        expect(!stream.isConnected() && stream.decodeErrors() == 0 && stream.eventsDropped() == 0, "clean stop");
+        expect(stream.connectionErrors() == 0 && stream.lastError().empty(), "expiry is not an error");
+        expect(store.staleUpdates() == 1, "duplicate placement dropped");
+
+        // Failures are kept for the caller, not printed
+        binance::UserDataStream unreachable(api, "ws://127.0.0.1:1");
+        unreachable.start();
+        waitFor([&]() { return unreachable.connectionErrors() > 0; }, "the connection error");
+        expect(unreachable.lastError().find("failed") != std::string::npos, "last error kept");
+        unreachable.stop();
+    });
+
+    runTest("Runtime tracks orders and positions", []() {
+        class Counting : public binance::Strategy {
+        public:
+            std::atomic<int> orderUpdates{0};
+            std::atomic<int> balanceUpdates{0};
+            void onOrderUpdate(const OrderUpdateEvent&) override { ++orderUpdates; }
+            void onBalanceUpdate(const BalanceUpdateEvent&) override { ++balanceUpdates; }
+        } strategy;
+
+        auto orderQueue = std::make_shared<binance::OrderUpdateQueue>(16);
+        auto balanceQueue = std::make_shared<binance::BalanceUpdateQueue>(16);
+        binance::StrategyRuntime runtime;
+        runtime.addStrategy(strategy);
+        runtime.addOrderUpdates(orderQueue);
+        runtime.addBalanceUpdates(balanceQueue);
+        OrderStore& store = runtime.trackOrders(64);
+        binance::PositionTracker& tracker = runtime.trackPositions();
+
+        orderQueue->tryPush(update(1, "r", OrderStatus::PARTIALLY_FILLED, "0.5", "50"));
+        orderQueue->tryPush(update(1, "r", OrderStatus::NEW, "0"));  // Stale: not dispatched
+        orderQueue->tryPush(update(1, "r", OrderStatus::FILLED, "1", "110"));
+        BalanceUpdateEvent balance;
+        balance.asset.assign("BTC");
+        balance.free = dec("1");
+        balanceQueue->tryPush(balance);
+
+        runtime.start();
+        waitFor([&]() { return strategy.orderUpdates + strategy.balanceUpdates == 3; }, "dispatch");
+        runtime.stop();
+        expect(strategy.orderUpdates == 2 && strategy.balanceUpdates == 1, "stale update not dispatched");
+        expect(store.find(1)->status == OrderStatus::FILLED, "store current");
+        expect(tracker.position("BTCUSDT")->averagePrice == dec("110") && tracker.balance("BTC")->free == dec("1"),
+               "positions and balances current");
+    });
+
+    if (runBenchmark) {
+        std::cout << "\n=== Benchmark ===" << std::endl;
+        benchmark();
+    }
+
+    std::cout << "\n=======================================" << std::endl;
+    std::cout << (failures == 0 ? "ALL TESTS PASSED" : "SOME TESTS FAILED") << std::endl;
+    std::cout << "=======================================" << std::endl;
+
+    return failures == 0 ? 0 : 1;
+}
@@ -61,7 +61,7 @@ void prettyPrintJSON(const std::string& json) {
 
 int main(int argc, char** argv) {
     if (argc < 3) {
-        std::cerr << "Usage: " << argv[0] << " <api_key> <api_secret>" << std::endl;
+        std::cerr << "Usage: " << argv[0] << " <api_key> <api_secret> [base_url]" << std::endl;
         return 1;
     }
     
@@ -74,7 +74,7 @@ int main(int argc, char** argv) {
         binance::BinanceAPI api(
             argv[1],
             argv[2],
-            "https://testnet.binance.vision"
+            argc > 3 ? argv[3] : "https://testnet.binance.vision"
         );
 
         // Get current price from ticker
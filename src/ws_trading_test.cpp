@@ -0,0 +1,321 @@
+#include "../include/BinanceWsTradingClient.h"
+#include "../include/BinanceAPI.h"
+#include "../include/ExchangeSimulator.h"
+#include "../include/RiskEngine.h"
+#include "test_exchange.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <functional>
+#include <stdexcept>
+#include <chrono>
+#include <future>
+#include <vector>
+#include <algorithm>
+
+namespace {
+
+using binance::test::API_KEY;
+using binance::test::API_SECRET;
+using binance::test::WsExchange;
+using binance::test::simulatorConfig;
+
+int failures = 0;
+
+void printTestResult(const std::string& testName, bool success) {
+    std::cout << std::left << std::setw(50) << testName << " : "
+              << (success ? "PASSED" : "FAILED") << std::endl;
+}
+
+void runTest(const std::string& testName, std::function<void()> testFunction) {
+    std::cout << "\n=== Running test: " << testName << " ===" << std::endl;
+    try {
+        testFunction();
+        printTestResult(testName, true);
+    } catch (const std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        printTestResult(testName, false);
+        ++failures;
+    }
+}
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        throw std::runtime_error("check failed: " + what);
+    }
+}
+
+// Expects the call to fail with an error message containing the text, e.g. "\"code\":-2010"
+void expectError(const std::function<void()>& call, const std::string& text, const std::string& what) {
+    try {
+        call();
+    } catch (const std::exception& e) {
+        if (std::string(e.what()).find(text) == std::string::npos) {
+            throw std::runtime_error("check failed: " + what + " (got " + e.what() + ")");
+        }
+        return;
+    }
+    throw std::runtime_error("check failed: " + what + " (no error)");
+}
+
+binance::Decimal dec(const char* text) {
+    return binance::Decimal::parse(text);
+}
+
+std::map<std::string, std::string> limitParams(const char* price, const char* quantity, const char* tif = "GTC") {
+    return {{"timeInForce", tif}, {"price", price}, {"quantity", quantity}};
+}
+
+double millisSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void benchmark() {
+    binance::SimulatorConfig config = simulatorConfig();
+    config.orderLimit10s = 1000000;
+    config.weightLimit = 1000000;
+    WsExchange exchange(config);
+    binance::BinanceAPI& rest = exchange.api;
+    exchange.client.rateLimiter().setEnabled(false);
+    rest.rateLimiter().setEnabled(false);
+    const int rounds = 2000;
+
+    auto run = [&](const char* name, const std::function<void()>& round) {
+        std::vector<double> latencies;
+        latencies.reserve(rounds);
+        for (int i = 0; i < rounds; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            round();
+            latencies.push_back(millisSince(start) * 1000);
+        }
+        std::sort(latencies.begin(), latencies.end());
+        std::cout << std::left << std::setw(28) << name << " p50 " << latencies[rounds / 2] << " us, p99 "
+                  << latencies[rounds * 99 / 100] << " us" << std::endl;
+    };
+    run("REST place + cancel", [&]() {
+        binance::OrderInfo order = rest.createOrderTyped("BTCUSDT", "BUY", "LIMIT", limitParams("40000", "0.001"));
+        rest.cancelOrder("BTCUSDT", {{"orderId", std::to_string(order.orderId)}});
+    });
+    run("WebSocket place + cancel", [&]() {
+        binance::OrderInfo order = exchange.client.createOrderTyped("BTCUSDT", "BUY", "LIMIT",
+                                                                    limitParams("40000", "0.001"));
+        exchange.client.cancelOrder("BTCUSDT", {{"orderId", std::to_string(order.orderId)}});
+    });
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool runBenchmark = argc > 1 && std::string(argv[1]) == "--bench";
+
+    std::cout << "\n\n=======================================" << std::endl;
+    std::cout << "WEBSOCKET TRADING CLIENT TESTS" << std::endl;
+    std::cout << "=======================================" << std::endl;
+
+    runTest("Ping and order lifecycle", []() {
+        WsExchange exchange;
+        expect(exchange.client.isConnected(), "connected");
+        expect(exchange.client.ping() == "{}", "ping");
+
+        binance::OrderInfo order = exchange.client.createOrderTyped(
+            "BTCUSDT", "BUY", "LIMIT",
+            {{"timeInForce", "GTC"}, {"price", "48000"}, {"quantity", "0.1"}, {"newClientOrderId", "mine"}});
+        expect(order.status == binance::OrderStatus::NEW && order.clientOrderId == "mine", "placed");
+        expect(exchange.simulator.openOrderCount() == 1, "resting on the book");
+
+        binance::OrderInfo queried = exchange.client.queryOrderTyped("BTCUSDT", {{"orderId", std::to_string(order.orderId)}});
+        expect(queried.orderId == order.orderId && queried.price == dec("48000"), "queried by id");
+
+        binance::CancelReplaceResult replaced = exchange.client.cancelReplaceOrderTyped(
+            "BTCUSDT", "BUY", "LIMIT", "STOP_ON_FAILURE",
+            {{"cancelOrigClientOrderId", "mine"}, {"timeInForce", "GTC"}, {"price", "48500"}, {"quantity", "0.2"}});
+        expect(replaced.cancelResult && replaced.newOrderResult, "replaced");
+        long replacement = std::get<binance::OrderInfo>(replaced.newOrderResponse).orderId;
+
+        binance::OrderInfo canceled = exchange.client.cancelOrderTyped("BTCUSDT", {{"orderId", std::to_string(replacement)}});
+        expect(canceled.status == binance::OrderStatus::CANCELED, "canceled");
+        expect(exchange.simulator.openOrderCount() == 0, "book empty");
+
+        binance::OrderInfo filled = exchange.client.createOrderTyped("BTCUSDT", "SELL", "MARKET", {{"quantity", "0.01"}});
+        expect(filled.status == binance::OrderStatus::FILLED && filled.executedQty == dec("0.01"), "market fill");
+
+        binance::TestOrderResult tested = exchange.client.testOrderTyped(
+            "BTCUSDT", "BUY", "LIMIT",
+            {{"timeInForce", "GTC"}, {"price", "48000"}, {"quantity", "0.1"}, {"computeCommissionRates", "true"}});
+        expect(tested.standardCommissionForOrder && tested.standardCommissionForOrder->maker == dec("0.001"),
+               "test order with commission rates");
+    });
+
+    runTest("Rejects, thrown and reported", []() {
+        WsExchange exchange;
+        expectError([&]() { exchange.client.createOrder("BTCUSDT", "BUY", "MARKET"); },
+                    "\"code\":-1102", "missing quantity throws");
+        expectError([&]() { exchange.client.cancelOrder("BTCUSDT", {{"orderId", "999"}}); },
+                    "\"code\":-2011", "unknown order cancel throws");
+
+        binance::Response response;
+        binance::RequestBuilder params;
+        params.add("orderId", int64_t{999});
+        expect(!exchange.client.tryCancelOrder("BTCUSDT", params, response), "try cancel fails");
+        expect(response.status == 400 && response.code == -2011, "status and code reported");
+        expect(response.message().find("Unknown order") != std::string::npos, "message reported");
+
+        binance::RequestBuilder order;
+        order.add("quantity", dec("0.001"));
+        expect(exchange.client.tryCreateOrder("BTCUSDT", "BUY", "MARKET", order, response), "try place succeeds");
+        expect(response.status == 200 && response.body.find("\"FILLED\"") != std::string::npos, "result body");
+
+        binance::BinanceWsTradingClient forged(API_KEY, "wrong-secret", exchange.simulator.webSocketApiUrl());
+        forged.connect();
+        expectError([&]() { forged.createOrder("BTCUSDT", "BUY", "MARKET", {{"quantity", "0.001"}}); },
+                    "\"code\":-1022", "bad signature");
+        expect(exchange.client.inFlight() == 0 && forged.inFlight() == 0, "nothing left in flight");
+    });
+
+    runTest("Orders checked with the risk engine", []() {
+        WsExchange exchange;
+        binance::SymbolRegistry registry;
+        binance::RiskEngine risk(registry);
+        binance::RiskLimits limits;
+        limits.maxOrderQty = dec("1");
+        limits.priceBand = dec("0.05");
+        limits.maxOpenOrders = 10;
+        risk.setLimits("BTCUSDT", limits);
+        binance::SymbolId btc = registry.find("BTCUSDT");
+        risk.onTrade(btc, dec("50000"));
+        exchange.client.setRiskEngine(&risk);
+        expect(exchange.client.riskEngine() == &risk, "set");
+        binance::BinanceWsTradingClient& client = exchange.client;
+
+        uint64_t before = exchange.simulator.requestCount();
+        expectError([&]() { client.createOrder("BTCUSDT", "BUY", "LIMIT", limitParams("40000", "0.1")); },
+                    "Risk check failed: PRICE_BAND", "order.place refused");
+        binance::Response response;
+        binance::RequestBuilder order;
+        order.add("timeInForce", "GTC").add("price", "49000").add("quantity", "2");
+        expect(!client.tryCreateOrder("BTCUSDT", "BUY", "LIMIT", order, response) && response.code == -2010,
+               "try variant refused like an exchange reject");
+        expectError([&]() { client.createOrderAsync("BTCUSDT", "BUY", "LIMIT", limitParams("60000", "0.1")); },
+                    "-2010", "async variant refused before sending");
+        std::map<std::string, std::string> replace = limitParams("40000", "0.1");
+        replace["cancelOrderId"] = "999";
+        expectError([&]() { client.cancelReplaceOrder("BTCUSDT", "BUY", "LIMIT", "ALLOW_FAILURE", replace); },
+                    "PRICE_BAND", "order.cancelReplace refused");
+        expect(exchange.simulator.requestCount() == before, "nothing sent");
+
+        client.createOrder("BTCUSDT", "BUY", "LIMIT", limitParams("49000", "0.1"));
+        expect(risk.exposure(btc).openOrders == 1, "accepted order reserved");
+
+        // Rejected by the exchange: crosses the book, or has nothing to cancel
+        expectError([&]() { client.createOrder("BTCUSDT", "BUY", "LIMIT_MAKER", {{"price", "51000"}, {"quantity", "0.1"}}); },
+                    "-2010", "maker order that would cross");
+        std::future<std::string> rejected =
+            client.createOrderAsync("BTCUSDT", "BUY", "LIMIT_MAKER", {{"price", "51000"}, {"quantity", "0.1"}});
+        expectError([&]() { rejected.get(); }, "-2010", "async reject");
+        replace["price"] = "49000";
+        expectError([&]() { client.cancelReplaceOrder("BTCUSDT", "BUY", "LIMIT", "STOP_ON_FAILURE", replace); },
+                    "-2022", "nothing to cancel");
+        rejected = client.cancelReplaceOrderAsync("BTCUSDT", "BUY", "LIMIT", "STOP_ON_FAILURE", replace);
+        expectError([&]() { rejected.get(); }, "-2022", "async variant");
+        expect(risk.exposure(btc).openOrders == 1, "reservations of rejected orders given back");
+
+        // ALLOW_FAILURE places the new order even though the cancel failed
+        expectError([&]() { client.cancelReplaceOrder("BTCUSDT", "BUY", "LIMIT", "ALLOW_FAILURE", replace); },
+                    "-2021", "partial failure");
+        expect(risk.exposure(btc).openOrders == 2 && exchange.simulator.openOrderCount() == 2,
+               "placed order stays reserved");
+    });
+
+    runTest("Rate limits synced from responses", []() {
+        binance::SimulatorConfig config = simulatorConfig();
+        config.weightLimit = 12;
+        WsExchange exchange(config);
+        exchange.client.rateLimiter().setEnabled(false);
+        exchange.client.createOrder("BTCUSDT", "BUY", "LIMIT", limitParams("49000", "0.1"));
+        binance::RateLimiter& limiter = exchange.client.rateLimiter();
+        expect(limiter.used(binance::RateLimitType::ORDERS, 10) == 1, "orders reported");
+        binance::Response response;
+        for (int i = 0; i < 10 && response.status != 429; ++i) {
+            binance::RequestBuilder params;
+            params.add("orderId", int64_t{1});
+            exchange.client.tryQueryOrder("BTCUSDT", params, response);
+        }
+        expect(response.status == 429 && response.code == -1003, "weight limit exceeded");
+        expect(response.headers.retryAfter > 0, "retry after reported");
+    });
+
+    runTest("Pipelined requests overlap their round trips", []() {
+        binance::SimulatorConfig config = simulatorConfig();
+        config.latencyMicros = 50000;
+        WsExchange exchange(config);
+        exchange.client.ping();
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::future<std::string>> placed;
+        for (int i = 0; i < 20; ++i) {
+            placed.push_back(exchange.client.createOrderAsync(
+                "BTCUSDT", "BUY", "LIMIT",
+                {{"timeInForce", "GTC"}, {"price", "40000"}, {"quantity", "0.001"},
+                 {"newClientOrderId", "burst-" + std::to_string(i)}}));
+        }
+        expect(exchange.client.inFlight() > 1, "requests in flight together");
+        for (int i = 0; i < 20; ++i) {
+            // Each response reaches the request that sent it
+            expect(placed[static_cast<size_t>(i)].get().find("\"burst-" + std::to_string(i) + "\"") != std::string::npos,
+                   "response matched to its request");
+        }
+        double millis = millisSince(start);
+        expect(millis >= 50 && millis < 500, "burst takes about one round trip, not twenty");
+        expect(exchange.simulator.openOrderCount() == 20, "all placed");
+
+        std::future<std::string> rejected = exchange.client.cancelOrderAsync("BTCUSDT", {{"orderId", "999"}});
+        expectError([&]() { rejected.get(); }, "\"code\":-2011", "async reject rethrown");
+    });
+
+    runTest("Requests in flight fail when the connection drops", []() {
+        binance::SimulatorConfig config = simulatorConfig();
+        config.latencyMicros = 200000;
+        WsExchange exchange(config);
+        std::future<std::string> pending = exchange.client.createOrderAsync("BTCUSDT", "BUY", "MARKET",
+                                                                            {{"quantity", "0.001"}});
+        exchange.client.close();
+        expectError([&]() { pending.get(); }, "connection closed", "in-flight request failed on close");
+        expect(!exchange.client.isConnected(), "closed");
+        expect(exchange.client.inFlight() == 0, "slots released");
+        expectError([&]() { exchange.client.ping(); }, "connection closed", "later calls throw");
+
+        exchange.client.connect();
+        expect(exchange.client.ping() == "{}", "reconnected");
+
+        pending = exchange.client.testOrderAsync("BTCUSDT", "BUY", "MARKET", {{"quantity", "0.001"}});
+        exchange.simulator.stop();
+        expectError([&]() { pending.get(); }, "connection closed", "in-flight request failed on disconnect");
+        expect(!exchange.client.isConnected(), "disconnected");
+    });
+
+    runTest("Response timeout", []() {
+        binance::SimulatorConfig config = simulatorConfig();
+        config.latencyMicros = 300000;
+        WsExchange exchange(config);
+        exchange.client.setResponseTimeout(50);
+        binance::Response response;
+        binance::RequestBuilder params;
+        params.add("quantity", dec("0.001"));
+        expect(!exchange.client.tryCreateOrder("BTCUSDT", "BUY", "MARKET", params, response), "timed out");
+        expect(response.status == 0 && response.transportError != nullptr, "timeout reported as transport error");
+        expect(exchange.client.inFlight() == 0, "slot released");
+        exchange.client.setResponseTimeout(5000);
+        expect(exchange.client.ping() == "{}", "late response ignored");
+    });
+
+    if (runBenchmark) {
+        std::cout << "\n=== Benchmark ===" << std::endl;
+        benchmark();
+    }
+
+    std::cout << "\n=======================================" << std::endl;
+    std::cout << (failures == 0 ? "ALL TESTS PASSED" : "SOME TESTS FAILED") << std::endl;
+    std::cout << "=======================================" << std::endl;
+
+    return failures == 0 ? 0 : 1;
+}